@@ -25,6 +25,13 @@
 #include "ace/OS_TLI.h"
 #include "ace/Truncate.h"
 
+#if defined (ACE_LINUX)
+#  include /**/ <linux/errqueue.h>
+#  if defined (MSG_ZEROCOPY) && defined (SO_EE_ORIGIN_ZEROCOPY)
+#    define ACE_HAS_ZEROCOPY_COMPLETIONS
+#  endif /* MSG_ZEROCOPY && SO_EE_ORIGIN_ZEROCOPY */
+#endif /* ACE_LINUX */
+
 #if !defined (__ACE_INLINE__)
 #include "ace/ACE.inl"
 #endif /* __ACE_INLINE__ */
@@ -366,6 +373,119 @@ ACE::hash_pjw (const wchar_t *str)
 }
 #endif /* ACE_HAS_WCHAR */
 
+namespace
+{
+  // xxHash64 primes.
+  const ACE_UINT64 xxh_p1 = ACE_UINT64_LITERAL (0x9E3779B185EBCA87);
+  const ACE_UINT64 xxh_p2 = ACE_UINT64_LITERAL (0xC2B2AE3D27D4EB4F);
+  const ACE_UINT64 xxh_p3 = ACE_UINT64_LITERAL (0x165667B19E3779F9);
+  const ACE_UINT64 xxh_p4 = ACE_UINT64_LITERAL (0x85EBCA77C2B2AE63);
+  const ACE_UINT64 xxh_p5 = ACE_UINT64_LITERAL (0x27D4EB2F165667C5);
+
+  inline ACE_UINT64
+  xxh_rotl (ACE_UINT64 x, int r)
+  {
+    return (x << r) | (x >> (64 - r));
+  }
+
+  // Little endian loads; compilers turn these into a single move
+  // where the target allows it.
+  inline ACE_UINT64
+  xxh_read32 (const unsigned char *p)
+  {
+    return static_cast<ACE_UINT64> (p[0])
+      | (static_cast<ACE_UINT64> (p[1]) << 8)
+      | (static_cast<ACE_UINT64> (p[2]) << 16)
+      | (static_cast<ACE_UINT64> (p[3]) << 24);
+  }
+
+  inline ACE_UINT64
+  xxh_read64 (const unsigned char *p)
+  {
+    return xxh_read32 (p) | (xxh_read32 (p + 4) << 32);
+  }
+
+  inline ACE_UINT64
+  xxh_round (ACE_UINT64 acc, ACE_UINT64 input)
+  {
+    acc += input * xxh_p2;
+    acc = xxh_rotl (acc, 31);
+    return acc * xxh_p1;
+  }
+
+  inline ACE_UINT64
+  xxh_merge (ACE_UINT64 acc, ACE_UINT64 val)
+  {
+    acc ^= xxh_round (0, val);
+    return acc * xxh_p1 + xxh_p4;
+  }
+}
+
+ACE_UINT64
+ACE::hash64 (const void *buf, size_t len, ACE_UINT64 seed)
+{
+  const unsigned char *p = static_cast<const unsigned char *> (buf);
+  const unsigned char * const end = p + len;
+  ACE_UINT64 h;
+
+  if (len >= 32)
+    {
+      // Four independent accumulators keep the multipliers busy.
+      ACE_UINT64 v1 = seed + xxh_p1 + xxh_p2;
+      ACE_UINT64 v2 = seed + xxh_p2;
+      ACE_UINT64 v3 = seed;
+      ACE_UINT64 v4 = seed - xxh_p1;
+      const unsigned char * const limit = end - 32;
+
+      do
+        {
+          v1 = xxh_round (v1, xxh_read64 (p));
+          v2 = xxh_round (v2, xxh_read64 (p + 8));
+          v3 = xxh_round (v3, xxh_read64 (p + 16));
+          v4 = xxh_round (v4, xxh_read64 (p + 24));
+          p += 32;
+        }
+      while (p <= limit);
+
+      h = xxh_rotl (v1, 1) + xxh_rotl (v2, 7)
+        + xxh_rotl (v3, 12) + xxh_rotl (v4, 18);
+      h = xxh_merge (h, v1);
+      h = xxh_merge (h, v2);
+      h = xxh_merge (h, v3);
+      h = xxh_merge (h, v4);
+    }
+  else
+    h = seed + xxh_p5;
+
+  h += static_cast<ACE_UINT64> (len);
+
+  for (; p + 8 <= end; p += 8)
+    {
+      h ^= xxh_round (0, xxh_read64 (p));
+      h = xxh_rotl (h, 27) * xxh_p1 + xxh_p4;
+    }
+
+  if (p + 4 <= end)
+    {
+      h ^= xxh_read32 (p) * xxh_p1;
+      h = xxh_rotl (h, 23) * xxh_p2 + xxh_p3;
+      p += 4;
+    }
+
+  for (; p < end; ++p)
+    {
+      h ^= *p * xxh_p5;
+      h = xxh_rotl (h, 11) * xxh_p1;
+    }
+
+  h ^= h >> 33;
+  h *= xxh_p2;
+  h ^= h >> 29;
+  h *= xxh_p3;
+  h ^= h >> 32;
+  return h;
+}
+
 ACE_TCHAR *
 ACE::strenvdup (const ACE_TCHAR *str)
 {
@@ -2074,6 +2194,203 @@ ACE::send_n (ACE_HANDLE handle,
   return ACE_Utils::truncate_cast<ssize_t> (bytes_transferred);
 }
 
+ssize_t
+ACE::send_chain (ACE_HANDLE handle,
+                 ACE_Message_Block *message_block,
+                 const ACE_Time_Value *timeout,
+                 size_t *bt,
+                 int flags,
+                 size_t *w)
+{
+  size_t temp;
+  size_t &bytes_transferred = bt == 0 ? temp : *bt;
+  bytes_transferred = 0;
+  size_t temp_writes;
+  size_t &writes = w == 0 ? temp_writes : *w;
+  writes = 0;
+
+#if !defined (ACE_HAS_MSG) || defined (ACE_LACKS_SENDMSG)
+  if (flags != 0)
+    ACE_NOTSUP_RETURN (-1);
+#endif /* !ACE_HAS_MSG || ACE_LACKS_SENDMSG */
+
+  // Blocks not fully sent yet: <message_block> is the first one of
+  // the chain of <message>.
+  ACE_Message_Block *message = message_block;
+
+  int val = 0;
+  if (timeout != 0)
+    ACE::record_and_set_non_blocking_mode (handle, val);
+
+  ssize_t result = 0;
+  iovec iov[ACE_IOV_MAX];
+
+  for (;;)
+    {
+      // Skip the blocks which are already sent, and gather the data
+      // of up to ACE_IOV_MAX of those following them.
+      while (message_block != 0 && message_block->length () == 0)
+        if ((message_block = message_block->cont ()) == 0
+            && (message = message->next ()) != 0)
+          message_block = message;
+
+      if (message_block == 0)
+        break;
+
+      int iovcnt = 0;
+      for (ACE_Message_Block *m = message_block, *mc = message;
+           m != 0 && iovcnt < ACE_IOV_MAX;
+           )
+        {
+          if (m->length () > 0)
+            {
+              iov[iovcnt].iov_base = m->rd_ptr ();
+              iov[iovcnt].iov_len =
+                ACE_Utils::truncate_cast<u_long> (m->length ());
+              ++iovcnt;
+            }
+
+          if ((m = m->cont ()) == 0 && (mc = mc->next ()) != 0)
+            m = mc;
+        }
+
+      ssize_t n = 0;
+
+#if defined (ACE_HAS_MSG) && !defined (ACE_LACKS_SENDMSG)
+      if (flags != 0)
+        {
+          msghdr msg;
+          ACE_OS::memset (&msg, 0, sizeof msg);
+          msg.msg_iov = iov;
+          msg.msg_iovlen = iovcnt;
+
+          n = ACE_OS::sendmsg (handle, &msg, flags);
+
+# if defined (MSG_ZEROCOPY)
+          // The kernel is out of memory to pin the pages of the data,
+          // or to queue completions: copy it this time.
+          if (n == -1 && errno == ENOBUFS && (flags & MSG_ZEROCOPY) != 0)
+            n = ACE_OS::sendmsg (handle, &msg, flags & ~MSG_ZEROCOPY);
+          else
+# endif /* MSG_ZEROCOPY */
+          if (n > 0)
+            ++writes;
+        }
+      else
+#endif /* ACE_HAS_MSG && !ACE_LACKS_SENDMSG */
+        {
+          n = ACE_OS::sendv (handle, iov, iovcnt);
+          if (n > 0)
+            ++writes;
+        }
+
+      if (n == 0 || n == -1)
+        {
+          // Check for possible blocking.
+          if (n == -1 && (errno == EWOULDBLOCK || errno == ENOBUFS))
+            {
+              if (timeout != 0 && *timeout == ACE_Time_Value::zero)
+                errno = ETIME;
+              else if (ACE::handle_write_ready (handle, timeout) != -1)
+                continue;
+            }
+
+          result = n;
+          break;
+        }
+
+      bytes_transferred += n;
+
+      // Consume what was sent.
+      size_t sent = static_cast<size_t> (n);
+      while (sent > 0)
+        {
+          size_t const length = message_block->length ();
+          if (length > sent)
+            {
+              message_block->rd_ptr (sent);
+              break;
+            }
+
+          message_block->rd_ptr (length);
+          sent -= length;
+          if ((message_block = message_block->cont ()) == 0
+              && (message = message->next ()) != 0)
+            message_block = message;
+        }
+    }
+
+  if (timeout != 0)
+    ACE::restore_non_blocking_mode (handle, val);
+
+  if (message_block != 0)
+    return result;
+
+  return ACE_Utils::truncate_cast<ssize_t> (bytes_transferred);
+}
+
+int
+ACE::enable_zerocopy (ACE_HANDLE handle)
+{
+#if defined (SO_ZEROCOPY) && defined (MSG_ZEROCOPY)
+  int one = 1;
+  return ACE_OS::setsockopt (handle,
+                             SOL_SOCKET,
+                             SO_ZEROCOPY,
+                             reinterpret_cast<const char *> (&one),
+                             sizeof one);
+#else
+  ACE_UNUSED_ARG (handle);
+  ACE_NOTSUP_RETURN (-1);
+#endif /* SO_ZEROCOPY && MSG_ZEROCOPY */
+}
+
+int
+ACE::zerocopy_completion (ACE_HANDLE handle,
+                          ACE_UINT32 &first,
+                          ACE_UINT32 &last)
+{
+#if defined (ACE_HAS_ZEROCOPY_COMPLETIONS)
+  for (;;)
+    {
+      char control[CMSG_SPACE (sizeof (sock_extended_err))
+                   + CMSG_SPACE (sizeof (sockaddr_in6))];
+      msghdr msg;
+      ACE_OS::memset (&msg, 0, sizeof msg);
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof control;
+
+      if (ACE_OS::recvmsg (handle, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) == -1)
+        return errno == EWOULDBLOCK ? 0 : -1;
+
+      // Skip the other errors queued on the socket, such as ICMP
+      // ones.
+      for (cmsghdr *cmsg = CMSG_FIRSTHDR (&msg);
+           cmsg != 0;
+           cmsg = CMSG_NXTHDR (&msg, cmsg))
+        if ((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR)
+            || (cmsg->cmsg_level == SOL_IPV6
+                && cmsg->cmsg_type == IPV6_RECVERR))
+          {
+            sock_extended_err const *error =
+              reinterpret_cast<sock_extended_err const *> (CMSG_DATA (cmsg));
+            if (error->ee_errno == 0
+                && error->ee_origin == SO_EE_ORIGIN_ZEROCOPY)
+              {
+                first = error->ee_info;
+                last = error->ee_data;
+                return 1;
+              }
+          }
+    }
+#else
+  ACE_UNUSED_ARG (handle);
+  ACE_UNUSED_ARG (first);
+  ACE_UNUSED_ARG (last);
+  ACE_NOTSUP_RETURN (-1);
+#endif /* ACE_HAS_ZEROCOPY_COMPLETIONS */
+}
+
 ssize_t
 ACE::readv_n (ACE_HANDLE handle,
               iovec *iov,
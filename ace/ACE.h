@@ -321,6 +321,51 @@ namespace ACE
                                     const ACE_Time_Value *timeout = 0,
                                     size_t *bytes_transferred = 0);
 
+  /**
+   * Send all the data of the @a message_block chain, following their
+   * @c cont and @c next pointers, with gather-writes of up to
+   * ACE_IOV_MAX blocks at a time.  Unlike send_n(), the data sent is
+   * consumed: the @c rd_ptr of the blocks is advanced past the bytes
+   * written, so after a partial write (an error, or @a timeout
+   * expiring) calling again with the same chain resumes where this
+   * call stopped.  A @a timeout of ACE_Time_Value::zero only sends
+   * what @a handle takes without blocking.
+   *
+   * @a flags other than 0 are passed to sendmsg(), e.g. MSG_ZEROCOPY
+   * on Linux, otherwise writev() is used, which works for any kind of
+   * handle.  @a writes is set to the number of write calls which sent
+   * data; each of them gets its own MSG_ZEROCOPY completion, see
+   * zerocopy_completion().
+   *
+   * @return The number of bytes sent once the whole chain is sent,
+   * 0 on EOF, or -1 on error or timeout, with @a bytes_transferred
+   * giving what was sent (and consumed) until then.
+   */
+  extern ACE_Export ssize_t send_chain (ACE_HANDLE handle,
+                                        ACE_Message_Block *message_block,
+                                        const ACE_Time_Value *timeout = 0,
+                                        size_t *bytes_transferred = 0,
+                                        int flags = 0,
+                                        size_t *writes = 0);
+
+  /// Turn on the SO_ZEROCOPY option of socket @a handle, without
+  /// which the MSG_ZEROCOPY flag is ignored.  Returns -1 with @c errno
+  /// ENOTSUP where zero-copy sends aren't supported.
+  extern ACE_Export int enable_zerocopy (ACE_HANDLE handle);
+
+  /**
+   * Read a MSG_ZEROCOPY completion from the error queue of socket
+   * @a handle, without blocking.  The zero-copy writes numbered
+   * @a first to @a last, counting from 0 for the first one on the
+   * socket, no longer use the memory they were given.
+   *
+   * @return 1 if a completion was read, 0 if none is pending, -1 on
+   * error.
+   */
+  extern ACE_Export int zerocopy_completion (ACE_HANDLE handle,
+                                             ACE_UINT32 &first,
+                                             ACE_UINT32 &last);
+
   // = File system I/O functions (these don't support timeouts).
 
   ACE_NAMESPACE_INLINE_FUNCTION
@@ -569,6 +614,17 @@ namespace ACE
   extern ACE_Export u_long hash_pjw (const wchar_t *str, size_t len);
 #endif /* ACE_HAS_WCHAR */
 
+  /**
+   * Computes a 64 bit hash value of the @a len bytes at @a buf using
+   * the xxHash64 algorithm.  Keys of 32 bytes or more are consumed
+   * in four independent lanes, so long keys hash at several bytes per
+   * cycle; short keys cost about as much as hash_pjw().  The result
+   * is the same on every platform for a given @a seed.
+   */
+  extern ACE_Export ACE_UINT64 hash64 (const void *buf,
+                                       size_t len,
+                                       ACE_UINT64 seed = 0);
+
   /// Computes CRC-CCITT for the string.
   extern ACE_Export ACE_UINT16 crc_ccitt(const char *str);
 
@@ -592,6 +648,19 @@ namespace ACE
   extern ACE_Export ACE_UINT32 crc32 (const iovec *iov, int len,
               ACE_UINT32 crc = 0);
 
+  /// Computes the CRC-32C (Castagnoli, as used by iSCSI and SCTP)
+  /// for the string.  Uses the SSE4.2 or ARMv8 crc32 instructions
+  /// when the CPU has them.
+  extern ACE_Export ACE_UINT32 crc32c (const char *str);
+
+  /// Computes the CRC-32C for the buffer.
+  extern ACE_Export ACE_UINT32 crc32c (const void *buf, size_t len,
+               ACE_UINT32 crc = 0);
+
+  /// Computes the CRC-32C for the @ len iovec buffers.
+  extern ACE_Export ACE_UINT32 crc32c (const iovec *iov, int len,
+               ACE_UINT32 crc = 0);
+
   /// Euclid's greatest common divisor algorithm.
   extern ACE_Export u_long gcd (u_long x, u_long y);
 
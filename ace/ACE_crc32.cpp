@@ -1,13 +1,34 @@
 // $Id$
 
 #include "ace/ACE.h"
+#include "ace/OS_NS_string.h"
+
+#if !defined (ACE_LACKS_HW_CRC32C)
+# if (defined (__x86_64__) || defined (__i386__)) \
+     && (defined (__clang__) \
+         || (defined (__GNUC__) \
+             && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#   define ACE_CRC32C_X86
+#   define ACE_CRC32C_TARGET __attribute__ ((target ("sse4.2")))
+#   include <cpuid.h>
+#   include <nmmintrin.h>
+# elif defined (_MSC_VER) && (defined (_M_X64) || defined (_M_IX86))
+#   define ACE_CRC32C_X86
+#   define ACE_CRC32C_TARGET
+#   include <intrin.h>
+#   include <nmmintrin.h>
+# elif defined (__ARM_FEATURE_CRC32)
+#   define ACE_CRC32C_ARM
+#   include <arm_acle.h>
+# endif
+#endif /* !ACE_LACKS_HW_CRC32C */
 
 namespace
 {
   /*****************************************************************/
   /*                                                               */
-  /* CRC LOOKUP TABLE                                              */
-  /* ================                                              */
+  /* CRC LOOKUP TABLES                                             */
+  /* =================                                             */
   /* The following CRC lookup table was generated automagically    */
   /* by the Rocksoft^tm Model CRC Algorithm Table Generation       */
   /* Program V1.0 using the following model parameters:            */
@@ -22,82 +43,1223 @@ namespace
   /* (ross@guest.adelaide.edu.au.). This document is likely to be  */
   /* in the FTP archive "ftp.adelaide.edu.au/pub/rocksoft".        */
   /*                                                               */
+  /* crc_table[0] is that table; crc_table[k][i] is the CRC of     */
+  /* byte i followed by k zero bytes, which lets the slicing-by-8  */
+  /* loop below fold in eight bytes per step.  crc32c_table holds  */
+  /* the same for the Castagnoli polynomial 0x1EDC6F41 (reversed   */
+  /* 0x82F63B78) used by iSCSI, SCTP and the SSE4.2 and ARMv8      */
+  /* crc32 instructions.                                           */
+  /*                                                               */
   /*****************************************************************/
 
-  const ACE_UINT32 crc_table[] =
+  const ACE_UINT32 crc_table[8][256] =
+    {
+      {
+        0x00000000L, 0x77073096L, 0xEE0E612CL, 0x990951BAL,
+        0x076DC419L, 0x706AF48FL, 0xE963A535L, 0x9E6495A3L,
+        0x0EDB8832L, 0x79DCB8A4L, 0xE0D5E91EL, 0x97D2D988L,
+        0x09B64C2BL, 0x7EB17CBDL, 0xE7B82D07L, 0x90BF1D91L,
+        0x1DB71064L, 0x6AB020F2L, 0xF3B97148L, 0x84BE41DEL,
+        0x1ADAD47DL, 0x6DDDE4EBL, 0xF4D4B551L, 0x83D385C7L,
+        0x136C9856L, 0x646BA8C0L, 0xFD62F97AL, 0x8A65C9ECL,
+        0x14015C4FL, 0x63066CD9L, 0xFA0F3D63L, 0x8D080DF5L,
+        0x3B6E20C8L, 0x4C69105EL, 0xD56041E4L, 0xA2677172L,
+        0x3C03E4D1L, 0x4B04D447L, 0xD20D85FDL, 0xA50AB56BL,
+        0x35B5A8FAL, 0x42B2986CL, 0xDBBBC9D6L, 0xACBCF940L,
+        0x32D86CE3L, 0x45DF5C75L, 0xDCD60DCFL, 0xABD13D59L,
+        0x26D930ACL, 0x51DE003AL, 0xC8D75180L, 0xBFD06116L,
+        0x21B4F4B5L, 0x56B3C423L, 0xCFBA9599L, 0xB8BDA50FL,
+        0x2802B89EL, 0x5F058808L, 0xC60CD9B2L, 0xB10BE924L,
+        0x2F6F7C87L, 0x58684C11L, 0xC1611DABL, 0xB6662D3DL,
+        0x76DC4190L, 0x01DB7106L, 0x98D220BCL, 0xEFD5102AL,
+        0x71B18589L, 0x06B6B51FL, 0x9FBFE4A5L, 0xE8B8D433L,
+        0x7807C9A2L, 0x0F00F934L, 0x9609A88EL, 0xE10E9818L,
+        0x7F6A0DBBL, 0x086D3D2DL, 0x91646C97L, 0xE6635C01L,
+        0x6B6B51F4L, 0x1C6C6162L, 0x856530D8L, 0xF262004EL,
+        0x6C0695EDL, 0x1B01A57BL, 0x8208F4C1L, 0xF50FC457L,
+        0x65B0D9C6L, 0x12B7E950L, 0x8BBEB8EAL, 0xFCB9887CL,
+        0x62DD1DDFL, 0x15DA2D49L, 0x8CD37CF3L, 0xFBD44C65L,
+        0x4DB26158L, 0x3AB551CEL, 0xA3BC0074L, 0xD4BB30E2L,
+        0x4ADFA541L, 0x3DD895D7L, 0xA4D1C46DL, 0xD3D6F4FBL,
+        0x4369E96AL, 0x346ED9FCL, 0xAD678846L, 0xDA60B8D0L,
+        0x44042D73L, 0x33031DE5L, 0xAA0A4C5FL, 0xDD0D7CC9L,
+        0x5005713CL, 0x270241AAL, 0xBE0B1010L, 0xC90C2086L,
+        0x5768B525L, 0x206F85B3L, 0xB966D409L, 0xCE61E49FL,
+        0x5EDEF90EL, 0x29D9C998L, 0xB0D09822L, 0xC7D7A8B4L,
+        0x59B33D17L, 0x2EB40D81L, 0xB7BD5C3BL, 0xC0BA6CADL,
+        0xEDB88320L, 0x9ABFB3B6L, 0x03B6E20CL, 0x74B1D29AL,
+        0xEAD54739L, 0x9DD277AFL, 0x04DB2615L, 0x73DC1683L,
+        0xE3630B12L, 0x94643B84L, 0x0D6D6A3EL, 0x7A6A5AA8L,
+        0xE40ECF0BL, 0x9309FF9DL, 0x0A00AE27L, 0x7D079EB1L,
+        0xF00F9344L, 0x8708A3D2L, 0x1E01F268L, 0x6906C2FEL,
+        0xF762575DL, 0x806567CBL, 0x196C3671L, 0x6E6B06E7L,
+        0xFED41B76L, 0x89D32BE0L, 0x10DA7A5AL, 0x67DD4ACCL,
+        0xF9B9DF6FL, 0x8EBEEFF9L, 0x17B7BE43L, 0x60B08ED5L,
+        0xD6D6A3E8L, 0xA1D1937EL, 0x38D8C2C4L, 0x4FDFF252L,
+        0xD1BB67F1L, 0xA6BC5767L, 0x3FB506DDL, 0x48B2364BL,
+        0xD80D2BDAL, 0xAF0A1B4CL, 0x36034AF6L, 0x41047A60L,
+        0xDF60EFC3L, 0xA867DF55L, 0x316E8EEFL, 0x4669BE79L,
+        0xCB61B38CL, 0xBC66831AL, 0x256FD2A0L, 0x5268E236L,
+        0xCC0C7795L, 0xBB0B4703L, 0x220216B9L, 0x5505262FL,
+        0xC5BA3BBEL, 0xB2BD0B28L, 0x2BB45A92L, 0x5CB36A04L,
+        0xC2D7FFA7L, 0xB5D0CF31L, 0x2CD99E8BL, 0x5BDEAE1DL,
+        0x9B64C2B0L, 0xEC63F226L, 0x756AA39CL, 0x026D930AL,
+        0x9C0906A9L, 0xEB0E363FL, 0x72076785L, 0x05005713L,
+        0x95BF4A82L, 0xE2B87A14L, 0x7BB12BAEL, 0x0CB61B38L,
+        0x92D28E9BL, 0xE5D5BE0DL, 0x7CDCEFB7L, 0x0BDBDF21L,
+        0x86D3D2D4L, 0xF1D4E242L, 0x68DDB3F8L, 0x1FDA836EL,
+        0x81BE16CDL, 0xF6B9265BL, 0x6FB077E1L, 0x18B74777L,
+        0x88085AE6L, 0xFF0F6A70L, 0x66063BCAL, 0x11010B5CL,
+        0x8F659EFFL, 0xF862AE69L, 0x616BFFD3L, 0x166CCF45L,
+        0xA00AE278L, 0xD70DD2EEL, 0x4E048354L, 0x3903B3C2L,
+        0xA7672661L, 0xD06016F7L, 0x4969474DL, 0x3E6E77DBL,
+        0xAED16A4AL, 0xD9D65ADCL, 0x40DF0B66L, 0x37D83BF0L,
+        0xA9BCAE53L, 0xDEBB9EC5L, 0x47B2CF7FL, 0x30B5FFE9L,
+        0xBDBDF21CL, 0xCABAC28AL, 0x53B39330L, 0x24B4A3A6L,
+        0xBAD03605L, 0xCDD70693L, 0x54DE5729L, 0x23D967BFL,
+        0xB3667A2EL, 0xC4614AB8L, 0x5D681B02L, 0x2A6F2B94L,
+        0xB40BBE37L, 0xC30C8EA1L, 0x5A05DF1BL, 0x2D02EF8DL
+      },
+      {
+        0x00000000L, 0x191B3141L, 0x32366282L, 0x2B2D53C3L,
+        0x646CC504L, 0x7D77F445L, 0x565AA786L, 0x4F4196C7L,
+        0xC8D98A08L, 0xD1C2BB49L, 0xFAEFE88AL, 0xE3F4D9CBL,
+        0xACB54F0CL, 0xB5AE7E4DL, 0x9E832D8EL, 0x87981CCFL,
+        0x4AC21251L, 0x53D92310L, 0x78F470D3L, 0x61EF4192L,
+        0x2EAED755L, 0x37B5E614L, 0x1C98B5D7L, 0x05838496L,
+        0x821B9859L, 0x9B00A918L, 0xB02DFADBL, 0xA936CB9AL,
+        0xE6775D5DL, 0xFF6C6C1CL, 0xD4413FDFL, 0xCD5A0E9EL,
+        0x958424A2L, 0x8C9F15E3L, 0xA7B24620L, 0xBEA97761L,
+        0xF1E8E1A6L, 0xE8F3D0E7L, 0xC3DE8324L, 0xDAC5B265L,
+        0x5D5DAEAAL, 0x44469FEBL, 0x6F6BCC28L, 0x7670FD69L,
+        0x39316BAEL, 0x202A5AEFL, 0x0B07092CL, 0x121C386DL,
+        0xDF4636F3L, 0xC65D07B2L, 0xED705471L, 0xF46B6530L,
+        0xBB2AF3F7L, 0xA231C2B6L, 0x891C9175L, 0x9007A034L,
+        0x179FBCFBL, 0x0E848DBAL, 0x25A9DE79L, 0x3CB2EF38L,
+        0x73F379FFL, 0x6AE848BEL, 0x41C51B7DL, 0x58DE2A3CL,
+        0xF0794F05L, 0xE9627E44L, 0xC24F2D87L, 0xDB541CC6L,
+        0x94158A01L, 0x8D0EBB40L, 0xA623E883L, 0xBF38D9C2L,
+        0x38A0C50DL, 0x21BBF44CL, 0x0A96A78FL, 0x138D96CEL,
+        0x5CCC0009L, 0x45D73148L, 0x6EFA628BL, 0x77E153CAL,
+        0xBABB5D54L, 0xA3A06C15L, 0x888D3FD6L, 0x91960E97L,
+        0xDED79850L, 0xC7CCA911L, 0xECE1FAD2L, 0xF5FACB93L,
+        0x7262D75CL, 0x6B79E61DL, 0x4054B5DEL, 0x594F849FL,
+        0x160E1258L, 0x0F152319L, 0x243870DAL, 0x3D23419BL,
+        0x65FD6BA7L, 0x7CE65AE6L, 0x57CB0925L, 0x4ED03864L,
+        0x0191AEA3L, 0x188A9FE2L, 0x33A7CC21L, 0x2ABCFD60L,
+        0xAD24E1AFL, 0xB43FD0EEL, 0x9F12832DL, 0x8609B26CL,
+        0xC94824ABL, 0xD05315EAL, 0xFB7E4629L, 0xE2657768L,
+        0x2F3F79F6L, 0x362448B7L, 0x1D091B74L, 0x04122A35L,
+        0x4B53BCF2L, 0x52488DB3L, 0x7965DE70L, 0x607EEF31L,
+        0xE7E6F3FEL, 0xFEFDC2BFL, 0xD5D0917CL, 0xCCCBA03DL,
+        0x838A36FAL, 0x9A9107BBL, 0xB1BC5478L, 0xA8A76539L,
+        0x3B83984BL, 0x2298A90AL, 0x09B5FAC9L, 0x10AECB88L,
+        0x5FEF5D4FL, 0x46F46C0EL, 0x6DD93FCDL, 0x74C20E8CL,
+        0xF35A1243L, 0xEA412302L, 0xC16C70C1L, 0xD8774180L,
+        0x9736D747L, 0x8E2DE606L, 0xA500B5C5L, 0xBC1B8484L,
+        0x71418A1AL, 0x685ABB5BL, 0x4377E898L, 0x5A6CD9D9L,
+        0x152D4F1EL, 0x0C367E5FL, 0x271B2D9CL, 0x3E001CDDL,
+        0xB9980012L, 0xA0833153L, 0x8BAE6290L, 0x92B553D1L,
+        0xDDF4C516L, 0xC4EFF457L, 0xEFC2A794L, 0xF6D996D5L,
+        0xAE07BCE9L, 0xB71C8DA8L, 0x9C31DE6BL, 0x852AEF2AL,
+        0xCA6B79EDL, 0xD37048ACL, 0xF85D1B6FL, 0xE1462A2EL,
+        0x66DE36E1L, 0x7FC507A0L, 0x54E85463L, 0x4DF36522L,
+        0x02B2F3E5L, 0x1BA9C2A4L, 0x30849167L, 0x299FA026L,
+        0xE4C5AEB8L, 0xFDDE9FF9L, 0xD6F3CC3AL, 0xCFE8FD7BL,
+        0x80A96BBCL, 0x99B25AFDL, 0xB29F093EL, 0xAB84387FL,
+        0x2C1C24B0L, 0x350715F1L, 0x1E2A4632L, 0x07317773L,
+        0x4870E1B4L, 0x516BD0F5L, 0x7A468336L, 0x635DB277L,
+        0xCBFAD74EL, 0xD2E1E60FL, 0xF9CCB5CCL, 0xE0D7848DL,
+        0xAF96124AL, 0xB68D230BL, 0x9DA070C8L, 0x84BB4189L,
+        0x03235D46L, 0x1A386C07L, 0x31153FC4L, 0x280E0E85L,
+        0x674F9842L, 0x7E54A903L, 0x5579FAC0L, 0x4C62CB81L,
+        0x8138C51FL, 0x9823F45EL, 0xB30EA79DL, 0xAA1596DCL,
+        0xE554001BL, 0xFC4F315AL, 0xD7626299L, 0xCE7953D8L,
+        0x49E14F17L, 0x50FA7E56L, 0x7BD72D95L, 0x62CC1CD4L,
+        0x2D8D8A13L, 0x3496BB52L, 0x1FBBE891L, 0x06A0D9D0L,
+        0x5E7EF3ECL, 0x4765C2ADL, 0x6C48916EL, 0x7553A02FL,
+        0x3A1236E8L, 0x230907A9L, 0x0824546AL, 0x113F652BL,
+        0x96A779E4L, 0x8FBC48A5L, 0xA4911B66L, 0xBD8A2A27L,
+        0xF2CBBCE0L, 0xEBD08DA1L, 0xC0FDDE62L, 0xD9E6EF23L,
+        0x14BCE1BDL, 0x0DA7D0FCL, 0x268A833FL, 0x3F91B27EL,
+        0x70D024B9L, 0x69CB15F8L, 0x42E6463BL, 0x5BFD777AL,
+        0xDC656BB5L, 0xC57E5AF4L, 0xEE530937L, 0xF7483876L,
+        0xB809AEB1L, 0xA1129FF0L, 0x8A3FCC33L, 0x9324FD72L
+      },
+      {
+        0x00000000L, 0x01C26A37L, 0x0384D46EL, 0x0246BE59L,
+        0x0709A8DCL, 0x06CBC2EBL, 0x048D7CB2L, 0x054F1685L,
+        0x0E1351B8L, 0x0FD13B8FL, 0x0D9785D6L, 0x0C55EFE1L,
+        0x091AF964L, 0x08D89353L, 0x0A9E2D0AL, 0x0B5C473DL,
+        0x1C26A370L, 0x1DE4C947L, 0x1FA2771EL, 0x1E601D29L,
+        0x1B2F0BACL, 0x1AED619BL, 0x18ABDFC2L, 0x1969B5F5L,
+        0x1235F2C8L, 0x13F798FFL, 0x11B126A6L, 0x10734C91L,
+        0x153C5A14L, 0x14FE3023L, 0x16B88E7AL, 0x177AE44DL,
+        0x384D46E0L, 0x398F2CD7L, 0x3BC9928EL, 0x3A0BF8B9L,
+        0x3F44EE3CL, 0x3E86840BL, 0x3CC03A52L, 0x3D025065L,
+        0x365E1758L, 0x379C7D6FL, 0x35DAC336L, 0x3418A901L,
+        0x3157BF84L, 0x3095D5B3L, 0x32D36BEAL, 0x331101DDL,
+        0x246BE590L, 0x25A98FA7L, 0x27EF31FEL, 0x262D5BC9L,
+        0x23624D4CL, 0x22A0277BL, 0x20E69922L, 0x2124F315L,
+        0x2A78B428L, 0x2BBADE1FL, 0x29FC6046L, 0x283E0A71L,
+        0x2D711CF4L, 0x2CB376C3L, 0x2EF5C89AL, 0x2F37A2ADL,
+        0x709A8DC0L, 0x7158E7F7L, 0x731E59AEL, 0x72DC3399L,
+        0x7793251CL, 0x76514F2BL, 0x7417F172L, 0x75D59B45L,
+        0x7E89DC78L, 0x7F4BB64FL, 0x7D0D0816L, 0x7CCF6221L,
+        0x798074A4L, 0x78421E93L, 0x7A04A0CAL, 0x7BC6CAFDL,
+        0x6CBC2EB0L, 0x6D7E4487L, 0x6F38FADEL, 0x6EFA90E9L,
+        0x6BB5866CL, 0x6A77EC5BL, 0x68315202L, 0x69F33835L,
+        0x62AF7F08L, 0x636D153FL, 0x612BAB66L, 0x60E9C151L,
+        0x65A6D7D4L, 0x6464BDE3L, 0x662203BAL, 0x67E0698DL,
+        0x48D7CB20L, 0x4915A117L, 0x4B531F4EL, 0x4A917579L,
+        0x4FDE63FCL, 0x4E1C09CBL, 0x4C5AB792L, 0x4D98DDA5L,
+        0x46C49A98L, 0x4706F0AFL, 0x45404EF6L, 0x448224C1L,
+        0x41CD3244L, 0x400F5873L, 0x4249E62AL, 0x438B8C1DL,
+        0x54F16850L, 0x55330267L, 0x5775BC3EL, 0x56B7D609L,
+        0x53F8C08CL, 0x523AAABBL, 0x507C14E2L, 0x51BE7ED5L,
+        0x5AE239E8L, 0x5B2053DFL, 0x5966ED86L, 0x58A487B1L,
+        0x5DEB9134L, 0x5C29FB03L, 0x5E6F455AL, 0x5FAD2F6DL,
+        0xE1351B80L, 0xE0F771B7L, 0xE2B1CFEEL, 0xE373A5D9L,
+        0xE63CB35CL, 0xE7FED96BL, 0xE5B86732L, 0xE47A0D05L,
+        0xEF264A38L, 0xEEE4200FL, 0xECA29E56L, 0xED60F461L,
+        0xE82FE2E4L, 0xE9ED88D3L, 0xEBAB368AL, 0xEA695CBDL,
+        0xFD13B8F0L, 0xFCD1D2C7L, 0xFE976C9EL, 0xFF5506A9L,
+        0xFA1A102CL, 0xFBD87A1BL, 0xF99EC442L, 0xF85CAE75L,
+        0xF300E948L, 0xF2C2837FL, 0xF0843D26L, 0xF1465711L,
+        0xF4094194L, 0xF5CB2BA3L, 0xF78D95FAL, 0xF64FFFCDL,
+        0xD9785D60L, 0xD8BA3757L, 0xDAFC890EL, 0xDB3EE339L,
+        0xDE71F5BCL, 0xDFB39F8BL, 0xDDF521D2L, 0xDC374BE5L,
+        0xD76B0CD8L, 0xD6A966EFL, 0xD4EFD8B6L, 0xD52DB281L,
+        0xD062A404L, 0xD1A0CE33L, 0xD3E6706AL, 0xD2241A5DL,
+        0xC55EFE10L, 0xC49C9427L, 0xC6DA2A7EL, 0xC7184049L,
+        0xC25756CCL, 0xC3953CFBL, 0xC1D382A2L, 0xC011E895L,
+        0xCB4DAFA8L, 0xCA8FC59FL, 0xC8C97BC6L, 0xC90B11F1L,
+        0xCC440774L, 0xCD866D43L, 0xCFC0D31AL, 0xCE02B92DL,
+        0x91AF9640L, 0x906DFC77L, 0x922B422EL, 0x93E92819L,
+        0x96A63E9CL, 0x976454ABL, 0x9522EAF2L, 0x94E080C5L,
+        0x9FBCC7F8L, 0x9E7EADCFL, 0x9C381396L, 0x9DFA79A1L,
+        0x98B56F24L, 0x99770513L, 0x9B31BB4AL, 0x9AF3D17DL,
+        0x8D893530L, 0x8C4B5F07L, 0x8E0DE15EL, 0x8FCF8B69L,
+        0x8A809DECL, 0x8B42F7DBL, 0x89044982L, 0x88C623B5L,
+        0x839A6488L, 0x82580EBFL, 0x801EB0E6L, 0x81DCDAD1L,
+        0x8493CC54L, 0x8551A663L, 0x8717183AL, 0x86D5720DL,
+        0xA9E2D0A0L, 0xA820BA97L, 0xAA6604CEL, 0xABA46EF9L,
+        0xAEEB787CL, 0xAF29124BL, 0xAD6FAC12L, 0xACADC625L,
+        0xA7F18118L, 0xA633EB2FL, 0xA4755576L, 0xA5B73F41L,
+        0xA0F829C4L, 0xA13A43F3L, 0xA37CFDAAL, 0xA2BE979DL,
+        0xB5C473D0L, 0xB40619E7L, 0xB640A7BEL, 0xB782CD89L,
+        0xB2CDDB0CL, 0xB30FB13BL, 0xB1490F62L, 0xB08B6555L,
+        0xBBD72268L, 0xBA15485FL, 0xB853F606L, 0xB9919C31L,
+        0xBCDE8AB4L, 0xBD1CE083L, 0xBF5A5EDAL, 0xBE9834EDL
+      },
+      {
+        0x00000000L, 0xB8BC6765L, 0xAA09C88BL, 0x12B5AFEEL,
+        0x8F629757L, 0x37DEF032L, 0x256B5FDCL, 0x9DD738B9L,
+        0xC5B428EFL, 0x7D084F8AL, 0x6FBDE064L, 0xD7018701L,
+        0x4AD6BFB8L, 0xF26AD8DDL, 0xE0DF7733L, 0x58631056L,
+        0x5019579FL, 0xE8A530FAL, 0xFA109F14L, 0x42ACF871L,
+        0xDF7BC0C8L, 0x67C7A7ADL, 0x75720843L, 0xCDCE6F26L,
+        0x95AD7F70L, 0x2D111815L, 0x3FA4B7FBL, 0x8718D09EL,
+        0x1ACFE827L, 0xA2738F42L, 0xB0C620ACL, 0x087A47C9L,
+        0xA032AF3EL, 0x188EC85BL, 0x0A3B67B5L, 0xB28700D0L,
+        0x2F503869L, 0x97EC5F0CL, 0x8559F0E2L, 0x3DE59787L,
+        0x658687D1L, 0xDD3AE0B4L, 0xCF8F4F5AL, 0x7733283FL,
+        0xEAE41086L, 0x525877E3L, 0x40EDD80DL, 0xF851BF68L,
+        0xF02BF8A1L, 0x48979FC4L, 0x5A22302AL, 0xE29E574FL,
+        0x7F496FF6L, 0xC7F50893L, 0xD540A77DL, 0x6DFCC018L,
+        0x359FD04EL, 0x8D23B72BL, 0x9F9618C5L, 0x272A7FA0L,
+        0xBAFD4719L, 0x0241207CL, 0x10F48F92L, 0xA848E8F7L,
+        0x9B14583DL, 0x23A83F58L, 0x311D90B6L, 0x89A1F7D3L,
+        0x1476CF6AL, 0xACCAA80FL, 0xBE7F07E1L, 0x06C36084L,
+        0x5EA070D2L, 0xE61C17B7L, 0xF4A9B859L, 0x4C15DF3CL,
+        0xD1C2E785L, 0x697E80E0L, 0x7BCB2F0EL, 0xC377486BL,
+        0xCB0D0FA2L, 0x73B168C7L, 0x6104C729L, 0xD9B8A04CL,
+        0x446F98F5L, 0xFCD3FF90L, 0xEE66507EL, 0x56DA371BL,
+        0x0EB9274DL, 0xB6054028L, 0xA4B0EFC6L, 0x1C0C88A3L,
+        0x81DBB01AL, 0x3967D77FL, 0x2BD27891L, 0x936E1FF4L,
+        0x3B26F703L, 0x839A9066L, 0x912F3F88L, 0x299358EDL,
+        0xB4446054L, 0x0CF80731L, 0x1E4DA8DFL, 0xA6F1CFBAL,
+        0xFE92DFECL, 0x462EB889L, 0x549B1767L, 0xEC277002L,
+        0x71F048BBL, 0xC94C2FDEL, 0xDBF98030L, 0x6345E755L,
+        0x6B3FA09CL, 0xD383C7F9L, 0xC1366817L, 0x798A0F72L,
+        0xE45D37CBL, 0x5CE150AEL, 0x4E54FF40L, 0xF6E89825L,
+        0xAE8B8873L, 0x1637EF16L, 0x048240F8L, 0xBC3E279DL,
+        0x21E91F24L, 0x99557841L, 0x8BE0D7AFL, 0x335CB0CAL,
+        0xED59B63BL, 0x55E5D15EL, 0x47507EB0L, 0xFFEC19D5L,
+        0x623B216CL, 0xDA874609L, 0xC832E9E7L, 0x708E8E82L,
+        0x28ED9ED4L, 0x9051F9B1L, 0x82E4565FL, 0x3A58313AL,
+        0xA78F0983L, 0x1F336EE6L, 0x0D86C108L, 0xB53AA66DL,
+        0xBD40E1A4L, 0x05FC86C1L, 0x1749292FL, 0xAFF54E4AL,
+        0x322276F3L, 0x8A9E1196L, 0x982BBE78L, 0x2097D91DL,
+        0x78F4C94BL, 0xC048AE2EL, 0xD2FD01C0L, 0x6A4166A5L,
+        0xF7965E1CL, 0x4F2A3979L, 0x5D9F9697L, 0xE523F1F2L,
+        0x4D6B1905L, 0xF5D77E60L, 0xE762D18EL, 0x5FDEB6EBL,
+        0xC2098E52L, 0x7AB5E937L, 0x680046D9L, 0xD0BC21BCL,
+        0x88DF31EAL, 0x3063568FL, 0x22D6F961L, 0x9A6A9E04L,
+        0x07BDA6BDL, 0xBF01C1D8L, 0xADB46E36L, 0x15080953L,
+        0x1D724E9AL, 0xA5CE29FFL, 0xB77B8611L, 0x0FC7E174L,
+        0x9210D9CDL, 0x2AACBEA8L, 0x38191146L, 0x80A57623L,
+        0xD8C66675L, 0x607A0110L, 0x72CFAEFEL, 0xCA73C99BL,
+        0x57A4F122L, 0xEF189647L, 0xFDAD39A9L, 0x45115ECCL,
+        0x764DEE06L, 0xCEF18963L, 0xDC44268DL, 0x64F841E8L,
+        0xF92F7951L, 0x41931E34L, 0x5326B1DAL, 0xEB9AD6BFL,
+        0xB3F9C6E9L, 0x0B45A18CL, 0x19F00E62L, 0xA14C6907L,
+        0x3C9B51BEL, 0x842736DBL, 0x96929935L, 0x2E2EFE50L,
+        0x2654B999L, 0x9EE8DEFCL, 0x8C5D7112L, 0x34E11677L,
+        0xA9362ECEL, 0x118A49ABL, 0x033FE645L, 0xBB838120L,
+        0xE3E09176L, 0x5B5CF613L, 0x49E959FDL, 0xF1553E98L,
+        0x6C820621L, 0xD43E6144L, 0xC68BCEAAL, 0x7E37A9CFL,
+        0xD67F4138L, 0x6EC3265DL, 0x7C7689B3L, 0xC4CAEED6L,
+        0x591DD66FL, 0xE1A1B10AL, 0xF3141EE4L, 0x4BA87981L,
+        0x13CB69D7L, 0xAB770EB2L, 0xB9C2A15CL, 0x017EC639L,
+        0x9CA9FE80L, 0x241599E5L, 0x36A0360BL, 0x8E1C516EL,
+        0x866616A7L, 0x3EDA71C2L, 0x2C6FDE2CL, 0x94D3B949L,
+        0x090481F0L, 0xB1B8E695L, 0xA30D497BL, 0x1BB12E1EL,
+        0x43D23E48L, 0xFB6E592DL, 0xE9DBF6C3L, 0x516791A6L,
+        0xCCB0A91FL, 0x740CCE7AL, 0x66B96194L, 0xDE0506F1L
+      },
+      {
+        0x00000000L, 0x3D6029B0L, 0x7AC05360L, 0x47A07AD0L,
+        0xF580A6C0L, 0xC8E08F70L, 0x8F40F5A0L, 0xB220DC10L,
+        0x30704BC1L, 0x0D106271L, 0x4AB018A1L, 0x77D03111L,
+        0xC5F0ED01L, 0xF890C4B1L, 0xBF30BE61L, 0x825097D1L,
+        0x60E09782L, 0x5D80BE32L, 0x1A20C4E2L, 0x2740ED52L,
+        0x95603142L, 0xA80018F2L, 0xEFA06222L, 0xD2C04B92L,
+        0x5090DC43L, 0x6DF0F5F3L, 0x2A508F23L, 0x1730A693L,
+        0xA5107A83L, 0x98705333L, 0xDFD029E3L, 0xE2B00053L,
+        0xC1C12F04L, 0xFCA106B4L, 0xBB017C64L, 0x866155D4L,
+        0x344189C4L, 0x0921A074L, 0x4E81DAA4L, 0x73E1F314L,
+        0xF1B164C5L, 0xCCD14D75L, 0x8B7137A5L, 0xB6111E15L,
+        0x0431C205L, 0x3951EBB5L, 0x7EF19165L, 0x4391B8D5L,
+        0xA121B886L, 0x9C419136L, 0xDBE1EBE6L, 0xE681C256L,
+        0x54A11E46L, 0x69C137F6L, 0x2E614D26L, 0x13016496L,
+        0x9151F347L, 0xAC31DAF7L, 0xEB91A027L, 0xD6F18997L,
+        0x64D15587L, 0x59B17C37L, 0x1E1106E7L, 0x23712F57L,
+        0x58F35849L, 0x659371F9L, 0x22330B29L, 0x1F532299L,
+        0xAD73FE89L, 0x9013D739L, 0xD7B3ADE9L, 0xEAD38459L,
+        0x68831388L, 0x55E33A38L, 0x124340E8L, 0x2F236958L,
+        0x9D03B548L, 0xA0639CF8L, 0xE7C3E628L, 0xDAA3CF98L,
+        0x3813CFCBL, 0x0573E67BL, 0x42D39CABL, 0x7FB3B51BL,
+        0xCD93690BL, 0xF0F340BBL, 0xB7533A6BL, 0x8A3313DBL,
+        0x0863840AL, 0x3503ADBAL, 0x72A3D76AL, 0x4FC3FEDAL,
+        0xFDE322CAL, 0xC0830B7AL, 0x872371AAL, 0xBA43581AL,
+        0x9932774DL, 0xA4525EFDL, 0xE3F2242DL, 0xDE920D9DL,
+        0x6CB2D18DL, 0x51D2F83DL, 0x167282EDL, 0x2B12AB5DL,
+        0xA9423C8CL, 0x9422153CL, 0xD3826FECL, 0xEEE2465CL,
+        0x5CC29A4CL, 0x61A2B3FCL, 0x2602C92CL, 0x1B62E09CL,
+        0xF9D2E0CFL, 0xC4B2C97FL, 0x8312B3AFL, 0xBE729A1FL,
+        0x0C52460FL, 0x31326FBFL, 0x7692156FL, 0x4BF23CDFL,
+        0xC9A2AB0EL, 0xF4C282BEL, 0xB362F86EL, 0x8E02D1DEL,
+        0x3C220DCEL, 0x0142247EL, 0x46E25EAEL, 0x7B82771EL,
+        0xB1E6B092L, 0x8C869922L, 0xCB26E3F2L, 0xF646CA42L,
+        0x44661652L, 0x79063FE2L, 0x3EA64532L, 0x03C66C82L,
+        0x8196FB53L, 0xBCF6D2E3L, 0xFB56A833L, 0xC6368183L,
+        0x74165D93L, 0x49767423L, 0x0ED60EF3L, 0x33B62743L,
+        0xD1062710L, 0xEC660EA0L, 0xABC67470L, 0x96A65DC0L,
+        0x248681D0L, 0x19E6A860L, 0x5E46D2B0L, 0x6326FB00L,
+        0xE1766CD1L, 0xDC164561L, 0x9BB63FB1L, 0xA6D61601L,
+        0x14F6CA11L, 0x2996E3A1L, 0x6E369971L, 0x5356B0C1L,
+        0x70279F96L, 0x4D47B626L, 0x0AE7CCF6L, 0x3787E546L,
+        0x85A73956L, 0xB8C710E6L, 0xFF676A36L, 0xC2074386L,
+        0x4057D457L, 0x7D37FDE7L, 0x3A978737L, 0x07F7AE87L,
+        0xB5D77297L, 0x88B75B27L, 0xCF1721F7L, 0xF2770847L,
+        0x10C70814L, 0x2DA721A4L, 0x6A075B74L, 0x576772C4L,
+        0xE547AED4L, 0xD8278764L, 0x9F87FDB4L, 0xA2E7D404L,
+        0x20B743D5L, 0x1DD76A65L, 0x5A7710B5L, 0x67173905L,
+        0xD537E515L, 0xE857CCA5L, 0xAFF7B675L, 0x92979FC5L,
+        0xE915E8DBL, 0xD475C16BL, 0x93D5BBBBL, 0xAEB5920BL,
+        0x1C954E1BL, 0x21F567ABL, 0x66551D7BL, 0x5B3534CBL,
+        0xD965A31AL, 0xE4058AAAL, 0xA3A5F07AL, 0x9EC5D9CAL,
+        0x2CE505DAL, 0x11852C6AL, 0x562556BAL, 0x6B457F0AL,
+        0x89F57F59L, 0xB49556E9L, 0xF3352C39L, 0xCE550589L,
+        0x7C75D999L, 0x4115F029L, 0x06B58AF9L, 0x3BD5A349L,
+        0xB9853498L, 0x84E51D28L, 0xC34567F8L, 0xFE254E48L,
+        0x4C059258L, 0x7165BBE8L, 0x36C5C138L, 0x0BA5E888L,
+        0x28D4C7DFL, 0x15B4EE6FL, 0x521494BFL, 0x6F74BD0FL,
+        0xDD54611FL, 0xE03448AFL, 0xA794327FL, 0x9AF41BCFL,
+        0x18A48C1EL, 0x25C4A5AEL, 0x6264DF7EL, 0x5F04F6CEL,
+        0xED242ADEL, 0xD044036EL, 0x97E479BEL, 0xAA84500EL,
+        0x4834505DL, 0x755479EDL, 0x32F4033DL, 0x0F942A8DL,
+        0xBDB4F69DL, 0x80D4DF2DL, 0xC774A5FDL, 0xFA148C4DL,
+        0x78441B9CL, 0x4524322CL, 0x028448FCL, 0x3FE4614CL,
+        0x8DC4BD5CL, 0xB0A494ECL, 0xF704EE3CL, 0xCA64C78CL
+      },
+      {
+        0x00000000L, 0xCB5CD3A5L, 0x4DC8A10BL, 0x869472AEL,
+        0x9B914216L, 0x50CD91B3L, 0xD659E31DL, 0x1D0530B8L,
+        0xEC53826DL, 0x270F51C8L, 0xA19B2366L, 0x6AC7F0C3L,
+        0x77C2C07BL, 0xBC9E13DEL, 0x3A0A6170L, 0xF156B2D5L,
+        0x03D6029BL, 0xC88AD13EL, 0x4E1EA390L, 0x85427035L,
+        0x9847408DL, 0x531B9328L, 0xD58FE186L, 0x1ED33223L,
+        0xEF8580F6L, 0x24D95353L, 0xA24D21FDL, 0x6911F258L,
+        0x7414C2E0L, 0xBF481145L, 0x39DC63EBL, 0xF280B04EL,
+        0x07AC0536L, 0xCCF0D693L, 0x4A64A43DL, 0x81387798L,
+        0x9C3D4720L, 0x57619485L, 0xD1F5E62BL, 0x1AA9358EL,
+        0xEBFF875BL, 0x20A354FEL, 0xA6372650L, 0x6D6BF5F5L,
+        0x706EC54DL, 0xBB3216E8L, 0x3DA66446L, 0xF6FAB7E3L,
+        0x047A07ADL, 0xCF26D408L, 0x49B2A6A6L, 0x82EE7503L,
+        0x9FEB45BBL, 0x54B7961EL, 0xD223E4B0L, 0x197F3715L,
+        0xE82985C0L, 0x23755665L, 0xA5E124CBL, 0x6EBDF76EL,
+        0x73B8C7D6L, 0xB8E41473L, 0x3E7066DDL, 0xF52CB578L,
+        0x0F580A6CL, 0xC404D9C9L, 0x4290AB67L, 0x89CC78C2L,
+        0x94C9487AL, 0x5F959BDFL, 0xD901E971L, 0x125D3AD4L,
+        0xE30B8801L, 0x28575BA4L, 0xAEC3290AL, 0x659FFAAFL,
+        0x789ACA17L, 0xB3C619B2L, 0x35526B1CL, 0xFE0EB8B9L,
+        0x0C8E08F7L, 0xC7D2DB52L, 0x4146A9FCL, 0x8A1A7A59L,
+        0x971F4AE1L, 0x5C439944L, 0xDAD7EBEAL, 0x118B384FL,
+        0xE0DD8A9AL, 0x2B81593FL, 0xAD152B91L, 0x6649F834L,
+        0x7B4CC88CL, 0xB0101B29L, 0x36846987L, 0xFDD8BA22L,
+        0x08F40F5AL, 0xC3A8DCFFL, 0x453CAE51L, 0x8E607DF4L,
+        0x93654D4CL, 0x58399EE9L, 0xDEADEC47L, 0x15F13FE2L,
+        0xE4A78D37L, 0x2FFB5E92L, 0xA96F2C3CL, 0x6233FF99L,
+        0x7F36CF21L, 0xB46A1C84L, 0x32FE6E2AL, 0xF9A2BD8FL,
+        0x0B220DC1L, 0xC07EDE64L, 0x46EAACCAL, 0x8DB67F6FL,
+        0x90B34FD7L, 0x5BEF9C72L, 0xDD7BEEDCL, 0x16273D79L,
+        0xE7718FACL, 0x2C2D5C09L, 0xAAB92EA7L, 0x61E5FD02L,
+        0x7CE0CDBAL, 0xB7BC1E1FL, 0x31286CB1L, 0xFA74BF14L,
+        0x1EB014D8L, 0xD5ECC77DL, 0x5378B5D3L, 0x98246676L,
+        0x852156CEL, 0x4E7D856BL, 0xC8E9F7C5L, 0x03B52460L,
+        0xF2E396B5L, 0x39BF4510L, 0xBF2B37BEL, 0x7477E41BL,
+        0x6972D4A3L, 0xA22E0706L, 0x24BA75A8L, 0xEFE6A60DL,
+        0x1D661643L, 0xD63AC5E6L, 0x50AEB748L, 0x9BF264EDL,
+        0x86F75455L, 0x4DAB87F0L, 0xCB3FF55EL, 0x006326FBL,
+        0xF135942EL, 0x3A69478BL, 0xBCFD3525L, 0x77A1E680L,
+        0x6AA4D638L, 0xA1F8059DL, 0x276C7733L, 0xEC30A496L,
+        0x191C11EEL, 0xD240C24BL, 0x54D4B0E5L, 0x9F886340L,
+        0x828D53F8L, 0x49D1805DL, 0xCF45F2F3L, 0x04192156L,
+        0xF54F9383L, 0x3E134026L, 0xB8873288L, 0x73DBE12DL,
+        0x6EDED195L, 0xA5820230L, 0x2316709EL, 0xE84AA33BL,
+        0x1ACA1375L, 0xD196C0D0L, 0x5702B27EL, 0x9C5E61DBL,
+        0x815B5163L, 0x4A0782C6L, 0xCC93F068L, 0x07CF23CDL,
+        0xF6999118L, 0x3DC542BDL, 0xBB513013L, 0x700DE3B6L,
+        0x6D08D30EL, 0xA65400ABL, 0x20C07205L, 0xEB9CA1A0L,
+        0x11E81EB4L, 0xDAB4CD11L, 0x5C20BFBFL, 0x977C6C1AL,
+        0x8A795CA2L, 0x41258F07L, 0xC7B1FDA9L, 0x0CED2E0CL,
+        0xFDBB9CD9L, 0x36E74F7CL, 0xB0733DD2L, 0x7B2FEE77L,
+        0x662ADECFL, 0xAD760D6AL, 0x2BE27FC4L, 0xE0BEAC61L,
+        0x123E1C2FL, 0xD962CF8AL, 0x5FF6BD24L, 0x94AA6E81L,
+        0x89AF5E39L, 0x42F38D9CL, 0xC467FF32L, 0x0F3B2C97L,
+        0xFE6D9E42L, 0x35314DE7L, 0xB3A53F49L, 0x78F9ECECL,
+        0x65FCDC54L, 0xAEA00FF1L, 0x28347D5FL, 0xE368AEFAL,
+        0x16441B82L, 0xDD18C827L, 0x5B8CBA89L, 0x90D0692CL,
+        0x8DD55994L, 0x46898A31L, 0xC01DF89FL, 0x0B412B3AL,
+        0xFA1799EFL, 0x314B4A4AL, 0xB7DF38E4L, 0x7C83EB41L,
+        0x6186DBF9L, 0xAADA085CL, 0x2C4E7AF2L, 0xE712A957L,
+        0x15921919L, 0xDECECABCL, 0x585AB812L, 0x93066BB7L,
+        0x8E035B0FL, 0x455F88AAL, 0xC3CBFA04L, 0x089729A1L,
+        0xF9C19B74L, 0x329D48D1L, 0xB4093A7FL, 0x7F55E9DAL,
+        0x6250D962L, 0xA90C0AC7L, 0x2F987869L, 0xE4C4ABCCL
+      },
+      {
+        0x00000000L, 0xA6770BB4L, 0x979F1129L, 0x31E81A9DL,
+        0xF44F2413L, 0x52382FA7L, 0x63D0353AL, 0xC5A73E8EL,
+        0x33EF4E67L, 0x959845D3L, 0xA4705F4EL, 0x020754FAL,
+        0xC7A06A74L, 0x61D761C0L, 0x503F7B5DL, 0xF64870E9L,
+        0x67DE9CCEL, 0xC1A9977AL, 0xF0418DE7L, 0x56368653L,
+        0x9391B8DDL, 0x35E6B369L, 0x040EA9F4L, 0xA279A240L,
+        0x5431D2A9L, 0xF246D91DL, 0xC3AEC380L, 0x65D9C834L,
+        0xA07EF6BAL, 0x0609FD0EL, 0x37E1E793L, 0x9196EC27L,
+        0xCFBD399CL, 0x69CA3228L, 0x582228B5L, 0xFE552301L,
+        0x3BF21D8FL, 0x9D85163BL, 0xAC6D0CA6L, 0x0A1A0712L,
+        0xFC5277FBL, 0x5A257C4FL, 0x6BCD66D2L, 0xCDBA6D66L,
+        0x081D53E8L, 0xAE6A585CL, 0x9F8242C1L, 0x39F54975L,
+        0xA863A552L, 0x0E14AEE6L, 0x3FFCB47BL, 0x998BBFCFL,
+        0x5C2C8141L, 0xFA5B8AF5L, 0xCBB39068L, 0x6DC49BDCL,
+        0x9B8CEB35L, 0x3DFBE081L, 0x0C13FA1CL, 0xAA64F1A8L,
+        0x6FC3CF26L, 0xC9B4C492L, 0xF85CDE0FL, 0x5E2BD5BBL,
+        0x440B7579L, 0xE27C7ECDL, 0xD3946450L, 0x75E36FE4L,
+        0xB044516AL, 0x16335ADEL, 0x27DB4043L, 0x81AC4BF7L,
+        0x77E43B1EL, 0xD19330AAL, 0xE07B2A37L, 0x460C2183L,
+        0x83AB1F0DL, 0x25DC14B9L, 0x14340E24L, 0xB2430590L,
+        0x23D5E9B7L, 0x85A2E203L, 0xB44AF89EL, 0x123DF32AL,
+        0xD79ACDA4L, 0x71EDC610L, 0x4005DC8DL, 0xE672D739L,
+        0x103AA7D0L, 0xB64DAC64L, 0x87A5B6F9L, 0x21D2BD4DL,
+        0xE47583C3L, 0x42028877L, 0x73EA92EAL, 0xD59D995EL,
+        0x8BB64CE5L, 0x2DC14751L, 0x1C295DCCL, 0xBA5E5678L,
+        0x7FF968F6L, 0xD98E6342L, 0xE86679DFL, 0x4E11726BL,
+        0xB8590282L, 0x1E2E0936L, 0x2FC613ABL, 0x89B1181FL,
+        0x4C162691L, 0xEA612D25L, 0xDB8937B8L, 0x7DFE3C0CL,
+        0xEC68D02BL, 0x4A1FDB9FL, 0x7BF7C102L, 0xDD80CAB6L,
+        0x1827F438L, 0xBE50FF8CL, 0x8FB8E511L, 0x29CFEEA5L,
+        0xDF879E4CL, 0x79F095F8L, 0x48188F65L, 0xEE6F84D1L,
+        0x2BC8BA5FL, 0x8DBFB1EBL, 0xBC57AB76L, 0x1A20A0C2L,
+        0x8816EAF2L, 0x2E61E146L, 0x1F89FBDBL, 0xB9FEF06FL,
+        0x7C59CEE1L, 0xDA2EC555L, 0xEBC6DFC8L, 0x4DB1D47CL,
+        0xBBF9A495L, 0x1D8EAF21L, 0x2C66B5BCL, 0x8A11BE08L,
+        0x4FB68086L, 0xE9C18B32L, 0xD82991AFL, 0x7E5E9A1BL,
+        0xEFC8763CL, 0x49BF7D88L, 0x78576715L, 0xDE206CA1L,
+        0x1B87522FL, 0xBDF0599BL, 0x8C184306L, 0x2A6F48B2L,
+        0xDC27385BL, 0x7A5033EFL, 0x4BB82972L, 0xEDCF22C6L,
+        0x28681C48L, 0x8E1F17FCL, 0xBFF70D61L, 0x198006D5L,
+        0x47ABD36EL, 0xE1DCD8DAL, 0xD034C247L, 0x7643C9F3L,
+        0xB3E4F77DL, 0x1593FCC9L, 0x247BE654L, 0x820CEDE0L,
+        0x74449D09L, 0xD23396BDL, 0xE3DB8C20L, 0x45AC8794L,
+        0x800BB91AL, 0x267CB2AEL, 0x1794A833L, 0xB1E3A387L,
+        0x20754FA0L, 0x86024414L, 0xB7EA5E89L, 0x119D553DL,
+        0xD43A6BB3L, 0x724D6007L, 0x43A57A9AL, 0xE5D2712EL,
+        0x139A01C7L, 0xB5ED0A73L, 0x840510EEL, 0x22721B5AL,
+        0xE7D525D4L, 0x41A22E60L, 0x704A34FDL, 0xD63D3F49L,
+        0xCC1D9F8BL, 0x6A6A943FL, 0x5B828EA2L, 0xFDF58516L,
+        0x3852BB98L, 0x9E25B02CL, 0xAFCDAAB1L, 0x09BAA105L,
+        0xFFF2D1ECL, 0x5985DA58L, 0x686DC0C5L, 0xCE1ACB71L,
+        0x0BBDF5FFL, 0xADCAFE4BL, 0x9C22E4D6L, 0x3A55EF62L,
+        0xABC30345L, 0x0DB408F1L, 0x3C5C126CL, 0x9A2B19D8L,
+        0x5F8C2756L, 0xF9FB2CE2L, 0xC813367FL, 0x6E643DCBL,
+        0x982C4D22L, 0x3E5B4696L, 0x0FB35C0BL, 0xA9C457BFL,
+        0x6C636931L, 0xCA146285L, 0xFBFC7818L, 0x5D8B73ACL,
+        0x03A0A617L, 0xA5D7ADA3L, 0x943FB73EL, 0x3248BC8AL,
+        0xF7EF8204L, 0x519889B0L, 0x6070932DL, 0xC6079899L,
+        0x304FE870L, 0x9638E3C4L, 0xA7D0F959L, 0x01A7F2EDL,
+        0xC400CC63L, 0x6277C7D7L, 0x539FDD4AL, 0xF5E8D6FEL,
+        0x647E3AD9L, 0xC209316DL, 0xF3E12BF0L, 0x55962044L,
+        0x90311ECAL, 0x3646157EL, 0x07AE0FE3L, 0xA1D90457L,
+        0x579174BEL, 0xF1E67F0AL, 0xC00E6597L, 0x66796E23L,
+        0xA3DE50ADL, 0x05A95B19L, 0x34414184L, 0x92364A30L
+      },
+      {
+        0x00000000L, 0xCCAA009EL, 0x4225077DL, 0x8E8F07E3L,
+        0x844A0EFAL, 0x48E00E64L, 0xC66F0987L, 0x0AC50919L,
+        0xD3E51BB5L, 0x1F4F1B2BL, 0x91C01CC8L, 0x5D6A1C56L,
+        0x57AF154FL, 0x9B0515D1L, 0x158A1232L, 0xD92012ACL,
+        0x7CBB312BL, 0xB01131B5L, 0x3E9E3656L, 0xF23436C8L,
+        0xF8F13FD1L, 0x345B3F4FL, 0xBAD438ACL, 0x767E3832L,
+        0xAF5E2A9EL, 0x63F42A00L, 0xED7B2DE3L, 0x21D12D7DL,
+        0x2B142464L, 0xE7BE24FAL, 0x69312319L, 0xA59B2387L,
+        0xF9766256L, 0x35DC62C8L, 0xBB53652BL, 0x77F965B5L,
+        0x7D3C6CACL, 0xB1966C32L, 0x3F196BD1L, 0xF3B36B4FL,
+        0x2A9379E3L, 0xE639797DL, 0x68B67E9EL, 0xA41C7E00L,
+        0xAED97719L, 0x62737787L, 0xECFC7064L, 0x205670FAL,
+        0x85CD537DL, 0x496753E3L, 0xC7E85400L, 0x0B42549EL,
+        0x01875D87L, 0xCD2D5D19L, 0x43A25AFAL, 0x8F085A64L,
+        0x562848C8L, 0x9A824856L, 0x140D4FB5L, 0xD8A74F2BL,
+        0xD2624632L, 0x1EC846ACL, 0x9047414FL, 0x5CED41D1L,
+        0x299DC2EDL, 0xE537C273L, 0x6BB8C590L, 0xA712C50EL,
+        0xADD7CC17L, 0x617DCC89L, 0xEFF2CB6AL, 0x2358CBF4L,
+        0xFA78D958L, 0x36D2D9C6L, 0xB85DDE25L, 0x74F7DEBBL,
+        0x7E32D7A2L, 0xB298D73CL, 0x3C17D0DFL, 0xF0BDD041L,
+        0x5526F3C6L, 0x998CF358L, 0x1703F4BBL, 0xDBA9F425L,
+        0xD16CFD3CL, 0x1DC6FDA2L, 0x9349FA41L, 0x5FE3FADFL,
+        0x86C3E873L, 0x4A69E8EDL, 0xC4E6EF0EL, 0x084CEF90L,
+        0x0289E689L, 0xCE23E617L, 0x40ACE1F4L, 0x8C06E16AL,
+        0xD0EBA0BBL, 0x1C41A025L, 0x92CEA7C6L, 0x5E64A758L,
+        0x54A1AE41L, 0x980BAEDFL, 0x1684A93CL, 0xDA2EA9A2L,
+        0x030EBB0EL, 0xCFA4BB90L, 0x412BBC73L, 0x8D81BCEDL,
+        0x8744B5F4L, 0x4BEEB56AL, 0xC561B289L, 0x09CBB217L,
+        0xAC509190L, 0x60FA910EL, 0xEE7596EDL, 0x22DF9673L,
+        0x281A9F6AL, 0xE4B09FF4L, 0x6A3F9817L, 0xA6959889L,
+        0x7FB58A25L, 0xB31F8ABBL, 0x3D908D58L, 0xF13A8DC6L,
+        0xFBFF84DFL, 0x37558441L, 0xB9DA83A2L, 0x7570833CL,
+        0x533B85DAL, 0x9F918544L, 0x111E82A7L, 0xDDB48239L,
+        0xD7718B20L, 0x1BDB8BBEL, 0x95548C5DL, 0x59FE8CC3L,
+        0x80DE9E6FL, 0x4C749EF1L, 0xC2FB9912L, 0x0E51998CL,
+        0x04949095L, 0xC83E900BL, 0x46B197E8L, 0x8A1B9776L,
+        0x2F80B4F1L, 0xE32AB46FL, 0x6DA5B38CL, 0xA10FB312L,
+        0xABCABA0BL, 0x6760BA95L, 0xE9EFBD76L, 0x2545BDE8L,
+        0xFC65AF44L, 0x30CFAFDAL, 0xBE40A839L, 0x72EAA8A7L,
+        0x782FA1BEL, 0xB485A120L, 0x3A0AA6C3L, 0xF6A0A65DL,
+        0xAA4DE78CL, 0x66E7E712L, 0xE868E0F1L, 0x24C2E06FL,
+        0x2E07E976L, 0xE2ADE9E8L, 0x6C22EE0BL, 0xA088EE95L,
+        0x79A8FC39L, 0xB502FCA7L, 0x3B8DFB44L, 0xF727FBDAL,
+        0xFDE2F2C3L, 0x3148F25DL, 0xBFC7F5BEL, 0x736DF520L,
+        0xD6F6D6A7L, 0x1A5CD639L, 0x94D3D1DAL, 0x5879D144L,
+        0x52BCD85DL, 0x9E16D8C3L, 0x1099DF20L, 0xDC33DFBEL,
+        0x0513CD12L, 0xC9B9CD8CL, 0x4736CA6FL, 0x8B9CCAF1L,
+        0x8159C3E8L, 0x4DF3C376L, 0xC37CC495L, 0x0FD6C40BL,
+        0x7AA64737L, 0xB60C47A9L, 0x3883404AL, 0xF42940D4L,
+        0xFEEC49CDL, 0x32464953L, 0xBCC94EB0L, 0x70634E2EL,
+        0xA9435C82L, 0x65E95C1CL, 0xEB665BFFL, 0x27CC5B61L,
+        0x2D095278L, 0xE1A352E6L, 0x6F2C5505L, 0xA386559BL,
+        0x061D761CL, 0xCAB77682L, 0x44387161L, 0x889271FFL,
+        0x825778E6L, 0x4EFD7878L, 0xC0727F9BL, 0x0CD87F05L,
+        0xD5F86DA9L, 0x19526D37L, 0x97DD6AD4L, 0x5B776A4AL,
+        0x51B26353L, 0x9D1863CDL, 0x1397642EL, 0xDF3D64B0L,
+        0x83D02561L, 0x4F7A25FFL, 0xC1F5221CL, 0x0D5F2282L,
+        0x079A2B9BL, 0xCB302B05L, 0x45BF2CE6L, 0x89152C78L,
+        0x50353ED4L, 0x9C9F3E4AL, 0x121039A9L, 0xDEBA3937L,
+        0xD47F302EL, 0x18D530B0L, 0x965A3753L, 0x5AF037CDL,
+        0xFF6B144AL, 0x33C114D4L, 0xBD4E1337L, 0x71E413A9L,
+        0x7B211AB0L, 0xB78B1A2EL, 0x39041DCDL, 0xF5AE1D53L,
+        0x2C8E0FFFL, 0xE0240F61L, 0x6EAB0882L, 0xA201081CL,
+        0xA8C40105L, 0x646E019BL, 0xEAE10678L, 0x264B06E6L
+      }
+    };
+
+  const ACE_UINT32 crc32c_table[8][256] =
     {
-      0x00000000L, 0x77073096L, 0xEE0E612CL, 0x990951BAL,
-      0x076DC419L, 0x706AF48FL, 0xE963A535L, 0x9E6495A3L,
-      0x0EDB8832L, 0x79DCB8A4L, 0xE0D5E91EL, 0x97D2D988L,
-      0x09B64C2BL, 0x7EB17CBDL, 0xE7B82D07L, 0x90BF1D91L,
-      0x1DB71064L, 0x6AB020F2L, 0xF3B97148L, 0x84BE41DEL,
-      0x1ADAD47DL, 0x6DDDE4EBL, 0xF4D4B551L, 0x83D385C7L,
-      0x136C9856L, 0x646BA8C0L, 0xFD62F97AL, 0x8A65C9ECL,
-      0x14015C4FL, 0x63066CD9L, 0xFA0F3D63L, 0x8D080DF5L,
-      0x3B6E20C8L, 0x4C69105EL, 0xD56041E4L, 0xA2677172L,
-      0x3C03E4D1L, 0x4B04D447L, 0xD20D85FDL, 0xA50AB56BL,
-      0x35B5A8FAL, 0x42B2986CL, 0xDBBBC9D6L, 0xACBCF940L,
-      0x32D86CE3L, 0x45DF5C75L, 0xDCD60DCFL, 0xABD13D59L,
-      0x26D930ACL, 0x51DE003AL, 0xC8D75180L, 0xBFD06116L,
-      0x21B4F4B5L, 0x56B3C423L, 0xCFBA9599L, 0xB8BDA50FL,
-      0x2802B89EL, 0x5F058808L, 0xC60CD9B2L, 0xB10BE924L,
-      0x2F6F7C87L, 0x58684C11L, 0xC1611DABL, 0xB6662D3DL,
-      0x76DC4190L, 0x01DB7106L, 0x98D220BCL, 0xEFD5102AL,
-      0x71B18589L, 0x06B6B51FL, 0x9FBFE4A5L, 0xE8B8D433L,
-      0x7807C9A2L, 0x0F00F934L, 0x9609A88EL, 0xE10E9818L,
-      0x7F6A0DBBL, 0x086D3D2DL, 0x91646C97L, 0xE6635C01L,
-      0x6B6B51F4L, 0x1C6C6162L, 0x856530D8L, 0xF262004EL,
-      0x6C0695EDL, 0x1B01A57BL, 0x8208F4C1L, 0xF50FC457L,
-      0x65B0D9C6L, 0x12B7E950L, 0x8BBEB8EAL, 0xFCB9887CL,
-      0x62DD1DDFL, 0x15DA2D49L, 0x8CD37CF3L, 0xFBD44C65L,
-      0x4DB26158L, 0x3AB551CEL, 0xA3BC0074L, 0xD4BB30E2L,
-      0x4ADFA541L, 0x3DD895D7L, 0xA4D1C46DL, 0xD3D6F4FBL,
-      0x4369E96AL, 0x346ED9FCL, 0xAD678846L, 0xDA60B8D0L,
-      0x44042D73L, 0x33031DE5L, 0xAA0A4C5FL, 0xDD0D7CC9L,
-      0x5005713CL, 0x270241AAL, 0xBE0B1010L, 0xC90C2086L,
-      0x5768B525L, 0x206F85B3L, 0xB966D409L, 0xCE61E49FL,
-      0x5EDEF90EL, 0x29D9C998L, 0xB0D09822L, 0xC7D7A8B4L,
-      0x59B33D17L, 0x2EB40D81L, 0xB7BD5C3BL, 0xC0BA6CADL,
-      0xEDB88320L, 0x9ABFB3B6L, 0x03B6E20CL, 0x74B1D29AL,
-      0xEAD54739L, 0x9DD277AFL, 0x04DB2615L, 0x73DC1683L,
-      0xE3630B12L, 0x94643B84L, 0x0D6D6A3EL, 0x7A6A5AA8L,
-      0xE40ECF0BL, 0x9309FF9DL, 0x0A00AE27L, 0x7D079EB1L,
-      0xF00F9344L, 0x8708A3D2L, 0x1E01F268L, 0x6906C2FEL,
-      0xF762575DL, 0x806567CBL, 0x196C3671L, 0x6E6B06E7L,
-      0xFED41B76L, 0x89D32BE0L, 0x10DA7A5AL, 0x67DD4ACCL,
-      0xF9B9DF6FL, 0x8EBEEFF9L, 0x17B7BE43L, 0x60B08ED5L,
-      0xD6D6A3E8L, 0xA1D1937EL, 0x38D8C2C4L, 0x4FDFF252L,
-      0xD1BB67F1L, 0xA6BC5767L, 0x3FB506DDL, 0x48B2364BL,
-      0xD80D2BDAL, 0xAF0A1B4CL, 0x36034AF6L, 0x41047A60L,
-      0xDF60EFC3L, 0xA867DF55L, 0x316E8EEFL, 0x4669BE79L,
-      0xCB61B38CL, 0xBC66831AL, 0x256FD2A0L, 0x5268E236L,
-      0xCC0C7795L, 0xBB0B4703L, 0x220216B9L, 0x5505262FL,
-      0xC5BA3BBEL, 0xB2BD0B28L, 0x2BB45A92L, 0x5CB36A04L,
-      0xC2D7FFA7L, 0xB5D0CF31L, 0x2CD99E8BL, 0x5BDEAE1DL,
-      0x9B64C2B0L, 0xEC63F226L, 0x756AA39CL, 0x026D930AL,
-      0x9C0906A9L, 0xEB0E363FL, 0x72076785L, 0x05005713L,
-      0x95BF4A82L, 0xE2B87A14L, 0x7BB12BAEL, 0x0CB61B38L,
-      0x92D28E9BL, 0xE5D5BE0DL, 0x7CDCEFB7L, 0x0BDBDF21L,
-      0x86D3D2D4L, 0xF1D4E242L, 0x68DDB3F8L, 0x1FDA836EL,
-      0x81BE16CDL, 0xF6B9265BL, 0x6FB077E1L, 0x18B74777L,
-      0x88085AE6L, 0xFF0F6A70L, 0x66063BCAL, 0x11010B5CL,
-      0x8F659EFFL, 0xF862AE69L, 0x616BFFD3L, 0x166CCF45L,
-      0xA00AE278L, 0xD70DD2EEL, 0x4E048354L, 0x3903B3C2L,
-      0xA7672661L, 0xD06016F7L, 0x4969474DL, 0x3E6E77DBL,
-      0xAED16A4AL, 0xD9D65ADCL, 0x40DF0B66L, 0x37D83BF0L,
-      0xA9BCAE53L, 0xDEBB9EC5L, 0x47B2CF7FL, 0x30B5FFE9L,
-      0xBDBDF21CL, 0xCABAC28AL, 0x53B39330L, 0x24B4A3A6L,
-      0xBAD03605L, 0xCDD70693L, 0x54DE5729L, 0x23D967BFL,
-      0xB3667A2EL, 0xC4614AB8L, 0x5D681B02L, 0x2A6F2B94L,
-      0xB40BBE37L, 0xC30C8EA1L, 0x5A05DF1BL, 0x2D02EF8DL
+      {
+        0x00000000L, 0xF26B8303L, 0xE13B70F7L, 0x1350F3F4L,
+        0xC79A971FL, 0x35F1141CL, 0x26A1E7E8L, 0xD4CA64EBL,
+        0x8AD958CFL, 0x78B2DBCCL, 0x6BE22838L, 0x9989AB3BL,
+        0x4D43CFD0L, 0xBF284CD3L, 0xAC78BF27L, 0x5E133C24L,
+        0x105EC76FL, 0xE235446CL, 0xF165B798L, 0x030E349BL,
+        0xD7C45070L, 0x25AFD373L, 0x36FF2087L, 0xC494A384L,
+        0x9A879FA0L, 0x68EC1CA3L, 0x7BBCEF57L, 0x89D76C54L,
+        0x5D1D08BFL, 0xAF768BBCL, 0xBC267848L, 0x4E4DFB4BL,
+        0x20BD8EDEL, 0xD2D60DDDL, 0xC186FE29L, 0x33ED7D2AL,
+        0xE72719C1L, 0x154C9AC2L, 0x061C6936L, 0xF477EA35L,
+        0xAA64D611L, 0x580F5512L, 0x4B5FA6E6L, 0xB93425E5L,
+        0x6DFE410EL, 0x9F95C20DL, 0x8CC531F9L, 0x7EAEB2FAL,
+        0x30E349B1L, 0xC288CAB2L, 0xD1D83946L, 0x23B3BA45L,
+        0xF779DEAEL, 0x05125DADL, 0x1642AE59L, 0xE4292D5AL,
+        0xBA3A117EL, 0x4851927DL, 0x5B016189L, 0xA96AE28AL,
+        0x7DA08661L, 0x8FCB0562L, 0x9C9BF696L, 0x6EF07595L,
+        0x417B1DBCL, 0xB3109EBFL, 0xA0406D4BL, 0x522BEE48L,
+        0x86E18AA3L, 0x748A09A0L, 0x67DAFA54L, 0x95B17957L,
+        0xCBA24573L, 0x39C9C670L, 0x2A993584L, 0xD8F2B687L,
+        0x0C38D26CL, 0xFE53516FL, 0xED03A29BL, 0x1F682198L,
+        0x5125DAD3L, 0xA34E59D0L, 0xB01EAA24L, 0x42752927L,
+        0x96BF4DCCL, 0x64D4CECFL, 0x77843D3BL, 0x85EFBE38L,
+        0xDBFC821CL, 0x2997011FL, 0x3AC7F2EBL, 0xC8AC71E8L,
+        0x1C661503L, 0xEE0D9600L, 0xFD5D65F4L, 0x0F36E6F7L,
+        0x61C69362L, 0x93AD1061L, 0x80FDE395L, 0x72966096L,
+        0xA65C047DL, 0x5437877EL, 0x4767748AL, 0xB50CF789L,
+        0xEB1FCBADL, 0x197448AEL, 0x0A24BB5AL, 0xF84F3859L,
+        0x2C855CB2L, 0xDEEEDFB1L, 0xCDBE2C45L, 0x3FD5AF46L,
+        0x7198540DL, 0x83F3D70EL, 0x90A324FAL, 0x62C8A7F9L,
+        0xB602C312L, 0x44694011L, 0x5739B3E5L, 0xA55230E6L,
+        0xFB410CC2L, 0x092A8FC1L, 0x1A7A7C35L, 0xE811FF36L,
+        0x3CDB9BDDL, 0xCEB018DEL, 0xDDE0EB2AL, 0x2F8B6829L,
+        0x82F63B78L, 0x709DB87BL, 0x63CD4B8FL, 0x91A6C88CL,
+        0x456CAC67L, 0xB7072F64L, 0xA457DC90L, 0x563C5F93L,
+        0x082F63B7L, 0xFA44E0B4L, 0xE9141340L, 0x1B7F9043L,
+        0xCFB5F4A8L, 0x3DDE77ABL, 0x2E8E845FL, 0xDCE5075CL,
+        0x92A8FC17L, 0x60C37F14L, 0x73938CE0L, 0x81F80FE3L,
+        0x55326B08L, 0xA759E80BL, 0xB4091BFFL, 0x466298FCL,
+        0x1871A4D8L, 0xEA1A27DBL, 0xF94AD42FL, 0x0B21572CL,
+        0xDFEB33C7L, 0x2D80B0C4L, 0x3ED04330L, 0xCCBBC033L,
+        0xA24BB5A6L, 0x502036A5L, 0x4370C551L, 0xB11B4652L,
+        0x65D122B9L, 0x97BAA1BAL, 0x84EA524EL, 0x7681D14DL,
+        0x2892ED69L, 0xDAF96E6AL, 0xC9A99D9EL, 0x3BC21E9DL,
+        0xEF087A76L, 0x1D63F975L, 0x0E330A81L, 0xFC588982L,
+        0xB21572C9L, 0x407EF1CAL, 0x532E023EL, 0xA145813DL,
+        0x758FE5D6L, 0x87E466D5L, 0x94B49521L, 0x66DF1622L,
+        0x38CC2A06L, 0xCAA7A905L, 0xD9F75AF1L, 0x2B9CD9F2L,
+        0xFF56BD19L, 0x0D3D3E1AL, 0x1E6DCDEEL, 0xEC064EEDL,
+        0xC38D26C4L, 0x31E6A5C7L, 0x22B65633L, 0xD0DDD530L,
+        0x0417B1DBL, 0xF67C32D8L, 0xE52CC12CL, 0x1747422FL,
+        0x49547E0BL, 0xBB3FFD08L, 0xA86F0EFCL, 0x5A048DFFL,
+        0x8ECEE914L, 0x7CA56A17L, 0x6FF599E3L, 0x9D9E1AE0L,
+        0xD3D3E1ABL, 0x21B862A8L, 0x32E8915CL, 0xC083125FL,
+        0x144976B4L, 0xE622F5B7L, 0xF5720643L, 0x07198540L,
+        0x590AB964L, 0xAB613A67L, 0xB831C993L, 0x4A5A4A90L,
+        0x9E902E7BL, 0x6CFBAD78L, 0x7FAB5E8CL, 0x8DC0DD8FL,
+        0xE330A81AL, 0x115B2B19L, 0x020BD8EDL, 0xF0605BEEL,
+        0x24AA3F05L, 0xD6C1BC06L, 0xC5914FF2L, 0x37FACCF1L,
+        0x69E9F0D5L, 0x9B8273D6L, 0x88D28022L, 0x7AB90321L,
+        0xAE7367CAL, 0x5C18E4C9L, 0x4F48173DL, 0xBD23943EL,
+        0xF36E6F75L, 0x0105EC76L, 0x12551F82L, 0xE03E9C81L,
+        0x34F4F86AL, 0xC69F7B69L, 0xD5CF889DL, 0x27A40B9EL,
+        0x79B737BAL, 0x8BDCB4B9L, 0x988C474DL, 0x6AE7C44EL,
+        0xBE2DA0A5L, 0x4C4623A6L, 0x5F16D052L, 0xAD7D5351L
+      },
+      {
+        0x00000000L, 0x13A29877L, 0x274530EEL, 0x34E7A899L,
+        0x4E8A61DCL, 0x5D28F9ABL, 0x69CF5132L, 0x7A6DC945L,
+        0x9D14C3B8L, 0x8EB65BCFL, 0xBA51F356L, 0xA9F36B21L,
+        0xD39EA264L, 0xC03C3A13L, 0xF4DB928AL, 0xE7790AFDL,
+        0x3FC5F181L, 0x2C6769F6L, 0x1880C16FL, 0x0B225918L,
+        0x714F905DL, 0x62ED082AL, 0x560AA0B3L, 0x45A838C4L,
+        0xA2D13239L, 0xB173AA4EL, 0x859402D7L, 0x96369AA0L,
+        0xEC5B53E5L, 0xFFF9CB92L, 0xCB1E630BL, 0xD8BCFB7CL,
+        0x7F8BE302L, 0x6C297B75L, 0x58CED3ECL, 0x4B6C4B9BL,
+        0x310182DEL, 0x22A31AA9L, 0x1644B230L, 0x05E62A47L,
+        0xE29F20BAL, 0xF13DB8CDL, 0xC5DA1054L, 0xD6788823L,
+        0xAC154166L, 0xBFB7D911L, 0x8B507188L, 0x98F2E9FFL,
+        0x404E1283L, 0x53EC8AF4L, 0x670B226DL, 0x74A9BA1AL,
+        0x0EC4735FL, 0x1D66EB28L, 0x298143B1L, 0x3A23DBC6L,
+        0xDD5AD13BL, 0xCEF8494CL, 0xFA1FE1D5L, 0xE9BD79A2L,
+        0x93D0B0E7L, 0x80722890L, 0xB4958009L, 0xA737187EL,
+        0xFF17C604L, 0xECB55E73L, 0xD852F6EAL, 0xCBF06E9DL,
+        0xB19DA7D8L, 0xA23F3FAFL, 0x96D89736L, 0x857A0F41L,
+        0x620305BCL, 0x71A19DCBL, 0x45463552L, 0x56E4AD25L,
+        0x2C896460L, 0x3F2BFC17L, 0x0BCC548EL, 0x186ECCF9L,
+        0xC0D23785L, 0xD370AFF2L, 0xE797076BL, 0xF4359F1CL,
+        0x8E585659L, 0x9DFACE2EL, 0xA91D66B7L, 0xBABFFEC0L,
+        0x5DC6F43DL, 0x4E646C4AL, 0x7A83C4D3L, 0x69215CA4L,
+        0x134C95E1L, 0x00EE0D96L, 0x3409A50FL, 0x27AB3D78L,
+        0x809C2506L, 0x933EBD71L, 0xA7D915E8L, 0xB47B8D9FL,
+        0xCE1644DAL, 0xDDB4DCADL, 0xE9537434L, 0xFAF1EC43L,
+        0x1D88E6BEL, 0x0E2A7EC9L, 0x3ACDD650L, 0x296F4E27L,
+        0x53028762L, 0x40A01F15L, 0x7447B78CL, 0x67E52FFBL,
+        0xBF59D487L, 0xACFB4CF0L, 0x981CE469L, 0x8BBE7C1EL,
+        0xF1D3B55BL, 0xE2712D2CL, 0xD69685B5L, 0xC5341DC2L,
+        0x224D173FL, 0x31EF8F48L, 0x050827D1L, 0x16AABFA6L,
+        0x6CC776E3L, 0x7F65EE94L, 0x4B82460DL, 0x5820DE7AL,
+        0xFBC3FAF9L, 0xE861628EL, 0xDC86CA17L, 0xCF245260L,
+        0xB5499B25L, 0xA6EB0352L, 0x920CABCBL, 0x81AE33BCL,
+        0x66D73941L, 0x7575A136L, 0x419209AFL, 0x523091D8L,
+        0x285D589DL, 0x3BFFC0EAL, 0x0F186873L, 0x1CBAF004L,
+        0xC4060B78L, 0xD7A4930FL, 0xE3433B96L, 0xF0E1A3E1L,
+        0x8A8C6AA4L, 0x992EF2D3L, 0xADC95A4AL, 0xBE6BC23DL,
+        0x5912C8C0L, 0x4AB050B7L, 0x7E57F82EL, 0x6DF56059L,
+        0x1798A91CL, 0x043A316BL, 0x30DD99F2L, 0x237F0185L,
+        0x844819FBL, 0x97EA818CL, 0xA30D2915L, 0xB0AFB162L,
+        0xCAC27827L, 0xD960E050L, 0xED8748C9L, 0xFE25D0BEL,
+        0x195CDA43L, 0x0AFE4234L, 0x3E19EAADL, 0x2DBB72DAL,
+        0x57D6BB9FL, 0x447423E8L, 0x70938B71L, 0x63311306L,
+        0xBB8DE87AL, 0xA82F700DL, 0x9CC8D894L, 0x8F6A40E3L,
+        0xF50789A6L, 0xE6A511D1L, 0xD242B948L, 0xC1E0213FL,
+        0x26992BC2L, 0x353BB3B5L, 0x01DC1B2CL, 0x127E835BL,
+        0x68134A1EL, 0x7BB1D269L, 0x4F567AF0L, 0x5CF4E287L,
+        0x04D43CFDL, 0x1776A48AL, 0x23910C13L, 0x30339464L,
+        0x4A5E5D21L, 0x59FCC556L, 0x6D1B6DCFL, 0x7EB9F5B8L,
+        0x99C0FF45L, 0x8A626732L, 0xBE85CFABL, 0xAD2757DCL,
+        0xD74A9E99L, 0xC4E806EEL, 0xF00FAE77L, 0xE3AD3600L,
+        0x3B11CD7CL, 0x28B3550BL, 0x1C54FD92L, 0x0FF665E5L,
+        0x759BACA0L, 0x663934D7L, 0x52DE9C4EL, 0x417C0439L,
+        0xA6050EC4L, 0xB5A796B3L, 0x81403E2AL, 0x92E2A65DL,
+        0xE88F6F18L, 0xFB2DF76FL, 0xCFCA5FF6L, 0xDC68C781L,
+        0x7B5FDFFFL, 0x68FD4788L, 0x5C1AEF11L, 0x4FB87766L,
+        0x35D5BE23L, 0x26772654L, 0x12908ECDL, 0x013216BAL,
+        0xE64B1C47L, 0xF5E98430L, 0xC10E2CA9L, 0xD2ACB4DEL,
+        0xA8C17D9BL, 0xBB63E5ECL, 0x8F844D75L, 0x9C26D502L,
+        0x449A2E7EL, 0x5738B609L, 0x63DF1E90L, 0x707D86E7L,
+        0x0A104FA2L, 0x19B2D7D5L, 0x2D557F4CL, 0x3EF7E73BL,
+        0xD98EEDC6L, 0xCA2C75B1L, 0xFECBDD28L, 0xED69455FL,
+        0x97048C1AL, 0x84A6146DL, 0xB041BCF4L, 0xA3E32483L
+      },
+      {
+        0x00000000L, 0xA541927EL, 0x4F6F520DL, 0xEA2EC073L,
+        0x9EDEA41AL, 0x3B9F3664L, 0xD1B1F617L, 0x74F06469L,
+        0x38513EC5L, 0x9D10ACBBL, 0x773E6CC8L, 0xD27FFEB6L,
+        0xA68F9ADFL, 0x03CE08A1L, 0xE9E0C8D2L, 0x4CA15AACL,
+        0x70A27D8AL, 0xD5E3EFF4L, 0x3FCD2F87L, 0x9A8CBDF9L,
+        0xEE7CD990L, 0x4B3D4BEEL, 0xA1138B9DL, 0x045219E3L,
+        0x48F3434FL, 0xEDB2D131L, 0x079C1142L, 0xA2DD833CL,
+        0xD62DE755L, 0x736C752BL, 0x9942B558L, 0x3C032726L,
+        0xE144FB14L, 0x4405696AL, 0xAE2BA919L, 0x0B6A3B67L,
+        0x7F9A5F0EL, 0xDADBCD70L, 0x30F50D03L, 0x95B49F7DL,
+        0xD915C5D1L, 0x7C5457AFL, 0x967A97DCL, 0x333B05A2L,
+        0x47CB61CBL, 0xE28AF3B5L, 0x08A433C6L, 0xADE5A1B8L,
+        0x91E6869EL, 0x34A714E0L, 0xDE89D493L, 0x7BC846EDL,
+        0x0F382284L, 0xAA79B0FAL, 0x40577089L, 0xE516E2F7L,
+        0xA9B7B85BL, 0x0CF62A25L, 0xE6D8EA56L, 0x43997828L,
+        0x37691C41L, 0x92288E3FL, 0x78064E4CL, 0xDD47DC32L,
+        0xC76580D9L, 0x622412A7L, 0x880AD2D4L, 0x2D4B40AAL,
+        0x59BB24C3L, 0xFCFAB6BDL, 0x16D476CEL, 0xB395E4B0L,
+        0xFF34BE1CL, 0x5A752C62L, 0xB05BEC11L, 0x151A7E6FL,
+        0x61EA1A06L, 0xC4AB8878L, 0x2E85480BL, 0x8BC4DA75L,
+        0xB7C7FD53L, 0x12866F2DL, 0xF8A8AF5EL, 0x5DE93D20L,
+        0x29195949L, 0x8C58CB37L, 0x66760B44L, 0xC337993AL,
+        0x8F96C396L, 0x2AD751E8L, 0xC0F9919BL, 0x65B803E5L,
+        0x1148678CL, 0xB409F5F2L, 0x5E273581L, 0xFB66A7FFL,
+        0x26217BCDL, 0x8360E9B3L, 0x694E29C0L, 0xCC0FBBBEL,
+        0xB8FFDFD7L, 0x1DBE4DA9L, 0xF7908DDAL, 0x52D11FA4L,
+        0x1E704508L, 0xBB31D776L, 0x511F1705L, 0xF45E857BL,
+        0x80AEE112L, 0x25EF736CL, 0xCFC1B31FL, 0x6A802161L,
+        0x56830647L, 0xF3C29439L, 0x19EC544AL, 0xBCADC634L,
+        0xC85DA25DL, 0x6D1C3023L, 0x8732F050L, 0x2273622EL,
+        0x6ED23882L, 0xCB93AAFCL, 0x21BD6A8FL, 0x84FCF8F1L,
+        0xF00C9C98L, 0x554D0EE6L, 0xBF63CE95L, 0x1A225CEBL,
+        0x8B277743L, 0x2E66E53DL, 0xC448254EL, 0x6109B730L,
+        0x15F9D359L, 0xB0B84127L, 0x5A968154L, 0xFFD7132AL,
+        0xB3764986L, 0x1637DBF8L, 0xFC191B8BL, 0x595889F5L,
+        0x2DA8ED9CL, 0x88E97FE2L, 0x62C7BF91L, 0xC7862DEFL,
+        0xFB850AC9L, 0x5EC498B7L, 0xB4EA58C4L, 0x11ABCABAL,
+        0x655BAED3L, 0xC01A3CADL, 0x2A34FCDEL, 0x8F756EA0L,
+        0xC3D4340CL, 0x6695A672L, 0x8CBB6601L, 0x29FAF47FL,
+        0x5D0A9016L, 0xF84B0268L, 0x1265C21BL, 0xB7245065L,
+        0x6A638C57L, 0xCF221E29L, 0x250CDE5AL, 0x804D4C24L,
+        0xF4BD284DL, 0x51FCBA33L, 0xBBD27A40L, 0x1E93E83EL,
+        0x5232B292L, 0xF77320ECL, 0x1D5DE09FL, 0xB81C72E1L,
+        0xCCEC1688L, 0x69AD84F6L, 0x83834485L, 0x26C2D6FBL,
+        0x1AC1F1DDL, 0xBF8063A3L, 0x55AEA3D0L, 0xF0EF31AEL,
+        0x841F55C7L, 0x215EC7B9L, 0xCB7007CAL, 0x6E3195B4L,
+        0x2290CF18L, 0x87D15D66L, 0x6DFF9D15L, 0xC8BE0F6BL,
+        0xBC4E6B02L, 0x190FF97CL, 0xF321390FL, 0x5660AB71L,
+        0x4C42F79AL, 0xE90365E4L, 0x032DA597L, 0xA66C37E9L,
+        0xD29C5380L, 0x77DDC1FEL, 0x9DF3018DL, 0x38B293F3L,
+        0x7413C95FL, 0xD1525B21L, 0x3B7C9B52L, 0x9E3D092CL,
+        0xEACD6D45L, 0x4F8CFF3BL, 0xA5A23F48L, 0x00E3AD36L,
+        0x3CE08A10L, 0x99A1186EL, 0x738FD81DL, 0xD6CE4A63L,
+        0xA23E2E0AL, 0x077FBC74L, 0xED517C07L, 0x4810EE79L,
+        0x04B1B4D5L, 0xA1F026ABL, 0x4BDEE6D8L, 0xEE9F74A6L,
+        0x9A6F10CFL, 0x3F2E82B1L, 0xD50042C2L, 0x7041D0BCL,
+        0xAD060C8EL, 0x08479EF0L, 0xE2695E83L, 0x4728CCFDL,
+        0x33D8A894L, 0x96993AEAL, 0x7CB7FA99L, 0xD9F668E7L,
+        0x9557324BL, 0x3016A035L, 0xDA386046L, 0x7F79F238L,
+        0x0B899651L, 0xAEC8042FL, 0x44E6C45CL, 0xE1A75622L,
+        0xDDA47104L, 0x78E5E37AL, 0x92CB2309L, 0x378AB177L,
+        0x437AD51EL, 0xE63B4760L, 0x0C158713L, 0xA954156DL,
+        0xE5F54FC1L, 0x40B4DDBFL, 0xAA9A1DCCL, 0x0FDB8FB2L,
+        0x7B2BEBDBL, 0xDE6A79A5L, 0x3444B9D6L, 0x91052BA8L
+      },
+      {
+        0x00000000L, 0xDD45AAB8L, 0xBF672381L, 0x62228939L,
+        0x7B2231F3L, 0xA6679B4BL, 0xC4451272L, 0x1900B8CAL,
+        0xF64463E6L, 0x2B01C95EL, 0x49234067L, 0x9466EADFL,
+        0x8D665215L, 0x5023F8ADL, 0x32017194L, 0xEF44DB2CL,
+        0xE964B13DL, 0x34211B85L, 0x560392BCL, 0x8B463804L,
+        0x924680CEL, 0x4F032A76L, 0x2D21A34FL, 0xF06409F7L,
+        0x1F20D2DBL, 0xC2657863L, 0xA047F15AL, 0x7D025BE2L,
+        0x6402E328L, 0xB9474990L, 0xDB65C0A9L, 0x06206A11L,
+        0xD725148BL, 0x0A60BE33L, 0x6842370AL, 0xB5079DB2L,
+        0xAC072578L, 0x71428FC0L, 0x136006F9L, 0xCE25AC41L,
+        0x2161776DL, 0xFC24DDD5L, 0x9E0654ECL, 0x4343FE54L,
+        0x5A43469EL, 0x8706EC26L, 0xE524651FL, 0x3861CFA7L,
+        0x3E41A5B6L, 0xE3040F0EL, 0x81268637L, 0x5C632C8FL,
+        0x45639445L, 0x98263EFDL, 0xFA04B7C4L, 0x27411D7CL,
+        0xC805C650L, 0x15406CE8L, 0x7762E5D1L, 0xAA274F69L,
+        0xB327F7A3L, 0x6E625D1BL, 0x0C40D422L, 0xD1057E9AL,
+        0xABA65FE7L, 0x76E3F55FL, 0x14C17C66L, 0xC984D6DEL,
+        0xD0846E14L, 0x0DC1C4ACL, 0x6FE34D95L, 0xB2A6E72DL,
+        0x5DE23C01L, 0x80A796B9L, 0xE2851F80L, 0x3FC0B538L,
+        0x26C00DF2L, 0xFB85A74AL, 0x99A72E73L, 0x44E284CBL,
+        0x42C2EEDAL, 0x9F874462L, 0xFDA5CD5BL, 0x20E067E3L,
+        0x39E0DF29L, 0xE4A57591L, 0x8687FCA8L, 0x5BC25610L,
+        0xB4868D3CL, 0x69C32784L, 0x0BE1AEBDL, 0xD6A40405L,
+        0xCFA4BCCFL, 0x12E11677L, 0x70C39F4EL, 0xAD8635F6L,
+        0x7C834B6CL, 0xA1C6E1D4L, 0xC3E468EDL, 0x1EA1C255L,
+        0x07A17A9FL, 0xDAE4D027L, 0xB8C6591EL, 0x6583F3A6L,
+        0x8AC7288AL, 0x57828232L, 0x35A00B0BL, 0xE8E5A1B3L,
+        0xF1E51979L, 0x2CA0B3C1L, 0x4E823AF8L, 0x93C79040L,
+        0x95E7FA51L, 0x48A250E9L, 0x2A80D9D0L, 0xF7C57368L,
+        0xEEC5CBA2L, 0x3380611AL, 0x51A2E823L, 0x8CE7429BL,
+        0x63A399B7L, 0xBEE6330FL, 0xDCC4BA36L, 0x0181108EL,
+        0x1881A844L, 0xC5C402FCL, 0xA7E68BC5L, 0x7AA3217DL,
+        0x52A0C93FL, 0x8FE56387L, 0xEDC7EABEL, 0x30824006L,
+        0x2982F8CCL, 0xF4C75274L, 0x96E5DB4DL, 0x4BA071F5L,
+        0xA4E4AAD9L, 0x79A10061L, 0x1B838958L, 0xC6C623E0L,
+        0xDFC69B2AL, 0x02833192L, 0x60A1B8ABL, 0xBDE41213L,
+        0xBBC47802L, 0x6681D2BAL, 0x04A35B83L, 0xD9E6F13BL,
+        0xC0E649F1L, 0x1DA3E349L, 0x7F816A70L, 0xA2C4C0C8L,
+        0x4D801BE4L, 0x90C5B15CL, 0xF2E73865L, 0x2FA292DDL,
+        0x36A22A17L, 0xEBE780AFL, 0x89C50996L, 0x5480A32EL,
+        0x8585DDB4L, 0x58C0770CL, 0x3AE2FE35L, 0xE7A7548DL,
+        0xFEA7EC47L, 0x23E246FFL, 0x41C0CFC6L, 0x9C85657EL,
+        0x73C1BE52L, 0xAE8414EAL, 0xCCA69DD3L, 0x11E3376BL,
+        0x08E38FA1L, 0xD5A62519L, 0xB784AC20L, 0x6AC10698L,
+        0x6CE16C89L, 0xB1A4C631L, 0xD3864F08L, 0x0EC3E5B0L,
+        0x17C35D7AL, 0xCA86F7C2L, 0xA8A47EFBL, 0x75E1D443L,
+        0x9AA50F6FL, 0x47E0A5D7L, 0x25C22CEEL, 0xF8878656L,
+        0xE1873E9CL, 0x3CC29424L, 0x5EE01D1DL, 0x83A5B7A5L,
+        0xF90696D8L, 0x24433C60L, 0x4661B559L, 0x9B241FE1L,
+        0x8224A72BL, 0x5F610D93L, 0x3D4384AAL, 0xE0062E12L,
+        0x0F42F53EL, 0xD2075F86L, 0xB025D6BFL, 0x6D607C07L,
+        0x7460C4CDL, 0xA9256E75L, 0xCB07E74CL, 0x16424DF4L,
+        0x106227E5L, 0xCD278D5DL, 0xAF050464L, 0x7240AEDCL,
+        0x6B401616L, 0xB605BCAEL, 0xD4273597L, 0x09629F2FL,
+        0xE6264403L, 0x3B63EEBBL, 0x59416782L, 0x8404CD3AL,
+        0x9D0475F0L, 0x4041DF48L, 0x22635671L, 0xFF26FCC9L,
+        0x2E238253L, 0xF36628EBL, 0x9144A1D2L, 0x4C010B6AL,
+        0x5501B3A0L, 0x88441918L, 0xEA669021L, 0x37233A99L,
+        0xD867E1B5L, 0x05224B0DL, 0x6700C234L, 0xBA45688CL,
+        0xA345D046L, 0x7E007AFEL, 0x1C22F3C7L, 0xC167597FL,
+        0xC747336EL, 0x1A0299D6L, 0x782010EFL, 0xA565BA57L,
+        0xBC65029DL, 0x6120A825L, 0x0302211CL, 0xDE478BA4L,
+        0x31035088L, 0xEC46FA30L, 0x8E647309L, 0x5321D9B1L,
+        0x4A21617BL, 0x9764CBC3L, 0xF54642FAL, 0x2803E842L
+      },
+      {
+        0x00000000L, 0x38116FACL, 0x7022DF58L, 0x4833B0F4L,
+        0xE045BEB0L, 0xD854D11CL, 0x906761E8L, 0xA8760E44L,
+        0xC5670B91L, 0xFD76643DL, 0xB545D4C9L, 0x8D54BB65L,
+        0x2522B521L, 0x1D33DA8DL, 0x55006A79L, 0x6D1105D5L,
+        0x8F2261D3L, 0xB7330E7FL, 0xFF00BE8BL, 0xC711D127L,
+        0x6F67DF63L, 0x5776B0CFL, 0x1F45003BL, 0x27546F97L,
+        0x4A456A42L, 0x725405EEL, 0x3A67B51AL, 0x0276DAB6L,
+        0xAA00D4F2L, 0x9211BB5EL, 0xDA220BAAL, 0xE2336406L,
+        0x1BA8B557L, 0x23B9DAFBL, 0x6B8A6A0FL, 0x539B05A3L,
+        0xFBED0BE7L, 0xC3FC644BL, 0x8BCFD4BFL, 0xB3DEBB13L,
+        0xDECFBEC6L, 0xE6DED16AL, 0xAEED619EL, 0x96FC0E32L,
+        0x3E8A0076L, 0x069B6FDAL, 0x4EA8DF2EL, 0x76B9B082L,
+        0x948AD484L, 0xAC9BBB28L, 0xE4A80BDCL, 0xDCB96470L,
+        0x74CF6A34L, 0x4CDE0598L, 0x04EDB56CL, 0x3CFCDAC0L,
+        0x51EDDF15L, 0x69FCB0B9L, 0x21CF004DL, 0x19DE6FE1L,
+        0xB1A861A5L, 0x89B90E09L, 0xC18ABEFDL, 0xF99BD151L,
+        0x37516AAEL, 0x0F400502L, 0x4773B5F6L, 0x7F62DA5AL,
+        0xD714D41EL, 0xEF05BBB2L, 0xA7360B46L, 0x9F2764EAL,
+        0xF236613FL, 0xCA270E93L, 0x8214BE67L, 0xBA05D1CBL,
+        0x1273DF8FL, 0x2A62B023L, 0x625100D7L, 0x5A406F7BL,
+        0xB8730B7DL, 0x806264D1L, 0xC851D425L, 0xF040BB89L,
+        0x5836B5CDL, 0x6027DA61L, 0x28146A95L, 0x10050539L,
+        0x7D1400ECL, 0x45056F40L, 0x0D36DFB4L, 0x3527B018L,
+        0x9D51BE5CL, 0xA540D1F0L, 0xED736104L, 0xD5620EA8L,
+        0x2CF9DFF9L, 0x14E8B055L, 0x5CDB00A1L, 0x64CA6F0DL,
+        0xCCBC6149L, 0xF4AD0EE5L, 0xBC9EBE11L, 0x848FD1BDL,
+        0xE99ED468L, 0xD18FBBC4L, 0x99BC0B30L, 0xA1AD649CL,
+        0x09DB6AD8L, 0x31CA0574L, 0x79F9B580L, 0x41E8DA2CL,
+        0xA3DBBE2AL, 0x9BCAD186L, 0xD3F96172L, 0xEBE80EDEL,
+        0x439E009AL, 0x7B8F6F36L, 0x33BCDFC2L, 0x0BADB06EL,
+        0x66BCB5BBL, 0x5EADDA17L, 0x169E6AE3L, 0x2E8F054FL,
+        0x86F90B0BL, 0xBEE864A7L, 0xF6DBD453L, 0xCECABBFFL,
+        0x6EA2D55CL, 0x56B3BAF0L, 0x1E800A04L, 0x269165A8L,
+        0x8EE76BECL, 0xB6F60440L, 0xFEC5B4B4L, 0xC6D4DB18L,
+        0xABC5DECDL, 0x93D4B161L, 0xDBE70195L, 0xE3F66E39L,
+        0x4B80607DL, 0x73910FD1L, 0x3BA2BF25L, 0x03B3D089L,
+        0xE180B48FL, 0xD991DB23L, 0x91A26BD7L, 0xA9B3047BL,
+        0x01C50A3FL, 0x39D46593L, 0x71E7D567L, 0x49F6BACBL,
+        0x24E7BF1EL, 0x1CF6D0B2L, 0x54C56046L, 0x6CD40FEAL,
+        0xC4A201AEL, 0xFCB36E02L, 0xB480DEF6L, 0x8C91B15AL,
+        0x750A600BL, 0x4D1B0FA7L, 0x0528BF53L, 0x3D39D0FFL,
+        0x954FDEBBL, 0xAD5EB117L, 0xE56D01E3L, 0xDD7C6E4FL,
+        0xB06D6B9AL, 0x887C0436L, 0xC04FB4C2L, 0xF85EDB6EL,
+        0x5028D52AL, 0x6839BA86L, 0x200A0A72L, 0x181B65DEL,
+        0xFA2801D8L, 0xC2396E74L, 0x8A0ADE80L, 0xB21BB12CL,
+        0x1A6DBF68L, 0x227CD0C4L, 0x6A4F6030L, 0x525E0F9CL,
+        0x3F4F0A49L, 0x075E65E5L, 0x4F6DD511L, 0x777CBABDL,
+        0xDF0AB4F9L, 0xE71BDB55L, 0xAF286BA1L, 0x9739040DL,
+        0x59F3BFF2L, 0x61E2D05EL, 0x29D160AAL, 0x11C00F06L,
+        0xB9B60142L, 0x81A76EEEL, 0xC994DE1AL, 0xF185B1B6L,
+        0x9C94B463L, 0xA485DBCFL, 0xECB66B3BL, 0xD4A70497L,
+        0x7CD10AD3L, 0x44C0657FL, 0x0CF3D58BL, 0x34E2BA27L,
+        0xD6D1DE21L, 0xEEC0B18DL, 0xA6F30179L, 0x9EE26ED5L,
+        0x36946091L, 0x0E850F3DL, 0x46B6BFC9L, 0x7EA7D065L,
+        0x13B6D5B0L, 0x2BA7BA1CL, 0x63940AE8L, 0x5B856544L,
+        0xF3F36B00L, 0xCBE204ACL, 0x83D1B458L, 0xBBC0DBF4L,
+        0x425B0AA5L, 0x7A4A6509L, 0x3279D5FDL, 0x0A68BA51L,
+        0xA21EB415L, 0x9A0FDBB9L, 0xD23C6B4DL, 0xEA2D04E1L,
+        0x873C0134L, 0xBF2D6E98L, 0xF71EDE6CL, 0xCF0FB1C0L,
+        0x6779BF84L, 0x5F68D028L, 0x175B60DCL, 0x2F4A0F70L,
+        0xCD796B76L, 0xF56804DAL, 0xBD5BB42EL, 0x854ADB82L,
+        0x2D3CD5C6L, 0x152DBA6AL, 0x5D1E0A9EL, 0x650F6532L,
+        0x081E60E7L, 0x300F0F4BL, 0x783CBFBFL, 0x402DD013L,
+        0xE85BDE57L, 0xD04AB1FBL, 0x9879010FL, 0xA0686EA3L
+      },
+      {
+        0x00000000L, 0xEF306B19L, 0xDB8CA0C3L, 0x34BCCBDAL,
+        0xB2F53777L, 0x5DC55C6EL, 0x697997B4L, 0x8649FCADL,
+        0x6006181FL, 0x8F367306L, 0xBB8AB8DCL, 0x54BAD3C5L,
+        0xD2F32F68L, 0x3DC34471L, 0x097F8FABL, 0xE64FE4B2L,
+        0xC00C303EL, 0x2F3C5B27L, 0x1B8090FDL, 0xF4B0FBE4L,
+        0x72F90749L, 0x9DC96C50L, 0xA975A78AL, 0x4645CC93L,
+        0xA00A2821L, 0x4F3A4338L, 0x7B8688E2L, 0x94B6E3FBL,
+        0x12FF1F56L, 0xFDCF744FL, 0xC973BF95L, 0x2643D48CL,
+        0x85F4168DL, 0x6AC47D94L, 0x5E78B64EL, 0xB148DD57L,
+        0x370121FAL, 0xD8314AE3L, 0xEC8D8139L, 0x03BDEA20L,
+        0xE5F20E92L, 0x0AC2658BL, 0x3E7EAE51L, 0xD14EC548L,
+        0x570739E5L, 0xB83752FCL, 0x8C8B9926L, 0x63BBF23FL,
+        0x45F826B3L, 0xAAC84DAAL, 0x9E748670L, 0x7144ED69L,
+        0xF70D11C4L, 0x183D7ADDL, 0x2C81B107L, 0xC3B1DA1EL,
+        0x25FE3EACL, 0xCACE55B5L, 0xFE729E6FL, 0x1142F576L,
+        0x970B09DBL, 0x783B62C2L, 0x4C87A918L, 0xA3B7C201L,
+        0x0E045BEBL, 0xE13430F2L, 0xD588FB28L, 0x3AB89031L,
+        0xBCF16C9CL, 0x53C10785L, 0x677DCC5FL, 0x884DA746L,
+        0x6E0243F4L, 0x813228EDL, 0xB58EE337L, 0x5ABE882EL,
+        0xDCF77483L, 0x33C71F9AL, 0x077BD440L, 0xE84BBF59L,
+        0xCE086BD5L, 0x213800CCL, 0x1584CB16L, 0xFAB4A00FL,
+        0x7CFD5CA2L, 0x93CD37BBL, 0xA771FC61L, 0x48419778L,
+        0xAE0E73CAL, 0x413E18D3L, 0x7582D309L, 0x9AB2B810L,
+        0x1CFB44BDL, 0xF3CB2FA4L, 0xC777E47EL, 0x28478F67L,
+        0x8BF04D66L, 0x64C0267FL, 0x507CEDA5L, 0xBF4C86BCL,
+        0x39057A11L, 0xD6351108L, 0xE289DAD2L, 0x0DB9B1CBL,
+        0xEBF65579L, 0x04C63E60L, 0x307AF5BAL, 0xDF4A9EA3L,
+        0x5903620EL, 0xB6330917L, 0x828FC2CDL, 0x6DBFA9D4L,
+        0x4BFC7D58L, 0xA4CC1641L, 0x9070DD9BL, 0x7F40B682L,
+        0xF9094A2FL, 0x16392136L, 0x2285EAECL, 0xCDB581F5L,
+        0x2BFA6547L, 0xC4CA0E5EL, 0xF076C584L, 0x1F46AE9DL,
+        0x990F5230L, 0x763F3929L, 0x4283F2F3L, 0xADB399EAL,
+        0x1C08B7D6L, 0xF338DCCFL, 0xC7841715L, 0x28B47C0CL,
+        0xAEFD80A1L, 0x41CDEBB8L, 0x75712062L, 0x9A414B7BL,
+        0x7C0EAFC9L, 0x933EC4D0L, 0xA7820F0AL, 0x48B26413L,
+        0xCEFB98BEL, 0x21CBF3A7L, 0x1577387DL, 0xFA475364L,
+        0xDC0487E8L, 0x3334ECF1L, 0x0788272BL, 0xE8B84C32L,
+        0x6EF1B09FL, 0x81C1DB86L, 0xB57D105CL, 0x5A4D7B45L,
+        0xBC029FF7L, 0x5332F4EEL, 0x678E3F34L, 0x88BE542DL,
+        0x0EF7A880L, 0xE1C7C399L, 0xD57B0843L, 0x3A4B635AL,
+        0x99FCA15BL, 0x76CCCA42L, 0x42700198L, 0xAD406A81L,
+        0x2B09962CL, 0xC439FD35L, 0xF08536EFL, 0x1FB55DF6L,
+        0xF9FAB944L, 0x16CAD25DL, 0x22761987L, 0xCD46729EL,
+        0x4B0F8E33L, 0xA43FE52AL, 0x90832EF0L, 0x7FB345E9L,
+        0x59F09165L, 0xB6C0FA7CL, 0x827C31A6L, 0x6D4C5ABFL,
+        0xEB05A612L, 0x0435CD0BL, 0x308906D1L, 0xDFB96DC8L,
+        0x39F6897AL, 0xD6C6E263L, 0xE27A29B9L, 0x0D4A42A0L,
+        0x8B03BE0DL, 0x6433D514L, 0x508F1ECEL, 0xBFBF75D7L,
+        0x120CEC3DL, 0xFD3C8724L, 0xC9804CFEL, 0x26B027E7L,
+        0xA0F9DB4AL, 0x4FC9B053L, 0x7B757B89L, 0x94451090L,
+        0x720AF422L, 0x9D3A9F3BL, 0xA98654E1L, 0x46B63FF8L,
+        0xC0FFC355L, 0x2FCFA84CL, 0x1B736396L, 0xF443088FL,
+        0xD200DC03L, 0x3D30B71AL, 0x098C7CC0L, 0xE6BC17D9L,
+        0x60F5EB74L, 0x8FC5806DL, 0xBB794BB7L, 0x544920AEL,
+        0xB206C41CL, 0x5D36AF05L, 0x698A64DFL, 0x86BA0FC6L,
+        0x00F3F36BL, 0xEFC39872L, 0xDB7F53A8L, 0x344F38B1L,
+        0x97F8FAB0L, 0x78C891A9L, 0x4C745A73L, 0xA344316AL,
+        0x250DCDC7L, 0xCA3DA6DEL, 0xFE816D04L, 0x11B1061DL,
+        0xF7FEE2AFL, 0x18CE89B6L, 0x2C72426CL, 0xC3422975L,
+        0x450BD5D8L, 0xAA3BBEC1L, 0x9E87751BL, 0x71B71E02L,
+        0x57F4CA8EL, 0xB8C4A197L, 0x8C786A4DL, 0x63480154L,
+        0xE501FDF9L, 0x0A3196E0L, 0x3E8D5D3AL, 0xD1BD3623L,
+        0x37F2D291L, 0xD8C2B988L, 0xEC7E7252L, 0x034E194BL,
+        0x8507E5E6L, 0x6A378EFFL, 0x5E8B4525L, 0xB1BB2E3CL
+      },
+      {
+        0x00000000L, 0x68032CC8L, 0xD0065990L, 0xB8057558L,
+        0xA5E0C5D1L, 0xCDE3E919L, 0x75E69C41L, 0x1DE5B089L,
+        0x4E2DFD53L, 0x262ED19BL, 0x9E2BA4C3L, 0xF628880BL,
+        0xEBCD3882L, 0x83CE144AL, 0x3BCB6112L, 0x53C84DDAL,
+        0x9C5BFAA6L, 0xF458D66EL, 0x4C5DA336L, 0x245E8FFEL,
+        0x39BB3F77L, 0x51B813BFL, 0xE9BD66E7L, 0x81BE4A2FL,
+        0xD27607F5L, 0xBA752B3DL, 0x02705E65L, 0x6A7372ADL,
+        0x7796C224L, 0x1F95EEECL, 0xA7909BB4L, 0xCF93B77CL,
+        0x3D5B83BDL, 0x5558AF75L, 0xED5DDA2DL, 0x855EF6E5L,
+        0x98BB466CL, 0xF0B86AA4L, 0x48BD1FFCL, 0x20BE3334L,
+        0x73767EEEL, 0x1B755226L, 0xA370277EL, 0xCB730BB6L,
+        0xD696BB3FL, 0xBE9597F7L, 0x0690E2AFL, 0x6E93CE67L,
+        0xA100791BL, 0xC90355D3L, 0x7106208BL, 0x19050C43L,
+        0x04E0BCCAL, 0x6CE39002L, 0xD4E6E55AL, 0xBCE5C992L,
+        0xEF2D8448L, 0x872EA880L, 0x3F2BDDD8L, 0x5728F110L,
+        0x4ACD4199L, 0x22CE6D51L, 0x9ACB1809L, 0xF2C834C1L,
+        0x7AB7077AL, 0x12B42BB2L, 0xAAB15EEAL, 0xC2B27222L,
+        0xDF57C2ABL, 0xB754EE63L, 0x0F519B3BL, 0x6752B7F3L,
+        0x349AFA29L, 0x5C99D6E1L, 0xE49CA3B9L, 0x8C9F8F71L,
+        0x917A3FF8L, 0xF9791330L, 0x417C6668L, 0x297F4AA0L,
+        0xE6ECFDDCL, 0x8EEFD114L, 0x36EAA44CL, 0x5EE98884L,
+        0x430C380DL, 0x2B0F14C5L, 0x930A619DL, 0xFB094D55L,
+        0xA8C1008FL, 0xC0C22C47L, 0x78C7591FL, 0x10C475D7L,
+        0x0D21C55EL, 0x6522E996L, 0xDD279CCEL, 0xB524B006L,
+        0x47EC84C7L, 0x2FEFA80FL, 0x97EADD57L, 0xFFE9F19FL,
+        0xE20C4116L, 0x8A0F6DDEL, 0x320A1886L, 0x5A09344EL,
+        0x09C17994L, 0x61C2555CL, 0xD9C72004L, 0xB1C40CCCL,
+        0xAC21BC45L, 0xC422908DL, 0x7C27E5D5L, 0x1424C91DL,
+        0xDBB77E61L, 0xB3B452A9L, 0x0BB127F1L, 0x63B20B39L,
+        0x7E57BBB0L, 0x16549778L, 0xAE51E220L, 0xC652CEE8L,
+        0x959A8332L, 0xFD99AFFAL, 0x459CDAA2L, 0x2D9FF66AL,
+        0x307A46E3L, 0x58796A2BL, 0xE07C1F73L, 0x887F33BBL,
+        0xF56E0EF4L, 0x9D6D223CL, 0x25685764L, 0x4D6B7BACL,
+        0x508ECB25L, 0x388DE7EDL, 0x808892B5L, 0xE88BBE7DL,
+        0xBB43F3A7L, 0xD340DF6FL, 0x6B45AA37L, 0x034686FFL,
+        0x1EA33676L, 0x76A01ABEL, 0xCEA56FE6L, 0xA6A6432EL,
+        0x6935F452L, 0x0136D89AL, 0xB933ADC2L, 0xD130810AL,
+        0xCCD53183L, 0xA4D61D4BL, 0x1CD36813L, 0x74D044DBL,
+        0x27180901L, 0x4F1B25C9L, 0xF71E5091L, 0x9F1D7C59L,
+        0x82F8CCD0L, 0xEAFBE018L, 0x52FE9540L, 0x3AFDB988L,
+        0xC8358D49L, 0xA036A181L, 0x1833D4D9L, 0x7030F811L,
+        0x6DD54898L, 0x05D66450L, 0xBDD31108L, 0xD5D03DC0L,
+        0x8618701AL, 0xEE1B5CD2L, 0x561E298AL, 0x3E1D0542L,
+        0x23F8B5CBL, 0x4BFB9903L, 0xF3FEEC5BL, 0x9BFDC093L,
+        0x546E77EFL, 0x3C6D5B27L, 0x84682E7FL, 0xEC6B02B7L,
+        0xF18EB23EL, 0x998D9EF6L, 0x2188EBAEL, 0x498BC766L,
+        0x1A438ABCL, 0x7240A674L, 0xCA45D32CL, 0xA246FFE4L,
+        0xBFA34F6DL, 0xD7A063A5L, 0x6FA516FDL, 0x07A63A35L,
+        0x8FD9098EL, 0xE7DA2546L, 0x5FDF501EL, 0x37DC7CD6L,
+        0x2A39CC5FL, 0x423AE097L, 0xFA3F95CFL, 0x923CB907L,
+        0xC1F4F4DDL, 0xA9F7D815L, 0x11F2AD4DL, 0x79F18185L,
+        0x6414310CL, 0x0C171DC4L, 0xB412689CL, 0xDC114454L,
+        0x1382F328L, 0x7B81DFE0L, 0xC384AAB8L, 0xAB878670L,
+        0xB66236F9L, 0xDE611A31L, 0x66646F69L, 0x0E6743A1L,
+        0x5DAF0E7BL, 0x35AC22B3L, 0x8DA957EBL, 0xE5AA7B23L,
+        0xF84FCBAAL, 0x904CE762L, 0x2849923AL, 0x404ABEF2L,
+        0xB2828A33L, 0xDA81A6FBL, 0x6284D3A3L, 0x0A87FF6BL,
+        0x17624FE2L, 0x7F61632AL, 0xC7641672L, 0xAF673ABAL,
+        0xFCAF7760L, 0x94AC5BA8L, 0x2CA92EF0L, 0x44AA0238L,
+        0x594FB2B1L, 0x314C9E79L, 0x8949EB21L, 0xE14AC7E9L,
+        0x2ED97095L, 0x46DA5C5DL, 0xFEDF2905L, 0x96DC05CDL,
+        0x8B39B544L, 0xE33A998CL, 0x5B3FECD4L, 0x333CC01CL,
+        0x60F48DC6L, 0x08F7A10EL, 0xB0F2D456L, 0xD8F1F89EL,
+        0xC5144817L, 0xAD1764DFL, 0x15121187L, 0x7D113D4FL
+      },
+      {
+        0x00000000L, 0x493C7D27L, 0x9278FA4EL, 0xDB448769L,
+        0x211D826DL, 0x6821FF4AL, 0xB3657823L, 0xFA590504L,
+        0x423B04DAL, 0x0B0779FDL, 0xD043FE94L, 0x997F83B3L,
+        0x632686B7L, 0x2A1AFB90L, 0xF15E7CF9L, 0xB86201DEL,
+        0x847609B4L, 0xCD4A7493L, 0x160EF3FAL, 0x5F328EDDL,
+        0xA56B8BD9L, 0xEC57F6FEL, 0x37137197L, 0x7E2F0CB0L,
+        0xC64D0D6EL, 0x8F717049L, 0x5435F720L, 0x1D098A07L,
+        0xE7508F03L, 0xAE6CF224L, 0x7528754DL, 0x3C14086AL,
+        0x0D006599L, 0x443C18BEL, 0x9F789FD7L, 0xD644E2F0L,
+        0x2C1DE7F4L, 0x65219AD3L, 0xBE651DBAL, 0xF759609DL,
+        0x4F3B6143L, 0x06071C64L, 0xDD439B0DL, 0x947FE62AL,
+        0x6E26E32EL, 0x271A9E09L, 0xFC5E1960L, 0xB5626447L,
+        0x89766C2DL, 0xC04A110AL, 0x1B0E9663L, 0x5232EB44L,
+        0xA86BEE40L, 0xE1579367L, 0x3A13140EL, 0x732F6929L,
+        0xCB4D68F7L, 0x827115D0L, 0x593592B9L, 0x1009EF9EL,
+        0xEA50EA9AL, 0xA36C97BDL, 0x782810D4L, 0x31146DF3L,
+        0x1A00CB32L, 0x533CB615L, 0x8878317CL, 0xC1444C5BL,
+        0x3B1D495FL, 0x72213478L, 0xA965B311L, 0xE059CE36L,
+        0x583BCFE8L, 0x1107B2CFL, 0xCA4335A6L, 0x837F4881L,
+        0x79264D85L, 0x301A30A2L, 0xEB5EB7CBL, 0xA262CAECL,
+        0x9E76C286L, 0xD74ABFA1L, 0x0C0E38C8L, 0x453245EFL,
+        0xBF6B40EBL, 0xF6573DCCL, 0x2D13BAA5L, 0x642FC782L,
+        0xDC4DC65CL, 0x9571BB7BL, 0x4E353C12L, 0x07094135L,
+        0xFD504431L, 0xB46C3916L, 0x6F28BE7FL, 0x2614C358L,
+        0x1700AEABL, 0x5E3CD38CL, 0x857854E5L, 0xCC4429C2L,
+        0x361D2CC6L, 0x7F2151E1L, 0xA465D688L, 0xED59ABAFL,
+        0x553BAA71L, 0x1C07D756L, 0xC743503FL, 0x8E7F2D18L,
+        0x7426281CL, 0x3D1A553BL, 0xE65ED252L, 0xAF62AF75L,
+        0x9376A71FL, 0xDA4ADA38L, 0x010E5D51L, 0x48322076L,
+        0xB26B2572L, 0xFB575855L, 0x2013DF3CL, 0x692FA21BL,
+        0xD14DA3C5L, 0x9871DEE2L, 0x4335598BL, 0x0A0924ACL,
+        0xF05021A8L, 0xB96C5C8FL, 0x6228DBE6L, 0x2B14A6C1L,
+        0x34019664L, 0x7D3DEB43L, 0xA6796C2AL, 0xEF45110DL,
+        0x151C1409L, 0x5C20692EL, 0x8764EE47L, 0xCE589360L,
+        0x763A92BEL, 0x3F06EF99L, 0xE44268F0L, 0xAD7E15D7L,
+        0x572710D3L, 0x1E1B6DF4L, 0xC55FEA9DL, 0x8C6397BAL,
+        0xB0779FD0L, 0xF94BE2F7L, 0x220F659EL, 0x6B3318B9L,
+        0x916A1DBDL, 0xD856609AL, 0x0312E7F3L, 0x4A2E9AD4L,
+        0xF24C9B0AL, 0xBB70E62DL, 0x60346144L, 0x29081C63L,
+        0xD3511967L, 0x9A6D6440L, 0x4129E329L, 0x08159E0EL,
+        0x3901F3FDL, 0x703D8EDAL, 0xAB7909B3L, 0xE2457494L,
+        0x181C7190L, 0x51200CB7L, 0x8A648BDEL, 0xC358F6F9L,
+        0x7B3AF727L, 0x32068A00L, 0xE9420D69L, 0xA07E704EL,
+        0x5A27754AL, 0x131B086DL, 0xC85F8F04L, 0x8163F223L,
+        0xBD77FA49L, 0xF44B876EL, 0x2F0F0007L, 0x66337D20L,
+        0x9C6A7824L, 0xD5560503L, 0x0E12826AL, 0x472EFF4DL,
+        0xFF4CFE93L, 0xB67083B4L, 0x6D3404DDL, 0x240879FAL,
+        0xDE517CFEL, 0x976D01D9L, 0x4C2986B0L, 0x0515FB97L,
+        0x2E015D56L, 0x673D2071L, 0xBC79A718L, 0xF545DA3FL,
+        0x0F1CDF3BL, 0x4620A21CL, 0x9D642575L, 0xD4585852L,
+        0x6C3A598CL, 0x250624ABL, 0xFE42A3C2L, 0xB77EDEE5L,
+        0x4D27DBE1L, 0x041BA6C6L, 0xDF5F21AFL, 0x96635C88L,
+        0xAA7754E2L, 0xE34B29C5L, 0x380FAEACL, 0x7133D38BL,
+        0x8B6AD68FL, 0xC256ABA8L, 0x19122CC1L, 0x502E51E6L,
+        0xE84C5038L, 0xA1702D1FL, 0x7A34AA76L, 0x3308D751L,
+        0xC951D255L, 0x806DAF72L, 0x5B29281BL, 0x1215553CL,
+        0x230138CFL, 0x6A3D45E8L, 0xB179C281L, 0xF845BFA6L,
+        0x021CBAA2L, 0x4B20C785L, 0x906440ECL, 0xD9583DCBL,
+        0x613A3C15L, 0x28064132L, 0xF342C65BL, 0xBA7EBB7CL,
+        0x4027BE78L, 0x091BC35FL, 0xD25F4436L, 0x9B633911L,
+        0xA777317BL, 0xEE4B4C5CL, 0x350FCB35L, 0x7C33B612L,
+        0x866AB316L, 0xCF56CE31L, 0x14124958L, 0x5D2E347FL,
+        0xE54C35A1L, 0xAC704886L, 0x7734CFEFL, 0x3E08B2C8L,
+        0xC451B7CCL, 0x8D6DCAEBL, 0x56294D82L, 0x1F1530A5L
+      }
     };
 
   /*****************************************************************/
-  /*                   End of CRC Lookup Table                     */
+  /*                   End of CRC Lookup Tables                    */
   /*****************************************************************/
-}
 
-#define COMPUTE(var, ch) (var) = (crc_table[(var ^ ch) & 0xFF] ^ (var >> 8))
+  inline ACE_UINT32
+  load32 (const unsigned char *p)
+  {
+    return static_cast<ACE_UINT32> (p[0])
+      | (static_cast<ACE_UINT32> (p[1]) << 8)
+      | (static_cast<ACE_UINT32> (p[2]) << 16)
+      | (static_cast<ACE_UINT32> (p[3]) << 24);
+  }
+
+  /// Slicing-by-8 update of the (inverted) @a crc with @a len bytes;
+  /// @a t is one of the tables above.
+  ACE_UINT32
+  crc_slice8 (const ACE_UINT32 (*t)[256],
+              ACE_UINT32 crc,
+              const unsigned char *p,
+              size_t len)
+  {
+    for (; len >= 8; p += 8, len -= 8)
+      {
+        ACE_UINT32 const one = load32 (p) ^ crc;
+        ACE_UINT32 const two = load32 (p + 4);
+        crc = t[7][one & 0xFF]
+          ^ t[6][(one >> 8) & 0xFF]
+          ^ t[5][(one >> 16) & 0xFF]
+          ^ t[4][one >> 24]
+          ^ t[3][two & 0xFF]
+          ^ t[2][(two >> 8) & 0xFF]
+          ^ t[1][(two >> 16) & 0xFF]
+          ^ t[0][two >> 24];
+      }
+
+    for (; len != 0; ++p, --len)
+      crc = t[0][(crc ^ *p) & 0xFF] ^ (crc >> 8);
+
+    return crc;
+  }
+
+  typedef ACE_UINT32 (*crc32c_update_fn) (ACE_UINT32,
+                                          const unsigned char *,
+                                          size_t);
+
+  ACE_UINT32
+  crc32c_sw (ACE_UINT32 crc, const unsigned char *p, size_t len)
+  {
+    return crc_slice8 (crc32c_table, crc, p, len);
+  }
+
+#if defined (ACE_CRC32C_X86)
+  bool
+  has_sse42 (void)
+  {
+# if defined (_MSC_VER)
+    int info[4];
+    __cpuid (info, 1);
+    return (info[2] & (1 << 20)) != 0;
+# else
+    unsigned int eax, ebx, ecx, edx;
+    return __get_cpuid (1, &eax, &ebx, &ecx, &edx) != 0
+      && (ecx & bit_SSE4_2) != 0;
+# endif /* _MSC_VER */
+  }
+
+  ACE_CRC32C_TARGET ACE_UINT32
+  crc32c_hw (ACE_UINT32 crc, const unsigned char *p, size_t len)
+  {
+    for (; len != 0 && (reinterpret_cast<uintptr_t> (p) & 7) != 0; ++p, --len)
+      crc = _mm_crc32_u8 (crc, *p);
+
+# if defined (__x86_64__) || defined (_M_X64)
+    ACE_UINT64 crc64 = crc;
+    for (; len >= 8; p += 8, len -= 8)
+      {
+        ACE_UINT64 v;
+        ACE_OS::memcpy (&v, p, sizeof v);
+        crc64 = _mm_crc32_u64 (crc64, v);
+      }
+    crc = static_cast<ACE_UINT32> (crc64);
+# endif /* __x86_64__ || _M_X64 */
+
+    for (; len >= 4; p += 4, len -= 4)
+      {
+        unsigned int v;
+        ACE_OS::memcpy (&v, p, sizeof v);
+        crc = _mm_crc32_u32 (crc, v);
+      }
+
+    for (; len != 0; ++p, --len)
+      crc = _mm_crc32_u8 (crc, *p);
+
+    return crc;
+  }
+#elif defined (ACE_CRC32C_ARM)
+  ACE_UINT32
+  crc32c_hw (ACE_UINT32 crc, const unsigned char *p, size_t len)
+  {
+    for (; len != 0 && (reinterpret_cast<uintptr_t> (p) & 7) != 0; ++p, --len)
+      crc = __crc32cb (crc, *p);
+
+    for (; len >= 8; p += 8, len -= 8)
+      {
+        uint64_t v;
+        ACE_OS::memcpy (&v, p, sizeof v);
+        crc = __crc32cd (crc, v);
+      }
+
+    for (; len != 0; ++p, --len)
+      crc = __crc32cb (crc, *p);
+
+    return crc;
+  }
+#endif /* ACE_CRC32C_X86 */
+
+  /// Picks the crc32 instruction when the CPU has it and the table
+  /// driven version otherwise.
+  crc32c_update_fn
+  crc32c_select (void)
+  {
+#if defined (ACE_CRC32C_X86)
+    if (has_sse42 ())
+      return crc32c_hw;
+#elif defined (ACE_CRC32C_ARM)
+    return crc32c_hw;
+#endif /* ACE_CRC32C_X86 */
+    return crc32c_sw;
+  }
+
+  // Set while the library is loaded; a crc32c() call made from a
+  // static constructor that runs earlier finds it still zero and
+  // selects again.
+  crc32c_update_fn crc32c_update = crc32c_select ();
+
+  inline ACE_UINT32
+  crc32c_i (ACE_UINT32 crc, const void *buffer, size_t len)
+  {
+    crc32c_update_fn update = crc32c_update;
+    if (update == 0)
+      update = crc32c_select ();
+    return update (crc, static_cast<const unsigned char *> (buffer), len);
+  }
+}
 
 // Open versioned namespace, if enabled by the user.
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -105,52 +1267,54 @@ ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 ACE_UINT32
 ACE::crc32 (const char *string)
 {
-  ACE_UINT32 crc = 0xFFFFFFFF;
-
-  for (const char *p = string;
-       *p != 0;
-       ++p)
-    {
-      COMPUTE (crc, *p);
-    }
-
-  return ~crc;
+  return ACE::crc32 (string, ACE_OS::strlen (string));
 }
 
 ACE_UINT32
 ACE::crc32 (const void *buffer, size_t len, ACE_UINT32 crc)
+{
+  return ~crc_slice8 (crc_table,
+                      ~crc,
+                      static_cast<const unsigned char *> (buffer),
+                      len);
+}
+
+ACE_UINT32
+ACE::crc32 (const iovec *iov, int len, ACE_UINT32 crc)
 {
   crc = ~crc;
 
-  for (const char *p = (const char *) buffer,
-                  *e = (const char *) buffer + len;
-       p != e;
-       ++p)
-    {
-      COMPUTE (crc, *p);
-    }
+  for (int i = 0; i < len; ++i)
+    crc = crc_slice8 (crc_table,
+                      crc,
+                      (const unsigned char *) iov[i].iov_base,
+                      iov[i].iov_len);
 
   return ~crc;
 }
 
 ACE_UINT32
-ACE::crc32 (const iovec *iov, int len, ACE_UINT32 crc)
+ACE::crc32c (const char *string)
+{
+  return ACE::crc32c (string, ACE_OS::strlen (string));
+}
+
+ACE_UINT32
+ACE::crc32c (const void *buffer, size_t len, ACE_UINT32 crc)
+{
+  return ~crc32c_i (~crc, buffer, len);
+}
+
+ACE_UINT32
+ACE::crc32c (const iovec *iov, int len, ACE_UINT32 crc)
 {
   crc = ~crc;
 
   for (int i = 0; i < len; ++i)
-    {
-      for (const char *p = (const char *) iov[i].iov_base,
-                      *e = (const char *) iov[i].iov_base + iov[i].iov_len;
-           p != e;
-           ++p)
-        COMPUTE (crc, *p);
-    }
+    crc = crc32c_i (crc, iov[i].iov_base, iov[i].iov_len);
 
   return ~crc;
 }
 
 // Close versioned namespace, if enabled by the user.
 ACE_END_VERSIONED_NAMESPACE_DECL
-
-#undef COMPUTE
@@ -17,6 +17,184 @@ static const ACE_INT16 max_eleven_bit = 0x3ff;
 static const ACE_INT16 max_fifteen_bit = 0x3fff;
 #endif /* NONNATIVE_LONGDOUBLE */
 
+//
+// Vectorized kernels for the swap_XX_array routines.  Each one swaps
+// as many whole vectors as it can and returns the number of elements
+// done, the scalar code below takes care of the rest.  SSE2 is always
+// there on x86_64, AVX2 is used when the CPU has it, and NEON is
+// always there where the compiler says so.  Define
+// ACE_LACKS_CDR_SIMD_SWAP to only use the scalar code.
+//
+#if !defined (ACE_LACKS_CDR_SIMD_SWAP) && defined (__GNUC__) \
+    && (defined (__x86_64__) || (defined (__i386__) && defined (__SSE2__)))
+# define ACE_CDR_SIMD_SWAP
+# define ACE_CDR_SIMD_SWAP_SSE2
+# include <emmintrin.h>
+# if defined (__clang__) \
+     || (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)
+#   define ACE_CDR_SIMD_SWAP_AVX2
+#   include <immintrin.h>
+# endif
+#elif !defined (ACE_LACKS_CDR_SIMD_SWAP) && defined (__GNUC__) \
+      && (defined (__ARM_NEON) || defined (__ARM_NEON__))
+# define ACE_CDR_SIMD_SWAP
+# define ACE_CDR_SIMD_SWAP_NEON
+# include <arm_neon.h>
+#endif
+
+#if defined (ACE_CDR_SIMD_SWAP)
+
+// Below this many bytes the scalar code is as fast.
+static const size_t ace_cdr_simd_swap_min = 64;
+
+# if defined (ACE_CDR_SIMD_SWAP_AVX2)
+
+static bool
+ace_cdr_has_avx2 (void)
+{
+  // Computed once; function-local statics are initialized thread
+  // safely by g++ and clang.
+  static bool const has_avx2 =
+    (__builtin_cpu_init (), __builtin_cpu_supports ("avx2") != 0);
+  return has_avx2;
+}
+
+// Swap the elements of <size> bytes of 32 byte blocks, following the
+// byte shuffle <mask> (the same for both 16 byte lanes).
+__attribute__ ((target ("avx2"))) static size_t
+ace_cdr_swap_avx2 (char const *orig,
+                   char *target,
+                   size_t bytes,
+                   __m128i mask)
+{
+  __m256i const m = _mm256_broadcastsi128_si256 (mask);
+  char const * const end = orig + (bytes & ~size_t (31));
+  char const * const start = orig;
+
+  for (; orig < end; orig += 32, target += 32)
+    {
+      __m256i const v =
+        _mm256_loadu_si256 (reinterpret_cast<__m256i const *> (orig));
+      _mm256_storeu_si256 (reinterpret_cast<__m256i *> (target),
+                           _mm256_shuffle_epi8 (v, m));
+    }
+
+  return static_cast<size_t> (orig - start);
+}
+
+# endif /* ACE_CDR_SIMD_SWAP_AVX2 */
+
+# if defined (ACE_CDR_SIMD_SWAP_SSE2)
+
+// Swap the bytes of each 16 bit word of <v>; SSE2 has no byte
+// shuffle, the wider elements first get their words reversed.
+static inline __m128i
+ace_cdr_swap_bytes_sse2 (__m128i v)
+{
+  return _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+}
+
+static inline __m128i
+ace_cdr_swap_sse2 (__m128i v, size_t size)
+{
+  switch (size)
+    {
+    case 4:
+      v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1));
+      v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1));
+      break;
+    case 8:
+      v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+      v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+      break;
+    case 16:
+      v = _mm_shuffle_epi32 (v, _MM_SHUFFLE (1, 0, 3, 2));
+      v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+      v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+      break;
+    }
+
+  return ace_cdr_swap_bytes_sse2 (v);
+}
+
+# endif /* ACE_CDR_SIMD_SWAP_SSE2 */
+
+// Swap the leading elements of <size> bytes of <n>, returns how many
+// were swapped.
+static size_t
+ace_cdr_swap_simd (char const *orig, char *target, size_t n, size_t size)
+{
+  size_t const bytes = n * size;
+  if (bytes < ace_cdr_simd_swap_min)
+    return 0;
+
+  size_t done = 0;
+
+# if defined (ACE_CDR_SIMD_SWAP_AVX2)
+  if (ace_cdr_has_avx2 ())
+    {
+      __m128i mask;
+      switch (size)
+        {
+        case 2:
+          mask = _mm_setr_epi8 (1, 0, 3, 2, 5, 4, 7, 6,
+                                9, 8, 11, 10, 13, 12, 15, 14);
+          break;
+        case 4:
+          mask = _mm_setr_epi8 (3, 2, 1, 0, 7, 6, 5, 4,
+                                11, 10, 9, 8, 15, 14, 13, 12);
+          break;
+        case 8:
+          mask = _mm_setr_epi8 (7, 6, 5, 4, 3, 2, 1, 0,
+                                15, 14, 13, 12, 11, 10, 9, 8);
+          break;
+        default:
+          mask = _mm_setr_epi8 (15, 14, 13, 12, 11, 10, 9, 8,
+                                7, 6, 5, 4, 3, 2, 1, 0);
+          break;
+        }
+      done = ace_cdr_swap_avx2 (orig, target, bytes, mask);
+    }
+# endif /* ACE_CDR_SIMD_SWAP_AVX2 */
+
+# if defined (ACE_CDR_SIMD_SWAP_SSE2)
+  for (; done + 16 <= bytes; done += 16)
+    {
+      __m128i const v =
+        _mm_loadu_si128 (reinterpret_cast<__m128i const *> (orig + done));
+      _mm_storeu_si128 (reinterpret_cast<__m128i *> (target + done),
+                        ace_cdr_swap_sse2 (v, size));
+    }
+# elif defined (ACE_CDR_SIMD_SWAP_NEON)
+  for (; done + 16 <= bytes; done += 16)
+    {
+      uint8x16_t v =
+        vld1q_u8 (reinterpret_cast<uint8_t const *> (orig + done));
+      switch (size)
+        {
+        case 2:
+          v = vrev16q_u8 (v);
+          break;
+        case 4:
+          v = vrev32q_u8 (v);
+          break;
+        case 8:
+          v = vrev64q_u8 (v);
+          break;
+        default:
+          v = vrev64q_u8 (v);
+          v = vextq_u8 (v, v, 8);
+          break;
+        }
+      vst1q_u8 (reinterpret_cast<uint8_t *> (target + done), v);
+    }
+# endif /* ACE_CDR_SIMD_SWAP_SSE2 */
+
+  return done / size;
+}
+
+#endif /* ACE_CDR_SIMD_SWAP */
+
 //
 // See comments in CDR_Base.inl about optimization cases for swap_XX_array.
 //
@@ -26,6 +204,15 @@ ACE_CDR::swap_2_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+#if defined (ACE_CDR_SIMD_SWAP)
+  size_t const done = ace_cdr_swap_simd (orig, target, n, 2);
+  if (done == n)
+    return;
+  orig += 2 * done;
+  target += 2 * done;
+  n -= done;
+#endif /* ACE_CDR_SIMD_SWAP */
+
   // We pretend that AMD64/GNU G++ systems have a Pentium CPU to
   // take advantage of the inline assembly implementation.
 
@@ -253,6 +440,15 @@ ACE_CDR::swap_4_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT (n > 0); The caller checks that n > 0
 
+#if defined (ACE_CDR_SIMD_SWAP)
+  size_t const done = ace_cdr_swap_simd (orig, target, n, 4);
+  if (done == n)
+    return;
+  orig += 4 * done;
+  target += 4 * done;
+  n -= done;
+#endif /* ACE_CDR_SIMD_SWAP */
+
 #if ACE_SIZEOF_LONG == 8
   // Later, we read from *orig in 64 bit chunks,
   // so make sure we don't generate unaligned readings.
@@ -461,6 +657,15 @@ ACE_CDR::swap_8_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+#if defined (ACE_CDR_SIMD_SWAP)
+  size_t const done = ace_cdr_swap_simd (orig, target, n, 8);
+  if (done == n)
+    return;
+  orig += 8 * done;
+  target += 8 * done;
+  n -= done;
+#endif /* ACE_CDR_SIMD_SWAP */
+
   char const * const end = orig + 8*n;
   while (orig < end)
     {
@@ -475,6 +680,15 @@ ACE_CDR::swap_16_array (char const * orig, char* target, size_t n)
 {
   // ACE_ASSERT(n > 0); The caller checks that n > 0
 
+#if defined (ACE_CDR_SIMD_SWAP)
+  size_t const done = ace_cdr_swap_simd (orig, target, n, 16);
+  if (done == n)
+    return;
+  orig += 16 * done;
+  target += 16 * done;
+  n -= done;
+#endif /* ACE_CDR_SIMD_SWAP */
+
   char const * const end = orig + 16*n;
   while (orig < end)
     {
@@ -217,6 +217,23 @@
 # define ACE_DEFAULT_SYSLOG_FACILITY LOG_USER
 # endif /* ACE_DEFAULT_SYSLOG_FACILITY */
 
+// Number of log records ACE_Log_Msg_Async can queue, rounded up to a
+// power of 2.
+# if !defined (ACE_DEFAULT_LOG_MSG_ASYNC_SIZE)
+#   define ACE_DEFAULT_LOG_MSG_ASYNC_SIZE 512
+# endif /* ACE_DEFAULT_LOG_MSG_ASYNC_SIZE */
+
+// Bytes of log records in each segment ACE_Log_Msg_Mapped_File maps.
+# if !defined (ACE_DEFAULT_LOG_SEGMENT_SIZE)
+#   define ACE_DEFAULT_LOG_SEGMENT_SIZE (4 * 1024 * 1024)
+# endif /* ACE_DEFAULT_LOG_SEGMENT_SIZE */
+
+// Bytes of log records between two entries of the index at the end
+// of an ACE_Log_Msg_Mapped_File segment.
+# if !defined (ACE_DEFAULT_LOG_SEGMENT_INDEX_INTERVAL)
+#   define ACE_DEFAULT_LOG_SEGMENT_INDEX_INTERVAL 4096
+# endif /* ACE_DEFAULT_LOG_SEGMENT_INDEX_INTERVAL */
+
 # if !defined (ACE_HAS_STREAM_LOG_MSG_IPC)
 #   if defined (ACE_HAS_STREAM_PIPES)
 #     define ACE_HAS_STREAM_LOG_MSG_IPC 1
@@ -326,6 +343,11 @@
 #   define ACE_DEFAULT_TIMER_WHEEL_RESOLUTION 100
 # endif /* ACE_DEFAULT_TIMER_WHEEL_RESOLUTION */
 
+// Default tick, in microseconds, of ACE Timer Hierarchical Wheel
+# if !defined (ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION)
+#   define ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION 1000
+# endif /* ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION */
+
 // Default size for ACE Timer Hash table
 # if !defined (ACE_DEFAULT_TIMER_HASH_TABLE_SIZE)
 #   define ACE_DEFAULT_TIMER_HASH_TABLE_SIZE 1024
@@ -348,6 +370,41 @@
 #   define ACE_DEFAULT_FREE_LIST_INC 100
 # endif /* ACE_DEFAULT_FREE_LIST_INC */
 
+// Default number of chunks in the magazines of ACE Magazine Allocator
+# if !defined (ACE_DEFAULT_MAGAZINE_SIZE)
+#   define ACE_DEFAULT_MAGAZINE_SIZE 32
+# endif /* ACE_DEFAULT_MAGAZINE_SIZE */
+
+// Number of messages ACE_Lockless_Message_Queue holds, rounded up to
+// a power of 2.
+# if !defined (ACE_DEFAULT_LOCKLESS_MESSAGE_QUEUE_SIZE)
+#   define ACE_DEFAULT_LOCKLESS_MESSAGE_QUEUE_SIZE 1024
+# endif /* ACE_DEFAULT_LOCKLESS_MESSAGE_QUEUE_SIZE */
+
+// Cache line size ACE_Lockless_Message_Queue keeps its enqueue and
+// dequeue positions apart by.
+# if !defined (ACE_LOCKLESS_MESSAGE_QUEUE_CACHE_LINE)
+#   define ACE_LOCKLESS_MESSAGE_QUEUE_CACHE_LINE 64
+# endif /* ACE_LOCKLESS_MESSAGE_QUEUE_CACHE_LINE */
+
+// Bytes of each ring of an ACE_MEM_Ring_Stream, rounded up to a power
+// of two pages.
+# if !defined (ACE_DEFAULT_MEM_RING_SIZE)
+#   define ACE_DEFAULT_MEM_RING_SIZE 65536
+# endif /* ACE_DEFAULT_MEM_RING_SIZE */
+
+// Times an ACE_MEM_Ring_Stream polls its ring before it sleeps, on a
+// host with more than one processor online; a few microseconds.
+# if !defined (ACE_DEFAULT_MEM_RING_SPIN)
+#   define ACE_DEFAULT_MEM_RING_SPIN 200
+# endif /* ACE_DEFAULT_MEM_RING_SPIN */
+
+// Cache line size ACE_MEM_Ring_Stream keeps the positions of its
+// rings apart by; both processes must agree on it.
+# if !defined (ACE_MEM_RING_CACHE_LINE)
+#   define ACE_MEM_RING_CACHE_LINE 64
+# endif /* ACE_MEM_RING_CACHE_LINE */
+
 # if !defined (ACE_UNIQUE_NAME_LEN)
 #   define ACE_UNIQUE_NAME_LEN 100
 # endif /* ACE_UNIQUE_NAME_LEN */
@@ -358,6 +415,12 @@
 #   define ACE_MAX_DGRAM_SIZE 8192
 # endif /* ACE_MAX_DGRAM_SIZE */
 
+// Most datagrams ACE_SOCK_Dgram::recv_batch() and send_batch()
+// transfer with one system call.
+# if !defined (ACE_DGRAM_BATCH_MAX)
+#   define ACE_DGRAM_BATCH_MAX 64
+# endif /* ACE_DGRAM_BATCH_MAX */
+
 # if !defined (ACE_DEFAULT_ARGV_BUFSIZ)
 #   define ACE_DEFAULT_ARGV_BUFSIZ 1024 * 4
 # endif /* ACE_DEFAULT_ARGV_BUFSIZ */
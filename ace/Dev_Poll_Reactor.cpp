@@ -40,6 +40,7 @@
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_sys_time.h"
 #include "ace/Functor_T.h"
+#include "ace/Numeric_Limits.h"
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -70,6 +71,10 @@ ACE_Dev_Poll_Reactor_Notify::open (ACE_Reactor_Impl *r,
           return -1;
         }
 
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+      if (this->notification_queue_.open () == -1)
+        return -1;
+#else
       if (this->notification_pipe_.open () == -1)
         return -1;
 
@@ -96,6 +101,7 @@ ACE_Dev_Poll_Reactor_Notify::open (ACE_Reactor_Impl *r,
       if (ACE::set_flags (this->notification_pipe_.read_handle (),
                           ACE_NONBLOCK) == -1)
         return -1;
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
     }
 
   return 0;
@@ -106,11 +112,15 @@ ACE_Dev_Poll_Reactor_Notify::close (void)
 {
   ACE_TRACE ("ACE_Dev_Poll_Reactor_Notify::close");
 
-#if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+  return this->notification_queue_.close ();
+#else
+# if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
   notification_queue_.reset ();
-#endif /* ACE_HAS_REACTOR_NOTIFICATION_QUEUE */
+# endif /* ACE_HAS_REACTOR_NOTIFICATION_QUEUE */
 
   return this->notification_pipe_.close ();
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
 }
 
 int
@@ -127,7 +137,18 @@ ACE_Dev_Poll_Reactor_Notify::notify (ACE_Event_Handler *eh,
 
   ACE_Notification_Buffer buffer (eh, mask);
 
-#if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+  ACE_UNUSED_ARG (timeout);
+  ACE_Dev_Poll_Handler_Guard eh_guard (eh);
+
+  // The queue wakes up the reactor only if it isn't already awake.
+  if (this->notification_queue_.push (buffer) == -1)
+    return -1;             // Also decrement eh's reference count
+
+  eh_guard.release ();
+
+  return 0;
+#elif defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
   ACE_UNUSED_ARG (timeout);
   ACE_Dev_Poll_Handler_Guard eh_guard (eh);
 
@@ -167,7 +188,7 @@ ACE_Dev_Poll_Reactor_Notify::notify (ACE_Event_Handler *eh,
   eh_guard.release ();
 
   return 0;
-#endif /* ACE_HAS_REACTOR_NOTIFICATION_QUEUE */
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
 }
 
 int
@@ -201,10 +222,15 @@ ACE_Dev_Poll_Reactor_Notify::read_notify_pipe (ACE_HANDLE handle,
   // by "walking" the array of pollfd structures returned from
   // `/dev/poll' or `/dev/epoll' but that is potentially much more
   // expensive than simply checking for an EWOULDBLOCK.
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+  // The queue keeps its handle readable until it is found empty.
+  ACE_UNUSED_ARG (handle);
+  return this->notification_queue_.pop (buffer);
+#else
   size_t to_read;
   char *read_p;
 
-#if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
+# if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
   // The idea in the queued case is to be sure we never end up with a notify
   // queued but no byte in the pipe. If that happens, the notify won't be
   // dispatched. So always try to empty the pipe, read the queue, then put
@@ -242,7 +268,7 @@ ACE_Dev_Poll_Reactor_Notify::read_notify_pipe (ACE_HANDLE handle,
                       (char *)&next,
                       1); /* one byte is enough */
   return 1;
-#else
+# else
   to_read = sizeof buffer;
   read_p = (char *)&buffer;
 
@@ -271,7 +297,8 @@ ACE_Dev_Poll_Reactor_Notify::read_notify_pipe (ACE_HANDLE handle,
     return -1;
 
   return 0;
-#endif /* ACE_HAS_REACTOR_NOTIFICATION_QUEUE */
+# endif /* ACE_HAS_REACTOR_NOTIFICATION_QUEUE */
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
 }
 
 
@@ -287,7 +314,11 @@ ACE_Dev_Poll_Reactor_Notify::notify_handle (void)
 {
   ACE_TRACE ("ACE_Dev_Poll_Reactor_Notify::notify_handle");
 
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+  return this->notification_queue_.handle ();
+#else
   return this->notification_pipe_.read_handle ();
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
 }
 
 int
@@ -582,6 +613,13 @@ ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor (ACE_Sig_Handler *sh,
   : initialized_ (false)
   , poll_fd_ (ACE_INVALID_HANDLE)
   // , ready_set_ ()
+#if defined (ACE_HAS_EVENT_POLL)
+  , events_ (0)
+  , events_size_ (0)
+  , start_pevents_ (0)
+  , end_pevents_ (0)
+  , edge_triggered_ (false)
+#endif  /* ACE_HAS_EVENT_POLL */
 #if defined (ACE_HAS_DEV_POLL)
   , dp_fds_ (0)
   , start_pfds_ (0)
@@ -625,6 +663,13 @@ ACE_Dev_Poll_Reactor::ACE_Dev_Poll_Reactor (size_t size,
   : initialized_ (false)
   , poll_fd_ (ACE_INVALID_HANDLE)
   // , ready_set_ ()
+#if defined (ACE_HAS_EVENT_POLL)
+  , events_ (0)
+  , events_size_ (0)
+  , start_pevents_ (0)
+  , end_pevents_ (0)
+  , edge_triggered_ (false)
+#endif  /* ACE_HAS_EVENT_POLL */
 #if defined (ACE_HAS_DEV_POLL)
   , dp_fds_ (0)
   , start_pfds_ (0)
@@ -833,6 +878,12 @@ ACE_Dev_Poll_Reactor::close (void)
   ACE_OS::memset (&this->event_, 0, sizeof (this->event_));
   this->event_.data.fd = ACE_INVALID_HANDLE;
 
+  delete [] this->events_;
+  this->events_ = 0;
+  this->events_size_ = 0;
+  this->start_pevents_ = 0;
+  this->end_pevents_ = 0;
+
 #else
 
   delete [] this->dp_fds_;
@@ -880,6 +931,79 @@ ACE_Dev_Poll_Reactor::close (void)
   return result;
 }
 
+int
+ACE_Dev_Poll_Reactor::batch_events (size_t max_events, bool edge_triggered)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::batch_events");
+
+#if defined (ACE_HAS_EVENT_POLL)
+
+  // Hold the token so that no thread is dispatching events while the
+  // mode changes.
+  ACE_MT (ACE_GUARD_RETURN (ACE_Dev_Poll_Reactor_Token, mon, this->token_, -1));
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->repo_lock_, -1));
+
+  if (!this->initialized_)
+    return -1;
+
+  // Called from an upcall, with the rest of a batch still pending.
+  if (this->start_pevents_ != this->end_pevents_)
+    {
+      errno = EBUSY;
+      return -1;
+    }
+
+  struct epoll_event *events = 0;
+  if (max_events > 0)
+    {
+      if (max_events > static_cast<size_t> (ACE_Numeric_Limits<int>::max ()))
+        max_events = static_cast<size_t> (ACE_Numeric_Limits<int>::max ());
+
+      ACE_NEW_RETURN (events, struct epoll_event[max_events], -1);
+    }
+
+  delete [] this->events_;
+  this->events_ = events;
+  this->events_size_ = static_cast<int> (max_events);
+  this->start_pevents_ = events;
+  this->end_pevents_ = events;
+  this->edge_triggered_ = edge_triggered;
+
+  // Re-register the handles currently in the "interest set" for the
+  // new mode.  Suspended handles pick it up when resumed.
+  size_t const len = this->handler_rep_.max_size ();
+
+  for (size_t i = 0; i < len; ++i)
+    {
+      ACE_HANDLE const handle = static_cast<ACE_HANDLE> (i);
+      Event_Tuple *info = this->handler_rep_.find (handle);
+      if (info == 0 || info->suspended || !info->controlled)
+        continue;
+
+      struct epoll_event epev;
+      ACE_OS::memset (&epev, 0, sizeof (epev));
+      epev.events  = this->reactor_mask_to_poll_event (info->mask)
+                     | this->epoll_flags (info->event_handler);
+      epev.data.fd = handle;
+
+      // A closed handle has already left the epoll set; it is removed
+      // from the repository as soon as the reactor learns about it.
+      if (::epoll_ctl (this->poll_fd_, EPOLL_CTL_MOD, handle, &epev) == -1
+          && errno != ENOENT)
+        return -1;
+    }
+
+  return 0;
+
+#else
+
+  ACE_UNUSED_ARG (max_events);
+  ACE_UNUSED_ARG (edge_triggered);
+  ACE_NOTSUP_RETURN (-1);
+
+#endif  /* ACE_HAS_EVENT_POLL */
+}
+
 int
 ACE_Dev_Poll_Reactor::work_pending (const ACE_Time_Value & max_wait_time)
 {
@@ -914,7 +1038,14 @@ ACE_Dev_Poll_Reactor::work_pending_i (ACE_Time_Value * max_wait_time)
     return 0;
 
 #if defined (ACE_HAS_EVENT_POLL)
-  if (this->event_.data.fd != ACE_INVALID_HANDLE)
+  // Events left from the last batch, typically those of handlers that
+  // asked to be called back, are dispatched along with the events
+  // ready by now, which are polled for without waiting.
+  int const left =
+    static_cast<int> (this->end_pevents_ - this->start_pevents_);
+
+  if (this->event_.data.fd != ACE_INVALID_HANDLE
+      || (left > 0 && left >= this->events_size_))
 #else
   if (this->start_pfds_ != this->end_pfds_)
 #endif /* ACE_HAS_EVENT_POLL */
@@ -931,18 +1062,63 @@ ACE_Dev_Poll_Reactor::work_pending_i (ACE_Time_Value * max_wait_time)
      || (this_timeout != 0 && max_wait_time != 0
          && *this_timeout != *max_wait_time) ? 1 : 0);
 
-  long const timeout =
+  long timeout =
     (this_timeout == 0
      ? -1 /* Infinity */
      : static_cast<long> (this_timeout->msec ()));
 
 #if defined (ACE_HAS_EVENT_POLL)
 
-  // Wait for an event.
-  int const nfds = ::epoll_wait (this->poll_fd_,
-                                 &this->event_,
-                                 1,
-                                 static_cast<int> (timeout));
+  int nfds = 0;
+
+  if (this->events_ == 0)
+    {
+      // Wait for an event.
+      nfds = ::epoll_wait (this->poll_fd_,
+                           &this->event_,
+                           1,
+                           static_cast<int> (timeout));
+    }
+  else
+    {
+      // Keep the events left at the front of the array.
+      if (left > 0)
+        {
+          ACE_OS::memmove (this->events_,
+                           this->start_pevents_,
+                           left * sizeof (struct epoll_event));
+          timeout = 0;
+        }
+
+      // Wait for a batch of events.
+      nfds = ::epoll_wait (this->poll_fd_,
+                           this->events_ + left,
+                           this->events_size_ - left,
+                           static_cast<int> (timeout));
+
+      this->start_pevents_ = this->events_;
+      this->end_pevents_ = this->events_ + (nfds > 0 ? nfds : 0);
+
+      if (left == 0)
+        return nfds == 0 && timers_pending != 0 ? 1 : nfds;
+
+      // Merge the events of a handle already in the array.
+      this->end_pevents_ = this->events_ + left;
+      for (int i = 0; i < nfds; ++i)
+        {
+          struct epoll_event const &ev = this->events_[left + i];
+          struct epoll_event *e = this->events_;
+          while (e < this->end_pevents_ && e->data.fd != ev.data.fd)
+            ++e;
+
+          if (e == this->end_pevents_)
+            *this->end_pevents_++ = ev;
+          else
+            e->events |= ev.events;
+        }
+
+      return static_cast<int> (this->end_pevents_ - this->start_pevents_);
+    }
 
 #else
 
@@ -1057,6 +1233,20 @@ ACE_Dev_Poll_Reactor::dispatch (Token_Guard &guard)
   // next waiter to begin getting an event while we dispatch one here.
   int result = 0;
 
+#if defined (ACE_HAS_EVENT_POLL)
+  // In batched mode the token is kept for the whole batch, so all the
+  // expired timers are run in one go, followed by the I/O events.
+  if (this->events_ != 0)
+    {
+      result = this->timer_queue_->expire ();
+      if (result == -1)
+        return -1;
+
+      int const n = this->dispatch_io_events ();
+      return n == -1 ? -1 : result + n;
+    }
+#endif /* ACE_HAS_EVENT_POLL */
+
   // Handle timers early since they may have higher latency
   // constraints than I/O handlers.  Ideally, the order of
   // dispatching should be a strategy...
@@ -1325,6 +1515,185 @@ ACE_Dev_Poll_Reactor::dispatch_io_event (Token_Guard &guard)
   return 0;
 }
 
+#if defined (ACE_HAS_EVENT_POLL)
+int
+ACE_Dev_Poll_Reactor::dispatch_io_events (void)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::dispatch_io_events");
+
+  int dispatched = 0;
+
+  // Only the events retrieved so far are dispatched: those queued
+  // again wait for the next call, after the timers and new events.
+  for (ptrdiff_t count = this->end_pevents_ - this->start_pevents_;
+       count > 0 && this->start_pevents_ < this->end_pevents_;
+       --count)
+    {
+      // Move past the event before the upcall, so that a nested
+      // handle_events() call resumes with the next one.
+      struct epoll_event ev = *this->start_pevents_++;
+
+      for (;;)
+        {
+          __uint32_t again = 0;
+          int const n = this->dispatch_io_events_i (ev.data.fd,
+                                                    ev.events,
+                                                    again);
+          if (n == -1)
+            return -1;
+
+          dispatched += n;
+          if (again == 0)
+            break;
+
+          // The handler asked to be called back.  Edge triggered, no
+          // new event would be reported for what it left, so the
+          // event is queued again behind the rest of the batch, to be
+          // dispatched by the next call.
+          ev.events = again;
+          if (this->end_pevents_ < this->events_ + this->events_size_)
+            {
+              *this->end_pevents_++ = ev;
+              break;
+            }
+          if (this->start_pevents_ > this->events_)
+            {
+              ACE_OS::memmove (this->start_pevents_ - 1,
+                               this->start_pevents_,
+                               (this->end_pevents_ - this->start_pevents_)
+                                 * sizeof (struct epoll_event));
+              --this->start_pevents_;
+              *(this->end_pevents_ - 1) = ev;
+              break;
+            }
+          // No room left, or the upcall left batched mode: call the
+          // handler back right away.
+        }
+    }
+
+  return dispatched;
+}
+
+int
+ACE_Dev_Poll_Reactor::dispatch_io_events_i (ACE_HANDLE handle,
+                                            __uint32_t revents,
+                                            __uint32_t &again)
+{
+  ACE_TRACE ("ACE_Dev_Poll_Reactor::dispatch_io_events_i");
+
+  int dispatched = 0;
+
+  // The token is held for the whole batch, so no other thread can
+  // dispatch this handle. Upcalls made earlier in the batch may have
+  // removed or suspended it though, so the handler repository is
+  // consulted before each upcall.
+  while (revents != 0)
+    {
+      ACE_Reactor_Mask disp_mask = 0;
+      __uint32_t bit = 0;
+      ACE_Event_Handler *eh = 0;
+      int (ACE_Event_Handler::*callback)(ACE_HANDLE) = 0;
+      {
+        ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->repo_lock_, -1);
+        Event_Tuple *info = this->handler_rep_.find (handle);
+        if (info == 0 || info->suspended)
+          return dispatched;
+
+        eh = info->event_handler;
+        if (ACE_BIT_ENABLED (revents, EPOLLOUT))
+          {
+            disp_mask = ACE_Event_Handler::WRITE_MASK;
+            callback = &ACE_Event_Handler::handle_output;
+            bit = EPOLLOUT;
+            ACE_CLR_BITS (revents, EPOLLOUT);
+          }
+        else if (ACE_BIT_ENABLED (revents, EPOLLPRI))
+          {
+            disp_mask = ACE_Event_Handler::EXCEPT_MASK;
+            callback = &ACE_Event_Handler::handle_exception;
+            bit = EPOLLPRI;
+            ACE_CLR_BITS (revents, EPOLLPRI);
+          }
+        else if (ACE_BIT_ENABLED (revents, EPOLLIN))
+          {
+            disp_mask = ACE_Event_Handler::READ_MASK;
+            callback = &ACE_Event_Handler::handle_input;
+            bit = EPOLLIN;
+            ACE_CLR_BITS (revents, EPOLLIN);
+          }
+        else if (ACE_BIT_ENABLED (revents, EPOLLHUP | EPOLLERR))
+          {
+            // A handler which asked to be called back for the data
+            // that came with the hangup gets the hangup with it, and
+            // is only removed once it is done.
+            if (again != 0)
+              {
+                ACE_SET_BITS (again, revents & (EPOLLHUP | EPOLLERR));
+                return dispatched;
+              }
+            this->remove_handler_i (handle,
+                                    ACE_Event_Handler::ALL_EVENTS_MASK,
+                                    grd,
+                                    eh);
+            return dispatched + 1;
+          }
+        else
+          {
+            ACELIB_ERROR ((LM_ERROR,
+                           ACE_TEXT ("(%t) dispatch_io_events h %d unknown events 0x%x\n"),
+                           handle, revents));
+            return dispatched;
+          }
+      }     // End scope for ACE_GUARD holding repo lock
+
+      if (eh == this->notify_handler_)
+        {
+          // Drain up to max_notify_iterations() notifications, or one
+          // batch worth if unlimited, so a notify storm cannot starve
+          // the I/O events.  The notify handle is level triggered; any
+          // notification left is picked up by the next epoll_wait().
+          ACE_Dev_Poll_Reactor_Notify *notify =
+            dynamic_cast<ACE_Dev_Poll_Reactor_Notify *> (notify_handler_);
+          int limit = this->notify_handler_->max_notify_iterations ();
+          if (limit <= 0)
+            limit = this->events_size_;
+
+          ACE_Notification_Buffer b;
+          for (int n = 0; n < limit; ++n)
+            {
+              int const status = notify->dequeue_one (b);
+              if (status == -1)
+                return -1;
+              if (status == 0)
+                break;
+              this->notify_handler_->dispatch_notify (b);
+            }
+          ++dispatched;
+          continue;
+        }
+
+      ACE_Dev_Poll_Handler_Guard eh_guard (eh);
+
+      // A positive return is reported through <again> rather than
+      // acted upon here, so the rest of the batch gets its turn first.
+      int const status = (eh->*callback) (handle);
+      ++dispatched;
+
+      if (status > 0)
+        ACE_SET_BITS (again, bit);
+      else if (status < 0)
+        {
+          ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, grd, this->repo_lock_, -1);
+          Event_Tuple *info = this->handler_rep_.find (handle);
+          if (info != 0 && info->event_handler == eh)
+            this->remove_handler_i (handle, disp_mask, grd);
+        }
+    }
+
+  return dispatched;
+}
+#endif /* ACE_HAS_EVENT_POLL */
+
 int
 ACE_Dev_Poll_Reactor::alertable_handle_events (ACE_Time_Value *max_wait_time)
 {
@@ -1421,9 +1790,9 @@ ACE_Dev_Poll_Reactor::register_handler_i (ACE_HANDLE handle,
      epev.events  = this->reactor_mask_to_poll_event (mask);
      // All but the notify handler get registered with oneshot to facilitate
      // auto suspend before the upcall. See dispatch_io_event for more
-     // information.
-     if (event_handler != this->notify_handler_)
-       epev.events |= EPOLLONESHOT;
+     // information. In batched mode no handler is suspended; see
+     // batch_events().
+     epev.events |= this->epoll_flags (event_handler);
 
      if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
        {
@@ -1875,7 +2244,8 @@ ACE_Dev_Poll_Reactor::resume_handler_i (ACE_HANDLE handle)
   int op = EPOLL_CTL_ADD;
   if (info->controlled)
     op = EPOLL_CTL_MOD;
-  epev.events  = this->reactor_mask_to_poll_event (mask) | EPOLLONESHOT;
+  epev.events  = this->reactor_mask_to_poll_event (mask)
+                 | this->epoll_flags (info->event_handler);
   epev.data.fd = handle;
 
   if (::epoll_ctl (this->poll_fd_, op, handle, &epev) == -1)
@@ -2340,7 +2710,7 @@ ACE_Dev_Poll_Reactor::mask_ops_i (ACE_HANDLE handle,
       else
         {
           op          = EPOLL_CTL_MOD;
-          epev.events = events | EPOLLONESHOT;
+          epev.events = events | this->epoll_flags (info->event_handler);
         }
 
       epev.data.fd = handle;
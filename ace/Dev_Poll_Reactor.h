@@ -36,9 +36,11 @@
 #include "ace/Reactor_Token_T.h"
 #include "ace/Token.h"
 
-#if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+# include "ace/MPSC_Notification_Queue.h"
+#elif defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
 # include "ace/Notification_Queue.h"
-#endif /* ACE_HAS_REACTOR_NOTIFICATION_QUEUE */
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
 
 #if defined (ACE_HAS_DEV_POLL)
 struct pollfd;
@@ -193,7 +195,16 @@ protected:
    */
   int max_notify_iterations_;
 
-#if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+  /**
+   * @brief A lock-free queue to store the notifications.
+   *
+   * notify() does not take any lock, and the queue provides the
+   * handle the reactor waits on instead of the notification pipe,
+   * which is left unused.
+   */
+  ACE_MPSC_Notification_Queue notification_queue_;
+#elif defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
   /**
    * @brief A user-space queue to store the notifications.
    *
@@ -206,7 +217,7 @@ protected:
    * at a time.
    */
   ACE_Notification_Queue notification_queue_;
-#endif /* ACE_HAS_REACTOR_NOTIFICATION_QUEUE */
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
 };
 
 // ---------------------------------------------------------------------
@@ -471,6 +482,47 @@ public:
   /// Close down and release all resources.
   virtual int close (void);
 
+  /**
+   * Switch the reactor between its default dispatching mode and a
+   * batched one.
+   *
+   * By default each <epoll_wait> call retrieves a single event, and
+   * the handle is registered with EPOLLONESHOT so that it is
+   * effectively suspended during the upcall, then re-armed afterwards
+   * by an <epoll_ctl> call.  This allows any number of threads to run
+   * the event loop concurrently, at the cost of two system calls per
+   * dispatched event.
+   *
+   * If @a max_events is non-zero, each <epoll_wait> call retrieves up
+   * to @a max_events events, and the whole batch is dispatched under
+   * a single acquisition of the reactor token: other threads calling
+   * handle_events() wait for the token and never see a handle which
+   * is being dispatched, so handles no longer need to be re-armed
+   * after each upcall.  Timers that expire while the batch is
+   * dispatched are run before it.
+   *
+   * If @a edge_triggered is true, handles are registered with
+   * EPOLLET: an event is then reported only once per readiness
+   * change, so event handlers must consume input (or fill the output
+   * buffer) until the operation returns EWOULDBLOCK, or return a
+   * positive value to be called back.  A handler asking to be called
+   * back is queued behind the rest of the batch, and dispatched along
+   * with the next one, once the expired timers have run.  If false,
+   * handles are level triggered and handlers keep their usual
+   * semantics.  The notify handler is always level triggered.
+   *
+   * Passing 0 for @a max_events restores the default mode.  Handles
+   * already registered are switched to the new mode.
+   *
+   * @note Handlers are never suspended by the reactor in batched
+   *       mode, so ACE_Event_Handler::resume_handler() is not
+   *       consulted.
+   *
+   * @return 0 on success, -1 on failure; this mode is only available
+   *         with epoll.
+   */
+  int batch_events (size_t max_events, bool edge_triggered = true);
+
   // = Event loop drivers.
   /**
    * Returns non-zero if there are I/O events "ready" for dispatching,
@@ -961,6 +1013,25 @@ protected:
   ///         -1 on error (token still held).
   int dispatch_io_event (Token_Guard &guard);
 
+#if defined (ACE_HAS_EVENT_POLL)
+  /// Dispatch all events retrieved by the last <epoll_wait> in
+  /// batched mode, without releasing the token.  Returns the number
+  /// of upcalls made, or -1 on error.
+  int dispatch_io_events (void);
+
+  /// Dispatch all of @a revents to the handler registered for
+  /// @a handle, once each.  The events whose upcall returned a
+  /// positive value are set in @a again.  Returns the number of
+  /// upcalls made, or -1 on error.
+  int dispatch_io_events_i (ACE_HANDLE handle,
+                            __uint32_t revents,
+                            __uint32_t &again);
+
+  /// Return the epoll flags, in addition to the event bits, to
+  /// register @a eh with in the current dispatching mode.
+  __uint32_t epoll_flags (ACE_Event_Handler *eh) const;
+#endif /* ACE_HAS_EVENT_POLL */
+
   /// Register the given event handler with the reactor.
   int register_handler_i (ACE_HANDLE handle,
                           ACE_Event_Handler *eh,
@@ -1021,6 +1092,22 @@ protected:
   /// epoll_wait() but not yet processed.
   struct epoll_event event_;
 
+  /// The array epoll_wait() feeds its results to in batched mode, 0
+  /// otherwise.  See batch_events().
+  struct epoll_event *events_;
+
+  /// Number of elements in <events_>.
+  int events_size_;
+
+  /// Pointer to the next element of <events_> to be dispatched.
+  struct epoll_event *start_pevents_;
+
+  /// The last element of <events_> retrieved plus one.
+  struct epoll_event *end_pevents_;
+
+  /// Register handles edge triggered in batched mode.
+  bool edge_triggered_;
+
 #else
   /// The pollfd array that `/dev/poll' will feed its results to.
   struct pollfd *dp_fds_;
@@ -90,6 +90,22 @@ ACE_Dev_Poll_Reactor::upcall (ACE_Event_Handler *event_handler,
   return status;
 }
 
+#if defined (ACE_HAS_EVENT_POLL)
+ACE_INLINE __uint32_t
+ACE_Dev_Poll_Reactor::epoll_flags (ACE_Event_Handler *eh) const
+{
+  // The notify handler is never suspended nor edge triggered; see
+  // dispatch_io_event() for more information.
+  if (eh == this->notify_handler_)
+    return 0;
+
+  if (this->events_ == 0)
+    return EPOLLONESHOT;
+
+  return this->edge_triggered_ ? static_cast<int> (EPOLLET) : 0;
+}
+#endif /* ACE_HAS_EVENT_POLL */
+
 
 /************************************************************************/
 // Methods for ACE_Dev_Poll_Reactor::Token_Guard
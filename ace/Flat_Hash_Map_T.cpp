@@ -0,0 +1,353 @@
+// $Id$
+
+#ifndef ACE_FLAT_HASH_MAP_T_CPP
+#define ACE_FLAT_HASH_MAP_T_CPP
+
+#include "ace/Flat_Hash_Map_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if !defined (__ACE_INLINE__)
+# include "ace/Flat_Hash_Map_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/Malloc_Base.h"
+#include "ace/OS_NS_string.h"
+#include "ace/os_include/os_errno.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template <class EXT_ID, class INT_ID> void
+ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("total_size_ = %B\n"), this->total_size_));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("cur_size_ = %B\n"), this->cur_size_));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("growth_left_ = %B\n"), this->growth_left_));
+  this->table_allocator_->dump ();
+  this->lock_.dump ();
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::create_table (size_t capacity)
+{
+  // The entries and the control bytes are allocated together: the
+  // entries first, for their alignment, then a control byte per
+  // entry, and the copies of the first bytes of a group.
+  size_t const bytes = capacity * sizeof (ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>)
+                       + capacity + GROUP_WIDTH;
+  void *ptr = 0;
+
+  ACE_ALLOCATOR_RETURN (ptr,
+                        this->table_allocator_->malloc (bytes),
+                        -1);
+
+  this->slots_ = static_cast<ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *> (ptr);
+  this->ctrl_ = reinterpret_cast<ACE_INT8 *> (this->slots_ + capacity);
+  ACE_OS::memset (this->ctrl_, CTRL_EMPTY, capacity + GROUP_WIDTH);
+
+  this->total_size_ = capacity;
+  // Keep at least 1/8th of the slots empty, so that probes end soon.
+  this->growth_left_ = capacity - capacity / 8;
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::open (size_t size,
+                                                                           ACE_Allocator *table_alloc)
+{
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  // Calling this->close_i () to ensure we release previous allocated
+  // memory before allocating new one.
+  this->close_i ();
+
+  if (table_alloc == 0)
+    table_alloc = ACE_Allocator::instance ();
+
+  this->table_allocator_ = table_alloc;
+
+  if (size > (~static_cast<size_t> (0)) / (4 * sizeof (ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>)))
+    {
+      errno = ENOMEM;
+      return -1;
+    }
+
+  // The smallest power of 2 number of slots which holds <size>
+  // entries, and at least a group.
+  size_t capacity = GROUP_WIDTH;
+  while (capacity - capacity / 8 < size)
+    capacity <<= 1;
+
+  this->cur_size_ = 0;
+  return this->create_table (capacity);
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::close_i (void)
+{
+  // Protect against "double-deletion" in case the destructor also
+  // gets called.
+  if (this->slots_ != 0)
+    {
+      // Remove all the entries.
+      this->unbind_all_i ();
+
+      // Free table memory.
+      this->table_allocator_->free (this->slots_);
+
+      // Should be done last...
+      this->slots_ = 0;
+      this->ctrl_ = 0;
+      this->total_size_ = 0;
+      this->growth_left_ = 0;
+    }
+
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::unbind_all_i (void)
+{
+  if (this->slots_ == 0)
+    return 0;
+
+  // Explicitly call the destructor of each entry.
+  for (size_t i = 0; i < this->total_size_; ++i)
+    if (this->ctrl_[i] >= 0)
+      {
+        ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *entry = &this->slots_[i];
+        ACE_DES_FREE_TEMPLATE2 (entry, ACE_NOOP,
+                                ACE_Flat_Hash_Map_Entry, EXT_ID, INT_ID);
+      }
+
+  ACE_OS::memset (this->ctrl_, CTRL_EMPTY, this->total_size_ + GROUP_WIDTH);
+
+  this->cur_size_ = 0;
+  this->growth_left_ = this->total_size_ - this->total_size_ / 8;
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> size_t
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::find_free_i (ACE_UINT64 hash) const
+{
+  // Same probe sequence as find_i(); there is always a free slot.
+  size_t const mask = this->total_size_ - 1;
+  size_t pos = static_cast<size_t> (hash >> 7) & mask;
+
+  for (size_t step = GROUP_WIDTH; ; step += GROUP_WIDTH)
+    {
+      ACE_UINT32 const match = match_free_i (this->ctrl_ + pos);
+      if (match != 0)
+        return (pos + lowest_bit_i (match)) & mask;
+
+      pos = (pos + step) & mask;
+    }
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::grow_i (void)
+{
+  ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> * const old_slots = this->slots_;
+  ACE_INT8 * const old_ctrl = this->ctrl_;
+  size_t const old_size = this->total_size_;
+
+  // When unbinds left the table with many deleted slots, rebuilding
+  // it with as many slots is enough to make room.
+  size_t capacity = old_size;
+  if (this->cur_size_ > (old_size - old_size / 8) / 2)
+    capacity *= 2;
+
+  if (this->create_table (capacity) == -1)
+    {
+      this->slots_ = old_slots;
+      this->ctrl_ = old_ctrl;
+      this->total_size_ = old_size;
+      return -1;
+    }
+
+  for (size_t i = 0; i < old_size; ++i)
+    if (old_ctrl[i] >= 0)
+      {
+        ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *entry = &old_slots[i];
+        ACE_UINT64 const hash = this->hash (entry->ext_id_);
+        size_t const slot = this->find_free_i (hash);
+
+        new (&this->slots_[slot]) ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> (entry->ext_id_,
+                                                                           entry->int_id_);
+        this->set_ctrl_i (slot, static_cast<ACE_INT8> (hash & 0x7f));
+        --this->growth_left_;
+
+        ACE_DES_FREE_TEMPLATE2 (entry, ACE_NOOP,
+                                ACE_Flat_Hash_Map_Entry, EXT_ID, INT_ID);
+      }
+
+  this->table_allocator_->free (old_slots);
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ssize_t
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::insert_i (const EXT_ID &ext_id,
+                                                                               const INT_ID &int_id,
+                                                                               ACE_UINT64 hash)
+{
+  if (this->slots_ == 0)
+    {
+      errno = ENOMEM;
+      return -1;
+    }
+
+  size_t slot = this->find_free_i (hash);
+
+  // Reusing a deleted slot doesn't use up an empty one.
+  if (this->ctrl_[slot] == CTRL_EMPTY && this->growth_left_ == 0)
+    {
+      if (this->grow_i () == -1)
+        return -1;
+      slot = this->find_free_i (hash);
+    }
+
+  new (&this->slots_[slot]) ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> (ext_id, int_id);
+
+  if (this->ctrl_[slot] == CTRL_EMPTY)
+    --this->growth_left_;
+  this->set_ctrl_i (slot, static_cast<ACE_INT8> (hash & 0x7f));
+  ++this->cur_size_;
+  return static_cast<ssize_t> (slot);
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::bind_i (const EXT_ID &ext_id,
+                                                                             const INT_ID &int_id,
+                                                                             ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry)
+{
+  ACE_UINT64 const hash = this->hash (ext_id);
+  ssize_t slot = this->find_i (ext_id, hash);
+
+  if (slot != -1)
+    {
+      entry = &this->slots_[slot];
+      return 1;
+    }
+
+  slot = this->insert_i (ext_id, int_id, hash);
+  if (slot == -1)
+    return -1;
+
+  entry = &this->slots_[slot];
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::trybind_i (const EXT_ID &ext_id,
+                                                                                INT_ID &int_id,
+                                                                                ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry)
+{
+  int const result = this->bind_i (ext_id, int_id, entry);
+  if (result == 1)
+    int_id = entry->int_id_;
+  return result;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::rebind_i (const EXT_ID &ext_id,
+                                                                               const INT_ID &int_id,
+                                                                               EXT_ID *old_ext_id,
+                                                                               INT_ID *old_int_id,
+                                                                               ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry)
+{
+  int const result = this->bind_i (ext_id, int_id, entry);
+
+  if (result == 1)
+    {
+      if (old_ext_id != 0)
+        *old_ext_id = entry->ext_id_;
+      if (old_int_id != 0)
+        *old_int_id = entry->int_id_;
+
+      entry->ext_id_ = ext_id;
+      entry->int_id_ = int_id;
+    }
+
+  return result;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::unbind_i (const EXT_ID &ext_id,
+                                                                               INT_ID *int_id)
+{
+  ssize_t const slot = this->find_i (ext_id, this->hash (ext_id));
+
+  if (slot == -1)
+    {
+      errno = ENOENT;
+      return -1;
+    }
+
+  if (int_id != 0)
+    *int_id = this->slots_[slot].int_id_;
+
+  this->erase_i (static_cast<size_t> (slot));
+  return 0;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::erase_i (size_t slot)
+{
+  ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *entry = &this->slots_[slot];
+  ACE_DES_FREE_TEMPLATE2 (entry, ACE_NOOP,
+                          ACE_Flat_Hash_Map_Entry, EXT_ID, INT_ID);
+  --this->cur_size_;
+
+  // A lookup stops at the first group with an empty slot, so the slot
+  // has to stay in the way (deleted) if some group with it has none;
+  // it can be made empty again if the non empty slots around it are
+  // fewer than a group.
+  size_t const mask = this->total_size_ - 1;
+  ACE_UINT32 const empty_after = match_empty_i (this->ctrl_ + slot);
+  ACE_UINT32 const empty_before =
+    match_empty_i (this->ctrl_ + ((slot - GROUP_WIDTH) & mask));
+
+  if (empty_after != 0
+      && empty_before != 0
+      && lowest_bit_i (empty_after)
+         + (GROUP_WIDTH - 1 - highest_bit_i (empty_before)) < GROUP_WIDTH)
+    {
+      this->set_ctrl_i (slot, static_cast<ACE_INT8> (CTRL_EMPTY));
+      ++this->growth_left_;
+    }
+  else
+    this->set_ctrl_i (slot, static_cast<ACE_INT8> (CTRL_DELETED));
+}
+
+// ------------------------------------------------------------
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Flat_Hash_Map_Iterator_Base)
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Flat_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::dump_i (void) const
+{
+  ACE_TRACE ("ACE_Flat_Hash_Map_Iterator_Base::dump_i");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("index_ = %d "), this->index_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_FLAT_HASH_MAP_T_CPP */
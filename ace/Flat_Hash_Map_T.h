@@ -0,0 +1,648 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Flat_Hash_Map_T.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+#ifndef ACE_FLAT_HASH_MAP_T_H
+#define ACE_FLAT_HASH_MAP_T_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Default_Constants.h"
+#include "ace/Functor_T.h"
+#include "ace/Log_Category.h"
+#include <iterator>
+
+// The control bytes of a group are matched with SSE2 where it is
+// always available; elsewhere a group is matched a byte at a time.
+#if !defined (ACE_LACKS_FLAT_HASH_MAP_SIMD) \
+    && (defined (__SSE2__) || defined (_M_X64) \
+        || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+# define ACE_FLAT_HASH_MAP_SSE2
+# include <emmintrin.h>
+#endif
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Flat_Hash_Map_Entry
+ *
+ * @brief Define an entry in the flat hash table.
+ *
+ * Unlike ACE_Hash_Map_Entry, the entries don't link to each other:
+ * they live in the table itself.
+ */
+template <class EXT_ID, class INT_ID>
+class ACE_Flat_Hash_Map_Entry
+{
+public:
+  /// Constructor.
+  ACE_Flat_Hash_Map_Entry (const EXT_ID &ext_id,
+                           const INT_ID &int_id);
+
+  /// Key accessor.
+  EXT_ID& key (void);
+
+  /// Read-only key accessor.
+  const EXT_ID& key (void) const;
+
+  /// Item accessor.
+  INT_ID& item (void);
+
+  /// Read-only item accessor.
+  const INT_ID& item (void) const;
+
+  /// Key used to look up an entry.
+  EXT_ID ext_id_;
+
+  /// The contents of the entry itself.
+  INT_ID int_id_;
+
+  /// Dump the state of an object.
+  void dump (void) const;
+};
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Iterator_Base;
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Iterator;
+
+// Forward decl.
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Reverse_Iterator;
+
+// Forward decl.
+class ACE_Allocator;
+
+/**
+ * @class ACE_Flat_Hash_Map
+ *
+ * @brief Define a map abstraction that associates @c EXT_ID type
+ * objects with @c INT_ID type objects in a single open addressed
+ * table.
+ *
+ * ACE_Hash_Map_Manager_Ex allocates every entry separately and chains
+ * the entries of a bucket, so each lookup follows pointers around the
+ * heap.  This map stores the entries themselves in one array, with an
+ * array of one control byte per entry next to it: the byte is either
+ * empty, deleted, or holds 7 bits of the hash of the key of the entry.
+ * A lookup reads the control bytes 16 at a time (with a single SSE2
+ * compare where available), and only compares the keys of the entries
+ * whose byte matches, which is almost always the one being looked up.
+ *
+ * The interface is the one of ACE_Hash_Map_Manager_Ex, with the same
+ * @c HASH_KEY and @c COMPARE_KEYS functors (ACE_Hash and
+ * ACE_Equal_To), and the same return values.  The differences are
+ * those of the storage:
+ *
+ * - the table grows (doubles) by itself when it is 7/8 full, so the
+ *   size given to open() is only a hint: the number of entries which
+ *   fit without growing.  total_size() is the number of slots.
+ * - a bind which grows the table moves the entries: the entries
+ *   returned by find(), bind(), ... and the iterators are only valid
+ *   until the next bind, trybind or rebind which adds an entry.
+ *   Unbinding entries doesn't move the others.
+ * - @c EXT_ID and @c INT_ID must be copy constructible, and a hash
+ *   of a key must not change while the key is in the map.
+ *
+ * The table is allocated with an ACE_Allocator in one piece; there is
+ * no separate entry allocator.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map
+{
+public:
+  friend class ACE_Flat_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+  friend class ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+  friend class ACE_Flat_Hash_Map_Reverse_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>;
+
+  typedef EXT_ID
+          KEY;
+  typedef INT_ID
+          VALUE;
+  typedef ACE_LOCK lock_type;
+  typedef ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>
+          ENTRY;
+
+  // = ACE-style iterator typedefs.
+  typedef ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          ITERATOR;
+  typedef ACE_Flat_Hash_Map_Reverse_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          REVERSE_ITERATOR;
+
+  // = STL-style iterator typedefs.
+  typedef ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          iterator;
+  typedef ACE_Flat_Hash_Map_Reverse_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+          reverse_iterator;
+
+  // = STL-style typedefs/traits.
+  typedef EXT_ID                                  key_type;
+  typedef INT_ID                                  data_type;
+  typedef ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> value_type;
+  typedef value_type &                            reference;
+  typedef value_type const &                      const_reference;
+  typedef value_type *                            pointer;
+  typedef value_type const *                      const_pointer;
+  typedef ptrdiff_t                               difference_type;
+  typedef size_t                                  size_type;
+
+  // = Initialization and termination methods.
+
+  /// Initialize a map that holds ACE_DEFAULT_MAP_SIZE entries without
+  /// growing.
+  ACE_Flat_Hash_Map (ACE_Allocator *table_alloc = 0);
+
+  /// Initialize a map that holds @a size entries without growing.
+  ACE_Flat_Hash_Map (size_t size,
+                     ACE_Allocator *table_alloc = 0);
+
+  /**
+   * Initialize a map that holds @a size entries without growing.  If
+   * @a table_alloc is 0, ACE_Allocator::instance() is used.  Returns
+   * -1 on failure, 0 on success.
+   */
+  int open (size_t size = ACE_DEFAULT_MAP_SIZE,
+            ACE_Allocator *table_alloc = 0);
+
+  /// Close down the map and release dynamically allocated resources.
+  int close (void);
+
+  /// Removes all the entries in the map.
+  int unbind_all (void);
+
+  /// Cleanup the map.
+  ~ACE_Flat_Hash_Map (void);
+
+  /**
+   * Associate @a ext_id with @a int_id.  If @a ext_id is already in
+   * the map then the map is not changed.  Returns 0 if a new entry is
+   * bound successfully, returns 1 if an attempt is made to bind an
+   * existing entry, and returns -1 if failures occur.
+   */
+  int bind (const EXT_ID &ext_id,
+            const INT_ID &int_id);
+
+  /// Same as the other bind(), but also return the entry of
+  /// @a ext_id in @a entry.
+  int bind (const EXT_ID &ext_id,
+            const INT_ID &int_id,
+            ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /**
+   * Associate @a ext_id with @a int_id if and only if @a ext_id is
+   * not in the map.  If @a ext_id is already in the map then the
+   * @a int_id parameter is assigned the existing value in the map.
+   * Returns 0 if a new entry is bound successfully, returns 1 if an
+   * attempt is made to bind an existing entry, and returns -1 if
+   * failures occur.
+   */
+  int trybind (const EXT_ID &ext_id,
+               INT_ID &int_id);
+
+  /// Same as the other trybind(), but also return the entry of
+  /// @a ext_id in @a entry.
+  int trybind (const EXT_ID &ext_id,
+               INT_ID &int_id,
+               ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /**
+   * Reassociate @a ext_id with @a int_id.  If @a ext_id is not in the
+   * map then behaves just like bind().  Returns 0 if a new entry is
+   * bound successfully, returns 1 if an existing entry was rebound,
+   * and returns -1 if failures occur.
+   */
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id);
+
+  /// Same as the other rebind(), but also return the entry of
+  /// @a ext_id in @a entry.
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Same as rebind(), but also return the value @a ext_id was
+  /// associated with, if any, in @a old_int_id.
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              INT_ID &old_int_id);
+
+  /// Same as the other rebind(), but also return the entry of
+  /// @a ext_id in @a entry.
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              INT_ID &old_int_id,
+              ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Same as rebind(), but also return the key and the value of the
+  /// entry of @a ext_id, if any, in @a old_ext_id and @a old_int_id.
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              EXT_ID &old_ext_id,
+              INT_ID &old_int_id);
+
+  /// Same as the other rebind(), but also return the entry of
+  /// @a ext_id in @a entry.
+  int rebind (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              EXT_ID &old_ext_id,
+              INT_ID &old_int_id,
+              ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Locate @a ext_id and pass out the value it is associated with
+  /// in @a int_id.  Returns 0 if found, -1 if not.
+  int find (const EXT_ID &ext_id,
+            INT_ID &int_id) const;
+
+  /// Returns 0 if @a ext_id is in the map, otherwise -1.
+  int find (const EXT_ID &ext_id) const;
+
+  /// Locate @a ext_id and pass out its entry in @a entry.  Returns 0
+  /// if found, -1 if not.
+  int find (const EXT_ID &ext_id,
+            ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry) const;
+
+  /// Unbind (remove) the @a ext_id from the map.  Returns 0 if
+  /// successful, -1 if @a ext_id isn't in the map.
+  int unbind (const EXT_ID &ext_id);
+
+  /// Same as the other unbind(), but also return the value @a ext_id
+  /// was associated with in @a int_id.
+  int unbind (const EXT_ID &ext_id,
+              INT_ID &int_id);
+
+  /// Remove @a entry from the map.  Returns 0 if successful, -1 if
+  /// @a entry isn't an entry of the map.
+  int unbind (ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *entry);
+
+  /// Returns the current number of entries in the map.
+  size_t current_size (void) const;
+
+  /// Returns the number of slots of the table.
+  size_t total_size (void) const;
+
+  /// Returns a reference to the underlying lock.
+  ACE_LOCK &mutex (void);
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  // = STL styled iterator factory functions.
+
+  /// Return forward iterator.
+  iterator begin (void);
+  iterator end (void);
+
+  /// Return reverse iterator.
+  reverse_iterator rbegin (void);
+  reverse_iterator rend (void);
+
+protected:
+  // = The following methods do the actual work, without locking.
+
+  /// Returns 1 if @a id1 == @a id2, else 0.
+  int equal (const EXT_ID &id1, const EXT_ID &id2) const;
+
+  /// Compute the hash of @a ext_id, with its bits mixed, so that the
+  /// low bits pick a slot and the high ones the control byte.
+  ACE_UINT64 hash (const EXT_ID &ext_id) const;
+
+  /// Performs bind.  Must be called with locks held.
+  int bind_i (const EXT_ID &ext_id,
+              const INT_ID &int_id,
+              ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Performs trybind.  Must be called with locks held.
+  int trybind_i (const EXT_ID &ext_id,
+                 INT_ID &int_id,
+                 ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Performs rebind.  Must be called with locks held.
+  int rebind_i (const EXT_ID &ext_id,
+                const INT_ID &int_id,
+                EXT_ID *old_ext_id,
+                INT_ID *old_int_id,
+                ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&entry);
+
+  /// Performs unbind.  Must be called with locks held.
+  int unbind_i (const EXT_ID &ext_id,
+                INT_ID *int_id);
+
+  /// Destroy the entry in @a slot and mark the slot free.  Must be
+  /// called with locks held.
+  void erase_i (size_t slot);
+
+  /// Close down the map.  Must be called with locks held.
+  int close_i (void);
+
+  /// Removes all the entries.  Must be called with locks held.
+  int unbind_all_i (void);
+
+  /// Allocate a table of @a capacity slots, all of them empty.
+  int create_table (size_t capacity);
+
+  /// Returns the slot of @a ext_id, whose hash is @a hash, or -1.
+  ssize_t find_i (const EXT_ID &ext_id,
+                  ACE_UINT64 hash) const;
+
+  /// Returns the first slot which is empty or deleted along the probe
+  /// sequence of @a hash.
+  size_t find_free_i (ACE_UINT64 hash) const;
+
+  /// Add a new entry for @a ext_id, whose hash is @a hash, growing
+  /// the table first if needed.  Returns -1 if that fails.
+  ssize_t insert_i (const EXT_ID &ext_id,
+                    const INT_ID &int_id,
+                    ACE_UINT64 hash);
+
+  /// Move the entries to a new table, of twice as many slots if the
+  /// table is more than half full, else of as many slots (to drop the
+  /// deleted ones).
+  int grow_i (void);
+
+  /// Set the control byte of @a slot, and its copy after the end of
+  /// the table.
+  void set_ctrl_i (size_t slot, ACE_INT8 ctrl);
+
+  // = Matching the control bytes of a group.
+
+  /// Returns a mask with bit @c i set if byte @c i of the group at
+  /// @a ctrl is @a h2.
+  static ACE_UINT32 match_i (const ACE_INT8 *ctrl, ACE_INT8 h2);
+
+  /// Returns a mask with bit @c i set if byte @c i of the group at
+  /// @a ctrl is empty.
+  static ACE_UINT32 match_empty_i (const ACE_INT8 *ctrl);
+
+  /// Returns a mask with bit @c i set if byte @c i of the group at
+  /// @a ctrl is empty or deleted.
+  static ACE_UINT32 match_free_i (const ACE_INT8 *ctrl);
+
+  /// Returns the index of the lowest bit set in @a mask, which isn't 0.
+  static size_t lowest_bit_i (ACE_UINT32 mask);
+
+  /// Returns the index of the highest bit set in @a mask, which isn't 0.
+  static size_t highest_bit_i (ACE_UINT32 mask);
+
+  enum
+  {
+    /// Number of control bytes matched at once.
+    GROUP_WIDTH = 16,
+
+    /// Control byte of an empty slot.
+    CTRL_EMPTY = -128,
+
+    /// Control byte of the slot of an unbound entry.
+    CTRL_DELETED = -2
+  };
+
+  /// Pointer to the memory allocator used for the table.
+  ACE_Allocator *table_allocator_;
+
+  /// Synchronization variable for the MT_SAFE ACE_Flat_Hash_Map.
+  mutable ACE_LOCK lock_;
+
+  /// Function object used for hashing keys.
+  HASH_KEY hash_key_;
+
+  /// Function object used for comparing keys.
+  COMPARE_KEYS compare_keys_;
+
+private:
+  /// The entries, of which only those whose control byte isn't
+  /// negative are constructed.
+  ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *slots_;
+
+  /// The control bytes; they follow the entries, in the same block,
+  /// and the first GROUP_WIDTH - 1 ones are copied after the last
+  /// one, so that any group can be read at once.
+  ACE_INT8 *ctrl_;
+
+  /// Number of slots of the table, a power of 2.
+  size_t total_size_;
+
+  /// Current number of entries in the table.
+  size_t cur_size_;
+
+  /// Number of entries which can still be added to empty slots
+  /// before the table has to grow.
+  size_t growth_left_;
+
+  // = Disallow these operations.
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &))
+  ACE_UNIMPLEMENTED_FUNC (ACE_Flat_Hash_Map (const ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &))
+};
+
+/**
+ * @class ACE_Flat_Hash_Map_Iterator_Base
+ *
+ * @brief Base iterator for the ACE_Flat_Hash_Map
+ *
+ * This class factors out common code from its templatized
+ * subclasses.  It walks the slots of the table, and stops at those
+ * which hold an entry.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Iterator_Base
+{
+public:
+  // = STL-style typedefs/traits.
+  typedef ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+  container_type;
+
+  // = std::iterator_traits typedefs/traits.
+  typedef typename container_type::value_type      value_type;
+  typedef typename container_type::reference       reference;
+  typedef typename container_type::pointer         pointer;
+  typedef typename container_type::difference_type difference_type;
+
+  /// Constructor.  Unless @a done is true, the iterator is on the
+  /// first entry of @a mm (the last one, if @a forward is false).
+  ACE_Flat_Hash_Map_Iterator_Base (ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &mm,
+                                   bool forward,
+                                   bool done);
+
+  /// Pass back the @a next_entry that hasn't been seen in the map.
+  /// Returns 0 when all items have been seen, else 1.
+  int next (ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID> *&next_entry) const;
+
+  /// Returns 1 when all items have been seen, else 0.
+  int done (void) const;
+
+  /// Returns a reference to the interal element @c this is pointing to.
+  ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>& operator* (void) const;
+
+  /// Returns a pointer to the interal element @c this is pointing to.
+  ACE_Flat_Hash_Map_Entry<EXT_ID, INT_ID>* operator-> (void) const;
+
+  /// Returns reference the ACE_Flat_Hash_Map that is being iterated
+  /// over.
+  ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>& map (void);
+
+  /// Check if two iterators point to the same position
+  bool operator== (const ACE_Flat_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &) const;
+  bool operator!= (const ACE_Flat_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// Move forward by one entry.  Returns 0 when all entries have
+  /// been seen, else 1.
+  int forward_i (void);
+
+  /// Move backward by one entry.  Returns 0 when all entries have
+  /// been seen, else 1.
+  int reverse_i (void);
+
+  /// Dump the state of an object.
+  void dump_i (void) const;
+
+  /// Map we are iterating over.
+  ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> *map_man_;
+
+  /// Slot we are looking at; -1 or total_size() once done.
+  ssize_t index_;
+};
+
+/**
+ * @class ACE_Flat_Hash_Map_Iterator
+ *
+ * @brief Forward iterator for the ACE_Flat_Hash_Map.
+ *
+ * This class does not perform any internal locking of the
+ * ACE_Flat_Hash_Map it is iterating upon since locking is
+ * inherently inefficient and/or error-prone within an STL-style
+ * iterator.  If you require locking, you can explicitly use an
+ * ACE_GUARD or ACE_READ_GUARD on the ACE_Flat_Hash_Map's internal
+ * lock, which is accessible via its mutex() method.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Iterator : public ACE_Flat_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+{
+public:
+  // = STL-style traits/typedefs
+  typedef typename ACE_Flat_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::container_type
+  container_type;
+
+  // = STL-style traits/typedefs
+  typedef std::bidirectional_iterator_tag          iterator_category;
+  typedef typename container_type::value_type      value_type;
+  typedef typename container_type::reference       reference;
+  typedef typename container_type::pointer         pointer;
+  typedef typename container_type::difference_type difference_type;
+
+  /// Constructor.
+  ACE_Flat_Hash_Map_Iterator (ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &mm,
+                              int tail = 0);
+
+  /// Move forward by one element in the set.  Returns 0 when all the
+  /// items in the set have been seen, else 1.
+  int advance (void);
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  // = STL styled iteration, compare, and reference functions.
+
+  /// Prefix advance.
+  ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator++ (void);
+
+  /// Postfix advance.
+  ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator++ (int);
+
+  /// Prefix reverse.
+  ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator-- (void);
+
+  /// Postfix reverse.
+  ACE_Flat_Hash_Map_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator-- (int);
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+};
+
+/**
+ * @class ACE_Flat_Hash_Map_Reverse_Iterator
+ *
+ * @brief Reverse iterator for the ACE_Flat_Hash_Map.
+ *
+ * This class does not perform any internal locking of the
+ * ACE_Flat_Hash_Map it is iterating upon since locking is
+ * inherently inefficient and/or error-prone within an STL-style
+ * iterator.  If you require locking, you can explicitly use an
+ * ACE_GUARD or ACE_READ_GUARD on the ACE_Flat_Hash_Map's internal
+ * lock, which is accessible via its mutex() method.
+ */
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
+class ACE_Flat_Hash_Map_Reverse_Iterator : public ACE_Flat_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>
+{
+public:
+  // = STL-style traits/typedefs
+  typedef typename ACE_Flat_Hash_Map_Iterator_Base<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::container_type
+  container_type;
+
+  // = std::iterator_traits typedefs
+  typedef std::bidirectional_iterator_tag          iterator_category;
+  typedef typename container_type::value_type      value_type;
+  typedef typename container_type::reference       reference;
+  typedef typename container_type::pointer         pointer;
+  typedef typename container_type::difference_type difference_type;
+
+  /// Constructor.
+  ACE_Flat_Hash_Map_Reverse_Iterator (ACE_Flat_Hash_Map<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &mm,
+                                      bool head = false);
+
+  /// Move forward by one element in the set.  Returns 0 when all the
+  /// items in the set have been seen, else 1.
+  int advance (void);
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  // = STL styled iteration, compare, and reference functions.
+
+  /// Prefix reverse.
+  ACE_Flat_Hash_Map_Reverse_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator++ (void);
+
+  /// Postfix reverse.
+  ACE_Flat_Hash_Map_Reverse_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator++ (int);
+
+  /// Prefix advance.
+  ACE_Flat_Hash_Map_Reverse_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> &operator-- (void);
+
+  /// Postfix advance.
+  ACE_Flat_Hash_Map_Reverse_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> operator-- (int);
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#  include "ace/Flat_Hash_Map_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Flat_Hash_Map_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Flat_Hash_Map_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_FLAT_HASH_MAP_T_H */
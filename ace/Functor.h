@@ -237,7 +237,8 @@ template<>
 class ACE_Export ACE_Hash<const char *>
 {
 public:
-  /// Calls ACE::hash_pjw
+  /// Calls ACE::hash64, or ACE::hash_pjw if ACE_USES_PJW_STRING_HASH
+  /// is defined.
   unsigned long operator () (const char *t) const;
 };
 
@@ -248,7 +249,8 @@ template<>
 class ACE_Export ACE_Hash<char *>
 {
 public:
-  /// Calls ACE::hash_pjw
+  /// Calls ACE::hash64, or ACE::hash_pjw if ACE_USES_PJW_STRING_HASH
+  /// is defined.
   unsigned long operator () (const char *t) const;
 };
 
@@ -399,7 +401,8 @@ template<>
 class ACE_Export ACE_Hash<const wchar_t *>
 {
 public:
-  /// Calls ACE::hash_pjw
+  /// Calls ACE::hash64, or ACE::hash_pjw if ACE_USES_PJW_STRING_HASH
+  /// is defined.
   unsigned long operator () (const wchar_t *t) const;
 };
 
@@ -410,7 +413,8 @@ template<>
 class ACE_Export ACE_Hash<wchar_t *>
 {
 public:
-  /// Calls ACE::hash_pjw
+  /// Calls ACE::hash64, or ACE::hash_pjw if ACE_USES_PJW_STRING_HASH
+  /// is defined.
   unsigned long operator () (const wchar_t *t) const;
 };
 
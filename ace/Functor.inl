@@ -131,13 +131,21 @@ ACE_Hash<ACE_UINT64>::operator () (const ACE_UINT64 &t) const
 ACE_INLINE unsigned long
 ACE_Hash<const char *>::operator () (const char *t) const
 {
+#if defined (ACE_USES_PJW_STRING_HASH)
   return ACE::hash_pjw (t);
+#else
+  return static_cast<unsigned long> (ACE::hash64 (t, ACE_OS::strlen (t)));
+#endif /* ACE_USES_PJW_STRING_HASH */
 }
 
 ACE_INLINE unsigned long
 ACE_Hash<char *>::operator () (const char *t) const
 {
+#if defined (ACE_USES_PJW_STRING_HASH)
   return ACE::hash_pjw (t);
+#else
+  return static_cast<unsigned long> (ACE::hash64 (t, ACE_OS::strlen (t)));
+#endif /* ACE_USES_PJW_STRING_HASH */
 }
 
 ACE_INLINE unsigned long
@@ -208,13 +216,21 @@ ACE_Less_Than<char *>::operator () (const char *lhs, const char *rhs) const
 ACE_INLINE unsigned long
 ACE_Hash<const wchar_t *>::operator () (const wchar_t *t) const
 {
+#if defined (ACE_USES_PJW_STRING_HASH)
   return ACE::hash_pjw (t);
+#else
+  return static_cast<unsigned long> (ACE::hash64 (t, ACE_OS::strlen (t) * sizeof (wchar_t)));
+#endif /* ACE_USES_PJW_STRING_HASH */
 }
 
 ACE_INLINE unsigned long
 ACE_Hash<wchar_t *>::operator () (const wchar_t *t) const
 {
+#if defined (ACE_USES_PJW_STRING_HASH)
   return ACE::hash_pjw (t);
+#else
+  return static_cast<unsigned long> (ACE::hash64 (t, ACE_OS::strlen (t) * sizeof (wchar_t)));
+#endif /* ACE_USES_PJW_STRING_HASH */
 }
 
 ACE_INLINE int
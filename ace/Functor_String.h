@@ -60,7 +60,8 @@ template<>
 class ACE_Export ACE_Hash<ACE_CString>
 {
 public:
-  /// Calls ACE::hash_pjw
+  /// Calls ACE::hash64, or ACE::hash_pjw if ACE_USES_PJW_STRING_HASH
+  /// is defined.
   unsigned long operator () (const ACE_CString &lhs) const;
 };
 
@@ -98,7 +99,8 @@ template<>
 class ACE_Export ACE_Hash<std::string>
 {
 public:
-  /// Calls ACE::hash_pjw
+  /// Calls ACE::hash64, or ACE::hash_pjw if ACE_USES_PJW_STRING_HASH
+  /// is defined.
   unsigned long operator () (const std::string &lhs) const;
 };
 
@@ -139,7 +141,8 @@ template<>
 class ACE_Export ACE_Hash<ACE_WString>
 {
 public:
-  /// Calls ACE::hash_pjw
+  /// Calls ACE::hash64, or ACE::hash_pjw if ACE_USES_PJW_STRING_HASH
+  /// is defined.
   unsigned long operator () (const ACE_WString &lhs) const;
 };
 
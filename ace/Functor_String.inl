@@ -10,7 +10,11 @@ ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 ACE_INLINE unsigned long
 ACE_Hash<ACE_CString>::operator () (const ACE_CString &t) const
 {
+#if defined (ACE_USES_PJW_STRING_HASH)
   return t.hash ();
+#else
+  return static_cast<unsigned long> (ACE::hash64 (t.fast_rep (), t.length ()));
+#endif /* ACE_USES_PJW_STRING_HASH */
 }
 
 
@@ -31,7 +35,11 @@ ACE_Less_Than<ACE_CString>::operator () (const ACE_CString &lhs,
 ACE_INLINE unsigned long
 ACE_Hash<std::string>::operator () (const std::string &t) const
 {
+#if defined (ACE_USES_PJW_STRING_HASH)
   return ACE::hash_pjw (t.c_str (), t.length ());
+#else
+  return static_cast<unsigned long> (ACE::hash64 (t.data (), t.length ()));
+#endif /* ACE_USES_PJW_STRING_HASH */
 }
 
 
@@ -53,7 +61,12 @@ ACE_Less_Than<std::string>::operator () (const std::string &lhs,
 ACE_INLINE unsigned long
 ACE_Hash<ACE_WString>::operator () (const ACE_WString &t) const
 {
+#if defined (ACE_USES_PJW_STRING_HASH)
   return t.hash ();
+#else
+  return static_cast<unsigned long> (ACE::hash64 (t.fast_rep (),
+                                                 t.length () * sizeof (ACE_WSTRING_TYPE)));
+#endif /* ACE_USES_PJW_STRING_HASH */
 }
 
 
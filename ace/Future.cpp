@@ -159,7 +159,21 @@ ACE_Future_Rep<T>::~ACE_Future_Rep (void)
 template <class T> int
 ACE_Future_Rep<T>::ready (void) const
 {
-  return this->value_ != 0;
+  return this->ready_value () != 0;
+}
+
+template <class T> T *
+ACE_Future_Rep<T>::ready_value (void) const
+{
+#if defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1)
+  T *const value = this->value_;
+  // Pairs with the barrier in set(): if the pointer is seen, so is
+  // the value it points to.
+  __sync_synchronize ();
+  return value;
+#else
+  return this->value_;
+#endif /* ACE_HAS_GCC_ATOMIC_BUILTINS */
 }
 
 template <class T> int
@@ -167,7 +181,7 @@ ACE_Future_Rep<T>::set (const T &r,
                         ACE_Future<T> &caller)
 {
   // If the value is already produced, ignore it...
-  if (this->value_ == 0)
+  if (this->ready_value () == 0)
     {
       ACE_GUARD_RETURN (ACE_SYNCH_RECURSIVE_MUTEX,
                         ace_mon,
@@ -178,10 +192,18 @@ ACE_Future_Rep<T>::set (const T &r,
 
       if (this->value_ == 0)       // Still no value, so proceed
         {
-          ACE_NEW_RETURN (this->value_,
+          T *value = 0;
+          ACE_NEW_RETURN (value,
                           T (r),
                           -1);
 
+          // Readers of a ready future don't lock <value_ready_mutex_>,
+          // so the value must be complete before they can see it.
+#if defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1)
+          __sync_synchronize ();
+#endif /* ACE_HAS_GCC_ATOMIC_BUILTINS */
+          this->value_ = value;
+
           // Remove and notify all subscribed observers.
           typename OBSERVER_COLLECTION::iterator iterator =
             this->observer_collection_.begin ();
@@ -207,8 +229,9 @@ template <class T> int
 ACE_Future_Rep<T>::get (T &value,
                         ACE_Time_Value *tv) const
 {
-  // If the value is already produced, return it.
-  if (this->value_ == 0)
+  // If the value is already produced, return it without locking.
+  T *ready = this->ready_value ();
+  if (ready == 0)
     {
       ACE_GUARD_RETURN (ACE_SYNCH_RECURSIVE_MUTEX, ace_mon,
                         this->value_ready_mutex_,
@@ -221,10 +244,11 @@ ACE_Future_Rep<T>::get (T &value,
         if (this->value_ready_.wait (tv) == -1)
           return -1;
 
+      ready = this->value_;
       // Destructor releases the lock.
     }
 
-  value = *this->value_;
+  value = *ready;
   return 0;
 }
 
@@ -262,7 +286,7 @@ template <class T>
 ACE_Future_Rep<T>::operator T ()
 {
   // If the value is already produced, return it.
-  if (this->value_ == 0)
+  if (this->ready_value () == 0)
     {
       // Constructor of ace_mon acquires the mutex.
       ACE_GUARD_RETURN (ACE_SYNCH_RECURSIVE_MUTEX, ace_mon, this->value_ready_mutex_, 0);
@@ -282,7 +306,7 @@ ACE_Future_Rep<T>::operator T ()
       // Destructor releases the mutex
     }
 
-  return *this->value_;
+  return *this->ready_value ();
 }
 
 template <class T>
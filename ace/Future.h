@@ -201,8 +201,17 @@ private:
   /// Is result available?
   int ready (void) const;
 
+  /**
+   * Return <value_> if the result is available, else 0.  Once set,
+   * the result never changes, so where ACE_HAS_GCC_ATOMIC_BUILTINS
+   * is defined this only needs a memory barrier, pairing with the one
+   * set() issues before publishing <value_>; readers of a ready
+   * future never take <value_ready_mutex_>.
+   */
+  T *ready_value (void) const;
+
   /// Pointer to the result.
-  T *value_;
+  T * volatile value_;
 
   /// Reference count.
   int ref_count_;
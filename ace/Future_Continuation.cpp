@@ -0,0 +1,272 @@
+// $Id$
+
+#ifndef ACE_FUTURE_CONTINUATION_CPP
+#define ACE_FUTURE_CONTINUATION_CPP
+
+#include "ace/Future_Continuation.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_THREADS)
+
+#include "ace/Reactor.h"
+#include "ace/Work_Stealing_Executor.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template <class T, class R>
+ACE_Future_Continuation<T, R>::~ACE_Future_Continuation (void)
+{
+}
+
+template <class T, class R>
+ACE_Future_Then<T, R>::ACE_Future_Then (ACE_Future_Continuation<T, R> *continuation,
+                                        const ACE_Future<R> &result,
+                                        ACE_Work_Stealing_Executor *executor,
+                                        ACE_Reactor *reactor)
+  : ACE_Event_Handler (reactor),
+    continuation_ (continuation),
+    result_ (result),
+    executor_ (executor)
+{
+}
+
+template <class T, class R>
+ACE_Future_Then<T, R>::~ACE_Future_Then (void)
+{
+  delete this->continuation_;
+}
+
+template <class T, class R> int
+ACE_Future_Then<T, R>::attach (ACE_Future<T> &future,
+                               ACE_Future_Continuation<T, R> *continuation,
+                               ACE_Future<R> &result,
+                               ACE_Work_Stealing_Executor *executor,
+                               ACE_Reactor *reactor)
+{
+  typedef ACE_Future_Then<T, R> THEN;
+  THEN *observer = 0;
+  ACE_NEW_NORETURN (observer,
+                    THEN (continuation, result, executor, reactor));
+  if (observer == 0)
+    {
+      delete continuation;
+      return -1;
+    }
+
+  if (future.attach (observer) == -1)
+    {
+      delete observer;
+      return -1;
+    }
+  return 0;
+}
+
+template <class T, class R> void
+ACE_Future_Then<T, R>::update (const ACE_Future<T> &future)
+{
+  // Called with the lock of the future held, so the continuation is
+  // only run here when it has nowhere else to go.
+  this->future_ = future;
+
+  if (this->executor_ != 0)
+    {
+      // The executor deletes this object after call().
+      if (this->executor_->execute (this) == 0)
+        return;
+    }
+  else if (this->reactor () != 0)
+    {
+      if (this->reactor ()->notify (this,
+                                    ACE_Event_Handler::EXCEPT_MASK) == 0)
+        return;
+    }
+
+  this->run ();
+  delete this;
+}
+
+template <class T, class R> int
+ACE_Future_Then<T, R>::call (void)
+{
+  this->run ();
+  return 0;
+}
+
+template <class T, class R> int
+ACE_Future_Then<T, R>::handle_exception (ACE_HANDLE)
+{
+  this->run ();
+  delete this;
+  return 0;
+}
+
+template <class T, class R> void
+ACE_Future_Then<T, R>::run (void)
+{
+  this->result_.set (this->continuation_->call (this->future_));
+}
+
+template <class T>
+ACE_Future_When<T>::State::State (const ACE_Future<int> &result,
+                                  bool any,
+                                  long remaining)
+  : result_ (result),
+    any_ (any),
+    failed_ (false),
+    remaining_ (remaining)
+{
+}
+
+template <class T>
+ACE_Future_When<T>::ACE_Future_When (State *state, int index)
+  : state_ (state),
+    index_ (index)
+{
+}
+
+template <class T> void
+ACE_Future_When<T>::update (const ACE_Future<T> &)
+{
+  State *const state = this->state_;
+
+  // Only the first call sets the future.
+  if (state->any_)
+    state->result_.set (this->index_);
+
+  if (--state->remaining_ == 0)
+    {
+      if (!state->any_ && !state->failed_)
+        state->result_.set (0);
+      delete state;
+    }
+
+  delete this;
+}
+
+template <class T> int
+ACE_Future_When<T>::attach (ACE_Future<T> futures[],
+                            size_t count,
+                            ACE_Future<int> &result,
+                            bool any)
+{
+  if (count == 0)
+    {
+      if (any)
+        {
+          errno = EINVAL;
+          return -1;
+        }
+      return result.set (0);
+    }
+
+  State *state = 0;
+  ACE_NEW_RETURN (state,
+                  State (result, any, static_cast<long> (count)),
+                  -1);
+
+  // Allocate all the observers first: once one is attached, the
+  // state may go any time.
+  ACE_Future_When<T> **observers = 0;
+  ACE_NEW_NORETURN (observers, ACE_Future_When<T> *[count]);
+  if (observers == 0)
+    {
+      delete state;
+      return -1;
+    }
+
+  size_t made = 0;
+  for (; made < count; ++made)
+    {
+      ACE_NEW_NORETURN (observers[made],
+                        ACE_Future_When<T> (state,
+                                            static_cast<int> (made)));
+      if (observers[made] == 0)
+        break;
+    }
+
+  if (made < count)
+    {
+      for (size_t i = 0; i < made; ++i)
+        delete observers[i];
+      delete [] observers;
+      delete state;
+      return -1;
+    }
+
+  int status = 0;
+  for (size_t i = 0; i < count; ++i)
+    if (futures[i].attach (observers[i]) == -1)
+      {
+        // Count it as set, but for a when_all() result.
+        status = -1;
+        state->failed_ = true;
+        if (--state->remaining_ == 0)
+          delete state;
+        delete observers[i];
+      }
+
+  delete [] observers;
+  return status;
+}
+
+namespace ACE
+{
+  template <class T, class R> int
+  then (ACE_Future<T> &future,
+        ACE_Future_Continuation<T, R> *continuation,
+        ACE_Future<R> &result,
+        ACE_Work_Stealing_Executor &executor)
+  {
+    return ACE_Future_Then<T, R>::attach (future,
+                                          continuation,
+                                          result,
+                                          &executor,
+                                          0);
+  }
+
+  template <class T, class R> int
+  then (ACE_Future<T> &future,
+        ACE_Future_Continuation<T, R> *continuation,
+        ACE_Future<R> &result,
+        ACE_Reactor &reactor)
+  {
+    return ACE_Future_Then<T, R>::attach (future,
+                                          continuation,
+                                          result,
+                                          0,
+                                          &reactor);
+  }
+
+  template <class T, class R> int
+  then (ACE_Future<T> &future,
+        ACE_Future_Continuation<T, R> *continuation,
+        ACE_Future<R> &result)
+  {
+    return ACE_Future_Then<T, R>::attach (future, continuation, result, 0, 0);
+  }
+
+  template <class T> int
+  when_all (ACE_Future<T> futures[],
+            size_t count,
+            ACE_Future<int> &result)
+  {
+    return ACE_Future_When<T>::attach (futures, count, result, false);
+  }
+
+  template <class T> int
+  when_any (ACE_Future<T> futures[],
+            size_t count,
+            ACE_Future<int> &result)
+  {
+    return ACE_Future_When<T>::attach (futures, count, result, true);
+  }
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_THREADS */
+
+#endif /* ACE_FUTURE_CONTINUATION_CPP */
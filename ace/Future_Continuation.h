@@ -0,0 +1,232 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Future_Continuation.h
+ *
+ *  $Id$
+ *
+ *  Continuations and compositions of ACE_Future objects, for callers
+ *  which would otherwise block a thread on each ACE_Future::get().
+ */
+//=============================================================================
+
+#ifndef ACE_FUTURE_CONTINUATION_H
+#define ACE_FUTURE_CONTINUATION_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Future.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_THREADS)
+
+#include "ace/Method_Request.h"
+#include "ace/Event_Handler.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Thread_Mutex.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Reactor;
+class ACE_Work_Stealing_Executor;
+
+/**
+ * @class ACE_Future_Continuation
+ *
+ * @brief Computation run on the value of an ACE_Future<T> once it is
+ * set, whose result sets an ACE_Future<R>.
+ *
+ * Continuations are given to ACE::then(), which deletes them once
+ * their call() has returned.
+ */
+template <class T, class R>
+class ACE_Future_Continuation
+{
+public:
+  /// Destructor.
+  virtual ~ACE_Future_Continuation (void);
+
+  /// Compute the result of the continuation.  @a future is set, so
+  /// its get() returns at once.
+  virtual R call (const ACE_Future<T> &future) = 0;
+};
+
+/**
+ * @class ACE_Future_Then
+ *
+ * @internal
+ *
+ * @brief Observer of the ACE_Future given to ACE::then(), running
+ * the continuation where it was asked to run when the future is set.
+ *
+ * It deletes itself, or is deleted by the executor, once the
+ * continuation has run.
+ */
+template <class T, class R>
+class ACE_Future_Then : public ACE_Future_Observer<T>,
+                        public ACE_Method_Request,
+                        public ACE_Event_Handler
+{
+public:
+  ACE_Future_Then (ACE_Future_Continuation<T, R> *continuation,
+                   const ACE_Future<R> &result,
+                   ACE_Work_Stealing_Executor *executor,
+                   ACE_Reactor *reactor);
+
+  virtual ~ACE_Future_Then (void);
+
+  /// Schedule the continuation on the executor or the reactor, or
+  /// run it, when @a future is set.
+  virtual void update (const ACE_Future<T> &future);
+
+  /// Run the continuation, when scheduled on the executor.
+  virtual int call (void);
+
+  /// Run the continuation, when notified by the reactor.
+  virtual int handle_exception (ACE_HANDLE);
+
+  /// Attach an observer running @a continuation to @a future;
+  /// implements ACE::then().
+  static int attach (ACE_Future<T> &future,
+                     ACE_Future_Continuation<T, R> *continuation,
+                     ACE_Future<R> &result,
+                     ACE_Work_Stealing_Executor *executor,
+                     ACE_Reactor *reactor);
+
+private:
+  /// Run the continuation and set the result.
+  void run (void);
+
+  ACE_Future_Continuation<T, R> *continuation_;
+  ACE_Future<T> future_;
+  ACE_Future<R> result_;
+  ACE_Work_Stealing_Executor *executor_;
+};
+
+/**
+ * @class ACE_Future_When
+ *
+ * @internal
+ *
+ * @brief Observer of one of the ACE_Future objects given to
+ * ACE::when_all() or ACE::when_any().
+ *
+ * There is one per future; each deletes itself once its future is
+ * set, the last one deleting the state shared by all of them.
+ */
+template <class T>
+class ACE_Future_When : public ACE_Future_Observer<T>
+{
+public:
+  /// State shared by the observers of the futures.
+  struct State
+  {
+    State (const ACE_Future<int> &result, bool any, long remaining);
+
+    /// Set when all the futures or one of them are set.
+    ACE_Future<int> result_;
+
+    /// Set the result to the index of the first future set, rather
+    /// than to 0 once they all are.
+    bool any_;
+
+    /// An observer could not be attached, so a when_all() result is
+    /// never set.
+    bool failed_;
+
+    /// Observers not updated yet.
+    ACE_Atomic_Op<ACE_Thread_Mutex, long> remaining_;
+  };
+
+  ACE_Future_When (State *state, int index);
+
+  /// Count the future as set, setting the result if it is due.
+  virtual void update (const ACE_Future<T> &future);
+
+  /// Attach an observer to each of @a futures; implements
+  /// ACE::when_all() and ACE::when_any().
+  static int attach (ACE_Future<T> futures[],
+                     size_t count,
+                     ACE_Future<int> &result,
+                     bool any);
+
+private:
+  State *state_;
+  int index_;
+};
+
+namespace ACE
+{
+  /**
+   * When @a future is set, run @a continuation on a worker of
+   * @a executor, and set @a result to the value returned by its
+   * call().  If the future is already set, the continuation is
+   * scheduled at once.  If @a executor refuses the continuation, it
+   * is run by the thread setting the future instead.  The
+   * continuation is deleted after it has run.
+   *
+   * @retval  0   Success.
+   * @retval -1   Error; @a continuation is deleted.
+   */
+  template <class T, class R>
+  int then (ACE_Future<T> &future,
+            ACE_Future_Continuation<T, R> *continuation,
+            ACE_Future<R> &result,
+            ACE_Work_Stealing_Executor &executor);
+
+  /// As above, running @a continuation in the event loop of
+  /// @a reactor, which it gets into through ACE_Reactor::notify().
+  template <class T, class R>
+  int then (ACE_Future<T> &future,
+            ACE_Future_Continuation<T, R> *continuation,
+            ACE_Future<R> &result,
+            ACE_Reactor &reactor);
+
+  /// As above, running @a continuation in the thread setting
+  /// @a future, or in the calling thread if it is already set.
+  template <class T, class R>
+  int then (ACE_Future<T> &future,
+            ACE_Future_Continuation<T, R> *continuation,
+            ACE_Future<R> &result);
+
+  /**
+   * Set @a result to 0 once all of the @a count futures of
+   * @a futures are set, at once if @a count is 0.  Use then() on
+   * @a result to run a continuation at that point.
+   *
+   * The observers attached to the futures are freed as these are
+   * set, so a future which is never set, or cancelled, leaks one.
+   *
+   * @retval  0   Success.
+   * @retval -1   Error; @a result is not set.
+   */
+  template <class T>
+  int when_all (ACE_Future<T> futures[],
+                size_t count,
+                ACE_Future<int> &result);
+
+  /// Set @a result to the index in @a futures of the first one of the
+  /// @a count futures to be set.  Fails with @c errno EINVAL if
+  /// @a count is 0.
+  template <class T>
+  int when_any (ACE_Future<T> futures[],
+                size_t count,
+                ACE_Future<int> &result);
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Future_Continuation.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Future_Continuation.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#endif /* ACE_HAS_THREADS */
+#include /**/ "ace/post.h"
+#endif /* ACE_FUTURE_CONTINUATION_H */
@@ -94,6 +94,9 @@ ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::dump
   ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
   ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("total_size_ = %d\n"), this->total_size_));
   ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("cur_size_ = %d\n"), this->cur_size_));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("old_size_ = %d\n"), this->old_size_));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("rehash_index_ = %d\n"), this->rehash_index_));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("max_load_ = %d\n"), this->max_load_));
   this->table_allocator_->dump ();
   this->entry_allocator_->dump ();
   this->lock_.dump ();
@@ -152,9 +155,46 @@ ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::open
   if (size == 0)
     return -1;
 
+  // A growing table has a power of 2 number of buckets.
+  if (this->max_load_ != 0)
+    {
+      size_t buckets = 1;
+      while (buckets < size)
+        buckets <<= 1;
+      size = buckets;
+    }
+
   return this->create_buckets (size);
 }
 
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
+ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::max_load (size_t max_load)
+{
+  ACE_WRITE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+  if (max_load != 0
+      && this->table_ != 0
+      && (this->total_size_ & (this->total_size_ - 1)) != 0)
+    {
+      if (this->cur_size_ != 0)
+        {
+          errno = EINVAL;
+          return -1;
+        }
+
+      size_t size = 1;
+      while (size < this->total_size_)
+        size <<= 1;
+
+      this->close_i ();
+      if (this->create_buckets (size) == -1)
+        return -1;
+    }
+
+  this->max_load_ = max_load;
+  return 0;
+}
+
 template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
 ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::close_i (void)
 {
@@ -197,8 +237,12 @@ ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::unbin
   // <ACE_Hash_Map_Entry>.
   for (size_t i = 0; i < this->total_size_; i++)
     {
-      for (ACE_Hash_Map_Entry<EXT_ID, INT_ID> *temp_ptr = this->table_[i].next_;
-           temp_ptr != &this->table_[i];
+      ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket = this->bucket_at_i (i);
+      if (bucket == 0)
+        continue;
+
+      for (ACE_Hash_Map_Entry<EXT_ID, INT_ID> *temp_ptr = bucket->next_;
+           temp_ptr != bucket;
            )
         {
           ACE_Hash_Map_Entry<EXT_ID, INT_ID> *hold_ptr = temp_ptr;
@@ -210,15 +254,94 @@ ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::unbin
         }
 
       // Restore the sentinel.
-      this->table_[i].next_ = &this->table_[i];
-      this->table_[i].prev_ = &this->table_[i];
+      bucket->next_ = bucket;
+      bucket->prev_ = bucket;
     }
 
+  // Finish growing the table, if it was: there are no entries left to
+  // move, only the buckets of <table_> to initialize.
+  while (this->old_table_ != 0)
+    this->rehash_bucket_i ();
+
   this->cur_size_ = 0;
 
   return 0;
 }
 
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::grow_i (void)
+{
+  if (this->old_table_ != 0)
+    {
+      // The table grows again once it holds twice as many entries, so
+      // moving two buckets per new entry is done well before that.
+      this->rehash_bucket_i ();
+      if (this->old_table_ != 0)
+        this->rehash_bucket_i ();
+    }
+  else if (this->max_load_ != 0
+           && this->cur_size_ > this->max_load_ * this->total_size_)
+    {
+      size_t const size = 2 * this->total_size_;
+      void *ptr = this->table_allocator_->malloc (size * sizeof (ACE_Hash_Map_Entry<EXT_ID, INT_ID>));
+
+      // Keep the current table if there's no memory for a bigger one.
+      if (ptr == 0)
+        return;
+
+      // The buckets of the new table are initialized as the entries
+      // are moved to them.
+      this->old_table_ = this->table_;
+      this->old_size_ = this->total_size_;
+      this->rehash_index_ = 0;
+      this->table_ = static_cast<ACE_Hash_Map_Entry<EXT_ID, INT_ID> *> (ptr);
+      this->total_size_ = size;
+    }
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> void
+ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::rehash_bucket_i (void)
+{
+  // The entries of bucket i of <old_table_> go to bucket i or
+  // i + <old_size_> of <table_>, which is twice as big, in the same
+  // order: see next_position_i().
+  size_t const index = this->rehash_index_;
+  ACE_Hash_Map_Entry<EXT_ID, INT_ID> *old_bucket = &this->old_table_[index];
+  ACE_Hash_Map_Entry<EXT_ID, INT_ID> *low = &this->table_[index];
+  ACE_Hash_Map_Entry<EXT_ID, INT_ID> *high = &this->table_[index + this->old_size_];
+
+  new (low) ACE_Hash_Map_Entry<EXT_ID, INT_ID> (low, low);
+  new (high) ACE_Hash_Map_Entry<EXT_ID, INT_ID> (high, high);
+
+  for (ACE_Hash_Map_Entry<EXT_ID, INT_ID> *entry = old_bucket->next_;
+       entry != old_bucket;
+       )
+    {
+      ACE_Hash_Map_Entry<EXT_ID, INT_ID> *next = entry->next_;
+      ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket =
+        (this->hash (entry->ext_id_) & this->old_size_) == 0 ? low : high;
+
+      entry->next_ = bucket;
+      entry->prev_ = bucket->prev_;
+      bucket->prev_->next_ = entry;
+      bucket->prev_ = entry;
+
+      entry = next;
+    }
+
+  // bucket_i() no longer returns the old bucket.
+  ACE_DES_FREE_TEMPLATE2 (old_bucket, ACE_NOOP,
+                          ACE_Hash_Map_Entry, EXT_ID, INT_ID);
+
+  if (++this->rehash_index_ == this->old_size_)
+    {
+      this->table_allocator_->free (this->old_table_);
+      this->old_table_ = 0;
+      this->old_size_ = 0;
+      this->rehash_index_ = 0;
+    }
+}
+
 template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
 ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::bind_i (const EXT_ID &ext_id,
                                                                                    const INT_ID &int_id,
@@ -233,13 +356,15 @@ ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::bind_
                             this->entry_allocator_->malloc (sizeof (ACE_Hash_Map_Entry<EXT_ID, INT_ID>)),
                             -1);
 
+      ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket = this->bucket_address_i (loc);
       entry = new (ptr) ACE_Hash_Map_Entry<EXT_ID, INT_ID> (ext_id,
                                                             int_id,
-                                                            this->table_[loc].next_,
-                                                            &this->table_[loc]);
-      this->table_[loc].next_ = entry;
+                                                            bucket->next_,
+                                                            bucket);
+      bucket->next_ = entry;
       entry->next_->prev_ = entry;
       ++this->cur_size_;
+      this->grow_i ();
       return 0;
     }
   else
@@ -260,13 +385,15 @@ ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::trybi
                             this->entry_allocator_->malloc (sizeof (ACE_Hash_Map_Entry<EXT_ID, INT_ID>)),
                             -1);
 
+      ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket = this->bucket_address_i (loc);
       entry = new (ptr) ACE_Hash_Map_Entry<EXT_ID, INT_ID> (ext_id,
                                                             int_id,
-                                                            this->table_[loc].next_,
-                                                            &this->table_[loc]);
-      this->table_[loc].next_ = entry;
+                                                            bucket->next_,
+                                                            bucket);
+      bucket->next_ = entry;
       entry->next_->prev_ = entry;
       ++this->cur_size_;
+      this->grow_i ();
       return 0;
     }
   else
@@ -316,14 +443,15 @@ ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::share
       return -1;
     }
 
-  loc = this->hash (ext_id) % this->total_size_;
+  loc = this->bucket_of_i (ext_id);
 
-  ACE_Hash_Map_Entry<EXT_ID, INT_ID> *temp = this->table_[loc].next_;
+  ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket = this->bucket_address_i (loc);
+  ACE_Hash_Map_Entry<EXT_ID, INT_ID> *temp = bucket->next_;
 
-  while (temp != &this->table_[loc] && this->equal (temp->ext_id_, ext_id) == 0)
+  while (temp != bucket && this->equal (temp->ext_id_, ext_id) == 0)
     temp = temp->next_;
 
-  if (temp == &this->table_[loc])
+  if (temp == bucket)
     {
       errno = ENOENT;
       return -1;
@@ -400,6 +528,7 @@ ACE_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>:
 
   ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
   ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("index_ = %d "), this->index_));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("size_ = %d "), this->size_));
   ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("next_ = %x"), this->next_));
   ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
 }
@@ -411,27 +540,43 @@ ACE_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>:
 
   if (this->map_man_->table_ == 0)
     return -1;
-  // Handle initial case specially.
-  else if (this->index_ == -1)
+
+  // The iterator is on an entry, or on the sentinel of a bucket
+  // before the first entry, or after the last one.  It goes by the
+  // sentinels rather than by <index_>, as the entries may have moved
+  // to other buckets since it got there.
+  ssize_t position = 0;
+  if (this->map_man_->bucket_index_i (this->next_) == -1)
     {
-      this->index_++;
-      return this->forward_i ();
+      this->next_ = this->next_->next_;
+      if (this->map_man_->bucket_index_i (this->next_) == -1)
+        return 1;
+      position = this->map_man_->next_position_i (this->next_,
+                                                  this->index_,
+                                                  this->size_);
     }
-  else if (this->index_ >= static_cast<ssize_t> (this->map_man_->total_size_))
+  else if (this->index_ >= 0)
     return 0;
 
-  this->next_ = this->next_->next_;
-  if (this->next_ == &this->map_man_->table_[this->index_])
+  // Find the next bucket which isn't empty.
+  ssize_t const count = static_cast<ssize_t> (this->map_man_->total_size_);
+  for (; position < count; ++position)
     {
-      while (++this->index_ < static_cast<ssize_t> (this->map_man_->total_size_))
+      ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket = this->map_man_->bucket_at_i (position);
+      if (bucket != 0 && bucket->next_ != bucket)
         {
-          this->next_ = this->map_man_->table_[this->index_].next_;
-          if (this->next_ != &this->map_man_->table_[this->index_])
-            break;
+          this->map_man_->iterator_position_i (bucket,
+                                               this->index_,
+                                               this->size_);
+          this->next_ = bucket->next_;
+          return 1;
         }
     }
 
-  return this->index_ < static_cast<ssize_t> (this->map_man_->total_size_);
+  this->index_ = count;
+  this->size_ = this->map_man_->total_size_;
+  this->next_ = this->map_man_->table_;
+  return 0;
 }
 
 template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
@@ -441,26 +586,39 @@ ACE_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>:
 
   if (this->map_man_->table_ == 0)
     return -1;
-  else if (this->index_ == static_cast<ssize_t> (this->map_man_->total_size_))
+
+  // See forward_i().
+  ssize_t position = static_cast<ssize_t> (this->map_man_->total_size_) - 1;
+  if (this->map_man_->bucket_index_i (this->next_) == -1)
     {
-      --this->index_;
-      return this->reverse_i ();
+      this->next_ = this->next_->prev_;
+      if (this->map_man_->bucket_index_i (this->next_) == -1)
+        return 1;
+      position = this->map_man_->prev_position_i (this->next_,
+                                                  this->index_,
+                                                  this->size_);
     }
   else if (this->index_ < 0)
     return 0;
 
-  this->next_ = this->next_->prev_;
-  if (this->next_ == &this->map_man_->table_[this->index_])
+  // Find the previous bucket which isn't empty.
+  for (; position >= 0; --position)
     {
-      while (--this->index_ >= 0)
+      ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket = this->map_man_->bucket_at_i (position);
+      if (bucket != 0 && bucket->prev_ != bucket)
         {
-          this->next_ = this->map_man_->table_[this->index_].prev_;
-          if (this->next_ != &this->map_man_->table_[this->index_])
-            break;
+          this->map_man_->iterator_position_i (bucket,
+                                               this->index_,
+                                               this->size_);
+          this->next_ = bucket->prev_;
+          return 1;
         }
     }
 
-  return this->index_ >= 0;
+  this->index_ = -1;
+  this->size_ = this->map_man_->total_size_;
+  this->next_ = this->map_man_->table_;
+  return 0;
 }
 
 // ------------------------------------------------------------
@@ -474,6 +632,7 @@ ACE_Hash_Map_Const_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_
 
   ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
   ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("index_ = %d "), this->index_));
+  ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("size_ = %d "), this->size_));
   ACELIB_DEBUG ((LM_DEBUG,  ACE_TEXT ("next_ = %x"), this->next_));
   ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
 }
@@ -485,27 +644,43 @@ ACE_Hash_Map_Const_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_
 
   if (this->map_man_->table_ == 0)
     return -1;
-  // Handle initial case specially.
-  else if (this->index_ == -1)
+
+  // The iterator is on an entry, or on the sentinel of a bucket
+  // before the first entry, or after the last one.  It goes by the
+  // sentinels rather than by <index_>, as the entries may have moved
+  // to other buckets since it got there.
+  ssize_t position = 0;
+  if (this->map_man_->bucket_index_i (this->next_) == -1)
     {
-      ++this->index_;
-      return this->forward_i ();
+      this->next_ = this->next_->next_;
+      if (this->map_man_->bucket_index_i (this->next_) == -1)
+        return 1;
+      position = this->map_man_->next_position_i (this->next_,
+                                                  this->index_,
+                                                  this->size_);
     }
-  else if (this->index_ >= (ssize_t) this->map_man_->total_size_)
+  else if (this->index_ >= 0)
     return 0;
 
-  this->next_ = this->next_->next_;
-  if (this->next_ == &this->map_man_->table_[this->index_])
+  // Find the next bucket which isn't empty.
+  ssize_t const count = static_cast<ssize_t> (this->map_man_->total_size_);
+  for (; position < count; ++position)
     {
-      while (++this->index_ < (ssize_t) this->map_man_->total_size_)
+      ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket = this->map_man_->bucket_at_i (position);
+      if (bucket != 0 && bucket->next_ != bucket)
         {
-          this->next_ = this->map_man_->table_[this->index_].next_;
-          if (this->next_ != &this->map_man_->table_[this->index_])
-            break;
+          this->map_man_->iterator_position_i (bucket,
+                                               this->index_,
+                                               this->size_);
+          this->next_ = bucket->next_;
+          return 1;
         }
     }
 
-  return this->index_ < (ssize_t) this->map_man_->total_size_;
+  this->index_ = count;
+  this->size_ = this->map_man_->total_size_;
+  this->next_ = this->map_man_->table_;
+  return 0;
 }
 
 template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
@@ -515,26 +690,39 @@ ACE_Hash_Map_Const_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_
 
   if (this->map_man_->table_ == 0)
     return -1;
-  else if (this->index_ == (ssize_t) this->map_man_->total_size_)
+
+  // See forward_i().
+  ssize_t position = static_cast<ssize_t> (this->map_man_->total_size_) - 1;
+  if (this->map_man_->bucket_index_i (this->next_) == -1)
     {
-      --this->index_;
-      return this->reverse_i ();
+      this->next_ = this->next_->prev_;
+      if (this->map_man_->bucket_index_i (this->next_) == -1)
+        return 1;
+      position = this->map_man_->prev_position_i (this->next_,
+                                                  this->index_,
+                                                  this->size_);
     }
   else if (this->index_ < 0)
     return 0;
 
-  this->next_ = this->next_->prev_;
-  if (this->next_ == &this->map_man_->table_[this->index_])
+  // Find the previous bucket which isn't empty.
+  for (; position >= 0; --position)
     {
-      while (--this->index_ >= 0)
+      ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket = this->map_man_->bucket_at_i (position);
+      if (bucket != 0 && bucket->prev_ != bucket)
         {
-          this->next_ = this->map_man_->table_[this->index_].prev_;
-          if (this->next_ != &this->map_man_->table_[this->index_])
-            break;
+          this->map_man_->iterator_position_i (bucket,
+                                               this->index_,
+                                               this->size_);
+          this->next_ = bucket->prev_;
+          return 1;
         }
     }
 
-  return this->index_ >= 0;
+  this->index_ = -1;
+  this->size_ = this->map_man_->total_size_;
+  this->next_ = this->map_man_->table_;
+  return 0;
 }
 
 ACE_END_VERSIONED_NAMESPACE_DECL
@@ -123,6 +123,20 @@ class ACE_Allocator;
  * This class uses an ACE_Allocator to allocate memory.  The
  * user can make this a persistent class by providing an
  * ACE_Allocator with a persistable memory pool.
+ *
+ * The number of buckets is fixed by open(), unless max_load() is
+ * set: the table then doubles its number of buckets whenever it
+ * holds too many entries, and the binds that follow move the entries
+ * to the new buckets a couple of buckets at a time.  The iterators
+ * of a growing table go through its buckets in the order of their
+ * indices with the bits reversed, which puts the two buckets that the
+ * entries of a bucket move to next to each other, in its place.  An
+ * iteration thus visits every entry that was bound before it started
+ * and isn't unbound, even if binds made the table grow meanwhile; as
+ * before, it may or may not visit the entries bound during it, and
+ * the entries moved while it was on their bucket may be visited
+ * twice.  Unbinding entries while iterating is safe, as finds and
+ * unbinds never move entries.
  */
 
 template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK>
@@ -401,6 +415,23 @@ public:
   /// linked lists of ACE_Hash_Map_Entry objects in the hash table.
   size_t total_size (void) const;
 
+  /**
+   * Grow the table whenever it holds more than @a max_load entries
+   * per bucket on average, by doubling its number of buckets.  0, the
+   * default, keeps the number of buckets given to open().
+   *
+   * The number of buckets of a growing table is a power of 2, so that
+   * the bucket of a key is found with a mask: open() rounds it up, and
+   * an empty table is reopened with the next power of 2.  Returns -1
+   * with @c errno EINVAL if the table isn't empty and its size isn't a
+   * power of 2, 0 otherwise.
+   */
+  int max_load (size_t max_load);
+
+  /// Number of entries per bucket above which the table grows, 0 if
+  /// it doesn't.
+  size_t max_load (void) const;
+
   /**
    * Returns a reference to the underlying <ACE_LOCK>.  This makes it
    * possible to acquire the lock explicitly, which can be useful in
@@ -559,6 +590,65 @@ protected:
   /// Accessor of the underlying table
   ACE_Hash_Map_Entry<EXT_ID, INT_ID> *table (void);
 
+  // = The buckets.
+
+  /// Address of the sentinel of the bucket at @a index, in use or
+  /// not: the buckets of <old_table_>, while the table grows, then
+  /// those of <table_>.
+  ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket_address_i (size_t index) const;
+
+  /// Index of the bucket @a entry is the sentinel of, or -1 if it is
+  /// an entry of the map.
+  ssize_t bucket_index_i (const ACE_Hash_Map_Entry<EXT_ID, INT_ID> *entry) const;
+
+  // = The buckets, as the iterators see them.
+
+  /// Position of the bucket at @a index of <table_> in the order of
+  /// the iterators, and the reverse: @a index with its bits reversed
+  /// if the table may grow, @a index otherwise.
+  size_t position_i (size_t index) const;
+
+  /// Sentinel of the bucket at @a position in the order of the
+  /// iterators, or 0 if there is none.  There are <total_size_>
+  /// positions; while the table grows, a bucket of <old_table_> takes
+  /// the positions of the two buckets its entries move to.
+  ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket_at_i (size_t position) const;
+
+  /// Sets @a position and @a size to what an iterator keeps track of
+  /// to get back to the bucket whose sentinel is @a bucket: its
+  /// position in a table of @a size buckets, which stays valid when
+  /// the table grows.
+  void iterator_position_i (const ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket,
+                            ssize_t &position,
+                            size_t &size) const;
+
+  /// Position an iterator goes on from forward once it got to the
+  /// sentinel @a bucket, from the bucket at @a position of a table of
+  /// @a size buckets.  This is the position after @a bucket, unless
+  /// entries of that bucket may have moved to buckets before
+  /// @a bucket meanwhile: the iterator then goes back to the first of
+  /// them.
+  ssize_t next_position_i (const ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket,
+                           ssize_t position,
+                           size_t size) const;
+
+  /// Same as next_position_i(), backward.
+  ssize_t prev_position_i (const ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket,
+                           ssize_t position,
+                           size_t size) const;
+
+  /// Index of the bucket of @a ext_id.
+  size_t bucket_of_i (const EXT_ID &ext_id);
+
+  /// Called after each new entry: moves the entries of the next
+  /// buckets of <old_table_>, or starts growing the table if it holds
+  /// too many entries.  Must be called with locks held.
+  void grow_i (void);
+
+  /// Moves the entries of the next bucket of <old_table_> to
+  /// <table_>.  Must be called with locks held.
+  void rehash_bucket_i (void);
+
 private:
   /**
    * Array of ACE_Hash_Map_Entry *s, each of which points to an
@@ -575,6 +665,18 @@ private:
   /// bucket chaining).
   size_t cur_size_;
 
+  /// While the table grows, the previous table, whose entries are
+  /// being moved to <table_>, and its size; 0 otherwise.
+  ACE_Hash_Map_Entry<EXT_ID, INT_ID> *old_table_;
+  size_t old_size_;
+
+  /// Number of buckets of <old_table_> whose entries were moved.
+  size_t rehash_index_;
+
+  /// Number of entries per bucket above which the table grows, 0 if
+  /// it doesn't.
+  size_t max_load_;
+
   // = Disallow these operations.
   ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID,  HASH_KEY, COMPARE_KEYS, ACE_LOCK> &))
   ACE_UNIMPLEMENTED_FUNC (ACE_Hash_Map_Manager_Ex (const ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID,  HASH_KEY, COMPARE_KEYS, ACE_LOCK> &))
@@ -671,8 +773,10 @@ protected:
   /// Map we are iterating over.
   ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> *map_man_;
 
-  /// Keeps track of how far we've advanced in the table.
+  /// Keeps track of how far we've advanced in the table: the position
+  /// of the current bucket, in a table of <size_> buckets.
   ssize_t index_;
+  size_t size_;
 
   /// Keeps track of how far we've advanced in a linked list in each
   /// table slot.
@@ -748,8 +852,10 @@ protected:
   /// Map we are iterating over.
   const ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK> *map_man_;
 
-  /// Keeps track of how far we've advanced in the table.
+  /// Keeps track of how far we've advanced in the table: the position
+  /// of the current bucket, in a table of <size_> buckets.
   ssize_t index_;
+  size_t size_;
 
   /// Keeps track of how far we've advanced in a linked list in each
   /// table slot.
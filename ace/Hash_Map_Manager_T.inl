@@ -14,7 +14,11 @@ ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::ACE_H
     entry_allocator_ (entry_alloc),
     table_ (0),
     total_size_ (0),
-    cur_size_ (0)
+    cur_size_ (0),
+    old_table_ (0),
+    old_size_ (0),
+    rehash_index_ (0),
+    max_load_ (0)
 {
   if (this->open (size, table_alloc, entry_alloc) == -1)
     ACELIB_ERROR ((LM_ERROR, ACE_TEXT ("ACE_Hash_Map_Manager_Ex\n")));
@@ -27,7 +31,11 @@ ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::ACE_H
     entry_allocator_ (entry_alloc),
     table_ (0),
     total_size_ (0),
-    cur_size_ (0)
+    cur_size_ (0),
+    old_table_ (0),
+    old_size_ (0),
+    rehash_index_ (0),
+    max_load_ (0)
 {
   if (this->open (ACE_DEFAULT_MAP_SIZE, table_alloc, entry_alloc) == -1)
     ACELIB_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"),
@@ -68,6 +76,12 @@ ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::total
   return this->total_size_;
 }
 
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE size_t
+ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::max_load (void) const
+{
+  return this->max_load_;
+}
+
 template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ACE_LOCK &
 ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::mutex (void)
 {
@@ -436,6 +450,144 @@ ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::table
   return this->table_;
 }
 
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_Hash_Map_Entry<EXT_ID, INT_ID> *
+ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::bucket_address_i (size_t index) const
+{
+  if (index < this->old_size_)
+    return &this->old_table_[index];
+  return &this->table_[index - this->old_size_];
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ssize_t
+ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::bucket_index_i (const ACE_Hash_Map_Entry<EXT_ID, INT_ID> *entry) const
+{
+  if (entry >= this->table_ && entry < this->table_ + this->total_size_)
+    return static_cast<ssize_t> (this->old_size_ + (entry - this->table_));
+  else if (this->old_table_ != 0
+           && entry >= this->old_table_
+           && entry < this->old_table_ + this->old_size_)
+    return static_cast<ssize_t> (entry - this->old_table_);
+  else
+    return -1;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE size_t
+ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::position_i (size_t index) const
+{
+  // When the table doubles, the entries of the bucket at position p
+  // move to the buckets at positions 2p and 2p + 1, and the order of
+  // the entries relative to each other stays the same.
+  if (this->max_load_ == 0 && this->old_table_ == 0)
+    return index;
+
+  size_t position = 0;
+  for (size_t bit = this->total_size_ >> 1; bit != 0; bit >>= 1)
+    {
+      position = (position << 1) | (index & 1);
+      index >>= 1;
+    }
+  return position;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
+ACE_Hash_Map_Entry<EXT_ID, INT_ID> *
+ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::bucket_at_i (size_t position) const
+{
+  size_t const index = this->position_i (position);
+
+  // While the table grows, the buckets of <old_table_> are destroyed
+  // when their entries are moved, and those of <table_> initialized.
+  if (this->old_table_ != 0)
+    {
+      size_t const old_index = index & (this->old_size_ - 1);
+      if (old_index >= this->rehash_index_)
+        return index == old_index ? &this->old_table_[old_index] : 0;
+    }
+
+  return &this->table_[index];
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE void
+ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::iterator_position_i (const ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket,
+                                                                                                ssize_t &position,
+                                                                                                size_t &size) const
+{
+  size_t const index = static_cast<size_t> (this->bucket_index_i (bucket));
+
+  // A bucket of <old_table_> is at an even position, whose half is
+  // its position in <old_table_>.
+  if (index < this->old_size_)
+    {
+      position = static_cast<ssize_t> (this->position_i (index) >> 1);
+      size = this->old_size_;
+    }
+  else
+    {
+      position = static_cast<ssize_t> (this->position_i (index - this->old_size_));
+      size = this->total_size_;
+    }
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ssize_t
+ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::next_position_i (const ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket,
+                                                                                            ssize_t position,
+                                                                                            size_t size) const
+{
+  ssize_t first = 0;
+  size_t first_size = 0;
+  this->iterator_position_i (bucket, first, first_size);
+
+  // The bucket the iterator was on now takes the positions from
+  // <start> to <start> + <total_size_> / <size> - 1: its entries are
+  // in the buckets there, in the same order.  Those after the
+  // iterator are all ahead, unless <bucket> isn't the first of these
+  // buckets.
+  size_t const start = static_cast<size_t> (position) * (this->total_size_ / size);
+  first *= static_cast<ssize_t> (this->total_size_ / first_size);
+  if (static_cast<size_t> (first) != start)
+    return static_cast<ssize_t> (start);
+  return first + static_cast<ssize_t> (this->total_size_ / first_size);
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE ssize_t
+ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::prev_position_i (const ACE_Hash_Map_Entry<EXT_ID, INT_ID> *bucket,
+                                                                                            ssize_t position,
+                                                                                            size_t size) const
+{
+  ssize_t last = 0;
+  size_t last_size = 0;
+  this->iterator_position_i (bucket, last, last_size);
+
+  // See next_position_i().
+  size_t const end = static_cast<size_t> (position + 1) * (this->total_size_ / size);
+  last = (last + 1) * static_cast<ssize_t> (this->total_size_ / last_size);
+  if (static_cast<size_t> (last) != end)
+    return static_cast<ssize_t> (end) - 1;
+  return last - static_cast<ssize_t> (this->total_size_ / last_size) - 1;
+}
+
+template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE size_t
+ACE_Hash_Map_Manager_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::bucket_of_i (const EXT_ID &ext_id)
+{
+  u_long const hash = this->hash (ext_id);
+
+  if (this->old_table_ != 0)
+    {
+      // The entries of the buckets of <old_table_> below
+      // <rehash_index_> were moved to <table_>.
+      size_t const index = hash & (this->old_size_ - 1);
+      if (index >= this->rehash_index_)
+        return index;
+      return this->old_size_ + (hash & (this->total_size_ - 1));
+    }
+
+  // Use a mask rather than a division when the size allows it.
+  if ((this->total_size_ & (this->total_size_ - 1)) == 0)
+    return hash & (this->total_size_ - 1);
+  return hash % this->total_size_;
+}
+
 template <class EXT_ID,
           class INT_ID,
           class HASH_KEY,
@@ -490,10 +642,11 @@ ACE_Hash_Map_Iterator_Base_Ex<EXT_ID,
   bool head)
   : map_man_ (&mm),
     index_ (head ? -1 : (ssize_t) mm.total_size_),
+    size_ (mm.total_size_),
     next_ (0)
 {
   if (mm.table_ != 0)
-    this->next_ = &mm.table_[head ? 0 : mm.total_size_ - 1];
+    this->next_ = mm.table_;
 }
 
 template <class EXT_ID,
@@ -515,9 +668,13 @@ ACE_Hash_Map_Iterator_Base_Ex<EXT_ID,
   ACE_Hash_Map_Entry<EXT_ID, INT_ID> * entry,
   size_t index)
   : map_man_ (&mm)
-  , index_ (static_cast<ssize_t> (index))
+  , index_ (0)
+  , size_ (0)
   , next_ (entry)
 {
+  mm.iterator_position_i (mm.bucket_address_i (index),
+                          this->index_,
+                          this->size_);
 }
 
 template <class EXT_ID,
@@ -526,10 +683,11 @@ ACE_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>:
 {
   ACE_TRACE ("ACE_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::next");
 
+  // The iterator is on an entry unless it is on the sentinel of a
+  // bucket, before the first entry or after the last one.
   if (this->map_man_->table_ != 0
-      && this->index_ < static_cast<ssize_t> (this->map_man_->total_size_)
       && this->index_ >= 0
-      && this->next_ != &this->map_man_->table_[this->index_])
+      && this->map_man_->bucket_index_i (this->next_) == -1)
     {
       entry = this->next_;
       return 1;
@@ -544,8 +702,8 @@ ACE_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>:
   ACE_TRACE ("ACE_Hash_Map_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::done");
 
   return this->map_man_->table_ == 0
-    || this->index_ >= static_cast<ssize_t> (this->map_man_->total_size_)
-    || this->index_ < 0;
+    || this->index_ < 0
+    || this->map_man_->bucket_index_i (this->next_) != -1;
 }
 
 template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
@@ -611,12 +769,13 @@ ACE_Hash_Map_Const_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_
                                                                                                                             bool head)
   : map_man_ (&mm),
     index_ (head ? -1 : (ssize_t) mm.total_size_),
+    size_ (mm.total_size_),
     next_ (0)
 {
   ACE_TRACE ("ACE_Hash_Map_Const_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::ACE_Hash_Map_Const_Iterator_Base_Ex");
 
   if (mm.table_ != 0)
-    this->next_ = &mm.table_[head ? 0 : mm.total_size_ - 1];
+    this->next_ = mm.table_;
 }
 
 template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE int
@@ -624,10 +783,11 @@ ACE_Hash_Map_Const_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_
 {
   ACE_TRACE ("ACE_Hash_Map_Const_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::next");
 
+  // The iterator is on an entry unless it is on the sentinel of a
+  // bucket, before the first entry or after the last one.
   if (this->map_man_->table_ != 0
-      && this->index_ < (ssize_t) this->map_man_->total_size_
       && this->index_ >= 0
-      && this->next_ != &this->map_man_->table_[this->index_])
+      && this->map_man_->bucket_index_i (this->next_) == -1)
     {
       entry = this->next_;
       return 1;
@@ -642,8 +802,8 @@ ACE_Hash_Map_Const_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_
   ACE_TRACE ("ACE_Hash_Map_Const_Iterator_Base_Ex<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::done");
 
   return this->map_man_->table_ == 0
-    || this->index_ >= (ssize_t) this->map_man_->total_size_
-    || this->index_ < 0;
+    || this->index_ < 0
+    || this->map_man_->bucket_index_i (this->next_) != -1;
 }
 
 template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
@@ -884,8 +1044,8 @@ ACE_Hash_Map_Bucket_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::
 {
   ACE_TRACE ("ACE_Hash_Map_Bucket_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::ACE_Hash_Map_Bucket_Iterator");
 
-  this->index_ = this->map_man_->hash (ext_id) % this->map_man_->total_size_;
-  this->next_ = &this->map_man_->table_[this->index_];
+  this->index_ = this->map_man_->bucket_of_i (ext_id);
+  this->next_ = this->map_man_->bucket_address_i (this->index_);
 
   if (tail == 0)
     this->forward_i ();
@@ -939,7 +1099,13 @@ ACE_Hash_Map_Bucket_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::
   ACE_TRACE ("ACE_Hash_Map_Bucket_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::forward_i");
 
   this->next_ = this->next_->next_;
-  return this->next_ != &this->map_man_->table_[this->index_];
+
+  // The entries may have moved to another bucket since the iterator
+  // got there: stop at the end of any bucket.
+  if (this->map_man_->bucket_index_i (this->next_) == -1)
+    return 1;
+  this->next_ = this->map_man_->bucket_address_i (this->index_);
+  return 0;
 }
 
 template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> int
@@ -948,7 +1114,12 @@ ACE_Hash_Map_Bucket_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::
   ACE_TRACE ("ACE_Hash_Map_Bucket_Iterator<EXT_ID, INT_ID, HASH_KEY, COMPARE_KEYS, ACE_LOCK>::reverse_i");
 
   this->next_ = this->next_->prev_;
-  return this->next_ != &this->map_man_->table_[this->index_];
+
+  // See forward_i().
+  if (this->map_man_->bucket_index_i (this->next_) == -1)
+    return 1;
+  this->next_ = this->map_man_->bucket_address_i (this->index_);
+  return 0;
 }
 
 template <class EXT_ID, class INT_ID, class HASH_KEY, class COMPARE_KEYS, class ACE_LOCK> ACE_INLINE
@@ -83,7 +83,7 @@ ACE_Intrusive_Auto_Ptr<X>::operator = (const ACE_Intrusive_Auto_Ptr<X> &rhs)
   // assign a zero
   if (rhs.rep_  == 0)
     {
-      X::intrusive_remove_ref (rhs.rep_);
+      X::intrusive_remove_ref (this->rep_);
       this->rep_ = 0;
       return;
     }
@@ -102,7 +102,8 @@ ACE_Intrusive_Auto_Ptr<X>::ACE_Intrusive_Auto_Ptr (const ACE_Intrusive_Auto_Ptr<
   // note implicit cast from U* to T* so illegal copy will generate a
   // compiler warning here
   this->rep_ = rhs.operator-> ();
-  X::intrusive_add_ref(this->rep_);
+  if (this->rep_ != 0)
+    X::intrusive_add_ref(this->rep_);
 }
 
   /// Equality operator that returns @c true if both
@@ -0,0 +1,590 @@
+// $Id$
+
+#ifndef ACE_LOCKLESS_MESSAGE_QUEUE_T_CPP
+#define ACE_LOCKLESS_MESSAGE_QUEUE_T_CPP
+
+#include "ace/Lockless_Message_Queue_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_THREADS) \
+    && defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1)
+
+#include "ace/Log_Category.h"
+#include "ace/Notification_Strategy.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Lockless_Message_Queue)
+
+template <ACE_SYNCH_DECL, class TIME_POLICY>
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::ACE_Lockless_Message_Queue (
+  size_t size,
+  ACE_Notification_Strategy *ns)
+  : inherited (ACE_Message_Queue_Base::DEFAULT_HWM,
+               ACE_Message_Queue_Base::DEFAULT_LWM,
+               ns),
+    cells_ (0),
+    mask_ (0),
+    enqueue_pos_ (0),
+    dequeue_pos_ (0),
+    consumers_waiting_ (0),
+    producers_waiting_ (0)
+{
+  ACE_TRACE ("ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::ACE_Lockless_Message_Queue");
+
+  size_t cells = 2;
+  while (cells < size)
+    cells *= 2;
+
+  ACE_NEW_NORETURN (this->cells_, Cell[cells]);
+  if (this->cells_ == 0)
+    {
+      ACELIB_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")));
+
+      // Fail every call rather than use a ring that isn't there.
+      this->state_ = ACE_Message_Queue_Base::DEACTIVATED;
+      return;
+    }
+
+  this->mask_ = cells - 1;
+  for (size_t i = 0; i < cells; ++i)
+    {
+      this->cells_[i].sequence_ = i;
+      this->cells_[i].item_ = 0;
+    }
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY>
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::~ACE_Lockless_Message_Queue (void)
+{
+  ACE_TRACE ("ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::~ACE_Lockless_Message_Queue");
+
+  if (this->cells_ != 0)
+    {
+      (void) this->close ();
+      delete [] this->cells_;
+    }
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::open (size_t hwm,
+                                                              size_t lwm,
+                                                              ACE_Notification_Strategy *ns)
+{
+  ACE_TRACE ("ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::open");
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_, -1);
+
+  this->high_water_mark_ = hwm;
+  this->low_water_mark_ = lwm;
+  this->notification_strategy_ = ns;
+  if (this->cells_ != 0)
+    this->state_ = ACE_Message_Queue_Base::ACTIVATED;
+  return 0;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::size (void) const
+{
+  return this->cells_ == 0 ? 0 : this->mask_ + 1;
+}
+
+// Put <new_item> in the next free cell.  The producers compete for
+// <enqueue_pos_>; the one which moves it past a cell owns it until
+// it publishes the new sequence of the cell.
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::push_i (ACE_Message_Block *new_item,
+                                                                size_t &pos)
+{
+  Cell *cell = 0;
+  pos = this->enqueue_pos_;
+
+  for (;;)
+    {
+      cell = &this->cells_[pos & this->mask_];
+      size_t const sequence = cell->sequence_;
+      __sync_synchronize ();
+
+      ssize_t const diff = static_cast<ssize_t> (sequence - pos);
+      if (diff == 0)
+        {
+          if (__sync_bool_compare_and_swap (&this->enqueue_pos_,
+                                            pos,
+                                            pos + 1))
+            break;
+        }
+      else if (diff < 0)
+        return false;
+
+      pos = this->enqueue_pos_;
+    }
+
+  cell->item_ = new_item;
+  __sync_synchronize ();
+  cell->sequence_ = pos + 1;
+
+  // Pairs with the barrier in wait_pop_i(): either that thread sees
+  // the message, or this one sees it waiting.
+  __sync_synchronize ();
+  return true;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::pop_i (ACE_Message_Block *&item)
+{
+  Cell *cell = 0;
+  size_t pos = this->dequeue_pos_;
+
+  for (;;)
+    {
+      cell = &this->cells_[pos & this->mask_];
+      size_t const sequence = cell->sequence_;
+      __sync_synchronize ();
+
+      ssize_t const diff = static_cast<ssize_t> (sequence - (pos + 1));
+      if (diff == 0)
+        {
+          if (__sync_bool_compare_and_swap (&this->dequeue_pos_,
+                                            pos,
+                                            pos + 1))
+            break;
+        }
+      else if (diff < 0)
+        return false;
+
+      pos = this->dequeue_pos_;
+    }
+
+  item = cell->item_;
+  __sync_synchronize ();
+
+  // The cell is free for the producer going around the ring next.
+  cell->sequence_ = pos + this->mask_ + 1;
+
+  // Pairs with the barrier in wait_push_i().
+  __sync_synchronize ();
+  return true;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::wait_push_i (ACE_Message_Block *new_item,
+                                                                     ACE_Time_Value *timeout)
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_, -1);
+
+  ++this->producers_waiting_;
+  __sync_synchronize ();
+
+  int result = 0;
+  size_t pos = 0;
+
+  // Consumers that free a cell after the check below see this thread
+  // waiting, and can't signal it before it waits since they need the
+  // lock.  The state is checked under the lock before every wait as
+  // well, since the caller checked it without the lock and a
+  // deactivate() or pulse() in between has already broadcast.
+  while (!this->push_i (new_item, pos))
+    {
+      if (this->state_ != ACE_Message_Queue_Base::ACTIVATED)
+        {
+          errno = ESHUTDOWN;
+          result = -1;
+          break;
+        }
+      if (this->not_full_cond_.wait (timeout) == -1)
+        {
+          if (errno == ETIME)
+            errno = EWOULDBLOCK;
+          result = -1;
+          break;
+        }
+    }
+
+  --this->producers_waiting_;
+  return result;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::wait_pop_i (ACE_Message_Block *&item,
+                                                                    ACE_Time_Value *timeout)
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_, -1);
+
+  ++this->consumers_waiting_;
+  __sync_synchronize ();
+
+  int result = 0;
+
+  // See wait_push_i().
+  while (!this->pop_i (item))
+    {
+      if (this->state_ != ACE_Message_Queue_Base::ACTIVATED)
+        {
+          errno = ESHUTDOWN;
+          result = -1;
+          break;
+        }
+      if (this->not_empty_cond_.wait (timeout) == -1)
+        {
+          if (errno == ETIME)
+            errno = EWOULDBLOCK;
+          result = -1;
+          break;
+        }
+    }
+
+  --this->consumers_waiting_;
+  return result;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::signal_consumer_i (size_t messages)
+{
+  if (this->consumers_waiting_ == 0)
+    return;
+
+  ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_);
+  if (this->consumers_waiting_ == 0)
+    return;
+
+  if (messages > 1)
+    this->not_empty_cond_.broadcast ();
+  else
+    this->not_empty_cond_.signal ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::signal_producer_i (size_t messages)
+{
+  if (this->producers_waiting_ == 0)
+    return;
+
+  ACE_GUARD (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_);
+  if (this->producers_waiting_ == 0)
+    return;
+
+  if (messages > 1)
+    this->not_full_cond_.broadcast ();
+  else
+    this->not_full_cond_.signal ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::count_i (void) const
+{
+  size_t const dequeue_pos = this->dequeue_pos_;
+  size_t const enqueue_pos = this->enqueue_pos_;
+  ssize_t const count = static_cast<ssize_t> (enqueue_pos - dequeue_pos);
+  return count < 0 ? 0 : static_cast<int> (count);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_tail (ACE_Message_Block *new_item,
+                                                                      ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_tail");
+
+  if (this->state_ == ACE_Message_Queue_Base::DEACTIVATED
+      || this->cells_ == 0)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  size_t pos = 0;
+  if (!this->push_i (new_item, pos)
+      && this->wait_push_i (new_item, timeout) == -1)
+    return -1;
+
+  this->signal_consumer_i ();
+
+  if (this->notification_strategy_ != 0)
+    this->notification_strategy_->notify ();
+
+  int const count = this->count_i ();
+  return count == 0 ? 1 : count;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue (ACE_Message_Block *new_item,
+                                                                 ACE_Time_Value *timeout)
+{
+  return this->enqueue_tail (new_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_prio (ACE_Message_Block *new_item,
+                                                                      ACE_Time_Value *timeout)
+{
+  return this->enqueue_tail (new_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_deadline (ACE_Message_Block *new_item,
+                                                                          ACE_Time_Value *timeout)
+{
+  return this->enqueue_tail (new_item, timeout);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_head (ACE_Message_Block *,
+                                                                      ACE_Time_Value *)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head (ACE_Message_Block *&first_item,
+                                                                      ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head");
+
+  if (this->state_ == ACE_Message_Queue_Base::DEACTIVATED
+      || this->cells_ == 0)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  if (!this->pop_i (first_item)
+      && this->wait_pop_i (first_item, timeout) == -1)
+    return -1;
+
+  this->signal_producer_i ();
+  return this->count_i ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue (ACE_Message_Block *&first_item,
+                                                                 ACE_Time_Value *timeout)
+{
+  return this->dequeue_head (first_item, timeout);
+}
+
+// Consumers waiting when the ring fills up are woken up before this
+// thread waits for room, or neither could ever make progress.
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_batch (ACE_Message_Block *new_items[],
+                                                                       size_t count,
+                                                                       ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_batch");
+
+  if (this->state_ == ACE_Message_Queue_Base::DEACTIVATED
+      || this->cells_ == 0)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  size_t enqueued = 0;
+  size_t unsignaled = 0;
+  for (; enqueued < count; ++enqueued)
+    {
+      size_t pos = 0;
+      if (this->push_i (new_items[enqueued], pos))
+        {
+          ++unsignaled;
+          continue;
+        }
+
+      if (unsignaled != 0)
+        {
+          this->signal_consumer_i (unsignaled);
+          unsignaled = 0;
+        }
+      if (this->wait_push_i (new_items[enqueued], timeout) == -1)
+        break;
+      ++unsignaled;
+    }
+
+  if (unsignaled != 0)
+    this->signal_consumer_i (unsignaled);
+
+  if (enqueued == 0)
+    return count == 0 ? 0 : -1;
+
+  if (this->notification_strategy_ != 0)
+    this->notification_strategy_->notify ();
+
+  return static_cast<int> (enqueued);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_batch (ACE_Message_Block *first_items[],
+                                                                       size_t count,
+                                                                       ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_batch");
+
+  if (count == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  if (this->state_ == ACE_Message_Queue_Base::DEACTIVATED
+      || this->cells_ == 0)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  if (!this->pop_i (first_items[0])
+      && this->wait_pop_i (first_items[0], timeout) == -1)
+    return -1;
+
+  size_t dequeued = 1;
+  while (dequeued < count && this->pop_i (first_items[dequeued]))
+    ++dequeued;
+
+  this->signal_producer_i (dequeued);
+  return static_cast<int> (dequeued);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_prio (ACE_Message_Block *&,
+                                                                      ACE_Time_Value *)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_tail (ACE_Message_Block *&,
+                                                                      ACE_Time_Value *)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_deadline (ACE_Message_Block *&,
+                                                                          ACE_Time_Value *)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::peek_dequeue_head (ACE_Message_Block *&,
+                                                                           ACE_Time_Value *)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::is_full_i (void)
+{
+  if (this->cells_ == 0)
+    return true;
+
+  size_t const pos = this->enqueue_pos_;
+  bool const result = this->cells_[pos & this->mask_].sequence_ != pos;
+  __sync_synchronize ();
+  return result;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::is_empty_i (void)
+{
+  if (this->cells_ == 0)
+    return true;
+
+  size_t const pos = this->dequeue_pos_;
+  bool const result = this->cells_[pos & this->mask_].sequence_ != pos + 1;
+  __sync_synchronize ();
+  return result;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::is_full (void)
+{
+  ACE_TRACE ("ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::is_full");
+  return this->is_full_i ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> bool
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::is_empty (void)
+{
+  ACE_TRACE ("ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::is_empty");
+  return this->is_empty_i ();
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::message_count (void)
+{
+  return static_cast<size_t> (this->count_i ());
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::message_bytes (void)
+{
+  return 0;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> size_t
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::message_length (void)
+{
+  return 0;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::message_bytes (size_t)
+{
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::message_length (size_t)
+{
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::flush_i (void)
+{
+  int number_flushed = 0;
+
+  if (this->cells_ == 0)
+    return 0;
+
+  for (ACE_Message_Block *item = 0; this->pop_i (item); )
+    {
+      ++number_flushed;
+      item->release ();
+    }
+
+  if (number_flushed > 0 && this->producers_waiting_ != 0)
+    this->not_full_cond_.broadcast ();
+
+  return number_flushed;
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> void
+ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dump");
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("state = %d\n")
+                 ACE_TEXT ("size = %B\n")
+                 ACE_TEXT ("enqueue_pos_ = %B\n")
+                 ACE_TEXT ("dequeue_pos_ = %B\n")
+                 ACE_TEXT ("consumers_waiting_ = %d\n")
+                 ACE_TEXT ("producers_waiting_ = %d\n"),
+                 this->state_,
+                 this->size (),
+                 this->enqueue_pos_,
+                 this->dequeue_pos_,
+                 this->consumers_waiting_,
+                 this->producers_waiting_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_THREADS && ACE_HAS_GCC_ATOMIC_BUILTINS */
+
+#endif /* ACE_LOCKLESS_MESSAGE_QUEUE_T_CPP */
@@ -0,0 +1,270 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Lockless_Message_Queue_T.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+#ifndef ACE_LOCKLESS_MESSAGE_QUEUE_T_H
+#define ACE_LOCKLESS_MESSAGE_QUEUE_T_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Message_Queue_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_THREADS) \
+    && defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1)
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Lockless_Message_Queue
+ *
+ * @brief A bounded FIFO ACE_Message_Queue which enqueues and
+ * dequeues without taking a lock.
+ *
+ * ACE_Message_Queue takes its lock for every enqueue and dequeue,
+ * so the threads of a worker pool serialize on it.  This queue keeps
+ * the messages in a ring of @a size message block pointers instead,
+ * which any number of threads may enqueue to and dequeue from at the
+ * same time with atomic operations only.  The queue lock and
+ * condition variables are only used by threads which must block,
+ * because the ring is empty (or full), and by the threads which wake
+ * them up.
+ *
+ * It is an ACE_Message_Queue, so it can be given to
+ * ACE_Task::msg_queue(), and the timeouts and activation states work
+ * the same way.  Being a FIFO of fixed size, it differs in that:
+ *
+ * - The ring holds at most @a size messages; enqueueing blocks when
+ *   it is full.  Bytes aren't counted: the water marks are ignored,
+ *   and message_bytes() and message_length() return 0.
+ * - enqueue(), enqueue_prio() and enqueue_deadline() enqueue at the
+ *   tail, ignoring priorities and deadlines.
+ * - enqueue_head(), dequeue_tail(), dequeue_prio(),
+ *   dequeue_deadline() and peek_dequeue_head() fail with @c errno
+ *   ENOTSUP, and the queue iterators see no messages.
+ * - message_count() is exact only while no other thread uses the
+ *   queue.
+ *
+ * The next() and prev() pointers of the messages are left alone.
+ */
+template <ACE_SYNCH_DECL, class TIME_POLICY = ACE_System_Time_Policy>
+class ACE_Lockless_Message_Queue
+  : public ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>
+{
+public:
+  typedef ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY> inherited;
+
+  /// Create a queue holding up to @a size messages, rounded up to a
+  /// power of 2.  @a ns is notified of every message enqueued.
+  ACE_Lockless_Message_Queue (
+    size_t size = ACE_DEFAULT_LOCKLESS_MESSAGE_QUEUE_SIZE,
+    ACE_Notification_Strategy *ns = 0);
+
+  /// Releases the messages still queued.
+  virtual ~ACE_Lockless_Message_Queue (void);
+
+  /// Activate the queue and set its notification strategy to @a ns.
+  /// The water marks are kept but not used.
+  virtual int open (size_t hwm = ACE_Message_Queue_Base::DEFAULT_HWM,
+                    size_t lwm = ACE_Message_Queue_Base::DEFAULT_LWM,
+                    ACE_Notification_Strategy *ns = 0);
+
+  /// Number of messages the ring holds.
+  size_t size (void) const;
+
+  /**
+   * Enqueue @a new_item at the tail of the queue, waiting for room
+   * until the absolute time @a timeout if the ring is full, or for as
+   * long as it takes if @a timeout is 0.
+   *
+   * @retval >0 The approximate number of messages in the queue.
+   * @retval -1 On failure, with @c errno EWOULDBLOCK if the queue
+   *            stayed full until @a timeout, or ESHUTDOWN if the
+   *            queue is (or became) deactivated or pulsed.
+   */
+  virtual int enqueue_tail (ACE_Message_Block *new_item,
+                            ACE_Time_Value *timeout = 0);
+
+  /// Same as enqueue_tail().
+  virtual int enqueue (ACE_Message_Block *new_item,
+                       ACE_Time_Value *timeout = 0);
+
+  /// Same as enqueue_tail(); priorities are not kept.
+  virtual int enqueue_prio (ACE_Message_Block *new_item,
+                            ACE_Time_Value *timeout = 0);
+
+  /// Same as enqueue_tail(); deadlines are not kept.
+  virtual int enqueue_deadline (ACE_Message_Block *new_item,
+                                ACE_Time_Value *timeout = 0);
+
+  /// Not supported; returns -1 with @c errno ENOTSUP.
+  virtual int enqueue_head (ACE_Message_Block *new_item,
+                            ACE_Time_Value *timeout = 0);
+
+  /**
+   * Dequeue the message at the head of the queue into @a first_item,
+   * waiting for one until the absolute time @a timeout if the queue
+   * is empty, or for as long as it takes if @a timeout is 0.
+   *
+   * @retval >=0 The approximate number of messages left in the queue.
+   * @retval -1  On failure, with @c errno EWOULDBLOCK if the queue
+   *             stayed empty until @a timeout, or ESHUTDOWN if the
+   *             queue is (or became) deactivated or pulsed.
+   */
+  virtual int dequeue_head (ACE_Message_Block *&first_item,
+                            ACE_Time_Value *timeout = 0);
+
+  /// Same as dequeue_head().
+  virtual int dequeue (ACE_Message_Block *&first_item,
+                       ACE_Time_Value *timeout = 0);
+
+  /**
+   * Enqueue the @a count messages of @a new_items at the tail of the
+   * queue, in order, waking up the waiting consumers and notifying
+   * the notification strategy once.  Waits for room as enqueue_tail()
+   * does whenever the ring is full.
+   *
+   * @retval >0 The number of messages enqueued, less than @a count if
+   *            the queue stayed full until @a timeout or was
+   *            deactivated part way through.
+   * @retval -1 On failure, with no message enqueued and @c errno set
+   *            as by enqueue_tail().
+   */
+  virtual int enqueue_batch (ACE_Message_Block *new_items[],
+                             size_t count,
+                             ACE_Time_Value *timeout = 0);
+
+  /**
+   * Dequeue up to @a count messages into @a first_items, waiting for
+   * the first one as dequeue_head() does.
+   *
+   * @retval >0 The number of messages dequeued.
+   * @retval -1 On failure, with @c errno set as by dequeue_head().
+   */
+  virtual int dequeue_batch (ACE_Message_Block *first_items[],
+                             size_t count,
+                             ACE_Time_Value *timeout = 0);
+
+  /// Not supported; return -1 with @c errno ENOTSUP.
+  virtual int dequeue_prio (ACE_Message_Block *&dequeued,
+                            ACE_Time_Value *timeout = 0);
+  virtual int dequeue_tail (ACE_Message_Block *&dequeued,
+                            ACE_Time_Value *timeout = 0);
+  virtual int dequeue_deadline (ACE_Message_Block *&dequeued,
+                                ACE_Time_Value *timeout = 0);
+  virtual int peek_dequeue_head (ACE_Message_Block *&first_item,
+                                 ACE_Time_Value *timeout = 0);
+
+  /// True if the ring is full.
+  virtual bool is_full (void);
+
+  /// True if the ring is empty.
+  virtual bool is_empty (void);
+
+  /// Number of messages in the queue.
+  virtual size_t message_count (void);
+
+  /// Bytes aren't counted; these return 0 and ignore the new value.
+  virtual size_t message_bytes (void);
+  virtual size_t message_length (void);
+  virtual void message_bytes (size_t new_size);
+  virtual void message_length (size_t new_length);
+
+  /// Dump the state of an object.
+  virtual void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+protected:
+  /// Releases the messages queued and wakes up the threads waiting
+  /// for room.  Called with the queue lock held by flush() and
+  /// close().
+  virtual int flush_i (void);
+
+  virtual bool is_full_i (void);
+  virtual bool is_empty_i (void);
+
+  /// Put @a new_item in the ring at position @a pos; false if it is
+  /// full.
+  bool push_i (ACE_Message_Block *new_item, size_t &pos);
+
+  /// Take the message at the head of the ring; false if it is empty.
+  bool pop_i (ACE_Message_Block *&item);
+
+  /// Wait until @a new_item could be put in the ring.
+  int wait_push_i (ACE_Message_Block *new_item, ACE_Time_Value *timeout);
+
+  /// Wait until a message could be taken out of the ring.
+  int wait_pop_i (ACE_Message_Block *&item, ACE_Time_Value *timeout);
+
+  /// Wake up a thread waiting for a message, if there is one, or all
+  /// of them if @a messages were enqueued.
+  void signal_consumer_i (size_t messages = 1);
+
+  /// Wake up a thread waiting for room, if there is one, or all of
+  /// them if @a messages were dequeued.
+  void signal_producer_i (size_t messages = 1);
+
+  /// Number of messages in the ring, for the return values.
+  int count_i (void) const;
+
+  /// A slot of the ring.
+  struct Cell
+  {
+    /// Position of the message this cell holds, plus 1, once it is
+    /// stored; position of the next message to be stored in it
+    /// otherwise.
+    volatile size_t sequence_;
+
+    ACE_Message_Block *item_;
+  };
+
+  /// The ring, <mask_> + 1 cells.
+  Cell *cells_;
+  size_t mask_;
+
+  /// Position of the next message enqueued.  Kept on a cache line of
+  /// its own, apart from <dequeue_pos_>, since producers and
+  /// consumers write them concurrently.
+  char pad0_[ACE_LOCKLESS_MESSAGE_QUEUE_CACHE_LINE];
+  volatile size_t enqueue_pos_;
+  char pad1_[ACE_LOCKLESS_MESSAGE_QUEUE_CACHE_LINE - sizeof (size_t)];
+
+  /// Position of the next message dequeued.
+  volatile size_t dequeue_pos_;
+  char pad2_[ACE_LOCKLESS_MESSAGE_QUEUE_CACHE_LINE - sizeof (size_t)];
+
+  /// Number of threads waiting on the queue conditions for a
+  /// message, and for room.  Changed with the queue lock held.
+  volatile int consumers_waiting_;
+  volatile int producers_waiting_;
+
+private:
+  // = Disallow these operations.
+  ACE_UNIMPLEMENTED_FUNC (void operator= (const ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY> &))
+  ACE_UNIMPLEMENTED_FUNC (ACE_Lockless_Message_Queue (const ACE_Lockless_Message_Queue<ACE_SYNCH_USE, TIME_POLICY> &))
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Lockless_Message_Queue_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Lockless_Message_Queue_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#endif /* ACE_HAS_THREADS && ACE_HAS_GCC_ATOMIC_BUILTINS */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_LOCKLESS_MESSAGE_QUEUE_T_H */
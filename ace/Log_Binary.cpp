@@ -0,0 +1,1050 @@
+// $Id$
+
+#include "ace/Log_Binary.h"
+#include "ace/Log_Msg.h"
+#include "ace/Log_Record.h"
+#include "ace/ACE.h"
+#include "ace/CDR_Base.h"
+#include "ace/Time_Value.h"
+#include "ace/Thread.h"
+#include "ace/Trace.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_Memory.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  // The encoding starts with a header of four bytes: the byte order,
+  // the version of the encoding, the size of the characters, and the
+  // prefixes of the message.  The time stamp of the prefix follows,
+  // if any, then the program name, if any, and the format.  The
+  // arguments come next, each with a tag.
+  ACE_Byte const ACE_LOG_BINARY_VERSION = 1;
+
+  // Prefixes of the message.
+  enum
+  {
+    PROGRAM_NAME = 1,
+    TIME_ONLY = 2,
+    DATE_AND_TIME = 4
+  };
+
+  // Tags of the arguments.
+  enum
+  {
+    /// ACE_INT32.
+    ARG_INT = 'i',
+    /// ACE_INT64.
+    ARG_INT64 = 'q',
+    /// ACE_UINT64.
+    ARG_UINT64 = 'Q',
+    /// double.
+    ARG_DOUBLE = 'd',
+    /// ACE_UINT32 number of characters, then the characters.
+    ARG_STRING = 's',
+    /// ACE_INT64 seconds, then ACE_INT32 microseconds.
+    ARG_TIME = 't'
+  };
+
+  // Flags and widths a directive can have before its conversion.
+  const ACE_TCHAR *const flag_chars = ACE_TEXT ("-+0 #123456789.Lh");
+
+  // How strings are printed.
+#if !defined (ACE_WIN32) && defined (ACE_USES_WCHAR)
+  const ACE_TCHAR *const string_conv = ACE_TEXT ("ls");
+#else
+  const ACE_TCHAR *const string_conv = ACE_TEXT ("s");
+#endif /* !ACE_WIN32 && ACE_USES_WCHAR */
+
+  // How wide characters (%w and %z) are printed.
+#if defined (ACE_WIN32)
+# if defined (ACE_USES_WCHAR)
+  const ACE_TCHAR *const wchar_conv = ACE_TEXT ("c");
+# else
+  const ACE_TCHAR *const wchar_conv = ACE_TEXT ("C");
+# endif /* ACE_USES_WCHAR */
+#elif defined (ACE_USES_WCHAR)
+# if defined (HPUX)
+  const ACE_TCHAR *const wchar_conv = ACE_TEXT ("C");
+# else
+  const ACE_TCHAR *const wchar_conv = ACE_TEXT ("lc");
+# endif /* HPUX */
+#else
+  const ACE_TCHAR *const wchar_conv = ACE_TEXT ("u");
+#endif /* ACE_WIN32 */
+
+  // How characters (%c and %.1M) are printed.
+#if defined (ACE_WIN32) && defined (ACE_USES_WCHAR)
+  const ACE_TCHAR *const char_conv = ACE_TEXT ("C");
+#elif defined (ACE_USES_WCHAR) && !defined (ACE_WIN32)
+# if defined (HPUX)
+  const ACE_TCHAR *const char_conv = ACE_TEXT ("C");
+# else
+  const ACE_TCHAR *const char_conv = ACE_TEXT ("lc");
+# endif /* HPUX */
+#else
+  const ACE_TCHAR *const char_conv = ACE_TEXT ("c");
+#endif /* ACE_WIN32 && ACE_USES_WCHAR */
+
+  /**
+   * Writes the encoding.  Once a value doesn't fit, nothing more is
+   * written, so that the values written are all complete; strings
+   * are truncated to fit, though.
+   */
+  class Encoder
+  {
+  public:
+    Encoder (char *data, size_t size)
+      : begin_ (data),
+        pos_ (data),
+        end_ (data + size),
+        full_ (false)
+    {
+    }
+
+    size_t length (void) const
+    {
+      return this->pos_ - this->begin_;
+    }
+
+    void put_header (ACE_Byte prefixes)
+    {
+      if (this->room (4))
+        {
+          *this->pos_++ = static_cast<char> (ACE_CDR_BYTE_ORDER);
+          *this->pos_++ = static_cast<char> (ACE_LOG_BINARY_VERSION);
+          *this->pos_++ = static_cast<char> (sizeof (ACE_TCHAR));
+          *this->pos_++ = static_cast<char> (prefixes);
+        }
+    }
+
+    void put_int (ACE_INT32 value)
+    {
+      this->put (ARG_INT, value);
+    }
+
+    void put_int64 (ACE_INT64 value)
+    {
+      this->put (ARG_INT64, value);
+    }
+
+    void put_uint64 (ACE_UINT64 value)
+    {
+      this->put (ARG_UINT64, value);
+    }
+
+    void put_double (double value)
+    {
+      this->put (ARG_DOUBLE, value);
+    }
+
+    void put_time (const ACE_Time_Value &tv, bool tagged = true)
+    {
+      ACE_INT64 const sec = static_cast<ACE_INT64> (tv.sec ());
+      ACE_INT32 const usec = static_cast<ACE_INT32> (tv.usec ());
+      if (this->room (tagged + sizeof sec + sizeof usec))
+        {
+          if (tagged)
+            *this->pos_++ = ARG_TIME;
+          this->copy (&sec, sizeof sec);
+          this->copy (&usec, sizeof usec);
+        }
+    }
+
+    void put_string (const ACE_TCHAR *s, bool tagged = true)
+    {
+      ACE_UINT32 len = static_cast<ACE_UINT32> (ACE_OS::strlen (s));
+      if (!this->room (tagged + sizeof len))
+        return;
+
+      size_t const max =
+        (this->end_ - this->pos_ - tagged - sizeof len) / sizeof (ACE_TCHAR);
+      if (len > max)
+        {
+          len = static_cast<ACE_UINT32> (max);
+          this->full_ = true;
+        }
+
+      if (tagged)
+        *this->pos_++ = ARG_STRING;
+      this->copy (&len, sizeof len);
+      this->copy (s, len * sizeof (ACE_TCHAR));
+    }
+
+    /// Strings of other characters are converted one by one.
+    template <typename CHAR>
+    void put_chars (const CHAR *s)
+    {
+      const CHAR *end = s;
+      while (*end != 0)
+        ++end;
+
+      ACE_UINT32 len = static_cast<ACE_UINT32> (end - s);
+      if (!this->room (1 + sizeof len))
+        return;
+
+      size_t const max =
+        (this->end_ - this->pos_ - 1 - sizeof len) / sizeof (ACE_TCHAR);
+      if (len > max)
+        {
+          len = static_cast<ACE_UINT32> (max);
+          this->full_ = true;
+        }
+
+      *this->pos_++ = ARG_STRING;
+      this->copy (&len, sizeof len);
+      for (ACE_UINT32 i = 0; i < len; ++i)
+        {
+          ACE_TCHAR const c = static_cast<ACE_TCHAR> (s[i]);
+          this->copy (&c, sizeof c);
+        }
+    }
+
+  private:
+    bool room (size_t n)
+    {
+      if (!this->full_ && static_cast<size_t> (this->end_ - this->pos_) >= n)
+        return true;
+
+      this->full_ = true;
+      return false;
+    }
+
+    void copy (const void *p, size_t n)
+    {
+      ACE_OS::memcpy (this->pos_, p, n);
+      this->pos_ += n;
+    }
+
+    template <typename T>
+    void put (char tag, T value)
+    {
+      if (this->room (1 + sizeof value))
+        {
+          *this->pos_++ = tag;
+          this->copy (&value, sizeof value);
+        }
+    }
+
+    char *begin_;
+    char *pos_;
+    char *end_;
+    bool full_;
+  };
+
+  /**
+   * Reads the encoding.  The get methods return false once the
+   * values run out, or if the value isn't of the type expected.
+   */
+  class Decoder
+  {
+  public:
+    Decoder (const char *data, size_t len)
+      : pos_ (data),
+        end_ (data + len),
+        swap_ (false),
+        char_size_ (0)
+    {
+    }
+
+    /// Whether all the values were read.
+    bool done (void) const
+    {
+      return this->pos_ == this->end_;
+    }
+
+    bool get_header (ACE_Byte &prefixes)
+    {
+      if (this->end_ - this->pos_ < 4
+          || static_cast<ACE_Byte> (this->pos_[1]) != ACE_LOG_BINARY_VERSION)
+        return false;
+
+      this->swap_ = this->pos_[0] != static_cast<char> (ACE_CDR_BYTE_ORDER);
+      this->char_size_ = static_cast<ACE_Byte> (this->pos_[2]);
+      prefixes = static_cast<ACE_Byte> (this->pos_[3]);
+      this->pos_ += 4;
+
+      return this->char_size_ == 1
+        || this->char_size_ == 2
+        || this->char_size_ == 4;
+    }
+
+    bool get_int (ACE_INT32 &value)
+    {
+      return this->tag (ARG_INT) && this->get (value);
+    }
+
+    bool get_int64 (ACE_INT64 &value)
+    {
+      return this->tag (ARG_INT64) && this->get (value);
+    }
+
+    bool get_uint64 (ACE_UINT64 &value)
+    {
+      return this->tag (ARG_UINT64) && this->get (value);
+    }
+
+    bool get_double (double &value)
+    {
+      return this->tag (ARG_DOUBLE) && this->get (value);
+    }
+
+    bool get_time (ACE_Time_Value &tv, bool tagged = true)
+    {
+      ACE_INT64 sec = 0;
+      ACE_INT32 usec = 0;
+      if ((tagged && !this->tag (ARG_TIME))
+          || !this->get (sec)
+          || !this->get (usec))
+        return false;
+
+      tv.set (static_cast<time_t> (sec), usec);
+      return true;
+    }
+
+    /// Reads a string in @a s, of @a size characters, truncating it
+    /// if needed.
+    bool get_string (ACE_TCHAR *s, size_t size, bool tagged = true)
+    {
+      ACE_UINT32 len = 0;
+      if ((tagged && !this->tag (ARG_STRING))
+          || !this->get (len)
+          || static_cast<size_t> (this->end_ - this->pos_)
+               < static_cast<size_t> (len) * this->char_size_)
+        return false;
+
+      size_t const n = len < size ? len : size - 1;
+
+      if (this->char_size_ == sizeof (ACE_TCHAR) && !this->swap_)
+        ACE_OS::memcpy (s, this->pos_, n * sizeof (ACE_TCHAR));
+      else
+        for (size_t i = 0; i < n; ++i)
+          {
+            const char *unit = this->pos_ + i * this->char_size_;
+            ACE_UINT32 c = 0;
+            if (this->char_size_ == 1)
+              c = static_cast<ACE_Byte> (*unit);
+            else if (this->char_size_ == 2)
+              {
+                ACE_UINT16 c16;
+                this->read (unit, c16);
+                c = c16;
+              }
+            else
+              this->read (unit, c);
+            s[i] = static_cast<ACE_TCHAR> (c);
+          }
+
+      s[n] = '\0';
+      this->pos_ += static_cast<size_t> (len) * this->char_size_;
+      return true;
+    }
+
+  private:
+    bool tag (char t)
+    {
+      if (this->pos_ == this->end_ || *this->pos_ != t)
+        return false;
+
+      ++this->pos_;
+      return true;
+    }
+
+    template <typename T>
+    bool get (T &value)
+    {
+      if (static_cast<size_t> (this->end_ - this->pos_) < sizeof value)
+        return false;
+
+      this->read (this->pos_, value);
+      this->pos_ += sizeof value;
+      return true;
+    }
+
+    /// The encoding isn't aligned, and ACE_CDR::swap_N() wants aligned
+    /// values: the value is copied first, then swapped in place.
+    template <typename T>
+    void read (const char *p, T &value)
+    {
+      T raw;
+      ACE_OS::memcpy (&raw, p, sizeof raw);
+      char const *src = reinterpret_cast<char const *> (&raw);
+      char *dst = reinterpret_cast<char *> (&value);
+      if (!this->swap_)
+        value = raw;
+      else if (sizeof value == 2)
+        ACE_CDR::swap_2 (src, dst);
+      else if (sizeof value == 4)
+        ACE_CDR::swap_4 (src, dst);
+      else
+        ACE_CDR::swap_8 (src, dst);
+    }
+
+    const char *pos_;
+    const char *end_;
+    bool swap_;
+    ACE_Byte char_size_;
+  };
+
+  /// Writes the text, as much as fits.
+  class Output
+  {
+  public:
+    Output (ACE_TCHAR *msg, size_t size)
+      : bp_ (msg),
+        bspace_ (size - 1)
+    {
+      *this->bp_ = '\0';
+    }
+
+    bool room (void) const
+    {
+      return this->bspace_ > 0;
+    }
+
+    void put (ACE_TCHAR c)
+    {
+      if (this->bspace_ > 0)
+        {
+          *this->bp_++ = c;
+          *this->bp_ = '\0';
+          --this->bspace_;
+        }
+    }
+
+    void append (const ACE_TCHAR *s)
+    {
+      while (*s != '\0' && this->bspace_ > 0)
+        this->put (*s++);
+    }
+
+    template <typename T>
+    void print (const ACE_TCHAR *spec, T value)
+    {
+      ACE_OS::snprintf (this->bp_, this->bspace_ + 1, spec, value);
+      this->advance ();
+    }
+
+    void print (const ACE_TCHAR *spec, const ACE_TCHAR *s1, const ACE_TCHAR *s2)
+    {
+      ACE_OS::snprintf (this->bp_, this->bspace_ + 1, spec, s1, s2);
+      this->advance ();
+    }
+
+  private:
+    void advance (void)
+    {
+      // snprintf() returns what it would have written on some
+      // platforms, and -1 on others, when it truncates.
+      this->bp_[this->bspace_] = '\0';
+      size_t const len = ACE_OS::strlen (this->bp_);
+      this->bp_ += len;
+      this->bspace_ -= len;
+    }
+
+    ACE_TCHAR *bp_;
+    size_t bspace_;
+  };
+
+  ACE_TCHAR
+  priority_char (ACE_Log_Priority p)
+  {
+    switch (p)
+      {
+      case LM_SHUTDOWN: return ACE_TEXT ('S');
+      case LM_TRACE: return ACE_TEXT ('T');
+      case LM_DEBUG: return ACE_TEXT ('D');
+      case LM_INFO: return ACE_TEXT ('I');
+      case LM_NOTICE: return ACE_TEXT ('N');
+      case LM_WARNING: return ACE_TEXT ('W');
+      case LM_STARTUP: return ACE_TEXT ('U');
+      case LM_ERROR: return ACE_TEXT ('E');
+      case LM_CRITICAL: return ACE_TEXT ('C');
+      case LM_ALERT: return ACE_TEXT ('A');
+      case LM_EMERGENCY: return ACE_TEXT ('!');
+      default: return ACE_TEXT ('?');
+      }
+  }
+
+  // Renders the message read by <in>, using <format> and <arg> of
+  // ACE_Log_Record::MAXLOGMSGLEN characters, and <arg2> of as many,
+  // for the strings.  Returns false if a value is missing, or isn't
+  // of the type expected, or, setting <too_long>, if the flags and
+  // widths of a directive don't fit in a spec.
+  bool
+  render_message (Decoder &in,
+                  Output &out,
+                  ACE_Byte prefixes,
+                  ACE_TCHAR *format,
+                  ACE_TCHAR *arg,
+                  ACE_TCHAR *arg2,
+                  bool &too_long)
+  {
+    size_t const size = ACE_Log_Record::MAXLOGMSGLEN;
+    too_long = false;
+
+    ACE_Time_Value stamp;
+    if (ACE_BIT_ENABLED (prefixes, TIME_ONLY | DATE_AND_TIME)
+        && !in.get_time (stamp, false))
+      return false;
+
+    if (ACE_BIT_ENABLED (prefixes, PROGRAM_NAME))
+      {
+        if (!in.get_string (arg, size, false))
+          return false;
+        out.append (arg);
+        out.put ('|');
+      }
+
+    if (ACE_BIT_ENABLED (prefixes, TIME_ONLY | DATE_AND_TIME))
+      {
+        ACE_TCHAR day_and_time[27];
+        const ACE_TCHAR *s =
+          ACE::timestamp (stamp,
+                          day_and_time,
+                          sizeof (day_and_time) / sizeof (ACE_TCHAR),
+                          ACE_BIT_ENABLED (prefixes, TIME_ONLY));
+        if (ACE_BIT_ENABLED (prefixes, DATE_AND_TIME))
+          s = day_and_time;
+        out.append (s != 0 ? s : ACE_TEXT (""));
+        out.put ('|');
+      }
+
+    if (!in.get_string (format, size, false))
+      return false;
+
+    // This walks the format as ACE_Log_Msg::log() does, except that
+    // the values come from the encoding instead of the arguments.
+    const ACE_TCHAR *format_str = format;
+
+    while (*format_str != '\0' && out.room ())
+      {
+        if (*format_str != '%')
+          {
+            out.put (*format_str++);
+            continue;
+          }
+
+        if (format_str[1] == '%')
+          {
+            out.put ('%');
+            format_str += 2;
+            continue;
+          }
+
+        const ACE_TCHAR *start_format = format_str;
+        // The flags and widths go up to <spec_end>, leaving room for
+        // the longest conversion appended below.
+        ACE_TCHAR spec[128];
+        ACE_TCHAR *const spec_end = spec + 100;
+        ACE_TCHAR *fp = spec;
+        *fp++ = *format_str++;
+
+        for (;; ++format_str)
+          {
+            if (*format_str == '*')
+              {
+                // Room for the longest width, "-2147483648".
+                ACE_INT32 wp = 0;
+                if (spec_end - fp < 11)
+                  {
+                    too_long = true;
+                    return false;
+                  }
+                if (!in.get_int (wp))
+                  return false;
+                fp += ACE_OS::sprintf (fp, ACE_TEXT ("%d"), wp);
+              }
+            else if (*format_str != '\0'
+                     && ACE_OS::strchr (flag_chars, *format_str) != 0)
+              {
+                if (fp == spec_end)
+                  {
+                    too_long = true;
+                    return false;
+                  }
+                *fp++ = *format_str;
+              }
+            else
+              break;
+          }
+        *fp = '\0';
+
+        ACE_INT32 i = 0;
+        ACE_INT64 q = 0;
+        ACE_UINT64 u = 0;
+        double d = 0;
+
+        switch (*format_str)
+          {
+          case 'A':
+          case 'F': case 'f': case 'e': case 'E':
+          case 'g': case 'G':
+            if (!in.get_double (d))
+              return false;
+            fp[0] = *format_str == 'A' ? ACE_TEXT ('f') : *format_str;
+            fp[1] = '\0';
+            out.print (spec, d);
+            break;
+
+          case 'd': case 'i': case 'o':
+          case 'u': case 'x': case 'X':
+            if (!in.get_int (i))
+              return false;
+            fp[0] = *format_str;
+            fp[1] = '\0';
+            out.print (spec, i);
+            break;
+
+          case 'l':
+          case 'R':
+          case 'P':
+            if (!in.get_int (i))
+              return false;
+#if defined (ACE_OPENVMS)
+            ACE_OS::strcpy (fp, *format_str == 'P'
+                                ? ACE_TEXT ("x")
+                                : ACE_TEXT ("d"));
+#else
+            ACE_OS::strcpy (fp, ACE_TEXT ("d"));
+#endif /* ACE_OPENVMS */
+            out.print (spec, i);
+            break;
+
+          case 'c':
+            if (!in.get_int (i))
+              return false;
+            ACE_OS::strcpy (fp, char_conv);
+            out.print (spec, i);
+            break;
+
+          case 'w':
+          case 'z':
+            if (!in.get_int (i))
+              return false;
+            ACE_OS::strcpy (fp, wchar_conv);
+            out.print (spec, i);
+            break;
+
+          case 'M':
+            if (!in.get_int (i))
+              return false;
+            if (spec[1] == ACE_TEXT ('.') && spec[2] == ACE_TEXT ('1'))
+              {
+                // A single character for the priority.
+                ACE_OS::strcpy (spec + 1, char_conv);
+                out.print (spec,
+                           static_cast<int> (priority_char (ACE_Log_Priority (i))));
+              }
+            else
+              {
+                ACE_OS::strcpy (fp, string_conv);
+                out.print (spec,
+                           ACE_Log_Record::priority_name (ACE_Log_Priority (i)));
+              }
+            break;
+
+          case 'N': case 'n': case 'm': case 'S':
+          case 's': case 'C': case 'W': case 'Z':
+            if (!in.get_string (arg, size))
+              return false;
+            ACE_OS::strcpy (fp, string_conv);
+            out.print (spec, static_cast<const ACE_TCHAR *> (arg));
+            break;
+
+          case 'p':
+            if (!in.get_string (arg, size) || !in.get_string (arg2, size))
+              return false;
+            ACE_OS::strcpy (fp, string_conv);
+            ACE_OS::strcat (fp, ACE_TEXT (": %"));
+            ACE_OS::strcat (fp, string_conv);
+            out.print (spec, arg, arg2);
+            break;
+
+          case 'D':
+          case 'T':
+            {
+              ACE_Time_Value tv;
+              if (!in.get_time (tv))
+                return false;
+
+              ACE_TCHAR day_and_time[27];
+              const ACE_TCHAR *s =
+                ACE::timestamp (tv,
+                                day_and_time,
+                                sizeof (day_and_time) / sizeof (ACE_TCHAR));
+              if (*format_str == 'D')
+                s = day_and_time;
+              ACE_OS::strcpy (fp, string_conv);
+              out.print (spec, s != 0 ? s : ACE_TEXT (""));
+            }
+            break;
+
+          case 't':
+            if (!in.get_uint64 (u))
+              return false;
+#if defined (ACE_WIN32)
+            ACE_OS::strcpy (fp, ACE_TEXT ("u"));
+            out.print (spec, static_cast<unsigned> (u));
+#else
+            ACE_OS::strcpy (fp, ACE_TEXT ("lu"));
+            out.print (spec, static_cast<unsigned long> (u));
+#endif /* ACE_WIN32 */
+            break;
+
+          case 'Q':
+          case 'B':
+            if (!in.get_uint64 (u))
+              return false;
+            ACE_OS::strcpy (fp, &ACE_UINT64_FORMAT_SPECIFIER[1]);
+            out.print (spec, u);
+            break;
+
+          case 'q':
+          case 'b':
+          case ':':
+            if (!in.get_int64 (q))
+              return false;
+            ACE_OS::strcpy (fp, &ACE_INT64_FORMAT_SPECIFIER[1]);
+            out.print (spec, q);
+            break;
+
+          case '@':
+            if (!in.get_uint64 (u))
+              return false;
+            ACE_OS::strcpy (fp, ACE_TEXT ("p"));
+            out.print (spec,
+                       reinterpret_cast<void *> (static_cast<uintptr_t> (u)));
+            break;
+
+          case '$':
+            out.put ('\n');
+            /* fallthrough */
+
+          case 'I':
+            if (!in.get_int (i))
+              return false;
+            for (; i > 0 && out.room (); --i)
+              out.put (' ');
+            break;
+
+          case '{':
+          case '}':
+            break;
+
+          default:
+            // Not a directive after all: copy it as is.
+            while (start_format != format_str)
+              out.put (*start_format++);
+            if (*format_str != '\0')
+              out.put (*format_str);
+            break;
+          }
+
+        if (*format_str != '\0')
+          ++format_str;
+      }
+
+    return true;
+  }
+}
+
+ssize_t
+ACE_Log_Binary::encode (char *data,
+                        size_t size,
+                        ACE_Log_Msg &log_msg,
+                        const ACE_Log_Record &log_record,
+                        const ACE_TCHAR *program_name,
+                        int timestamp,
+                        const ACE_TCHAR *format,
+                        va_list argp)
+{
+  // Check that nothing in the format must be done now, before doing
+  // anything.
+  for (const ACE_TCHAR *p = ACE_OS::strchr (format, '%');
+       p != 0;
+       p = ACE_OS::strchr (p, '%'))
+    {
+      ++p;
+      while (*p == '*' || (*p != '\0' && ACE_OS::strchr (flag_chars, *p) != 0))
+        ++p;
+
+      if (*p == 'a' || *p == 'r' || *p == '?')
+        return -1;
+      else if (*p == '%')
+        ++p;
+    }
+
+  ACE_Byte prefixes = 0;
+  if (program_name != 0)
+    ACE_SET_BITS (prefixes, PROGRAM_NAME);
+  if (timestamp == 1)
+    ACE_SET_BITS (prefixes, TIME_ONLY);
+  else if (timestamp > 1)
+    ACE_SET_BITS (prefixes, DATE_AND_TIME);
+
+  Encoder out (data, size);
+  out.put_header (prefixes);
+  if (timestamp > 0)
+    out.put_time (log_record.time_stamp (), false);
+  if (program_name != 0)
+    out.put_string (program_name, false);
+  out.put_string (format, false);
+
+  // Collect the values, as ACE_Log_Msg::log() would print them.
+  const ACE_TCHAR *format_str = format;
+
+  while ((format_str = ACE_OS::strchr (format_str, '%')) != 0)
+    {
+      ++format_str;
+      if (*format_str == '%')
+        {
+          ++format_str;
+          continue;
+        }
+
+      const ACE_TCHAR *flags = format_str;
+      int wp = 0;
+
+      for (;; ++format_str)
+        {
+          if (*format_str == '*')
+            {
+              wp = va_arg (argp, int);
+              out.put_int (wp);
+            }
+          else if (*format_str == '\0'
+                   || ACE_OS::strchr (flag_chars, *format_str) == 0)
+            break;
+        }
+
+      switch (*format_str)
+        {
+        case 'A':
+        case 'F': case 'f': case 'e': case 'E':
+        case 'g': case 'G':
+          out.put_double (va_arg (argp, double));
+          break;
+
+        case 'd': case 'i': case 'o':
+        case 'u': case 'x': case 'X':
+        case 'c':
+          out.put_int (va_arg (argp, int));
+          break;
+
+        case 'l':
+          out.put_int (log_msg.linenum ());
+          break;
+
+        case 'N':
+          out.put_string (log_msg.file ()
+                          ? ACE_TEXT_CHAR_TO_TCHAR (log_msg.file ())
+                          : ACE_TEXT ("<unknown file>"));
+          break;
+
+        case 'n':
+          out.put_string (ACE_Log_Msg::program_name ()
+                          ? ACE_Log_Msg::program_name ()
+                          : ACE_TEXT ("<unknown>"));
+          break;
+
+        case 'P':
+          out.put_int (static_cast<ACE_INT32> (log_msg.getpid ()));
+          break;
+
+        case 'p':
+          {
+            ACE_TCHAR *str = va_arg (argp, ACE_TCHAR *);
+            out.put_string (str ? str : ACE_TEXT ("(null)"));
+          }
+          /* fallthrough */
+
+        case 'm':
+          out.put_string (ACE_TEXT_CHAR_TO_TCHAR
+                          (ACE_OS::strerror (ACE::map_errno (log_msg.errnum ()))));
+          break;
+
+        case 'M':
+          out.put_int (static_cast<ACE_INT32> (log_record.type ()));
+          break;
+
+        case 'R':
+          {
+            int const status = va_arg (argp, int);
+            log_msg.op_status (status);
+            out.put_int (status);
+          }
+          break;
+
+        case '{':
+          log_msg.inc ();
+          break;
+
+        case '}':
+          log_msg.dec ();
+          break;
+
+        case '$':
+        case 'I':
+          // Like ACE_Log_Msg, %*I overrides the nesting indent.
+#if defined (ACE_HAS_TRACE)
+          if (0 == wp)
+            wp = ACE_Trace::get_nesting_indent ();
+#else
+          if (0 == wp)
+            wp = 4;
+#endif /* ACE_HAS_TRACE */
+          out.put_int (wp * log_msg.trace_depth ());
+          break;
+
+        case 'S':
+          out.put_string (ACE_TEXT_CHAR_TO_TCHAR
+                          (ACE_OS::strsignal (va_arg (argp, int))));
+          break;
+
+        case 'D':
+        case 'T':
+          if (flags[0] == '#')
+            out.put_time (*va_arg (argp, ACE_Time_Value *));
+          else
+            out.put_time (log_record.time_stamp ());
+          break;
+
+        case 't':
+          {
+#if defined (ACE_WIN32)
+            out.put_uint64 (static_cast<unsigned> (ACE_Thread::self ()));
+#else
+            ACE_hthread_t t_id;
+            ACE_OS::thr_self (t_id);
+            // See ACE_Log_Msg::log() about this cast.
+            out.put_uint64 ((unsigned long) t_id);
+#endif /* ACE_WIN32 */
+          }
+          break;
+
+        case 's':
+          {
+            ACE_TCHAR *str = va_arg (argp, ACE_TCHAR *);
+            out.put_string (str ? str : ACE_TEXT ("(null)"));
+          }
+          break;
+
+        case 'C':
+          {
+            char *cstr = va_arg (argp, char *);
+            out.put_string (ACE_TEXT_CHAR_TO_TCHAR (cstr ? cstr : "(null)"));
+          }
+          break;
+
+        case 'W':
+#if defined (ACE_HAS_WCHAR)
+          {
+            wchar_t *wstr = va_arg (argp, wchar_t *);
+            out.put_string (ACE_TEXT_WCHAR_TO_TCHAR
+                            (wstr ? wstr : ACE_TEXT_WIDE ("(null)")));
+          }
+#else
+          out.put_string (ACE_TEXT (""));
+#endif /* ACE_HAS_WCHAR */
+          break;
+
+        case 'w':
+#if !defined (ACE_WIN32) && defined (ACE_USES_WCHAR)
+          out.put_int (static_cast<ACE_INT32> (va_arg (argp, wint_t)));
+#else
+          out.put_int (va_arg (argp, int));
+#endif /* !ACE_WIN32 && ACE_USES_WCHAR */
+          break;
+
+        case 'z':
+          out.put_int (static_cast<wchar_t> (va_arg (argp, int)));
+          break;
+
+        case 'Z':
+          {
+            ACE_OS::WChar *wchar_str = va_arg (argp, ACE_OS::WChar *);
+            if (wchar_str != 0)
+              out.put_chars (wchar_str);
+            else
+              out.put_string (ACE_TEXT (""));
+          }
+          break;
+
+        case 'Q':
+          out.put_uint64 (va_arg (argp, ACE_UINT64));
+          break;
+
+        case 'q':
+          out.put_int64 (va_arg (argp, ACE_INT64));
+          break;
+
+        case 'b':
+          out.put_int64 (va_arg (argp, ssize_t));
+          break;
+
+        case 'B':
+          out.put_uint64 (va_arg (argp, size_t));
+          break;
+
+        case ':':
+          out.put_int64 (static_cast<ACE_INT64> (va_arg (argp, time_t)));
+          break;
+
+        case '@':
+          out.put_uint64 (reinterpret_cast<uintptr_t> (va_arg (argp, void *)));
+          break;
+
+        default:
+          break;
+        }
+
+      if (*format_str == '\0')
+        break;
+      ++format_str;
+    }
+
+  return static_cast<ssize_t> (out.length ());
+}
+
+int
+ACE_Log_Binary::render (const char *data,
+                        size_t len,
+                        ACE_TCHAR *msg,
+                        size_t size)
+{
+  if (size == 0)
+    return -1;
+
+  Output out (msg, size);
+  Decoder in (data, len);
+
+  ACE_Byte prefixes = 0;
+  if (!in.get_header (prefixes))
+    return -1;
+
+  size_t const max = ACE_Log_Record::MAXLOGMSGLEN;
+  ACE_TCHAR *text = 0;
+  ACE_NEW_RETURN (text, ACE_TCHAR[3 * max], -1);
+
+  // The values which didn't fit were left out of the encoding, so
+  // running out of values isn't an error; values of the wrong type,
+  // and directives too long to be rendered, are.
+  bool too_long = false;
+  bool const valid = render_message (in,
+                                     out,
+                                     prefixes,
+                                     text,
+                                     text + max,
+                                     text + 2 * max,
+                                     too_long)
+    || (in.done () && !too_long);
+  delete [] text;
+
+  return valid ? 0 : -1;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,88 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Log_Binary.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+#ifndef ACE_LOG_BINARY_H
+#define ACE_LOG_BINARY_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Basic_Types.h"
+#include "ace/os_include/os_stdarg.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Log_Msg;
+class ACE_Log_Record;
+
+/**
+ * @class ACE_Log_Binary
+ *
+ * @brief Encodes the format and the arguments of a log message in a
+ * compact binary form, and renders them as text later.
+ *
+ * This is what ACE_Log_Msg does with the ACE_Log_Msg::BINARY flag:
+ * instead of running the format through its printf-style formatter,
+ * it only copies the format and the values of the arguments, and what
+ * the ACE specific directives (%t, %P, %N, %l, %p, %D, ...) print,
+ * in the record.  The text is rendered from the encoded form the
+ * first time ACE_Log_Record::msg_data() is called, which may be in a
+ * backend thread, or in the logging server the record is sent to: the
+ * encoded form travels in the record, and ACE_Log_Records read from a
+ * CDR stream render it as well.
+ *
+ * The encoding is in the byte order and with the characters of the
+ * host which made it, and records its byte order and character size;
+ * render() converts as needed.  The directives which run code (%r),
+ * abort (%a) or print a stack trace (%?) can't be deferred: encode()
+ * refuses the formats which use them.
+ */
+class ACE_Export ACE_Log_Binary
+{
+public:
+  /**
+   * Encode the message of @a format, with the arguments @a argp, in
+   * the @a size bytes at @a data.  @a log_msg provides the values of
+   * the ACE directives, and @a log_record the time stamp of %D and %T.
+   * @a program_name and @a timestamp are the prefixes ACE_Log_Msg adds
+   * to the message, if any: @a timestamp is 1 for the time only, 2 for
+   * the date and time.
+   *
+   * What doesn't fit in @a size bytes is left out, as the text of
+   * long messages is truncated.  Returns the size of the encoding, or
+   * -1 if @a format can't be deferred; @a argp is then left alone, and
+   * @a log_msg unchanged.
+   */
+  static ssize_t encode (char *data,
+                         size_t size,
+                         ACE_Log_Msg &log_msg,
+                         const ACE_Log_Record &log_record,
+                         const ACE_TCHAR *program_name,
+                         int timestamp,
+                         const ACE_TCHAR *format,
+                         va_list argp);
+
+  /// Render the message encoded in the @a len bytes at @a data as
+  /// text, in @a msg, of @a size characters.  Returns -1 if the
+  /// encoding isn't valid, 0 otherwise.
+  static int render (const char *data,
+                     size_t len,
+                     ACE_TCHAR *msg,
+                     size_t size);
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* ACE_LOG_BINARY_H */
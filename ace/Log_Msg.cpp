@@ -38,6 +38,7 @@
 #include "ace/Log_Msg_NT_Event_Log.h"
 #include "ace/Log_Msg_UNIX_Syslog.h"
 #include "ace/Log_Record.h"
+#include "ace/Log_Binary.h"
 #include "ace/Recursive_Thread_Mutex.h"
 #include "ace/Stack_Trace.h"
 #include "ace/Atomic_Op.h"
@@ -881,6 +882,11 @@ ACE_Log_Msg::open (const ACE_TCHAR *prog_name,
     ACE_SET_BITS (ACE_Log_Msg::flags_,
                   ACE_Log_Msg::SILENT);
 
+  if (ACE_BIT_ENABLED (flags,
+                       ACE_Log_Msg::BINARY))
+    ACE_SET_BITS (ACE_Log_Msg::flags_,
+                  ACE_Log_Msg::BINARY);
+
   return status;
 }
 
@@ -1012,6 +1018,37 @@ ACE_Log_Msg::log (const ACE_TCHAR *format_str,
 
   log_record.category(category);
 
+  if (ACE_BIT_ENABLED (ACE_Log_Msg::flags_, ACE_Log_Msg::BINARY))
+    {
+      // Only keep the format and the values of the arguments; the
+      // text is rendered from them when it's needed.  The formats
+      // which can't be deferred are formatted below.
+      char data[ACE_Log_Record::MAXLOGMSGLEN];
+      va_list args;
+      va_copy (args, argp);
+      ssize_t const len =
+        ACE_Log_Binary::encode (data,
+                                sizeof data,
+                                *this,
+                                log_record,
+                                ACE_BIT_ENABLED (ACE_Log_Msg::flags_,
+                                                 ACE_Log_Msg::VERBOSE)
+                                ? ACE_Log_Msg::program_name_
+                                : 0,
+                                this->timestamp_,
+                                format_str,
+                                args);
+      va_end (args);
+
+      if (len != -1)
+        {
+          if (log_record.msg_binary (data, len) == -1)
+            return -1;
+
+          return this->log (log_record, 0);
+        }
+    }
+
   // bp is pointer to where to put next part of logged message.
   // bspace is the number of characters remaining in msg_.
   ACE_TCHAR *bp = const_cast<ACE_TCHAR *> (this->msg ());
@@ -202,7 +202,12 @@ public:
     /// Write messages to the system's event log.
     SYSLOG = 128,
     /// Write messages to the user provided backend
-    CUSTOM = 256
+    CUSTOM = 256,
+    /// Do not format messages when they are logged: keep their format
+    /// and arguments in the record, encoded by ACE_Log_Binary, and only
+    /// render the text when it is needed, e.g. by the logging server
+    /// the records are sent to.
+    BINARY = 512
  };
 
   // = Initialization and termination routines.
@@ -0,0 +1,607 @@
+// $Id$
+
+#include "ace/Log_Msg_Async.h"
+
+#if defined (ACE_HAS_THREADS)
+
+#include "ace/ACE.h"
+#include "ace/Log_Msg.h"
+#include "ace/Guard_T.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_sys_time.h"
+
+#if defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1)
+#  define ACE_LOG_MSG_ASYNC_BARRIER() __sync_synchronize ()
+#else
+#  define ACE_LOG_MSG_ASYNC_BARRIER()
+#endif /* ACE_HAS_GCC_ATOMIC_BUILTINS */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+// Most records the thread takes out of the ring before writing them.
+static const int ACE_LOG_MSG_ASYNC_BATCH = 64;
+
+ACE_Log_Msg_Async::ACE_Log_Msg_Async (ACE_HANDLE handle,
+                                      size_t size,
+                                      Overflow_Policy policy)
+  : handle_ (handle),
+    backend_ (0),
+    policy_ (policy),
+    not_empty_ (lock_),
+    not_full_ (lock_),
+    written_cond_ (lock_)
+{
+  this->init (size);
+}
+
+ACE_Log_Msg_Async::ACE_Log_Msg_Async (ACE_Log_Msg_Backend *backend,
+                                      size_t size,
+                                      Overflow_Policy policy)
+  : handle_ (ACE_INVALID_HANDLE),
+    backend_ (backend),
+    policy_ (policy),
+    not_empty_ (lock_),
+    not_full_ (lock_),
+    written_cond_ (lock_)
+{
+  this->init (size);
+}
+
+void
+ACE_Log_Msg_Async::init (size_t size)
+{
+  this->slots_ = 0;
+  this->mask_ = 0;
+  this->enqueue_pos_ = 0;
+  this->dequeue_pos_ = 0;
+  this->done_pos_ = 0;
+  this->consumer_waiting_ = 0;
+  this->producers_waiting_ = 0;
+  this->flushers_waiting_ = 0;
+  this->stop_ = 0;
+  this->running_ = false;
+  this->open_ = false;
+  this->flags_ = 0;
+  this->host_ = 0;
+  this->dropped_ = 0;
+  this->reported_ = 0;
+  this->written_ = 0;
+  this->blocked_ = 0;
+
+  size_t slots = 2;
+  while (slots < size)
+    slots *= 2;
+
+  ACE_NEW (this->slots_, Slot[slots]);
+  this->mask_ = slots - 1;
+
+  for (size_t i = 0; i < slots; ++i)
+    this->slots_[i].sequence_ = i;
+
+  (void) this->start ();
+}
+
+ACE_Log_Msg_Async::~ACE_Log_Msg_Async (void)
+{
+  (void) this->close ();
+  (void) this->stop ();
+  delete [] this->slots_;
+}
+
+int
+ACE_Log_Msg_Async::open (const ACE_TCHAR *logger_key)
+{
+  if (!this->running_)
+    return -1;
+
+  if (this->backend_ != 0 && this->backend_->open (logger_key) == -1)
+    return -1;
+
+  this->open_ = true;
+  return 0;
+}
+
+int
+ACE_Log_Msg_Async::reset (void)
+{
+  int result = this->drain ();
+
+  if (this->backend_ != 0 && this->backend_->reset () == -1)
+    result = -1;
+
+  return result;
+}
+
+int
+ACE_Log_Msg_Async::close (void)
+{
+  int result = this->drain ();
+
+  if (this->backend_ != 0 && this->backend_->close () == -1)
+    result = -1;
+
+  return result;
+}
+
+ssize_t
+ACE_Log_Msg_Async::log (ACE_Log_Record &log_record)
+{
+  // ACE_Log_Msg calls backends with the lock that guards its flags
+  // held, so the thread must not read them itself: a thread waiting
+  // for room would keep it from ever making any.
+  if (this->backend_ == 0 && this->open_)
+    {
+      ACE_Log_Msg *log_msg = ACE_LOG_MSG;
+      this->flags_ = log_msg->flags ();
+      this->host_ = log_msg->local_host ();
+    }
+
+  while (this->open_)
+    {
+      size_t pos = 0;
+      Slot *slot = this->claim (pos);
+
+      if (slot != 0)
+        {
+          ACE_Log_Record &record = slot->record_;
+          record.type (log_record.type ());
+          record.time_stamp (log_record.time_stamp ());
+          record.pid (log_record.pid ());
+
+          // Encoded messages are only rendered by the thread.
+          if (log_record.msg_binary () != 0)
+            record.msg_binary (log_record.msg_binary (),
+                               log_record.msg_binary_len ());
+          else
+            record.msg_data (log_record.msg_data ());
+
+          this->publish (slot, pos);
+          return 0;
+        }
+
+      // The thread itself can't wait for room, if its backend logs.
+      if (this->policy_ == DROP
+          || ACE_OS::thr_equal (ACE_OS::thr_self (), this->thread_id_))
+        break;
+
+      this->wait_for_room ();
+    }
+
+  ++this->dropped_;
+  return -1;
+}
+
+int
+ACE_Log_Msg_Async::flush (const ACE_Time_Value *timeout)
+{
+  size_t const pos = this->enqueue_pos_;
+  ACE_Time_Value deadline;
+  if (timeout != 0)
+    deadline = ACE_OS::gettimeofday () + *timeout;
+
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+
+  ++this->flushers_waiting_;
+  ACE_LOG_MSG_ASYNC_BARRIER ();
+
+  int result = 0;
+  while (static_cast<ssize_t> (pos - this->done_pos_) > 0)
+    {
+      if (!this->running_
+          || this->written_cond_.wait (timeout != 0 ? &deadline : 0) == -1)
+        {
+          errno = ETIME;
+          result = -1;
+          break;
+        }
+    }
+
+  --this->flushers_waiting_;
+  return result;
+}
+
+unsigned long
+ACE_Log_Msg_Async::dropped (void) const
+{
+  return this->dropped_.value ();
+}
+
+unsigned long
+ACE_Log_Msg_Async::written (void) const
+{
+  return this->written_.value ();
+}
+
+unsigned long
+ACE_Log_Msg_Async::blocked (void) const
+{
+  return this->blocked_.value ();
+}
+
+int
+ACE_Log_Msg_Async::start (void)
+{
+  if (this->slots_ == 0)
+    return -1;
+
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+
+  if (this->thr_mgr_.spawn (ACE_Log_Msg_Async::run_svc,
+                            this,
+                            THR_NEW_LWP | THR_JOINABLE,
+                            &this->thread_id_) == -1)
+    return -1;
+
+  // A thread takes ACE_Log_Msg's lock as it starts and exits, so it
+  // is started here rather than by open(), which ACE_Log_Msg calls
+  // with that lock held.
+  while (!this->running_ && this->stop_ == 0)
+    this->written_cond_.wait ();
+
+  if (this->running_)
+    return 0;
+
+  guard.release ();
+  this->thr_mgr_.wait ();
+  return -1;
+}
+
+int
+ACE_Log_Msg_Async::drain (void)
+{
+  int result = 0;
+
+  if (this->open_)
+    {
+      result = this->flush ();
+      this->open_ = false;
+
+      // Let the threads waiting for room drop their records.
+      ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+      this->not_full_.broadcast ();
+    }
+
+  return result;
+}
+
+int
+ACE_Log_Msg_Async::stop (void)
+{
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+
+    if (!this->running_)
+      return 0;
+
+    this->stop_ = 1;
+    this->not_empty_.signal ();
+  }
+
+  int const result = this->thr_mgr_.wait ();
+
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+  this->running_ = false;
+  return result;
+}
+
+// Claim the slot of the next record put in the ring, at position
+// <pos>, or return 0 if the ring is full.
+
+ACE_Log_Msg_Async::Slot *
+ACE_Log_Msg_Async::claim (size_t &pos)
+{
+#if defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1)
+  pos = this->enqueue_pos_;
+
+  for (;;)
+    {
+      Slot *slot = &this->slots_[pos & this->mask_];
+      size_t const sequence = slot->sequence_;
+      __sync_synchronize ();
+
+      ssize_t const diff = static_cast<ssize_t> (sequence - pos);
+      if (diff == 0)
+        {
+          if (__sync_bool_compare_and_swap (&this->enqueue_pos_,
+                                            pos,
+                                            pos + 1))
+            return slot;
+        }
+      else if (diff < 0)
+        return 0;
+
+      pos = this->enqueue_pos_;
+    }
+#else
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->ring_lock_, 0);
+
+  pos = this->enqueue_pos_;
+  Slot *slot = &this->slots_[pos & this->mask_];
+  if (slot->sequence_ != pos)
+    return 0;
+
+  ++this->enqueue_pos_;
+  return slot;
+#endif /* ACE_HAS_GCC_ATOMIC_BUILTINS */
+}
+
+// Hand the record written in <slot> to the thread, waking it up if
+// it waits.
+
+void
+ACE_Log_Msg_Async::publish (Slot *slot, size_t pos)
+{
+#if defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1)
+  __sync_synchronize ();
+  slot->sequence_ = pos + 1;
+  __sync_synchronize ();
+
+  if (this->consumer_waiting_ == 0)
+    return;
+#else
+  {
+    ACE_GUARD (ACE_Thread_Mutex, guard, this->ring_lock_);
+    slot->sequence_ = pos + 1;
+  }
+#endif /* ACE_HAS_GCC_ATOMIC_BUILTINS */
+
+  ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+  if (this->consumer_waiting_ != 0)
+    this->not_empty_.signal ();
+}
+
+// Whether the ring is full.
+
+bool
+ACE_Log_Msg_Async::full (void)
+{
+#if !defined (ACE_HAS_GCC_ATOMIC_BUILTINS) || (ACE_HAS_GCC_ATOMIC_BUILTINS == 0)
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->ring_lock_, false);
+#endif /* !ACE_HAS_GCC_ATOMIC_BUILTINS */
+
+  size_t const pos = this->enqueue_pos_;
+  bool const result = this->slots_[pos & this->mask_].sequence_ != pos;
+  ACE_LOG_MSG_ASYNC_BARRIER ();
+  return result;
+}
+
+// Take the next record out of the ring, or return 0 if it is empty.
+// Only called by the thread, which calls release() once done with
+// the record.
+
+ACE_Log_Msg_Async::Slot *
+ACE_Log_Msg_Async::acquire (void)
+{
+#if !defined (ACE_HAS_GCC_ATOMIC_BUILTINS) || (ACE_HAS_GCC_ATOMIC_BUILTINS == 0)
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->ring_lock_, 0);
+#endif /* !ACE_HAS_GCC_ATOMIC_BUILTINS */
+
+  Slot *slot = &this->slots_[this->dequeue_pos_ & this->mask_];
+  bool const ready = slot->sequence_ == this->dequeue_pos_ + 1;
+  ACE_LOG_MSG_ASYNC_BARRIER ();
+  return ready ? slot : 0;
+}
+
+// Give the slot of the record acquire() returned back to the
+// producers.
+
+void
+ACE_Log_Msg_Async::release (Slot *slot)
+{
+#if !defined (ACE_HAS_GCC_ATOMIC_BUILTINS) || (ACE_HAS_GCC_ATOMIC_BUILTINS == 0)
+  ACE_GUARD (ACE_Thread_Mutex, guard, this->ring_lock_);
+#endif /* !ACE_HAS_GCC_ATOMIC_BUILTINS */
+
+  ACE_LOG_MSG_ASYNC_BARRIER ();
+  slot->sequence_ = this->dequeue_pos_ + this->mask_ + 1;
+  ++this->dequeue_pos_;
+}
+
+// Wait until the thread frees a slot, or stops.
+
+void
+ACE_Log_Msg_Async::wait_for_room (void)
+{
+  ++this->blocked_;
+
+  ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+
+  ++this->producers_waiting_;
+  ACE_LOG_MSG_ASYNC_BARRIER ();
+
+  if (this->open_ && this->full ())
+    this->not_full_.wait ();
+
+  --this->producers_waiting_;
+}
+
+ACE_THR_FUNC_RETURN
+ACE_Log_Msg_Async::run_svc (void *arg)
+{
+  static_cast<ACE_Log_Msg_Async *> (arg)->svc ();
+  return 0;
+}
+
+void
+ACE_Log_Msg_Async::svc (void)
+{
+  int const batch = ACE_IOV_MAX < ACE_LOG_MSG_ASYNC_BATCH
+    ? ACE_IOV_MAX
+    : ACE_LOG_MSG_ASYNC_BATCH;
+
+  // The formatted records of a batch, and a record of our own to
+  // report those dropped.
+  char *text = 0;
+  if (this->backend_ == 0)
+    {
+      ACE_NEW_NORETURN (text,
+                        char[batch * ACE_Log_Record::MAXVERBOSELOGMSGLEN]);
+    }
+
+  {
+    ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+
+    // Tell start () whether the thread is up.
+    if (this->backend_ == 0 && text == 0)
+      this->stop_ = 1;
+    else
+      this->running_ = true;
+
+    this->written_cond_.broadcast ();
+    if (!this->running_)
+      return;
+  }
+
+#if defined (ACE_USES_WCHAR)
+  ACE_TCHAR verbose[ACE_Log_Record::MAXVERBOSELOGMSGLEN];
+#endif /* ACE_USES_WCHAR */
+
+  iovec iov[ACE_LOG_MSG_ASYNC_BATCH];
+  ACE_Log_Record notice;
+
+  for (;;)
+    {
+      u_long const flags = this->flags_;
+      const ACE_TCHAR *host = this->host_;
+
+      // Records taken out of the ring, and records handled, with the
+      // notice of those dropped.
+      int count = 0;
+      int handled = 0;
+      int iovcnt = 0;
+
+      unsigned long const dropped = this->dropped_.value ();
+      Slot *slot = 0;
+
+      while (handled < batch)
+        {
+          ACE_Log_Record *record = 0;
+
+          if (dropped != this->reported_)
+            {
+              ACE_TCHAR msg[80];
+              ACE_OS::sprintf (msg,
+                               ACE_TEXT ("ACE_Log_Msg_Async: %lu log ")
+                               ACE_TEXT ("records dropped\n"),
+                               dropped - this->reported_);
+              notice.type (LM_WARNING);
+              notice.time_stamp (ACE_OS::gettimeofday ());
+              notice.pid (ACE_OS::getpid ());
+              notice.msg_data (msg);
+              this->reported_ = dropped;
+              record = &notice;
+            }
+          else if ((slot = this->acquire ()) != 0)
+            record = &slot->record_;
+          else
+            break;
+
+          ++handled;
+
+          if (this->backend_ != 0)
+            this->backend_->log (*record);
+          else
+            {
+              char *buf = text + iovcnt * ACE_Log_Record::MAXVERBOSELOGMSGLEN;
+#if defined (ACE_USES_WCHAR)
+              if (record->format_msg (host, flags, verbose) == 0)
+                ACE_OS::strcpy (buf, ACE_TEXT_ALWAYS_CHAR (verbose));
+              else
+                buf[0] = '\0';
+#else
+              if (record->format_msg (host, flags, buf) != 0)
+                buf[0] = '\0';
+#endif /* ACE_USES_WCHAR */
+              iov[iovcnt].iov_base = buf;
+              iov[iovcnt].iov_len = ACE_OS::strlen (buf);
+              ++iovcnt;
+            }
+
+          if (slot != 0)
+            {
+              this->release (slot);
+              slot = 0;
+              ++count;
+            }
+        }
+
+      if (handled > 0)
+        {
+          // Make room for the threads waiting for it first.
+          ACE_LOG_MSG_ASYNC_BARRIER ();
+          if (this->producers_waiting_ != 0)
+            {
+              ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+              this->not_full_.broadcast ();
+            }
+
+          if (iovcnt > 0)
+            this->write (iov, iovcnt);
+
+          this->written_ += count;
+          this->done_pos_ = this->dequeue_pos_;
+
+          ACE_LOG_MSG_ASYNC_BARRIER ();
+          if (this->flushers_waiting_ != 0)
+            {
+              ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+              this->written_cond_.broadcast ();
+            }
+          continue;
+        }
+
+      ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+
+      this->consumer_waiting_ = 1;
+      ACE_LOG_MSG_ASYNC_BARRIER ();
+
+      if ((slot = this->acquire ()) == 0)
+        {
+          if (this->stop_ != 0)
+            break;
+
+          this->not_empty_.wait ();
+        }
+
+      this->consumer_waiting_ = 0;
+    }
+
+  this->consumer_waiting_ = 0;
+  delete [] text;
+}
+
+void
+ACE_Log_Msg_Async::write (iovec iov[], int iovcnt)
+{
+  // Errors can't be logged: they would only end up here.
+  while (iovcnt > 0)
+    {
+      size_t bytes_transferred = 0;
+      if (ACE::writev_n (this->handle_,
+                         iov,
+                         iovcnt,
+                         &bytes_transferred) != -1)
+        return;
+
+      // Skip what was written, and give up on the record which failed.
+      while (iovcnt > 0 && bytes_transferred >= iov[0].iov_len)
+        {
+          bytes_transferred -= iov[0].iov_len;
+          ++iov;
+          --iovcnt;
+        }
+
+      if (iovcnt > 0)
+        {
+          ++iov;
+          --iovcnt;
+        }
+    }
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_THREADS */
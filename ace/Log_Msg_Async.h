@@ -0,0 +1,236 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Log_Msg_Async.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+#ifndef ACE_LOG_MSG_ASYNC_H
+#define ACE_LOG_MSG_ASYNC_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Log_Msg_Backend.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_THREADS)
+
+#include "ace/Log_Record.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Condition_Thread_Mutex.h"
+#include "ace/Atomic_Op.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Log_Msg_Async
+ *
+ * @brief Implements an ACE_Log_Msg_Backend that hands log records to
+ * a thread of its own, which writes them out in batches.
+ *
+ * ACE_Log_Msg calls its backends with its lock held, so a backend
+ * writing to a slow file, pipe or syslog holds up every thread that
+ * logs.  log() only copies the record in a bounded ring instead, and
+ * returns; a thread of the backend takes the records out of the ring,
+ * formats them as ACE_Log_Msg::STDERR would, and writes them to a
+ * handle with one writev() per batch.  Alternatively, the thread can
+ * pass them on to another backend, e.g. an ACE_Log_Msg_UNIX_Syslog.
+ *
+ * The ring is lock-free where the GCC atomic builtins are available:
+ * threads logging at the same time only contend on its position.
+ * When it is full, log() either drops the record, or waits for the
+ * thread to make room, depending on the policy; dropped records are
+ * counted, and reported in the output.
+ *
+ * The thread runs from construction to destruction: it takes the lock
+ * of ACE_Log_Msg as it starts and exits, so the backend must not be
+ * created or destroyed with that lock held, e.g. from a backend.  The
+ * thread never takes it otherwise; the flags it formats the records
+ * with are those ACE_Log_Msg had when they were logged.
+ *
+ * Use it with ACE_Log_Msg::msg_backend() and the ACE_Log_Msg::CUSTOM
+ * flag; it must outlive its use by ACE_Log_Msg.
+ *
+ * @code
+ *   ACE_Log_Msg_Async backend;
+ *   ACE_Log_Msg::msg_backend (&backend);
+ *   ACE_LOG_MSG->open (argv[0], ACE_Log_Msg::CUSTOM);
+ * @endcode
+ */
+class ACE_Export ACE_Log_Msg_Async : public ACE_Log_Msg_Backend
+{
+public:
+  /// What log() does when the ring is full.
+  enum Overflow_Policy
+  {
+    /// Count the record as dropped and return -1.
+    DROP,
+    /// Wait until the thread makes room.
+    BLOCK
+  };
+
+  /// Write to @a handle, with room for @a size records.
+  ACE_Log_Msg_Async (ACE_HANDLE handle = ACE_STDERR,
+                     size_t size = ACE_DEFAULT_LOG_MSG_ASYNC_SIZE,
+                     Overflow_Policy policy = DROP);
+
+  /// Pass the records on to @a backend, with room for @a size records.
+  /// @a backend is opened, reset and closed along with this one.
+  ACE_Log_Msg_Async (ACE_Log_Msg_Backend *backend,
+                     size_t size = ACE_DEFAULT_LOG_MSG_ASYNC_SIZE,
+                     Overflow_Policy policy = DROP);
+
+  /// Writes the records left, and stops the thread.
+  virtual ~ACE_Log_Msg_Async (void);
+
+  /// Open the backend the records are passed to, if any, with
+  /// @a logger_key, and accept records.  Returns -1 if the thread
+  /// couldn't be started.
+  virtual int open (const ACE_TCHAR *logger_key);
+
+  /// Write the records left, and drop those logged until the next
+  /// open().
+  virtual int reset (void);
+
+  /// Write the records left, drop those logged until the next open(),
+  /// and close the backend the records are passed to, if any.
+  virtual int close (void);
+
+  /// Queue a copy of @a log_record.  Returns 0, or -1 if the record
+  /// was dropped.
+  virtual ssize_t log (ACE_Log_Record &log_record);
+
+  /// Wait until the records queued so far are written, or for up to
+  /// @a timeout, relative.  Returns -1 with @c errno ETIME if they
+  /// aren't.
+  int flush (const ACE_Time_Value *timeout = 0);
+
+  /// Number of records dropped because the ring was full, or because
+  /// the backend wasn't open.
+  unsigned long dropped (void) const;
+
+  /// Number of records written.
+  unsigned long written (void) const;
+
+  /// Number of times log() waited for room in the ring.
+  unsigned long blocked (void) const;
+
+private:
+  /// A record in the ring.
+  struct Slot
+  {
+    /// Position in the ring of the record this slot holds, plus 1,
+    /// once it is written; position of the next record to be put in
+    /// it otherwise.
+    volatile size_t sequence_;
+
+    ACE_Log_Record record_;
+  };
+
+  void init (size_t size);
+
+  /// Starts the thread, and waits until it runs.
+  int start (void);
+
+  /// Writes the records left and stops accepting new ones.
+  int drain (void);
+
+  /// Stops the thread, once it wrote the records left.
+  int stop (void);
+
+  // The following are documented in the .cpp file.
+  Slot *claim (size_t &pos);
+  void publish (Slot *slot, size_t pos);
+  bool full (void);
+  Slot *acquire (void);
+  void release (Slot *slot);
+  void wait_for_room (void);
+
+  /// Entry point of the thread.
+  static ACE_THR_FUNC_RETURN run_svc (void *arg);
+  void svc (void);
+
+  /// Writes @a iov to <handle_>, for as long as it takes.
+  void write (iovec iov[], int iovcnt);
+
+  /// Where the records are written, if they aren't passed on.
+  ACE_HANDLE handle_;
+
+  /// Where the records are passed on, if anywhere.
+  ACE_Log_Msg_Backend *backend_;
+
+  Overflow_Policy policy_;
+
+  /// The ring, <mask_> + 1 slots.
+  Slot *slots_;
+  size_t mask_;
+
+  /// Position of the next record put in the ring.
+  volatile size_t enqueue_pos_;
+
+  /// Position of the next record taken out of the ring.
+  volatile size_t dequeue_pos_;
+
+  /// Position of the next record to be written.
+  volatile size_t done_pos_;
+
+  /// Whether the thread waits on <not_empty_>, and how many threads
+  /// wait on <not_full_> and <written_cond_>.
+  volatile int consumer_waiting_;
+  volatile int producers_waiting_;
+  volatile int flushers_waiting_;
+
+  /// Whether the thread must exit once the ring is empty.
+  volatile int stop_;
+
+  /// Set while the thread runs.
+  volatile bool running_;
+
+  /// Set between open() and reset() or close().
+  volatile bool open_;
+
+  /// The flags and host name of ACE_Log_Msg, as of the last record
+  /// logged.
+  volatile u_long flags_;
+  const ACE_TCHAR * volatile host_;
+
+  /// The thread.
+  ACE_thread_t thread_id_;
+
+#if !defined (ACE_HAS_GCC_ATOMIC_BUILTINS) || (ACE_HAS_GCC_ATOMIC_BUILTINS == 0)
+  /// Serializes the ring.
+  ACE_Thread_Mutex ring_lock_;
+#endif /* !ACE_HAS_GCC_ATOMIC_BUILTINS */
+
+  /// Serializes the waits and <running_>.
+  ACE_Thread_Mutex lock_;
+  ACE_Condition_Thread_Mutex not_empty_;
+  ACE_Condition_Thread_Mutex not_full_;
+
+  /// Signalled once records are written, and once the thread runs.
+  ACE_Condition_Thread_Mutex written_cond_;
+
+  ACE_Atomic_Op<ACE_Thread_Mutex, unsigned long> dropped_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, unsigned long> written_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, unsigned long> blocked_;
+
+  /// Value of <dropped_> last reported in the output.
+  unsigned long reported_;
+
+  /// Manages the thread, of its own so that it can run while the
+  /// process exits.
+  ACE_Thread_Manager thr_mgr_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_THREADS */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_LOG_MSG_ASYNC_H */
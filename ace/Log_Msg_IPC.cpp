@@ -47,6 +47,15 @@ ACE_Log_Msg_IPC::close (void)
 ssize_t
 ACE_Log_Msg_IPC::log (ACE_Log_Record &log_record)
 {
+  // An encoded message is sent as is, without rendering it.
+  size_t msg_len = log_record.msg_binary_len ();
+  if (log_record.msg_binary () == 0)
+#if defined (ACE_USES_WCHAR)
+    msg_len = log_record.msg_data_len () * ACE_OutputCDR::wchar_maxbytes();
+#else
+    msg_len = log_record.msg_data_len ();
+#endif
+
   // Serialize the log record using a CDR stream, allocate enough
   // space for the complete <ACE_Log_Record>.
   size_t const max_payload_size =
@@ -55,11 +64,7 @@ ACE_Log_Msg_IPC::log (ACE_Log_Record &log_record)
     + 12 // timestamp
     + 4  // process id
     + 4  // data length
-#if defined (ACE_USES_WCHAR)
-    + (log_record.msg_data_len () * ACE_OutputCDR::wchar_maxbytes())  // message
-#else
-    + log_record.msg_data_len () // message
-#endif
+    + msg_len // message
     + ACE_CDR::MAX_ALIGNMENT;     // padding;
 
   // Insert contents of <log_record> into payload stream.
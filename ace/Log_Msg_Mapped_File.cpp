@@ -0,0 +1,943 @@
+// $Id$
+
+#include "ace/Log_Msg_Mapped_File.h"
+
+#if defined (ACE_HAS_THREADS) && !defined (ACE_LACKS_MMAP)
+
+#include "ace/Log_Msg.h"
+#include "ace/Log_Record.h"
+#include "ace/Guard_T.h"
+#include "ace/Dirent.h"
+#include "ace/Array_Base.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_sys_mman.h"
+#include "ace/OS_NS_sys_stat.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_Memory.h"
+
+#if defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1)
+#  define ACE_LOG_MSG_MAPPED_FILE_BARRIER() __sync_synchronize ()
+#else
+#  define ACE_LOG_MSG_MAPPED_FILE_BARRIER()
+#endif /* ACE_HAS_GCC_ATOMIC_BUILTINS */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+static const char ACE_LOG_SEGMENT_MAGIC[8] =
+  { 'A', 'C', 'E', 'L', 'O', 'G', 'S', 'G' };
+static const char ACE_LOG_SEGMENT_INDEX_MAGIC[8] =
+  { 'A', 'C', 'E', 'L', 'O', 'G', 'I', 'X' };
+static const ACE_UINT32 ACE_LOG_SEGMENT_BYTE_ORDER = 0x01020304;
+
+ACE_Log_Msg_Mapped_File::ACE_Log_Msg_Mapped_File (const ACE_TCHAR *path,
+                                                  size_t segment_size,
+                                                  const ACE_Time_Value &max_age,
+                                                  size_t max_segments)
+  : capacity_ (segment_size),
+    index_size_ (0),
+    max_age_ (max_age),
+    max_segments_ (max_segments),
+    current_ (0),
+    spare_ (0),
+    full_ (0),
+    free_ (0),
+    next_sequence_ (1),
+    open_ (false),
+    stop_ (false),
+    sync_ (false),
+    running_ (false),
+    creating_ (false),
+    work_ (lock_),
+    switched_ (lock_),
+    dropped_ (0)
+{
+  ACE_OS::strsncpy (this->path_, path, MAXPATHLEN + 1);
+
+  // Any record must fit in an empty segment.
+  if (this->capacity_ < ACE_Log_Record::MAXVERBOSELOGMSGLEN)
+    this->capacity_ = ACE_Log_Record::MAXVERBOSELOGMSGLEN;
+
+  this->index_size_ =
+    (this->capacity_ + ACE_DEFAULT_LOG_SEGMENT_INDEX_INTERVAL - 1)
+    / ACE_DEFAULT_LOG_SEGMENT_INDEX_INTERVAL;
+}
+
+ACE_Log_Msg_Mapped_File::~ACE_Log_Msg_Mapped_File (void)
+{
+  (void) this->close ();
+
+  while (this->free_ != 0)
+    {
+      Segment *segment = this->free_;
+      this->free_ = segment->next_;
+      delete [] segment->index_;
+      delete segment;
+    }
+}
+
+int
+ACE_Log_Msg_Mapped_File::open (const ACE_TCHAR *)
+{
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+
+    if (this->open_ || this->running_)
+      return 0;
+
+    if (ACE_OS::strlen (this->path_) + 8 > MAXPATHLEN)
+      {
+        errno = ENAMETOOLONG;
+        return -1;
+      }
+
+    if (this->scan () != 0)
+      return -1;
+  }
+
+  Segment *first = this->create ();
+  if (first == 0)
+    return -1;
+
+  // Have the second segment ready too, so that the first switch
+  // doesn't have to create it.  The thread retries if this fails.
+  Segment *spare = this->create ();
+
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+
+  this->stop_ = false;
+  this->sync_ = false;
+
+  if (this->thr_mgr_.spawn (ACE_Log_Msg_Mapped_File::run_svc,
+                            this,
+                            THR_NEW_LWP | THR_JOINABLE) == -1)
+    {
+      this->recycle (first, true);
+      if (spare != 0)
+        this->recycle (spare, true);
+      return -1;
+    }
+
+  this->running_ = true;
+  this->open_ = true;
+  this->spare_ = spare;
+  this->begin (first);
+  this->publish (first);
+  return 0;
+}
+
+int
+ACE_Log_Msg_Mapped_File::reset (void)
+{
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+
+  if (this->running_)
+    {
+      this->sync_ = true;
+      this->work_.signal ();
+    }
+  return 0;
+}
+
+int
+ACE_Log_Msg_Mapped_File::close (void)
+{
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+
+    if (!this->running_)
+      return 0;
+
+    // No segment is switched to from now on.
+    this->open_ = false;
+  }
+
+  this->close_current ();
+
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+    this->stop_ = true;
+    this->work_.signal ();
+  }
+
+  int const result = this->thr_mgr_.wait ();
+
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, -1);
+  this->running_ = false;
+  return result;
+}
+
+ssize_t
+ACE_Log_Msg_Mapped_File::log (ACE_Log_Record &log_record)
+{
+  ACE_Log_Msg *log_msg = ACE_LOG_MSG;
+  char text[ACE_Log_Record::MAXVERBOSELOGMSGLEN];
+
+#if defined (ACE_USES_WCHAR)
+  ACE_TCHAR verbose[ACE_Log_Record::MAXVERBOSELOGMSGLEN];
+  if (log_record.format_msg (log_msg->local_host (),
+                             log_msg->flags (),
+                             verbose) != 0)
+    return -1;
+  ACE_OS::strsncpy (text, ACE_TEXT_ALWAYS_CHAR (verbose), sizeof text);
+#else
+  if (log_record.format_msg (log_msg->local_host (),
+                             log_msg->flags (),
+                             text) != 0)
+    return -1;
+#endif /* ACE_USES_WCHAR */
+
+  size_t const length = ACE_OS::strlen (text);
+  if (length == 0)
+    return 0;
+
+  ACE_Time_Value const stamp = log_record.time_stamp ();
+
+  for (;;)
+    {
+      Segment *segment = this->enter ();
+      if (segment == 0)
+        {
+          ++this->dropped_;
+          return -1;
+        }
+
+      size_t const offset = this->reserve (segment, length);
+      if (offset + length <= this->capacity_)
+        {
+          ACE_OS::memcpy (segment->data_ + offset, text, length);
+
+          // The record is the one holding the bytes at the multiples
+          // of the index interval it covers.
+          for (size_t i = (offset + ACE_DEFAULT_LOG_SEGMENT_INDEX_INTERVAL - 1)
+                 / ACE_DEFAULT_LOG_SEGMENT_INDEX_INTERVAL;
+               i * ACE_DEFAULT_LOG_SEGMENT_INDEX_INTERVAL < offset + length;
+               ++i)
+            {
+              Index_Entry &entry = segment->index_[i];
+              entry.offset_ = offset;
+              entry.sec_ = static_cast<ACE_UINT64> (stamp.sec ());
+              entry.usec_ = static_cast<ACE_UINT32> (stamp.usec ());
+            }
+
+          this->leave (segment);
+          return 0;
+        }
+
+      // The record doesn't fit.  The thread which filled the segment
+      // switches to the next one, and the others wait for it.
+      if (offset <= this->capacity_)
+        this->switch_from (segment, offset);
+
+      this->leave (segment);
+      this->wait_switch (segment);
+    }
+}
+
+int
+ACE_Log_Msg_Mapped_File::rotate (void)
+{
+  Segment *segment = this->enter ();
+  if (segment == 0)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  // Fill the segment, unless another thread did.
+  size_t const offset = this->reserve (segment, this->capacity_ + 1);
+  if (offset <= this->capacity_)
+    this->switch_from (segment, offset);
+
+  this->leave (segment);
+  return 0;
+}
+
+ACE_UINT64
+ACE_Log_Msg_Mapped_File::segment (void) const
+{
+  Segment *segment = this->current_;
+  return segment == 0 ? 0 : segment->sequence_;
+}
+
+unsigned long
+ACE_Log_Msg_Mapped_File::dropped (void) const
+{
+  return this->dropped_.value ();
+}
+
+int
+ACE_Log_Msg_Mapped_File::find (const ACE_TCHAR *path,
+                               const ACE_Time_Value &time,
+                               ACE_OFF_T &offset)
+{
+  ACE_HANDLE handle = ACE_OS::open (path, O_RDONLY);
+  if (handle == ACE_INVALID_HANDLE)
+    return -1;
+
+  ACE_OFF_T const size = ACE_OS::filesize (handle);
+
+  Header header;
+  Trailer trailer;
+  if (size < static_cast<ACE_OFF_T> (sizeof header + sizeof trailer)
+      || ACE_OS::pread (handle, &header, sizeof header, 0)
+           != static_cast<ssize_t> (sizeof header)
+      || ACE_OS::pread (handle,
+                        &trailer,
+                        sizeof trailer,
+                        size - sizeof trailer)
+           != static_cast<ssize_t> (sizeof trailer)
+      || ACE_OS::memcmp (header.magic_,
+                         ACE_LOG_SEGMENT_MAGIC,
+                         sizeof header.magic_) != 0
+      || header.byte_order_ != ACE_LOG_SEGMENT_BYTE_ORDER
+      || ACE_OS::memcmp (trailer.magic_,
+                         ACE_LOG_SEGMENT_INDEX_MAGIC,
+                         sizeof trailer.magic_) != 0
+      || static_cast<ACE_UINT64> (size)
+           != header.header_size_ + trailer.used_
+              + trailer.entries_ * sizeof (Index_Entry) + sizeof trailer)
+    {
+      ACE_OS::close (handle);
+      errno = EINVAL;
+      return -1;
+    }
+
+  size_t const entries = static_cast<size_t> (trailer.entries_);
+  Index_Entry *index = 0;
+  ACE_NEW_NORETURN (index, Index_Entry[entries > 0 ? entries : 1]);
+  if (index == 0)
+    {
+      ACE_OS::close (handle);
+      return -1;
+    }
+
+  ssize_t const index_size =
+    static_cast<ssize_t> (entries * sizeof (Index_Entry));
+  if (ACE_OS::pread (handle,
+                     index,
+                     index_size,
+                     header.header_size_ + trailer.used_) != index_size)
+    {
+      delete [] index;
+      ACE_OS::close (handle);
+      return -1;
+    }
+  ACE_OS::close (handle);
+
+  // Find the last entry before <time>; the records logged by several
+  // threads at once may be a little out of order.
+  ACE_UINT64 const sec = static_cast<ACE_UINT64> (time.sec ());
+  ACE_UINT32 const usec = static_cast<ACE_UINT32> (time.usec ());
+  size_t low = 0;
+  size_t high = entries;
+  while (low < high)
+    {
+      size_t const middle = low + (high - low) / 2;
+      Index_Entry const &entry = index[middle];
+      if (entry.sec_ < sec || (entry.sec_ == sec && entry.usec_ < usec))
+        low = middle + 1;
+      else
+        high = middle;
+    }
+
+  ACE_UINT64 start = 0;
+  if (low > 0)
+    start = index[low - 1].offset_;
+  delete [] index;
+
+  offset = static_cast<ACE_OFF_T> (header.header_size_ + start);
+  return 0;
+}
+
+// Return the current segment, counted as used by the calling thread
+// until leave(), or 0 if closed.  The segment is not finished while
+// in use; since the structures are only reused, the count of a
+// structure which stopped being current before it was counted is
+// just taken back.
+
+ACE_Log_Msg_Mapped_File::Segment *
+ACE_Log_Msg_Mapped_File::enter (void)
+{
+#if defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1)
+  for (;;)
+    {
+      Segment *segment = this->current_;
+      __sync_synchronize ();
+      if (segment == 0)
+        return 0;
+
+      __sync_fetch_and_add (&segment->users_, 1);
+      if (this->current_ == segment)
+        return segment;
+      __sync_fetch_and_sub (&segment->users_, 1);
+    }
+#else
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->cursor_lock_, 0);
+
+  Segment *segment = this->current_;
+  if (segment != 0)
+    ++segment->users_;
+  return segment;
+#endif /* ACE_HAS_GCC_ATOMIC_BUILTINS */
+}
+
+// Stop counting <segment> as used by the calling thread.
+
+void
+ACE_Log_Msg_Mapped_File::leave (Segment *segment)
+{
+#if defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1)
+  __sync_fetch_and_sub (&segment->users_, 1);
+#else
+  ACE_GUARD (ACE_Thread_Mutex, guard, this->cursor_lock_);
+  --segment->users_;
+#endif /* ACE_HAS_GCC_ATOMIC_BUILTINS */
+}
+
+// Move the cursor of <segment> by <length> bytes, returning where it
+// was.
+
+size_t
+ACE_Log_Msg_Mapped_File::reserve (Segment *segment, size_t length)
+{
+#if defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1)
+  return __sync_fetch_and_add (&segment->reserved_, length);
+#else
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->cursor_lock_, 0);
+  size_t const offset = segment->reserved_;
+  segment->reserved_ += length;
+  return offset;
+#endif /* ACE_HAS_GCC_ATOMIC_BUILTINS */
+}
+
+// Number of threads using <segment>.
+
+long
+ACE_Log_Msg_Mapped_File::users (Segment *segment)
+{
+#if defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1)
+  long const users = segment->users_;
+  __sync_synchronize ();
+  return users;
+#else
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->cursor_lock_, 0);
+  return segment->users_;
+#endif /* ACE_HAS_GCC_ATOMIC_BUILTINS */
+}
+
+// Make <segment> the current one, 0 for none, and wake up the
+// threads waiting for the switch.  Called with <lock_> held.
+
+void
+ACE_Log_Msg_Mapped_File::publish (Segment *segment)
+{
+#if defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1)
+  __sync_synchronize ();
+  this->current_ = segment;
+  __sync_synchronize ();
+#else
+  {
+    ACE_GUARD (ACE_Thread_Mutex, guard, this->cursor_lock_);
+    this->current_ = segment;
+  }
+#endif /* ACE_HAS_GCC_ATOMIC_BUILTINS */
+
+  this->switched_.broadcast ();
+}
+
+// Called by the thread which moved the cursor of the current segment
+// <segment> past its capacity, from <used>: switch to the spare
+// segment, creating it if the thread of the backend hasn't yet, and
+// hand <segment> to that thread to be finished.  The segment the
+// thread is creating is waited for rather than another one created,
+// so that the segments are switched to in the order of their
+// numbers.
+
+void
+ACE_Log_Msg_Mapped_File::switch_from (Segment *segment, size_t used)
+{
+  segment->used_ = used;
+
+  Segment *next = 0;
+  bool open = false;
+  bool create = false;
+  {
+    ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+
+    while (this->open_ && this->spare_ == 0 && this->creating_)
+      this->switched_.wait ();
+
+    open = this->open_;
+    if (open)
+      {
+        next = this->spare_;
+        this->spare_ = 0;
+        create = next == 0;
+        if (create)
+          this->creating_ = true;
+      }
+  }
+
+  if (create)
+    next = this->create ();
+
+  ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+
+  if (create)
+    this->creating_ = false;
+
+  if (next != 0 && !this->open_)
+    {
+      this->recycle (next, true);
+      next = 0;
+    }
+
+  if (next != 0)
+    this->begin (next);
+
+  // Without a segment, records are dropped until the thread of the
+  // backend manages to create one.
+  this->publish (next);
+
+  Segment **tail = &this->full_;
+  while (*tail != 0)
+    tail = &(*tail)->next_;
+  segment->next_ = 0;
+  *tail = segment;
+
+  this->work_.signal ();
+}
+
+// Block until <segment> is no longer the current segment.  The
+// thread which filled it switches as soon as it has taken the spare
+// segment, so the wait is short; it is bounded all the same, the
+// callers checking again afterwards.
+
+void
+ACE_Log_Msg_Mapped_File::wait_switch (Segment *segment)
+{
+  ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+
+  if (this->current_ != segment)
+    return;
+
+  ACE_Time_Value const deadline =
+    ACE_OS::gettimeofday () + ACE_Time_Value (0, 100000);
+  while (this->current_ == segment)
+    if (this->switched_.wait (&deadline) == -1)
+      break;
+}
+
+// Hand the current segment to the thread to be finished, once the
+// backend no longer switches segments.
+
+void
+ACE_Log_Msg_Mapped_File::close_current (void)
+{
+  for (;;)
+    {
+      Segment *segment = this->enter ();
+      if (segment == 0)
+        return;
+
+      size_t const offset = this->reserve (segment, this->capacity_ + 1);
+      if (offset <= this->capacity_)
+        this->switch_from (segment, offset);
+
+      this->leave (segment);
+      this->wait_switch (segment);
+    }
+}
+
+static int
+ace_log_segment_compare (const void *a, const void *b)
+{
+  ACE_UINT64 const x = *static_cast<const ACE_UINT64 *> (a);
+  ACE_UINT64 const y = *static_cast<const ACE_UINT64 *> (b);
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// Number the segments after the highest one already there and, if
+// their number is limited, count those as finished, oldest first.
+// Called with <lock_> held.
+
+int
+ACE_Log_Msg_Mapped_File::scan (void)
+{
+  ACE_TCHAR dir[MAXPATHLEN + 1];
+  ACE_OS::strsncpy (dir, this->path_, MAXPATHLEN + 1);
+
+  const ACE_TCHAR *name = this->path_;
+  ACE_TCHAR *separator = ACE_OS::strrchr (dir, ACE_DIRECTORY_SEPARATOR_CHAR);
+  if (separator == 0)
+    ACE_OS::strcpy (dir, ACE_TEXT ("."));
+  else
+    {
+      name = this->path_ + (separator - dir) + 1;
+      separator[separator == dir ? 1 : 0] = 0;
+    }
+
+  ACE_Dirent directory;
+  if (directory.open (dir) == -1)
+    return -1;
+
+  size_t const length = ACE_OS::strlen (name);
+  ACE_Array_Base<ACE_UINT64> found;
+  size_t count = 0;
+
+  for (ACE_DIRENT *entry = directory.read ();
+       entry != 0;
+       entry = directory.read ())
+    {
+      const ACE_TCHAR *p = entry->d_name;
+      if (ACE_OS::strncmp (p, name, length) != 0 || p[length] != '.')
+        continue;
+
+      p += length + 1;
+      ACE_UINT64 sequence = 0;
+      for (; *p >= '0' && *p <= '9'; ++p)
+        sequence = sequence * 10 + static_cast<ACE_UINT64> (*p - '0');
+      if (*p != 0 || p == entry->d_name + length + 1 || sequence == 0)
+        continue;
+
+      if (sequence >= this->next_sequence_)
+        this->next_sequence_ = sequence + 1;
+
+      if (this->max_segments_ != 0)
+        {
+          if (count == found.size () && found.size (2 * count + 16) == -1)
+            return -1;
+          found[count++] = sequence;
+        }
+    }
+
+  this->finished_.reset ();
+  if (count > 0)
+    {
+      ACE_OS::qsort (&found[0],
+                     count,
+                     sizeof (ACE_UINT64),
+                     ace_log_segment_compare);
+      for (size_t i = 0; i < count; ++i)
+        this->finished_.enqueue_tail (found[i]);
+    }
+  return 0;
+}
+
+// Create and map the next segment, or return 0.
+
+ACE_Log_Msg_Mapped_File::Segment *
+ACE_Log_Msg_Mapped_File::create (void)
+{
+  Segment *segment = 0;
+  ACE_UINT64 sequence = 0;
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, 0);
+    sequence = this->next_sequence_++;
+    if (this->free_ != 0)
+      {
+        segment = this->free_;
+        this->free_ = segment->next_;
+      }
+  }
+
+  if (segment == 0)
+    {
+      ACE_NEW_RETURN (segment, Segment, 0);
+      ACE_NEW_NORETURN (segment->index_, Index_Entry[this->index_size_]);
+      if (segment->index_ == 0)
+        {
+          delete segment;
+          return 0;
+        }
+      segment->users_ = 0;
+    }
+
+  segment->sequence_ = sequence;
+  segment->handle_ = ACE_INVALID_HANDLE;
+  segment->base_ = 0;
+  segment->data_ = 0;
+  segment->reserved_ = 0;
+  segment->used_ = 0;
+  segment->next_ = 0;
+  ACE_OS::memset (segment->index_,
+                  0,
+                  this->index_size_ * sizeof (Index_Entry));
+
+  ACE_OS::sprintf (segment->path_,
+                   ACE_TEXT ("%s.%06lu"),
+                   this->path_,
+                   static_cast<unsigned long> (sequence));
+
+  size_t const size = sizeof (Header) + this->capacity_;
+  segment->handle_ = ACE_OS::open (segment->path_,
+                                   O_RDWR | O_CREAT | O_TRUNC,
+                                   ACE_DEFAULT_FILE_PERMS);
+  if (segment->handle_ != ACE_INVALID_HANDLE
+      && ACE_OS::ftruncate (segment->handle_,
+                            static_cast<ACE_OFF_T> (size)) == 0)
+    {
+      void *base = ACE_OS::mmap (0,
+                                 size,
+                                 PROT_RDWR,
+                                 MAP_SHARED,
+                                 segment->handle_,
+                                 0);
+      if (base != MAP_FAILED)
+        segment->base_ = static_cast<char *> (base);
+    }
+
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, guard, this->lock_, 0);
+
+  if (segment->base_ == 0)
+    {
+      this->recycle (segment, segment->handle_ != ACE_INVALID_HANDLE);
+      return 0;
+    }
+
+  segment->data_ = segment->base_ + sizeof (Header);
+
+  Header *header = reinterpret_cast<Header *> (segment->base_);
+  ACE_OS::memcpy (header->magic_,
+                  ACE_LOG_SEGMENT_MAGIC,
+                  sizeof header->magic_);
+  header->byte_order_ = ACE_LOG_SEGMENT_BYTE_ORDER;
+  header->header_size_ = sizeof (Header);
+  header->sequence_ = sequence;
+  header->index_interval_ = ACE_DEFAULT_LOG_SEGMENT_INDEX_INTERVAL;
+  return segment;
+}
+
+// Stamp <segment>, which is about to become the current segment.
+
+void
+ACE_Log_Msg_Mapped_File::begin (Segment *segment)
+{
+  segment->opened_ = ACE_OS::gettimeofday ();
+
+  Header *header = reinterpret_cast<Header *> (segment->base_);
+  header->sec_ = static_cast<ACE_UINT64> (segment->opened_.sec ());
+  header->usec_ = static_cast<ACE_UINT32> (segment->opened_.usec ());
+}
+
+// Wait until no thread writes to the full <segment>, then unmap it,
+// cut it to its records, append the index and the trailer, and sync
+// it to disk.
+
+void
+ACE_Log_Msg_Mapped_File::finish (Segment *segment)
+{
+  while (this->users (segment) != 0)
+    ACE_OS::thr_yield ();
+
+  size_t const used = segment->used_;
+  ACE_OS::munmap (segment->base_, sizeof (Header) + this->capacity_);
+  segment->base_ = 0;
+
+  size_t const entries =
+    (used + ACE_DEFAULT_LOG_SEGMENT_INDEX_INTERVAL - 1)
+    / ACE_DEFAULT_LOG_SEGMENT_INDEX_INTERVAL;
+
+  Trailer trailer;
+  trailer.used_ = used;
+  trailer.entries_ = entries;
+  ACE_OS::memcpy (trailer.magic_,
+                  ACE_LOG_SEGMENT_INDEX_MAGIC,
+                  sizeof trailer.magic_);
+
+  ACE_OFF_T const end = static_cast<ACE_OFF_T> (sizeof (Header) + used);
+  size_t const index_size = entries * sizeof (Index_Entry);
+  if (ACE_OS::ftruncate (segment->handle_, end) == -1
+      || ACE_OS::pwrite (segment->handle_,
+                         segment->index_,
+                         index_size,
+                         end) != static_cast<ssize_t> (index_size)
+      || ACE_OS::pwrite (segment->handle_,
+                         &trailer,
+                         sizeof trailer,
+                         end + index_size)
+           != static_cast<ssize_t> (sizeof trailer)
+      || ACE_OS::fsync (segment->handle_) == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("ACE_Log_Msg_Mapped_File: %p\n"),
+                   segment->path_));
+
+  ACE_UINT64 const sequence = segment->sequence_;
+
+  ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+
+  this->recycle (segment, false);
+  this->prune (sequence);
+}
+
+// Count the segment <sequence> as finished, and remove the oldest
+// finished segments beyond <max_segments_>, whatever their numbers.
+// Called with <lock_> held.
+
+void
+ACE_Log_Msg_Mapped_File::prune (ACE_UINT64 sequence)
+{
+  if (this->max_segments_ == 0)
+    return;
+
+  this->finished_.enqueue_tail (sequence);
+
+  ACE_UINT64 oldest = 0;
+  while (this->finished_.size () > this->max_segments_
+         && this->finished_.dequeue_head (oldest) == 0)
+    {
+      ACE_TCHAR path[MAXPATHLEN + 1];
+      ACE_OS::sprintf (path,
+                       ACE_TEXT ("%s.%06lu"),
+                       this->path_,
+                       static_cast<unsigned long> (oldest));
+      ACE_OS::unlink (path);
+    }
+}
+
+// Unmap and close <segment> if needed, remove its file if <unlink>,
+// and keep the structure for reuse.  Called with <lock_> held.
+
+void
+ACE_Log_Msg_Mapped_File::recycle (Segment *segment, bool unlink)
+{
+  if (segment->base_ != 0)
+    {
+      ACE_OS::munmap (segment->base_, sizeof (Header) + this->capacity_);
+      segment->base_ = 0;
+    }
+
+  if (segment->handle_ != ACE_INVALID_HANDLE)
+    {
+      ACE_OS::close (segment->handle_);
+      segment->handle_ = ACE_INVALID_HANDLE;
+    }
+
+  if (unlink)
+    ACE_OS::unlink (segment->path_);
+
+  segment->next_ = this->free_;
+  this->free_ = segment;
+}
+
+// Schedule the written part of the current segment to be written to
+// disk.
+
+void
+ACE_Log_Msg_Mapped_File::sync (void)
+{
+  Segment *segment = this->enter ();
+  if (segment == 0)
+    return;
+
+  size_t written = segment->reserved_;
+  if (written > this->capacity_)
+    written = this->capacity_;
+
+  ACE_OS::msync (segment->base_, sizeof (Header) + written, MS_ASYNC);
+  this->leave (segment);
+}
+
+ACE_THR_FUNC_RETURN
+ACE_Log_Msg_Mapped_File::run_svc (void *arg)
+{
+  static_cast<ACE_Log_Msg_Mapped_File *> (arg)->svc ();
+  return 0;
+}
+
+void
+ACE_Log_Msg_Mapped_File::svc (void)
+{
+  ACE_GUARD (ACE_Thread_Mutex, guard, this->lock_);
+
+  for (;;)
+    {
+      // Have the next segment ready before it is needed, even
+      // before finishing the full ones.
+      if (this->spare_ == 0 && this->open_ && !this->creating_)
+        {
+          this->creating_ = true;
+          ACE_MT (guard.release ());
+          Segment *segment = this->create ();
+          ACE_MT (guard.acquire ());
+          this->creating_ = false;
+
+          if (segment != 0)
+            {
+              if (this->spare_ == 0 && this->open_)
+                this->spare_ = segment;
+              else
+                this->recycle (segment, true);
+            }
+
+          this->switched_.broadcast ();
+          if (segment != 0)
+            continue;
+        }
+
+      if (this->full_ != 0)
+        {
+          Segment *segment = this->full_;
+          this->full_ = segment->next_;
+
+          ACE_MT (guard.release ());
+          this->finish (segment);
+          ACE_MT (guard.acquire ());
+          continue;
+        }
+
+      if (this->stop_)
+        break;
+
+      // Switch to the spare segment if a writer couldn't create one.
+      if (this->current_ == 0 && this->spare_ != 0 && this->open_)
+        {
+          Segment *segment = this->spare_;
+          this->spare_ = 0;
+          this->begin (segment);
+          this->publish (segment);
+          continue;
+        }
+
+      ACE_Time_Value const now = ACE_OS::gettimeofday ();
+      ACE_Time_Value deadline = now + ACE_Time_Value (1);
+
+      Segment *current = this->current_;
+      if (current != 0 && this->max_age_ != ACE_Time_Value::zero)
+        {
+          ACE_Time_Value const expiry = current->opened_ + this->max_age_;
+          if (expiry <= now && current->reserved_ != 0)
+            {
+              ACE_MT (guard.release ());
+              this->rotate ();
+              ACE_MT (guard.acquire ());
+              continue;
+            }
+          if (expiry < deadline)
+            deadline = expiry;
+        }
+
+      if (!this->sync_)
+        this->work_.wait (&deadline);
+
+      this->sync_ = false;
+      ACE_MT (guard.release ());
+      this->sync ();
+      ACE_MT (guard.acquire ());
+    }
+
+  if (this->spare_ != 0)
+    {
+      this->recycle (this->spare_, true);
+      this->spare_ = 0;
+    }
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_THREADS && !ACE_LACKS_MMAP */
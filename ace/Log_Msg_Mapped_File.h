@@ -0,0 +1,294 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Log_Msg_Mapped_File.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+#ifndef ACE_LOG_MSG_MAPPED_FILE_H
+#define ACE_LOG_MSG_MAPPED_FILE_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Log_Msg_Backend.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_THREADS) && !defined (ACE_LACKS_MMAP)
+
+#include "ace/Basic_Types.h"
+#include "ace/Time_Value.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Condition_Thread_Mutex.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Unbounded_Queue.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Log_Msg_Mapped_File
+ *
+ * @brief Implements an ACE_Log_Msg_Backend writing the log records,
+ * formatted as ACE_Log_Msg::STDERR would, into a series of
+ * memory-mapped files of a fixed size, the segments.
+ *
+ * Each segment is created at its full size and mapped before it is
+ * needed.  log() formats the record, reserves room for it in the
+ * current segment by moving the append cursor of the segment with an
+ * atomic add, and copies it there, so threads logging at the same
+ * time only contend on the cursor.  The thread whose record does not
+ * fit switches to the next segment, which is ready by then, and the
+ * others block until it has; no other system call is made on the
+ * logging path.
+ *
+ * A thread of the backend prepares the next segment, msync()s the
+ * current one every second, and finishes the full ones once their
+ * last writer is done: it unmaps them, cuts them to the size of
+ * their records, appends the index footer, and fsync()s them.  It
+ * also switches to a new segment once the current one is older than
+ * the maximum age, if any, and removes the oldest segments beyond
+ * the maximum number, if any, those left by earlier runs included.
+ *
+ * Segment number n of a backend writing to @c path is called
+ * @c path.n, with n zero padded to 6 digits, starting above the
+ * highest segment already there.  A segment is a Header, the formatted log
+ * records, then, once it is finished, one Index_Entry for every
+ * ACE_DEFAULT_LOG_SEGMENT_INDEX_INTERVAL bytes of records and a
+ * Trailer, in the byte order of the host.  The entry i gives the
+ * start and time of the record holding byte i times the interval, so
+ * tools can seek to a time with find() rather than read the whole
+ * segment.  The display_segment client of netsvcs/clients/Logger
+ * prints a segment from a given time that way.
+ *
+ * ACE_Log_Msg serializes its calls to log(); the cursor pays off when
+ * the backend is called directly, or through ACE_Log_Msg_Async.
+ * Records are not logged while the backend is closed, and it must not
+ * be closed while a thread is in log().  Use it with
+ * ACE_Log_Msg::msg_backend() and the ACE_Log_Msg::CUSTOM flag, or
+ * with the -M option of ACE_Logging_Strategy.
+ */
+class ACE_Export ACE_Log_Msg_Mapped_File : public ACE_Log_Msg_Backend
+{
+public:
+  /// Start of a segment.
+  struct Header
+  {
+    /// "ACELOGSG".
+    char magic_[8];
+    /// 0x01020304, as stored by the host which wrote the segment.
+    ACE_UINT32 byte_order_;
+    /// Size of this header; the records follow it.
+    ACE_UINT32 header_size_;
+    /// Number of the segment.
+    ACE_UINT64 sequence_;
+    /// Time the segment became the current one.
+    ACE_UINT64 sec_;
+    ACE_UINT32 usec_;
+    /// Bytes of records between two entries of the index.
+    ACE_UINT32 index_interval_;
+  };
+
+  /// Entry of the index of a finished segment.
+  struct Index_Entry
+  {
+    /// Offset of the record, from the end of the header.
+    ACE_UINT64 offset_;
+    /// Time stamp of the record.
+    ACE_UINT64 sec_;
+    ACE_UINT32 usec_;
+    ACE_UINT32 reserved_;
+  };
+
+  /// End of a finished segment, after the index.
+  struct Trailer
+  {
+    /// Bytes of records.
+    ACE_UINT64 used_;
+    /// Entries in the index.
+    ACE_UINT64 entries_;
+    /// "ACELOGIX".
+    char magic_[8];
+  };
+
+  /**
+   * Write segments named after @a path, each holding up to
+   * @a segment_size bytes of records.  If @a max_age is not zero, a
+   * segment holding records is finished once that old.  If
+   * @a max_segments is not zero, only the last @a max_segments
+   * finished segments are kept, counting those already there when
+   * the backend is opened.
+   */
+  ACE_Log_Msg_Mapped_File (
+    const ACE_TCHAR *path,
+    size_t segment_size = ACE_DEFAULT_LOG_SEGMENT_SIZE,
+    const ACE_Time_Value &max_age = ACE_Time_Value::zero,
+    size_t max_segments = 0);
+
+  /// Finishes the current segment.
+  virtual ~ACE_Log_Msg_Mapped_File (void);
+
+  /// Map the first segment and start the thread, unless already
+  /// open.  @a logger_key is ignored.
+  virtual int open (const ACE_TCHAR *logger_key);
+
+  /// Schedule an msync() of the current segment.
+  virtual int reset (void);
+
+  /// Finish the current segment, and stop the thread once the full
+  /// segments are finished.  The next open() starts a new segment.
+  virtual int close (void);
+
+  /// Append @a log_record to the current segment.  Returns 0, or -1
+  /// if the record was dropped.
+  virtual ssize_t log (ACE_Log_Record &log_record);
+
+  /// Switch to a new segment now.
+  int rotate (void);
+
+  /// Number of the current segment, 0 if closed.
+  ACE_UINT64 segment (void) const;
+
+  /// Number of records dropped, because the backend was closed or a
+  /// segment could not be created.
+  unsigned long dropped (void) const;
+
+  /**
+   * Set @a offset to the start of a record of the finished segment
+   * @a path from which the records are logged at @a time or later,
+   * so a reader only has to skip the records before @a time from
+   * there.  Fails with @c errno EINVAL if @a path is not a finished
+   * segment of this host.
+   */
+  static int find (const ACE_TCHAR *path,
+                   const ACE_Time_Value &time,
+                   ACE_OFF_T &offset);
+
+private:
+  /// A segment, mapped while it is current or full; the structures
+  /// are reused rather than deleted while the backend is open.
+  struct Segment
+  {
+    ACE_UINT64 sequence_;
+    ACE_TCHAR path_[MAXPATHLEN + 1];
+    ACE_HANDLE handle_;
+
+    /// The mapping: the header, then <data_>.
+    char *base_;
+    char *data_;
+
+    /// Append cursor; moves past the capacity once the segment is
+    /// full.
+    volatile size_t reserved_;
+
+    /// Bytes of records, once the segment is full.
+    size_t used_;
+
+    /// Threads using the structure, see enter().
+    volatile long users_;
+
+    /// Index, filled in by the writers.
+    Index_Entry *index_;
+
+    ACE_Time_Value opened_;
+
+    /// Next in the list of full or free structures.
+    Segment *next_;
+  };
+
+  // The following are documented in the .cpp file.
+  Segment *enter (void);
+  void leave (Segment *segment);
+  size_t reserve (Segment *segment, size_t length);
+  long users (Segment *segment);
+  void publish (Segment *segment);
+  void switch_from (Segment *segment, size_t used);
+  void wait_switch (Segment *segment);
+  void close_current (void);
+  int scan (void);
+  Segment *create (void);
+  void begin (Segment *segment);
+  void finish (Segment *segment);
+  void prune (ACE_UINT64 sequence);
+  void recycle (Segment *segment, bool unlink);
+  void sync (void);
+
+  /// Entry point of the thread.
+  static ACE_THR_FUNC_RETURN run_svc (void *arg);
+  void svc (void);
+
+  /// Base name of the segments.
+  ACE_TCHAR path_[MAXPATHLEN + 1];
+
+  /// Bytes of records a segment holds.
+  size_t capacity_;
+
+  /// Entries in the index of a full segment.
+  size_t index_size_;
+
+  ACE_Time_Value max_age_;
+  size_t max_segments_;
+
+  /// The segment the records go to, 0 if closed.
+  Segment * volatile current_;
+
+  /// The next segment, if ready.
+  Segment *spare_;
+
+  /// Full segments to be finished, and structures to be reused.
+  Segment *full_;
+  Segment *free_;
+
+  /// Number of the next segment created.
+  ACE_UINT64 next_sequence_;
+
+  /// Numbers of the finished segments still there, oldest first,
+  /// when their number is limited.
+  ACE_Unbounded_Queue<ACE_UINT64> finished_;
+
+  /// Set while the backend is open.
+  bool open_;
+
+  /// Whether the thread must exit once the full segments are done.
+  bool stop_;
+
+  /// Whether the thread is to msync() the current segment at once.
+  bool sync_;
+
+  /// Whether the thread runs.
+  bool running_;
+
+  /// Whether the next segment is being created.
+  bool creating_;
+
+#if !defined (ACE_HAS_GCC_ATOMIC_BUILTINS) || (ACE_HAS_GCC_ATOMIC_BUILTINS == 0)
+  /// Serializes the cursors and the user counts.
+  ACE_Thread_Mutex cursor_lock_;
+#endif /* !ACE_HAS_GCC_ATOMIC_BUILTINS */
+
+  /// Serializes the lists, the sequence and the state, and the waits
+  /// of the thread.
+  ACE_Thread_Mutex lock_;
+  ACE_Condition_Thread_Mutex work_;
+
+  /// Signalled when the current segment changes, or the next one is
+  /// created.
+  ACE_Condition_Thread_Mutex switched_;
+
+  ACE_Atomic_Op<ACE_Thread_Mutex, unsigned long> dropped_;
+
+  /// Manages the thread, of its own so that it can run while the
+  /// process exits.
+  ACE_Thread_Manager thr_mgr_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_THREADS && !ACE_LACKS_MMAP */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_LOG_MSG_MAPPED_FILE_H */
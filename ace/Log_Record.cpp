@@ -9,6 +9,7 @@
 #include "ace/Auto_Ptr.h"
 #include "ace/Truncate.h"
 #include "ace/Log_Category.h"
+#include "ace/Log_Binary.h"
 
 #if !defined (__ACE_INLINE__)
 # include "ace/Log_Record.inl"
@@ -63,6 +64,9 @@ namespace
       ACE_TEXT ("LM_UNK(010000000000)"),
       ACE_TEXT ("LM_UNK(020000000000)")
     };
+
+  // Set in the type sent in CDR streams when the message is encoded.
+  ACE_CDR::Long const ace_log_record_binary = 0x40000000;
 }
 
 const ACE_TCHAR *
@@ -116,6 +120,8 @@ ACE_Log_Record::dump (void) const
               this->msg_data_, this->msg_data_));
   ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\nmsg_data_size_ = %B\n"),
               this->msg_data_size_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\nmsg_binary_len_ = %B\n"),
+              this->msg_binary_len_));
   ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
 #endif /* ACE_HAS_DUMP */
 }
@@ -134,10 +140,51 @@ ACE_Log_Record::msg_data (const ACE_TCHAR *data)
       this->msg_data_size_ = newlen;
     }
   ACE_OS::strcpy (this->msg_data_, data);
+  this->msg_binary_len_ = 0;
+  this->render_pending_ = false;
   this->round_up ();
   return 0;
 }
 
+int
+ACE_Log_Record::msg_binary (const char *data, size_t len)
+{
+  // ACE_TRACE ("ACE_Log_Record::msg_binary");
+  if (len > this->msg_binary_size_)
+    {
+      char *new_msg_binary = 0;
+      ACE_NEW_RETURN (new_msg_binary, char[len], -1);
+      delete [] this->msg_binary_;
+      this->msg_binary_ = new_msg_binary;
+      this->msg_binary_size_ = len;
+    }
+  ACE_OS::memcpy (this->msg_binary_, data, len);
+  this->msg_binary_len_ = len;
+  this->render_pending_ = len != 0;
+  if (this->msg_data_ != 0)
+    this->msg_data_[0] = '\0';
+
+  size_t const length = sizeof (*this) + len;
+  this->length_ =
+    static_cast<ACE_UINT32> ((length + ACE_Log_Record::ALIGN_WORDB - 1)
+                             & ~(ACE_Log_Record::ALIGN_WORDB - 1));
+  return 0;
+}
+
+void
+ACE_Log_Record::render (void)
+{
+  // ACE_TRACE ("ACE_Log_Record::render");
+  if (!this->render_pending_ || this->msg_data_ == 0)
+    return;
+
+  this->render_pending_ = false;
+  ACE_Log_Binary::render (this->msg_binary_,
+                          this->msg_binary_len_,
+                          this->msg_data_,
+                          this->msg_data_size_);
+}
+
 ACE_Log_Record::ACE_Log_Record (ACE_Log_Priority lp,
                                 time_t ts_sec,
                                 long p)
@@ -148,6 +195,10 @@ ACE_Log_Record::ACE_Log_Record (ACE_Log_Priority lp,
     pid_ (ACE_UINT32 (p)),
     msg_data_ (0),
     msg_data_size_ (0),
+    msg_binary_ (0),
+    msg_binary_len_ (0),
+    msg_binary_size_ (0),
+    render_pending_ (false),
     category_(0)
 {
   // ACE_TRACE ("ACE_Log_Record::ACE_Log_Record");
@@ -169,6 +220,10 @@ ACE_Log_Record::ACE_Log_Record (ACE_Log_Priority lp,
     pid_ (ACE_UINT32 (p)),
     msg_data_ (0),
     msg_data_size_ (0),
+    msg_binary_ (0),
+    msg_binary_len_ (0),
+    msg_binary_size_ (0),
+    render_pending_ (false),
     category_(0)
 {
   // ACE_TRACE ("ACE_Log_Record::ACE_Log_Record");
@@ -201,6 +256,10 @@ ACE_Log_Record::ACE_Log_Record (void)
     pid_ (0),
     msg_data_ (0),
     msg_data_size_ (0),
+    msg_binary_ (0),
+    msg_binary_len_ (0),
+    msg_binary_size_ (0),
+    render_pending_ (false),
     category_(0)
 {
   // ACE_TRACE ("ACE_Log_Record::ACE_Log_Record");
@@ -231,6 +290,8 @@ ACE_Log_Record::format_msg (const ACE_TCHAR host_name[],
   const ACE_TCHAR *verbose_lite_fmt = ACE_TEXT ("%ls@%ls@%ls");
 #endif
 
+  this->render ();
+
   if (ACE_BIT_ENABLED (verbose_flag,
                        ACE_Log_Msg::VERBOSE)
       || ACE_BIT_ENABLED (verbose_flag,
@@ -328,6 +389,24 @@ int
 operator<< (ACE_OutputCDR &cdr,
             const ACE_Log_Record &log_record)
 {
+  // An encoded message is sent as is, in octets, for the receiver to
+  // render.
+  if (log_record.msg_binary () != 0)
+    {
+      ACE_CDR::ULong const u_binlen =
+        ACE_Utils::truncate_cast<ACE_CDR::ULong> (log_record.msg_binary_len ());
+
+      cdr << ACE_CDR::Long (log_record.type () | ace_log_record_binary);
+      cdr << ACE_CDR::Long (log_record.pid ());
+      cdr << ACE_CDR::LongLong (log_record.time_stamp ().sec ());
+      cdr << ACE_CDR::Long (log_record.time_stamp ().usec ());
+      cdr << u_binlen;
+      cdr.write_octet_array
+        (reinterpret_cast<const ACE_CDR::Octet *> (log_record.msg_binary ()),
+         u_binlen);
+      return cdr.good_bit ();
+    }
+
   // The written message length can't be more than 32 bits (ACE_CDR::ULong)
   // so reduce it here if needed.
   ACE_CDR::ULong u_msglen =
@@ -359,7 +438,23 @@ operator>> (ACE_InputCDR &cdr,
 
   // Extract each field from input CDR stream into <log_record>.
   if ((cdr >> type) && (cdr >> pid) && (cdr >> sec) && (cdr >> usec)
-      && (cdr >> buffer_len)) {
+      && (cdr >> buffer_len)
+      && ACE_BIT_ENABLED (type, ace_log_record_binary)) {
+    // The message is encoded: keep it that way, it is rendered when
+    // it's needed.
+    char *log_msg;
+    ACE_NEW_RETURN (log_msg, char[buffer_len], -1);
+    ACE_Auto_Basic_Array_Ptr<char> log_msg_p (log_msg);
+    log_record.type (type & ~ace_log_record_binary);
+    log_record.pid (pid);
+    log_record.time_stamp (ACE_Time_Value (ACE_Utils::truncate_cast<time_t> (sec),
+                                           usec));
+    if (cdr.read_octet_array (reinterpret_cast<ACE_CDR::Octet *> (log_msg),
+                              buffer_len)
+        && -1 == log_record.msg_binary (log_msg, buffer_len))
+      return -1;
+  }
+  else if (cdr.good_bit ()) {
     ACE_TCHAR *log_msg;
     ACE_NEW_RETURN (log_msg, ACE_TCHAR[buffer_len + 1], -1);
     auto_ptr<ACE_TCHAR> log_msg_p (log_msg);
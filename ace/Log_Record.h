@@ -146,7 +146,8 @@ public:
   /// Set the process id of the Log_Record.
   void pid (long);
 
-  /// Get the message data of the Log_Record.
+  /// Get the message data of the Log_Record.  If the message is
+  /// encoded (see msg_binary()), it is rendered first.
   const ACE_TCHAR *msg_data (void) const;
 
   /// Set the message data of the record. If @a data is longer than the
@@ -158,6 +159,19 @@ public:
   /// a byte for the NUL.
   size_t msg_data_len (void) const;
 
+  /// Set the message of the record to the @a len bytes at @a data,
+  /// encoded by ACE_Log_Binary.  The text is only rendered by the
+  /// first call to msg_data(); the encoding is what is sent in CDR
+  /// streams.  Returns -1 if the encoding can't be copied, else 0.
+  int msg_binary (const char *data, size_t len);
+
+  /// Get the encoded message of the record, or 0 if its message was
+  /// set as text.
+  const char *msg_binary (void) const;
+
+  /// Get the size of the encoded message of the record.
+  size_t msg_binary_len (void) const;
+
   /// Dump the state of an object.
   void dump (void) const;
 
@@ -168,6 +182,9 @@ private:
   /// Round up to the alignment restrictions.
   void round_up (void);
 
+  /// Render the encoded message in <msg_data_>, if it wasn't yet.
+  void render (void);
+
   /**
    * Total length of the logging record in bytes.  This field *must*
    * come first in order for various IPC framing mechanisms to work
@@ -192,6 +209,14 @@ private:
   /// Allocated size of msg_data_ in ACE_TCHARs
   size_t msg_data_size_;
 
+  /// Encoded message, if any, its length and its allocated size.
+  char *msg_binary_;
+  size_t msg_binary_len_;
+  size_t msg_binary_size_;
+
+  /// Set while <msg_data_> doesn't hold the encoded message rendered.
+  bool render_pending_;
+
   ///
   ACE_Log_Category_TSS* category_;
 
@@ -14,6 +14,7 @@ ACE_Log_Record::~ACE_Log_Record (void)
 {
   if (this->msg_data_)
     delete [] this->msg_data_;
+  delete [] this->msg_binary_;
 }
 
 ACE_INLINE ACE_UINT32
@@ -92,6 +93,8 @@ ACE_INLINE const ACE_TCHAR *
 ACE_Log_Record::msg_data (void) const
 {
   ACE_TRACE ("ACE_Log_Record::msg_data");
+  if (this->render_pending_)
+    const_cast<ACE_Log_Record *> (this)->render ();
   return this->msg_data_;
 }
 
@@ -99,7 +102,21 @@ ACE_INLINE size_t
 ACE_Log_Record::msg_data_len (void) const
 {
   ACE_TRACE ("ACE_Log_Record::msg_data_len");
-  return ACE_OS::strlen (this->msg_data_) + 1;
+  return ACE_OS::strlen (this->msg_data ()) + 1;
+}
+
+ACE_INLINE const char *
+ACE_Log_Record::msg_binary (void) const
+{
+  ACE_TRACE ("ACE_Log_Record::msg_binary");
+  return this->msg_binary_len_ == 0 ? 0 : this->msg_binary_;
+}
+
+ACE_INLINE size_t
+ACE_Log_Record::msg_binary_len (void) const
+{
+  ACE_TRACE ("ACE_Log_Record::msg_binary_len");
+  return this->msg_binary_len_;
 }
 
 ACE_END_VERSIONED_NAMESPACE_DECL
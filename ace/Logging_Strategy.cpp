@@ -11,6 +11,7 @@
 
 #include "ace/Lib_Find.h"
 #include "ace/Log_Category.h"
+#include "ace/Log_Msg_Mapped_File.h"
 #include "ace/Reactor.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_stdio.h"
@@ -128,6 +129,8 @@ ACE_Logging_Strategy::tokenize (ACE_TCHAR *flag_string)
         ACE_SET_BITS (this->flags_, ACE_Log_Msg::SILENT);
       else if (ACE_OS::strcmp (flag, ACE_TEXT ("SYSLOG")) == 0)
         ACE_SET_BITS (this->flags_, ACE_Log_Msg::SYSLOG);
+      else if (ACE_OS::strcmp (flag, ACE_TEXT ("BINARY")) == 0)
+        ACE_SET_BITS (this->flags_, ACE_Log_Msg::BINARY);
     }
 }
 
@@ -146,12 +149,13 @@ ACE_Logging_Strategy::parse_args (int argc, ACE_TCHAR *argv[])
   this->count_ = 0;
   this->fixed_number_ = false;
   this->order_files_ = false;
+  this->mapped_file_ = false;
   this->max_file_number_ = 1;
   this->interval_ = ACE_DEFAULT_LOGFILE_POLL_INTERVAL;
   this->max_size_ = 0;
 
   ACE_Get_Opt get_opt (argc, argv,
-                       ACE_TEXT ("f:i:k:m:n:N:op:s:t:w"), 0);
+                       ACE_TEXT ("f:i:k:m:Mn:N:op:s:t:w"), 0);
 
   for (int c; (c = get_opt ()) != -1; )
     {
@@ -183,6 +187,10 @@ ACE_Logging_Strategy::parse_args (int argc, ACE_TCHAR *argv[])
           this->max_size_ = ACE_OS::strtoul (get_opt.opt_arg (), 0, 10);
           this->max_size_ <<= 10;       // convert from KB to bytes.
           break;
+        case 'M':
+          // Write memory-mapped segments.
+          this->mapped_file_ = true;
+          break;
         case 'n':
           delete [] this->program_name_;
           this->program_name_ = ACE::strnew (get_opt.opt_arg ());
@@ -234,6 +242,9 @@ ACE_Logging_Strategy::ACE_Logging_Strategy (void)
     wipeout_logfile_ (false),
     fixed_number_ (false),
     order_files_ (false),
+    mapped_file_ (false),
+    mapped_backend_ (0),
+    previous_backend_ (0),
     count_ (0),
     max_file_number_ (1), // 2 files by default (max file number + 1)
     interval_ (ACE_DEFAULT_LOGFILE_POLL_INTERVAL),
@@ -268,6 +279,24 @@ ACE_Logging_Strategy::~ACE_Logging_Strategy (void)
   // This is allocated in constructor, so it must be deallocated in
   // the destructor!
   delete [] this->filename_;
+
+  this->close_mapped_backend ();
+}
+
+void
+ACE_Logging_Strategy::close_mapped_backend (void)
+{
+  if (this->mapped_backend_ == 0)
+    return;
+
+  if (this->previous_backend_ == 0)
+    this->log_msg_->clr_flags (ACE_Log_Msg::CUSTOM);
+  ACE_Log_Msg::msg_backend (this->previous_backend_);
+
+  this->mapped_backend_->close ();
+  delete this->mapped_backend_;
+  this->mapped_backend_ = 0;
+  this->previous_backend_ = 0;
 }
 
 int
@@ -283,6 +312,8 @@ ACE_Logging_Strategy::fini (void)
       && this->interval_ > 0 && this->max_size_ > 0)
     this->reactor ()->cancel_timer (this);
 
+  this->close_mapped_backend ();
+
   return 0;
 }
 
@@ -310,6 +341,40 @@ ACE_Logging_Strategy::init (int argc, ACE_TCHAR *argv[])
   this->log_msg_->priority_mask (process_priority_mask_,
                                  ACE_Log_Msg::PROCESS);
 
+  // Reconfiguration starts over with new segments.
+  this->close_mapped_backend ();
+
+  if (this->mapped_file_)
+    {
+#if defined (ACE_HAS_THREADS) && !defined (ACE_LACKS_MMAP)
+      // The segments replace the ostream, and are switched by the
+      // backend itself.
+      ACE_CLR_BITS (this->flags_, ACE_Log_Msg::OSTREAM);
+      ACE_SET_BITS (this->flags_, ACE_Log_Msg::CUSTOM);
+
+      size_t const segment_size =
+        this->max_size_ > 0 ? this->max_size_ : ACE_DEFAULT_LOG_SEGMENT_SIZE;
+      size_t const max_segments =
+        this->fixed_number_
+        ? static_cast<size_t> (this->max_file_number_ + 1)
+        : 0;
+
+      ACE_NEW_RETURN (this->mapped_backend_,
+                      ACE_Log_Msg_Mapped_File (this->filename_,
+                                               segment_size,
+                                               ACE_Time_Value (this->interval_),
+                                               max_segments),
+                      -1);
+      this->previous_backend_ =
+        ACE_Log_Msg::msg_backend (this->mapped_backend_);
+#else
+      ACELIB_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT ("Memory-mapped segments are not ")
+                            ACE_TEXT ("supported on this platform\n")),
+                           -1);
+#endif /* ACE_HAS_THREADS && !ACE_LACKS_MMAP */
+    }
+
   // Check if any flags were specified. If none were specified, let
   // the default behavior take effect.
   if (this->flags_ != 0)
@@ -398,6 +463,10 @@ int
 ACE_Logging_Strategy::handle_timeout (const ACE_Time_Value &,
                                       const void *)
 {
+  // The segments are switched by their backend.
+  if (this->mapped_backend_ != 0)
+    return 0;
+
 #if defined (ACE_LACKS_IOSTREAM_TOTALLY)
   if ((size_t) ACE_OS::ftell (this->log_msg_->msg_ostream ()) > this->max_size_)
 #else
@@ -27,6 +27,8 @@
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
+class ACE_Log_Msg_Backend;
+
 /**
  * @class ACE_Logging_Strategy
  *
@@ -61,6 +63,11 @@ ACE_BEGIN_VERSIONED_NAMESPACE_DECL
  * create a new log file, and don't rotate the others (fewer accesses
  * to disk)).
  *
+ * With the -M option, the records are written into memory-mapped
+ * segments of the logfile by an ACE_Log_Msg_Mapped_File instead, see
+ * parse_args().  No reactor is needed then: the segments are switched
+ * as they fill up or get older than the -i interval.
+ *
  * By default, the @c ACE_Logging_Strategy uses the singleton reactor,
  * i.e., what's returned by @c ACE_Reactor::instance().  If you want
  * to set the reactor used by @c ACE_Logging_Strategy to something
@@ -119,11 +126,14 @@ public:
   /**
    * Parse arguments provided in svc.conf file.
    * @arg '-f' Pass in the flags (such as OSTREAM, STDERR, LOGGER, VERBOSE,
-   *           SILENT, VERBOSE_LITE) used to control logging.
+   *           SILENT, VERBOSE_LITE, BINARY) used to control logging.
    * @arg '-i' The interval (in seconds) at which the logfile size is sampled
    *           (default is 0, i.e., do not sample by default).
    * @arg '-k' Set the logging key.
    * @arg '-m' Maximum logfile size in Kbytes.
+   * @arg '-M' Write the logfile as memory-mapped segments, named after
+   *           the -s filename, of -m Kbytes each and switched every -i
+   *           seconds, keeping the last -N of them.
    * @arg '-n' Set the program name for the %n format specifier.
    * @arg '-N' The maximum number of logfiles that we want created.
    * @arg '-o' Specifies that we want the no standard logfiles ordering
@@ -153,6 +163,10 @@ protected:
   void priorities (ACE_TCHAR *priority_string,
                    ACE_Log_Msg::MASK_TYPE mask);
 
+  /// Close and delete @c mapped_backend_, if any, and give
+  /// ACE_Log_Msg back its previous backend.
+  void close_mapped_backend (void);
+
   /// Current thread's priority mask set by @c priorities
   u_long thread_priority_mask_;
 
@@ -183,6 +197,16 @@ protected:
   /// is false, i.e., we do not rotate files by default.
   bool order_files_;
 
+  /// If true we write memory-mapped segments rather than use an
+  /// ostream.  Default value is false.
+  bool mapped_file_;
+
+  /// Backend writing the segments with -M.
+  ACE_Log_Msg_Backend *mapped_backend_;
+
+  /// Backend of ACE_Log_Msg before @c mapped_backend_.
+  ACE_Log_Msg_Backend *previous_backend_;
+
   /// This tells us in what file we last wrote. It will be increased
   /// to enable multiple log files
   int count_;
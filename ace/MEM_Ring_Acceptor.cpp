@@ -0,0 +1,138 @@
+// $Id$
+
+#include "ace/MEM_Ring_Acceptor.h"
+
+#if defined (ACE_HAS_MEM_RING_STREAM)
+
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_unistd.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_MEM_Ring_Acceptor)
+
+void
+ACE_MEM_Ring_Acceptor::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_MEM_Ring_Acceptor::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("ring_size_ = %B\n"), this->ring_size_));
+  ACE_LSOCK_Acceptor::dump ();
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_MEM_Ring_Acceptor::ACE_MEM_Ring_Acceptor (void)
+  : ring_size_ (ACE_DEFAULT_MEM_RING_SIZE)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Acceptor::ACE_MEM_Ring_Acceptor");
+}
+
+ACE_MEM_Ring_Acceptor::ACE_MEM_Ring_Acceptor (const ACE_UNIX_Addr &local_sap,
+                                              int reuse_addr,
+                                              int backlog)
+  : ring_size_ (ACE_DEFAULT_MEM_RING_SIZE)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Acceptor::ACE_MEM_Ring_Acceptor");
+
+  if (this->open (local_sap, reuse_addr, backlog) == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("%p\n"),
+                   ACE_TEXT ("ACE_MEM_Ring_Acceptor::ACE_MEM_Ring_Acceptor")));
+}
+
+int
+ACE_MEM_Ring_Acceptor::open (const ACE_UNIX_Addr &local_sap,
+                             int reuse_addr,
+                             int backlog)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Acceptor::open");
+
+  return ACE_LSOCK_Acceptor::open (local_sap, reuse_addr, PF_UNIX, backlog);
+}
+
+int
+ACE_MEM_Ring_Acceptor::accept (ACE_MEM_Ring_Stream &new_stream,
+                               ACE_UNIX_Addr *remote_addr,
+                               ACE_Time_Value *timeout,
+                               bool restart,
+                               bool reset_new_handle)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Acceptor::accept");
+
+  ACE_LSOCK_Stream socket;
+  if (ACE_LSOCK_Acceptor::accept (socket,
+                                  remote_addr,
+                                  timeout,
+                                  restart,
+                                  reset_new_handle) == -1)
+    return -1;
+
+  // The handles this side waits on and the peer wakes it up with, and
+  // the other way around.
+  ACE_HANDLE wait_handle = ACE_INVALID_HANDLE;
+  ACE_HANDLE signal_handle = ACE_INVALID_HANDLE;
+  ACE_HANDLE peer_wait_handle = ACE_INVALID_HANDLE;
+  ACE_HANDLE peer_signal_handle = ACE_INVALID_HANDLE;
+
+  ACE_HANDLE const segment =
+    ACE_MEM_Ring_Stream::create_segment (this->ring_size_);
+
+  int result = -1;
+  if (segment != ACE_INVALID_HANDLE
+      && ACE_MEM_Ring_Stream::create_wakeup (wait_handle,
+                                             peer_signal_handle) == 0
+      && ACE_MEM_Ring_Stream::create_wakeup (peer_wait_handle,
+                                             signal_handle) == 0
+      && socket.send_handle (segment) != -1
+      && socket.send_handle (peer_wait_handle) != -1
+      && socket.send_handle (peer_signal_handle) != -1)
+    result = 0;
+
+  {
+    ACE_Errno_Guard error (errno);
+
+    // The peer has its own copies of the handles it got by now.
+    if (peer_wait_handle != ACE_INVALID_HANDLE
+        && peer_wait_handle != signal_handle)
+      ACE_OS::close (peer_wait_handle);
+    if (peer_signal_handle != ACE_INVALID_HANDLE
+        && peer_signal_handle != wait_handle)
+      ACE_OS::close (peer_signal_handle);
+
+    if (result == -1)
+      {
+        if (segment != ACE_INVALID_HANDLE)
+          ACE_OS::close (segment);
+        if (wait_handle != ACE_INVALID_HANDLE)
+          ACE_OS::close (wait_handle);
+        if (signal_handle != ACE_INVALID_HANDLE)
+          ACE_OS::close (signal_handle);
+        socket.close ();
+        return -1;
+      }
+  }
+
+  new_stream.close ();
+  new_stream.socket_.set_handle (socket.get_handle ());
+  return new_stream.attach (segment, wait_handle, signal_handle, true);
+}
+
+void
+ACE_MEM_Ring_Acceptor::ring_size (size_t size)
+{
+  this->ring_size_ = size;
+}
+
+size_t
+ACE_MEM_Ring_Acceptor::ring_size (void) const
+{
+  return this->ring_size_;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_MEM_RING_STREAM */
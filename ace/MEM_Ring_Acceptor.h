@@ -0,0 +1,95 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    MEM_Ring_Acceptor.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+
+#ifndef ACE_MEM_RING_ACCEPTOR_H
+#define ACE_MEM_RING_ACCEPTOR_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/MEM_Ring_Stream.h"
+
+#if defined (ACE_HAS_MEM_RING_STREAM)
+
+#include "ace/LSOCK_Acceptor.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_MEM_Ring_Acceptor
+ *
+ * @brief Defines the format and interface for the acceptor side of
+ * the ACE_MEM_Ring_Stream.
+ *
+ * The rendezvous point is a UNIX domain socket.  For each connection
+ * accepted, the acceptor creates a shared memory segment holding two
+ * rings of ring_size() bytes, and passes it to the connector with the
+ * handles the sides wake up each other with.  The segment has no name
+ * left by then, so it goes away with the last side closing it.
+ */
+class ACE_Export ACE_MEM_Ring_Acceptor : public ACE_LSOCK_Acceptor
+{
+public:
+  // = Initialization methods.
+  /// Default constructor.
+  ACE_MEM_Ring_Acceptor (void);
+
+  /// Initiate a passive mode socket.
+  ACE_MEM_Ring_Acceptor (const ACE_UNIX_Addr &local_sap,
+                         int reuse_addr = 0,
+                         int backlog = ACE_DEFAULT_BACKLOG);
+
+  /// Initiate a passive mode socket.
+  int open (const ACE_UNIX_Addr &local_sap,
+            int reuse_addr = 0,
+            int backlog = ACE_DEFAULT_BACKLOG);
+
+  /// Accept a new connection and set up its rings.
+  int accept (ACE_MEM_Ring_Stream &new_stream,
+              ACE_UNIX_Addr *remote_addr = 0,
+              ACE_Time_Value *timeout = 0,
+              bool restart = true,
+              bool reset_new_handle = false);
+
+  /// Set the bytes of each ring of the connections accepted from now
+  /// on, rounded up to a power of two pages.
+  void ring_size (size_t size);
+
+  /// Bytes of each ring, as set.
+  size_t ring_size (void) const;
+
+  // = Meta-type info
+  typedef ACE_UNIX_Addr PEER_ADDR;
+  typedef ACE_MEM_Ring_Stream PEER_STREAM;
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  /// Bytes of each ring.
+  size_t ring_size_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_MEM_RING_STREAM */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_MEM_RING_ACCEPTOR_H */
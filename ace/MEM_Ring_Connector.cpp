@@ -0,0 +1,111 @@
+// $Id$
+
+#include "ace/MEM_Ring_Connector.h"
+
+#if defined (ACE_HAS_MEM_RING_STREAM)
+
+#include "ace/ACE.h"
+#include "ace/Log_Category.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_unistd.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_MEM_Ring_Connector)
+
+void
+ACE_MEM_Ring_Connector::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_MEM_Ring_Connector::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_MEM_Ring_Connector::ACE_MEM_Ring_Connector (void)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Connector::ACE_MEM_Ring_Connector");
+}
+
+ACE_MEM_Ring_Connector::ACE_MEM_Ring_Connector (
+  ACE_MEM_Ring_Stream &new_stream,
+  const ACE_UNIX_Addr &remote_sap,
+  ACE_Time_Value *timeout,
+  const ACE_Addr &local_sap,
+  int reuse_addr,
+  int flags,
+  int perms)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Connector::ACE_MEM_Ring_Connector");
+
+  if (this->connect (new_stream,
+                     remote_sap,
+                     timeout,
+                     local_sap,
+                     reuse_addr,
+                     flags,
+                     perms) == -1
+      && timeout != 0 && !(errno == EWOULDBLOCK || errno == ETIME))
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("%p\n"),
+                   ACE_TEXT ("ACE_MEM_Ring_Connector::ACE_MEM_Ring_Connector")));
+}
+
+int
+ACE_MEM_Ring_Connector::connect (ACE_MEM_Ring_Stream &new_stream,
+                                 const ACE_UNIX_Addr &remote_sap,
+                                 ACE_Time_Value *timeout,
+                                 const ACE_Addr &local_sap,
+                                 int reuse_addr,
+                                 int flags,
+                                 int perms)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Connector::connect");
+
+  ACE_LSOCK_Stream socket;
+  if (ACE_LSOCK_Connector::connect (socket,
+                                    remote_sap,
+                                    timeout,
+                                    local_sap,
+                                    reuse_addr,
+                                    flags,
+                                    perms) == -1)
+    return -1;
+
+  // The segment, the handle to wait on, and the one to wake up the
+  // acceptor with, in that order.
+  ACE_HANDLE handles[3];
+  size_t received = 0;
+  for (; received < 3; ++received)
+    {
+      if (ACE::handle_read_ready (socket.get_handle (), timeout) == -1)
+        break;
+
+      ssize_t const result = socket.recv_handle (handles[received]);
+      if (result != 1)
+        {
+          if (result == 0)
+            errno = EINVAL;
+          break;
+        }
+    }
+
+  if (received < 3)
+    {
+      ACE_Errno_Guard error (errno);
+      while (received > 0)
+        ACE_OS::close (handles[--received]);
+      socket.close ();
+      return -1;
+    }
+
+  new_stream.close ();
+  new_stream.socket_.set_handle (socket.get_handle ());
+  return new_stream.attach (handles[0], handles[1], handles[2], false);
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_MEM_RING_STREAM */
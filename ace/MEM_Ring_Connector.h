@@ -0,0 +1,89 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    MEM_Ring_Connector.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+
+#ifndef ACE_MEM_RING_CONNECTOR_H
+#define ACE_MEM_RING_CONNECTOR_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/MEM_Ring_Stream.h"
+
+#if defined (ACE_HAS_MEM_RING_STREAM)
+
+#include "ace/LSOCK_Connector.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_MEM_Ring_Connector
+ *
+ * @brief Defines the format and interface for the connector side of
+ * the ACE_MEM_Ring_Stream.
+ *
+ * The connector connects to the UNIX domain socket of an
+ * ACE_MEM_Ring_Acceptor, and maps the rings the acceptor passes back.
+ */
+class ACE_Export ACE_MEM_Ring_Connector : public ACE_LSOCK_Connector
+{
+public:
+  // = Initialization methods.
+  /// Default constructor.
+  ACE_MEM_Ring_Connector (void);
+
+  /**
+   * Actively connect and produce a @a new_stream if things go well.
+   * @see connect().
+   */
+  ACE_MEM_Ring_Connector (ACE_MEM_Ring_Stream &new_stream,
+                          const ACE_UNIX_Addr &remote_sap,
+                          ACE_Time_Value *timeout = 0,
+                          const ACE_Addr &local_sap = ACE_Addr::sap_any,
+                          int reuse_addr = 0,
+                          int flags = 0,
+                          int perms = 0);
+
+  /**
+   * Actively connect and produce a @a new_stream if things go well.
+   * The arguments are relayed to ACE_LSOCK_Connector::connect(), and
+   * @a timeout also bounds the wait for the rings.
+   */
+  int connect (ACE_MEM_Ring_Stream &new_stream,
+               const ACE_UNIX_Addr &remote_sap,
+               ACE_Time_Value *timeout = 0,
+               const ACE_Addr &local_sap = ACE_Addr::sap_any,
+               int reuse_addr = 0,
+               int flags = 0,
+               int perms = 0);
+
+  // = Meta-type info
+  typedef ACE_UNIX_Addr PEER_ADDR;
+  typedef ACE_MEM_Ring_Stream PEER_STREAM;
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_MEM_RING_STREAM */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_MEM_RING_CONNECTOR_H */
@@ -0,0 +1,855 @@
+// $Id$
+
+#include "ace/MEM_Ring_Stream.h"
+
+#if defined (ACE_HAS_MEM_RING_STREAM)
+
+#include "ace/ACE.h"
+#include "ace/Countdown_Time.h"
+#include "ace/Handle_Set.h"
+#include "ace/Log_Category.h"
+#include "ace/Truncate.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_mman.h"
+#include "ace/OS_NS_sys_select.h"
+#include "ace/OS_NS_sys_socket.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+#if defined (ACE_HAS_EVENTFD)
+#  include <sys/eventfd.h>
+#endif /* ACE_HAS_EVENTFD */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * The positions count the bytes ever written to, and read from, the
+ * ring, modulo 2^32: the ring holds <tail_> - <head_> bytes, from
+ * <head_> modulo its capacity.  A position and its closed flag are
+ * only written by their side, and each waiting flag is set by the
+ * side which sleeps and cleared by the one which wakes it up.
+ */
+struct ACE_MEM_Ring_Stream::Ring
+{
+  volatile ACE_UINT32 tail_;
+  volatile ACE_UINT32 writer_closed_;
+  char pad0_[ACE_MEM_RING_CACHE_LINE - 2 * sizeof (ACE_UINT32)];
+
+  volatile ACE_UINT32 head_;
+  volatile ACE_UINT32 reader_closed_;
+  char pad1_[ACE_MEM_RING_CACHE_LINE - 2 * sizeof (ACE_UINT32)];
+
+  volatile ACE_UINT32 reader_waiting_;
+  char pad2_[ACE_MEM_RING_CACHE_LINE - sizeof (ACE_UINT32)];
+
+  volatile ACE_UINT32 writer_waiting_;
+  char pad3_[ACE_MEM_RING_CACHE_LINE - sizeof (ACE_UINT32)];
+};
+
+namespace
+{
+  /// Start of a segment, padded to a page.  The data of the ring from
+  /// the acceptor follows, then the data of the other one.
+  struct Segment_Header
+  {
+    char magic_[8];
+    ACE_UINT32 capacity_;
+    ACE_UINT32 header_size_;
+    char pad_[ACE_MEM_RING_CACHE_LINE - 16];
+
+    /// The ring from the acceptor to the connector, then the other.
+    ACE_MEM_Ring_Stream::Ring rings_[2];
+  };
+
+  const char segment_magic[8] = { 'A', 'C', 'E', 'R', 'I', 'N', 'G', '1' };
+
+  /// Largest ring, so that the positions can tell full from empty.
+  const size_t max_capacity = 0x40000000;
+
+  /// Read the position the peer updates, then the data it covers.
+  inline ACE_UINT32
+  load_position (volatile ACE_UINT32 &position)
+  {
+    ACE_UINT32 const value = position;
+    __sync_synchronize ();
+    return value;
+  }
+
+  /// Update the data, then the position which covers it.  The caller
+  /// then looks at the waiting flag of the peer, after a full barrier
+  /// of its own: a peer which set the flag after that sees the update.
+  inline void
+  store_position (volatile ACE_UINT32 &position, ACE_UINT32 value)
+  {
+    __sync_synchronize ();
+    position = value;
+    __sync_synchronize ();
+  }
+
+  /// Clear the wakeups received.
+  void
+  drain (ACE_HANDLE handle)
+  {
+#if defined (ACE_HAS_EVENTFD)
+    ACE_UINT64 count;
+    (void) ACE_OS::read (handle, &count, sizeof count);
+#else
+    char buf[64];
+    while (ACE_OS::recv (handle, buf, sizeof buf) > 0)
+      continue;
+#endif /* ACE_HAS_EVENTFD */
+  }
+
+  /// Map the @a capacity bytes of data at @a offset of @a segment
+  /// twice, back to back.
+  char *
+  map_ring (ACE_HANDLE segment, ACE_OFF_T offset, size_t capacity)
+  {
+    // Reserve the addresses, then map the data over both halves.
+    char *const base =
+      static_cast<char *> (ACE_OS::mmap (0,
+                                         2 * capacity,
+                                         PROT_NONE,
+                                         MAP_SHARED,
+                                         segment));
+    if (base == MAP_FAILED)
+      return 0;
+
+    if (ACE_OS::mmap (base,
+                      capacity,
+                      PROT_RDWR,
+                      MAP_SHARED | MAP_FIXED,
+                      segment,
+                      offset) != base
+        || ACE_OS::mmap (base + capacity,
+                         capacity,
+                         PROT_RDWR,
+                         MAP_SHARED | MAP_FIXED,
+                         segment,
+                         offset) != base + capacity)
+      {
+        ACE_OS::munmap (base, 2 * capacity);
+        return 0;
+      }
+
+    return base;
+  }
+}
+
+ACE_ALLOC_HOOK_DEFINE(ACE_MEM_Ring_Stream)
+
+ACE_MEM_Ring_Stream::ACE_MEM_Ring_Stream (void)
+  : signal_handle_ (ACE_INVALID_HANDLE),
+    header_ (0),
+    header_size_ (0),
+    in_ (0),
+    out_ (0),
+    in_data_ (0),
+    out_data_ (0),
+    capacity_ (0),
+    in_head_ (0),
+    out_tail_ (0),
+    in_tail_ (0),
+    out_head_ (0),
+    spin_ (ACE_OS::num_processors_online () > 1
+           ? ACE_DEFAULT_MEM_RING_SPIN
+           : 0),
+    peer_gone_ (false)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::ACE_MEM_Ring_Stream");
+}
+
+ACE_MEM_Ring_Stream::~ACE_MEM_Ring_Stream (void)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::~ACE_MEM_Ring_Stream");
+  (void) this->close ();
+}
+
+void
+ACE_MEM_Ring_Stream::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_MEM_Ring_Stream::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("capacity_ = %u\nin_head_ = %u\nout_tail_ = %u\n"),
+                 this->capacity_,
+                 this->in_head_,
+                 this->out_tail_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_HANDLE
+ACE_MEM_Ring_Stream::create_segment (size_t size)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::create_segment");
+
+  size_t const page = ACE_OS::allocation_granularity ();
+  size_t capacity = page;
+  while (capacity < size && capacity < max_capacity)
+    capacity *= 2;
+
+  static ACE_UINT32 sequence = 0;
+  ACE_TCHAR name[ACE_UNIQUE_NAME_LEN];
+  ACE_OS::sprintf (name,
+                   ACE_TEXT ("/ace-mem-ring-%d-%u"),
+                   static_cast<int> (ACE_OS::getpid ()),
+                   __sync_fetch_and_add (&sequence, 1));
+
+  ACE_HANDLE const segment = ACE_OS::shm_open (name,
+                                               O_RDWR | O_CREAT | O_EXCL,
+                                               S_IRUSR | S_IWUSR);
+  if (segment == ACE_INVALID_HANDLE)
+    return ACE_INVALID_HANDLE;
+
+  // The peer gets the handle, not the name.
+  (void) ACE_OS::shm_unlink (name);
+
+  void *header = MAP_FAILED;
+  if (ACE_OS::ftruncate (segment,
+                         static_cast<ACE_OFF_T> (page + 2 * capacity)) == 0)
+    header = ACE_OS::mmap (0, page, PROT_RDWR, MAP_SHARED, segment);
+
+  if (header == MAP_FAILED)
+    {
+      ACE_Errno_Guard error (errno);
+      ACE_OS::close (segment);
+      return ACE_INVALID_HANDLE;
+    }
+
+  // The rest of the segment is zeroed already.
+  Segment_Header *const h = static_cast<Segment_Header *> (header);
+  ACE_OS::memcpy (h->magic_, segment_magic, sizeof h->magic_);
+  h->capacity_ = static_cast<ACE_UINT32> (capacity);
+  h->header_size_ = static_cast<ACE_UINT32> (page);
+
+  // Both readers wait from the start, so that the first data wakes up
+  // a reactor.
+  h->rings_[0].reader_waiting_ = 1;
+  h->rings_[1].reader_waiting_ = 1;
+  ACE_OS::munmap (header, page);
+
+  return segment;
+}
+
+int
+ACE_MEM_Ring_Stream::create_wakeup (ACE_HANDLE &wait_handle,
+                                    ACE_HANDLE &signal_handle)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::create_wakeup");
+
+#if defined (ACE_HAS_EVENTFD)
+  wait_handle = ::eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC);
+  signal_handle = wait_handle;
+  return wait_handle == ACE_INVALID_HANDLE ? -1 : 0;
+#else
+  // Sockets rather than a pipe, so that waking up a peer gone does not
+  // raise SIGPIPE.
+  ACE_HANDLE handles[2];
+  if (ACE_OS::socketpair (AF_UNIX, SOCK_STREAM, 0, handles) == -1)
+    return -1;
+
+# if defined (F_SETFD)
+  ACE_OS::fcntl (handles[0], F_SETFD, 1);
+  ACE_OS::fcntl (handles[1], F_SETFD, 1);
+# endif /* F_SETFD */
+
+# if defined (SO_NOSIGPIPE)
+  int one = 1;
+  ACE_OS::setsockopt (handles[1], SOL_SOCKET, SO_NOSIGPIPE,
+                      reinterpret_cast<const char *> (&one), sizeof one);
+# endif /* SO_NOSIGPIPE */
+
+  // A full socket wakes up the peer already, so neither end may block.
+  if (ACE::set_flags (handles[0], ACE_NONBLOCK) == -1
+      || ACE::set_flags (handles[1], ACE_NONBLOCK) == -1)
+    {
+      ACE_Errno_Guard error (errno);
+      ACE_OS::closesocket (handles[0]);
+      ACE_OS::closesocket (handles[1]);
+      return -1;
+    }
+
+  wait_handle = handles[0];
+  signal_handle = handles[1];
+  return 0;
+#endif /* ACE_HAS_EVENTFD */
+}
+
+int
+ACE_MEM_Ring_Stream::attach (ACE_HANDLE segment,
+                             ACE_HANDLE wait_handle,
+                             ACE_HANDLE signal_handle,
+                             bool acceptor)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::attach");
+
+  this->set_handle (wait_handle);
+  this->signal_handle_ = signal_handle;
+  this->peer_gone_ = false;
+
+  size_t const page = ACE_OS::allocation_granularity ();
+  ACE_OFF_T const size = ACE_OS::filesize (segment);
+
+  void *header = ACE_OS::mmap (0, page, PROT_RDWR, MAP_SHARED, segment);
+  if (header == MAP_FAILED)
+    {
+      ACE_Errno_Guard error (errno);
+      ACE_OS::close (segment);
+      this->close ();
+      return -1;
+    }
+
+  this->header_ = static_cast<char *> (header);
+  this->header_size_ = page;
+
+  Segment_Header *const h = static_cast<Segment_Header *> (header);
+  size_t const capacity = h->capacity_;
+  if (ACE_OS::memcmp (h->magic_, segment_magic, sizeof h->magic_) != 0
+      || h->header_size_ != page
+      || capacity < page
+      || capacity > max_capacity
+      || (capacity & (capacity - 1)) != 0
+      || size < static_cast<ACE_OFF_T> (page + 2 * capacity))
+    {
+      ACE_OS::close (segment);
+      this->close ();
+      errno = EINVAL;
+      return -1;
+    }
+
+  this->capacity_ = static_cast<ACE_UINT32> (capacity);
+  this->out_ = &h->rings_[acceptor ? 0 : 1];
+  this->in_ = &h->rings_[acceptor ? 1 : 0];
+
+  this->out_data_ =
+    map_ring (segment, static_cast<ACE_OFF_T> (page + (acceptor ? 0 : capacity)),
+              capacity);
+  this->in_data_ =
+    map_ring (segment, static_cast<ACE_OFF_T> (page + (acceptor ? capacity : 0)),
+              capacity);
+
+  {
+    // The mappings hold on to the segment.
+    ACE_Errno_Guard error (errno);
+    ACE_OS::close (segment);
+  }
+
+  if (this->out_data_ == 0 || this->in_data_ == 0)
+    {
+      ACE_Errno_Guard error (errno);
+      this->close ();
+      return -1;
+    }
+
+  this->out_tail_ = this->out_->tail_;
+  this->out_head_ = this->out_->head_;
+  this->in_head_ = this->in_->head_;
+  this->in_tail_ = this->in_->tail_;
+  return 0;
+}
+
+/// Called with nothing to do.  The first time, clear the handle, set
+/// @a waiting and return for the caller to look at the ring again: a
+/// peer which updates the ring after that wakes this side up.  The
+/// next time, wait for the handle, or for the socket, which only
+/// becomes readable once the peer is gone.
+int
+ACE_MEM_Ring_Stream::sleep (volatile ACE_UINT32 &waiting,
+                            bool &armed,
+                            const ACE_Time_Value *timeout,
+                            const ACE_Time_Value &deadline)
+{
+  if (!armed)
+    {
+      drain (this->get_handle ());
+      waiting = 1;
+      __sync_synchronize ();
+      armed = true;
+      return 0;
+    }
+
+  armed = false;
+
+  ACE_Time_Value time_left;
+  ACE_Time_Value *time_left_p = 0;
+  if (timeout != 0)
+    {
+      if (*timeout == ACE_Time_Value::zero)
+        {
+          errno = EWOULDBLOCK;
+          return -1;
+        }
+
+      time_left = deadline - ACE_OS::gettimeofday ();
+      if (time_left <= ACE_Time_Value::zero)
+        {
+          errno = ETIME;
+          return -1;
+        }
+      time_left_p = &time_left;
+    }
+
+  ACE_Handle_Set handles;
+  handles.set_bit (this->get_handle ());
+  handles.set_bit (this->socket_.get_handle ());
+
+  int const result = ACE_OS::select (int (handles.max_set ()) + 1,
+                                     handles,
+                                     0,
+                                     0,
+                                     time_left_p);
+  if (result == -1)
+    return errno == EINTR ? 0 : -1;
+
+  if (result == 0)
+    {
+      errno = ETIME;
+      return -1;
+    }
+
+  if (handles.is_set (this->socket_.get_handle ()))
+    this->peer_gone_ = true;
+
+  return 0;
+}
+
+/// Wake up the peer if it waits on @a waiting.
+void
+ACE_MEM_Ring_Stream::wake_up (volatile ACE_UINT32 &waiting)
+{
+  if (waiting != 0 && __sync_bool_compare_and_swap (&waiting, 1, 0))
+    {
+#if defined (ACE_HAS_EVENTFD)
+      ACE_UINT64 one = 1;
+      (void) ACE_OS::write (this->signal_handle_, &one, sizeof one);
+#else
+      // A full socket is readable already.
+      char zero = 0;
+# if defined (MSG_NOSIGNAL)
+      (void) ACE_OS::send (this->signal_handle_, &zero, 1, MSG_NOSIGNAL);
+# else
+      (void) ACE_OS::send (this->signal_handle_, &zero, 1);
+# endif /* MSG_NOSIGNAL */
+#endif /* ACE_HAS_EVENTFD */
+    }
+}
+
+/// Wait until @a n bytes can be read, or the peer closed its side.
+/// Returns the bytes to read, or -1.  More bytes than the ring holds
+/// mean the peer corrupted its position, which fails with EPROTO.
+ssize_t
+ACE_MEM_Ring_Stream::wait_input (size_t n, const ACE_Time_Value *timeout)
+{
+  if (this->in_ == 0)
+    {
+      errno = ENOTCONN;
+      return -1;
+    }
+
+  // Only look at the position of the writer once the bytes read from
+  // the last one are used up.
+  ACE_UINT32 available = this->in_tail_ - this->in_head_;
+  if (available >= n && available <= this->capacity_)
+    return available;
+
+  ACE_Time_Value deadline;
+  if (timeout != 0 && *timeout != ACE_Time_Value::zero)
+    deadline = ACE_OS::gettimeofday () + *timeout;
+
+  u_int const spin =
+    timeout != 0 && *timeout == ACE_Time_Value::zero ? 0 : this->spin_;
+  bool armed = false;
+
+  for (u_int spins = 0; ; ++spins)
+    {
+      this->in_tail_ = load_position (this->in_->tail_);
+      available = this->in_tail_ - this->in_head_;
+      if (available > this->capacity_)
+        break;
+      if (available >= n)
+        return available;
+
+      if (this->in_->writer_closed_ != 0 || this->peer_gone_)
+        {
+          // The writer closed after its last write.
+          __sync_synchronize ();
+          this->in_tail_ = load_position (this->in_->tail_);
+          available = this->in_tail_ - this->in_head_;
+          if (available > this->capacity_)
+            break;
+          return available;
+        }
+
+      if (spins >= spin
+          && this->sleep (this->in_->reader_waiting_,
+                          armed,
+                          timeout,
+                          deadline) == -1)
+        return -1;
+    }
+
+  // Keep the bad position, so that later calls fail as well.
+  errno = EPROTO;
+  return -1;
+}
+
+/// Wait until there is room for @a n bytes.  Returns the room, or -1;
+/// a reader ahead of the writer fails with EPROTO.
+ssize_t
+ACE_MEM_Ring_Stream::wait_output (size_t n, const ACE_Time_Value *timeout)
+{
+  if (this->out_ == 0)
+    {
+      errno = ENOTCONN;
+      return -1;
+    }
+
+  if (this->out_->writer_closed_ != 0 || this->peer_gone_)
+    {
+      errno = EPIPE;
+      return -1;
+    }
+
+  ACE_UINT32 room = this->capacity_ - (this->out_tail_ - this->out_head_);
+  if (room >= n && room <= this->capacity_)
+    return room;
+
+  ACE_Time_Value deadline;
+  if (timeout != 0 && *timeout != ACE_Time_Value::zero)
+    deadline = ACE_OS::gettimeofday () + *timeout;
+
+  u_int const spin =
+    timeout != 0 && *timeout == ACE_Time_Value::zero ? 0 : this->spin_;
+  bool armed = false;
+
+  for (u_int spins = 0; ; ++spins)
+    {
+      this->out_head_ = load_position (this->out_->head_);
+      if (this->out_->reader_closed_ != 0 || this->peer_gone_)
+        {
+          errno = EPIPE;
+          return -1;
+        }
+
+      if (ACE_UINT32 (this->out_tail_ - this->out_head_) > this->capacity_)
+        {
+          errno = EPROTO;
+          return -1;
+        }
+
+      room = this->capacity_ - (this->out_tail_ - this->out_head_);
+      if (room >= n)
+        return room;
+
+      if (spins >= spin
+          && this->sleep (this->out_->writer_waiting_,
+                          armed,
+                          timeout,
+                          deadline) == -1)
+        return -1;
+    }
+}
+
+ssize_t
+ACE_MEM_Ring_Stream::reserve (void *&buf,
+                              size_t n,
+                              const ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::reserve");
+
+  if (this->out_ != 0 && n > this->capacity_)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  ssize_t const room = this->wait_output (n == 0 ? 1 : n, timeout);
+  if (room > 0)
+    buf = this->out_data_ + (this->out_tail_ & (this->capacity_ - 1));
+  return room;
+}
+
+int
+ACE_MEM_Ring_Stream::commit (size_t n)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::commit");
+
+  if (this->out_ == 0)
+    {
+      errno = ENOTCONN;
+      return -1;
+    }
+
+  if (n > size_t (this->capacity_ - (this->out_tail_ - this->out_head_)))
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  this->out_tail_ += static_cast<ACE_UINT32> (n);
+  store_position (this->out_->tail_, this->out_tail_);
+  this->wake_up (this->out_->reader_waiting_);
+  return 0;
+}
+
+ssize_t
+ACE_MEM_Ring_Stream::peek (const void *&buf,
+                           size_t n,
+                           const ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::peek");
+
+  if (this->in_ != 0 && n > this->capacity_)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  ssize_t const available = this->wait_input (n == 0 ? 1 : n, timeout);
+  if (available > 0)
+    buf = this->in_data_ + (this->in_head_ & (this->capacity_ - 1));
+  return available;
+}
+
+int
+ACE_MEM_Ring_Stream::consume (size_t n)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::consume");
+
+  if (this->in_ == 0)
+    {
+      errno = ENOTCONN;
+      return -1;
+    }
+
+  if (n > size_t (this->in_tail_ - this->in_head_))
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  this->in_head_ += static_cast<ACE_UINT32> (n);
+  store_position (this->in_->head_, this->in_head_);
+  this->wake_up (this->in_->writer_waiting_);
+  return 0;
+}
+
+ssize_t
+ACE_MEM_Ring_Stream::send (const void *buf,
+                           size_t n,
+                           const ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::send");
+
+  if (n == 0)
+    return 0;
+
+  ssize_t const room = this->wait_output (1, timeout);
+  if (room == -1)
+    return -1;
+
+  size_t const len = n < size_t (room) ? n : size_t (room);
+  ACE_OS::memcpy (this->out_data_ + (this->out_tail_ & (this->capacity_ - 1)),
+                  buf,
+                  len);
+  this->commit (len);
+  return ACE_Utils::truncate_cast<ssize_t> (len);
+}
+
+ssize_t
+ACE_MEM_Ring_Stream::recv (void *buf,
+                           size_t n,
+                           const ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::recv");
+
+  if (n == 0)
+    return 0;
+
+  ssize_t const available = this->wait_input (1, timeout);
+  if (available <= 0)
+    return available;
+
+  size_t const len = n < size_t (available) ? n : size_t (available);
+  ACE_OS::memcpy (buf,
+                  this->in_data_ + (this->in_head_ & (this->capacity_ - 1)),
+                  len);
+  this->consume (len);
+  return ACE_Utils::truncate_cast<ssize_t> (len);
+}
+
+ssize_t
+ACE_MEM_Ring_Stream::send_n (const void *buf,
+                             size_t n,
+                             const ACE_Time_Value *timeout,
+                             size_t *bytes_transferred)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::send_n");
+
+  size_t temp;
+  size_t &bytes = bytes_transferred == 0 ? temp : *bytes_transferred;
+
+  ACE_Time_Value time_left;
+  ACE_Time_Value *time_left_p = 0;
+  if (timeout != 0)
+    {
+      time_left = *timeout;
+      time_left_p = &time_left;
+    }
+  ACE_Countdown_Time countdown (time_left_p);
+
+  for (bytes = 0; bytes < n; countdown.update ())
+    {
+      ssize_t const result =
+        this->send (static_cast<const char *> (buf) + bytes,
+                    n - bytes,
+                    time_left_p);
+      if (result == -1)
+        return -1;
+      bytes += result;
+    }
+
+  return ACE_Utils::truncate_cast<ssize_t> (bytes);
+}
+
+ssize_t
+ACE_MEM_Ring_Stream::recv_n (void *buf,
+                             size_t n,
+                             const ACE_Time_Value *timeout,
+                             size_t *bytes_transferred)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::recv_n");
+
+  size_t temp;
+  size_t &bytes = bytes_transferred == 0 ? temp : *bytes_transferred;
+
+  ACE_Time_Value time_left;
+  ACE_Time_Value *time_left_p = 0;
+  if (timeout != 0)
+    {
+      time_left = *timeout;
+      time_left_p = &time_left;
+    }
+  ACE_Countdown_Time countdown (time_left_p);
+
+  for (bytes = 0; bytes < n; countdown.update ())
+    {
+      ssize_t const result =
+        this->recv (static_cast<char *> (buf) + bytes,
+                    n - bytes,
+                    time_left_p);
+      if (result <= 0)
+        return result;
+      bytes += result;
+    }
+
+  return ACE_Utils::truncate_cast<ssize_t> (bytes);
+}
+
+int
+ACE_MEM_Ring_Stream::close_writer (void)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::close_writer");
+
+  if (this->out_ == 0)
+    {
+      errno = ENOTCONN;
+      return -1;
+    }
+
+  if (this->out_->writer_closed_ == 0)
+    {
+      store_position (this->out_->writer_closed_, 1);
+      this->wake_up (this->out_->reader_waiting_);
+    }
+  return 0;
+}
+
+int
+ACE_MEM_Ring_Stream::close (void)
+{
+  ACE_TRACE ("ACE_MEM_Ring_Stream::close");
+
+  if (this->out_ != 0)
+    this->close_writer ();
+
+  if (this->in_ != 0)
+    {
+      // A writer waiting for room gets EPIPE instead.
+      store_position (this->in_->reader_closed_, 1);
+      this->wake_up (this->in_->writer_waiting_);
+    }
+
+  if (this->in_data_ != 0)
+    ACE_OS::munmap (this->in_data_, 2 * this->capacity_);
+  if (this->out_data_ != 0)
+    ACE_OS::munmap (this->out_data_, 2 * this->capacity_);
+  if (this->header_ != 0)
+    ACE_OS::munmap (this->header_, this->header_size_);
+
+  this->header_ = 0;
+  this->in_ = 0;
+  this->out_ = 0;
+  this->in_data_ = 0;
+  this->out_data_ = 0;
+  this->capacity_ = 0;
+  this->in_head_ = this->in_tail_ = 0;
+  this->out_head_ = this->out_tail_ = 0;
+  this->peer_gone_ = false;
+
+  int result = 0;
+  if (this->get_handle () != ACE_INVALID_HANDLE)
+    {
+      result = ACE_OS::close (this->get_handle ());
+      this->set_handle (ACE_INVALID_HANDLE);
+    }
+  if (this->signal_handle_ != ACE_INVALID_HANDLE)
+    {
+      ACE_OS::close (this->signal_handle_);
+      this->signal_handle_ = ACE_INVALID_HANDLE;
+    }
+  if (this->socket_.get_handle () != ACE_INVALID_HANDLE)
+    this->socket_.close ();
+
+  return result;
+}
+
+size_t
+ACE_MEM_Ring_Stream::capacity (void) const
+{
+  return this->capacity_;
+}
+
+void
+ACE_MEM_Ring_Stream::spin (u_int count)
+{
+  this->spin_ = count;
+}
+
+u_int
+ACE_MEM_Ring_Stream::spin (void) const
+{
+  return this->spin_;
+}
+
+int
+ACE_MEM_Ring_Stream::get_remote_addr (ACE_Addr &addr) const
+{
+  return this->socket_.get_remote_addr (addr);
+}
+
+int
+ACE_MEM_Ring_Stream::get_local_addr (ACE_Addr &addr) const
+{
+  return this->socket_.get_local_addr (addr);
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_MEM_RING_STREAM */
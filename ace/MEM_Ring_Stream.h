@@ -0,0 +1,261 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    MEM_Ring_Stream.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+
+#ifndef ACE_MEM_RING_STREAM_H
+#define ACE_MEM_RING_STREAM_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/LSOCK_Stream.h"
+
+#if defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1) \
+    && defined (ACE_HAS_MSG) && !defined (ACE_LACKS_UNIX_DOMAIN_SOCKETS) \
+    && !defined (ACE_LACKS_MMAP)
+# define ACE_HAS_MEM_RING_STREAM
+#endif /* ACE_HAS_GCC_ATOMIC_BUILTINS && ACE_HAS_MSG ... */
+
+#if defined (ACE_HAS_MEM_RING_STREAM)
+
+#include "ace/IPC_SAP.h"
+#include "ace/UNIX_Addr.h"
+#include "ace/Basic_Types.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_MEM_Ring_Acceptor;
+class ACE_MEM_Ring_Connector;
+class ACE_Time_Value;
+
+/**
+ * @class ACE_MEM_Ring_Stream
+ *
+ * @brief A byte stream between two processes of a host, through a
+ * pair of rings in shared memory.
+ *
+ * Each direction is a ring of a power of two bytes, with one writer
+ * and one reader, in a segment the ACE_MEM_Ring_Acceptor creates and
+ * passes to the ACE_MEM_Ring_Connector over the UNIX domain socket
+ * they connect with.  The positions of the writer and the reader are
+ * on cache lines of their own, and each side keeps the last position
+ * of the other it read, so that a transfer only touches the line of
+ * the other side when the ring looks full or empty.  The data of a
+ * ring is mapped twice, back to back, so that the bytes from any
+ * position are contiguous: reserve() and peek() hand out pointers
+ * into the ring for zero-copy transfers, and send() and recv() copy
+ * with a single memcpy().
+ *
+ * A side waiting for data or for room polls the ring a few times (see
+ * spin()), then flags that it waits and sleeps on its handle, an
+ * @c eventfd where available (a socket otherwise); the other side only
+ * makes a system call to wake it up when it finds the flag set.
+ * get_handle() returns this handle, so the stream can be registered
+ * with a reactor for READ_MASK.  It becomes readable once data comes
+ * in, and after that once the stream can make progress again after a
+ * call given a zero timeout failed with @c errno EWOULDBLOCK: a handler
+ * calls until then, as with a non-blocking socket under an edge
+ * triggered reactor.
+ *
+ * The sockets stay connected, so that a blocked call notices when the
+ * peer process goes away; a reactor only notices a peer which close()s
+ * the stream.  Each direction is for a single thread at a time: threads
+ * sharing a stream must serialize their sends, and their receives.
+ */
+class ACE_Export ACE_MEM_Ring_Stream : public ACE_IPC_SAP
+{
+public:
+  friend class ACE_MEM_Ring_Acceptor;
+  friend class ACE_MEM_Ring_Connector;
+
+  // = Initialization and termination methods.
+  /// Constructor.
+  ACE_MEM_Ring_Stream (void);
+
+  /// Destructor, close()s the stream.
+  ~ACE_MEM_Ring_Stream (void);
+
+  /**
+   * @name Counted send/receive methods
+   *
+   * A null @a timeout blocks as long as it takes, a @a timeout of zero
+   * does not block and fails with @c errno EWOULDBLOCK if no byte can
+   * be transferred; otherwise the call fails with @c errno ETIME if it
+   * could not transfer a byte in time.  recv() returns 0 once the peer
+   * closed its side and all the data has been received; send() fails
+   * with @c errno EPIPE once the peer closed the stream.  Both fail
+   * with @c errno EPROTO if the peer left its position in the ring
+   * more than capacity() bytes away from this side's.
+   */
+  //@{
+  /// Send up to @a n bytes.
+  ssize_t send (const void *buf,
+                size_t n,
+                const ACE_Time_Value *timeout = 0);
+
+  /// Receive up to @a n bytes.
+  ssize_t recv (void *buf,
+                size_t n,
+                const ACE_Time_Value *timeout = 0);
+
+  /// Send @a n bytes, keep trying until all are sent, the peer closes
+  /// or the time runs out.
+  ssize_t send_n (const void *buf,
+                  size_t n,
+                  const ACE_Time_Value *timeout = 0,
+                  size_t *bytes_transferred = 0);
+
+  /// Receive @a n bytes, keep trying until all are received, the peer
+  /// closes or the time runs out.
+  ssize_t recv_n (void *buf,
+                  size_t n,
+                  const ACE_Time_Value *timeout = 0,
+                  size_t *bytes_transferred = 0);
+  //@}
+
+  /**
+   * @name Zero-copy methods
+   *
+   * These block like the methods above, and fail with @c errno EINVAL
+   * if @a n is more than capacity().
+   */
+  //@{
+  /// Wait for room for @a n bytes, and point @a buf to it.  Returns
+  /// the contiguous bytes available there, at least @a n; they are sent
+  /// once commit()ed.
+  ssize_t reserve (void *&buf,
+                   size_t n,
+                   const ACE_Time_Value *timeout = 0);
+
+  /// Send the first @a n bytes reserve() made room for.
+  int commit (size_t n);
+
+  /// Wait for @a n bytes, and point @a buf to them.  Returns the
+  /// contiguous bytes there, at least @a n unless the peer closed its
+  /// side, 0 if there are none left.  They stay in the ring until
+  /// consume()d.
+  ssize_t peek (const void *&buf,
+                size_t n = 1,
+                const ACE_Time_Value *timeout = 0);
+
+  /// Drop the first @a n bytes peek() gave.
+  int consume (size_t n);
+  //@}
+
+  /// Close down the writer side: the peer receives the data sent so
+  /// far, then the end of the stream.
+  int close_writer (void);
+
+  /// Close down the stream and release the shared memory.
+  int close (void);
+
+  /// Bytes a ring holds.
+  size_t capacity (void) const;
+
+  /// Set the number of times a side polls the ring before it sleeps;
+  /// ACE_DEFAULT_MEM_RING_SPIN, or 0 with a single processor online.
+  void spin (u_int count);
+  u_int spin (void) const;
+
+  /// Return the address of the peer's socket.
+  int get_remote_addr (ACE_Addr &) const;
+
+  /// Return the address of the local socket.
+  int get_local_addr (ACE_Addr &) const;
+
+  // = Meta-type info
+  typedef ACE_UNIX_Addr PEER_ADDR;
+
+  /// Dump the state of an object.
+  void dump (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+  /// Shared state of one direction, see MEM_Ring_Stream.cpp.
+  struct Ring;
+
+private:
+  /// Map the @a segment the acceptor set up, and wait on @a wait_handle
+  /// and wake up the peer with @a signal_handle.  @a acceptor tells the
+  /// side.  The handles belong to the stream, even on failure.
+  int attach (ACE_HANDLE segment,
+              ACE_HANDLE wait_handle,
+              ACE_HANDLE signal_handle,
+              bool acceptor);
+
+  /// Create a segment with rings of at least @a size bytes, for the
+  /// acceptor.
+  static ACE_HANDLE create_segment (size_t size);
+
+  /// Create the handle a side waits on and the one its peer wakes it
+  /// up with, for the acceptor; they are the same with @c eventfd.
+  static int create_wakeup (ACE_HANDLE &wait_handle,
+                            ACE_HANDLE &signal_handle);
+
+  // The following are documented in the .cpp file.
+  ssize_t wait_input (size_t n, const ACE_Time_Value *timeout);
+  ssize_t wait_output (size_t n, const ACE_Time_Value *timeout);
+  int sleep (volatile ACE_UINT32 &waiting,
+             bool &armed,
+             const ACE_Time_Value *timeout,
+             const ACE_Time_Value &deadline);
+  void wake_up (volatile ACE_UINT32 &waiting);
+
+  ACE_MEM_Ring_Stream (const ACE_MEM_Ring_Stream &);
+  ACE_MEM_Ring_Stream &operator= (const ACE_MEM_Ring_Stream &);
+
+  /// The connection the rings were set up through.
+  ACE_LSOCK_Stream socket_;
+
+  /// Handle written to wake up the peer.
+  ACE_HANDLE signal_handle_;
+
+  /// Mapping of the header of the segment.
+  char *header_;
+  size_t header_size_;
+
+  /// The rings the peer writes to and reads from.
+  Ring *in_;
+  Ring *out_;
+
+  /// Mappings of their data, each twice capacity_ bytes long.
+  char *in_data_;
+  char *out_data_;
+
+  ACE_UINT32 capacity_;
+
+  /// Positions this side owns: the reader's of <in_>, the writer's
+  /// of <out_>.
+  ACE_UINT32 in_head_;
+  ACE_UINT32 out_tail_;
+
+  /// Last positions of the peer read from the rings.
+  ACE_UINT32 in_tail_;
+  ACE_UINT32 out_head_;
+
+  u_int spin_;
+
+  /// Set once the socket reports the peer gone.
+  bool peer_gone_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_MEM_RING_STREAM */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_MEM_RING_STREAM_H */
@@ -0,0 +1,291 @@
+// $Id$
+
+#include "ace/MPSC_Notification_Queue.h"
+
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+
+#if !defined (__ACE_INLINE__)
+#include "ace/MPSC_Notification_Queue.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/ACE.h"
+#include "ace/Guard_T.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_fcntl.h"
+
+#if defined (ACE_HAS_EVENTFD)
+#  include <sys/eventfd.h>
+#endif /* ACE_HAS_EVENTFD */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_MPSC_Notification_Queue::ACE_MPSC_Notification_Queue (void)
+  : head_ (&stub_)
+  , tail_ (&stub_)
+  , signaled_ (0)
+#if defined (ACE_HAS_EVENTFD)
+  , event_handle_ (ACE_INVALID_HANDLE)
+#endif /* ACE_HAS_EVENTFD */
+{
+  this->stub_.next_ = 0;
+}
+
+ACE_MPSC_Notification_Queue::~ACE_MPSC_Notification_Queue (void)
+{
+  (void) this->close ();
+}
+
+int
+ACE_MPSC_Notification_Queue::open (void)
+{
+  ACE_TRACE ("ACE_MPSC_Notification_Queue::open");
+
+  if (this->handle () != ACE_INVALID_HANDLE)
+    return 0;
+
+#if defined (ACE_HAS_EVENTFD)
+  this->event_handle_ = ::eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (this->event_handle_ == ACE_INVALID_HANDLE)
+    return -1;
+#else
+  if (this->wakeup_pipe_.open () == -1)
+    return -1;
+
+# if defined (F_SETFD)
+  ACE_OS::fcntl (this->wakeup_pipe_.read_handle (), F_SETFD, 1);
+  ACE_OS::fcntl (this->wakeup_pipe_.write_handle (), F_SETFD, 1);
+# endif /* F_SETFD */
+
+  // A full pipe already wakes up the reactor, so neither end may
+  // block.
+  if (ACE::set_flags (this->wakeup_pipe_.read_handle (),
+                      ACE_NONBLOCK) == -1
+      || ACE::set_flags (this->wakeup_pipe_.write_handle (),
+                         ACE_NONBLOCK) == -1)
+    {
+      this->wakeup_pipe_.close ();
+      return -1;
+    }
+#endif /* ACE_HAS_EVENTFD */
+
+  this->signaled_ = 0;
+  return 0;
+}
+
+int
+ACE_MPSC_Notification_Queue::close (void)
+{
+  ACE_TRACE ("ACE_MPSC_Notification_Queue::close");
+
+  {
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, mon, this->consumer_lock_, -1);
+
+    // Release the event handlers still in the queue.
+    for (Node *node = this->dequeue (); node != 0; node = this->dequeue ())
+      {
+        if (node->buffer_.eh_ != 0)
+          (void) node->buffer_.eh_->remove_reference ();
+        delete node;
+      }
+  }
+
+#if defined (ACE_HAS_EVENTFD)
+  int result = 0;
+  if (this->event_handle_ != ACE_INVALID_HANDLE)
+    {
+      result = ACE_OS::close (this->event_handle_);
+      this->event_handle_ = ACE_INVALID_HANDLE;
+    }
+  return result;
+#else
+  return this->wakeup_pipe_.close ();
+#endif /* ACE_HAS_EVENTFD */
+}
+
+int
+ACE_MPSC_Notification_Queue::push (ACE_Notification_Buffer const &buffer)
+{
+  ACE_TRACE ("ACE_MPSC_Notification_Queue::push");
+
+  if (buffer.eh_ != 0)
+    {
+      Node *node = 0;
+      ACE_NEW_RETURN (node, Node, -1);
+      node->buffer_ = buffer;
+      this->enqueue (node);
+    }
+
+  return this->signal ();
+}
+
+int
+ACE_MPSC_Notification_Queue::pop (ACE_Notification_Buffer &buffer)
+{
+  ACE_TRACE ("ACE_MPSC_Notification_Queue::pop");
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, mon, this->consumer_lock_, -1);
+
+  bool cleared = false;
+
+  for (;;)
+    {
+      Node *node = this->dequeue ();
+
+      if (node == 0)
+        {
+          if (cleared)
+            return 0;
+
+          // Clear the wakeup handle, then look again: anything pushed
+          // before that is seen now, anything pushed after it signals
+          // the handle again.
+          this->clear ();
+          cleared = true;
+          continue;
+        }
+
+      ACE_Notification_Buffer const contents = node->buffer_;
+      delete node;
+
+      // Skip the notifications purged while queued.
+      if (contents.eh_ == 0)
+        continue;
+
+      // Producers which found the handle signaled before it was
+      // cleared may have left more notifications behind this one, and
+      // the caller may not come back unless the handle is readable.
+      if (cleared && this->signal () == -1)
+        return -1;
+
+      buffer = contents;
+      return 1;
+    }
+}
+
+int
+ACE_MPSC_Notification_Queue::purge_pending_notifications (
+  ACE_Event_Handler *eh,
+  ACE_Reactor_Mask mask)
+{
+  ACE_TRACE ("ACE_MPSC_Notification_Queue::purge_pending_notifications");
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, mon, this->consumer_lock_, -1);
+
+  // Nodes cannot be unlinked from the middle of the list while
+  // producers push, so purged nodes lose their handler and are
+  // discarded by pop().  Nodes still being linked are not visited.
+  int number_purged = 0;
+
+  for (Node *node = this->tail_; node != 0; node = node->next_)
+    {
+      ACE_Notification_Buffer &b = node->buffer_;
+
+      if (node == &this->stub_ || b.eh_ == 0 || (eh != 0 && eh != b.eh_))
+        continue;
+
+      if (!ACE_BIT_DISABLED (b.mask_, ~mask))
+        {
+          ACE_CLR_BITS (b.mask_, mask);
+          continue;
+        }
+
+      b.eh_->remove_reference ();
+      b.eh_ = 0;
+      ++number_purged;
+    }
+
+  return number_purged;
+}
+
+ACE_MPSC_Notification_Queue::Node *
+ACE_MPSC_Notification_Queue::dequeue (void)
+{
+  Node *tail = this->tail_;
+  Node *next = tail->next_;
+
+  if (tail == &this->stub_)
+    {
+      if (next == 0)
+        return 0;
+
+      this->tail_ = next;
+      tail = next;
+      next = next->next_;
+    }
+
+  if (next == 0)
+    {
+      // <tail> is the last node; it can only be taken once something
+      // else follows it, so put the stub back behind it.
+      if (tail != this->head_)
+        return 0;
+
+      this->enqueue (&this->stub_);
+      next = tail->next_;
+
+      if (next == 0)
+        return 0;
+    }
+
+  this->tail_ = next;
+
+  // Pairs with the barrier in enqueue(): the contents of <tail> are
+  // read after its link.
+  __sync_synchronize ();
+  return tail;
+}
+
+int
+ACE_MPSC_Notification_Queue::signal (void)
+{
+  // __sync_lock_test_and_set() is only an acquire barrier: without a
+  // full one, the link enqueue() stored could become visible after the
+  // flag is read.  See clear().
+  __sync_synchronize ();
+  if (__sync_lock_test_and_set (&this->signaled_, 1) != 0)
+    return 0;
+
+#if defined (ACE_HAS_EVENTFD)
+  ACE_UINT64 const one = 1;
+  ssize_t const n = ACE_OS::write (this->event_handle_, &one, sizeof one);
+#else
+  char const one = 1;
+  ssize_t const n = ACE::send (this->wakeup_pipe_.write_handle (),
+                               &one,
+                               sizeof one);
+#endif /* ACE_HAS_EVENTFD */
+
+  if (n == -1 && errno != EWOULDBLOCK && errno != EAGAIN)
+    {
+      __sync_lock_release (&this->signaled_);
+      return -1;
+    }
+
+  return 0;
+}
+
+void
+ACE_MPSC_Notification_Queue::clear (void)
+{
+#if defined (ACE_HAS_EVENTFD)
+  ACE_UINT64 count;
+  (void) ACE_OS::read (this->event_handle_, &count, sizeof count);
+#else
+  char buf[64];
+  (void) ACE::recv (this->wakeup_pipe_.read_handle (), buf, sizeof buf);
+#endif /* ACE_HAS_EVENTFD */
+
+  __sync_lock_release (&this->signaled_);
+
+  // A producer stores the link to its node, then reads the flag; the
+  // consumer clears the flag, then reads the links again.  Each side
+  // has a full barrier between its store and its load, here and in
+  // signal(), so at least one of them sees the other's store: either
+  // the consumer finds the node, or the producer finds the flag clear
+  // and signals the handle.
+  __sync_synchronize ();
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
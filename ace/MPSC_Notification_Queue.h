@@ -0,0 +1,156 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    MPSC_Notification_Queue.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+#ifndef ACE_MPSC_NOTIFICATION_QUEUE_H
+#define ACE_MPSC_NOTIFICATION_QUEUE_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+
+#if !defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
+#  error ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE requires ACE_HAS_REACTOR_NOTIFICATION_QUEUE
+#endif /* !ACE_HAS_REACTOR_NOTIFICATION_QUEUE */
+
+#if !defined (ACE_HAS_GCC_ATOMIC_BUILTINS) || (ACE_HAS_GCC_ATOMIC_BUILTINS == 0)
+#  error ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE requires ACE_HAS_GCC_ATOMIC_BUILTINS
+#endif /* !ACE_HAS_GCC_ATOMIC_BUILTINS */
+
+#include "ace/Copy_Disabled.h"
+#include "ace/Event_Handler.h"
+#include "ace/Thread_Mutex.h"
+
+#if !defined (ACE_HAS_EVENTFD)
+#  include "ace/Pipe.h"
+#endif /* !ACE_HAS_EVENTFD */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_MPSC_Notification_Queue
+ *
+ * @brief Lock-free queue of reactor notifications, with its own
+ * wakeup handle.
+ *
+ * ACE_Notification_Queue serializes every notify() on a mutex, which
+ * becomes the bottleneck when many threads notify the same reactor.
+ * This queue is an intrusive multi-producer/single-consumer list:
+ * push() only takes an atomic exchange, so any number of threads may
+ * call it concurrently, while pop() is called by the reactor, which
+ * serializes its callers on its token.
+ *
+ * The queue also replaces the notification pipe.  handle() is an
+ * @c eventfd where available (a pipe otherwise) which is readable as
+ * long as notifications may be pending, and wakeups are coalesced:
+ * only the push() finding the queue idle writes to it, so one write
+ * covers any number of notifications queued before the reactor
+ * drains the queue.
+ */
+class ACE_Export ACE_MPSC_Notification_Queue : private ACE_Copy_Disabled
+{
+public:
+  ACE_MPSC_Notification_Queue (void);
+  ~ACE_MPSC_Notification_Queue (void);
+
+  /// Create the wakeup handle.
+  int open (void);
+
+  /// Release the event handlers still queued, free the nodes and
+  /// close the wakeup handle.
+  int close (void);
+
+  /// Handle to wait on for READ events.
+  ACE_HANDLE handle (void) const;
+
+  /**
+   * Queue @a buffer and wake up the reactor if it isn't already
+   * going to look at the queue.  A notification without an event
+   * handler only wakes up the reactor.  Safe to call from any number
+   * of threads.
+   *
+   * @return 0 on success, -1 on failure.
+   */
+  int push (ACE_Notification_Buffer const &buffer);
+
+  /**
+   * Remove the oldest notification and copy it to @a buffer.  When
+   * the queue is found empty the wakeup handle is cleared first, so
+   * that it becomes readable again on the next push().  Callers are
+   * serialized on a lock push() never takes.
+   *
+   * @return 1 if a notification was popped, 0 if the queue is empty.
+   */
+  int pop (ACE_Notification_Buffer &buffer);
+
+  /// Same as ACE_Notification_Queue::purge_pending_notifications();
+  /// purged notifications are left in the queue with no handler.
+  int purge_pending_notifications (ACE_Event_Handler *eh,
+                                   ACE_Reactor_Mask mask);
+
+private:
+  struct Node
+  {
+    Node * volatile next_;
+    ACE_Notification_Buffer buffer_;
+  };
+
+  /// Link @a node at the head of the list.
+  void enqueue (Node *node);
+
+  /// Unlink the node at the tail of the list; 0 if the list is empty
+  /// or its last node is still being linked.
+  Node *dequeue (void);
+
+  /// Write to the wakeup handle unless already signaled.
+  int signal (void);
+
+  /// Drain the wakeup handle and clear the signaled state.
+  void clear (void);
+
+private:
+  /// Most recently pushed node, exchanged by the producers.
+  Node * volatile head_;
+
+  /// Oldest node, only used by the consumer.
+  Node *tail_;
+
+  /// Placeholder keeping the list non-empty.
+  Node stub_;
+
+  /// 1 once the wakeup handle was written and not yet drained.
+  int volatile signaled_;
+
+#if defined (ACE_HAS_EVENTFD)
+  ACE_HANDLE event_handle_;
+#else
+  ACE_Pipe wakeup_pipe_;
+#endif /* ACE_HAS_EVENTFD */
+
+  /// Serializes pop(), purge_pending_notifications() and close().
+  ACE_SYNCH_MUTEX consumer_lock_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/MPSC_Notification_Queue.inl"
+#endif /* __ACE_INLINE__ */
+
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_MPSC_NOTIFICATION_QUEUE_H */
@@ -0,0 +1,31 @@
+// -*- C++ -*-
+//
+// $Id$
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE ACE_HANDLE
+ACE_MPSC_Notification_Queue::handle (void) const
+{
+#if defined (ACE_HAS_EVENTFD)
+  return this->event_handle_;
+#else
+  return this->wakeup_pipe_.read_handle ();
+#endif /* ACE_HAS_EVENTFD */
+}
+
+ACE_INLINE void
+ACE_MPSC_Notification_Queue::enqueue (Node *node)
+{
+  node->next_ = 0;
+
+  // Publish the contents of the node before it becomes reachable.
+  __sync_synchronize ();
+  Node *prev = __sync_lock_test_and_set (&this->head_, node);
+
+  // Between the exchange and this store the consumer sees the list
+  // end at <prev>; dequeue() then reports it empty.
+  prev->next_ = node;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,301 @@
+// $Id$
+
+#ifndef ACE_MAGAZINE_ALLOCATOR_T_CPP
+#define ACE_MAGAZINE_ALLOCATOR_T_CPP
+
+#include "ace/Magazine_Allocator_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if !defined (__ACE_INLINE__)
+#include "ace/Magazine_Allocator_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/Guard_T.h"
+#include "ace/Malloc.h"
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template <class ACE_LOCK>
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::Cache::Cache (void)
+  : allocator_ (0),
+    loaded_ (0),
+    previous_ (0)
+{
+}
+
+template <class ACE_LOCK>
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::Cache::~Cache (void)
+{
+  if (this->allocator_ != 0)
+    this->allocator_->release (this);
+}
+
+template <class ACE_LOCK>
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::Cache_TSS::Cache_TSS
+  (ACE_Dynamic_Magazine_Allocator<ACE_LOCK> *allocator)
+    : allocator_ (allocator)
+{
+}
+
+template <class ACE_LOCK>
+typename ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::Cache *
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::Cache_TSS::make_TSS_TYPE (void) const
+{
+  Cache *cache = 0;
+  ACE_NEW_RETURN (cache, Cache, 0);
+  cache->allocator_ = this->allocator_;
+  return cache;
+}
+
+template <class ACE_LOCK>
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::ACE_Dynamic_Magazine_Allocator
+  (size_t n_chunks, size_t chunk_size, size_t magazine_size)
+    : pool_ (0),
+      chunk_size_ (chunk_size),
+      magazine_size_ (magazine_size),
+      full_ (0),
+      empty_ (0),
+      all_ (0),
+      loose_ (0),
+      depot_depth_ (0),
+      caches_ (0)
+{
+  ACE_ASSERT (chunk_size > 0);
+  ACE_ASSERT (magazine_size > 0);
+  chunk_size = ACE_MALLOC_ROUNDUP (chunk_size, ACE_MALLOC_ALIGN);
+  ACE_NEW (this->pool_, char[n_chunks * chunk_size]);
+  ACE_NEW (this->caches_, Cache_TSS (this));
+
+  // Load the chunks in full magazines, the last one possibly not
+  // quite full.
+  for (size_t c = 0; c < n_chunks; )
+    {
+      Magazine *magazine = this->make_magazine ();
+      if (magazine == 0)
+        return;
+
+      for (; c < n_chunks && magazine->count_ < magazine_size; ++c)
+        magazine->rounds_[magazine->count_++] = this->pool_ + c * chunk_size;
+
+      magazine->next_ = this->full_;
+      this->full_ = magazine;
+      this->depot_depth_ += magazine->count_;
+    }
+}
+
+template <class ACE_LOCK>
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::~ACE_Dynamic_Magazine_Allocator (void)
+{
+  // Puts the magazines of the calling thread back in the depot; the
+  // other threads are gone and returned theirs already.
+  delete this->caches_;
+  this->caches_ = 0;
+
+  while (this->all_ != 0)
+    {
+      Magazine *magazine = this->all_;
+      this->all_ = magazine->all_next_;
+      delete [] magazine->rounds_;
+      delete magazine;
+    }
+
+  delete [] this->pool_;
+  this->pool_ = 0;
+  this->full_ = 0;
+  this->empty_ = 0;
+  this->loose_ = 0;
+  this->depot_depth_ = 0;
+}
+
+template <class ACE_LOCK> void *
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::calloc (size_t nbytes,
+                                                  char initial_value)
+{
+  void *ptr = this->malloc (nbytes);
+  if (ptr != 0)
+    ACE_OS::memset (ptr, initial_value, this->chunk_size_);
+  return ptr;
+}
+
+template <class ACE_LOCK> void *
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::calloc (size_t, size_t, char)
+{
+  ACE_NOTSUP_RETURN (0);
+}
+
+template <class ACE_LOCK> void
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::flush (void)
+{
+  Cache *cache = this->caches_->ts_object ();
+  if (cache != 0)
+    this->release (cache);
+}
+
+// Create an empty magazine, linked in <all_>.  Called with the lock
+// held, or from the constructor.
+
+template <class ACE_LOCK>
+typename ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::Magazine *
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::make_magazine (void)
+{
+  Magazine *magazine = 0;
+  ACE_NEW_RETURN (magazine, Magazine, 0);
+
+  magazine->rounds_ = 0;
+  ACE_NEW_NORETURN (magazine->rounds_, void *[this->magazine_size_]);
+  if (magazine->rounds_ == 0)
+    {
+      delete magazine;
+      return 0;
+    }
+
+  magazine->next_ = 0;
+  magazine->count_ = 0;
+  magazine->all_next_ = this->all_;
+  this->all_ = magazine;
+  return magazine;
+}
+
+// Called by malloc() when the loaded magazine of <cache> is empty:
+// swap it with the previous one if that one has chunks, otherwise
+// trade the previous one for a full magazine of the depot.  Returns
+// a chunk of the new loaded magazine, a loose chunk of the depot if
+// it has no full magazine, or 0 if the depot is empty too.
+
+template <class ACE_LOCK> void *
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::exchange_full (Cache *cache)
+{
+  Magazine *previous = cache->previous_;
+
+  if (previous == 0 || previous->count_ == 0)
+    {
+      ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, 0);
+
+      Magazine *full = this->full_;
+      if (full == 0)
+        {
+          void *ptr = this->loose_;
+          if (ptr != 0)
+            {
+              this->loose_ = *static_cast<void **> (ptr);
+              --this->depot_depth_;
+            }
+          return ptr;
+        }
+
+      this->full_ = full->next_;
+      this->depot_depth_ -= full->count_;
+
+      if (previous != 0)
+        {
+          previous->next_ = this->empty_;
+          this->empty_ = previous;
+        }
+
+      previous = full;
+    }
+
+  cache->previous_ = cache->loaded_;
+  cache->loaded_ = previous;
+  return previous->rounds_[--previous->count_];
+}
+
+// Called by free() when the loaded magazine of <cache> is full: swap
+// it with the previous one if that one is empty, otherwise trade the
+// previous one for an empty magazine of the depot.  Then puts <ptr>
+// in the new loaded magazine.  Returns -1, leaving <ptr> to the
+// caller, if no empty magazine could be had.
+
+template <class ACE_LOCK> int
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::exchange_empty (Cache *cache,
+                                                          void *ptr)
+{
+  Magazine *previous = cache->previous_;
+
+  if (previous == 0 || previous->count_ != 0)
+    {
+      ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, -1);
+
+      Magazine *empty = this->empty_;
+      if (empty != 0)
+        this->empty_ = empty->next_;
+      else if ((empty = this->make_magazine ()) == 0)
+        return -1;
+
+      if (previous != 0)
+        {
+          previous->next_ = this->full_;
+          this->full_ = previous;
+          this->depot_depth_ += previous->count_;
+        }
+
+      previous = empty;
+    }
+
+  cache->previous_ = cache->loaded_;
+  cache->loaded_ = previous;
+  previous->rounds_[previous->count_++] = ptr;
+  return 0;
+}
+
+// Called by free() when <ptr> can't go in a magazine, because the
+// calling thread has no cache or no empty magazine could be had: put
+// it in the depot on its own, so that it isn't lost.
+
+template <class ACE_LOCK> void
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::deposit (void *ptr)
+{
+  ACE_GUARD (ACE_LOCK, ace_mon, this->lock_);
+
+  *static_cast<void **> (ptr) = this->loose_;
+  this->loose_ = ptr;
+  ++this->depot_depth_;
+}
+
+// Put the magazines of <cache> back in the depot.
+
+template <class ACE_LOCK> void
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::release (Cache *cache)
+{
+  ACE_GUARD (ACE_LOCK, ace_mon, this->lock_);
+
+  Magazine *magazines[2] = { cache->loaded_, cache->previous_ };
+  cache->loaded_ = 0;
+  cache->previous_ = 0;
+
+  for (size_t i = 0; i < 2; ++i)
+    {
+      Magazine *magazine = magazines[i];
+      if (magazine == 0)
+        continue;
+
+      if (magazine->count_ == 0)
+        {
+          magazine->next_ = this->empty_;
+          this->empty_ = magazine;
+        }
+      else
+        {
+          magazine->next_ = this->full_;
+          this->full_ = magazine;
+          this->depot_depth_ += magazine->count_;
+        }
+    }
+}
+
+template <class T, class ACE_LOCK>
+ACE_Magazine_Allocator<T, ACE_LOCK>::ACE_Magazine_Allocator (size_t n_chunks,
+                                                             size_t magazine_size)
+  : ACE_Dynamic_Magazine_Allocator<ACE_LOCK> (n_chunks,
+                                              sizeof (T),
+                                              magazine_size)
+{
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_MAGAZINE_ALLOCATOR_T_CPP */
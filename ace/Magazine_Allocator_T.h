@@ -0,0 +1,233 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Magazine_Allocator_T.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+#ifndef ACE_MAGAZINE_ALLOCATOR_T_H
+#define ACE_MAGAZINE_ALLOCATOR_T_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Malloc_Allocator.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/TSS_T.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Dynamic_Magazine_Allocator
+ *
+ * @brief A size-based allocator that caches blocks per thread, in
+ * magazines, in front of a shared depot.
+ *
+ * ACE_Dynamic_Cached_Allocator takes its lock on every malloc() and
+ * free(), so threads allocating from the same pool all contend on
+ * it.  This allocator follows Bonwick's magazine design instead:
+ * every thread holds up to two magazines, arrays of up to
+ * @a magazine_size free chunks, in thread-specific storage.
+ * malloc() and free() only take and put chunks in those magazines;
+ * only when both are empty (or both full) is a magazine exchanged
+ * with the depot, under @a ACE_LOCK, for a full (or empty) one.  The
+ * lock is therefore taken once every @a magazine_size operations at
+ * most.
+ *
+ * A chunk may be freed by any thread, not only the one that
+ * allocated it.  When a thread exits, its magazines go back to the
+ * depot.  Chunks cached by a thread can't be allocated by the other
+ * ones, so malloc() may return 0 while other threads hold free
+ * chunks; up to two magazines per thread must be counted on top of
+ * what the application needs.
+ *
+ * Each allocator uses a thread-specific storage key, and must only
+ * be destroyed once the threads that used it, other than the calling
+ * one, have exited.
+ *
+ * @sa ACE_Dynamic_Cached_Allocator
+ */
+template <class ACE_LOCK>
+class ACE_Dynamic_Magazine_Allocator : public ACE_New_Allocator
+{
+public:
+  /// Create a cached memory pool with @a n_chunks chunks each with
+  /// @a chunk_size size, which threads take and return in magazines
+  /// of @a magazine_size chunks.
+  ACE_Dynamic_Magazine_Allocator (size_t n_chunks,
+                                  size_t chunk_size,
+                                  size_t magazine_size = ACE_DEFAULT_MAGAZINE_SIZE);
+
+  /// Clear things up.
+  ~ACE_Dynamic_Magazine_Allocator (void);
+
+  /**
+   * Get a chunk of memory from the magazines of the calling thread.
+   * Note that @a nbytes is only checked to make sure that it's less or
+   * equal to @a chunk_size, and is otherwise ignored since malloc()
+   * always returns a pointer to an item of @a chunk_size size.
+   */
+  void *malloc (size_t nbytes = 0);
+
+  /**
+   * Get a chunk of memory from the magazines of the calling thread,
+   * giving them @a initial_value.  Note that @a nbytes is only
+   * checked to make sure that it's less or equal to @a chunk_size,
+   * and is otherwise ignored since calloc() always returns a pointer
+   * to an item of @a chunk_size.
+   */
+  virtual void *calloc (size_t nbytes,
+                        char initial_value = '\0');
+
+  /// This method is a no-op and just returns 0 since the magazines
+  /// only work with fixed sized entities.
+  virtual void *calloc (size_t n_elem,
+                        size_t elem_size,
+                        char initial_value = '\0');
+
+  /// Return a chunk of memory back to the magazines of the calling
+  /// thread.
+  void free (void *);
+
+  /// Return the magazines of the calling thread to the depot.
+  void flush (void);
+
+  /// Return the number of chunks available in the depot, not
+  /// counting those cached by the threads.
+  size_t pool_depth (void);
+
+private:
+  /// An array of free chunks.
+  struct Magazine
+  {
+    /// Next magazine in its depot list.
+    Magazine *next_;
+
+    /// Next magazine ever created by the allocator.
+    Magazine *all_next_;
+
+    /// Number of chunks in <rounds_>.
+    size_t count_;
+
+    /// The chunks.
+    void **rounds_;
+  };
+
+  /// The magazines of one thread.
+  struct Cache
+  {
+    Cache (void);
+
+    /// Returns the magazines to the depot.
+    ~Cache (void);
+
+    /// Allocator owning the magazines.
+    ACE_Dynamic_Magazine_Allocator<ACE_LOCK> *allocator_;
+
+    /// Magazine malloc() and free() work on.
+    Magazine *loaded_;
+
+    /// Magazine swapped with <loaded_> before going to the depot.
+    Magazine *previous_;
+  };
+
+  /// Creates the caches of the threads with a link back to the
+  /// allocator.
+  class Cache_TSS : public ACE_TSS<Cache>
+  {
+  public:
+    Cache_TSS (ACE_Dynamic_Magazine_Allocator<ACE_LOCK> *allocator);
+
+    virtual Cache *make_TSS_TYPE (void) const;
+
+  private:
+    ACE_Dynamic_Magazine_Allocator<ACE_LOCK> *allocator_;
+  };
+
+  friend struct Cache;
+  friend class Cache_TSS;
+
+  // The following are documented in the .cpp file.
+  Magazine *make_magazine (void);
+  void *exchange_full (Cache *cache);
+  int exchange_empty (Cache *cache, void *ptr);
+  void deposit (void *ptr);
+  void release (Cache *cache);
+
+private:
+  /// Remember how we allocate the memory in the first place so
+  /// we can clear things up later.
+  char *pool_;
+
+  /// Remember the size of our chunks.
+  size_t chunk_size_;
+
+  /// Number of chunks a magazine holds.
+  size_t magazine_size_;
+
+  /// Magazines holding chunks, in the depot.
+  Magazine *full_;
+
+  /// Empty magazines, in the depot.
+  Magazine *empty_;
+
+  /// Every magazine created, to delete them.
+  Magazine *all_;
+
+  /// Chunks freed without a magazine to hold them, in the depot,
+  /// linked through their first word.
+  void *loose_;
+
+  /// Number of chunks in the magazines of <full_> and in <loose_>.
+  size_t depot_depth_;
+
+  /// Serializes the depot.
+  ACE_LOCK lock_;
+
+  /// Magazines of each thread.
+  Cache_TSS *caches_;
+};
+
+/**
+ * @class ACE_Magazine_Allocator
+ *
+ * @brief A fixed-size allocator that caches items of type @a T per
+ * thread, in magazines, in front of a shared depot.
+ *
+ * This is ACE_Dynamic_Magazine_Allocator with chunks the size of
+ * @a T, as ACE_Cached_Allocator is for ACE_Dynamic_Cached_Allocator.
+ *
+ * @sa ACE_Cached_Allocator
+ */
+template <class T, class ACE_LOCK>
+class ACE_Magazine_Allocator : public ACE_Dynamic_Magazine_Allocator<ACE_LOCK>
+{
+public:
+  /// Create a cached memory pool with @a n_chunks chunks each with
+  /// sizeof (T) size, which threads take and return in magazines of
+  /// @a magazine_size chunks.
+  ACE_Magazine_Allocator (size_t n_chunks,
+                          size_t magazine_size = ACE_DEFAULT_MAGAZINE_SIZE);
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/Magazine_Allocator_T.inl"
+#endif /* __ACE_INLINE__ */
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Magazine_Allocator_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Magazine_Allocator_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_MAGAZINE_ALLOCATOR_T_H */
@@ -0,0 +1,52 @@
+// -*- C++ -*-
+//
+// $Id$
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template <class ACE_LOCK> ACE_INLINE void *
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::malloc (size_t nbytes)
+{
+  // Check if size requested fits within pre-determined size.
+  if (nbytes > this->chunk_size_)
+    return 0;
+
+  Cache *cache = *this->caches_;
+  if (cache == 0)
+    return 0;
+
+  Magazine *loaded = cache->loaded_;
+  if (loaded != 0 && loaded->count_ > 0)
+    return loaded->rounds_[--loaded->count_];
+
+  return this->exchange_full (cache);
+}
+
+template <class ACE_LOCK> ACE_INLINE void
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::free (void *ptr)
+{
+  if (ptr == 0)
+    return;
+
+  Cache *cache = *this->caches_;
+  if (cache == 0)
+    {
+      this->deposit (ptr);
+      return;
+    }
+
+  Magazine *loaded = cache->loaded_;
+  if (loaded != 0 && loaded->count_ < this->magazine_size_)
+    loaded->rounds_[loaded->count_++] = ptr;
+  else if (this->exchange_empty (cache, ptr) == -1)
+    this->deposit (ptr);
+}
+
+template <class ACE_LOCK> ACE_INLINE size_t
+ACE_Dynamic_Magazine_Allocator<ACE_LOCK>::pool_depth (void)
+{
+  ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->lock_, 0);
+  return this->depot_depth_;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
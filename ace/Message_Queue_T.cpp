@@ -261,6 +261,74 @@ ACE_Message_Queue_Ex<ACE_MESSAGE_TYPE, ACE_SYNCH_USE, TIME_POLICY>::dequeue_head
   return cur_count;
 }
 
+// Enqueue the items at the end of the queue.  Their message blocks are
+// enqueued as a batch, so that the queue takes its lock once unless it
+// fills up.
+
+template <class ACE_MESSAGE_TYPE, ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Ex<ACE_MESSAGE_TYPE, ACE_SYNCH_USE, TIME_POLICY>::enqueue_batch (ACE_MESSAGE_TYPE *new_items[],
+                                                                      size_t count,
+                                                                      ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Message_Queue_Ex<ACE_MESSAGE_TYPE, ACE_SYNCH_USE, TIME_POLICY>::enqueue_batch");
+
+  if (count == 0)
+    return 0;
+
+  ACE_Message_Block **mbs = 0;
+  ACE_NEW_RETURN (mbs, ACE_Message_Block *[count], -1);
+
+  size_t i = 0;
+  for (; i < count; ++i)
+    {
+      ACE_NEW_NORETURN (mbs[i],
+                        ACE_Message_Block ((char *) new_items[i],
+                                           sizeof (*new_items[i]),
+                                           ACE_Message_Queue_Ex<ACE_MESSAGE_TYPE, ACE_SYNCH_USE, TIME_POLICY>::DEFAULT_PRIORITY));
+      if (mbs[i] == 0)
+        break;
+    }
+
+  int result = -1;
+  if (i == count)
+    result = this->queue_.enqueue_batch (mbs, count, timeout);
+  else
+    errno = ENOMEM;
+
+  // Zap the messages not enqueued.
+  for (size_t j = result == -1 ? 0 : static_cast<size_t> (result); j < i; ++j)
+    mbs[j]->release ();
+
+  delete [] mbs;
+  return result;
+}
+
+// Remove up to count items from the front of the queue, waiting for
+// the first one until timeout (or indefinitely if timeout == 0).
+
+template <class ACE_MESSAGE_TYPE, ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue_Ex<ACE_MESSAGE_TYPE, ACE_SYNCH_USE, TIME_POLICY>::dequeue_batch (ACE_MESSAGE_TYPE *first_items[],
+                                                                      size_t count,
+                                                                      ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Message_Queue_Ex<ACE_MESSAGE_TYPE, ACE_SYNCH_USE, TIME_POLICY>::dequeue_batch");
+
+  ACE_Message_Block **mbs = 0;
+  ACE_NEW_RETURN (mbs, ACE_Message_Block *[count], -1);
+
+  int const dequeued = this->queue_.dequeue_batch (mbs, count, timeout);
+
+  for (int i = 0; i < dequeued; ++i)
+    {
+      first_items[i] = reinterpret_cast<ACE_MESSAGE_TYPE *> (mbs[i]->base ());
+      // Delete the message block.
+      mbs[i]->release ();
+    }
+
+  delete [] mbs;
+  return dequeued;
+}
+
 // Remove the item with the lowest priority from the queue.  If timeout == 0
 // block indefinitely (or until an alert occurs).  Otherwise, block for upto
 // the amount of time specified by timeout.
@@ -1520,6 +1588,46 @@ ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head_i (ACE_Message_Block
     return ACE_Utils::truncate_cast<int> (this->cur_count_);
 }
 
+// Put the nodes at the end, each with the tail enqueueing semantics of
+// this queue, until the queue is full (no locking, so must be called
+// with locks held).  The first node goes in regardless; the caller has
+// waited for room for it.
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_batch_i (ACE_Message_Block *new_items[],
+                                                   size_t count)
+{
+  ACE_TRACE ("ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_batch_i");
+
+  size_t i = 0;
+  for (; i < count && (i == 0 || !this->is_full_i ()); ++i)
+    if (this->enqueue_tail_i (new_items[i]) == -1)
+      break;
+
+  return i == 0 ? -1 : ACE_Utils::truncate_cast<int> (i);
+}
+
+// Get up to count nodes from the head (no locking, so must be called
+// with locks held).  This method assumes that the queue has at least
+// one item in it when it is called.
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_batch_i (ACE_Message_Block *first_items[],
+                                                   size_t count)
+{
+  ACE_TRACE ("ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_batch_i");
+
+  size_t dequeued = 0;
+  while (dequeued < count && !this->is_empty_i ())
+    {
+      if (this->dequeue_head_i (first_items[dequeued]) == -1)
+        break;
+      ++dequeued;
+    }
+
+  return dequeued == 0 ? -1 : ACE_Utils::truncate_cast<int> (dequeued);
+}
+
 // Get the earliest (i.e., FIFO) ACE_Message_Block with the lowest
 // priority (no locking, so must be called with locks held).  This
 // method assumes that the queue has at least one item in it when it
@@ -1973,6 +2081,96 @@ ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head (ACE_Message_Block *
   return this->dequeue_head_i (first_item);
 }
 
+// Enqueue a batch of items at the end of the queue, taking the lock
+// and notifying once for the whole batch.
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_batch (ACE_Message_Block *new_items[],
+                                                 size_t count,
+                                                 ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_batch");
+
+  for (size_t i = 0; i < count; ++i)
+    if (new_items[i] == 0)
+      {
+        errno = EINVAL;
+        return -1;
+      }
+
+  if (count == 0)
+    return 0;
+
+  // Each run of blocks enqueued without waiting is followed by one
+  // notification, so that a consumer driven by the notification
+  // strategy drains the queue while this thread waits for room.
+  size_t enqueued = 0;
+  while (enqueued < count)
+    {
+      ACE_Notification_Strategy *notifier = 0;
+      {
+        ACE_GUARD_RETURN (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_,
+                          enqueued == 0 ? -1 : ACE_Utils::truncate_cast<int> (enqueued));
+
+        if (this->state_ == ACE_Message_Queue_Base::DEACTIVATED)
+          {
+            errno = ESHUTDOWN;
+            break;
+          }
+
+        if (this->wait_not_full_cond (timeout) == -1)
+          break;
+
+        int const result = this->enqueue_batch_i (new_items + enqueued,
+                                                  count - enqueued);
+        if (result == -1)
+          break;
+        enqueued += result;
+
+#if defined (ACE_HAS_MONITOR_POINTS) && (ACE_HAS_MONITOR_POINTS == 1)
+        this->monitor_->receive (this->cur_length_);
+#endif
+        notifier = this->notification_strategy_;
+      }
+      if (0 != notifier)
+        notifier->notify ();
+    }
+
+  return enqueued == 0 ? -1 : ACE_Utils::truncate_cast<int> (enqueued);
+}
+
+// Remove up to count items from the front of the queue, taking the
+// lock once.  If timeout == 0 block indefinitely for the first item
+// (or until an alert occurs).  Otherwise, block for upto the amount
+// of time specified by timeout.
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_batch (ACE_Message_Block *first_items[],
+                                                 size_t count,
+                                                 ACE_Time_Value *timeout)
+{
+  ACE_TRACE ("ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_batch");
+
+  if (count == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX_T, ace_mon, this->lock_, -1);
+
+  if (this->state_ == ACE_Message_Queue_Base::DEACTIVATED)
+    {
+      errno = ESHUTDOWN;
+      return -1;
+    }
+
+  if (this->wait_not_empty_cond (timeout) == -1)
+    return -1;
+
+  return this->dequeue_batch_i (first_items, count);
+}
+
 // Remove item with the lowest priority from the queue.  If timeout == 0 block
 // indefinitely (or until an alert occurs).  Otherwise, block for upto
 // the amount of time specified by timeout.
@@ -2259,6 +2457,38 @@ ACE_Dynamic_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_head (ACE_Message
   return result;
 }
 
+// Enqueue each message of the batch according to its priority.
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Dynamic_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_batch_i (ACE_Message_Block *new_items[],
+                                                           size_t count)
+{
+  ACE_TRACE ("ACE_Dynamic_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::enqueue_batch_i");
+
+  size_t i = 0;
+  for (; i < count && (i == 0 || !this->is_full_i ()); ++i)
+    if (this->enqueue_i (new_items[i]) == -1)
+      break;
+
+  return i == 0 ? -1 : ACE_Utils::truncate_cast<int> (i);
+}
+
+// Refresh the priority status boundaries, then dequeue from the
+// (logical) head of the queue.
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Dynamic_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_batch_i (ACE_Message_Block *first_items[],
+                                                           size_t count)
+{
+  ACE_TRACE ("ACE_Dynamic_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_batch_i");
+
+  if (this->refresh_queue (ACE_OS::gettimeofday ()) < 0)
+    return -1;
+
+  return ACE_Message_Queue<ACE_SYNCH_USE, TIME_POLICY>::dequeue_batch_i (first_items,
+                                                            count);
+}
+
 // Dequeue and return the <ACE_Message_Block *> at the (logical) head
 // of the queue.
 
@@ -299,6 +299,56 @@ public:
   virtual int dequeue_head (ACE_Message_Block *&first_item,
                             ACE_Time_Value *timeout = 0);
 
+  /**
+   * Enqueue the @a count ACE_Message_Block objects of @a new_items at
+   * the tail of the queue, in order, as if by enqueue_tail() (each
+   * block's @c next() chain is enqueued with it).  The queue lock is
+   * taken once for all the blocks, and the notification strategy is
+   * notified once, rather than once per block, as long as the queue
+   * has room for them.  The queue is checked for room before each
+   * block; when it is full the notification strategy is notified of
+   * the blocks enqueued so far and the caller waits for room, as
+   * enqueue_tail() does.
+   *
+   * @param new_items Array of @a count blocks to enqueue.
+   * @param count     Number of blocks in @a new_items.
+   * @param timeout   The absolute time the caller will wait until
+   *                  for the queue to have room for the blocks.
+   *
+   * @retval >=0 The number of elements of @a new_items enqueued, the
+   *             first ones of them; less than @a count if the queue
+   *             stayed full until @a timeout or was deactivated or
+   *             pulsed part way through.
+   * @retval -1 On failure, with none of the blocks enqueued.  errno
+   *            holds the reason. Common errno values are:
+   *            - EWOULDBLOCK: the timeout elapsed
+   *            - ESHUTDOWN: the queue was deactivated or pulsed
+   */
+  virtual int enqueue_batch (ACE_Message_Block *new_items[],
+                             size_t count,
+                             ACE_Time_Value *timeout = 0);
+
+  /**
+   * Dequeue up to @a count ACE_Message_Block objects from the head of
+   * the queue into @a first_items, taking the queue lock once.  Waits
+   * only for the first block: once the queue has one, as many blocks
+   * as it holds (up to @a count) are dequeued.
+   *
+   * @param first_items Array of at least @a count elements set to the
+   *                    addresses of the dequeued blocks, in order.
+   * @param count       Maximum number of blocks to dequeue.
+   * @param timeout     The absolute time the caller will wait until
+   *                    for a block to be dequeued.
+   *
+   * @retval >0 The number of ACE_Message_Blocks dequeued.
+   * @retval -1 On failure.  errno holds the reason. Common errno values are:
+   *            - EWOULDBLOCK: the timeout elapsed
+   *            - ESHUTDOWN: the queue was deactivated or pulsed
+   */
+  virtual int dequeue_batch (ACE_Message_Block *first_items[],
+                             size_t count,
+                             ACE_Time_Value *timeout = 0);
+
   /**
    * Dequeue the ACE_Message_Block that has the lowest priority (preserves
    * FIFO order for messages with the same priority) and return a pointer
@@ -524,6 +574,17 @@ protected:
   /// queue.
   virtual int dequeue_head_i (ACE_Message_Block *&first_item);
 
+  /// Enqueue the <ACE_Message_Block *> of @a new_items at the end of
+  /// the queue until all @a count are or the queue is full; the first
+  /// one is enqueued regardless.  Returns the number enqueued.
+  virtual int enqueue_batch_i (ACE_Message_Block *new_items[],
+                               size_t count);
+
+  /// Dequeue up to @a count <ACE_Message_Block *> from the head of the
+  /// queue into @a first_items; returns the number dequeued.
+  virtual int dequeue_batch_i (ACE_Message_Block *first_items[],
+                               size_t count);
+
   /// Dequeue and return the <ACE_Message_Block *> with the lowest
   /// priority.
   virtual int dequeue_prio_i (ACE_Message_Block *&dequeued);
@@ -871,6 +932,17 @@ protected:
    */
   virtual int dequeue_head_i (ACE_Message_Block *&first_item);
 
+  /// Enqueue each of the @a count messages of @a new_items in
+  /// accordance with its priority, as enqueue_tail() does, until the
+  /// queue is full; the first one is enqueued regardless.
+  virtual int enqueue_batch_i (ACE_Message_Block *new_items[],
+                               size_t count);
+
+  /// Refresh the queue, then dequeue up to @a count messages from the
+  /// head of the logical queue.
+  virtual int dequeue_batch_i (ACE_Message_Block *first_items[],
+                               size_t count);
+
   /// Refresh the queue using the strategy
   /// specific priority status function.
   virtual int refresh_queue (const ACE_Time_Value & current_time);
@@ -1214,6 +1286,38 @@ public:
   virtual int dequeue_head (ACE_MESSAGE_TYPE *&first_item,
                             ACE_Time_Value *timeout = 0);
 
+  /**
+   * Enqueue the @a count items of @a new_items at the tail of the
+   * queue, in order, taking the queue lock once unless the queue
+   * fills up, as ACE_Message_Queue::enqueue_batch() does.
+   *
+   * @retval >=0 The number of items enqueued, the first ones of
+   *             @a new_items; less than @a count if the queue stayed
+   *             full until @a timeout or was deactivated part way
+   *             through.
+   * @retval -1 On failure, with none of the items enqueued.  errno
+   *            holds the reason. Common errno values are:
+   *            - EWOULDBLOCK: the timeout elapsed
+   *            - ESHUTDOWN: the queue was deactivated or pulsed
+   */
+  virtual int enqueue_batch (ACE_MESSAGE_TYPE *new_items[],
+                             size_t count,
+                             ACE_Time_Value *timeout = 0);
+
+  /**
+   * Dequeue up to @a count items from the head of the queue into
+   * @a first_items, taking the queue lock once.  Waits only until the
+   * queue has an item.
+   *
+   * @retval >0 The number of items dequeued.
+   * @retval -1 On failure.  errno holds the reason. Common errno values are:
+   *            - EWOULDBLOCK: the timeout elapsed
+   *            - ESHUTDOWN: the queue was deactivated or pulsed
+   */
+  virtual int dequeue_batch (ACE_MESSAGE_TYPE *first_items[],
+                             size_t count,
+                             ACE_Time_Value *timeout = 0);
+
   /**
    * Dequeue the item that has the lowest priority (preserves
    * FIFO order for items with the same priority) and return a pointer
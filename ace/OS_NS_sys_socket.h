@@ -181,6 +181,16 @@ namespace ACE_OS
                    struct msghdr *msg,
                    int flags);
 
+#if defined (ACE_HAS_RECVMMSG)
+  /// Receive up to @a vlen datagrams into @a msgvec with one call.
+  /// Returns the number received, or -1.
+  ACE_NAMESPACE_INLINE_FUNCTION
+  int recvmmsg (ACE_HANDLE handle,
+                struct mmsghdr *msgvec,
+                unsigned int vlen,
+                int flags);
+#endif /* ACE_HAS_RECVMMSG */
+
   ACE_NAMESPACE_INLINE_FUNCTION
   ssize_t recvv (ACE_HANDLE handle,
                  iovec *iov,
@@ -205,6 +215,16 @@ namespace ACE_OS
                    const struct msghdr *msg,
                    int flags);
 
+#if defined (ACE_HAS_SENDMMSG)
+  /// Send the @a vlen datagrams of @a msgvec with one call.  Returns
+  /// the number sent, or -1.
+  ACE_NAMESPACE_INLINE_FUNCTION
+  int sendmmsg (ACE_HANDLE handle,
+                struct mmsghdr *msgvec,
+                unsigned int vlen,
+                int flags);
+#endif /* ACE_HAS_SENDMMSG */
+
   ACE_NAMESPACE_INLINE_FUNCTION
   ssize_t sendto (ACE_HANDLE handle,
                   const char *buf,
@@ -70,7 +70,10 @@ public:
     PROACTOR_SUN    = 3,
 
     /// Callback notifications
-    PROACTOR_CB     = 4
+    PROACTOR_CB     = 4,
+
+    /// Linux io_uring submission/completion rings
+    PROACTOR_URING  = 5
   };
 
 
@@ -0,0 +1,357 @@
+// $Id$
+
+#include "ace/Reactor_Group.h"
+
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+
+#include "ace/Reactor.h"
+#include "ace/Dev_Poll_Reactor.h"
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/ACE.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/os_include/os_sched.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Reactor_Group)
+
+ACE_Reactor_Group::Handoff::Handoff (ACE_Event_Handler *eh,
+                                     ACE_Reactor *from,
+                                     ACE_Reactor *to)
+  : eh_ (eh)
+  , from_ (from)
+  , to_ (to)
+{
+}
+
+int
+ACE_Reactor_Group::Handoff::handle_exception (ACE_HANDLE)
+{
+  ACE_TRACE ("ACE_Reactor_Group::Handoff::handle_exception");
+
+  // Running in the thread of the source shard, so the handler is not
+  // in an upcall.  A handler removed meanwhile is left alone.
+  int const mask =
+    this->from_->mask_ops (this->eh_, 0, ACE_Reactor::GET_MASK);
+
+  if (mask > 0
+      && this->from_->remove_handler (this->eh_,
+                                      mask | ACE_Event_Handler::DONT_CALL) != -1
+      && this->to_->register_handler (this->eh_, mask) == -1)
+    {
+      ACELIB_ERROR ((LM_ERROR,
+                     ACE_TEXT ("%p\n"),
+                     ACE_TEXT ("ACE_Reactor_Group::handoff")));
+      this->eh_->handle_close (this->eh_->get_handle (), mask);
+    }
+
+  this->eh_->remove_reference ();
+
+  delete this;
+  return 0;
+}
+
+ACE_Reactor_Group::ACE_Reactor_Group (void)
+  : shards_ (0)
+  , size_ (0)
+  , next_ (0)
+  , pin_ (false)
+  , running_ (false)
+{
+  ACE_TRACE ("ACE_Reactor_Group::ACE_Reactor_Group");
+}
+
+ACE_Reactor_Group::~ACE_Reactor_Group (void)
+{
+  ACE_TRACE ("ACE_Reactor_Group::~ACE_Reactor_Group");
+
+  (void) this->close ();
+}
+
+int
+ACE_Reactor_Group::open (size_t shards,
+                         size_t max_events,
+                         bool edge_triggered)
+{
+  ACE_TRACE ("ACE_Reactor_Group::open");
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1));
+
+  if (this->shards_ != 0)
+    {
+      errno = EBUSY;
+      return -1;
+    }
+
+  if (shards == 0)
+    {
+      long const cpus = ACE_OS::num_processors_online ();
+      shards = cpus > 0 ? static_cast<size_t> (cpus) : 1;
+    }
+
+  ACE_NEW_RETURN (this->shards_, Shard[shards], -1);
+
+  for (size_t i = 0; i < shards; ++i)
+    {
+      Shard &s = this->shards_[i];
+      s.group_ = this;
+      s.reactor_ = 0;
+      s.index_ = i;
+      s.thr_id_ = ACE_OS::NULL_thread;
+    }
+  this->size_ = shards;
+
+  for (size_t i = 0; i < shards; ++i)
+    {
+      ACE_Dev_Poll_Reactor *impl = 0;
+      ACE_NEW_NORETURN (impl, ACE_Dev_Poll_Reactor);
+      if (impl == 0)
+        break;
+
+#if defined (ACE_HAS_EVENT_POLL)
+      if (max_events > 0 && impl->batch_events (max_events,
+                                                edge_triggered) == -1)
+        {
+          delete impl;
+          break;
+        }
+#else
+      ACE_UNUSED_ARG (max_events);
+      ACE_UNUSED_ARG (edge_triggered);
+#endif /* ACE_HAS_EVENT_POLL */
+
+      ACE_NEW_NORETURN (this->shards_[i].reactor_,
+                        ACE_Reactor (impl, true));
+      if (this->shards_[i].reactor_ == 0)
+        {
+          delete impl;
+          break;
+        }
+    }
+
+  if (this->shards_[shards - 1].reactor_ == 0)
+    {
+      ACE_Errno_Guard error (errno);
+      for (size_t i = 0; i < shards; ++i)
+        delete this->shards_[i].reactor_;
+      delete [] this->shards_;
+      this->shards_ = 0;
+      this->size_ = 0;
+      return -1;
+    }
+
+  this->next_ = 0;
+  return 0;
+}
+
+int
+ACE_Reactor_Group::start (bool pin)
+{
+  ACE_TRACE ("ACE_Reactor_Group::start");
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1));
+
+  if (this->shards_ == 0 || this->running_)
+    {
+      errno = this->shards_ == 0 ? EINVAL : EBUSY;
+      return -1;
+    }
+
+  this->pin_ = pin;
+
+  for (size_t i = 0; i < this->size_; ++i)
+    {
+      this->shards_[i].reactor_->reset_reactor_event_loop ();
+
+      if (this->thr_mgr_.spawn (&ACE_Reactor_Group::svc_run,
+                                &this->shards_[i],
+                                THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED,
+                                &this->shards_[i].thr_id_) == -1)
+        {
+          ACE_Errno_Guard error (errno);
+          for (size_t j = 0; j < i; ++j)
+            this->shards_[j].reactor_->end_reactor_event_loop ();
+          this->thr_mgr_.wait ();
+          return -1;
+        }
+    }
+
+  this->running_ = true;
+  return 0;
+}
+
+int
+ACE_Reactor_Group::stop (void)
+{
+  ACE_TRACE ("ACE_Reactor_Group::stop");
+
+  {
+    ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1));
+
+    if (!this->running_)
+      return 0;
+
+    if (this->current_shard () != -1)
+      {
+        errno = EDEADLK;
+        return -1;
+      }
+
+    for (size_t i = 0; i < this->size_; ++i)
+      this->shards_[i].reactor_->end_reactor_event_loop ();
+
+    this->running_ = false;
+  }
+
+  return this->thr_mgr_.wait ();
+}
+
+int
+ACE_Reactor_Group::close (void)
+{
+  ACE_TRACE ("ACE_Reactor_Group::close");
+
+  if (this->stop () == -1)
+    return -1;
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, -1));
+
+  for (size_t i = 0; i < this->size_; ++i)
+    delete this->shards_[i].reactor_;
+
+  delete [] this->shards_;
+  this->shards_ = 0;
+  this->size_ = 0;
+
+  return 0;
+}
+
+ACE_Reactor *
+ACE_Reactor_Group::reactor (size_t shard) const
+{
+  return shard < this->size_ ? this->shards_[shard].reactor_ : 0;
+}
+
+size_t
+ACE_Reactor_Group::size (void) const
+{
+  return this->size_;
+}
+
+ACE_Reactor *
+ACE_Reactor_Group::next_reactor (void)
+{
+  ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, 0));
+
+  if (this->size_ == 0)
+    return 0;
+
+  ACE_Reactor *r = this->shards_[this->next_].reactor_;
+  this->next_ = (this->next_ + 1) % this->size_;
+  return r;
+}
+
+ssize_t
+ACE_Reactor_Group::shard (const ACE_Reactor *reactor) const
+{
+  for (size_t i = 0; i < this->size_; ++i)
+    if (this->shards_[i].reactor_ == reactor)
+      return static_cast<ssize_t> (i);
+
+  return -1;
+}
+
+ssize_t
+ACE_Reactor_Group::current_shard (void) const
+{
+  ACE_thread_t const self = ACE_OS::thr_self ();
+
+  for (size_t i = 0; i < this->size_; ++i)
+    if (ACE_OS::thr_equal (this->shards_[i].thr_id_, self))
+      return static_cast<ssize_t> (i);
+
+  return -1;
+}
+
+int
+ACE_Reactor_Group::handoff (ACE_Event_Handler *eh, size_t shard)
+{
+  ACE_TRACE ("ACE_Reactor_Group::handoff");
+
+  ACE_Reactor *to = this->reactor (shard);
+  ACE_Reactor *from = eh == 0 ? 0 : eh->reactor ();
+
+  if (to == 0 || from == 0 || this->shard (from) == -1)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  if (from == to)
+    return 0;
+
+  Handoff *h = 0;
+  ACE_NEW_RETURN (h, Handoff (eh, from, to), -1);
+
+  eh->add_reference ();
+
+  if (from->notify (h) == -1)
+    {
+      eh->remove_reference ();
+      delete h;
+      return -1;
+    }
+
+  return 0;
+}
+
+ACE_THR_FUNC_RETURN
+ACE_Reactor_Group::svc_run (void *arg)
+{
+  Shard *s = static_cast<Shard *> (arg);
+
+  if (s->group_->pin_)
+    ACE_Reactor_Group::pin (s->index_);
+
+  s->reactor_->owner (ACE_OS::thr_self ());
+
+  if (s->reactor_->run_reactor_event_loop () == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("(%t) %p\n"),
+                   ACE_TEXT ("ACE_Reactor_Group::svc_run")));
+
+  return 0;
+}
+
+void
+ACE_Reactor_Group::pin (size_t index)
+{
+#if defined (ACE_HAS_CPU_SET_T) && defined (CPU_SET)
+  long const cpus = ACE_OS::num_processors_online ();
+  if (cpus <= 0)
+    return;
+
+  cpu_set_t mask;
+  CPU_ZERO (&mask);
+  CPU_SET (static_cast<int> (index % cpus), &mask);
+
+  ACE_hthread_t self;
+  ACE_OS::thr_self (self);
+
+  if (ACE_OS::thr_set_affinity (self, sizeof (mask), &mask) == -1
+      && ACE::debug ())
+    ACELIB_DEBUG ((LM_DEBUG,
+                   ACE_TEXT ("(%t) ACE_Reactor_Group: unable to pin ")
+                   ACE_TEXT ("shard %B: %p\n"),
+                   index,
+                   ACE_TEXT ("thr_set_affinity")));
+#else
+  ACE_UNUSED_ARG (index);
+#endif /* ACE_HAS_CPU_SET_T && CPU_SET */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
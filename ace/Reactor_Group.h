@@ -0,0 +1,192 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Reactor_Group.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+#ifndef ACE_REACTOR_GROUP_H
+#define ACE_REACTOR_GROUP_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Event_Handler.h"
+
+#if !defined (ACE_REACTOR_GROUP_MAX_EVENTS)
+/// Number of events each reactor of an ACE_Reactor_Group retrieves
+/// per <epoll_wait>; see ACE_Dev_Poll_Reactor::batch_events().
+#  define ACE_REACTOR_GROUP_MAX_EVENTS 64
+#endif /* ACE_REACTOR_GROUP_MAX_EVENTS */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Reactor;
+
+/**
+ * @class ACE_Reactor_Group
+ *
+ * @brief A set of independent ACE_Dev_Poll_Reactor instances, each
+ * run by its own thread.
+ *
+ * A single reactor run by a pool of threads serializes all of them
+ * on its token.  ACE_Reactor_Group instead runs N reactors, or
+ * "shards", each one driven by a single thread which is pinned to a
+ * CPU where the platform allows it.  Since a shard is only ever run
+ * by one thread, its reactor dispatches events in batches (see
+ * ACE_Dev_Poll_Reactor::batch_events()) and its event handlers need
+ * no locking as long as they stay on that shard.
+ *
+ * Connections are spread among the shards by an
+ * ACE_Sharded_Acceptor, which listens on the same port from every
+ * shard, or by registering handlers with next_reactor().  A handler
+ * can later move to another shard with handoff().
+ */
+class ACE_Export ACE_Reactor_Group
+{
+public:
+  /// Constructor.
+  ACE_Reactor_Group (void);
+
+  /// Destructor, calls close().
+  ~ACE_Reactor_Group (void);
+
+  /**
+   * Create @a shards reactors; if 0, one per online CPU.  Each
+   * reactor retrieves up to @a max_events events per wait, handles
+   * being registered edge triggered if @a edge_triggered is true;
+   * @a max_events of 0 leaves the reactors in their default mode.
+   * The event loops are not started.
+   */
+  int open (size_t shards = 0,
+            size_t max_events = ACE_REACTOR_GROUP_MAX_EVENTS,
+            bool edge_triggered = false);
+
+  /**
+   * Spawn one thread per shard to run its event loop.  If @a pin is
+   * true, the thread of shard i is bound to CPU (i % number of online
+   * CPUs); failing to do so is not an error.
+   */
+  int start (bool pin = true);
+
+  /// End the event loop of every shard and wait for the threads.
+  /// Must not be called from a thread of the group.
+  int stop (void);
+
+  /// Stop the group, if needed, and delete the reactors.
+  int close (void);
+
+  /// Number of shards.
+  size_t size (void) const;
+
+  /// Reactor of shard @a shard, 0 if out of range.
+  ACE_Reactor *reactor (size_t shard) const;
+
+  /// Pick the reactors in turn; 0 if the group is not open.
+  ACE_Reactor *next_reactor (void);
+
+  /// Return the shard of @a reactor, or -1 if it isn't part of the
+  /// group.
+  ssize_t shard (const ACE_Reactor *reactor) const;
+
+  /// Return the shard run by the calling thread, or -1 if the calling
+  /// thread is not a thread of the group.
+  ssize_t current_shard (void) const;
+
+  /**
+   * Move @a eh, which must be registered with a reactor of the group,
+   * to shard @a shard.  The move is carried out by the thread of its
+   * current shard, once the upcall in progress (if any) has returned,
+   * so a handler may hand itself off from one of its callbacks.  The
+   * handler keeps its registration mask; timers scheduled for it stay
+   * with the original reactor.  Reference counted handlers are kept
+   * alive until the move is complete.
+   *
+   * @return 0 if the move was queued, -1 on failure.
+   */
+  int handoff (ACE_Event_Handler *eh, size_t shard);
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  /// State of one shard.
+  struct Shard
+  {
+    ACE_Reactor_Group *group_;
+    ACE_Reactor *reactor_;
+    size_t index_;
+    ACE_thread_t thr_id_;
+  };
+
+  /**
+   * @class Handoff
+   *
+   * @brief Notification moving a handler from one reactor of the
+   * group to another.
+   */
+  class Handoff : public ACE_Event_Handler
+  {
+  public:
+    Handoff (ACE_Event_Handler *eh, ACE_Reactor *from, ACE_Reactor *to);
+
+    /// Move the handler, then delete this.
+    virtual int handle_exception (ACE_HANDLE);
+
+  private:
+    ACE_Event_Handler *eh_;
+    ACE_Reactor *from_;
+    ACE_Reactor *to_;
+  };
+
+  /// Thread entry point for a shard.
+  static ACE_THR_FUNC_RETURN svc_run (void *arg);
+
+  /// Bind the calling thread to a CPU for shard @a index.
+  static void pin (size_t index);
+
+  ACE_Reactor_Group (const ACE_Reactor_Group &);
+  ACE_Reactor_Group &operator= (const ACE_Reactor_Group &);
+
+private:
+  /// Array of <size_> shards.
+  Shard *shards_;
+
+  /// Number of shards.
+  size_t size_;
+
+  /// Next shard returned by next_reactor().
+  size_t next_;
+
+  /// Are the threads to be pinned to CPUs.
+  bool pin_;
+
+  /// Are the event loops running.
+  bool running_;
+
+  /// Protects <next_> and the start/stop state.
+  ACE_SYNCH_MUTEX lock_;
+
+  /// Manages the shard threads.
+  ACE_Thread_Manager thr_mgr_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_REACTOR_GROUP_H */
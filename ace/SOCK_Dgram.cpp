@@ -10,6 +10,7 @@
 #include "ace/OS_NS_ctype.h"
 #include "ace/os_include/net/os_if.h"
 #include "ace/Truncate.h"
+#include "ace/Message_Block.h"
 
 #if !defined (__ACE_INLINE__)
 #  include "ace/SOCK_Dgram.inl"
@@ -19,6 +20,11 @@
 #include /**/ <iphlpapi.h>
 #endif
 
+#if defined (ACE_LINUX)
+// For the UDP segmentation offload options.
+#include /**/ <netinet/udp.h>
+#endif /* ACE_LINUX */
+
 // This is a workaround for platforms with non-standard
 // definitions of the ip_mreq structure
 #if ! defined (IMR_MULTIADDR)
@@ -454,6 +460,251 @@ ACE_SOCK_Dgram::send (const void *buf,
     }
 }
 
+ssize_t
+ACE_SOCK_Dgram::recv_batch (ACE_Message_Block *const blocks[],
+                            ACE_INET_Addr addrs[],
+                            Batch_Info info[],
+                            size_t n,
+                            int flags,
+                            const ACE_Time_Value *timeout) const
+{
+  ACE_TRACE ("ACE_SOCK_Dgram::recv_batch");
+
+  if (n == 0)
+    return 0;
+  if (n > ACE_DGRAM_BATCH_MAX)
+    n = ACE_DGRAM_BATCH_MAX;
+
+  if (timeout != 0
+      && ACE::handle_read_ready (this->get_handle (), timeout) != 1)
+    return -1;
+
+#if defined (ACE_HAS_RECVMMSG)
+  mmsghdr msgs[ACE_DGRAM_BATCH_MAX];
+  iovec iov[ACE_DGRAM_BATCH_MAX];
+# if defined (SOL_UDP) && defined (UDP_GRO)
+  // Room for the segment size of each datagram.
+  union
+  {
+    cmsghdr align_;
+    char buf_[CMSG_SPACE (sizeof (int))];
+  } control[ACE_DGRAM_BATCH_MAX];
+# endif /* SOL_UDP && UDP_GRO */
+
+  for (size_t i = 0; i < n; ++i)
+    {
+      iov[i].iov_base = blocks[i]->wr_ptr ();
+      iov[i].iov_len = blocks[i]->space ();
+
+      msghdr &msg = msgs[i].msg_hdr;
+      ACE_OS::memset (&msg, 0, sizeof msg);
+      msg.msg_iov = &iov[i];
+      msg.msg_iovlen = 1;
+      if (addrs != 0)
+        {
+          // Room for any address an ACE_INET_Addr holds.
+          msg.msg_name = addrs[i].get_addr ();
+# if defined (ACE_HAS_IPV6)
+          msg.msg_namelen = sizeof (sockaddr_in6);
+# else
+          msg.msg_namelen = sizeof (sockaddr_in);
+# endif /* ACE_HAS_IPV6 */
+        }
+# if defined (SOL_UDP) && defined (UDP_GRO)
+      if (info != 0)
+        {
+          msg.msg_control = control[i].buf_;
+          msg.msg_controllen = sizeof control[i].buf_;
+        }
+# endif /* SOL_UDP && UDP_GRO */
+      msgs[i].msg_len = 0;
+    }
+
+# if defined (MSG_WAITFORONE)
+  // Only wait for the first datagram.
+  flags |= MSG_WAITFORONE;
+# endif /* MSG_WAITFORONE */
+
+  int const received = ACE_OS::recvmmsg (this->get_handle (),
+                                         msgs,
+                                         static_cast<unsigned int> (n),
+                                         flags);
+
+  for (int i = 0; i < received; ++i)
+    {
+      msghdr &msg = msgs[i].msg_hdr;
+      blocks[i]->wr_ptr (msgs[i].msg_len);
+
+      if (addrs != 0)
+        {
+          addrs[i].set_size (msg.msg_namelen);
+          addrs[i].set_type (((sockaddr *) addrs[i].get_addr ())->sa_family);
+        }
+
+      if (info != 0)
+        {
+          info[i].flags_ = msg.msg_flags;
+          info[i].segment_size_ = 0;
+# if defined (SOL_UDP) && defined (UDP_GRO)
+          for (cmsghdr *cmsg = CMSG_FIRSTHDR (&msg);
+               cmsg != 0;
+               cmsg = CMSG_NXTHDR (&msg, cmsg))
+            if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+              {
+                int size = 0;
+                ACE_OS::memcpy (&size, CMSG_DATA (cmsg), sizeof size);
+                info[i].segment_size_ = static_cast<size_t> (size);
+              }
+# endif /* SOL_UDP && UDP_GRO */
+        }
+    }
+
+  return received;
+#else
+  ssize_t received = 0;
+  for (size_t i = 0; i < n; ++i)
+    {
+      // Only wait for the first datagram.
+      if (i > 0
+          && ACE::handle_read_ready (this->get_handle (),
+                                     &ACE_Time_Value::zero) != 1)
+        break;
+
+      ACE_INET_Addr from;
+      ssize_t const length = this->recv (blocks[i]->wr_ptr (),
+                                         blocks[i]->space (),
+                                         addrs != 0 ? addrs[i] : from,
+                                         flags);
+      if (length == -1)
+        return received > 0 ? received : -1;
+
+      blocks[i]->wr_ptr (static_cast<size_t> (length));
+      if (info != 0)
+        {
+          info[i].flags_ = 0;
+          info[i].segment_size_ = 0;
+        }
+      ++received;
+    }
+
+  return received;
+#endif /* ACE_HAS_RECVMMSG */
+}
+
+ssize_t
+ACE_SOCK_Dgram::send_batch_i (ACE_Message_Block *const blocks[],
+                              const ACE_INET_Addr addrs[],
+                              const ACE_Addr *addr,
+                              size_t n,
+                              int flags,
+                              const ACE_Time_Value *timeout) const
+{
+  if (n == 0)
+    return 0;
+  if (n > ACE_DGRAM_BATCH_MAX)
+    n = ACE_DGRAM_BATCH_MAX;
+
+  if (timeout != 0
+      && ACE::handle_write_ready (this->get_handle (), timeout) != 1)
+    return -1;
+
+#if defined (ACE_HAS_SENDMMSG)
+  mmsghdr msgs[ACE_DGRAM_BATCH_MAX];
+  iovec iov[ACE_DGRAM_BATCH_MAX];
+
+  for (size_t i = 0; i < n; ++i)
+    {
+      iov[i].iov_base = blocks[i]->rd_ptr ();
+      iov[i].iov_len = blocks[i]->length ();
+
+      msghdr &msg = msgs[i].msg_hdr;
+      ACE_OS::memset (&msg, 0, sizeof msg);
+      msg.msg_iov = &iov[i];
+      msg.msg_iovlen = 1;
+
+      const ACE_Addr *to = addrs != 0 ? &addrs[i] : addr;
+      if (to != 0)
+        {
+          msg.msg_name = to->get_addr ();
+          msg.msg_namelen = to->get_size ();
+        }
+      msgs[i].msg_len = 0;
+    }
+
+  return ACE_OS::sendmmsg (this->get_handle (),
+                           msgs,
+                           static_cast<unsigned int> (n),
+                           flags);
+#else
+  ssize_t sent = 0;
+  for (size_t i = 0; i < n; ++i)
+    {
+      const ACE_Addr *to = addrs != 0 ? &addrs[i] : addr;
+      ssize_t const result =
+        to != 0
+        ? this->send (blocks[i]->rd_ptr (), blocks[i]->length (), *to, flags)
+        : ACE_OS::send (this->get_handle (),
+                        blocks[i]->rd_ptr (),
+                        blocks[i]->length (),
+                        flags);
+      if (result == -1)
+        return sent > 0 ? sent : -1;
+      ++sent;
+    }
+
+  return sent;
+#endif /* ACE_HAS_SENDMMSG */
+}
+
+ssize_t
+ACE_SOCK_Dgram::send_batch (ACE_Message_Block *const blocks[],
+                            const ACE_INET_Addr addrs[],
+                            size_t n,
+                            int flags,
+                            const ACE_Time_Value *timeout) const
+{
+  ACE_TRACE ("ACE_SOCK_Dgram::send_batch");
+  return this->send_batch_i (blocks, addrs, 0, n, flags, timeout);
+}
+
+ssize_t
+ACE_SOCK_Dgram::send_batch (ACE_Message_Block *const blocks[],
+                            size_t n,
+                            const ACE_Addr &addr,
+                            int flags,
+                            const ACE_Time_Value *timeout) const
+{
+  ACE_TRACE ("ACE_SOCK_Dgram::send_batch");
+  return this->send_batch_i (blocks, 0, &addr, n, flags, timeout);
+}
+
+int
+ACE_SOCK_Dgram::set_gso (u_short segment_size)
+{
+  ACE_TRACE ("ACE_SOCK_Dgram::set_gso");
+#if defined (SOL_UDP) && defined (UDP_SEGMENT)
+  int size = segment_size;
+  return this->set_option (SOL_UDP, UDP_SEGMENT, &size, sizeof size);
+#else
+  ACE_UNUSED_ARG (segment_size);
+  ACE_NOTSUP_RETURN (-1);
+#endif /* SOL_UDP && UDP_SEGMENT */
+}
+
+int
+ACE_SOCK_Dgram::set_gro (bool enable)
+{
+  ACE_TRACE ("ACE_SOCK_Dgram::set_gro");
+  // Only recv_batch() with recvmmsg() tells the size of the segments.
+#if defined (ACE_HAS_RECVMMSG) && defined (SOL_UDP) && defined (UDP_GRO)
+  int on = enable ? 1 : 0;
+  return this->set_option (SOL_UDP, UDP_GRO, &on, sizeof on);
+#else
+  ACE_UNUSED_ARG (enable);
+  ACE_NOTSUP_RETURN (-1);
+#endif /* ACE_HAS_RECVMMSG && SOL_UDP && UDP_GRO */
+}
+
 int
 ACE_SOCK_Dgram::set_nic (const ACE_TCHAR *net_if,
                          int addr_family)
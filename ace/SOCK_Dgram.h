@@ -26,6 +26,7 @@
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class ACE_Time_Value;
+class ACE_Message_Block;
 
 /**
  * @class ACE_SOCK_Dgram
@@ -36,6 +37,19 @@ class ACE_Time_Value;
 class ACE_Export ACE_SOCK_Dgram : public ACE_SOCK
 {
 public:
+  /// What recv_batch() tells of each datagram it received.
+  struct Batch_Info
+  {
+    /// The @c msg_flags of the datagram, e.g. MSG_TRUNC if it didn't
+    /// fit in its block and was cut.  Always 0 without recvmmsg().
+    int flags_;
+
+    /// With set_gro(), the size of the datagrams the kernel coalesced
+    /// into this one, but for the last which may be shorter; 0 if the
+    /// datagram is a single one.
+    size_t segment_size_;
+  };
+
   // = Initialization and termination methods.
   /// Default constructor.
   ACE_SOCK_Dgram (void);
@@ -191,6 +205,77 @@ public:
                 ACE_OVERLAPPED *overlapped,
                 ACE_OVERLAPPED_COMPLETION_FUNC func) const;
 
+  // = Batch data transfer routines.
+
+  /**
+   * Receive up to @a n datagrams with as few system calls as possible
+   * (uses <recvmmsg(2)> where available).  Datagram i is written to
+   * the space of @a blocks[i], whose @c wr_ptr is advanced past it;
+   * if @a addrs is not 0, @a addrs[i] is set to its source address,
+   * and if @a info is not 0, @a info[i] to its flags and segment
+   * size.  Only the first block of a chain is used.
+   *
+   * Blocks until a datagram arrives, or until @a timeout expires if
+   * not 0, then only takes what is there without waiting, and at most
+   * ACE_DGRAM_BATCH_MAX datagrams.
+   *
+   * @return The number of datagrams received, or -1 on error, with
+   * @c errno ETIME if @a timeout expired.
+   */
+  ssize_t recv_batch (ACE_Message_Block *const blocks[],
+                      ACE_INET_Addr addrs[],
+                      Batch_Info info[],
+                      size_t n,
+                      int flags = 0,
+                      const ACE_Time_Value *timeout = 0) const;
+
+  /**
+   * Send the data of each of the @a n @a blocks, between its
+   * @c rd_ptr and @c wr_ptr, as a datagram to the matching address of
+   * @a addrs, with as few system calls as possible (uses
+   * <sendmmsg(2)> where available).  Only the first block of a chain
+   * is sent, and the blocks are not changed.  @a addrs may be 0 if
+   * the socket is connected.
+   *
+   * Waits until the socket is writable, or until @a timeout expires
+   * if not 0, then sends at most ACE_DGRAM_BATCH_MAX datagrams.
+   *
+   * @return The number of datagrams sent, fewer than @a n if the
+   * socket buffer filled up or the datagram after the last sent
+   * failed, or -1 if none could be sent.
+   */
+  ssize_t send_batch (ACE_Message_Block *const blocks[],
+                      const ACE_INET_Addr addrs[],
+                      size_t n,
+                      int flags = 0,
+                      const ACE_Time_Value *timeout = 0) const;
+
+  /// As above, sending all the datagrams to @a addr.
+  ssize_t send_batch (ACE_Message_Block *const blocks[],
+                      size_t n,
+                      const ACE_Addr &addr,
+                      int flags = 0,
+                      const ACE_Time_Value *timeout = 0) const;
+
+  /**
+   * Have the kernel cut each datagram sent into datagrams of
+   * @a segment_size bytes, the last one possibly shorter, so a large
+   * block goes out as many datagrams through a single traversal of
+   * the stack (UDP generic segmentation offload, Linux).  0 turns it
+   * off.  Returns -1 with @c errno ENOTSUP where not supported.
+   */
+  int set_gso (u_short segment_size);
+
+  /**
+   * Let the kernel coalesce datagrams of the same size arriving
+   * together from a peer into one (UDP generic receive offload,
+   * Linux).  recv_batch() reports the size of the datagrams in
+   * Batch_Info::segment_size_, and callers must then split them.
+   * Returns -1 with @c errno ENOTSUP where not supported, or without
+   * recvmmsg().
+   */
+  int set_gro (bool enable);
+
   // = Meta-type info.
   typedef ACE_INET_Addr PEER_ADDR;
 
@@ -224,6 +309,14 @@ protected:
 #endif /* ACE_HAS_IPV6 */
 
 private:
+  /// Send <n> <blocks> to <addrs>, or all to <addr> if <addrs> is 0.
+  ssize_t send_batch_i (ACE_Message_Block *const blocks[],
+                        const ACE_INET_Addr addrs[],
+                        const ACE_Addr *addr,
+                        size_t n,
+                        int flags,
+                        const ACE_Time_Value *timeout) const;
+
   /// Do not allow this function to percolate up to this interface...
   int  get_remote_addr (ACE_Addr &) const;
 };
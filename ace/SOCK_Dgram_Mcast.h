@@ -313,6 +313,14 @@ public:
                 int n,
                 int flags = 0) const;
 
+  /// Send the @a n @a blocks as datagrams, using the multicast address
+  /// and network interface defined by the first open() or subscribe(),
+  /// with as few system calls as possible.  See
+  /// ACE_SOCK_Dgram::send_batch().
+  ssize_t send_batch (ACE_Message_Block *const blocks[],
+                      size_t n,
+                      int flags = 0) const;
+
   // = Options.
 
   /// Set a socket option.
@@ -49,6 +49,18 @@ ACE_SOCK_Dgram_Mcast::send (const iovec iov[],
                                      flags);
 }
 
+ACE_INLINE ssize_t
+ACE_SOCK_Dgram_Mcast::send_batch (ACE_Message_Block *const blocks[],
+                                  size_t n,
+                                  int flags) const
+{
+  ACE_TRACE ("ACE_SOCK_Dgram_Mcast::send_batch");
+  return this->ACE_SOCK_Dgram::send_batch (blocks,
+                                           n,
+                                           this->send_addr_,
+                                           flags);
+}
+
 ACE_INLINE void
 ACE_SOCK_Dgram_Mcast::opts (int opts)
 {
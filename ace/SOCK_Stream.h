@@ -136,6 +136,16 @@ public:
                   const ACE_Time_Value *timeout = 0,
                   size_t *bytes_transferred = 0) const;
 
+  /// Send all the message blocks chained through their @c next and
+  /// @c cont pointers, consuming the data sent so that a call with
+  /// the same chain resumes after a partial write.  @a flags, such as
+  /// MSG_ZEROCOPY, are passed to sendmsg().  See ACE::send_chain().
+  ssize_t send_chain (ACE_Message_Block *message_block,
+                      const ACE_Time_Value *timeout = 0,
+                      size_t *bytes_transferred = 0,
+                      int flags = 0,
+                      size_t *writes = 0) const;
+
   /// Send an @c iovec of size @a iovcnt to the connected socket.
   ssize_t sendv_n (const iovec iov[],
                    int iovcnt,
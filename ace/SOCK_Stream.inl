@@ -148,6 +148,22 @@ ACE_SOCK_Stream::send_n (const ACE_Message_Block *message_block,
                       bytes_transferred);
 }
 
+ACE_INLINE ssize_t
+ACE_SOCK_Stream::send_chain (ACE_Message_Block *message_block,
+                             const ACE_Time_Value *timeout,
+                             size_t *bytes_transferred,
+                             int flags,
+                             size_t *writes) const
+{
+  ACE_TRACE ("ACE_SOCK_Stream::send_chain");
+  return ACE::send_chain (this->get_handle (),
+                          message_block,
+                          timeout,
+                          bytes_transferred,
+                          flags,
+                          writes);
+}
+
 ACE_INLINE ssize_t
 ACE_SOCK_Stream::send_urg (const void *ptr,
                            size_t len,
@@ -608,6 +608,15 @@ ACE_Select_Reactor_Notify::open (ACE_Reactor_Impl *r,
           return -1;
         }
 
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+      if (this->notification_queue_.open () == -1)
+        return -1;
+
+      return this->select_reactor_->register_handler
+        (this->notification_queue_.handle (),
+         this,
+         ACE_Event_Handler::READ_MASK);
+#else
       if (this->notification_pipe_.open () == -1)
         return -1;
 #if defined (F_SETFD)
@@ -632,6 +641,7 @@ ACE_Select_Reactor_Notify::open (ACE_Reactor_Impl *r,
           (this->notification_pipe_.read_handle (),
            this,
            ACE_Event_Handler::READ_MASK);
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
     }
   else
     {
@@ -645,9 +655,12 @@ ACE_Select_Reactor_Notify::close (void)
 {
   ACE_TRACE ("ACE_Select_Reactor_Notify::close");
 
-#if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
-  notification_queue_.reset();
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+  return this->notification_queue_.close ();
 #else
+# if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
+  notification_queue_.reset();
+# else
   if (this->notification_pipe_.read_handle() != ACE_INVALID_HANDLE)
     {
       // Please see Bug 2820, if we just close the pipe then we break
@@ -666,9 +679,10 @@ ACE_Select_Reactor_Notify::close (void)
             }
         }
     }
-#endif /* ACE_HAS_REACTOR_NOTIFICATION_QUEUE */
+# endif /* ACE_HAS_REACTOR_NOTIFICATION_QUEUE */
 
   return this->notification_pipe_.close ();
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
 }
 
 int
@@ -692,7 +706,18 @@ ACE_Select_Reactor_Notify::notify (ACE_Event_Handler *event_handler,
 
   ACE_Notification_Buffer buffer (event_handler, mask);
 
-#if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+  ACE_UNUSED_ARG (timeout);
+
+  if (this->notification_queue_.push (buffer) == -1)
+    return -1;
+
+  // No failures, the handler is now owned by the notification queue.
+  safe_handler.release ();
+
+  return 0;
+#else
+# if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
   int const notification_required =
     notification_queue_.push_new_notification(buffer);
 
@@ -708,7 +733,7 @@ ACE_Select_Reactor_Notify::notify (ACE_Event_Handler *event_handler,
 
       return 0;
     }
-#endif /* ACE_HAS_REACTOR_NOTIFICATION_QUEUE */
+# endif /* ACE_HAS_REACTOR_NOTIFICATION_QUEUE */
 
   ssize_t const n = ACE::send (this->notification_pipe_.write_handle (),
                                (char *) &buffer,
@@ -723,6 +748,7 @@ ACE_Select_Reactor_Notify::notify (ACE_Event_Handler *event_handler,
   safe_handler.release ();
 
   return 0;
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
 }
 
 // Handles pending threads (if any) that are waiting to unblock the
@@ -734,8 +760,7 @@ ACE_Select_Reactor_Notify::dispatch_notifications (int &number_of_active_handles
 {
   ACE_TRACE ("ACE_Select_Reactor_Notify::dispatch_notifications");
 
-  ACE_HANDLE const read_handle =
-    this->notification_pipe_.read_handle ();
+  ACE_HANDLE const read_handle = this->notify_handle ();
 
   if (read_handle != ACE_INVALID_HANDLE
       && rd_mask.is_set (read_handle))
@@ -754,14 +779,19 @@ ACE_Select_Reactor_Notify::notify_handle (void)
 {
   ACE_TRACE ("ACE_Select_Reactor_Notify::notify_handle");
 
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+  return this->notification_queue_.handle ();
+#else
   return this->notification_pipe_.read_handle ();
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
 }
 
 
 int
 ACE_Select_Reactor_Notify::is_dispatchable (ACE_Notification_Buffer &buffer)
 {
-#if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
+#if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE) \
+    && !defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
   ACE_UNUSED_ARG(buffer);
   return 1;
 #else
@@ -787,7 +817,8 @@ ACE_Select_Reactor_Notify::dispatch_notify (ACE_Notification_Buffer &buffer)
 {
   int result = 0;
 
-#if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
+#if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE) \
+    && !defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
   // Dispatch one message from the notify queue, and put another in
   // the pipe if one is available.  Remember, the idea is to keep
   // exactly one message in the pipe at a time.
@@ -868,6 +899,12 @@ ACE_Select_Reactor_Notify::read_notify_pipe (ACE_HANDLE handle,
 {
   ACE_TRACE ("ACE_Select_Reactor_Notify::read_notify_pipe");
 
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+  // The notifications are taken from the queue directly; there is
+  // nothing but a wakeup to read from <handle>.
+  ACE_UNUSED_ARG (handle);
+  return this->notification_queue_.pop (buffer);
+#else
   // This is kind of a weird, fragile beast.  We first read with a
   // regular read.  The read side of this socket is non-blocking, so
   // the read may end up being short.
@@ -915,6 +952,7 @@ ACE_Select_Reactor_Notify::read_notify_pipe (ACE_HANDLE handle,
     return -1;
 
   return 0;
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
 }
 
 
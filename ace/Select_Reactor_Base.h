@@ -26,9 +26,11 @@
 #include "ace/Pipe.h"
 #include "ace/Reactor_Impl.h"
 
-#if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+# include "ace/MPSC_Notification_Queue.h"
+#elif defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
 # include "ace/Notification_Queue.h"
-#endif /* ACE_HAS_REACTOR_NOTIFICATION_QUEUE */
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
 
 #ifdef ACE_WIN32
 # include "ace/Null_Mutex.h"
@@ -254,7 +256,16 @@ protected:
    */
   int max_notify_iterations_;
 
-#if defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+  /**
+   * @brief A lock-free queue to store the notifications.
+   *
+   * notify() does not take any lock, and the queue provides the
+   * handle the reactor waits on instead of the notification pipe,
+   * which is left unused.
+   */
+  ACE_MPSC_Notification_Queue notification_queue_;
+#elif defined (ACE_HAS_REACTOR_NOTIFICATION_QUEUE)
   /**
    * @brief A user-space queue to store the notifications.
    *
@@ -267,7 +278,7 @@ protected:
    * at a time.
    */
   ACE_Notification_Queue notification_queue_;
-#endif /* ACE_HAS_REACTOR_NOTIFICATION_QUEUE */
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
 };
 
 /**
@@ -0,0 +1,210 @@
+// $Id$
+
+#ifndef ACE_SHARDED_ACCEPTOR_CPP
+#define ACE_SHARDED_ACCEPTOR_CPP
+
+#include "ace/Sharded_Acceptor.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+
+#include "ace/OS_NS_sys_socket.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR>
+ACE_Shard_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::ACE_Shard_Acceptor (void)
+  : ACE_Acceptor<SVC_HANDLER, PEER_ACCEPTOR> (0)
+{
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR> int
+ACE_Shard_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::open
+  (const typename PEER_ACCEPTOR::PEER_ADDR &local_addr,
+   ACE_Reactor *reactor,
+   int flags,
+   int use_select,
+   int reuse_addr)
+{
+  ACE_TRACE ("ACE_Shard_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::open");
+  this->flags_ = flags;
+  this->use_select_ = use_select;
+  this->reuse_addr_ = reuse_addr;
+  this->peer_acceptor_addr_ = local_addr;
+
+  if (reactor == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+#if defined (SO_REUSEPORT)
+  // Same as PEER_ACCEPTOR::open(), except that SO_REUSEPORT must be
+  // set between the creation of the socket and the bind().
+  PEER_ACCEPTOR &peer = this->peer_acceptor_;
+
+  if (peer.ACE_SOCK::open (SOCK_STREAM,
+                           local_addr.get_type (),
+                           0,
+                           reuse_addr) == -1)
+    return -1;
+
+  int one = 1;
+  if (peer.set_option (SOL_SOCKET,
+                       SO_REUSEPORT,
+                       &one,
+                       sizeof one) == -1
+      || ACE_OS::bind (peer.get_handle (),
+                       (sockaddr *) local_addr.get_addr (),
+                       local_addr.get_size ()) == -1
+      || ACE_OS::listen (peer.get_handle (), ACE_DEFAULT_BACKLOG) == -1)
+    {
+      ACE_Errno_Guard error (errno);
+      peer.close ();
+      return -1;
+    }
+
+  // See ACE_Acceptor::open().
+  (void) peer.enable (ACE_NONBLOCK);
+
+  int const result =
+    reactor->register_handler (this, ACE_Event_Handler::ACCEPT_MASK);
+  if (result != -1)
+    this->reactor (reactor);
+  else
+    peer.close ();
+
+  return result;
+#else
+  ACE_NOTSUP_RETURN (-1);
+#endif /* SO_REUSEPORT */
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR>
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::ACE_Sharded_Acceptor (void)
+  : shards_ (0),
+    size_ (0)
+{
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR>
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::~ACE_Sharded_Acceptor (void)
+{
+  this->close ();
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR> int
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::make_shard (shard_type *&shard)
+{
+  ACE_NEW_RETURN (shard, shard_type, -1);
+  return 0;
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR> int
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::open
+  (const addr_type &local_addr,
+   ACE_Reactor_Group &group,
+   int flags,
+   int use_select,
+   int reuse_addr)
+{
+  ACE_TRACE ("ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::open");
+
+  if (this->shards_ != 0 || group.size () == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  size_t const n = group.size ();
+  ACE_NEW_RETURN (this->shards_, shard_type *[n], -1);
+  for (size_t i = 0; i < n; ++i)
+    this->shards_[i] = 0;
+  this->size_ = n;
+
+  addr_type addr (local_addr);
+
+  for (size_t i = 0; i < n; ++i)
+    {
+      if (this->make_shard (this->shards_[i]) == -1
+          || this->shards_[i]->open (addr,
+                                     group.reactor (i),
+                                     flags,
+                                     use_select,
+                                     reuse_addr) == -1)
+        {
+          ACE_Errno_Guard error (errno);
+          this->close ();
+          return -1;
+        }
+
+      // Let the other shards listen on the port chosen for the first
+      // one.
+      if (i == 0
+          && this->shards_[0]->acceptor ().get_local_addr (addr) == -1)
+        {
+          ACE_Errno_Guard error (errno);
+          this->close ();
+          return -1;
+        }
+    }
+
+  return 0;
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR> int
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::close (void)
+{
+  ACE_TRACE ("ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::close");
+
+  int result = 0;
+
+  for (size_t i = 0; i < this->size_; ++i)
+    if (this->shards_[i] != 0)
+      {
+        if (this->shards_[i]->close () == -1)
+          result = -1;
+        delete this->shards_[i];
+      }
+
+  delete [] this->shards_;
+  this->shards_ = 0;
+  this->size_ = 0;
+
+  return result;
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR> size_t
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::size (void) const
+{
+  return this->size_;
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR>
+typename ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::shard_type *
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::shard (size_t shard) const
+{
+  return shard < this->size_ ? this->shards_[shard] : 0;
+}
+
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR> int
+ACE_Sharded_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>::get_local_addr
+  (addr_type &addr) const
+{
+  if (this->size_ == 0 || this->shards_[0] == 0)
+    {
+      errno = ENOTCONN;
+      return -1;
+    }
+
+  return this->shards_[0]->acceptor ().get_local_addr (addr);
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
+
+#endif /* ACE_SHARDED_ACCEPTOR_CPP */
@@ -0,0 +1,140 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Sharded_Acceptor.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+#ifndef ACE_SHARDED_ACCEPTOR_H
+#define ACE_SHARDED_ACCEPTOR_H
+
+#include /**/ "ace/pre.h"
+
+#include "ace/Acceptor.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Reactor_Group.h"
+
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Shard_Acceptor
+ *
+ * @brief An ACE_Acceptor whose listening socket is opened with
+ * @c SO_REUSEPORT, so that several of them can listen on the same
+ * address, the kernel spreading incoming connections among them.
+ *
+ * @tparam PEER_ACCEPTOR Must be derived from ACE_SOCK, e.g.,
+ *         ACE_SOCK_Acceptor.
+ */
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR>
+class ACE_Shard_Acceptor : public ACE_Acceptor<SVC_HANDLER, PEER_ACCEPTOR>
+{
+public:
+  /// Default constructor.
+  ACE_Shard_Acceptor (void);
+
+  /**
+   * Open the listening socket on @a local_addr with @c SO_REUSEPORT
+   * enabled and register it with @a reactor.  The other parameters
+   * are those of ACE_Acceptor::open().  Fails with @c ENOTSUP where
+   * @c SO_REUSEPORT is not available.
+   */
+  virtual int open (const typename PEER_ACCEPTOR::PEER_ADDR &local_addr,
+                    ACE_Reactor *reactor = ACE_Reactor::instance (),
+                    int flags = 0,
+                    int use_select = 1,
+                    int reuse_addr = 1);
+};
+
+/**
+ * @class ACE_Sharded_Acceptor
+ *
+ * @brief Accepts connections on every shard of an ACE_Reactor_Group.
+ *
+ * One ACE_Shard_Acceptor is opened on the same address for each
+ * shard and registered with its reactor, so a connection is accepted
+ * by the thread of one of the shards, chosen by the kernel, and its
+ * SVC_HANDLER is registered with the reactor of that shard: it stays
+ * on the core that accepted it unless it is moved with
+ * ACE_Reactor_Group::handoff().
+ *
+ * close() must be called once the event loops of the group are
+ * stopped, see ACE_Reactor_Group::stop().
+ */
+template <typename SVC_HANDLER, typename PEER_ACCEPTOR>
+class ACE_Sharded_Acceptor
+{
+public:
+  typedef ACE_Shard_Acceptor<SVC_HANDLER, PEER_ACCEPTOR> shard_type;
+  typedef typename PEER_ACCEPTOR::PEER_ADDR addr_type;
+
+  /// Default constructor.
+  ACE_Sharded_Acceptor (void);
+
+  /// Destructor, calls close().
+  virtual ~ACE_Sharded_Acceptor (void);
+
+  /**
+   * Open one acceptor on @a local_addr per shard of @a group; if the
+   * port of @a local_addr is 0, the port picked for the first shard
+   * is used for all of them.  The other parameters are those of
+   * ACE_Acceptor::open().
+   */
+  virtual int open (const addr_type &local_addr,
+                    ACE_Reactor_Group &group,
+                    int flags = 0,
+                    int use_select = 1,
+                    int reuse_addr = 1);
+
+  /// Close and delete the acceptors of all shards.
+  virtual int close (void);
+
+  /// Number of shards listening.
+  size_t size (void) const;
+
+  /// Acceptor of shard @a shard, 0 if out of range.
+  shard_type *shard (size_t shard) const;
+
+  /// Return the address the acceptors listen on.
+  int get_local_addr (addr_type &addr) const;
+
+protected:
+  /// Factory for the acceptor of each shard; subclasses can override
+  /// it to create an ACE_Shard_Acceptor subclass.
+  virtual int make_shard (shard_type *&shard);
+
+  /// Array of <size_> acceptors.
+  shard_type **shards_;
+
+  /// Number of shards.
+  size_t size_;
+
+private:
+  ACE_Sharded_Acceptor (const ACE_Sharded_Acceptor &);
+  ACE_Sharded_Acceptor &operator= (const ACE_Sharded_Acceptor &);
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Sharded_Acceptor.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Sharded_Acceptor.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#endif /* ACE_HAS_EVENT_POLL || ACE_HAS_DEV_POLL */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_SHARDED_ACCEPTOR_H */
@@ -98,6 +98,24 @@ ACE_Stream<ACE_SYNCH_USE, TIME_POLICY>::get (ACE_Message_Block *&mb, ACE_Time_Va
   return this->stream_head_->reader ()->getq (mb, tv);
 }
 
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Stream<ACE_SYNCH_USE, TIME_POLICY>::put_n (ACE_Message_Block *mbs[],
+                                  size_t count,
+                                  ACE_Time_Value *tv)
+{
+  ACE_TRACE ("ACE_Stream<ACE_SYNCH_USE, TIME_POLICY>::put_n");
+  return this->stream_head_->writer ()->put_n (mbs, count, tv);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Stream<ACE_SYNCH_USE, TIME_POLICY>::get_n (ACE_Message_Block *mbs[],
+                                  size_t count,
+                                  ACE_Time_Value *tv)
+{
+  ACE_TRACE ("ACE_Stream<ACE_SYNCH_USE, TIME_POLICY>::get_n");
+  return this->stream_head_->reader ()->getq_n (mbs, count, tv);
+}
+
 // Return the "top" ACE_Module in a ACE_Stream, skipping over the
 // stream_head.
 
@@ -151,6 +151,25 @@ public:
   virtual int get (ACE_Message_Block *&mb,
                    ACE_Time_Value *timeout = 0);
 
+  /**
+   * Send the @a count messages of @a mbs down the stream, in order,
+   * through the put_n() hooks of its tasks, so that tasks queueing
+   * them do so under a single lock acquisition.  Returns the number
+   * of messages sent, or -1 if none was.
+   */
+  virtual int put_n (ACE_Message_Block *mbs[],
+                     size_t count,
+                     ACE_Time_Value *timeout = 0);
+
+  /**
+   * Read up to @a count messages stored in the stream head into
+   * @a mbs, waiting until @a timeout for the first one.  Returns the
+   * number of messages read, or -1 on failure.
+   */
+  virtual int get_n (ACE_Message_Block *mbs[],
+                     size_t count,
+                     ACE_Time_Value *timeout = 0);
+
   /// Send control message down the stream.
   virtual int control (ACE_IO_Cntl_Msg::ACE_IO_Cntl_Cmds cmd,
                        void *args);
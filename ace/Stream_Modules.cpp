@@ -126,6 +126,26 @@ ACE_Stream_Head<ACE_SYNCH_USE, TIME_POLICY>::put (ACE_Message_Block *mb,
     }
 }
 
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Stream_Head<ACE_SYNCH_USE, TIME_POLICY>::put_n (ACE_Message_Block *msgs[],
+                                       size_t count,
+                                       ACE_Time_Value *tv)
+{
+  ACE_TRACE ("ACE_Stream_Head<ACE_SYNCH_USE, TIME_POLICY>::put_n");
+
+  // Control and flush messages are handled one at a time by put().
+  for (size_t i = 0; i < count; ++i)
+    if (msgs[i]->msg_type () == ACE_Message_Block::MB_IOCTL
+        || (this->is_reader ()
+            && msgs[i]->msg_type () == ACE_Message_Block::MB_FLUSH))
+      return ACE_Task<ACE_SYNCH_USE, TIME_POLICY>::put_n (msgs, count, tv);
+
+  if (this->is_writer ())
+    return this->put_next_n (msgs, count, tv);
+  else // this->is_reader ()
+    return this->putq_n (msgs, count, tv);
+}
+
 template <ACE_SYNCH_DECL, class TIME_POLICY> int
 ACE_Stream_Head<ACE_SYNCH_USE, TIME_POLICY>::init (int, ACE_TCHAR *[])
 {
@@ -348,6 +368,15 @@ ACE_Thru_Task<ACE_SYNCH_USE, TIME_POLICY>::put (ACE_Message_Block *msg,
   return this->put_next (msg, tv);
 }
 
+template <ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Thru_Task<ACE_SYNCH_USE, TIME_POLICY>::put_n (ACE_Message_Block *msgs[],
+                                     size_t count,
+                                     ACE_Time_Value *tv)
+{
+  ACE_TRACE ("ACE_Thru_Task<ACE_SYNCH_USE, TIME_POLICY>::put_n");
+  return this->put_next_n (msgs, count, tv);
+}
+
 template <ACE_SYNCH_DECL, class TIME_POLICY> int
 ACE_Thru_Task<ACE_SYNCH_USE, TIME_POLICY>::init (int, ACE_TCHAR *[])
 {
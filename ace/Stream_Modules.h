@@ -63,6 +63,13 @@ public:
   virtual int put (ACE_Message_Block *msg, ACE_Time_Value * = 0);
   virtual int svc (void);
 
+  /// Pass the messages on as a batch (writer), or queue them with a
+  /// single putq_n() (reader), unless one of them needs the handling
+  /// put() gives control and flush messages.
+  virtual int put_n (ACE_Message_Block *msgs[],
+                     size_t count,
+                     ACE_Time_Value * = 0);
+
   // = Dynamic linking hooks
   virtual int init (int argc, ACE_TCHAR *argv[]);
   virtual int info (ACE_TCHAR **info_string, size_t length) const;
@@ -140,6 +147,11 @@ public:
   virtual int put (ACE_Message_Block *msg, ACE_Time_Value * = 0);
   virtual int svc (void);
 
+  /// Pass the messages on as a batch.
+  virtual int put_n (ACE_Message_Block *msgs[],
+                     size_t count,
+                     ACE_Time_Value * = 0);
+
   // = Dynamic linking hooks
   virtual int init (int argc, ACE_TCHAR *argv[]);
   virtual int info (ACE_TCHAR **info_string, size_t length) const;
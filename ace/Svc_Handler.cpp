@@ -9,7 +9,9 @@
 # pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
+#include "ace/ACE.h"
 #include "ace/OS_NS_sys_time.h"
+#include "ace/Truncate.h"
 #include "ace/Object_Manager.h"
 #include "ace/Connection_Recycling_Strategy.h"
 
@@ -406,7 +408,32 @@ ACE_Svc_Handler<PEER_STREAM, SYNCH_TRAITS>::recycle (void *)
 template <typename PEER_STREAM, typename SYNCH_TRAITS>
 ACE_Buffered_Svc_Handler<PEER_STREAM, SYNCH_TRAITS>::~ACE_Buffered_Svc_Handler (void)
 {
+  // Send what's left blocking: the reactor can't call this handler
+  // anymore.
+  if (this->output_scheduled_)
+    {
+      this->output_scheduled_ = false;
+      this->reactor ()->cancel_wakeup (this,
+                                       ACE_Event_Handler::WRITE_MASK);
+    }
+
+  ACE_Reactor *reactor = this->reactor ();
+  this->reactor (0);
   this->flush ();
+  this->reactor (reactor);
+
+  // Whatever couldn't be sent is lost.
+  while (this->pending_ != 0)
+    {
+      ACE_Message_Block *mb = this->pending_;
+      this->pending_ = mb->next ();
+      mb->release ();
+    }
+
+  // The kernel keeps the pages of data it hasn't sent yet.
+  Zerocopy_Message message;
+  while (this->zerocopy_messages_.dequeue_head (message) == 0)
+    message.message_->release ();
 }
 
 template <typename PEER_STREAM, typename SYNCH_TRAITS>
@@ -416,6 +443,13 @@ ACE_Buffered_Svc_Handler<PEER_STREAM, SYNCH_TRAITS>::ACE_Buffered_Svc_Handler (A
                                                                             size_t maximum_buffer_size,
                                                                             ACE_Time_Value *timeout)
   : ACE_Svc_Handler<PEER_STREAM, SYNCH_TRAITS> (tm, mq, reactor),
+    pending_ (0),
+    pending_tail_ (0),
+    pending_length_ (0),
+    output_scheduled_ (false),
+    zerocopy_threshold_ (0),
+    zerocopy_writes_ (0),
+    zerocopy_completed_ (0),
     maximum_buffer_size_ (maximum_buffer_size),
     current_buffer_size_ (0),
     timeoutp_ (timeout)
@@ -433,7 +467,7 @@ template <typename PEER_STREAM, typename SYNCH_TRAITS> int
 ACE_Buffered_Svc_Handler<PEER_STREAM, SYNCH_TRAITS>::put (ACE_Message_Block *mb,
                                                           ACE_Time_Value *tv)
 {
-  ACE_GUARD_RETURN (typename SYNCH_TRAITS::MUTEX, m, this->msg_queue ()->lock (), -1);
+  ACE_GUARD_RETURN (typename SYNCH_TRAITS::MUTEX, m, this->flush_lock_, -1);
 
   // Enqueue <mb> onto the message queue.
   if (this->putq (mb, tv) == -1)
@@ -459,7 +493,7 @@ ACE_Buffered_Svc_Handler<PEER_STREAM, SYNCH_TRAITS>::put (ACE_Message_Block *mb,
 template <typename PEER_STREAM, typename SYNCH_TRAITS> int
 ACE_Buffered_Svc_Handler<PEER_STREAM, SYNCH_TRAITS>::flush (void)
 {
-  ACE_GUARD_RETURN (typename SYNCH_TRAITS::MUTEX, m, this->msg_queue ()->lock (), -1);
+  ACE_GUARD_RETURN (typename SYNCH_TRAITS::MUTEX, m, this->flush_lock_, -1);
 
   return this->flush_i ();
 }
@@ -467,26 +501,172 @@ ACE_Buffered_Svc_Handler<PEER_STREAM, SYNCH_TRAITS>::flush (void)
 template <typename PEER_STREAM, typename SYNCH_TRAITS> int
 ACE_Buffered_Svc_Handler<PEER_STREAM, SYNCH_TRAITS>::flush_i (void)
 {
-  ACE_Message_Queue_Iterator<SYNCH_TRAITS> iterator (*this->msg_queue ());
-  ACE_Message_Block *mblk = 0;
+  // Take the messages off the queue, behind those a previous flush
+  // left.
+  ACE_Message_Block *mb = 0;
+  ACE_Time_Value nowait (ACE_Time_Value::zero);
+
+  while (this->getq (mb, &nowait) != -1)
+    {
+      if (this->pending_tail_ == 0)
+        this->pending_ = mb;
+      else
+        this->pending_tail_->next (mb);
+      this->pending_tail_ = mb;
+      this->pending_length_ += mb->total_length ();
+    }
+
+  ACE_HANDLE const handle = this->peer ().get_handle ();
+
+  if (this->zerocopy_writes_ != this->zerocopy_completed_)
+    this->reap_zerocopy_i ();
+
+  // Don't block in a reactor's thread: the peer's handle will tell
+  // when it takes more.
+  const ACE_Time_Value *timeout = 0;
+  if (this->reactor () != 0
+      && ACE_BIT_ENABLED (ACE::get_flags (handle), ACE_NONBLOCK))
+    timeout = &ACE_Time_Value::zero;
+
+  int flags = 0;
+#if defined (MSG_ZEROCOPY)
+  if (this->zerocopy_threshold_ != 0
+      && this->pending_length_ >= this->zerocopy_threshold_)
+    flags = MSG_ZEROCOPY;
+#endif /* MSG_ZEROCOPY */
+
   ssize_t result = 0;
+  size_t total = 0;
 
-  // Get the first <ACE_Message_Block> so that we can write everything
-  // out via the <send_n>.
-  if (iterator.next (mblk) != 0)
-    result = this->peer ().send_n (mblk);
+  while (this->pending_ != 0)
+    {
+      size_t bytes_transferred = 0;
+      size_t writes = 0;
+      result = ACE::send_chain (handle,
+                                this->pending_,
+                                timeout,
+                                &bytes_transferred,
+                                flags,
+                                &writes);
+      int const error = errno;
+
+      total += bytes_transferred;
+      this->pending_length_ -= bytes_transferred;
+      if (flags != 0)
+        this->zerocopy_writes_ += static_cast<ACE_UINT32> (writes);
+
+      // Release the messages sent.
+      while (this->pending_ != 0 && this->pending_->total_length () == 0)
+        {
+          mb = this->pending_;
+          this->pending_ = mb->next ();
+          mb->next (0);
+          this->release_i (mb);
+        }
+
+      if (this->pending_ == 0)
+        this->pending_tail_ = 0;
+      else if (result == -1 && timeout != 0 && error == ETIME)
+        {
+          // Send the rest from <handle_output>, or block if the
+          // reactor can't tell when.
+          if (this->output_scheduled_
+              || this->reactor ()->schedule_wakeup
+                   (this, ACE_Event_Handler::WRITE_MASK) != -1)
+            {
+              this->output_scheduled_ = true;
+              result = 0;
+              break;
+            }
+
+          timeout = 0;
+          continue;
+        }
+
+      break;
+    }
 
-  // This method assumes the caller holds the queue's lock!
-  if (result != -1)
-    this->msg_queue ()->flush_i ();
+  if (this->pending_ == 0 && this->output_scheduled_)
+    {
+      this->output_scheduled_ = false;
+      this->reactor ()->cancel_wakeup (this,
+                                       ACE_Event_Handler::WRITE_MASK);
+    }
 
   if (this->timeoutp_ != 0)
     // Update the next timeout period by adding the interval.
     this->next_timeout_ += this->interval_;
 
-  this->current_buffer_size_ = 0;
+  this->current_buffer_size_ = this->pending_length_;
+
+  if (result == -1)
+    return -1;
+
+  return ACE_Utils::truncate_cast<int> (total);
+}
+
+template <typename PEER_STREAM, typename SYNCH_TRAITS> void
+ACE_Buffered_Svc_Handler<PEER_STREAM, SYNCH_TRAITS>::release_i (ACE_Message_Block *mb)
+{
+  // The data of zero-copy writes not completed yet may still be
+  // read by the kernel.
+  if (this->zerocopy_writes_ != this->zerocopy_completed_)
+    {
+      Zerocopy_Message message;
+      message.message_ = mb;
+      message.write_ = this->zerocopy_writes_ - 1;
+      if (this->zerocopy_messages_.enqueue_tail (message) == 0)
+        return;
+    }
+
+  mb->release ();
+}
+
+template <typename PEER_STREAM, typename SYNCH_TRAITS> void
+ACE_Buffered_Svc_Handler<PEER_STREAM, SYNCH_TRAITS>::reap_zerocopy_i (void)
+{
+  ACE_HANDLE const handle = this->peer ().get_handle ();
+  ACE_UINT32 first = 0;
+  ACE_UINT32 last = 0;
+
+  // TCP reports the writes in order, possibly several at once.
+  while (this->zerocopy_writes_ != this->zerocopy_completed_
+         && ACE::zerocopy_completion (handle, first, last) == 1)
+    if (static_cast<ACE_INT32> (last + 1 - this->zerocopy_completed_) > 0)
+      this->zerocopy_completed_ = last + 1;
+
+  Zerocopy_Message *message = 0;
+  while (this->zerocopy_messages_.get (message) == 0
+         && static_cast<ACE_INT32> (this->zerocopy_completed_
+                                    - message->write_) > 0)
+    {
+      message->message_->release ();
+      Zerocopy_Message done;
+      this->zerocopy_messages_.dequeue_head (done);
+    }
+}
+
+template <typename PEER_STREAM, typename SYNCH_TRAITS> int
+ACE_Buffered_Svc_Handler<PEER_STREAM, SYNCH_TRAITS>::handle_output (ACE_HANDLE)
+{
+  ACE_TRACE ("ACE_Buffered_Svc_Handler<PEER_STREAM, SYNCH_TRAITS>::handle_output");
+  ACE_GUARD_RETURN (typename SYNCH_TRAITS::MUTEX, m, this->flush_lock_, -1);
+
+  return this->flush_i () == -1 ? -1 : 0;
+}
 
-  return result;
+template <typename PEER_STREAM, typename SYNCH_TRAITS> int
+ACE_Buffered_Svc_Handler<PEER_STREAM, SYNCH_TRAITS>::zerocopy_threshold (size_t threshold)
+{
+  ACE_GUARD_RETURN (typename SYNCH_TRAITS::MUTEX, m, this->flush_lock_, -1);
+
+  if (threshold != 0
+      && this->zerocopy_threshold_ == 0
+      && ACE::enable_zerocopy (this->peer ().get_handle ()) == -1)
+    return -1;
+
+  this->zerocopy_threshold_ = threshold;
+  return 0;
 }
 
 template <typename PEER_STREAM, typename SYNCH_TRAITS> void
@@ -25,6 +25,7 @@
 #include "ace/Task.h"
 #include "ace/Recyclable.h"
 #include "ace/Reactor.h"
+#include "ace/Unbounded_Queue.h"
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -276,7 +277,17 @@ protected:
  * The buffering feature makes it possible to queue up
  * ACE_Message_Blocks in an ACE_Message_Queue until (1) the
  * queue is "full" or (2) a period of time elapses, at which
- * point the queue is "flushed" via <sendv_n> to the peer.
+ * point the queue is "flushed" to the peer, with gather-writes of
+ * the whole queue via ACE::send_chain().
+ *
+ * When the handler has a reactor and the peer's handle is in
+ * non-blocking mode, a flush only sends what the peer takes without
+ * blocking; the rest is kept, and sent from <handle_output> once the
+ * reactor reports that the peer is writable.  Otherwise a flush
+ * blocks until everything is sent.
+ *
+ * On Linux, flushes of large amounts of data can use MSG_ZEROCOPY,
+ * see <zerocopy_threshold>.
  */
 template <typename PEER_STREAM, typename SYNCH_TRAITS>
 class ACE_Buffered_Svc_Handler : public ACE_Svc_Handler<PEER_STREAM, SYNCH_TRAITS>
@@ -315,6 +326,21 @@ public:
   /// ACE_Message_Blocks to the <PEER_STREAM>.
   virtual int flush (void);
 
+  /// Send the data a previous flush couldn't send without blocking.
+  virtual int handle_output (ACE_HANDLE = ACE_INVALID_HANDLE);
+
+  /**
+   * Flush with MSG_ZEROCOPY when at least @a threshold bytes are to
+   * be sent, or never if @a threshold is 0.  The kernel then sends
+   * the data from the message blocks themselves, which are only
+   * released once it reports that it is done with them, on later
+   * flushes.  Zero-copy only pays off for large writes, of some 10KB
+   * and more.  The handler must be the only one sending with
+   * MSG_ZEROCOPY on the peer.  Returns -1 if the peer doesn't support
+   * it.
+   */
+  int zerocopy_threshold (size_t threshold);
+
   /// This method is not currently implemented -- this is where the
   /// integration with the <Reactor> would occur.
   virtual int handle_timeout (const ACE_Time_Value &time,
@@ -326,14 +352,62 @@ public:
 protected:
   /// Implement the flush operation on the ACE_Message_Queue, which
   /// writes all the queued ACE_Message_Blocks to the <PEER_STREAM>.
-  /// Assumes that the caller holds the lock.
+  /// Assumes that the caller holds <flush_lock_>.
   virtual int flush_i (void);
 
+  /// Release @a message_block once the kernel no longer uses its
+  /// data.
+  void release_i (ACE_Message_Block *message_block);
+
+  /// Read the MSG_ZEROCOPY completions of the peer, and release the
+  /// message blocks they are for.
+  void reap_zerocopy_i (void);
+
+  /// Serializes <put>, <flush> and <handle_output>.
+  typename SYNCH_TRAITS::MUTEX flush_lock_;
+
+  /// Messages taken off the queue but not fully sent yet, the data
+  /// already sent consumed.
+  ACE_Message_Block *pending_;
+
+  /// Last message of <pending_>.
+  ACE_Message_Block *pending_tail_;
+
+  /// Number of bytes in <pending_>.
+  size_t pending_length_;
+
+  /// Whether the reactor was asked to call <handle_output>.
+  bool output_scheduled_;
+
+  /// Number of bytes from which flushes use MSG_ZEROCOPY, 0 for
+  /// never.
+  size_t zerocopy_threshold_;
+
+  /// Number of MSG_ZEROCOPY writes made.
+  ACE_UINT32 zerocopy_writes_;
+
+  /// Number of MSG_ZEROCOPY writes the kernel reported done with.
+  ACE_UINT32 zerocopy_completed_;
+
+  /// A sent message the kernel may still be reading.
+  struct Zerocopy_Message
+  {
+    ACE_Message_Block *message_;
+
+    /// The message can be released once <zerocopy_completed_> is
+    /// past this write.
+    ACE_UINT32 write_;
+  };
+
+  /// Sent messages waiting for MSG_ZEROCOPY completions, in order.
+  ACE_Unbounded_Queue<Zerocopy_Message> zerocopy_messages_;
+
   /// Maximum size the <Message_Queue> can be before we have to flush
   /// the buffer.
   size_t maximum_buffer_size_;
 
-  /// Current size in bytes of the <Message_Queue> contents.
+  /// Current size in bytes of the <Message_Queue> contents, plus the
+  /// data of <pending_>.
   size_t current_buffer_size_;
 
   /// Timeout value used to control when the buffer is flushed.
@@ -11,6 +11,7 @@
 
 #include "ace/Module.h"
 #include "ace/Null_Condition.h"
+#include "ace/Truncate.h"
 
 #if !defined (__ACE_INLINE__)
 #include "ace/Task_T.inl"
@@ -104,6 +105,21 @@ ACE_Task<ACE_SYNCH_USE, TIME_POLICY>::module (void) const
   return this->mod_;
 }
 
+template<ACE_SYNCH_DECL, class TIME_POLICY> int
+ACE_Task<ACE_SYNCH_USE, TIME_POLICY>::put_n (ACE_Message_Block *msgs[],
+                                             size_t count,
+                                             ACE_Time_Value *tv)
+{
+  ACE_TRACE ("ACE_Task<ACE_SYNCH_USE, TIME_POLICY>::put_n");
+
+  size_t i = 0;
+  for (; i < count; ++i)
+    if (this->put (msgs[i], tv) == -1)
+      break;
+
+  return i == 0 && count != 0 ? -1 : ACE_Utils::truncate_cast<int> (i);
+}
+
 ACE_END_VERSIONED_NAMESPACE_DECL
 
 #endif /* ACE_TASK_T_CPP */
@@ -95,6 +95,28 @@ public: // Should be protected:
    */
   int getq (ACE_Message_Block *&mb, ACE_Time_Value *timeout = 0);
 
+  /**
+   * Insert the @a count messages of @a mbs into the message queue
+   * under a single lock acquisition.  Note that @a timeout uses
+   * <{absolute}> time rather than <{relative}> time.  Returns the
+   * number of messages inserted, the first ones of @a mbs and fewer
+   * than @a count if the queue stayed full until @a timeout, or -1
+   * otherwise.
+   */
+  int putq_n (ACE_Message_Block *mbs[],
+              size_t count,
+              ACE_Time_Value *timeout = 0);
+
+  /**
+   * Extract up to @a count messages from the queue into @a mbs,
+   * blocking until there is at least one.  Note that @a timeout uses
+   * <{absolute}> time rather than <{relative}> time.  Returns the
+   * number of messages extracted or -1 otherwise.
+   */
+  int getq_n (ACE_Message_Block *mbs[],
+              size_t count,
+              ACE_Time_Value *timeout = 0);
+
   /// Return a message to the queue.  Note that @a timeout uses
   /// <{absolute}> time rather than <{relative}> time.
   int ungetq (ACE_Message_Block *, ACE_Time_Value *timeout = 0);
@@ -119,6 +141,24 @@ public: // Should be protected:
    */
   int put_next (ACE_Message_Block *msg, ACE_Time_Value *timeout = 0);
 
+  /**
+   * Pass the @a count messages of @a msgs to this task, in order.  By
+   * default each one is passed to put(); tasks whose put() just
+   * queues the message can override this to queue them all with
+   * putq_n().  Returns the number of messages passed, which is less
+   * than @a count if put() failed on one, or -1 if it failed on the
+   * first.
+   */
+  virtual int put_n (ACE_Message_Block *msgs[],
+                     size_t count,
+                     ACE_Time_Value *timeout = 0);
+
+  /// Transfer the @a count messages of @a msgs to the put_n() of the
+  /// adjacent ACE_Task in a ACE_Stream.
+  int put_next_n (ACE_Message_Block *msgs[],
+                  size_t count,
+                  ACE_Time_Value *timeout = 0);
+
   // = ACE_Task utility routines to identify names et al.
   /// Return the name of the enclosing Module if there's one associated
   /// with the Task, else returns 0.
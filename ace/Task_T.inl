@@ -29,6 +29,24 @@ ACE_Task<ACE_SYNCH_USE, TIME_POLICY>::putq (ACE_Message_Block *mb, ACE_Time_Valu
   return this->msg_queue_->enqueue_tail (mb, tv);
 }
 
+template <ACE_SYNCH_DECL, class TIME_POLICY> ACE_INLINE int
+ACE_Task<ACE_SYNCH_USE, TIME_POLICY>::putq_n (ACE_Message_Block *mbs[],
+                                              size_t count,
+                                              ACE_Time_Value *tv)
+{
+  ACE_TRACE ("ACE_Task<ACE_SYNCH_USE, TIME_POLICY>::putq_n");
+  return this->msg_queue_->enqueue_batch (mbs, count, tv);
+}
+
+template <ACE_SYNCH_DECL, class TIME_POLICY> ACE_INLINE int
+ACE_Task<ACE_SYNCH_USE, TIME_POLICY>::getq_n (ACE_Message_Block *mbs[],
+                                              size_t count,
+                                              ACE_Time_Value *tv)
+{
+  ACE_TRACE ("ACE_Task<ACE_SYNCH_USE, TIME_POLICY>::getq_n");
+  return this->msg_queue_->dequeue_batch (mbs, count, tv);
+}
+
 template <ACE_SYNCH_DECL, class TIME_POLICY> ACE_INLINE int
 ACE_Task<ACE_SYNCH_USE, TIME_POLICY>::ungetq (ACE_Message_Block *mb, ACE_Time_Value *tv)
 {
@@ -113,4 +131,13 @@ ACE_Task<ACE_SYNCH_USE, TIME_POLICY>::put_next (ACE_Message_Block *msg, ACE_Time
   return this->next_ == 0 ? -1 : this->next_->put (msg, tv);
 }
 
+template <ACE_SYNCH_DECL, class TIME_POLICY> ACE_INLINE int
+ACE_Task<ACE_SYNCH_USE, TIME_POLICY>::put_next_n (ACE_Message_Block *msgs[],
+                                                  size_t count,
+                                                  ACE_Time_Value *tv)
+{
+  ACE_TRACE ("ACE_Task<ACE_SYNCH_USE, TIME_POLICY>::put_next_n");
+  return this->next_ == 0 ? -1 : this->next_->put_n (msgs, count, tv);
+}
+
 ACE_END_VERSIONED_NAMESPACE_DECL
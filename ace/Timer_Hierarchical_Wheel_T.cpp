@@ -0,0 +1,1047 @@
+// $Id$
+
+#ifndef ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP
+#define ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/OS_NS_sys_time.h"
+#include "ace/Guard_T.h"
+#include "ace/Timer_Hierarchical_Wheel_T.h"
+#include "ace/Log_Category.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+// Design/implementation notes for ACE_Timer_Hierarchical_Wheel_T.
+//
+// Timer values are converted to ticks of resolution_ microseconds and
+// every timer is kept in the list of one slot, relative to
+// current_tick_:
+//
+// - A timer due at or before current_tick_ is in the slot of
+//   current_tick_ in the first wheel (the "current" slot).
+// - Otherwise, level L is the highest group of bits in which its tick
+//   and current_tick_ differ, and the timer is in the slot of level L
+//   given by those bits of its tick.  Group 0 is the low ROOT_BITS
+//   bits, then each group has LEVEL_BITS bits.
+// - A timer differing from current_tick_ above TOTAL_BITS is on the
+//   overflow list.
+//
+// So all the timers of a slot of the first wheel share the same tick,
+// and a slot of wheel L is later than every slot of the wheels below
+// it and than the preceding slots of wheel L.  The earliest timer is
+// thus in the first non-empty slot of the lowest non-empty wheel,
+// found with the occupied_ bitmap, and only that list is searched for
+// it.
+//
+// advance() moves current_tick_ forward, one non-empty slot at a time:
+// reaching a slot of the first wheel makes it the current slot, and
+// reaching the start of a slot of a higher wheel (or of the next range
+// of overflow timers) redistributes its timers to the wheels below.
+// Empty ranges are skipped using the bitmap, so advancing costs
+// nothing for the ticks nobody waits for.  advance() is only called
+// with the current time, before timers are dispatched, so timers
+// cancelled before they get close to expiring never move.
+//
+// Timer ids index timer_ids_, which points at the node of each
+// pending timer.  Freed ids are reused oldest first, so that a stale
+// id does not immediately designate a new timer.
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE,FUNCTOR,ACE_LOCK,TIME_POLICY>::ACE_Timer_Hierarchical_Wheel_Iterator_T (Wheel& wheel)
+  : timer_wheel_ (wheel)
+  , slot_ (0)
+  , current_node_ (0)
+{
+  this->first ();
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE,FUNCTOR,ACE_LOCK,TIME_POLICY>::~ACE_Timer_Hierarchical_Wheel_Iterator_T (void)
+{
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE,FUNCTOR,ACE_LOCK,TIME_POLICY>::first (void)
+{
+  this->goto_next (0);
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE,FUNCTOR,ACE_LOCK,TIME_POLICY>::next (void)
+{
+  if (this->isdone ())
+    return;
+
+  ACE_Timer_Node_T<TYPE>* n = this->current_node_->get_next ();
+  if (n == &this->timer_wheel_.slots_[this->slot_])
+    this->goto_next (this->slot_ + 1);
+  else
+    this->current_node_ = n;
+}
+
+/// Positions the iterator at the first node of the first non-empty
+/// list at or after <start_slot>.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE,FUNCTOR,ACE_LOCK,TIME_POLICY>::goto_next (u_int start_slot)
+{
+  for (u_int i = start_slot; i < Wheel::SLOT_COUNT; ++i)
+    {
+      ACE_Timer_Node_T<TYPE>* root = &this->timer_wheel_.slots_[i];
+      ACE_Timer_Node_T<TYPE>* n = root->get_next ();
+      if (n != root)
+        {
+          this->slot_ = i;
+          this->current_node_ = n;
+          return;
+        }
+    }
+
+  this->slot_ = Wheel::SLOT_COUNT;
+  this->current_node_ = 0;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> bool
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE,FUNCTOR,ACE_LOCK,TIME_POLICY>::isdone (void) const
+{
+  return this->current_node_ == 0;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE,FUNCTOR,ACE_LOCK,TIME_POLICY>::item (void)
+{
+  return this->current_node_;
+}
+
+/**
+* Default Constructor that uses a tick of
+* ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION microseconds and
+* doesn't do any preallocation.
+*
+* @param upcall_functor A pointer to a functor to use instead of the default
+* @param freelist       A pointer to a freelist to use instead of the default
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::ACE_Timer_Hierarchical_Wheel_T
+(FUNCTOR* upcall_functor
+ , FreeList* freelist
+ , TIME_POLICY const & time_policy
+ )
+  : Base_Timer_Queue (upcall_functor, freelist, time_policy)
+  , slots_ (0)
+  , current_tick_ (0)
+  , resolution_ (0)
+  , earliest_ (0)
+  , sorted_slot_ (SLOT_COUNT)
+  , timer_ids_ (0)
+  , timer_ids_size_ (0)
+  , free_ids_ (0)
+  , free_ids_head_ (0)
+  , free_ids_count_ (0)
+  , iterator_ (0)
+  , timer_count_ (0)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::ACE_Timer_Hierarchical_Wheel_T");
+  this->open_i (0, ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION);
+}
+
+/**
+* Constructor that sets up the wheels and also may preallocate
+* some nodes on the free list
+*
+* @param resolution     The length of a tick, in microseconds
+* @param prealloc       The number of entries to prealloc in the free_list
+* @param upcall_functor A pointer to a functor to use instead of the default
+* @param freelist       A pointer to a freelist to use instead of the default
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::ACE_Timer_Hierarchical_Wheel_T
+  (u_int resolution,
+   size_t prealloc,
+   FUNCTOR* upcall_functor,
+   FreeList* freelist,
+   TIME_POLICY const & time_policy)
+  : Base_Timer_Queue (upcall_functor, freelist, time_policy)
+  , slots_ (0)
+  , current_tick_ (0)
+  , resolution_ (0)
+  , earliest_ (0)
+  , sorted_slot_ (SLOT_COUNT)
+  , timer_ids_ (0)
+  , timer_ids_size_ (0)
+  , free_ids_ (0)
+  , free_ids_head_ (0)
+  , free_ids_count_ (0)
+  , iterator_ (0)
+  , timer_count_ (0)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::ACE_Timer_Hierarchical_Wheel_T");
+  this->open_i (prealloc, resolution);
+}
+
+/**
+* Initialize the queue: create the empty lists, preallocate the nodes
+* and timer ids and position the wheels at the current time.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::open_i
+  (size_t prealloc, u_int resolution)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::open_i");
+
+  this->resolution_ = resolution == 0 ? 1 : resolution;
+
+  ACE_NEW (this->slots_, ACE_Timer_Node_T<TYPE>[SLOT_COUNT]);
+
+  for (u_int i = 0; i < SLOT_COUNT; ++i)
+    {
+      this->slots_[i].set_prev (&this->slots_[i]);
+      this->slots_[i].set_next (&this->slots_[i]);
+    }
+
+  for (u_int i = 0; i < OCCUPIED_WORDS; ++i)
+    this->occupied_[i] = 0;
+
+  if (prealloc > 0)
+    this->free_list_->resize (prealloc);
+
+  do
+    {
+      if (this->grow_timer_ids () == -1)
+        return;
+    }
+  while (this->timer_ids_size_ < prealloc);
+
+  this->current_tick_ = this->ticks (this->gettimeofday_static ());
+
+  ACE_NEW (iterator_, Iterator (*this));
+}
+
+/// Destructor just cleans up its memory
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::~ACE_Timer_Hierarchical_Wheel_T (void)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::~ACE_Timer_Hierarchical_Wheel_T");
+
+  delete iterator_;
+
+  this->close ();
+
+  delete [] this->slots_;
+  delete [] this->timer_ids_;
+  delete [] this->free_ids_;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::close (void)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::close");
+
+  if (this->slots_ == 0)
+    return 0;
+
+  // Remove any remaining nodes
+  for (u_int i = 0; i < SLOT_COUNT; ++i)
+    {
+      ACE_Timer_Node_T<TYPE>* root = &this->slots_[i];
+      for (ACE_Timer_Node_T<TYPE>* n = root->get_next (); n != root;)
+        {
+          ACE_Timer_Node_T<TYPE>* next = n->get_next ();
+          this->upcall_functor ().deletion (*this,
+                                            n->get_type (),
+                                            n->get_act ());
+          this->free_node (n);
+          n = next;
+        }
+      root->set_prev (root);
+      root->set_next (root);
+    }
+
+  for (u_int i = 0; i < OCCUPIED_WORDS; ++i)
+    this->occupied_[i] = 0;
+
+  this->timer_count_ = 0;
+  this->earliest_ = 0;
+  return 0;
+}
+
+/// Converts @a t to a number of ticks.  Times before the epoch are
+/// tick 0, times more than 2^40 seconds after it are the same tick.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_UINT64
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::ticks
+  (const ACE_Time_Value& t) const
+{
+  if (t.sec () < 0)
+    return 0;
+
+  ACE_UINT64 const max_sec = ACE_UINT64 (1) << 40;
+  ACE_UINT64 sec = static_cast<ACE_UINT64> (t.sec ());
+  if (sec > max_sec)
+    sec = max_sec;
+
+  return (sec * ACE_ONE_SECOND_IN_USECS + t.usec ()) / this->resolution_;
+}
+
+/// Returns the slot (or the overflow list) of a timer due at @a tick.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> u_int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::slot_of
+  (ACE_UINT64 tick) const
+{
+  if (tick <= this->current_tick_)
+    return static_cast<u_int> (this->current_tick_ & (ROOT_SIZE - 1));
+
+  ACE_UINT64 const diff = tick ^ this->current_tick_;
+  if (diff < ROOT_SIZE)
+    return static_cast<u_int> (tick & (ROOT_SIZE - 1));
+
+  u_int shift = ROOT_BITS;
+  u_int base = ROOT_SIZE;
+  for (u_int level = 1;
+       level < LEVELS;
+       ++level, shift += LEVEL_BITS, base += LEVEL_SIZE)
+    {
+      if ((diff >> (shift + LEVEL_BITS)) == 0)
+        return base + static_cast<u_int> ((tick >> shift) & (LEVEL_SIZE - 1));
+    }
+
+  return OVERFLOW_SLOT;
+}
+
+/// Returns the first non-empty slot in [<from>, <to>), or <to>.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> u_int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::next_occupied
+  (u_int from, u_int to) const
+{
+  while (from < to)
+    {
+      ACE_UINT64 bits = this->occupied_[from / 64] >> (from % 64);
+      if (bits != 0)
+        {
+#if defined (__GNUC__)
+          from += static_cast<u_int> (__builtin_ctzll (bits));
+#else
+          for (; (bits & 1) == 0; bits >>= 1)
+            ++from;
+#endif /* __GNUC__ */
+          return from < to ? from : to;
+        }
+      from = (from / 64 + 1) * 64;
+    }
+
+  return to;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> bool
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::is_empty (void) const
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::is_empty");
+  return this->timer_count_ == 0;
+}
+
+/**
+* @return First (earliest) node in the queue
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> const ACE_Time_Value &
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::earliest_time (void) const
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::earliest_time");
+  ACE_Timer_Node_T<TYPE>* n = this->get_first_i ();
+  if (n != 0)
+    return n->get_timer_value ();
+  return ACE_Time_Value::zero;
+}
+
+/// Links @a n at the end of the list of its slot, or after the last
+/// node due no later than it in the sorted slot.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::link
+  (ACE_Timer_Node_T<TYPE>* n)
+{
+  this->link (n, this->slot_of (this->ticks (n->get_timer_value ())));
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::link
+  (ACE_Timer_Node_T<TYPE>* n, u_int slot)
+{
+  ACE_Timer_Node_T<TYPE>* root = &this->slots_[slot];
+  ACE_Timer_Node_T<TYPE>* last = root->get_prev ();
+
+  // Timers mostly come due after the ones already there, so the
+  // search from the end is short.
+  if (slot == this->sorted_slot_)
+    while (last != root
+           && n->get_timer_value () < last->get_timer_value ())
+      last = last->get_prev ();
+
+  ACE_Timer_Node_T<TYPE>* next = last->get_next ();
+  n->set_prev (last);
+  n->set_next (next);
+  last->set_next (n);
+  next->set_prev (n);
+
+  if (slot != OVERFLOW_SLOT)
+    this->occupied_[slot / 64] |= ACE_UINT64 (1) << (slot % 64);
+}
+
+/// Removes @a n from its list.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::unlink
+  (ACE_Timer_Node_T<TYPE>* n)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::unlink");
+
+  ACE_Timer_Node_T<TYPE>* prev = n->get_prev ();
+  ACE_Timer_Node_T<TYPE>* next = n->get_next ();
+  prev->set_next (next);
+  next->set_prev (prev);
+
+  // Both neighbours are the same node only if it is the head of a
+  // list that is now empty.
+  if (prev == next)
+    {
+      u_int const slot = static_cast<u_int> (prev - this->slots_);
+      if (slot != OVERFLOW_SLOT)
+        this->occupied_[slot / 64] &= ~(ACE_UINT64 (1) << (slot % 64));
+    }
+
+  n->set_prev (0);
+  n->set_next (0);
+
+  --this->timer_count_;
+  if (n == this->earliest_)
+    this->earliest_ = 0;
+}
+
+/// Moves all the nodes of slot <from> to the end of slot <to>.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::splice
+  (u_int from, u_int to)
+{
+  ACE_Timer_Node_T<TYPE>* src = &this->slots_[from];
+  if (from == to || src->get_next () == src)
+    return;
+
+  ACE_Timer_Node_T<TYPE>* dst = &this->slots_[to];
+
+  // The nodes keep their order only if they go to an empty list.
+  if (from == this->sorted_slot_ && dst->get_next () == dst)
+    this->sorted_slot_ = to;
+  else if (to == this->sorted_slot_)
+    this->sorted_slot_ = SLOT_COUNT;
+
+  ACE_Timer_Node_T<TYPE>* first = src->get_next ();
+  ACE_Timer_Node_T<TYPE>* last = src->get_prev ();
+  ACE_Timer_Node_T<TYPE>* tail = dst->get_prev ();
+
+  tail->set_next (first);
+  first->set_prev (tail);
+  last->set_next (dst);
+  dst->set_prev (last);
+
+  src->set_prev (src);
+  src->set_next (src);
+
+  this->occupied_[from / 64] &= ~(ACE_UINT64 (1) << (from % 64));
+  this->occupied_[to / 64] |= ACE_UINT64 (1) << (to % 64);
+}
+
+/// Redistributes the nodes of @a slot according to <current_tick_>.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::cascade
+  (u_int slot)
+{
+  ACE_Timer_Node_T<TYPE>* root = &this->slots_[slot];
+  ACE_Timer_Node_T<TYPE>* n = root->get_next ();
+  if (n == root)
+    return;
+
+  // Detach the whole list first: some nodes may go back to it.
+  root->get_prev ()->set_next (0);
+  root->set_prev (root);
+  root->set_next (root);
+  if (slot != OVERFLOW_SLOT)
+    this->occupied_[slot / 64] &= ~(ACE_UINT64 (1) << (slot % 64));
+
+  while (n != 0)
+    {
+      ACE_Timer_Node_T<TYPE>* next = n->get_next ();
+      this->link (n);
+      n = next;
+    }
+}
+
+/// Moves <current_tick_> forward to @a tick, cascading the slots
+/// reached on the way.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::advance
+  (ACE_UINT64 tick)
+{
+  while (tick > this->current_tick_)
+    {
+      ACE_UINT64 const cur = this->current_tick_;
+      u_int const current_slot = static_cast<u_int> (cur & (ROOT_SIZE - 1));
+
+      // Find the start of the next non-empty slot.
+      u_int slot = this->next_occupied (current_slot + 1, ROOT_SIZE);
+      ACE_UINT64 start = (cur & ~ACE_UINT64 (ROOT_SIZE - 1)) | slot;
+
+      if (slot == ROOT_SIZE)
+        {
+          slot = SLOT_COUNT;
+
+          u_int shift = ROOT_BITS;
+          u_int base = ROOT_SIZE;
+          for (u_int level = 1;
+               level < LEVELS && slot == SLOT_COUNT;
+               ++level, shift += LEVEL_BITS, base += LEVEL_SIZE)
+            {
+              u_int const digit =
+                static_cast<u_int> ((cur >> shift) & (LEVEL_SIZE - 1));
+              u_int const s = this->next_occupied (base + digit + 1,
+                                                   base + LEVEL_SIZE);
+              if (s < base + LEVEL_SIZE)
+                {
+                  slot = s;
+                  start = ((cur >> (shift + LEVEL_BITS)) << (shift + LEVEL_BITS))
+                    | (ACE_UINT64 (s - base) << shift);
+                }
+            }
+
+          ACE_Timer_Node_T<TYPE>* overflow = &this->slots_[OVERFLOW_SLOT];
+          if (slot == SLOT_COUNT && overflow->get_next () != overflow)
+            {
+              // Move on to the range holding the earliest overflow timer.
+              ACE_UINT64 earliest = ~ACE_UINT64 (0);
+              for (ACE_Timer_Node_T<TYPE>* n = overflow->get_next ();
+                   n != overflow;
+                   n = n->get_next ())
+                {
+                  ACE_UINT64 const t = this->ticks (n->get_timer_value ());
+                  if (t < earliest)
+                    earliest = t;
+                }
+
+              slot = OVERFLOW_SLOT;
+              start = (earliest >> TOTAL_BITS) << TOTAL_BITS;
+            }
+        }
+
+      if (slot == SLOT_COUNT || start > tick)
+        {
+          // Nothing is due up to <tick>.
+          this->current_tick_ = tick;
+          this->splice (current_slot,
+                        static_cast<u_int> (tick & (ROOT_SIZE - 1)));
+          return;
+        }
+
+      this->current_tick_ = start;
+      this->splice (current_slot,
+                    static_cast<u_int> (start & (ROOT_SIZE - 1)));
+
+      if (slot >= ROOT_SIZE)
+        this->cascade (slot);
+    }
+}
+
+/**
+* Creates a ACE_Timer_Node_T based on the input parameters.  Then inserts
+* the node into the wheel using schedule_i.
+*
+* @param type The data of the timer node
+* @param act  Asynchronous Completion Token (AKA magic cookie)
+* @param future_time The time the timer is scheduled for (absolute time)
+* @param interval If not ACE_Time_Value::zero, then this is a periodic
+*                 timer and interval is the time period
+*
+* @return Unique identifier (can be used to cancel the timer).
+*         -1 on failure.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> long
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::schedule_i (const TYPE& type,
+                                                                      const void* act,
+                                                                      const ACE_Time_Value& future_time,
+                                                                      const ACE_Time_Value& interval)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::schedule_i");
+
+  ACE_Timer_Node_T<TYPE>* n = this->alloc_node ();
+
+  if (n != 0)
+    {
+      long const id = this->pop_freelist ();
+
+      if (id == -1)
+        {
+          Base_Timer_Queue::free_node (n);
+          errno = ENOMEM;
+          return -1;
+        }
+
+      // Catch up with the time spent idle, so that the timer lands in
+      // the slot it would be in had the queue been dispatching.
+      if (this->timer_count_ == 0)
+        this->advance (this->ticks (this->gettimeofday_static ()));
+
+      n->set (type, act, future_time, interval, 0, 0, id);
+      this->timer_ids_[id] = n;
+      this->reschedule (n);
+      return id;
+    }
+
+  // Failure return
+  errno = ENOMEM;
+  return -1;
+}
+
+/**
+* Links a node, new or just expired, in the wheels.  Also makes sure
+* to update the earliest node.
+*
+* @param n The timer node to reschedule
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::reschedule (ACE_Timer_Node_T<TYPE>* n)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::reschedule");
+
+  this->link (n);
+  ++this->timer_count_;
+
+  if (this->earliest_ != 0
+      && n->get_timer_value () < this->earliest_->get_timer_value ())
+    this->earliest_ = n;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::free_node (ACE_Timer_Node_T<TYPE>* n)
+{
+  this->push_freelist (n->get_timer_id ());
+  Base_Timer_Queue::free_node (n);
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::dispatch_info_i
+  (const ACE_Time_Value& cur_time,
+   ACE_Timer_Node_Dispatch_Info_T<TYPE>& info)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::dispatch_info_i");
+
+  this->advance (this->ticks (cur_time));
+  return Base_Timer_Queue::dispatch_info_i (cur_time, info);
+}
+
+/// Returns the node of @a timer_id, 0 if it is not in use.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::find_node (long timer_id) const
+{
+  if (timer_id < 0 || static_cast<size_t> (timer_id) >= this->timer_ids_size_)
+    return 0;
+  return this->timer_ids_[timer_id];
+}
+
+/// Takes the oldest free timer id, growing the table if none is left.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> long
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::pop_freelist (void)
+{
+  if (this->free_ids_count_ == 0 && this->grow_timer_ids () == -1)
+    return -1;
+
+  long const id = this->free_ids_[this->free_ids_head_];
+  if (++this->free_ids_head_ == this->timer_ids_size_)
+    this->free_ids_head_ = 0;
+  --this->free_ids_count_;
+  return id;
+}
+
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::push_freelist (long timer_id)
+{
+  this->timer_ids_[timer_id] = 0;
+
+  size_t tail = this->free_ids_head_ + this->free_ids_count_;
+  if (tail >= this->timer_ids_size_)
+    tail -= this->timer_ids_size_;
+  this->free_ids_[tail] = timer_id;
+  ++this->free_ids_count_;
+}
+
+/// Doubles the number of timer ids.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::grow_timer_ids (void)
+{
+  size_t const new_size = this->timer_ids_size_ == 0
+    ? ACE_DEFAULT_TIMERS
+    : this->timer_ids_size_ * 2;
+
+  ACE_Timer_Node_T<TYPE>** timer_ids = 0;
+  ACE_NEW_RETURN (timer_ids, ACE_Timer_Node_T<TYPE>*[new_size], -1);
+
+  long* free_ids = 0;
+  ACE_NEW_NORETURN (free_ids, long[new_size]);
+  if (free_ids == 0)
+    {
+      delete [] timer_ids;
+      errno = ENOMEM;
+      return -1;
+    }
+
+  size_t i = 0;
+  for (; i < this->timer_ids_size_; ++i)
+    timer_ids[i] = this->timer_ids_[i];
+  for (; i < new_size; ++i)
+    timer_ids[i] = 0;
+
+  // Keep the ids already free ahead of the new ones.
+  size_t n = 0;
+  for (; n < this->free_ids_count_; ++n)
+    free_ids[n] =
+      this->free_ids_[(this->free_ids_head_ + n) % this->timer_ids_size_];
+  for (i = this->timer_ids_size_; i < new_size; ++i)
+    free_ids[n++] = static_cast<long> (i);
+
+  delete [] this->timer_ids_;
+  delete [] this->free_ids_;
+  this->timer_ids_ = timer_ids;
+  this->free_ids_ = free_ids;
+  this->timer_ids_size_ = new_size;
+  this->free_ids_head_ = 0;
+  this->free_ids_count_ = n;
+  return 0;
+}
+
+/**
+* Find the timer node by using the id as an index.  Then use
+* set_interval() on the node to update the interval.
+*
+* @param timer_id The timer identifier
+* @param interval The new interval
+*
+* @return 0 if successful, -1 if no.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::reset_interval (long timer_id,
+                                                                          const ACE_Time_Value &interval)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::reset_interval");
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+  ACE_Timer_Node_T<TYPE>* n = this->find_node (timer_id);
+  if (n != 0)
+    {
+      // The interval will take effect the next time this node is expired.
+      n->set_interval (interval);
+      return 0;
+    }
+  return -1;
+}
+
+/**
+* Goes through every list in the wheels and whenever we find one with
+* the correct type value, we remove it and continue.
+*
+* @param type       The value to search for.
+* @param skip_close If this non-zero, the cancellation method of the
+*                   functor will not be called for each cancelled timer.
+*
+* @return Number of timers cancelled
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::cancel (const TYPE& type, int skip_close)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::cancel");
+
+  int num_canceled = 0; // Note : Technically this can overflow.
+  int cookie = 0;
+
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+
+  if (!this->is_empty ())
+    {
+      for (u_int i = 0; i < SLOT_COUNT; ++i)
+        {
+          ACE_Timer_Node_T<TYPE>* root = &this->slots_[i];
+          for (ACE_Timer_Node_T<TYPE>* n = root->get_next (); n != root; )
+            {
+              ACE_Timer_Node_T<TYPE>* next = n->get_next ();
+              if (n->get_type () == type)
+                {
+                  ++num_canceled;
+                  this->unlink (n);
+                  this->free_node (n);
+                }
+              n = next;
+            }
+        }
+    }
+
+  // Call the close hooks.
+
+  // cancel_type() called once per <type>.
+  this->upcall_functor ().cancel_type (*this,
+                                       type,
+                                       skip_close,
+                                       cookie);
+
+  for (int i = 0;
+       i < num_canceled;
+       ++i)
+    {
+      // cancel_timer() called once per <timer>.
+      this->upcall_functor ().cancel_timer (*this,
+                                            type,
+                                            skip_close,
+                                            cookie);
+    }
+
+  return num_canceled;
+}
+
+/**
+* Cancels the single timer that is specified by the timer_id, found
+* in O(1) through the timer id table.
+*
+* @param timer_id   Timer Identifier
+* @param act        Asychronous Completion Token (AKA magic cookie):
+*                   If this is non-zero, stores the magic cookie of
+*                   the cancelled timer here.
+* @param skip_close If this non-zero, the cancellation method of the
+*                   functor will not be called.
+*
+* @return 1 for sucess and 0 if the timer_id wasn't found (or was
+*         found to be invalid)
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> int
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::cancel (long timer_id,
+                                                                  const void **act,
+                                                                  int skip_close)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::cancel");
+  ACE_MT (ACE_GUARD_RETURN (ACE_LOCK, ace_mon, this->mutex_, -1));
+  ACE_Timer_Node_T<TYPE>* n = this->find_node (timer_id);
+
+  // Nodes returned by remove_first() are not in the wheels anymore.
+  if (n == 0 || n->get_prev () == 0)
+    return 0;
+
+  // Call the close hooks.
+  int cookie = 0;
+
+  // cancel_type() called once per <type>.
+  this->upcall_functor ().cancel_type (*this,
+                                       n->get_type (),
+                                       skip_close,
+                                       cookie);
+
+  // cancel_timer() called once per <timer>.
+  this->upcall_functor ().cancel_timer (*this,
+                                        n->get_type (),
+                                        skip_close,
+                                        cookie);
+  if (act != 0)
+    *act = n->get_act ();
+
+  this->unlink (n);
+  this->free_node (n);
+  return 1;
+}
+
+/**
+* Dumps out the resolution, the current tick and every node of every
+* slot.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::dump (void) const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::dump");
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\nresolution_ = %u"), this->resolution_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\ncurrent_tick_ = %Q"), this->current_tick_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\ntimer_count_ = %B"), this->timer_count_));
+  ACELIB_DEBUG ((LM_DEBUG,
+    ACE_TEXT ("\nslots_ =\n")));
+
+  for (u_int i = 0; i < SLOT_COUNT; ++i)
+    {
+      ACE_Timer_Node_T<TYPE>* root = &this->slots_[i];
+      if (root->get_next () == root)
+        continue;
+
+      ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("%d\n"), i));
+      for (ACE_Timer_Node_T<TYPE>* n = root->get_next ();
+           n != root;
+           n = n->get_next ())
+        {
+          n->dump ();
+        }
+    }
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+/**
+* Removes the earliest node.  Its timer id stays in use until the node
+* is rescheduled or freed.
+*
+* @return The earliest timer node.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> ACE_Timer_Node_T<TYPE> *
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::remove_first (void)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::remove_first");
+  ACE_Timer_Node_T<TYPE>* n = this->get_first_i ();
+  if (n != 0)
+    this->unlink (n);
+  return n;
+}
+
+/**
+* Returns the earliest node without removing it
+*
+* @return The earliest timer node.
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::get_first (void)
+{
+  ACE_TRACE ("ACE_Timer_Hierarchical_Wheel_T::get_first");
+  return this->get_first_i ();
+}
+
+/// Returns the first node of the first non-empty slot of the lowest
+/// non-empty wheel, sorting that slot unless it is the sorted one.
+/// Only the first call after the earliest node moved to another slot
+/// has to sort.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Node_T<TYPE>*
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::get_first_i (void) const
+{
+  if (this->earliest_ != 0 || this->timer_count_ == 0)
+    return this->earliest_;
+
+  ACE_UINT64 const cur = this->current_tick_;
+  u_int slot = this->next_occupied (static_cast<u_int> (cur & (ROOT_SIZE - 1)),
+                                    ROOT_SIZE);
+
+  if (slot == ROOT_SIZE)
+    {
+      slot = OVERFLOW_SLOT;
+
+      u_int shift = ROOT_BITS;
+      u_int base = ROOT_SIZE;
+      for (u_int level = 1;
+           level < LEVELS && slot == OVERFLOW_SLOT;
+           ++level, shift += LEVEL_BITS, base += LEVEL_SIZE)
+        {
+          u_int const digit =
+            static_cast<u_int> ((cur >> shift) & (LEVEL_SIZE - 1));
+          u_int const s = this->next_occupied (base + digit + 1,
+                                               base + LEVEL_SIZE);
+          if (s < base + LEVEL_SIZE)
+            slot = s;
+        }
+    }
+
+  if (slot != this->sorted_slot_)
+    this->sort (slot);
+
+  this->earliest_ = this->slots_[slot].get_next ();
+  return this->earliest_;
+}
+
+/// Sorts the list of @a slot by time, keeping the order of the nodes
+/// due at the same time, and makes it the sorted slot.  A bottom-up
+/// merge sort, in O(n log n) without extra memory.
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY> void
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::sort
+  (u_int slot) const
+{
+  ACE_Timer_Node_T<TYPE>* root = &this->slots_[slot];
+  ACE_Timer_Node_T<TYPE>* list = root->get_next ();
+  this->sorted_slot_ = slot;
+  if (list == root)
+    return;
+
+  // Merge runs of <width> nodes of the list, linked through their
+  // next pointers only, until a single run is left.
+  root->get_prev ()->set_next (0);
+  for (size_t width = 1; ; width *= 2)
+    {
+      ACE_Timer_Node_T<TYPE>* head = 0;
+      ACE_Timer_Node_T<TYPE>* tail = 0;
+      size_t merges = 0;
+
+      for (ACE_Timer_Node_T<TYPE>* p = list; p != 0; ++merges)
+        {
+          ACE_Timer_Node_T<TYPE>* q = p;
+          size_t p_size = 0;
+          for (; p_size < width && q != 0; ++p_size)
+            q = q->get_next ();
+          size_t q_size = width;
+
+          while (p_size > 0 || (q_size > 0 && q != 0))
+            {
+              ACE_Timer_Node_T<TYPE>* n = 0;
+              if (p_size == 0
+                  || (q_size > 0 && q != 0
+                      && q->get_timer_value () < p->get_timer_value ()))
+                {
+                  n = q;
+                  q = q->get_next ();
+                  --q_size;
+                }
+              else
+                {
+                  n = p;
+                  p = p->get_next ();
+                  --p_size;
+                }
+
+              if (tail == 0)
+                head = n;
+              else
+                tail->set_next (n);
+              tail = n;
+            }
+          p = q;
+        }
+
+      tail->set_next (0);
+      list = head;
+      if (merges <= 1)
+        break;
+    }
+
+  ACE_Timer_Node_T<TYPE>* prev = root;
+  for (ACE_Timer_Node_T<TYPE>* n = list; n != 0; n = n->get_next ())
+    {
+      n->set_prev (prev);
+      prev->set_next (n);
+      prev = n;
+    }
+  prev->set_next (root);
+  root->set_prev (prev);
+}
+
+/**
+* @return The iterator
+*/
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+ACE_Timer_Queue_Iterator_T<TYPE> &
+ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>::iter (void)
+{
+  this->iterator_->first ();
+  return *this->iterator_;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_TIMER_HIERARCHICAL_WHEEL_T_CPP */
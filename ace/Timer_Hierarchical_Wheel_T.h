@@ -0,0 +1,287 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Timer_Hierarchical_Wheel_T.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+#ifndef ACE_TIMER_HIERARCHICAL_WHEEL_T_H
+#define ACE_TIMER_HIERARCHICAL_WHEEL_T_H
+#include /**/ "ace/pre.h"
+
+#include "ace/Timer_Queue_T.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+// Forward declaration
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY>
+class ACE_Timer_Hierarchical_Wheel_T;
+
+/**
+ * @class ACE_Timer_Hierarchical_Wheel_Iterator_T
+ *
+ * @brief Iterates over an ACE_Timer_Hierarchical_Wheel.
+ *
+ * This is a generic iterator that can be used to visit every
+ * node of a timer queue.  Be aware that it doesn't traverse
+ * in the order of timeout values.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY = ACE_Default_Time_Policy>
+class ACE_Timer_Hierarchical_Wheel_Iterator_T
+  : public ACE_Timer_Queue_Iterator_T <TYPE>
+{
+public:
+  typedef ACE_Timer_Hierarchical_Wheel_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Wheel;
+  typedef ACE_Timer_Node_T<TYPE> Node;
+
+  /// Constructor
+  ACE_Timer_Hierarchical_Wheel_Iterator_T (Wheel &);
+
+  /// Destructor
+  virtual ~ACE_Timer_Hierarchical_Wheel_Iterator_T (void);
+
+  /// Positions the iterator at the first node in the Timer Queue
+  virtual void first (void);
+
+  /// Positions the iterator at the next node in the Timer Queue
+  virtual void next (void);
+
+  /// Returns true when there are no more nodes in the sequence
+  virtual bool isdone (void) const;
+
+  /// Returns the node at the current position in the sequence
+  virtual ACE_Timer_Node_T<TYPE>* item (void);
+
+protected:
+  /// The wheel we are iterating over.
+  Wheel& timer_wheel_;
+
+  /// Current slot of the wheel.
+  u_int slot_;
+
+  /// Current position in the list of <slot_>.
+  ACE_Timer_Node_T<TYPE>* current_node_;
+
+private:
+  void goto_next (u_int start_slot);
+};
+
+/**
+ * @class ACE_Timer_Hierarchical_Wheel_T
+ *
+ * @brief Provides a hierarchical timing wheel version of
+ * ACE_Timer_Queue.
+ *
+ * ACE_Timer_Wheel_T hashes every timer into one wheel of sorted
+ * lists, so timers far in the future crowd the same spokes as the
+ * near ones.  This queue follows Varghese and Lauck's "Hashed and
+ * Hierarchical Timing Wheels" instead: time is counted in ticks of
+ * @a resolution microseconds, the first wheel has one slot per tick
+ * and each further wheel has slots covering a full turn of the wheel
+ * below, up to 2^32 ticks (about 49 days at the default 1 ms tick).
+ * Timers further away wait on an overflow list.
+ *
+ * Slots are unsorted doubly-linked lists and timer ids index a
+ * table of nodes, so schedule() and cancel() by id are O(1) no
+ * matter how many timers are pending.  Timers only move down to a
+ * finer wheel when the time of their slot is reached by expire(), so
+ * the many timers cancelled before that, such as idle timeouts of
+ * busy connections, are never cascaded at all.  The earliest timer
+ * is found through a bitmap of the non-empty slots and is cached
+ * until it is removed.  The list of the slot it is found in is then
+ * sorted, once, and kept in order while timers are added to it, so
+ * the timers after it are found in constant time.  Nodes come from
+ * the free list of the queue, which may be preallocated.
+ */
+template <class TYPE, class FUNCTOR, class ACE_LOCK, typename TIME_POLICY = ACE_Default_Time_Policy>
+class ACE_Timer_Hierarchical_Wheel_T
+  : public ACE_Timer_Queue_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>
+{
+public:
+  /// Type of iterator
+  typedef ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Iterator;
+  /// Iterator is a friend
+  friend class ACE_Timer_Hierarchical_Wheel_Iterator_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY>;
+  typedef ACE_Timer_Node_T<TYPE> Node;
+  /// Type inherited from
+  typedef ACE_Timer_Queue_T<TYPE, FUNCTOR, ACE_LOCK, TIME_POLICY> Base_Timer_Queue;
+  typedef ACE_Free_List<Node> FreeList;
+
+  /// Default constructor
+  ACE_Timer_Hierarchical_Wheel_T (FUNCTOR* upcall_functor = 0,
+                                  FreeList* freelist = 0,
+                                  TIME_POLICY const & time_policy = TIME_POLICY());
+
+  /**
+   * Constructor with the length of a tick, in microseconds, and the
+   * number of timer nodes and ids to preallocate.
+   */
+  ACE_Timer_Hierarchical_Wheel_T (u_int resolution,
+                                  size_t prealloc = 0,
+                                  FUNCTOR* upcall_functor = 0,
+                                  FreeList* freelist = 0,
+                                  TIME_POLICY const & time_policy = TIME_POLICY());
+
+  /// Destructor
+  virtual ~ACE_Timer_Hierarchical_Wheel_T (void);
+
+  /// True if queue is empty, else false.
+  virtual bool is_empty (void) const;
+
+  /// Returns the time of the earlier node in the queue.
+  /// Must be called on a non-empty queue.
+  virtual const ACE_Time_Value& earliest_time (void) const;
+
+  /// Changes the interval of a timer (and can make it periodic or non
+  /// periodic by setting it to ACE_Time_Value::zero or not).
+  virtual int reset_interval (long timer_id,
+                              const ACE_Time_Value& interval);
+
+  /// Cancel all timer associated with @a type.  If @a dont_call_handle_close is
+  /// 0 then the <functor> will be invoked.  Returns number of timers
+  /// cancelled.
+  virtual int cancel (const TYPE& type,
+                      int dont_call_handle_close = 1);
+
+  /// Cancel a timer, storing the magic cookie in act (if nonzero).
+  /// Calls the functor if dont_call_handle_close is 0 and returns 1
+  /// on success
+  virtual int cancel (long timer_id,
+                      const void** act = 0,
+                      int dont_call_handle_close = 1);
+
+  /**
+   * Destroy timer queue. Cancels all timers.
+   */
+  virtual int close (void);
+
+  /// Returns a pointer to this <ACE_Timer_Queue_T>'s iterator.
+  virtual ACE_Timer_Queue_Iterator_T<TYPE> & iter (void);
+
+  /// Removes the earliest node from the queue and returns it
+  virtual ACE_Timer_Node_T<TYPE>* remove_first (void);
+
+  /// Dump the state of an object.
+  virtual void dump (void) const;
+
+  /// Reads the earliest node from the queue and returns it.
+  virtual ACE_Timer_Node_T<TYPE>* get_first (void);
+
+protected:
+  /// Schedules a timer.
+  virtual long schedule_i (const TYPE& type,
+                           const void* act,
+                           const ACE_Time_Value& future_time,
+                           const ACE_Time_Value& interval);
+
+  /// Reschedule an "interval" node.
+  virtual void reschedule (ACE_Timer_Node_T<TYPE> *);
+
+  /// Returns the timer id of @a node to the free ids, then @a node
+  /// to the free list.
+  virtual void free_node (ACE_Timer_Node_T<TYPE> *node);
+
+  /// Advances the wheels to @a current_time before looking for an
+  /// expired timer.
+  virtual int dispatch_info_i (const ACE_Time_Value &current_time,
+                               ACE_Timer_Node_Dispatch_Info_T<TYPE> &info);
+
+private:
+  enum
+  {
+    /// Number of wheels.
+    LEVELS = 5,
+    /// log2 of the number of slots of the first wheel.
+    ROOT_BITS = 8,
+    /// log2 of the number of slots of each further wheel.
+    LEVEL_BITS = 6,
+    ROOT_SIZE = 1 << ROOT_BITS,
+    LEVEL_SIZE = 1 << LEVEL_BITS,
+    /// Number of ticks the wheels cover: 2^TOTAL_BITS.
+    TOTAL_BITS = ROOT_BITS + (LEVELS - 1) * LEVEL_BITS,
+    /// Index of the overflow list, after the slots of all the wheels.
+    OVERFLOW_SLOT = ROOT_SIZE + (LEVELS - 1) * LEVEL_SIZE,
+    SLOT_COUNT = OVERFLOW_SLOT + 1,
+    /// Number of words in <occupied_>, one bit per slot.
+    OCCUPIED_WORDS = OVERFLOW_SLOT / 64
+  };
+
+  // The following are documented in the .cpp file.
+  void open_i (size_t prealloc, u_int resolution);
+  ACE_UINT64 ticks (const ACE_Time_Value &t) const;
+  u_int slot_of (ACE_UINT64 tick) const;
+  u_int next_occupied (u_int from, u_int to) const;
+  ACE_Timer_Node_T<TYPE>* get_first_i (void) const;
+  void sort (u_int slot) const;
+  void link (ACE_Timer_Node_T<TYPE>* n);
+  void link (ACE_Timer_Node_T<TYPE>* n, u_int slot);
+  void unlink (ACE_Timer_Node_T<TYPE>* n);
+  void splice (u_int from, u_int to);
+  void cascade (u_int slot);
+  void advance (ACE_UINT64 tick);
+  ACE_Timer_Node_T<TYPE>* find_node (long timer_id) const;
+  long pop_freelist (void);
+  void push_freelist (long timer_id);
+  int grow_timer_ids (void);
+
+private:
+  /// Head node of the list of each slot, then of the overflow list.
+  ACE_Timer_Node_T<TYPE>* slots_;
+
+  /// One bit per slot of the wheels, set while its list isn't empty.
+  ACE_UINT64 occupied_[OCCUPIED_WORDS];
+
+  /// Tick the wheels are positioned at.  Timers due at or before it
+  /// wait in its slot of the first wheel.
+  ACE_UINT64 current_tick_;
+
+  /// Length of a tick, in microseconds.
+  u_int resolution_;
+
+  /// Cached earliest node, 0 when unknown.
+  mutable ACE_Timer_Node_T<TYPE>* earliest_;
+
+  /// Slot whose list is kept sorted by time, SLOT_COUNT for none.
+  mutable u_int sorted_slot_;
+
+  /// Node of each timer id, 0 for free ids.
+  ACE_Timer_Node_T<TYPE>** timer_ids_;
+
+  /// Size of <timer_ids_> and <free_ids_>.
+  size_t timer_ids_size_;
+
+  /// Ring of the free timer ids, reused oldest first.
+  long* free_ids_;
+
+  /// Position of the oldest free id in <free_ids_>.
+  size_t free_ids_head_;
+
+  /// Number of free ids in <free_ids_>.
+  size_t free_ids_count_;
+
+  /// Iterator used to expire timers.
+  Iterator* iterator_;
+
+  /// The total number of timers currently scheduled.
+  size_t timer_count_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (ACE_TEMPLATES_REQUIRE_SOURCE)
+#include "ace/Timer_Hierarchical_Wheel_T.cpp"
+#endif /* ACE_TEMPLATES_REQUIRE_SOURCE */
+
+#if defined (ACE_TEMPLATES_REQUIRE_PRAGMA)
+#pragma implementation ("Timer_Hierarchical_Wheel_T.cpp")
+#endif /* ACE_TEMPLATES_REQUIRE_PRAGMA */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_TIMER_HIERARCHICAL_WHEEL_T_H */
@@ -0,0 +1,655 @@
+// $Id$
+
+#include "ace/Uring_Proactor.h"
+
+#if defined (ACE_HAS_AIO_CALLS) && defined (ACE_HAS_IO_URING)
+
+#include "ace/Log_Category.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_mman.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Countdown_Time.h"
+
+#include /**/ <sys/syscall.h>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  // The head/tail indices are shared with the kernel; the kernel
+  // side uses acquire/release semantics so we have to match them.
+  inline unsigned int
+  ace_uring_load_acquire (const unsigned int *p)
+  {
+    unsigned int const v = *static_cast<const volatile unsigned int *> (p);
+    __sync_synchronize ();
+    return v;
+  }
+
+  inline void
+  ace_uring_store_release (unsigned int *p, unsigned int v)
+  {
+    __sync_synchronize ();
+    *static_cast<volatile unsigned int *> (p) = v;
+  }
+
+  inline int
+  ace_uring_enter (ACE_HANDLE fd,
+                   unsigned int to_submit,
+                   unsigned int min_complete,
+                   unsigned int flags,
+                   void *arg,
+                   size_t argsz)
+  {
+    return static_cast<int> (::syscall (__NR_io_uring_enter,
+                                        fd,
+                                        to_submit,
+                                        min_complete,
+                                        flags,
+                                        arg,
+                                        argsz));
+  }
+}
+
+ACE_Uring_Proactor::ACE_Uring_Proactor (size_t max_aio_operations)
+  : ACE_POSIX_AIOCB_Proactor (max_aio_operations,
+                              ACE_POSIX_Proactor::PROACTOR_URING),
+    ring_fd_ (ACE_INVALID_HANDLE),
+    features_ (0),
+    sq_ring_ (MAP_FAILED),
+    sq_ring_size_ (0),
+    sq_head_ (0),
+    sq_tail_ (0),
+    sq_mask_ (0),
+    sq_entries_ (0),
+    sq_array_ (0),
+    sqes_ (static_cast<io_uring_sqe *> (MAP_FAILED)),
+    sqes_size_ (0),
+    cq_ring_ (MAP_FAILED),
+    cq_ring_size_ (0),
+    cq_head_ (0),
+    cq_tail_ (0),
+    cq_mask_ (0),
+    cqes_ (0),
+    sq_local_tail_ (0),
+    sq_pending_ (0),
+    dispatching_ (0),
+    generation_ (0)
+{
+  ACE_NEW (this->generation_, ACE_UINT32[this->aiocb_list_max_size_]);
+  for (size_t i = 0; i < this->aiocb_list_max_size_; ++i)
+    this->generation_[i] = 0;
+
+  ACE_OS::memset (&this->timeout_, 0, sizeof (this->timeout_));
+
+  // One submission entry per slot; the kernel sizes the completion
+  // ring at twice that, which leaves room for cancellations.
+  if (this->open_ring (static_cast<unsigned int> (this->aiocb_list_max_size_)) == -1)
+    ACELIB_ERROR ((LM_ERROR,
+                   ACE_TEXT ("%N:%l:(%P | %t)::%p\n"),
+                   ACE_TEXT ("ACE_Uring_Proactor: io_uring_setup failed")));
+
+  // To provide correct virtual calls.
+  this->create_notify_manager ();
+
+  // we should start pseudo-asynchronous accept task
+  // one per all future acceptors
+  this->get_asynch_pseudo_task ().start ();
+}
+
+// Destructor.
+ACE_Uring_Proactor::~ACE_Uring_Proactor (void)
+{
+  this->close ();
+
+  delete [] this->generation_;
+  this->generation_ = 0;
+}
+
+ACE_POSIX_Proactor::Proactor_Type
+ACE_Uring_Proactor::get_impl_type (void)
+{
+  return PROACTOR_URING;
+}
+
+int
+ACE_Uring_Proactor::close (void)
+{
+  // stop asynch accept task
+  this->get_asynch_pseudo_task ().stop ();
+
+  this->delete_notify_manager ();
+
+  this->clear_result_queue ();
+
+  // Operations in flight still reference our result objects; the
+  // kernel has to let go of them before the lists are deleted.
+  this->drain_ring ();
+
+  int const result = this->delete_result_aiocb_list ();
+
+  this->close_ring ();
+
+  return result;
+}
+
+int
+ACE_Uring_Proactor::open_ring (unsigned int entries)
+{
+  io_uring_params params;
+  ACE_OS::memset (&params, 0, sizeof (params));
+
+  int const fd = static_cast<int> (::syscall (__NR_io_uring_setup,
+                                              entries,
+                                              &params));
+  if (fd < 0)
+    return -1;
+
+  this->ring_fd_ = fd;
+  this->features_ = params.features;
+
+  this->sq_ring_size_ =
+    params.sq_off.array + params.sq_entries * sizeof (unsigned int);
+  this->cq_ring_size_ =
+    params.cq_off.cqes + params.cq_entries * sizeof (io_uring_cqe);
+
+  if (ACE_BIT_ENABLED (this->features_, IORING_FEAT_SINGLE_MMAP)
+      && this->cq_ring_size_ > this->sq_ring_size_)
+    this->sq_ring_size_ = this->cq_ring_size_;
+
+  this->sq_ring_ = ACE_OS::mmap (0,
+                                 this->sq_ring_size_,
+                                 PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE,
+                                 this->ring_fd_,
+                                 IORING_OFF_SQ_RING);
+  if (this->sq_ring_ == MAP_FAILED)
+    {
+      this->close_ring ();
+      return -1;
+    }
+
+  if (ACE_BIT_ENABLED (this->features_, IORING_FEAT_SINGLE_MMAP))
+    {
+      this->cq_ring_ = this->sq_ring_;
+      this->cq_ring_size_ = 0;
+    }
+  else
+    {
+      this->cq_ring_ = ACE_OS::mmap (0,
+                                     this->cq_ring_size_,
+                                     PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_POPULATE,
+                                     this->ring_fd_,
+                                     IORING_OFF_CQ_RING);
+      if (this->cq_ring_ == MAP_FAILED)
+        {
+          this->close_ring ();
+          return -1;
+        }
+    }
+
+  this->sqes_size_ = params.sq_entries * sizeof (io_uring_sqe);
+  this->sqes_ =
+    static_cast<io_uring_sqe *> (ACE_OS::mmap (0,
+                                               this->sqes_size_,
+                                               PROT_READ | PROT_WRITE,
+                                               MAP_SHARED | MAP_POPULATE,
+                                               this->ring_fd_,
+                                               IORING_OFF_SQES));
+  if (this->sqes_ == MAP_FAILED)
+    {
+      this->close_ring ();
+      return -1;
+    }
+
+  char *sq = static_cast<char *> (this->sq_ring_);
+  this->sq_head_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.head);
+  this->sq_tail_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.tail);
+  this->sq_mask_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.ring_mask);
+  this->sq_entries_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.ring_entries);
+  this->sq_array_ = reinterpret_cast<unsigned int *> (sq + params.sq_off.array);
+  this->sq_local_tail_ = *this->sq_tail_;
+
+  char *cq = static_cast<char *> (this->cq_ring_);
+  this->cq_head_ = reinterpret_cast<unsigned int *> (cq + params.cq_off.head);
+  this->cq_tail_ = reinterpret_cast<unsigned int *> (cq + params.cq_off.tail);
+  this->cq_mask_ = reinterpret_cast<unsigned int *> (cq + params.cq_off.ring_mask);
+  this->cqes_ = reinterpret_cast<io_uring_cqe *> (cq + params.cq_off.cqes);
+
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("(%P | %t) ACE_Uring_Proactor::SQ entries=%u")
+                 ACE_TEXT (" CQ entries=%u\n"),
+                 params.sq_entries,
+                 params.cq_entries));
+  return 0;
+}
+
+void
+ACE_Uring_Proactor::close_ring (void)
+{
+  if (this->sqes_ != MAP_FAILED)
+    ACE_OS::munmap (this->sqes_, this->sqes_size_);
+  this->sqes_ = static_cast<io_uring_sqe *> (MAP_FAILED);
+
+  if (this->cq_ring_ != MAP_FAILED && this->cq_ring_ != this->sq_ring_)
+    ACE_OS::munmap (this->cq_ring_, this->cq_ring_size_);
+  this->cq_ring_ = MAP_FAILED;
+
+  if (this->sq_ring_ != MAP_FAILED)
+    ACE_OS::munmap (this->sq_ring_, this->sq_ring_size_);
+  this->sq_ring_ = MAP_FAILED;
+
+  if (this->ring_fd_ != ACE_INVALID_HANDLE)
+    ACE_OS::close (this->ring_fd_);
+  this->ring_fd_ = ACE_INVALID_HANDLE;
+}
+
+void
+ACE_Uring_Proactor::drain_ring (void)
+{
+  if (this->ring_fd_ == ACE_INVALID_HANDLE || this->aiocb_list_ == 0)
+    return;
+
+  {
+    ACE_MT (ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->mutex_));
+
+    for (size_t ai = 0; ai < this->aiocb_list_max_size_; ++ai)
+      if (this->aiocb_list_[ai] != 0)
+        this->cancel_aiocb (this->result_list_[ai]);
+
+    this->submit ();
+  }
+
+  // Give the kernel a bounded amount of time to acknowledge the
+  // cancellations; anything left over is reported by
+  // delete_result_aiocb_list().
+  for (int tries = 0; tries < 10 && this->num_started_aio_ > 0; ++tries)
+    {
+      this->wait_completions (100);
+
+      ACE_POSIX_Asynch_Result *results[ACE_URING_COMPLETION_BATCH];
+      int errors[ACE_URING_COMPLETION_BATCH];
+      size_t counts[ACE_URING_COMPLETION_BATCH];
+      size_t n = 0;
+
+      do
+        {
+          {
+            ACE_MT (ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->mutex_));
+            n = this->reap_completions (results, errors, counts);
+          }
+
+          for (size_t i = 0; i < n; ++i)
+            delete results[i];
+        }
+      while (n == ACE_URING_COMPLETION_BATCH);
+    }
+}
+
+ACE_UINT64
+ACE_Uring_Proactor::make_cookie (size_t slot) const
+{
+  // Zero is reserved for our own timeout and cancel requests.
+  return (static_cast<ACE_UINT64> (this->generation_[slot]) << 32)
+    | static_cast<ACE_UINT64> (slot + 1);
+}
+
+io_uring_sqe *
+ACE_Uring_Proactor::get_sqe (void)
+{
+  if (this->sqes_ == MAP_FAILED)
+    return 0;
+
+  unsigned int const head = ace_uring_load_acquire (this->sq_head_);
+  if (this->sq_local_tail_ - head >= *this->sq_entries_)
+    return 0;
+
+  unsigned int const index = this->sq_local_tail_ & *this->sq_mask_;
+  io_uring_sqe *sqe = &this->sqes_[index];
+  ACE_OS::memset (sqe, 0, sizeof (io_uring_sqe));
+
+  this->sq_array_[index] = index;
+  ++this->sq_local_tail_;
+  ++this->sq_pending_;
+  return sqe;
+}
+
+int
+ACE_Uring_Proactor::submit (void)
+{
+  // This protected method should be called with locked mutex_.
+  if (this->sq_pending_ == 0)
+    return 0;
+
+  ace_uring_store_release (this->sq_tail_, this->sq_local_tail_);
+
+  int const rc = ace_uring_enter (this->ring_fd_,
+                                  this->sq_pending_,
+                                  0,
+                                  0,
+                                  0,
+                                  0);
+  if (rc < 0)
+    {
+      // EAGAIN/EBUSY: the entries stay in the ring and go out with
+      // the next submit.
+      if (errno != EAGAIN && errno != EBUSY && errno != EINTR)
+        ACELIB_ERROR ((LM_ERROR,
+                       ACE_TEXT ("%N:%l:(%P | %t)::%p\n"),
+                       ACE_TEXT ("ACE_Uring_Proactor::submit: io_uring_enter failed")));
+      return -1;
+    }
+
+  unsigned int const submitted = static_cast<unsigned int> (rc);
+  this->sq_pending_ -= (submitted < this->sq_pending_
+                        ? submitted
+                        : this->sq_pending_);
+  return rc;
+}
+
+int
+ACE_Uring_Proactor::wait_completions (u_long milli_seconds)
+{
+  if (*this->cq_head_ != ace_uring_load_acquire (this->cq_tail_))
+    return 0; // Already have something to harvest.
+
+  unsigned int flags = IORING_ENTER_GETEVENTS;
+  void *arg = 0;
+  size_t argsz = 0;
+
+  io_uring_getevents_arg getevents_arg;
+  __kernel_timespec ts;
+
+  if (milli_seconds != ACE_INFINITE)
+    {
+      ts.tv_sec = milli_seconds / 1000;
+      ts.tv_nsec = (milli_seconds - (ts.tv_sec * 1000)) * 1000000;
+
+      if (ACE_BIT_ENABLED (this->features_, IORING_FEAT_EXT_ARG))
+        {
+          ACE_OS::memset (&getevents_arg, 0, sizeof (getevents_arg));
+          getevents_arg.ts = reinterpret_cast<ACE_UINT64> (&ts);
+          flags |= IORING_ENTER_EXT_ARG;
+          arg = &getevents_arg;
+          argsz = sizeof (getevents_arg);
+        }
+      else
+        {
+          // Pre-5.11 kernels: a timeout request completes the wait.
+          // Its completion carries a zero cookie and is discarded.
+          // The request may stay in the ring past this call, so its
+          // timeout is kept in the proactor; a request still queued
+          // when another thread waits takes the newer timeout.
+          ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+
+          io_uring_sqe *sqe = this->get_sqe ();
+          if (sqe != 0)
+            {
+              this->timeout_ = ts;
+              sqe->opcode = IORING_OP_TIMEOUT;
+              sqe->fd = -1;
+              sqe->addr = reinterpret_cast<ACE_UINT64> (&this->timeout_);
+              sqe->len = 1;
+              sqe->off = 1;
+              sqe->user_data = 0;
+              this->submit ();
+            }
+        }
+    }
+
+  return ace_uring_enter (this->ring_fd_, 0, 1, flags, arg, argsz);
+}
+
+size_t
+ACE_Uring_Proactor::reap_completions (ACE_POSIX_Asynch_Result *results[],
+                                      int errors[],
+                                      size_t counts[])
+{
+  // This protected method should be called with locked mutex_.
+  size_t n = 0;
+
+  if (this->cq_ring_ == MAP_FAILED)
+    return 0;
+
+  unsigned int head = *this->cq_head_;
+  unsigned int const tail = ace_uring_load_acquire (this->cq_tail_);
+
+  for (; head != tail && n < ACE_URING_COMPLETION_BATCH; ++head)
+    {
+      io_uring_cqe const &cqe = this->cqes_[head & *this->cq_mask_];
+
+      if (cqe.user_data == 0)
+        continue;  // timeout or cancel request
+
+      size_t const slot =
+        static_cast<size_t> (cqe.user_data & 0xffffffffU) - 1;
+      ACE_UINT32 const generation =
+        static_cast<ACE_UINT32> (cqe.user_data >> 32);
+
+      if (slot >= this->aiocb_list_max_size_
+          || this->aiocb_list_[slot] == 0
+          || this->generation_[slot] != generation)
+        continue;  // stale completion, should never be
+
+      results[n] = this->result_list_[slot];
+      if (cqe.res < 0)
+        {
+          errors[n] = -cqe.res;
+          counts[n] = 0;
+        }
+      else
+        {
+          errors[n] = 0;
+          counts[n] = static_cast<size_t> (cqe.res);
+        }
+      ++n;
+
+      this->aiocb_list_[slot] = 0;
+      this->result_list_[slot] = 0;
+      ++this->generation_[slot];
+      --this->aiocb_list_cur_size_;
+      --this->num_started_aio_;
+
+      //make attempt to start deferred AIO
+      //It is safe as we are protected by mutex_
+      this->start_deferred_aio ();
+    }
+
+  ace_uring_store_release (this->cq_head_, head);
+  return n;
+}
+
+int
+ACE_Uring_Proactor::handle_events (ACE_Time_Value &wait_time)
+{
+  // Decrement <wait_time> with the amount of time spent in the method
+  ACE_Countdown_Time countdown (&wait_time);
+  return this->handle_events_i (wait_time.msec ());
+}
+
+int
+ACE_Uring_Proactor::handle_events (void)
+{
+  return this->handle_events_i (ACE_INFINITE);
+}
+
+int
+ACE_Uring_Proactor::handle_events_i (u_long milli_seconds)
+{
+  int retval = 0;
+
+  {
+    ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+    this->submit ();
+  }
+
+  if (this->wait_completions (milli_seconds) == -1)
+    {
+      if (errno != ETIME &&   // Timeout
+          errno != EINTR)     // Interrupted call
+        ACELIB_ERROR ((LM_ERROR,
+                       ACE_TEXT ("%N:%l:(%P | %t)::%p\n"),
+                       ACE_TEXT ("handle_events: io_uring_enter failed")));
+      // let continue work
+      // we should check "post_completed" queue
+    }
+
+  ACE_POSIX_Asynch_Result *results[ACE_URING_COMPLETION_BATCH];
+  int errors[ACE_URING_COMPLETION_BATCH];
+  size_t counts[ACE_URING_COMPLETION_BATCH];
+
+  for (;;)
+    {
+      size_t n = 0;
+      {
+        ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+        n = this->reap_completions (results, errors, counts);
+        if (n == 0)
+          break;
+        ++this->dispatching_;
+      }
+
+      for (size_t i = 0; i < n; ++i)
+        // Call the application code.
+        this->application_specific_code (results[i],
+                                         counts[i],
+                                         0,             // No completion key.
+                                         errors[i]);
+      retval += static_cast<int> (n);
+
+      {
+        // Operations started by the upcalls above are handed to the
+        // kernel in one go.
+        ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
+        if (--this->dispatching_ == 0)
+          this->submit ();
+      }
+
+      if (n < ACE_URING_COMPLETION_BATCH)
+        break;
+    }
+
+  // process post_completed results
+  retval += this->process_result_queue ();
+
+  return retval > 0 ? 1 : 0;
+}
+
+ssize_t
+ACE_Uring_Proactor::allocate_aio_slot (ACE_POSIX_Asynch_Result *result)
+{
+  ssize_t const slot = ACE_POSIX_AIOCB_Proactor::allocate_aio_slot (result);
+  if (slot == -1)
+    return -1;
+
+  // The sigevent is not used by io_uring; keep the slot there so the
+  // submission can find its cookie.
+  result->aio_sigevent.sigev_value.sival_int = static_cast<int> (slot);
+  return slot;
+}
+
+// start_aio_i  has new return codes
+//     0    AIO was started successfully
+//     1    AIO was not started, OS AIO queue overflow
+//     -1   AIO was not started, other errors
+
+int
+ACE_Uring_Proactor::start_aio_i (ACE_POSIX_Asynch_Result *result)
+{
+  ACE_TRACE ("ACE_Uring_Proactor::start_aio_i");
+
+  // This protected method should be called with locked mutex_.
+  if (this->ring_fd_ == ACE_INVALID_HANDLE)
+    {
+      errno = EBADF;
+      return -1;
+    }
+
+  ACE_UINT8 opcode = 0;
+  switch (result->aio_lio_opcode)
+    {
+    case LIO_READ :
+      opcode = IORING_OP_READ;
+      break;
+    case LIO_WRITE :
+      opcode = IORING_OP_WRITE;
+      break;
+    default:
+      errno = EINVAL;
+      return -1;
+    }
+
+  io_uring_sqe *sqe = this->get_sqe ();
+  if (sqe == 0)
+    {
+      // Submission ring is full: push it out and try again once.
+      this->submit ();
+      sqe = this->get_sqe ();
+      if (sqe == 0)
+        return 1;
+    }
+
+  size_t const slot =
+    static_cast<size_t> (result->aio_sigevent.sigev_value.sival_int);
+
+  sqe->opcode = opcode;
+  sqe->fd = result->aio_fildes;
+  sqe->addr = reinterpret_cast<ACE_UINT64> (const_cast<void *> (result->aio_buf));
+  sqe->len = static_cast<ACE_UINT32> (result->aio_nbytes);
+  sqe->off = static_cast<ACE_UINT64> (result->aio_offset);
+  sqe->user_data = this->make_cookie (slot);
+
+  ++this->num_started_aio_;
+
+  // A dispatching thread flushes the ring once its batch is done.
+  if (this->dispatching_ == 0)
+    this->submit ();
+
+  return 0;
+}
+
+int
+ACE_Uring_Proactor::get_result_status (ACE_POSIX_Asynch_Result *,
+                                       int &error_status,
+                                       size_t &transfer_count)
+{
+  error_status = EINPROGRESS;
+  transfer_count = 0;
+  return 0;  // not completed, completions arrive through the ring
+}
+
+int
+ACE_Uring_Proactor::cancel_aiocb (ACE_POSIX_Asynch_Result *result)
+{
+  // This method is called from cancel_aio with locked mutex_
+  // to cancel a previously submitted AIO request
+  size_t const slot =
+    static_cast<size_t> (result->aio_sigevent.sigev_value.sival_int);
+
+  io_uring_sqe *sqe = this->get_sqe ();
+  if (sqe == 0)
+    {
+      this->submit ();
+      sqe = this->get_sqe ();
+      if (sqe == 0)
+        return 2;  // AIO_NOTCANCELED
+    }
+
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = -1;
+  sqe->addr = this->make_cookie (slot);
+  sqe->user_data = 0;
+
+  if (this->dispatching_ == 0)
+    this->submit ();
+
+  // The canceled request completes with ECANCELED through the ring.
+  return 0;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_AIO_CALLS && ACE_HAS_IO_URING */
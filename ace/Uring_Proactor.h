@@ -0,0 +1,206 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Uring_Proactor.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+#ifndef ACE_URING_PROACTOR_H
+#define ACE_URING_PROACTOR_H
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_AIO_CALLS) && defined (ACE_HAS_IO_URING)
+
+#include "ace/POSIX_Proactor.h"
+#include /**/ <linux/io_uring.h>
+
+#if !defined (ACE_URING_COMPLETION_BATCH)
+/// Number of completions harvested from the completion ring under a
+/// single acquisition of the proactor lock.
+#  define ACE_URING_COMPLETION_BATCH 64
+#endif /* ACE_URING_COMPLETION_BATCH */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Uring_Proactor
+ *
+ * @brief Implementation of the Proactor for Linux using the io_uring
+ * submission and completion rings.
+ *
+ * This proactor, based on ACE_POSIX_AIOCB_Proactor, keeps the slot
+ * bookkeeping of its base class but replaces glibc's thread-emulated
+ * <aio_*()> calls with io_uring:
+ * POSIX_API          io_uring
+ * aio_read           IORING_OP_READ
+ * aio_write          IORING_OP_WRITE
+ * aio_suspend        io_uring_enter (IORING_ENTER_GETEVENTS)
+ * aio_error          io_uring_cqe.res < 0
+ * aio_return         io_uring_cqe.res >= 0
+ * aio_cancel         IORING_OP_ASYNC_CANCEL
+ *
+ * No helper threads are used to perform the I/O, so all operations
+ * built on <start_aio> (Read/Write_Stream, Read/Write_File,
+ * Read/Write_Dgram and Transmit_File) complete straight out of the
+ * kernel. Every completion present in the ring is harvested by one
+ * <handle_events> call. Operations started from within a completion
+ * upcall are queued in the submission ring and handed to the kernel
+ * together once the batch has been dispatched, so a busy handler
+ * costs one <io_uring_enter> per batch rather than one per request.
+ *
+ * Accept and Connect are still driven by the Asynch_Pseudo_Task, as
+ * for all other POSIX proactors.
+ *
+ * The proactor is only available when ACE is built with
+ * ACE_HAS_IO_URING defined; it requires a Linux 5.6 or newer
+ * kernel. Timed waits pass their timeout to <io_uring_enter> with
+ * IORING_ENTER_EXT_ARG on Linux 5.11 and newer; older kernels are
+ * given an IORING_OP_TIMEOUT request instead.
+ */
+class ACE_Export ACE_Uring_Proactor : public ACE_POSIX_AIOCB_Proactor
+{
+public:
+  /// Constructor defines max number asynchronous operations that can
+  /// be started at the same time; this is also the size of the
+  /// submission ring.
+  ACE_Uring_Proactor (size_t max_aio_operations = ACE_AIO_DEFAULT_SIZE);
+
+  /// Destructor.
+  virtual ~ACE_Uring_Proactor (void);
+
+  virtual Proactor_Type get_impl_type (void);
+
+  /// Close down the Proactor.
+  virtual int close (void);
+
+protected:
+  /**
+   * Dispatch a single set of events.  If @a wait_time elapses before
+   * any events occur, return 0.  Return 1 on success i.e., when a
+   * completion is dispatched, non-zero (-1) on errors and errno is
+   * set accordingly.
+   */
+  virtual int handle_events (ACE_Time_Value &wait_time);
+
+  /**
+   * Block indefinitely until at least one event is dispatched.
+   * Dispatch a single set of events. Return 1 on success i.e., when a
+   * completion is dispatched, non-zero (-1) on errors and errno is
+   * set accordingly.
+   */
+  virtual int handle_events (void);
+
+  /// Internal completion detection and dispatching.
+  int handle_events_i (u_long milli_seconds);
+
+  /// Queue an aio operation in the submission ring.
+  virtual int start_aio_i (ACE_POSIX_Asynch_Result *result);
+
+  /// Completion status is delivered through the completion ring only,
+  /// so an operation is never found completed by polling it.
+  virtual int get_result_status (ACE_POSIX_Asynch_Result *asynch_result,
+                                 int &error_status,
+                                 size_t &transfer_count);
+
+  /// From ACE_POSIX_AIOCB_Proactor.
+  /// Attempt to cancel running request
+  virtual int cancel_aiocb (ACE_POSIX_Asynch_Result *result);
+
+  /// Find free slot to store result and remember the slot in the
+  /// result, so the submission can carry it to the completion.
+  virtual ssize_t allocate_aio_slot (ACE_POSIX_Asynch_Result *result);
+
+  /// Map the rings of a new io_uring instance. Return -1 on failure.
+  int open_ring (unsigned int entries);
+
+  /// Unmap the rings and close the io_uring descriptor.
+  void close_ring (void);
+
+  /// Cancel every running operation and harvest the completions
+  /// without upcalls; used on close.
+  void drain_ring (void);
+
+  /// Get a free submission queue entry, 0 if the ring is full.
+  /// Must be called with <mutex_> held.
+  io_uring_sqe *get_sqe (void);
+
+  /// Hand all queued submission entries to the kernel.  Must be
+  /// called with <mutex_> held.
+  int submit (void);
+
+  /// Block until the completion ring is not empty or @a milli_seconds
+  /// elapse. Called without <mutex_> held.
+  int wait_completions (u_long milli_seconds);
+
+  /// Harvest up to ACE_URING_COMPLETION_BATCH completions into
+  /// @a results / @a errors / @a counts.  Must be called with
+  /// <mutex_> held.  Return the number of harvested completions.
+  size_t reap_completions (ACE_POSIX_Asynch_Result *results[],
+                           int errors[],
+                           size_t counts[]);
+
+  /// Build the user_data cookie for the operation in @a slot.
+  ACE_UINT64 make_cookie (size_t slot) const;
+
+  /// File descriptor of the io_uring instance.
+  ACE_HANDLE ring_fd_;
+
+  /// Features reported by the kernel in io_uring_setup().
+  unsigned int features_;
+
+  /// Timeout of the IORING_OP_TIMEOUT request a timed wait queues on
+  /// kernels without IORING_FEAT_EXT_ARG. The kernel may read it only
+  /// when the request is submitted, after <wait_completions> returned,
+  /// so it does not live on the stack. Set with <mutex_> held.
+  __kernel_timespec timeout_;
+
+  /// Mapped submission ring and its fields.
+  void *sq_ring_;
+  size_t sq_ring_size_;
+  unsigned int *sq_head_;
+  unsigned int *sq_tail_;
+  unsigned int *sq_mask_;
+  unsigned int *sq_entries_;
+  unsigned int *sq_array_;
+
+  /// Mapped submission queue entries.
+  io_uring_sqe *sqes_;
+  size_t sqes_size_;
+
+  /// Mapped completion ring and its fields.
+  void *cq_ring_;
+  size_t cq_ring_size_;
+  unsigned int *cq_head_;
+  unsigned int *cq_tail_;
+  unsigned int *cq_mask_;
+  io_uring_cqe *cqes_;
+
+  /// Local copy of the submission tail, published to the kernel on
+  /// every <submit>.
+  unsigned int sq_local_tail_;
+
+  /// Number of queued submission entries not yet seen by the kernel.
+  unsigned int sq_pending_;
+
+  /// Number of threads currently dispatching a completion batch.
+  /// While non-zero, new submissions are left in the ring for the
+  /// dispatching thread to flush.
+  size_t dispatching_;
+
+  /// Per slot generation counters, so that a stale cancel or
+  /// completion never matches a reused slot.
+  ACE_UINT32 *generation_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_AIO_CALLS && ACE_HAS_IO_URING */
+#endif /* ACE_URING_PROACTOR_H */
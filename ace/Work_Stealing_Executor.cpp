@@ -0,0 +1,573 @@
+// $Id$
+
+#include "ace/Work_Stealing_Executor.h"
+
+#if defined (ACE_HAS_THREADS)
+
+#include "ace/Method_Request.h"
+#include "ace/Task.h"
+#include "ace/Guard_T.h"
+#include "ace/Thread.h"
+#include "ace/Log_Category.h"
+#include "ace/ACE.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/os_include/os_sched.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE(ACE_Work_Stealing_Executor)
+
+/**
+ * @class ACE_Work_Stealing_Executor::Future_Request
+ *
+ * @brief Runs a request and sets a future to what its call() returns.
+ */
+class ACE_Work_Stealing_Executor::Future_Request : public ACE_Method_Request
+{
+public:
+  Future_Request (ACE_Method_Request *request, ACE_Future<int> &result)
+    : request_ (request)
+    , result_ (result)
+  {
+  }
+
+  virtual ~Future_Request (void)
+  {
+    delete this->request_;
+  }
+
+  virtual int call (void)
+  {
+    int const result = this->request_->call ();
+    this->result_.set (result);
+    return result;
+  }
+
+  /// Give the request back to the caller.
+  void release (void)
+  {
+    this->request_ = 0;
+  }
+
+private:
+  ACE_Method_Request *request_;
+  ACE_Future<int> result_;
+};
+
+/**
+ * @class ACE_Work_Stealing_Executor::Function_Request
+ *
+ * @brief Calls a thread function.
+ */
+class ACE_Work_Stealing_Executor::Function_Request : public ACE_Method_Request
+{
+public:
+  Function_Request (ACE_THR_FUNC func, void *arg)
+    : func_ (func)
+    , arg_ (arg)
+  {
+  }
+
+  virtual int call (void)
+  {
+    (*this->func_) (this->arg_);
+    return 0;
+  }
+
+private:
+  ACE_THR_FUNC func_;
+  void *arg_;
+};
+
+/**
+ * @class ACE_Work_Stealing_Executor::Task_Request
+ *
+ * @brief Calls the svc() hook of a task.
+ */
+class ACE_Work_Stealing_Executor::Task_Request : public ACE_Method_Request
+{
+public:
+  Task_Request (ACE_Task_Base *task)
+    : task_ (task)
+  {
+  }
+
+  virtual int call (void)
+  {
+    return this->task_->svc ();
+  }
+
+private:
+  ACE_Task_Base *task_;
+};
+
+ACE_Work_Stealing_Executor::ACE_Work_Stealing_Executor (void)
+  : workers_ (0)
+  , size_ (0)
+  , pin_ (false)
+  , closing_ (false)
+  , steals_ (0)
+  , worker_key_created_ (false)
+  , next_ (0)
+  , idle_ (0)
+  , work_available_ (lock_)
+{
+  ACE_TRACE ("ACE_Work_Stealing_Executor::ACE_Work_Stealing_Executor");
+}
+
+ACE_Work_Stealing_Executor::~ACE_Work_Stealing_Executor (void)
+{
+  ACE_TRACE ("ACE_Work_Stealing_Executor::~ACE_Work_Stealing_Executor");
+
+  (void) this->close ();
+
+  if (this->worker_key_created_)
+    ACE_Thread::keyfree (this->worker_key_);
+}
+
+int
+ACE_Work_Stealing_Executor::open (size_t workers, bool pin)
+{
+  ACE_TRACE ("ACE_Work_Stealing_Executor::open");
+
+  ACE_WRITE_GUARD_RETURN (ACE_RW_Thread_Mutex, state_mon, this->state_lock_, -1);
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, this->lock_, -1);
+
+  if (this->workers_ != 0)
+    {
+      errno = EBUSY;
+      return -1;
+    }
+
+  // The key is kept until the executor is destroyed, so that a
+  // thread never finds a pointer to the workers of a closed executor
+  // under it.
+  if (!this->worker_key_created_)
+    {
+      if (ACE_Thread::keycreate (&this->worker_key_, 0) == -1)
+        return -1;
+      this->worker_key_created_ = true;
+    }
+
+  if (workers == 0)
+    {
+      long const cpus = ACE_OS::num_processors_online ();
+      workers = cpus > 0 ? static_cast<size_t> (cpus) : 1;
+    }
+
+  ACE_NEW_RETURN (this->workers_, Worker[workers], -1);
+
+  for (size_t i = 0; i < workers; ++i)
+    {
+      Worker &w = this->workers_[i];
+      w.executor_ = this;
+      w.index_ = i;
+      w.thr_id_ = ACE_OS::NULL_thread;
+      w.seed_ = static_cast<ACE_UINT32> (i * 2654435761u + 1);
+      w.items_ = 0;
+      w.capacity_ = 0;
+      w.head_ = 0;
+      w.count_ = 0;
+      w.steals_ = 0;
+    }
+  this->size_ = workers;
+  this->pin_ = pin;
+  this->closing_ = false;
+
+  // The workers start running once this returns and releases the
+  // lock, so they all see their thread ids.
+  for (size_t i = 0; i < workers; ++i)
+    if (this->thr_mgr_.spawn (&ACE_Work_Stealing_Executor::svc_run,
+                              &this->workers_[i],
+                              THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED,
+                              &this->workers_[i].thr_id_) == -1)
+      {
+        ACE_Errno_Guard error (errno);
+        this->closing_ = true;
+        ace_mon.release ();
+        this->work_available_.broadcast ();
+        this->thr_mgr_.wait ();
+
+        ace_mon.acquire ();
+        delete [] this->workers_;
+        this->workers_ = 0;
+        this->size_ = 0;
+        return -1;
+      }
+
+  return 0;
+}
+
+int
+ACE_Work_Stealing_Executor::close (void)
+{
+  ACE_TRACE ("ACE_Work_Stealing_Executor::close");
+
+  {
+    if (this->worker () != 0)
+      {
+        errno = EDEADLK;
+        return -1;
+      }
+
+    // Once <closing_> is set, no request is scheduled from outside
+    // anymore, and those scheduled before are in the deques.
+    ACE_WRITE_GUARD_RETURN (ACE_RW_Thread_Mutex, state_mon, this->state_lock_, -1);
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, this->lock_, -1);
+
+    if (this->workers_ == 0)
+      return 0;
+
+    this->closing_ = true;
+    this->work_available_.broadcast ();
+  }
+
+  this->thr_mgr_.wait ();
+
+  ACE_WRITE_GUARD_RETURN (ACE_RW_Thread_Mutex, state_mon, this->state_lock_, -1);
+
+  for (size_t i = 0; i < this->size_; ++i)
+    {
+      // The workers only return once all the deques are empty.
+      ACE_ASSERT (this->workers_[i].count_ == 0);
+      delete [] this->workers_[i].items_;
+      this->steals_ += this->workers_[i].steals_;
+    }
+
+  delete [] this->workers_;
+  this->workers_ = 0;
+  this->size_ = 0;
+
+  return 0;
+}
+
+int
+ACE_Work_Stealing_Executor::execute (ACE_Method_Request *request)
+{
+  ACE_TRACE ("ACE_Work_Stealing_Executor::execute");
+
+  if (request == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  // Workers may schedule requests while the executor is closing;
+  // close() waits for them.
+  Worker *self = this->worker ();
+  if (self != 0)
+    {
+      if (this->push (*self, request) == -1)
+        return -1;
+    }
+  else
+    {
+      ACE_READ_GUARD_RETURN (ACE_RW_Thread_Mutex, state_mon, this->state_lock_, -1);
+
+      if (this->workers_ == 0 || this->closing_)
+        {
+          errno = ESHUTDOWN;
+          return -1;
+        }
+
+      if (this->push (this->workers_[this->next_++ % this->size_],
+                      request) == -1)
+        return -1;
+    }
+
+  // A worker about to wait has counted itself idle before looking at
+  // the deques, so either it sees the request or it is signaled.
+  if (this->idle_.value () > 0)
+    {
+      ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, this->lock_, -1);
+      this->work_available_.signal ();
+    }
+
+  return 0;
+}
+
+int
+ACE_Work_Stealing_Executor::execute (ACE_Method_Request *request,
+                                     ACE_Future<int> &result)
+{
+  ACE_TRACE ("ACE_Work_Stealing_Executor::execute");
+
+  if (request == 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  Future_Request *fr = 0;
+  ACE_NEW_RETURN (fr, Future_Request (request, result), -1);
+
+  if (this->execute (fr) == -1)
+    {
+      fr->release ();
+      delete fr;
+      return -1;
+    }
+
+  return 0;
+}
+
+int
+ACE_Work_Stealing_Executor::execute (ACE_THR_FUNC func, void *arg)
+{
+  ACE_TRACE ("ACE_Work_Stealing_Executor::execute");
+
+  Function_Request *fr = 0;
+  ACE_NEW_RETURN (fr, Function_Request (func, arg), -1);
+
+  if (this->execute (fr) == -1)
+    {
+      delete fr;
+      return -1;
+    }
+
+  return 0;
+}
+
+int
+ACE_Work_Stealing_Executor::execute (ACE_Task_Base *task)
+{
+  ACE_TRACE ("ACE_Work_Stealing_Executor::execute");
+
+  Task_Request *tr = 0;
+  ACE_NEW_RETURN (tr, Task_Request (task), -1);
+
+  if (this->execute (tr) == -1)
+    {
+      delete tr;
+      return -1;
+    }
+
+  return 0;
+}
+
+size_t
+ACE_Work_Stealing_Executor::size (void) const
+{
+  return this->size_;
+}
+
+ssize_t
+ACE_Work_Stealing_Executor::current_worker (void) const
+{
+  Worker const *w = this->worker ();
+  return w != 0 ? static_cast<ssize_t> (w->index_) : -1;
+}
+
+size_t
+ACE_Work_Stealing_Executor::pending (void) const
+{
+  ACE_READ_GUARD_RETURN (ACE_RW_Thread_Mutex, state_mon, this->state_lock_, 0);
+
+  size_t pending = 0;
+  for (size_t i = 0; i < this->size_; ++i)
+    {
+      Worker &w = this->workers_[i];
+      ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, w.lock_, pending);
+      pending += w.count_;
+    }
+
+  return pending;
+}
+
+unsigned long
+ACE_Work_Stealing_Executor::steals (void) const
+{
+  ACE_READ_GUARD_RETURN (ACE_RW_Thread_Mutex, state_mon, this->state_lock_, 0);
+
+  unsigned long steals = this->steals_;
+  for (size_t i = 0; i < this->size_; ++i)
+    steals += this->workers_[i].steals_;
+
+  return steals;
+}
+
+ACE_Work_Stealing_Executor::Worker *
+ACE_Work_Stealing_Executor::worker (void) const
+{
+  void *w = 0;
+
+  if (!this->worker_key_created_
+      || ACE_Thread::getspecific (this->worker_key_, &w) == -1)
+    return 0;
+
+  return static_cast<Worker *> (w);
+}
+
+int
+ACE_Work_Stealing_Executor::push (Worker &w, ACE_Method_Request *request)
+{
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, w.lock_, -1);
+
+  if (w.count_ == w.capacity_)
+    {
+      size_t const capacity = w.capacity_ == 0
+        ? ACE_WORK_STEALING_EXECUTOR_DEQUE_SIZE
+        : w.capacity_ * 2;
+
+      ACE_Method_Request **items = 0;
+      ACE_NEW_RETURN (items, ACE_Method_Request *[capacity], -1);
+
+      for (size_t i = 0; i < w.count_; ++i)
+        items[i] = w.items_[(w.head_ + i) & (w.capacity_ - 1)];
+
+      delete [] w.items_;
+      w.items_ = items;
+      w.capacity_ = capacity;
+      w.head_ = 0;
+    }
+
+  w.items_[(w.head_ + w.count_) & (w.capacity_ - 1)] = request;
+  ++w.count_;
+  return 0;
+}
+
+ACE_Method_Request *
+ACE_Work_Stealing_Executor::pop (Worker &w)
+{
+  ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, w.lock_, 0);
+
+  if (w.count_ == 0)
+    return 0;
+
+  --w.count_;
+  return w.items_[(w.head_ + w.count_) & (w.capacity_ - 1)];
+}
+
+ACE_Method_Request *
+ACE_Work_Stealing_Executor::steal (Worker &w)
+{
+  if (this->size_ < 2)
+    return 0;
+
+  // xorshift32, good enough to spread the thieves among the victims.
+  w.seed_ ^= w.seed_ << 13;
+  w.seed_ ^= w.seed_ >> 17;
+  w.seed_ ^= w.seed_ << 5;
+
+  size_t const start = w.seed_ % this->size_;
+
+  for (size_t i = 0; i < this->size_; ++i)
+    {
+      Worker &victim = this->workers_[(start + i) % this->size_];
+      if (&victim == &w || victim.count_ == 0)
+        continue;
+
+      ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, victim.lock_, 0);
+
+      if (victim.count_ == 0)
+        continue;
+
+      ACE_Method_Request *request =
+        victim.items_[victim.head_ & (victim.capacity_ - 1)];
+      ++victim.head_;
+      --victim.count_;
+      ++w.steals_;
+      return request;
+    }
+
+  return 0;
+}
+
+bool
+ACE_Work_Stealing_Executor::work_left (void)
+{
+  for (size_t i = 0; i < this->size_; ++i)
+    {
+      Worker &w = this->workers_[i];
+      ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, w.lock_, true);
+      if (w.count_ > 0)
+        return true;
+    }
+
+  return false;
+}
+
+void
+ACE_Work_Stealing_Executor::run (Worker &w)
+{
+  for (;;)
+    {
+      ACE_Method_Request *request = this->pop (w);
+      if (request == 0)
+        request = this->steal (w);
+
+      if (request != 0)
+        {
+          request->call ();
+          delete request;
+          continue;
+        }
+
+      ACE_GUARD (ACE_Thread_Mutex, ace_mon, this->lock_);
+
+      // The deques are looked at under their locks once the worker
+      // counted itself idle, so a request scheduled meanwhile is
+      // either seen here or signaled.
+      ++this->idle_;
+      while (!this->closing_ && !this->work_left ())
+        this->work_available_.wait ();
+      --this->idle_;
+
+      // The workers still running requests take care of those they
+      // schedule.
+      if (this->closing_ && !this->work_left ())
+        break;
+    }
+}
+
+ACE_THR_FUNC_RETURN
+ACE_Work_Stealing_Executor::svc_run (void *arg)
+{
+  Worker *w = static_cast<Worker *> (arg);
+  ACE_Work_Stealing_Executor *executor = w->executor_;
+
+  // Wait for open() to have spawned all the workers.
+  {
+    ACE_GUARD_RETURN (ACE_Thread_Mutex, ace_mon, executor->lock_, 0);
+  }
+
+  if (executor->pin_)
+    ACE_Work_Stealing_Executor::pin (w->index_);
+
+  ACE_Thread::setspecific (executor->worker_key_, w);
+
+  executor->run (*w);
+  return 0;
+}
+
+void
+ACE_Work_Stealing_Executor::pin (size_t index)
+{
+#if defined (ACE_HAS_CPU_SET_T) && defined (CPU_SET)
+  long const cpus = ACE_OS::num_processors_online ();
+  if (cpus <= 0)
+    return;
+
+  cpu_set_t mask;
+  CPU_ZERO (&mask);
+  CPU_SET (static_cast<int> (index % cpus), &mask);
+
+  ACE_hthread_t self;
+  ACE_OS::thr_self (self);
+
+  if (ACE_OS::thr_set_affinity (self, sizeof (mask), &mask) == -1
+      && ACE::debug ())
+    ACELIB_DEBUG ((LM_DEBUG,
+                   ACE_TEXT ("(%t) ACE_Work_Stealing_Executor: unable to ")
+                   ACE_TEXT ("pin worker %B: %p\n"),
+                   index,
+                   ACE_TEXT ("thr_set_affinity")));
+#else
+  ACE_UNUSED_ARG (index);
+#endif /* ACE_HAS_CPU_SET_T && CPU_SET */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_THREADS */
@@ -0,0 +1,246 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Work_Stealing_Executor.h
+ *
+ *  $Id$
+ */
+//=============================================================================
+
+#ifndef ACE_WORK_STEALING_EXECUTOR_H
+#define ACE_WORK_STEALING_EXECUTOR_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if defined (ACE_HAS_THREADS)
+
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/RW_Thread_Mutex.h"
+#include "ace/Condition_Thread_Mutex.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Future.h"
+
+#if !defined (ACE_WORK_STEALING_EXECUTOR_DEQUE_SIZE)
+/// Initial number of requests each worker of an
+/// ACE_Work_Stealing_Executor can hold; the deques grow as needed.
+#  define ACE_WORK_STEALING_EXECUTOR_DEQUE_SIZE 64
+#endif /* ACE_WORK_STEALING_EXECUTOR_DEQUE_SIZE */
+
+#if !defined (ACE_WORK_STEALING_EXECUTOR_CACHE_LINE)
+/// Cache line size an ACE_Work_Stealing_Executor keeps the state of
+/// its workers apart by.
+#  define ACE_WORK_STEALING_EXECUTOR_CACHE_LINE 64
+#endif /* ACE_WORK_STEALING_EXECUTOR_CACHE_LINE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Method_Request;
+class ACE_Task_Base;
+
+/**
+ * @class ACE_Work_Stealing_Executor
+ *
+ * @brief A thread pool running ACE_Method_Request objects, in which
+ * each thread has its own queue and steals from the others when it
+ * runs out of work.
+ *
+ * The threads of an ACE_Task activated with several threads all
+ * dequeue from one ACE_Message_Queue, and an ACE_Activation_Queue
+ * likewise hands out all the requests from a single queue, so every
+ * request passes through the same lock.  Here each worker thread
+ * keeps a deque of its own.  A request scheduled by a worker, for
+ * instance a request splitting its work into smaller ones, goes on
+ * the back of that worker's deque, from which the worker takes its
+ * next request (last in, first out, while the data is still in its
+ * cache).  A worker finds its own deque through thread-specific
+ * storage.  Requests scheduled by other threads are spread among the
+ * workers in turn.  A worker whose deque is empty steals the oldest
+ * request from the front of the deque of another worker, picked at
+ * random, so the deques are only contended when work runs short.
+ * Workers only wait on the executor lock when there is no request
+ * left anywhere.
+ *
+ * The executor owns the requests it is given and deletes them once
+ * their call() has returned.  Requests are run in no particular
+ * order, and their priorities are ignored.
+ */
+class ACE_Export ACE_Work_Stealing_Executor
+{
+public:
+  /// Constructor.
+  ACE_Work_Stealing_Executor (void);
+
+  /// Destructor, calls close().
+  ~ACE_Work_Stealing_Executor (void);
+
+  /**
+   * Spawn @a workers threads; if 0, one per online CPU.  If @a pin is
+   * true, worker i is bound to CPU (i % number of online CPUs);
+   * failing to do so is not an error.
+   */
+  int open (size_t workers = 0, bool pin = false);
+
+  /// Let the workers run the requests already scheduled, including
+  /// those these schedule in turn, then stop them and wait for the
+  /// threads.  Requests scheduled from other threads fail with
+  /// ESHUTDOWN once close() started; every request scheduled before
+  /// is run.  Must not be called from a worker.
+  int close (void);
+
+  /**
+   * Schedule @a request, which is deleted after its call() returns.
+   * On failure, with @c errno ESHUTDOWN if the executor is not open,
+   * the request is left to the caller.
+   */
+  int execute (ACE_Method_Request *request);
+
+  /// Schedule @a request, and set @a result to the value returned by
+  /// its call() when it has run.
+  int execute (ACE_Method_Request *request, ACE_Future<int> &result);
+
+  /// Schedule a call of @a func with @a arg, as ACE_Thread_Manager
+  /// would run it in a thread of its own.
+  int execute (ACE_THR_FUNC func, void *arg = 0);
+
+  /// Schedule a call of the svc() hook of @a task, which must stay
+  /// alive until it has returned.
+  int execute (ACE_Task_Base *task);
+
+  /// Number of workers.
+  size_t size (void) const;
+
+  /// Return the worker run by the calling thread, or -1 if the
+  /// calling thread is not one of the workers.
+  ssize_t current_worker (void) const;
+
+  /// Number of requests scheduled and not yet started.
+  size_t pending (void) const;
+
+  /// Number of requests a worker took from another worker's deque.
+  unsigned long steals (void) const;
+
+  /// Declare the dynamic allocation hooks.
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  class Future_Request;
+  class Function_Request;
+  class Task_Request;
+
+  /// State of one worker, and its deque of requests.
+  struct Worker
+  {
+    ACE_Work_Stealing_Executor *executor_;
+    size_t index_;
+    ACE_thread_t thr_id_;
+
+    /// State for picking the workers to steal from.
+    ACE_UINT32 seed_;
+
+    /// Protects the deque.
+    ACE_Thread_Mutex lock_;
+
+    /// Ring of <capacity_> requests, a power of 2, holding <count_>
+    /// requests starting at <head_>.
+    ACE_Method_Request **items_;
+    size_t capacity_;
+    size_t head_;
+    size_t count_;
+
+    /// Number of requests this worker stole; only it changes this.
+    volatile unsigned long steals_;
+
+    /// Keeps the workers, which different threads change, on
+    /// different cache lines.
+    char pad_[ACE_WORK_STEALING_EXECUTOR_CACHE_LINE];
+  };
+
+  /// Thread entry point for a worker.
+  static ACE_THR_FUNC_RETURN svc_run (void *arg);
+
+  /// Run requests until the executor is closed.
+  void run (Worker &w);
+
+  /// Put @a request on the back of the deque of @a w.
+  int push (Worker &w, ACE_Method_Request *request);
+
+  /// Take the request at the back of the deque of @a w, 0 if empty.
+  ACE_Method_Request *pop (Worker &w);
+
+  /// Take the request at the front of the deque of another worker
+  /// than @a w, 0 if all of them are empty.
+  ACE_Method_Request *steal (Worker &w);
+
+  /// Is any request left in the deques.
+  bool work_left (void);
+
+  /// Return the worker run by the calling thread, 0 if none.
+  Worker *worker (void) const;
+
+  /// Bind the calling thread to a CPU for worker @a index.
+  static void pin (size_t index);
+
+  ACE_Work_Stealing_Executor (const ACE_Work_Stealing_Executor &);
+  ACE_Work_Stealing_Executor &operator= (const ACE_Work_Stealing_Executor &);
+
+private:
+  /// Array of <size_> workers.
+  Worker *workers_;
+
+  /// Number of workers.
+  size_t size_;
+
+  /// Are the threads to be pinned to CPUs.
+  bool pin_;
+
+  /// Set by close(); workers return once no request is left.
+  bool closing_;
+
+  /// Number of requests stolen by the workers closed already.
+  unsigned long steals_;
+
+  /// Key of the thread-specific pointer to the Worker a thread runs,
+  /// if the key could be created.
+  ACE_thread_key_t worker_key_;
+  bool worker_key_created_;
+
+  /// Worker getting the next request scheduled from outside.  Kept on
+  /// a cache line of its own, as every thread scheduling requests
+  /// from outside changes it.
+  char pad0_[ACE_WORK_STEALING_EXECUTOR_CACHE_LINE];
+  ACE_Atomic_Op<ACE_Thread_Mutex, unsigned long> next_;
+  char pad1_[ACE_WORK_STEALING_EXECUTOR_CACHE_LINE];
+
+  /// Workers waiting on <work_available_>, read by every execute().
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> idle_;
+
+  /// Held as a reader while scheduling a request from outside, and
+  /// as a writer by open() and close(), so that they don't change the
+  /// workers under it.
+  mutable ACE_RW_Thread_Mutex state_lock_;
+
+  /// Protects <closing_>, and the waits of idle workers.
+  ACE_Thread_Mutex lock_;
+
+  /// Signaled when a request is scheduled while workers are idle.
+  ACE_Condition_Thread_Mutex work_available_;
+
+  /// Manages the worker threads.
+  ACE_Thread_Manager thr_mgr_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_THREADS */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_WORK_STEALING_EXECUTOR_H */
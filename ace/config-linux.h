@@ -139,6 +139,19 @@
 # define ACE_HAS_CPU_SET_T
 #endif /* __GLIBC__ > 2 || __GLIBC__ === 2 && __GLIBC_MINOR__ >= 3) */
 
+#if (__GLIBC__  > 2)  || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 9)
+# define ACE_HAS_EVENTFD
+#endif /* __GLIBC__ > 2 || __GLIBC__ === 2 && __GLIBC_MINOR__ >= 9) */
+
+#if defined (_GNU_SOURCE)
+# if (__GLIBC__  > 2)  || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 12)
+#   define ACE_HAS_RECVMMSG
+# endif /* __GLIBC__ > 2 || __GLIBC__ === 2 && __GLIBC_MINOR__ >= 12) */
+# if (__GLIBC__  > 2)  || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+#   define ACE_HAS_SENDMMSG
+# endif /* __GLIBC__ > 2 || __GLIBC__ === 2 && __GLIBC_MINOR__ >= 14) */
+#endif /* _GNU_SOURCE */
+
 // Then the compiler specific parts
 
 #if defined (__INTEL_COMPILER)
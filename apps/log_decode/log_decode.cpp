@@ -0,0 +1,142 @@
+// $Id$
+
+// File: log_decode.cpp
+
+// Prints the log records of a stream of CDR encoded records, framed
+// the way ACE_Log_Msg_IPC sends them to a logging server: an 8 byte
+// header (byte order, then the length of the payload), then the
+// payload.  Records encoded by ACE_Log_Msg::BINARY are rendered as
+// they are printed.
+
+#include "ace/Log_Msg.h"
+#include "ace/Log_Record.h"
+#include "ace/CDR_Stream.h"
+#include "ace/Message_Block.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_unistd.h"
+
+static const ACE_TCHAR *input_file = 0;
+static const ACE_TCHAR *host_name = ACE_TEXT ("localhost");
+static u_long verbose_flags = 0;
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("f:h:lv"));
+
+  for (int c; (c = get_opt ()) != -1; )
+    switch (c)
+      {
+      case 'f':
+        input_file = get_opt.opt_arg ();
+        break;
+      case 'h':
+        host_name = get_opt.opt_arg ();
+        break;
+      case 'l':
+        verbose_flags = ACE_Log_Msg::VERBOSE_LITE;
+        break;
+      case 'v':
+        verbose_flags = ACE_Log_Msg::VERBOSE;
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage: %s [-f file] [-h host] [-l|-v]\n"),
+                           argv[0]),
+                          -1);
+      }
+
+  return 0;
+}
+
+// Reads exactly <len> bytes; returns 1 if it did, 0 at the end of
+// the input, -1 if the input ends in the middle.
+static int
+read_n (FILE *fp, char *buf, size_t len)
+{
+  size_t const n = ACE_OS::fread (buf, 1, len, fp);
+  if (n == len)
+    return 1;
+  return n == 0 ? 0 : -1;
+}
+
+static int
+decode_record (FILE *fp, ACE_Log_Record &record)
+{
+  ACE_Message_Block header (ACE_DEFAULT_CDR_BUFSIZE);
+  ACE_CDR::mb_align (&header);
+
+  int const result = read_n (fp, header.wr_ptr (), 8);
+  if (result != 1)
+    return result;
+  header.wr_ptr (8);
+
+  ACE_InputCDR header_cdr (&header);
+  ACE_CDR::Boolean byte_order;
+  ACE_CDR::ULong length;
+  if (!(header_cdr >> ACE_InputCDR::to_boolean (byte_order)))
+    return -1;
+  header_cdr.reset_byte_order (byte_order);
+  if (!(header_cdr >> length))
+    return -1;
+
+  ACE_Message_Block payload (length);
+  ACE_CDR::grow (&payload, 8 + ACE_CDR::MAX_ALIGNMENT + length);
+  if (read_n (fp, payload.wr_ptr (), length) != 1)
+    return -1;
+  payload.wr_ptr (length);
+
+  ACE_InputCDR payload_cdr (&payload);
+  payload_cdr.reset_byte_order (byte_order);
+  if (!(payload_cdr >> record))
+    return -1;
+
+  record.length (length);
+  return 1;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) == -1)
+    return 1;
+
+  FILE *fp = stdin;
+  if (input_file != 0)
+    {
+      fp = ACE_OS::fopen (input_file, ACE_TEXT ("rb"));
+      if (fp == 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("%p\n"),
+                           input_file),
+                          1);
+    }
+
+  int status = 0;
+  u_int count = 0;
+
+  for (;;)
+    {
+      ACE_Log_Record record;
+      int const result = decode_record (fp, record);
+      if (result == 0)
+        break;
+      if (result == -1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("can't decode record %u\n"),
+                      count + 1));
+          status = 1;
+          break;
+        }
+
+      record.print (host_name, verbose_flags, stdout);
+      ++count;
+    }
+
+  if (fp != stdin)
+    ACE_OS::fclose (fp);
+
+  return status;
+}
@@ -0,0 +1,104 @@
+// $Id$
+
+// This program prints the log records of a segment finished by an
+// ACE_Log_Msg_Mapped_File, starting from those logged at a given
+// time, which it seeks to through the index of the segment.
+
+#include "ace/Log_Msg_Mapped_File.h"
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_sys_stat.h"
+
+#if defined (ACE_HAS_THREADS) && !defined (ACE_LACKS_MMAP)
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Time_Value time (ACE_Time_Value::zero);
+
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("t:"));
+  for (int c; (c = get_opt ()) != -1; )
+    switch (c)
+      {
+      case 't':
+        // Seconds since the epoch.
+        time.sec (static_cast<time_t> (ACE_OS::atoi (get_opt.opt_arg ())));
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage: %s [-t seconds] segment\n"),
+                           argv[0]),
+                          1);
+      }
+
+  if (get_opt.opt_ind () != argc - 1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("usage: %s [-t seconds] segment\n"),
+                       argv[0]),
+                      1);
+
+  const ACE_TCHAR *path = argv[get_opt.opt_ind ()];
+
+  ACE_OFF_T offset = 0;
+  if (ACE_Log_Msg_Mapped_File::find (path, time, offset) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), path), 1);
+
+  ACE_HANDLE handle = ACE_OS::open (path, O_RDONLY);
+  if (handle == ACE_INVALID_HANDLE)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), path), 1);
+
+  // find() checked the segment, so the records end where its trailer
+  // says.
+  ACE_Log_Msg_Mapped_File::Header header;
+  ACE_Log_Msg_Mapped_File::Trailer trailer;
+  ACE_OFF_T const size = ACE_OS::filesize (handle);
+  if (ACE_OS::pread (handle, &header, sizeof header, 0)
+        != static_cast<ssize_t> (sizeof header)
+      || ACE_OS::pread (handle, &trailer, sizeof trailer, size - sizeof trailer)
+           != static_cast<ssize_t> (sizeof trailer))
+    {
+      ACE_OS::close (handle);
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), path), 1);
+    }
+
+  ACE_OFF_T const end =
+    static_cast<ACE_OFF_T> (header.header_size_ + trailer.used_);
+
+  char buffer[BUFSIZ];
+  while (offset < end)
+    {
+      size_t length = sizeof buffer;
+      if (end - offset < static_cast<ACE_OFF_T> (length))
+        length = static_cast<size_t> (end - offset);
+
+      ssize_t const n = ACE_OS::pread (handle, buffer, length, offset);
+      if (n <= 0)
+        {
+          ACE_OS::close (handle);
+          ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), path), 1);
+        }
+
+      ACE_OS::fwrite (buffer, 1, static_cast<size_t> (n), stdout);
+      offset += n;
+    }
+
+  ACE_OS::close (handle);
+  return 0;
+}
+
+#else
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  ACE_ERROR_RETURN ((LM_ERROR,
+                     ACE_TEXT ("ACE_Log_Msg_Mapped_File requires threads ")
+                     ACE_TEXT ("and mmap\n")),
+                    1);
+}
+
+#endif /* ACE_HAS_THREADS && !ACE_LACKS_MMAP */
@@ -5,7 +5,9 @@
  *
  *  $Id$
  *
- *  Measures UDP round-trip performance.
+ *  Measures UDP round-trip performance.  With -B, datagrams are
+ *  sent and received in batches with ACE_SOCK_Dgram::send_batch()
+ *  and recv_batch(), and each sample is the round trip of a batch.
  *
  *
  *  @author Fred Kuhns and David L. Levine
@@ -17,6 +19,7 @@
 #include "ace/Reactor.h"
 #include "ace/SOCK_Dgram.h"
 #include "ace/INET_Addr.h"
+#include "ace/Message_Block.h"
 #include "ace/ACE.h"
 #include "ace/Get_Opt.h"
 #include "ace/High_Res_Timer.h"
@@ -52,6 +55,7 @@ static int logfile = 0;
 static int server = 0;
 static int client = 0;
 static u_int use_reactor = 0;
+static int batch = 0;
 ACE_hrtime_t max_allow = 0;
 ACE_hrtime_t total_ltime;
 ACE_hrtime_t ltime;
@@ -73,6 +77,7 @@ usage (void)
               "  [-r]\n"
               "  [-x max_sample_allowed]\n"
               "  [-a to use the ACE reactor]\n"
+              "  [-B batch_size (send and receive in batches)]\n"
               "  targethost\n",
               *cmd));
 }
@@ -105,6 +110,12 @@ public:
   /// Wait for the response.
   int get_response (char *buf, size_t len);
 
+  /// Send <batch> copies of the <buf> to the server.
+  int send_batch (const char *buf, size_t len);
+
+  /// Wait for the <batch> responses.
+  int get_batch_response (size_t len);
+
   /// Send messages to server and record statistics.
   int run (void);
 
@@ -120,6 +131,10 @@ private:
   /// The address to send messages to.
   ACE_INET_Addr remote_addr_;
 
+  /// Blocks of the batches sent and received.
+  ACE_Message_Block *send_blocks_[ACE_DGRAM_BATCH_MAX];
+  ACE_Message_Block *recv_blocks_[ACE_DGRAM_BATCH_MAX];
+
   ACE_UNIMPLEMENTED_FUNC (Client (void))
   ACE_UNIMPLEMENTED_FUNC (Client (const Client &))
   ACE_UNIMPLEMENTED_FUNC (Client &operator= (const Client &))
@@ -130,6 +145,12 @@ Client::Client (const ACE_INET_Addr &addr,
   : endpoint_ (addr),
     remote_addr_ (remote_addr)
 {
+  for (int i = 0; i < batch; ++i)
+    {
+      ACE_NEW (this->send_blocks_[i], ACE_Message_Block (MAXPKTSZ));
+      ACE_NEW (this->recv_blocks_[i], ACE_Message_Block (MAXPKTSZ));
+    }
+
   if (use_reactor)
     {
       if (ACE_Reactor::instance ()->register_handler
@@ -141,6 +162,11 @@ Client::Client (const ACE_INET_Addr &addr,
 
 Client::~Client (void)
 {
+  for (int i = 0; i < batch; ++i)
+    {
+      this->send_blocks_[i]->release ();
+      this->recv_blocks_[i]->release ();
+    }
 }
 
 ACE_HANDLE
@@ -192,6 +218,54 @@ Client::get_response (char *buf, size_t len)
   return this->endpoint_.recv (buf, len, addr);
 }
 
+int
+Client::send_batch (const char *buf, size_t len)
+{
+  for (int i = 0; i < batch; ++i)
+    {
+      this->send_blocks_[i]->reset ();
+      this->send_blocks_[i]->copy (buf, len);
+    }
+
+  // The socket buffer may take fewer than a batch at once.
+  int sent = 0;
+  while (sent < batch)
+    {
+      ssize_t const n = this->endpoint_.send_batch (this->send_blocks_ + sent,
+                                                    batch - sent,
+                                                    remote_addr_);
+      if (n <= 0)
+        return -1;
+      sent += static_cast<int> (n);
+    }
+  return sent;
+}
+
+int
+Client::get_batch_response (size_t len)
+{
+  int received = 0;
+  while (received < batch)
+    {
+      for (int i = received; i < batch; ++i)
+        this->recv_blocks_[i]->reset ();
+
+      ssize_t const n =
+        this->endpoint_.recv_batch (this->recv_blocks_ + received,
+                                    0,
+                                    0,
+                                    batch - received);
+      if (n <= 0)
+        return -1;
+
+      for (ssize_t i = 0; i < n; ++i)
+        if (this->recv_blocks_[received + i]->length () != len)
+          return -1;
+      received += static_cast<int> (n);
+    }
+  return received;
+}
+
 int
 Client::run (void)
 {
@@ -244,11 +318,25 @@ Client::run (void)
        (*seq)++, i++, j++, timer.reset ())
     {
       timer.start ();
-      if (this->send (sbuf, bufsz) <= 0)
-        ACE_ERROR_RETURN ((LM_ERROR, "(%P) %p\n", "send"), -1);
+      if (batch > 0)
+        {
+          if (this->send_batch (sbuf, bufsz) <= 0)
+            ACE_ERROR_RETURN ((LM_ERROR, "(%P) %p\n", "send_batch"), -1);
 
-      if ((n = get_response (rbuf, bufsz)) <= 0)
-        ACE_ERROR_RETURN ((LM_ERROR, "(%P) %p\n", "get_response"), -1);
+          if ((n = get_batch_response (bufsz)) <= 0)
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "(%P) %p\n",
+                               "get_batch_response"),
+                              -1);
+        }
+      else
+        {
+          if (this->send (sbuf, bufsz) <= 0)
+            ACE_ERROR_RETURN ((LM_ERROR, "(%P) %p\n", "send"), -1);
+
+          if ((n = get_response (rbuf, bufsz)) <= 0)
+            ACE_ERROR_RETURN ((LM_ERROR, "(%P) %p\n", "get_response"), -1);
+        }
 
       timer.stop ();
 
@@ -418,6 +506,12 @@ Client::run (void)
               std_dev / 1000.0,
               std_err / 1000.0));
 
+  if (batch > 0)
+    ACE_DEBUG ((LM_DEBUG,
+                "\tBatches of %d datagrams, Mean per datagram = %f\n",
+                batch,
+                sample_mean / 1000.0 / batch));
+
   if (logfile)
     {
       ACE_OS::fprintf (sumfp,
@@ -481,9 +575,16 @@ public:
                             ACE_Reactor_Mask close_mask);
 
 private:
+  /// Echo a batch of datagrams.
+  int handle_batch (void);
+
   /// Receives datagrams.
   ACE_SOCK_Dgram endpoint_;
 
+  /// Blocks and sources of the batches received.
+  ACE_Message_Block *blocks_[ACE_DGRAM_BATCH_MAX];
+  ACE_INET_Addr addrs_[ACE_DGRAM_BATCH_MAX];
+
   ACE_UNIMPLEMENTED_FUNC (Server (void))
   ACE_UNIMPLEMENTED_FUNC (Server (const Server &))
   ACE_UNIMPLEMENTED_FUNC (Server &operator= (const Server &))
@@ -492,6 +593,9 @@ private:
 Server::Server (const ACE_INET_Addr &addr)
   :  endpoint_ (addr)
 {
+  for (int i = 0; i < batch; ++i)
+    ACE_NEW (this->blocks_[i], ACE_Message_Block (MAXPKTSZ));
+
   if (use_reactor)
     {
       if (ACE_Reactor::instance ()->register_handler
@@ -504,6 +608,8 @@ Server::Server (const ACE_INET_Addr &addr)
 
 Server::~Server (void)
 {
+  for (int i = 0; i < batch; ++i)
+    this->blocks_[i]->release ();
 }
 
 ACE_HANDLE
@@ -515,6 +621,9 @@ Server::get_handle (void) const
 int
 Server::handle_input (ACE_HANDLE)
 {
+  if (batch > 0)
+    return this->handle_batch ();
+
   char buf[BUFSIZ];
   ACE_INET_Addr from_addr;
 
@@ -558,6 +667,58 @@ Server::handle_input (ACE_HANDLE)
     }
 }
 
+int
+Server::handle_batch (void)
+{
+  for (int i = 0; i < batch; ++i)
+    this->blocks_[i]->reset ();
+
+  ssize_t const n = endpoint_.recv_batch (this->blocks_,
+                                          this->addrs_,
+                                          0,
+                                          batch);
+  if (n <= 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "%p\n",
+                       "handle_batch: recv_batch"),
+                      -1);
+
+  // Send the messages back as the responses.
+  for (ssize_t sent = 0; sent < n; )
+    {
+      ssize_t const m = endpoint_.send_batch (this->blocks_ + sent,
+                                              this->addrs_ + sent,
+                                              n - sent);
+      if (m <= 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "%p\n",
+                           "handle_batch: send_batch"),
+                          -1);
+      sent += m;
+    }
+
+  for (ssize_t i = 0; i < n; ++i)
+    if (this->blocks_[i]->length () == 1 && *this->blocks_[i]->rd_ptr () == 'S')
+      {
+        if (use_reactor)
+          {
+            if (ACE_Reactor::instance ()->remove_handler
+                (this, ACE_Event_Handler::READ_MASK) == -1)
+              ACE_ERROR_RETURN ((LM_ERROR,
+                                 "ACE_Reactor::remove_handler: server\n"),
+                                -1);
+
+            ACE_Reactor::end_event_loop ();
+            return 0;
+          }
+
+        // Indicate done by returning 1.
+        return 1;
+      }
+
+  return 0;
+}
+
 int
 Server::handle_close (ACE_HANDLE,
                       ACE_Reactor_Mask)
@@ -576,7 +737,7 @@ ACE_TMAIN (int argc, ACE_TCHAR *argv[])
   cmd = argv;
 
   //FUZZ: disable check_for_lack_ACE_OS
-  ACE_Get_Opt getopt (argc, argv, ACE_TEXT("x:w:f:vs:I:p:rtn:b:a"));
+  ACE_Get_Opt getopt (argc, argv, ACE_TEXT("x:w:f:vs:I:p:rtn:b:aB:"));
 
   while ((c = getopt ()) != -1)
     {
@@ -618,6 +779,14 @@ ACE_TMAIN (int argc, ACE_TCHAR *argv[])
         case 'a':
           use_reactor = 1;
           break;
+        case 'B':
+          batch = ACE_OS::atoi (getopt.opt_arg ());
+          if (batch <= 0 || batch > ACE_DGRAM_BATCH_MAX)
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "\nBatch size must be between 1 and %d!\n\n",
+                               ACE_DGRAM_BATCH_MAX),
+                              1);
+          break;
         case 's':
           so_bufsz = ACE_OS::atoi (getopt.opt_arg ());
 
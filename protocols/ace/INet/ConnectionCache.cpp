@@ -7,6 +7,7 @@
 #endif
 
 #include "ace/INet/INet_Log.h"
+#include "ace/OS_NS_sys_time.h"
 
 
 
@@ -42,6 +43,12 @@ namespace ACE
         *this = cachekey;
       }
 
+    ConnectionCacheKey::~ConnectionCacheKey ()
+      {
+        if (this->key_ != 0 && this->delete_key_)
+          delete this->key_;
+      }
+
     ConnectionCacheKey& ConnectionCacheKey::operator =(const ConnectionCacheKey& cachekey)
       {
         if (this != &cachekey)
@@ -77,88 +84,223 @@ namespace ACE
     ConnectionFactory::~ConnectionFactory () {}
     ConnectionFactory::ConnectionFactory () {}
 
-    ConnectionCacheValue::ConnectionCacheValue ()
-      : state_ (CST_INIT),
-        connection_ (0)
+    namespace
+    {
+      /// A connection of an entry.
+      struct Node
+        {
+          Node ()
+            : connection (0), closing (false), next (0)
+            {
+            }
+
+          ConnectionHolder* connection;
+          /// The time the connection was created and the time it was
+          /// released last.
+          ACE_Time_Value created;
+          ACE_Time_Value released;
+          /// Close the connection when it is released.
+          bool closing;
+          Node* next;
+        };
+
+      /// Removes the node of <connection> from the list at <head>.
+      Node* unlink (Node*& head, const ConnectionHolder* connection)
+        {
+          for (Node** n = &head; *n != 0; n = &(*n)->next)
+            {
+              if ((*n)->connection == connection)
+                {
+                  Node* node = *n;
+                  *n = node->next;
+                  node->next = 0;
+                  return node;
+                }
+            }
+          return 0;
+        }
+
+      /// Deletes the nodes in the list at <nodes> with their connections.
+      void close_nodes (Node* nodes)
+        {
+          while (nodes != 0)
+            {
+              Node* node = nodes;
+              nodes = node->next;
+              delete node->connection;
+              delete node;
+            }
+        }
+    }
+
+    /// The connections of a key.
+    struct ConnectionCache::Entry
       {
-      }
+        Entry ()
+          : idle (0), busy (0), count (0), waiters (0)
+          {
+          }
 
-    ConnectionCacheValue::ConnectionCacheValue (connection_type* connection)
-      : state_ (connection ? CST_IDLE : CST_INIT),
-        connection_ (connection)
+        /// Idle connections, the one released last first.
+        Node* idle;
+        /// Claimed connections.
+        Node* busy;
+        /// All connections, including those being created.
+        size_t count;
+        /// Threads waiting for a connection.
+        size_t waiters;
+      };
+
+    /// A part of the cache with a lock of its own.
+    struct ConnectionCache::Shard
       {
-      }
+        typedef ACE_Hash_Map_Manager_Ex <ConnectionCacheKey,
+                                         Entry*,
+                                         ACE_Hash<ConnectionCacheKey>,
+                                         ACE_Equal_To<ConnectionCacheKey>,
+                                         ACE_SYNCH_NULL_MUTEX> map_type;
+
+        Shard ()
+          : condition (lock)
+          {
+            stats.hits = stats.misses = stats.waits = stats.evictions = 0;
+          }
 
-    ConnectionCacheValue::ConnectionCacheValue (const ConnectionCacheValue& cacheval)
-      {
-        *this = cacheval;
-      }
+        /// Wakes up the threads waiting for a connection of <entry>.
+        void signal (const Entry& entry)
+          {
+            if (entry.waiters != 0)
+              this->condition.broadcast ();
+          }
 
-    ConnectionCacheValue& ConnectionCacheValue::operator =(const ConnectionCacheValue& cacheval)
-      {
-        if (this != &cacheval)
+        /// Returns true if <node> is past max_age at <now>.
+        bool too_old (const Node& node, const ACE_Time_Value& now) const
           {
-            this->state_ = cacheval.state ();
-            this->connection_ = const_cast<connection_type*> (cacheval.connection ());
+            return this->max_age != ACE_Time_Value::zero
+                && now - node.created >= this->max_age;
           }
-        return *this;
-      }
 
-    ConnectionCache::ConnectionCache(size_t size)
-      : condition_ (lock_),
-        cache_map_ (size)
+        mutable ACE_SYNCH_MUTEX lock;
+        ACE_SYNCH_CONDITION condition;
+        map_type map;
+        Statistics stats;
+
+        /// Copies of the settings of the cache, read under the lock.
+        ACE_Time_Value idle_timeout;
+        ACE_Time_Value max_age;
+      };
+
+    /**
+    * Calls ConnectionCache::evict () from a timer.  The evictor is
+    * reference counted, so a timeout being dispatched keeps it alive
+    * while the cache lets go of it, and detach () waits for such a
+    * timeout to leave the cache alone.
+    */
+    class ConnectionCache::Evictor
+      : public ACE_Event_Handler
+      {
+        public:
+          Evictor (ConnectionCache& cache, ACE_Reactor* reactor)
+            : ACE_Event_Handler (reactor),
+              cache_ (&cache),
+              timer_ (-1)
+            {
+              this->reference_counting_policy ().value (
+                  ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
+            }
+
+          virtual int handle_timeout (const ACE_Time_Value&, const void*)
+            {
+              ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
+                                        guard_,
+                                        this->lock_,
+                                        0));
+              if (this->cache_ != 0)
+                this->cache_->evict ();
+              return 0;
+            }
+
+          /// Stop calling the cache, once a call in progress returned.
+          void detach ()
+            {
+              ACE_MT (ACE_GUARD (ACE_SYNCH_MUTEX,
+                                 guard_,
+                                 this->lock_));
+              this->cache_ = 0;
+            }
+
+          ACE_SYNCH_MUTEX lock_;
+          ConnectionCache* cache_;
+          long timer_;
+      };
+
+    ConnectionCache::ConnectionCache(size_t size,
+                                     size_t max_connections,
+                                     size_t shards)
+      : max_connections_ (max_connections == 0 ? 1 : max_connections),
+        shard_count_ (shards == 0 ? 1 : shards),
+        shards_ (0),
+        evictor_ (0)
       {
+        ACE_NEW_NORETURN (this->shards_, Shard[this->shard_count_]);
+        if (this->shards_ == 0)
+          {
+            INET_ERROR (1, (LM_ERROR, DLINFO ACE_TEXT ("ConnectionCache::ConnectionCache - ")
+                                      ACE_TEXT ("failed to allocate shards\n")));
+            this->shard_count_ = 0;
+            return;
+          }
+
+        size_t const shard_size = size / this->shard_count_;
+        for (size_t i = 0; i < this->shard_count_; ++i)
+          this->shards_[i].map.open (shard_size == 0 ? 1 : shard_size);
       }
 
     ConnectionCache::~ConnectionCache ()
       {
+        this->cancel_eviction ();
         this->close_all_connections ();
-      }
 
-    bool ConnectionCache::find_connection (const ConnectionKey& key,
-                                           ConnectionCacheValue& cacheval)
-      {
-        if (this->cache_map_.find (ConnectionCacheKey (key),
-                                   cacheval) == 0)
+        // connections still claimed go with the cache
+        for (size_t i = 0; i < this->shard_count_; ++i)
           {
-            return true;
+            Shard::map_type& map = this->shards_[i].map;
+            for (Shard::map_type::iterator iter = map.begin ();
+                 iter != map.end ();
+                 ++iter)
+              {
+                close_nodes ((*iter).int_id_->busy);
+                delete (*iter).int_id_;
+              }
           }
-        return false;
+        delete [] this->shards_;
       }
 
-    bool ConnectionCache::set_connection (const ConnectionKey& key,
-                                          const ConnectionCacheValue& cacheval)
+    ConnectionCache::Shard& ConnectionCache::shard (const ConnectionKey& key) const
       {
-        return this->cache_map_.rebind (ConnectionCacheKey (key),
-                                        cacheval) != -1;
+        // the maps of the shards hash the same key again; mix the bits
+        // so that each map gets an even spread
+        ACE_UINT32 const h = static_cast<ACE_UINT32> (key.hash ()) * 2654435761U;
+        return this->shards_[(h >> 16) % this->shard_count_];
       }
 
-    bool ConnectionCache::claim_existing_connection(const ConnectionKey& key,
-                                                    connection_type*& connection,
-                                                    ConnectionCacheValue::State& state)
+    ConnectionCache::Entry* ConnectionCache::find_entry (Shard& shard,
+                                                         const ConnectionKey& key,
+                                                         bool create)
       {
-        INET_TRACE ("ConnectionCache::claim_existing_connection");
+        Entry* entry = 0;
+        if (shard.map.find (ConnectionCacheKey (key), entry) == 0 || !create)
+          return entry;
 
-        ConnectionCacheValue cacheval;
-        if (this->find_connection (key, cacheval))
+        ACE_NEW_RETURN (entry, Entry, 0);
+        if (shard.map.bind (ConnectionCacheKey (key), entry) != 0)
           {
-            state = cacheval.state ();
-            if (state == ConnectionCacheValue::CST_IDLE)
-              {
-                cacheval.state (ConnectionCacheValue::CST_BUSY);
-                if (this->set_connection (key, cacheval))
-                  {
-                    connection = cacheval.connection ();
-                    return true;
-                  }
-                else
-                  {
-                    INET_ERROR (1, (LM_ERROR, DLINFO ACE_TEXT ("ConnectionCache::claim_existing_connection - ")
-                                              ACE_TEXT ("failed to claim connection entry")));
-                  }
-              }
+            INET_ERROR (1, (LM_ERROR, DLINFO ACE_TEXT ("ConnectionCache::find_entry - ")
+                                      ACE_TEXT ("failed to add connection entry\n")));
+            delete entry;
+            return 0;
           }
-        return false;
+        return entry;
       }
 
     bool ConnectionCache::claim_connection(const ConnectionKey& key,
@@ -168,78 +310,121 @@ namespace ACE
       {
         INET_TRACE ("ConnectionCache::claim_connection");
 
-        while (1)
-          {
-            bool create_connection = false;
-            ConnectionCacheValue::State state = ConnectionCacheValue::CST_NONE;
-            do
-              {
-                ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
-                                          guard_,
-                                          this->lock_,
-                                          false));
-
-                if (this->claim_existing_connection (key, connection, state))
-                  {
-                    INET_DEBUG (9, (LM_INFO, DLINFO ACE_TEXT ("%P|%t) ConnectionCache::claim_connection - ")
-                                             ACE_TEXT ("successfully claimed existing connection\n")));
-                    return true;
-                  }
-
-                if ((state == ConnectionCacheValue::CST_BUSY ||
-                        state == ConnectionCacheValue::CST_INIT) && !wait)
+        if (this->shard_count_ == 0)
+          return false;
+
+        Shard& shard = this->shard (key);
+        Entry* entry = 0;
+        Node* expired = 0;
+        {
+          ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
+                                    guard_,
+                                    shard.lock,
+                                    false));
+
+          entry = this->find_entry (shard, key, true);
+          if (entry == 0)
+            return false;
+
+          for (;;)
+            {
+              // connections past their age are not handed out again
+              while (entry->idle != 0
+                     && shard.too_old (*entry->idle, ACE_OS::gettimeofday ()))
+                {
+                  Node* node = entry->idle;
+                  entry->idle = node->next;
+                  node->next = expired;
+                  expired = node;
+                  --entry->count;
+                  ++shard.stats.evictions;
+                }
+
+              if (entry->idle != 0)
+                {
+                  Node* node = entry->idle;
+                  entry->idle = node->next;
+                  node->next = entry->busy;
+                  entry->busy = node;
+                  connection = node->connection;
+                  ++shard.stats.hits;
+
+                  INET_DEBUG (9, (LM_INFO, DLINFO ACE_TEXT ("%P|%t) ConnectionCache::claim_connection - ")
+                                           ACE_TEXT ("successfully claimed existing connection\n")));
+                  break;
+                }
+
+              if (entry->count < this->max_connections_)
+                {
+                  // reserve the slot; the connection is created without
+                  // holding up the shard
+                  ++entry->count;
+                  ++shard.stats.misses;
+                  connection = 0;
+                  break;
+                }
+
+              if (!wait)
+                {
+                  close_nodes (expired);
                   return false;
+                }
+
+              INET_DEBUG (9, (LM_INFO, DLINFO ACE_TEXT ("ConnectionCache::claim_connection - ")
+                                       ACE_TEXT ("waiting for connection to become available\n")));
+              ++shard.stats.waits;
+              ++entry->waiters;
+              int const result = shard.condition.wait ();
+              --entry->waiters;
+              if (result != 0)
+                {
+                  close_nodes (expired);
+                  INET_ERROR (1, (LM_ERROR, DLINFO ACE_TEXT ("(%P|%t) ConnectionCache::claim_connection - ")
+                                            ACE_TEXT ("error waiting for connection condition (%p)\n")));
+                  return false;
+                }
+              INET_DEBUG (9, (LM_INFO, DLINFO ACE_TEXT ("ConnectionCache::claim_connection - ")
+                                       ACE_TEXT ("awoken and retrying to claim connection\n")));
+            }
+        }
 
-                if (state == ConnectionCacheValue::CST_CLOSED ||
-                        state == ConnectionCacheValue::CST_NONE)
-                  {
-                    if (!this->set_connection (key, ConnectionCacheValue ()))
-                      {
-                        INET_ERROR (1, (LM_ERROR, DLINFO ACE_TEXT ("ConnectionCache::claim_connection - ")
-                                                  ACE_TEXT ("failed to initialize connection entry")));
-                        return false;
-                      }
-
-                    create_connection = true;
-                  }
-                else
-                  {
-                    INET_DEBUG (9, (LM_INFO, DLINFO ACE_TEXT ("ConnectionCache::claim_connection - ")
-                                             ACE_TEXT ("waiting for connection to become available\n")));
-                    // wait for connection to become ready/free
-                    if (this->condition_.wait () != 0)
-                      {
-                        INET_ERROR (1, (LM_ERROR, DLINFO ACE_TEXT ("(%P|%t) ConnectionCache::claim_connection - ")
-                                                  ACE_TEXT ("error waiting for connection condition (%p)\n")));
-                        return false;
-                      }
-                    INET_DEBUG (9, (LM_INFO, DLINFO ACE_TEXT ("ConnectionCache::claim_connection - ")
-                                             ACE_TEXT ("awoken and retrying to claim connection\n")));
-                  }
-              }
-            while (0);
+        close_nodes (expired);
 
-            if (create_connection)
+        if (connection != 0)
+          return true;
+
+        Node* node = 0;
+        ACE_NEW_NORETURN (node, Node);
+        if (node != 0)
+          {
+            connection = connection_factory.create_connection (key);
+            if (connection == 0)
               {
-                connection = connection_factory.create_connection (key);
-                if (connection)
-                  {
-                    INET_DEBUG (9, (LM_INFO, DLINFO ACE_TEXT ("ConnectionCache::claim_connection - ")
-                                             ACE_TEXT ("successfully created new connection\n")));
-
-                    ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
-                                              guard_,
-                                              this->lock_,
-                                              false));
-
-                    ConnectionCacheValue cacheval (connection);
-                    cacheval.state (ConnectionCacheValue::CST_BUSY);
-                    return this->set_connection (key, cacheval);
-                  }
-                else
-                  return false;
+                delete node;
+                node = 0;
               }
           }
+
+        ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
+                                  guard_,
+                                  shard.lock,
+                                  false));
+        if (node == 0)
+          {
+            // give the slot to a waiting thread
+            --entry->count;
+            shard.signal (*entry);
+            return false;
+          }
+
+        INET_DEBUG (9, (LM_INFO, DLINFO ACE_TEXT ("ConnectionCache::claim_connection - ")
+                                 ACE_TEXT ("successfully created new connection\n")));
+
+        node->connection = connection;
+        node->created = ACE_OS::gettimeofday ();
+        node->next = entry->busy;
+        entry->busy = node;
+        return true;
       }
 
     bool ConnectionCache::release_connection(const ConnectionKey& key,
@@ -250,32 +435,42 @@ namespace ACE
         INET_DEBUG (9, (LM_INFO, DLINFO ACE_TEXT ("ConnectionCache::release_connection - ")
                                  ACE_TEXT ("releasing connection\n")));
 
-        ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
-                                  guard_,
-                                  this->lock_,
-                                  false));
-
-        ConnectionCacheValue cacheval;
-        if (this->find_connection (key, cacheval) &&
-              cacheval.connection () == connection &&
-              cacheval.state () == ConnectionCacheValue::CST_BUSY)
-          {
-            cacheval.state (ConnectionCacheValue::CST_IDLE);
-            if (this->set_connection (key, cacheval))
-              {
-                // signal other threads about free connection
-                this->condition_.broadcast ();
-                return true;
-              }
-            else
-              {
-                INET_ERROR (1, (LM_ERROR, DLINFO ACE_TEXT ("ConnectionCache::release_connection - ")
-                                          ACE_TEXT ("failed to release connection entry")));
-                return false;
-              }
-          }
-        else
+        if (this->shard_count_ == 0)
           return false;
+
+        Shard& shard = this->shard (key);
+        Node* node = 0;
+        {
+          ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
+                                    guard_,
+                                    shard.lock,
+                                    false));
+
+          Entry* entry = this->find_entry (shard, key, false);
+          if (entry == 0 || (node = unlink (entry->busy, connection)) == 0)
+            return false;
+
+          node->released = ACE_OS::gettimeofday ();
+          if (node->closing)
+            --entry->count;
+          else if (shard.too_old (*node, node->released))
+            {
+              --entry->count;
+              ++shard.stats.evictions;
+            }
+          else
+            {
+              node->next = entry->idle;
+              entry->idle = node;
+              node = 0;
+            }
+
+          // signal other threads about free connection
+          shard.signal (*entry);
+        }
+
+        close_nodes (node);
+        return true;
       }
 
     bool ConnectionCache::close_connection(const ConnectionKey& key,
@@ -286,73 +481,245 @@ namespace ACE
         INET_DEBUG (9, (LM_INFO, DLINFO ACE_TEXT ("ConnectionCache::close_connection - ")
                                  ACE_TEXT ("closing connection\n")));
 
-        ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
-                                  guard_,
-                                  this->lock_,
-                                  false));
-
-        ConnectionCacheValue cacheval;
-        if (this->find_connection (key, cacheval) &&
-              cacheval.connection () == connection &&
-              cacheval.state () == ConnectionCacheValue::CST_BUSY)
-          {
-            connection_type* conn = cacheval.connection ();
-            cacheval.connection (0);
-            cacheval.state (ConnectionCacheValue::CST_CLOSED);
-            if (this->set_connection (key, cacheval))
-              {
-                // signal other threads about closed connection
-                this->condition_.broadcast ();
-                delete conn; // clean up
-                return true;
-              }
-            else
-              {
-                INET_ERROR (1, (LM_ERROR, DLINFO ACE_TEXT ("ConnectionCache::close_connection - ")
-                                          ACE_TEXT ("failed to close connection entry")));
-                return false;
-              }
-          }
-        else
+        if (this->shard_count_ == 0)
           return false;
+
+        Shard& shard = this->shard (key);
+        Node* node = 0;
+        {
+          ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
+                                    guard_,
+                                    shard.lock,
+                                    false));
+
+          Entry* entry = this->find_entry (shard, key, false);
+          if (entry == 0 || (node = unlink (entry->busy, connection)) == 0)
+            return false;
+
+          --entry->count;
+          // signal other threads about closed connection
+          shard.signal (*entry);
+        }
+
+        close_nodes (node); // clean up
+        return true;
       }
 
     bool ConnectionCache::has_connection(const ConnectionKey& key)
       {
         INET_TRACE ("ConnectionCache::has_connection");
 
+        if (this->shard_count_ == 0)
+          return false;
+
+        Shard& shard = this->shard (key);
         ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
                                   guard_,
-                                  this->lock_,
+                                  shard.lock,
                                   false));
 
-        ConnectionCacheValue cacheval;
-        return (this->find_connection (key, cacheval) &&
-                  cacheval.state () != ConnectionCacheValue::CST_CLOSED);
+        Entry* entry = this->find_entry (shard, key, false);
+        return entry != 0 && (entry->idle != 0 || entry->busy != 0);
       }
 
     void ConnectionCache::close_all_connections()
       {
         INET_TRACE ("ConnectionCache::close_all_connections");
 
-        ACE_MT (ACE_GUARD (ACE_SYNCH_MUTEX,
-                           guard_,
-                           this->lock_));
+        for (size_t i = 0; i < this->shard_count_; ++i)
+          {
+            Shard& shard = this->shards_[i];
+            Node* nodes = 0;
+            {
+              ACE_MT (ACE_GUARD (ACE_SYNCH_MUTEX,
+                                 guard_,
+                                 shard.lock));
+
+              // entries stay; threads waiting on them start over, and
+              // the connections claimed are closed by their release
+              for (Shard::map_type::iterator iter = shard.map.begin ();
+                   iter != shard.map.end ();
+                   ++iter)
+                {
+                  Entry* entry = (*iter).int_id_;
+                  while (entry->idle != 0)
+                    {
+                      Node* node = entry->idle;
+                      entry->idle = node->next;
+                      node->next = nodes;
+                      nodes = node;
+                      --entry->count;
+                    }
+                  for (Node* node = entry->busy; node != 0; node = node->next)
+                    node->closing = true;
+                  shard.signal (*entry);
+                }
+            }
+            close_nodes (nodes);
+          }
+      }
 
-        map_iter_type iter = this->cache_map_.end ();
-        for (iter = this->cache_map_.begin ();
-             iter != this->cache_map_.end ();
-             ++iter)
+    size_t ConnectionCache::current_size () const
+      {
+        size_t size = 0;
+        for (size_t i = 0; i < this->shard_count_; ++i)
           {
-            if ((*iter).int_id_.state () == ConnectionCacheValue::CST_CLOSED)
-              {
-                connection_type* conn = (*iter).int_id_.connection ();
-                (*iter).int_id_.connection (0);
-                (*iter).int_id_.state (ConnectionCacheValue::CST_CLOSED);
-                delete conn;
-              }
+            ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
+                                      guard_,
+                                      this->shards_[i].lock,
+                                      0));
+            size += this->shards_[i].map.current_size ();
+          }
+        return size;
+      }
+
+    size_t ConnectionCache::evict ()
+      {
+        INET_TRACE ("ConnectionCache::evict");
+
+        ACE_Time_Value const now = ACE_OS::gettimeofday ();
+        size_t evicted = 0;
+        for (size_t i = 0; i < this->shard_count_; ++i)
+          {
+            Shard& shard = this->shards_[i];
+            Node* nodes = 0;
+            {
+              ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
+                                        guard_,
+                                        shard.lock,
+                                        evicted));
+
+              if (shard.idle_timeout == ACE_Time_Value::zero
+                  && shard.max_age == ACE_Time_Value::zero)
+                continue;
+
+              for (Shard::map_type::iterator iter = shard.map.begin ();
+                   iter != shard.map.end ();
+                   ++iter)
+                {
+                  Entry* entry = (*iter).int_id_;
+                  Node** n = &entry->idle;
+                  while (*n != 0)
+                    {
+                      Node* node = *n;
+                      if ((shard.idle_timeout != ACE_Time_Value::zero
+                             && now - node->released >= shard.idle_timeout)
+                          || shard.too_old (*node, now))
+                        {
+                          *n = node->next;
+                          node->next = nodes;
+                          nodes = node;
+                          --entry->count;
+                          ++shard.stats.evictions;
+                          ++evicted;
+                          shard.signal (*entry);
+                        }
+                      else
+                        n = &node->next;
+                    }
+                }
+            }
+            close_nodes (nodes);
+          }
+
+        INET_DEBUG (9, (LM_INFO, DLINFO ACE_TEXT ("ConnectionCache::evict - ")
+                                 ACE_TEXT ("closed %B idle connections\n"),
+                        evicted));
+        return evicted;
+      }
+
+    int ConnectionCache::schedule_eviction (const ACE_Time_Value& interval,
+                                            ACE_Reactor* reactor)
+      {
+        this->cancel_eviction ();
+
+        ACE_NEW_RETURN (this->evictor_, Evictor (*this, reactor), -1);
+        this->evictor_->timer_ = reactor->schedule_timer (this->evictor_,
+                                                          0,
+                                                          interval,
+                                                          interval);
+        if (this->evictor_->timer_ == -1)
+          {
+            this->evictor_->remove_reference ();
+            this->evictor_ = 0;
+            return -1;
+          }
+        return 0;
+      }
+
+    void ConnectionCache::cancel_eviction ()
+      {
+        if (this->evictor_ != 0)
+          {
+            // a timeout dispatched by now finishes before detach ()
+            // returns and holds on to the evictor until it is done
+            this->evictor_->detach ();
+            this->evictor_->reactor ()->cancel_timer (this->evictor_->timer_);
+            this->evictor_->remove_reference ();
+            this->evictor_ = 0;
+          }
+      }
+
+    void ConnectionCache::idle_timeout (const ACE_Time_Value& timeout)
+      {
+        for (size_t i = 0; i < this->shard_count_; ++i)
+          {
+            ACE_MT (ACE_GUARD (ACE_SYNCH_MUTEX,
+                               guard_,
+                               this->shards_[i].lock));
+            this->shards_[i].idle_timeout = timeout;
+          }
+      }
+
+    ACE_Time_Value ConnectionCache::idle_timeout () const
+      {
+        if (this->shard_count_ == 0)
+          return ACE_Time_Value::zero;
+
+        ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
+                                  guard_,
+                                  this->shards_[0].lock,
+                                  ACE_Time_Value::zero));
+        return this->shards_[0].idle_timeout;
+      }
+
+    void ConnectionCache::max_age (const ACE_Time_Value& age)
+      {
+        for (size_t i = 0; i < this->shard_count_; ++i)
+          {
+            ACE_MT (ACE_GUARD (ACE_SYNCH_MUTEX,
+                               guard_,
+                               this->shards_[i].lock));
+            this->shards_[i].max_age = age;
+          }
+      }
+
+    ACE_Time_Value ConnectionCache::max_age () const
+      {
+        if (this->shard_count_ == 0)
+          return ACE_Time_Value::zero;
+
+        ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
+                                  guard_,
+                                  this->shards_[0].lock,
+                                  ACE_Time_Value::zero));
+        return this->shards_[0].max_age;
+      }
+
+    void ConnectionCache::get_statistics (Statistics& stats) const
+      {
+        stats.hits = stats.misses = stats.waits = stats.evictions = 0;
+        for (size_t i = 0; i < this->shard_count_; ++i)
+          {
+            const Shard& shard = this->shards_[i];
+            ACE_MT (ACE_GUARD (ACE_SYNCH_MUTEX,
+                               guard_,
+                               shard.lock));
+            stats.hits += shard.stats.hits;
+            stats.misses += shard.stats.misses;
+            stats.waits += shard.stats.waits;
+            stats.evictions += shard.stats.evictions;
           }
-        this->cache_map_.unbind_all ();
       }
 
   }
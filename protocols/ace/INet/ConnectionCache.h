@@ -16,6 +16,8 @@
 #include "ace/Condition_Thread_Mutex.h"
 #include "ace/Null_Mutex.h"
 #include "ace/Hash_Map_Manager_T.h"
+#include "ace/Time_Value.h"
+#include "ace/Reactor.h"
 #include "ace/INet/INet_Export.h"
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -63,6 +65,7 @@ namespace ACE
               ConnectionCacheKey ();
               ConnectionCacheKey (const ConnectionKey& key);
               ConnectionCacheKey (const ConnectionCacheKey& cachekey);
+              ~ConnectionCacheKey ();
 
               ConnectionCacheKey& operator =(const ConnectionCacheKey& cachekey);
 
@@ -114,60 +117,23 @@ namespace ACE
           };
 
 
-        /**
-        * @class ACE_INet_ConnectionCacheValue
-        *
-        * @brief Holder class for connections.
-        *
-        * Implements non-copying holder object maintaining
-        * connection state used as int_id in connection
-        * cache map.
-        */
-        class ConnectionCacheValue
-          {
-            public:
-              enum State
-                {
-                  CST_NONE,
-                  CST_INIT,
-                  CST_IDLE,
-                  CST_BUSY,
-                  CST_CLOSED
-                };
-
-              typedef ConnectionHolder connection_type;
-
-              ConnectionCacheValue ();
-              explicit ConnectionCacheValue (connection_type* connection);
-              ConnectionCacheValue (const ConnectionCacheValue& cacheval);
-
-              ConnectionCacheValue& operator =(const ConnectionCacheValue& cacheval);
-
-              bool operator == (const ConnectionCacheValue& cacheval) const;
-
-              bool operator != (const ConnectionCacheValue& cacheval) const;
-
-              connection_type* connection ();
-
-              const connection_type* connection () const;
-
-              void connection (connection_type* conn);
-
-              State state () const;
-
-              void state (State st);
-
-            private:
-              State state_;
-              connection_type* connection_;
-          };
-
-
         /**
         * @class ACE_INet_ConnectionCache
         *
         * @brief Implements a cache for INet connection objects.
         *
+        * The cache is split into shards, each with its own lock and
+        * map, chosen by the hash of the connection key; threads using
+        * connections to different hosts rarely contend.  Each key has
+        * up to max_connections () connections; idle ones are kept last
+        * in, first out so that the most recently used (and warmest) one
+        * is claimed first.  A claim waits when all connections of the
+        * key are busy and the limit is reached.
+        *
+        * Idle connections are closed by evict () once they were idle
+        * longer than idle_timeout () or exist longer than max_age ();
+        * schedule_eviction () calls it from a reactor timer.  The
+        * settings may be changed while the cache is in use.
         */
         class ACE_INET_Export ConnectionCache
           {
@@ -175,30 +141,46 @@ namespace ACE
               typedef ConnectionHolder connection_type;
               typedef ConnectionFactory factory_type;
 
-              typedef ACE_Hash_Map_Manager_Ex <ConnectionCacheKey,
-                                               ConnectionCacheValue,
-                                               ACE_Hash<ConnectionCacheKey>,
-                                               ACE_Equal_To<ConnectionCacheKey>,
-                                               ACE_SYNCH_NULL_MUTEX> map_type;
-
-              typedef map_type::iterator map_iter_type;
+              enum Limits
+                {
+                  DEFAULT_MAX_CONNECTIONS = 1,
+                  DEFAULT_SHARDS = 16
+                };
 
-              typedef ACE_Hash_Map_Entry <ConnectionCacheKey,
-                                          ConnectionCacheValue> map_entry_type;
+              /// Counters of a cache.
+              struct Statistics
+                {
+                  /// Claims served with an idle connection.
+                  ACE_UINT64 hits;
+                  /// Claims which created a connection.
+                  ACE_UINT64 misses;
+                  /// Times claims waited for a connection.
+                  ACE_UINT64 waits;
+                  /// Connections closed for their idle time by evict (),
+                  /// or for their age by evict (), a claim or a release.
+                  ACE_UINT64 evictions;
+                };
 
-              /// Constructor
-              ConnectionCache(size_t size = ACE_DEFAULT_MAP_SIZE);
+              /// Constructor; <size> is the number of keys expected,
+              /// spread over <shards> maps.  By default a key has one
+              /// connection, as before the cache was sharded; callers
+              /// which can use more pass a higher <max_connections>.
+              ConnectionCache(size_t size = ACE_DEFAULT_MAP_SIZE,
+                              size_t max_connections = DEFAULT_MAX_CONNECTIONS,
+                              size_t shards = DEFAULT_SHARDS);
 
-              /// Destructor
+              /// Destructor; closes all connections, including those
+              /// still claimed.
               ~ConnectionCache ();
 
               /// Claim a connection from the cache.
-              /// Creates a new connection using <connection_factory>
-              /// if the cache does not contain a matching entry for
-              /// <key>.
-              /// If <wait> is true and the state of the matching
-              /// connection is BUSY the method will block waiting for
-              /// connection to become available.
+              /// Claims the idle connection for <key> released last,
+              /// or creates a new connection using <connection_factory>
+              /// if there is none and the limit for <key> is not
+              /// reached.
+              /// If <wait> is true and all connections for <key> are
+              /// BUSY the method will block waiting for a connection
+              /// to become available.
               /// Returns true if a connection could be successfully
               /// claimed and sets <connection> to the claimed connection.
               /// Returns false otherwise.
@@ -208,52 +190,87 @@ namespace ACE
                                     bool wait = true);
 
               /// Release a previously claimed connection making it
-              /// available for renewed claiming.
+              /// available for renewed claiming; a connection older
+              /// than max_age (), or claimed when close_all_connections ()
+              /// was called, is closed instead.
               /// Returns true if the connection was successfully released.
               bool release_connection(const ConnectionKey& key,
                                     connection_type* connection);
 
               /// Close a previously claimed connection.
-              /// Deletes the actual connection object and marks the cache entry
-              /// as CLOSED.
+              /// Deletes the actual connection object and removes it
+              /// from the cache.
               /// Returns true is the connection was successfully closed.
               bool close_connection(const ConnectionKey& key,
                                     connection_type* connection);
 
               /// Returns true if the cache contains a connection matching
-              /// <key>. Cache entries with state CLOSED are not considered.
+              /// <key>, idle or busy.
               /// Returns false otherwise.
               bool has_connection (const ConnectionKey& key);
 
-              /// Unconditionally closes all active connections.
+              /// Closes all idle connections; the connections claimed
+              /// are closed when they are released, rather than made
+              /// available again.
               void close_all_connections ();
 
-              /// Returns the number of registered cache entries (including CLOSED).
+              /// Returns the number of registered cache entries (keys).
               size_t current_size () const;
 
+              /// Returns the maximum number of connections per key.
+              size_t max_connections () const;
+
+              /// Set the time after which an idle connection is
+              /// evicted; zero (the default) keeps them.
+              void idle_timeout (const ACE_Time_Value& timeout);
+
+              ACE_Time_Value idle_timeout () const;
+
+              /// Set the time after which a connection is closed once
+              /// it is idle; zero (the default) keeps them.
+              void max_age (const ACE_Time_Value& age);
+
+              ACE_Time_Value max_age () const;
+
+              /// Close the idle connections which timed out or are too
+              /// old. Returns the number of connections closed.
+              size_t evict ();
+
+              /// Call evict () every <interval> from a timer of <reactor>,
+              /// until cancel_eviction () or the destructor.
+              /// Returns 0 on success, -1 otherwise.
+              int schedule_eviction (const ACE_Time_Value& interval,
+                                     ACE_Reactor* reactor = ACE_Reactor::instance ());
+
+              /// Cancel the timer scheduled by schedule_eviction ();
+              /// to be called while its reactor exists.
+              void cancel_eviction ();
+
+              /// Returns the counters summed over the shards.
+              void get_statistics (Statistics& stats) const;
+
             private:
-              /// Updates cache entry state
-              bool set_connection (const ConnectionKey& key,
-                                   const ConnectionCacheValue& cacheval);
+              struct Shard;
+              struct Entry;
+              class Evictor;
 
-              /// Attempts to claim an existing connection.
-              /// Returns true and sets <connection> if successful.
-              /// Returns false otherwise.
-              /// Does not wait when no connection available.
-              bool claim_existing_connection(const ConnectionKey& key,
-                                             connection_type*& connection,
-                                             ConnectionCacheValue::State& state);
+              /// Returns the shard for <key>.
+              Shard& shard (const ConnectionKey& key) const;
+
+              /// Returns the entry for <key> in <shard>, creating it
+              /// if <create> is true, with the shard locked.
+              Entry* find_entry (Shard& shard,
+                                 const ConnectionKey& key,
+                                 bool create);
 
-              /// Looks up a matching cache entry for <key> and updates
-              /// <cacheval> with the entry state if found.
-              /// Returns true if found, false otherwise.
-              bool find_connection (const ConnectionKey& key,
-                                    ConnectionCacheValue& cacheval);
+              size_t max_connections_;
+              size_t shard_count_;
+              Shard* shards_;
 
+              Evictor* evictor_;
 
-              mutable ACE_SYNCH_MUTEX lock_;
-              ACE_SYNCH_CONDITION condition_;
-              map_type cache_map_;
+              ConnectionCache (const ConnectionCache&);
+              ConnectionCache& operator =(const ConnectionCache&);
           };
 
 
@@ -40,56 +40,9 @@ namespace ACE
       }
 
     ACE_INLINE
-    bool ConnectionCacheValue::operator == (const ConnectionCacheValue& cacheval) const
+    size_t ConnectionCache::max_connections () const
       {
-        return this->connection () == cacheval.connection () &&
-                this->state () == cacheval.state ();
-      }
-
-    ACE_INLINE
-    bool ConnectionCacheValue::operator != (const ConnectionCacheValue& cacheval) const
-      {
-        return !((*this) == cacheval);
-      }
-
-    ACE_INLINE
-    ConnectionCacheValue::connection_type* ConnectionCacheValue::connection ()
-      {
-        return this->connection_;
-      }
-
-    ACE_INLINE
-    const ConnectionCacheValue::connection_type* ConnectionCacheValue::connection () const
-      {
-        return this->connection_;
-      }
-
-    ACE_INLINE
-    void ConnectionCacheValue::connection (connection_type* conn)
-      {
-        this->connection_ = conn;
-      }
-
-    ACE_INLINE
-    ConnectionCacheValue::State ConnectionCacheValue::state () const
-      {
-        return this->state_;
-      }
-
-    ACE_INLINE
-    void ConnectionCacheValue::state (State st)
-      {
-        this->state_ = st;
-      }
-
-    ACE_INLINE
-    size_t ConnectionCache::current_size () const
-      {
-        ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
-                                  guard_,
-                                  this->lock_,
-                                  false));
-        return this->cache_map_.current_size ();
+        return this->max_connections_;
       }
 
   }
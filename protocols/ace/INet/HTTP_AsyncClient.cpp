@@ -0,0 +1,1112 @@
+// $Id$
+
+#include "ace/INet/HTTP_AsyncClient.h"
+#include "ace/INet/HTTP_ClientRequestHandler.h"
+#include "ace/INet/HeaderParser.h"
+#include "ace/INet/String_IOStream.h"
+#include "ace/INet/INet_Log.h"
+#include "ace/Reactor.h"
+#include "ace/Message_Block.h"
+#include "ace/INET_Addr.h"
+#include "ace/SOCK_Stream.h"
+#include "ace/SOCK_Connector.h"
+#include "ace/Svc_Handler.h"
+#include "ace/Connector.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_strings.h"
+#include "ace/Numeric_Limits.h"
+#include "ace/os_include/os_errno.h"
+
+#if !defined (__ACE_INLINE__)
+#include "ace/INet/HTTP_AsyncClient.inl"
+#endif
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace ACE
+{
+  namespace HTTP
+  {
+
+    /// A request: the bytes to send and where its outcome goes.
+    struct AsyncClient::Job
+      {
+        Job ()
+          : head_request (false),
+            idempotent (false),
+            handler (0),
+            act (0),
+            retries (0),
+            next (0)
+          {
+          }
+
+        ACE_CString data;
+        bool head_request;
+        bool idempotent;
+        AsyncResponseHandler* handler;
+        const void* act;
+        u_int retries;
+        Job* next;
+      };
+
+    namespace
+    {
+      /// FIFO of jobs linked through Job::next.
+      class JobQueue
+        {
+          public:
+            typedef AsyncClient::Job Job;
+
+            JobQueue ()
+              : head_ (0), tail_ (0), size_ (0)
+              {
+              }
+
+            bool empty () const { return this->head_ == 0; }
+
+            size_t size () const { return this->size_; }
+
+            Job* front () const { return this->head_; }
+
+            void push (Job* job)
+              {
+                job->next = 0;
+                if (this->tail_ == 0)
+                  this->head_ = job;
+                else
+                  this->tail_->next = job;
+                this->tail_ = job;
+                ++this->size_;
+              }
+
+            Job* pop ()
+              {
+                Job* job = this->head_;
+                this->head_ = job->next;
+                if (this->head_ == 0)
+                  this->tail_ = 0;
+                job->next = 0;
+                --this->size_;
+                return job;
+              }
+
+            /// Put the jobs of <queue> in front of these.
+            void push_front (JobQueue& queue)
+              {
+                if (queue.empty ())
+                  return;
+                queue.tail_->next = this->head_;
+                if (this->tail_ == 0)
+                  this->tail_ = queue.tail_;
+                this->head_ = queue.head_;
+                this->size_ += queue.size_;
+                queue.head_ = queue.tail_ = 0;
+                queue.size_ = 0;
+              }
+
+            /// Take the whole list, leaving the queue empty.
+            Job* release ()
+              {
+                Job* jobs = this->head_;
+                this->head_ = this->tail_ = 0;
+                this->size_ = 0;
+                return jobs;
+              }
+
+          private:
+            Job* head_;
+            Job* tail_;
+            size_t size_;
+        };
+
+      bool equal_nocase (const ACE::INet::HeaderParser::View& v,
+                         const char* s)
+        {
+          size_t const length = ACE_OS::strlen (s);
+          return v.length == length
+              && ACE_OS::strncasecmp (v.data, s, length) == 0;
+        }
+
+      /// The size to receive into at least, and the receive buffer
+      /// to start with.
+      const size_t MIN_RECV = 4096;
+      const size_t INITIAL_BUFFER = 16384;
+
+      /// Longest chunk size or trailer line accepted.
+      const size_t MAX_LINE_LENGTH = 4096;
+
+      /// Largest size a body may be announced with.
+      const size_t MAX_SIZE = ACE_Numeric_Limits<size_t>::max ();
+
+      /// Returns the value of the hex digit <c>, -1 if it is none.
+      int hex_digit (char c)
+        {
+          if (c >= '0' && c <= '9')
+            return c - '0';
+          if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+          if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+          return -1;
+        }
+    }
+
+    /// The requests waiting for a connection to a host, and its
+    /// connections.
+    struct AsyncClient::Host
+      {
+        Host ()
+          : connections (0),
+            count (0)
+          {
+          }
+
+        void add (Connection* connection);
+
+        void remove (Connection* connection);
+
+        ACE_INET_Addr address;
+        JobQueue queue;
+        Connection* connections;
+        size_t count;
+      };
+
+    /**
+    * A connection to a host.  Requests are written to the output
+    * buffer as they are assigned and sent as far as the socket takes
+    * them; the responses are parsed in the input buffer in the order
+    * the requests were sent and the body of each is collected before
+    * it is passed on.
+    */
+    class AsyncClient::Connection
+      : public ACE_Svc_Handler<ACE_SOCK_Stream, ACE_NULL_SYNCH>
+      {
+        public:
+          typedef ACE_Svc_Handler<ACE_SOCK_Stream, ACE_NULL_SYNCH> super;
+
+          Connection (AsyncClient* client = 0, Host* host = 0);
+
+          virtual int open (void* = 0);
+
+          virtual int handle_input (ACE_HANDLE);
+
+          virtual int handle_output (ACE_HANDLE);
+
+          virtual int handle_timeout (const ACE_Time_Value&, const void*);
+
+          virtual int handle_close (ACE_HANDLE, ACE_Reactor_Mask);
+
+          /// Send <job> on this connection.
+          void enqueue (Job* job);
+
+          /// Returns true if requests can be assigned to the connection.
+          bool usable () const;
+
+          /// Returns the requests sent and not answered yet.
+          size_t load () const;
+
+          bool opened () const;
+
+          /// Returns true while the connection calls back the client.
+          bool in_upcall () const;
+
+          Host* host () const;
+
+          /// Let go of the client; returns the requests not answered.
+          /// The connection closes once it is out of its callbacks.
+          Job* detach ();
+
+          Connection* next_;
+
+        private:
+          enum State
+            {
+              ST_HEAD,
+              ST_LENGTH,
+              ST_CHUNK_SIZE,
+              ST_CHUNK_DATA,
+              ST_CHUNK_END,
+              ST_TRAILER,
+              ST_EOF
+            };
+
+          int flush ();
+
+          int process ();
+
+          int start_body ();
+
+          int complete ();
+
+          /// Point <line> to the next line received, without its line
+          /// end.  Returns 1 if there is one, 0 if it did not come in
+          /// yet, -1 if it is too long.
+          int read_line (const char*& line, size_t& length);
+
+          /// Returns true if <length> more bytes of body do not take
+          /// the body past the size the client accepts.
+          bool body_fits (size_t length) const;
+
+          int append_body (const char* data, size_t length);
+
+          AsyncClient* client_;
+          Host* host_;
+
+          JobQueue jobs_;
+
+          ACE_Message_Block out_;
+          ACE_Message_Block in_;
+          ACE_Message_Block body_;
+
+          ACE::INet::HeaderParser parser_;
+          Response response_;
+
+          State state_;
+          size_t remaining_;
+          size_t max_body_;
+          bool keep_alive_;
+
+          bool opened_;
+          bool closing_;
+          bool closed_;
+          bool writing_;
+          bool upcall_;
+          int error_;
+      };
+
+    class AsyncClient::Connector
+      : public ACE_Connector<Connection, ACE_SOCK_Connector>
+      {
+      };
+
+    void AsyncClient::Host::add (Connection* connection)
+      {
+        connection->next_ = this->connections;
+        this->connections = connection;
+        ++this->count;
+      }
+
+    void AsyncClient::Host::remove (Connection* connection)
+      {
+        for (Connection** c = &this->connections; *c != 0; c = &(*c)->next_)
+          {
+            if (*c == connection)
+              {
+                *c = connection->next_;
+                connection->next_ = 0;
+                --this->count;
+                return;
+              }
+          }
+      }
+
+    AsyncClient::Connection::Connection (AsyncClient* client, Host* host)
+      : next_ (0),
+        client_ (client),
+        host_ (host),
+        out_ (INITIAL_BUFFER),
+        in_ (INITIAL_BUFFER),
+        body_ (INITIAL_BUFFER),
+        state_ (ST_HEAD),
+        remaining_ (0),
+        max_body_ (client != 0 ? client->max_body_size () : 0),
+        keep_alive_ (true),
+        opened_ (false),
+        closing_ (false),
+        closed_ (false),
+        writing_ (false),
+        upcall_ (false),
+        error_ (0)
+      {
+        if (client != 0)
+          this->reactor (client->reactor ());
+      }
+
+    int AsyncClient::Connection::open (void* arg)
+      {
+        if (super::open (arg) == -1)
+          return -1;
+
+        this->opened_ = true;
+
+        INET_DEBUG (9, (LM_INFO, DLINFO
+                        ACE_TEXT ("ACE_INet_HTTP: AsyncClient connected to %C:%u\n"),
+                        this->host_->address.get_host_addr (),
+                        this->host_->address.get_port_number ()));
+
+        if (this->closing_)
+          return -1;
+        return this->flush ();
+      }
+
+    bool AsyncClient::Connection::usable () const
+      {
+        return !this->closing_ && this->client_ != 0;
+      }
+
+    size_t AsyncClient::Connection::load () const
+      {
+        return this->jobs_.size ();
+      }
+
+    bool AsyncClient::Connection::opened () const
+      {
+        return this->opened_;
+      }
+
+    bool AsyncClient::Connection::in_upcall () const
+      {
+        return this->upcall_;
+      }
+
+    AsyncClient::Host* AsyncClient::Connection::host () const
+      {
+        return this->host_;
+      }
+
+    void AsyncClient::Connection::enqueue (Job* job)
+      {
+        this->jobs_.push (job);
+
+        size_t const length = job->data.length ();
+        if (this->out_.space () < length)
+          {
+            this->out_.crunch ();
+            if (this->out_.space () < length)
+              this->out_.size (this->out_.length () + length);
+          }
+        this->out_.copy (job->data.c_str (), length);
+
+        // errors are handled by the reactor; writing again fails the
+        // same way and closes the connection from there
+        if (this->opened_ && !this->writing_ && this->flush () == -1)
+          {
+            this->writing_ = true;
+            this->reactor ()->register_handler (this,
+                                                ACE_Event_Handler::WRITE_MASK);
+          }
+      }
+
+    int AsyncClient::Connection::flush ()
+      {
+        // a server gone while requests are still written to it is an
+        // error of the connection, not a signal to the process
+#if defined (MSG_NOSIGNAL)
+        int const flags = MSG_NOSIGNAL;
+#else
+        int const flags = 0;
+#endif /* MSG_NOSIGNAL */
+
+        while (this->out_.length () > 0)
+          {
+            ssize_t const n = this->peer ().send (this->out_.rd_ptr (),
+                                                  this->out_.length (),
+                                                  flags);
+            if (n == -1)
+              {
+                if (errno != EWOULDBLOCK)
+                  {
+                    this->error_ = errno;
+                    return -1;
+                  }
+                if (!this->writing_)
+                  {
+                    this->writing_ = true;
+                    return this->reactor ()->register_handler (
+                        this, ACE_Event_Handler::WRITE_MASK);
+                  }
+                return 0;
+              }
+            this->out_.rd_ptr (static_cast<size_t> (n));
+          }
+
+        this->out_.reset ();
+        if (this->writing_)
+          {
+            this->writing_ = false;
+            this->reactor ()->remove_handler (
+                this,
+                ACE_Event_Handler::WRITE_MASK | ACE_Event_Handler::DONT_CALL);
+          }
+        return 0;
+      }
+
+    int AsyncClient::Connection::handle_output (ACE_HANDLE)
+      {
+        if (this->closing_ && this->client_ == 0)
+          return -1;
+        return this->flush ();
+      }
+
+    int AsyncClient::Connection::handle_input (ACE_HANDLE)
+      {
+        if (this->closing_ && this->client_ == 0)
+          return -1;
+
+        if (this->in_.length () == 0)
+          this->in_.reset ();
+        if (this->in_.space () < MIN_RECV)
+          {
+            this->in_.crunch ();
+            if (this->in_.space () < MIN_RECV
+                && this->in_.size (2 * this->in_.size ()) == -1)
+              {
+                this->error_ = ENOMEM;
+                return -1;
+              }
+          }
+
+        ssize_t const n = this->peer ().recv (this->in_.wr_ptr (),
+                                              this->in_.space ());
+        if (n == 0)
+          {
+            this->closing_ = true;
+            return -1;
+          }
+        if (n == -1)
+          {
+            if (errno == EWOULDBLOCK)
+              return 0;
+            this->error_ = errno;
+            return -1;
+          }
+        this->in_.wr_ptr (static_cast<size_t> (n));
+
+        return this->process ();
+      }
+
+    int AsyncClient::Connection::process ()
+      {
+        const char* line = 0;
+        size_t length = 0;
+        int result = 0;
+
+        for (;;)
+          {
+            switch (this->state_)
+              {
+              case ST_HEAD:
+                if (this->in_.length () == 0)
+                  return 0;
+                if (this->jobs_.empty ())
+                  {
+                    // a response to nothing
+                    this->error_ = EPROTO;
+                    return -1;
+                  }
+                switch (this->parser_.parse (this->in_))
+                  {
+                  case ACE::INet::HeaderParser::PARSE_INCOMPLETE:
+                    return 0;
+                  case ACE::INet::HeaderParser::PARSE_ERROR:
+                    this->error_ = EPROTO;
+                    return -1;
+                  default:
+                    break;
+                  }
+                if (this->start_body () == -1)
+                  return -1;
+                break;
+
+              case ST_LENGTH:
+              case ST_CHUNK_DATA:
+                length = this->in_.length () < this->remaining_
+                           ? this->in_.length () : this->remaining_;
+                if (this->append_body (this->in_.rd_ptr (), length) == -1)
+                  return -1;
+                this->in_.rd_ptr (length);
+                this->remaining_ -= length;
+                if (this->remaining_ != 0)
+                  return 0;
+                if (this->state_ == ST_CHUNK_DATA)
+                  this->state_ = ST_CHUNK_END;
+                else if (this->complete () == -1)
+                  return -1;
+                break;
+
+              case ST_CHUNK_SIZE:
+                result = this->read_line (line, length);
+                if (result <= 0)
+                  return result;
+                {
+                  size_t size = 0;
+                  size_t p = 0;
+                  for (int digit = 0;
+                       p != length && (digit = hex_digit (line[p])) != -1;
+                       ++p)
+                    {
+                      if (size > (MAX_SIZE - digit) / 16)
+                        {
+                          this->error_ = EPROTO;
+                          return -1;
+                        }
+                      size = 16 * size + digit;
+                    }
+                  // the size may be followed by chunk extensions
+                  if (p == 0
+                      || (p != length && line[p] != ';'
+                          && line[p] != ' ' && line[p] != '\t'))
+                    {
+                      this->error_ = EPROTO;
+                      return -1;
+                    }
+                  if (!this->body_fits (size))
+                    {
+                      this->error_ = EFBIG;
+                      return -1;
+                    }
+                  this->remaining_ = size;
+                }
+                this->state_ = this->remaining_ == 0 ? ST_TRAILER
+                                                     : ST_CHUNK_DATA;
+                break;
+
+              case ST_CHUNK_END:
+                result = this->read_line (line, length);
+                if (result <= 0)
+                  return result;
+                if (length != 0)
+                  {
+                    this->error_ = EPROTO;
+                    return -1;
+                  }
+                this->state_ = ST_CHUNK_SIZE;
+                break;
+
+              case ST_TRAILER:
+                result = this->read_line (line, length);
+                if (result <= 0)
+                  return result;
+                if (length == 0 && this->complete () == -1)
+                  return -1;
+                break;
+
+              case ST_EOF:
+                if (this->append_body (this->in_.rd_ptr (),
+                                       this->in_.length ()) == -1)
+                  return -1;
+                this->in_.reset ();
+                return 0;
+              }
+          }
+      }
+
+    int AsyncClient::Connection::start_body ()
+      {
+        const ACE::INet::HeaderParser& parser = this->parser_;
+
+        this->response_.clear ();
+        if (!this->response_.read (parser))
+          {
+            this->error_ = EPROTO;
+            return -1;
+          }
+
+        // the headers deciding on the body are looked up before the
+        // views of the parser go with the head
+        this->keep_alive_ =
+          this->response_.get_version () == Header::HTTP_1_1;
+        int i = parser.find (Header::CONNECTION.c_str ());
+        if (i != -1)
+          {
+            if (equal_nocase (parser.value (i), "close"))
+              this->keep_alive_ = false;
+            else if (equal_nocase (parser.value (i), "keep-alive"))
+              this->keep_alive_ = true;
+          }
+
+        bool chunked = false;
+        i = parser.find (Header::TRANSFER_ENCODING.c_str ());
+        if (i != -1)
+          {
+            ACE::INet::HeaderParser::View v = parser.value (i);
+            size_t const n = Header::CHUNKED_TRANSFER_ENCODING.length ();
+            chunked = v.length >= n
+                && ACE_OS::strncasecmp (v.data + v.length - n,
+                                        Header::CHUNKED_TRANSFER_ENCODING.c_str (),
+                                        n) == 0;
+          }
+
+        bool has_length = false;
+        size_t content_length = 0;
+        i = parser.find (Header::CONTENT_LENGTH.c_str ());
+        if (i != -1)
+          {
+            ACE::INet::HeaderParser::View v = parser.value (i);
+            for (size_t p = 0; p != v.length; ++p)
+              {
+                if (v.data[p] < '0' || v.data[p] > '9')
+                  {
+                    this->error_ = EPROTO;
+                    return -1;
+                  }
+                size_t const digit = v.data[p] - '0';
+                if (content_length > (MAX_SIZE - digit) / 10)
+                  {
+                    this->error_ = EPROTO;
+                    return -1;
+                  }
+                content_length = 10 * content_length + digit;
+              }
+            has_length = v.length != 0;
+          }
+
+        this->in_.rd_ptr (parser.header_length ());
+        this->parser_.reset ();
+        this->body_.reset ();
+
+        int const status = this->response_.get_status ().get_status ();
+
+        INET_DEBUG (9, (LM_INFO, DLINFO
+                        ACE_TEXT ("ACE_INet_HTTP: AsyncClient got status %d\n"),
+                        status));
+
+        // interim responses come before the one to the request
+        if (status >= 100 && status < 200)
+          return 0;
+
+        if (this->jobs_.front ()->head_request
+            || status == Status::HTTP_NO_CONTENT
+            || status == Status::HTTP_NOT_MODIFIED)
+          return this->complete ();
+
+        if (chunked)
+          this->state_ = ST_CHUNK_SIZE;
+        else if (has_length)
+          {
+            if (content_length == 0)
+              return this->complete ();
+            // the body grows as it comes in rather than by the size the
+            // server claims
+            if (!this->body_fits (content_length))
+              {
+                this->error_ = EFBIG;
+                return -1;
+              }
+            this->remaining_ = content_length;
+            this->state_ = ST_LENGTH;
+          }
+        else
+          {
+            // the body ends with the connection
+            this->keep_alive_ = false;
+            this->state_ = ST_EOF;
+          }
+        return 0;
+      }
+
+    int AsyncClient::Connection::complete ()
+      {
+        Job* job = this->jobs_.pop ();
+        this->state_ = ST_HEAD;
+        if (!this->keep_alive_)
+          this->closing_ = true;
+
+        if (this->client_ != 0)
+          {
+            this->upcall_ = true;
+            this->client_->completed (job, this->response_, this->body_);
+            this->upcall_ = false;
+          }
+        else
+          delete job;
+        this->body_.reset ();
+
+        if (this->closing_)
+          return -1;
+        if (this->client_ != 0)
+          this->client_->dispatch (*this->host_);
+        return 0;
+      }
+
+    int AsyncClient::Connection::read_line (const char*& line,
+                                            size_t& length)
+      {
+        line = this->in_.rd_ptr ();
+        const char* lf = static_cast<const char*> (
+            ACE_OS::memchr (line, '\n', this->in_.length ()));
+        if (lf == 0)
+          {
+            if (this->in_.length () <= MAX_LINE_LENGTH)
+              return 0;
+            this->error_ = EPROTO;
+            return -1;
+          }
+
+        length = lf - line;
+        if (length > 0 && line[length - 1] == '\r')
+          --length;
+        this->in_.rd_ptr (lf + 1 - line);
+        return 1;
+      }
+
+    bool AsyncClient::Connection::body_fits (size_t length) const
+      {
+        return this->max_body_ == 0
+            || length <= this->max_body_ - this->body_.length ();
+      }
+
+    int AsyncClient::Connection::append_body (const char* data,
+                                              size_t length)
+      {
+        if (!this->body_fits (length))
+          {
+            this->error_ = EFBIG;
+            return -1;
+          }
+
+        if (this->body_.space () < length)
+          {
+            size_t size = 2 * this->body_.size ();
+            if (size < this->body_.length () + length)
+              size = this->body_.length () + length;
+            if (this->max_body_ != 0 && size > this->max_body_)
+              size = this->max_body_;
+            if (this->body_.size (size) == -1)
+              {
+                this->error_ = ENOMEM;
+                return -1;
+              }
+          }
+        return this->body_.copy (data, length);
+      }
+
+    int AsyncClient::Connection::handle_timeout (const ACE_Time_Value&,
+                                                 const void*)
+      {
+        // only the connector schedules timers for the connection, when
+        // it gives up waiting for it to be set up
+        this->error_ = this->opened_ ? ETIME : ETIMEDOUT;
+        return -1;
+      }
+
+    AsyncClient::Job* AsyncClient::Connection::detach ()
+      {
+        this->client_ = 0;
+        this->closing_ = true;
+        return this->jobs_.release ();
+      }
+
+    int AsyncClient::Connection::handle_close (ACE_HANDLE handle,
+                                               ACE_Reactor_Mask mask)
+      {
+        if (this->closed_)
+          return 0;
+        this->closed_ = true;
+
+        // a body ending with the connection is complete now
+        if (this->state_ == ST_EOF && this->error_ == 0)
+          this->complete ();
+
+        if (this->client_ != 0)
+          {
+            int error = this->error_;
+            if (error == 0)
+              error = this->opened_ ? ECONNRESET : ECONNREFUSED;
+            AsyncClient* client = this->client_;
+            Job* jobs = this->detach ();
+            client->closed (this, jobs, error);
+          }
+
+        return super::handle_close (handle, mask);
+      }
+
+
+    AsyncResponseHandler::AsyncResponseHandler ()
+      {
+      }
+
+    AsyncResponseHandler::~AsyncResponseHandler ()
+      {
+      }
+
+
+    AsyncClient::AsyncClient (ACE_Reactor* reactor,
+                              size_t max_connections,
+                              size_t max_pipeline)
+      : reactor_ (reactor == 0 ? ACE_Reactor::instance () : reactor),
+        max_connections_ (max_connections == 0 ? 1 : max_connections),
+        max_pipeline_ (max_pipeline == 0 ? 1 : max_pipeline),
+        max_body_size_ (DEFAULT_MAX_BODY_SIZE),
+        connector_ (0),
+        pending_ (0)
+      {
+        ACE_NEW_NORETURN (this->connector_, Connector);
+        if (this->connector_ != 0)
+          this->connector_->open (this->reactor_, ACE_NONBLOCK);
+      }
+
+    AsyncClient::~AsyncClient ()
+      {
+        this->close ();
+        delete this->connector_;
+      }
+
+    int AsyncClient::get (const URL& url,
+                          AsyncResponseHandler* handler,
+                          const void* act)
+      {
+        Request request (Request::HTTP_GET,
+                         url.get_request_uri (),
+                         Header::HTTP_1_1);
+        return this->send_request (url.get_host (),
+                                   url.get_port (),
+                                   request,
+                                   handler,
+                                   act);
+      }
+
+    int AsyncClient::send_request (const ACE_CString& host,
+                                   u_short port,
+                                   Request& request,
+                                   AsyncResponseHandler* handler,
+                                   const void* act,
+                                   const char* body,
+                                   size_t length)
+      {
+        if (this->connector_ == 0)
+          return -1;
+
+        if (!request.has_host ())
+          {
+            if (port == URL::HTTP_PORT)
+              request.set_host (host);
+            else
+              request.set_host (host, port);
+          }
+        const ACE_CString& method = request.get_method ();
+        if (body != 0
+            || method == Request::HTTP_POST || method == Request::HTTP_PUT)
+          request.set_content_length (static_cast<int> (length));
+
+        Job* job = 0;
+        ACE_NEW_RETURN (job, Job, -1);
+        {
+          ACE::IOS::CString_OStream sos;
+          request.write (sos);
+          job->data = sos.str ();
+        }
+        if (body != 0)
+          job->data.append (body, length);
+        job->head_request = method == Request::HTTP_HEAD;
+        job->idempotent = idempotent (method);
+        job->handler = handler;
+        job->act = act;
+
+        ClientRequestHandler::HttpConnectionKey key (host, port);
+        Host* h = 0;
+        if (this->hosts_.find (ACE::INet::ConnectionCacheKey (key), h) != 0)
+          {
+            ACE_NEW_NORETURN (h, Host);
+            if (h == 0
+                || h->address.set (port, host.c_str ()) != 0
+                || this->hosts_.bind (ACE::INet::ConnectionCacheKey (key), h) != 0)
+              {
+                INET_ERROR (1, (LM_ERROR, DLINFO
+                                ACE_TEXT ("ACE_INet_HTTP: AsyncClient failed to ")
+                                ACE_TEXT ("add host %C:%u\n"),
+                                host.c_str (), port));
+                delete h;
+                delete job;
+                return -1;
+              }
+          }
+
+        h->queue.push (job);
+        ++this->pending_;
+        this->dispatch (*h);
+        return 0;
+      }
+
+    bool AsyncClient::idempotent (const ACE_CString& method)
+      {
+        return method == Request::HTTP_GET
+            || method == Request::HTTP_HEAD
+            || method == Request::HTTP_PUT
+            || method == Request::HTTP_DELETE
+            || method == Request::HTTP_OPTIONS
+            || method == Request::HTTP_TRACE;
+      }
+
+    void AsyncClient::dispatch (Host& host)
+      {
+        bool may_connect = true;
+        while (!host.queue.empty ())
+          {
+            // requests that may not be sent twice are not pipelined
+            size_t load = host.queue.front ()->idempotent
+                            ? this->max_pipeline_ : 1;
+            Connection* target = 0;
+            for (Connection* c = host.connections; c != 0; c = c->next_)
+              {
+                if (c->usable () && c->load () < load)
+                  {
+                    target = c;
+                    load = c->load ();
+                  }
+              }
+
+            if ((target == 0 || load != 0)
+                && may_connect
+                && host.count < this->max_connections_)
+              {
+                Connection* c = this->connect (host);
+                if (c == 0)
+                  {
+                    // the failure may have taken the queue with it
+                    may_connect = false;
+                    continue;
+                  }
+                target = c;
+              }
+
+            if (target == 0)
+              break;
+
+            target->enqueue (host.queue.pop ());
+          }
+      }
+
+    AsyncClient::Connection* AsyncClient::connect (Host& host)
+      {
+        Connection* connection = 0;
+        ACE_NEW_RETURN (connection, Connection (this, &host), 0);
+        host.add (connection);
+
+        ACE_Synch_Options options (ACE_Synch_Options::USE_REACTOR);
+        if (this->connect_timeout_ != ACE_Time_Value::zero)
+          options.set (ACE_Synch_Options::USE_REACTOR
+                         | ACE_Synch_Options::USE_TIMEOUT,
+                       this->connect_timeout_);
+
+        // a connection failing right away is closed and deleted by the
+        // connector before this returns
+        if (this->connector_->connect (connection, host.address, options) == -1
+            && errno != EWOULDBLOCK)
+          {
+            INET_DEBUG (3, (LM_ERROR, DLINFO
+                            ACE_TEXT ("ACE_INet_HTTP: AsyncClient failed to ")
+                            ACE_TEXT ("connect to %C:%u\n"),
+                            host.address.get_host_addr (),
+                            host.address.get_port_number ()));
+            return 0;
+          }
+        return connection;
+      }
+
+    void AsyncClient::completed (Job* job,
+                                 const Response& response,
+                                 const ACE_Message_Block& body)
+      {
+        --this->pending_;
+        if (job->handler != 0)
+          job->handler->handle_response (response, body, job->act);
+        delete job;
+      }
+
+    void AsyncClient::fail (Job* jobs, int error)
+      {
+        while (jobs != 0)
+          {
+            Job* job = jobs;
+            jobs = job->next;
+            --this->pending_;
+            if (job->handler != 0)
+              job->handler->handle_error (error, job->act);
+            delete job;
+          }
+      }
+
+    void AsyncClient::closed (Connection* connection, Job* jobs, int error)
+      {
+        Host& host = *connection->host ();
+        host.remove (connection);
+
+        if (!connection->opened ())
+          {
+            // nothing was sent; the queue fails with the last way to
+            // the host
+            Job* rest = host.count == 0 ? host.queue.release () : 0;
+            this->fail (jobs, error);
+            this->fail (rest, error);
+            return;
+          }
+
+        // a response the client could not take fails its request
+        Job* failed = 0;
+        Job** failed_tail = &failed;
+        if (jobs != 0 && (error == EPROTO || error == EFBIG))
+          {
+            failed = jobs;
+            jobs = jobs->next;
+            failed->next = 0;
+            failed_tail = &failed->next;
+          }
+
+        // the requests the server dropped are sent again once if their
+        // method is idempotent, and fail otherwise
+        JobQueue retry;
+        while (jobs != 0)
+          {
+            Job* job = jobs;
+            jobs = job->next;
+            if (job->idempotent && job->retries == 0)
+              {
+                ++job->retries;
+                retry.push (job);
+              }
+            else
+              {
+                job->next = 0;
+                *failed_tail = job;
+                failed_tail = &job->next;
+              }
+          }
+        host.queue.push_front (retry);
+
+        this->dispatch (host);
+        this->fail (failed, error);
+      }
+
+    void AsyncClient::close ()
+      {
+        // take everything apart before the callbacks run, which may
+        // queue requests again
+        Job* jobs = 0;
+        Job** tail = &jobs;
+
+        for (host_map_type::iterator it = this->hosts_.begin ();
+             it != this->hosts_.end ();
+             ++it)
+          {
+            Host* host = (*it).int_id_;
+            while (host->connections != 0)
+              {
+                Connection* c = host->connections;
+                host->remove (c);
+                *tail = c->detach ();
+                while (*tail != 0)
+                  tail = &(*tail)->next;
+                if (!c->opened ())
+                  {
+                    this->connector_->cancel (c);
+                    c->close ();
+                  }
+                else if (!c->in_upcall ())
+                  c->close ();
+              }
+            *tail = host->queue.release ();
+            while (*tail != 0)
+              tail = &(*tail)->next;
+            delete host;
+          }
+        this->hosts_.unbind_all ();
+
+        this->fail (jobs, ECANCELED);
+      }
+
+  }
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,216 @@
+// $Id$
+
+/**
+ * @file HTTP_AsyncClient.h
+ */
+
+#ifndef ACE_HTTP_ASYNC_CLIENT_H
+#define ACE_HTTP_ASYNC_CLIENT_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Time_Value.h"
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Null_Mutex.h"
+#include "ace/INet/INet_Export.h"
+#include "ace/INet/ConnectionCache.h"
+#include "ace/INet/HTTP_Request.h"
+#include "ace/INet/HTTP_Response.h"
+#include "ace/INet/HTTP_URL.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Reactor;
+class ACE_Message_Block;
+
+namespace ACE
+  {
+    namespace HTTP
+      {
+        /**
+        * @class ACE_HTTP_AsyncResponseHandler
+        *
+        * @brief Completion callbacks for the requests of an AsyncClient.
+        *
+        */
+        class ACE_INET_Export AsyncResponseHandler
+          {
+            public:
+              virtual ~AsyncResponseHandler ();
+
+              /// Called with the response to a request and its body.
+              /// <act> is the token given with the request.
+              virtual void handle_response (const Response& response,
+                                            const ACE_Message_Block& body,
+                                            const void* act) = 0;
+
+              /// Called when a request failed; <error> is the errno value:
+              /// ETIMEDOUT if the connection to the host was not set up
+              /// within the connect timeout, ECONNREFUSED if it failed,
+              /// ECONNRESET if the server closed it before it answered,
+              /// EPROTO for a malformed response, EFBIG for a body
+              /// larger than the client takes, and ECANCELED for the
+              /// requests of a client closed.
+              virtual void handle_error (int error, const void* act) = 0;
+
+            protected:
+              AsyncResponseHandler ();
+          };
+
+        /**
+        * @class ACE_HTTP_AsyncClient
+        *
+        * @brief Non-blocking HTTP/1.1 client driven by a reactor.
+        *
+        * Requests are queued per HttpConnectionKey and sent over up to
+        * max_connections () keep-alive connections to the host, each
+        * taking up to max_pipeline () requests before the responses to
+        * the first ones came in.  A request goes to an idle connection
+        * first, then to a new one, and is pipelined only once all the
+        * connections the host may have are busy; the rest wait in the
+        * queue of the host.  Responses are parsed in the receive buffer
+        * and passed to the AsyncResponseHandler of their request.
+        *
+        * Requests of a connection the server closed before it answered
+        * them are sent again once if their method is idempotent, and
+        * fail with ECONNRESET otherwise.
+        *
+        * A response body is collected in memory up to max_body_size ()
+        * bytes; a larger one fails its request with EFBIG and closes
+        * the connection.
+        *
+        * Requests are sent with MSG_NOSIGNAL where the platform has it.
+        * Elsewhere a server closing a connection the client is still
+        * writing to raises SIGPIPE, which the application has to ignore.
+        *
+        * The client is used from the thread that runs the event loop
+        * of its reactor, callbacks included; it has no threads or locks
+        * of its own.
+        */
+        class ACE_INET_Export AsyncClient
+          {
+            public:
+              enum Limits
+                {
+                  DEFAULT_MAX_CONNECTIONS = 4,
+                  DEFAULT_MAX_PIPELINE    = 8,
+                  DEFAULT_MAX_BODY_SIZE   = 64 * 1024 * 1024
+                };
+
+              /// Constructor; uses ACE_Reactor::instance () unless
+              /// <reactor> is given.
+              AsyncClient (ACE_Reactor* reactor = 0,
+                           size_t max_connections = DEFAULT_MAX_CONNECTIONS,
+                           size_t max_pipeline = DEFAULT_MAX_PIPELINE);
+
+              /// Destructor; close ()s the client.
+              ~AsyncClient ();
+
+              /// Queue a GET request for <url>.
+              /// Returns 0 if the request was queued, -1 otherwise.
+              int get (const URL& url,
+                       AsyncResponseHandler* handler,
+                       const void* act = 0);
+
+              /// Queue <request> for <host>:<port>, followed by <length>
+              /// bytes of <body>.  The Host header of <request> is set
+              /// unless it has one, and the Content-Length header if a
+              /// body is given.  The address of a host is resolved with
+              /// its first request.
+              /// Returns 0 if the request was queued, -1 otherwise.
+              int send_request (const ACE_CString& host,
+                                u_short port,
+                                Request& request,
+                                AsyncResponseHandler* handler,
+                                const void* act = 0,
+                                const char* body = 0,
+                                size_t length = 0);
+
+              /// Close all connections; the requests not answered yet
+              /// fail with ECANCELED.
+              void close ();
+
+              /// Set the time a connection may take to be established;
+              /// zero waits as long as it takes.
+              void connect_timeout (const ACE_Time_Value& timeout);
+
+              const ACE_Time_Value& connect_timeout () const;
+
+              /// Set the largest response body accepted; zero takes any
+              /// size.  Applies to the connections set up after the call.
+              void max_body_size (size_t size);
+
+              size_t max_body_size () const;
+
+              size_t max_connections () const;
+
+              size_t max_pipeline () const;
+
+              /// Returns the number of requests not answered yet.
+              size_t pending () const;
+
+              ACE_Reactor* reactor () const;
+
+              struct Job;
+              struct Host;
+              class Connection;
+
+            private:
+              class Connector;
+              friend class Connection;
+
+              /// Assign the queued requests of <host> to connections.
+              void dispatch (Host& host);
+
+              /// Connect to <host>, 0 if that failed right away.
+              Connection* connect (Host& host);
+
+              /// Called by a connection closed with the requests it
+              /// had not answered.
+              void closed (Connection* connection, Job* jobs, int error);
+
+              /// Called by a connection with a request it completed.
+              void completed (Job* job,
+                              const Response& response,
+                              const ACE_Message_Block& body);
+
+              /// Fail the list of <jobs> with <error>.
+              void fail (Job* jobs, int error);
+
+              static bool idempotent (const ACE_CString& method);
+
+              typedef ACE_Hash_Map_Manager_Ex <ACE::INet::ConnectionCacheKey,
+                                               Host*,
+                                               ACE_Hash<ACE::INet::ConnectionCacheKey>,
+                                               ACE_Equal_To<ACE::INet::ConnectionCacheKey>,
+                                               ACE_Null_Mutex> host_map_type;
+
+              ACE_Reactor* reactor_;
+              size_t max_connections_;
+              size_t max_pipeline_;
+              ACE_Time_Value connect_timeout_;
+              size_t max_body_size_;
+              Connector* connector_;
+              host_map_type hosts_;
+              size_t pending_;
+
+              AsyncClient (const AsyncClient&);
+              AsyncClient& operator =(const AsyncClient&);
+          };
+      }
+  }
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/INet/HTTP_AsyncClient.inl"
+#endif
+
+#include /**/ "ace/post.h"
+#endif /* ACE_HTTP_ASYNC_CLIENT_H */
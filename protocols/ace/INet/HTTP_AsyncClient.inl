@@ -0,0 +1,63 @@
+// -*- C++ -*-
+//
+// $Id$
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace ACE
+{
+  namespace HTTP
+  {
+
+    ACE_INLINE
+    void AsyncClient::connect_timeout (const ACE_Time_Value& timeout)
+      {
+        this->connect_timeout_ = timeout;
+      }
+
+    ACE_INLINE
+    const ACE_Time_Value& AsyncClient::connect_timeout () const
+      {
+        return this->connect_timeout_;
+      }
+
+    ACE_INLINE
+    void AsyncClient::max_body_size (size_t size)
+      {
+        this->max_body_size_ = size;
+      }
+
+    ACE_INLINE
+    size_t AsyncClient::max_body_size () const
+      {
+        return this->max_body_size_;
+      }
+
+    ACE_INLINE
+    size_t AsyncClient::max_connections () const
+      {
+        return this->max_connections_;
+      }
+
+    ACE_INLINE
+    size_t AsyncClient::max_pipeline () const
+      {
+        return this->max_pipeline_;
+      }
+
+    ACE_INLINE
+    size_t AsyncClient::pending () const
+      {
+        return this->pending_;
+      }
+
+    ACE_INLINE
+    ACE_Reactor* AsyncClient::reactor () const
+      {
+        return this->reactor_;
+      }
+
+  }
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -175,6 +175,37 @@ namespace ACE
         return true;
       }
 
+    bool Request::read(const ACE::INet::HeaderParser& parser)
+      {
+        ACE::INet::HeaderParser::View method;
+        ACE::INet::HeaderParser::View uri;
+        ACE::INet::HeaderParser::View version;
+
+        if (parser.status () != ACE::INet::HeaderParser::PARSE_COMPLETE
+            || !parser.split_start_line (method, uri, version))
+          return false;
+        if (method.length > MAX_METHOD_LENGTH)
+          return false; // invalid HTTP method string
+        if (uri.length > MAX_URI_LENGTH)
+          return false; // invalid HTTP uri string
+        if (version.length == 0 || version.length > MAX_VERSION_LENGTH)
+          return false; // invalid HTTP version string
+
+        INET_DEBUG (6, (LM_DEBUG, DLINFO
+                        ACE_TEXT ("ACE_INet_HTTP: <-- %.*C %.*C %.*C\n"),
+                        static_cast<int> (method.length), method.data,
+                        static_cast<int> (uri.length), uri.data,
+                        static_cast<int> (version.length), version.data));
+
+        // get header lines
+        if (!Header::read (parser))
+          return false;
+        this->method_.set (method.data, method.length, true);
+        this->uri_.set (uri.data, uri.length, true);
+        this->set_version (ACE_CString (version.data, version.length));
+        return true;
+      }
+
   }
 }
 
@@ -102,6 +102,10 @@ namespace ACE
               /// given stream.
               bool read(std::istream& str);
 
+              /// Reads the HTTP request from the head
+              /// <parser> completed.
+              bool read(const ACE::INet::HeaderParser& parser);
+
               static const ACE_CString HTTP_GET;
               static const ACE_CString HTTP_HEAD;
               static const ACE_CString HTTP_PUT;
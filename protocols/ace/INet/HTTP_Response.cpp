@@ -120,6 +120,37 @@ namespace ACE
         return true;
       }
 
+    bool Response::read(const ACE::INet::HeaderParser& parser)
+      {
+        ACE::INet::HeaderParser::View version;
+        ACE::INet::HeaderParser::View status;
+        ACE::INet::HeaderParser::View reason;
+
+        if (parser.status () != ACE::INet::HeaderParser::PARSE_COMPLETE
+            || !parser.split_start_line (version, status, reason))
+          return false;
+        if (version.length > MAX_VERSION_LENGTH)
+          return false; // invalid HTTP version string
+        if (status.length > MAX_STATUS_LENGTH)
+          return false; // invalid HTTP status code
+        if (reason.length > MAX_REASON_LENGTH)
+          return false; // HTTP reason string too long
+
+        INET_DEBUG (6, (LM_DEBUG, DLINFO
+                        ACE_TEXT ("ACE_INet_HTTP: <-- %.*C %.*C %.*C\n"),
+                        static_cast<int> (version.length), version.data,
+                        static_cast<int> (status.length), status.data,
+                        static_cast<int> (reason.length), reason.data));
+
+        // get header lines
+        if (!Header::read (parser))
+          return false;
+        this->set_version (ACE_CString (version.data, version.length));
+        this->status_.set_status (ACE_CString (status.data, status.length));
+        this->status_.set_reason (ACE_CString (reason.data, reason.length));
+        return true;
+      }
+
   }
 }
 
@@ -76,6 +76,10 @@ namespace ACE
               /// 100 Continue responses are ignored.
               virtual bool read(std::istream& str);
 
+              /// Reads the HTTP response from the head
+              /// <parser> completed.
+              bool read(const ACE::INet::HeaderParser& parser);
+
               static const ACE_CString COOKIE;
 
             private:
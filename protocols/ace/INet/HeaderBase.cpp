@@ -121,6 +121,29 @@ namespace ACE
         return true;
       }
 
+    bool HeaderBase::read(const HeaderParser& parser)
+      {
+        if (parser.status () != HeaderParser::PARSE_COMPLETE)
+          return false;
+
+        ACE_CString name (64, '\0');
+        ACE_CString value (128, '\0');
+        for (size_t i = 0; i < parser.count () ;++i)
+          {
+            HeaderParser::View const n = parser.name (i);
+            name.set (n.data, n.length, true);
+            parser.get_value (i, value);
+
+            this->add (name, value);
+
+            INET_DEBUG (9, (LM_DEBUG, DLINFO
+                            ACE_TEXT ("ACE_INet_HTTP: <-+ %C: %C\n"),
+                            name.c_str (),
+                            value.c_str ()));
+          }
+        return true;
+      }
+
 
     void HeaderBase::set (const ACE_CString& name, const ACE_CString& value)
       {
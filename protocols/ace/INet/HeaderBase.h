@@ -22,6 +22,7 @@
 #include "ace/Containers_T.h"
 #include "ace/OS_NS_ctype.h"
 #include "ace/INet/INet_Export.h"
+#include "ace/INet/HeaderParser.h"
 #include <iostream>
 
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -108,6 +109,9 @@ namespace ACE
               /// given stream.
               virtual bool read(std::istream& str);
 
+              /// Adds the headers of a head <parser> completed.
+              bool read(const HeaderParser& parser);
+
               static const int         UNKNOWN_CONTENT_LENGTH;
               static const ACE_CString UNKNOWN_CONTENT_TYPE;
 
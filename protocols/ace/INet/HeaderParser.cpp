@@ -0,0 +1,274 @@
+// $Id$
+
+#include "ace/INet/HeaderParser.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_strings.h"
+
+#if !defined (__ACE_INLINE__)
+#include "ace/INet/HeaderParser.inl"
+#endif
+
+// Lines are scanned 16 bytes at a time with SSE2 where it is always
+// available; define ACE_LACKS_INET_HEADER_SIMD to scan them a byte at
+// a time.
+#if !defined (ACE_LACKS_INET_HEADER_SIMD) && defined (__GNUC__) \
+    && defined (__SSE2__)
+# define ACE_INET_HEADER_SSE2
+# include <emmintrin.h>
+#endif
+
+
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace ACE
+{
+  namespace INet
+  {
+
+    HeaderParser::HeaderParser (size_t max_length, size_t max_headers)
+      : max_length_ (max_length),
+        max_headers_ (max_headers),
+        fields_ (16)
+      {
+        this->reset ();
+      }
+
+    HeaderParser::~HeaderParser ()
+      {
+      }
+
+    void HeaderParser::reset ()
+      {
+        this->status_ = PARSE_INCOMPLETE;
+        this->buf_ = 0;
+        this->line_ = 0;
+        this->colon_ = 0;
+        this->has_colon_ = false;
+        this->scanned_ = 0;
+        this->has_start_ = false;
+        this->start_offset_ = 0;
+        this->start_length_ = 0;
+        this->header_length_ = 0;
+        this->count_ = 0;
+      }
+
+    HeaderParser::Status HeaderParser::parse (const char* buf, size_t length)
+      {
+        if (this->status_ != PARSE_INCOMPLETE)
+          return this->status_;
+
+        this->buf_ = buf;
+
+        const char* const end = buf + length;
+        const char* p = buf + this->scanned_;
+        while (p != end)
+          {
+            // only the colon of a header line counts
+            bool const colon = this->has_start_ && !this->has_colon_;
+            p = scan (p, end, colon);
+            if (p == end)
+              break;
+
+            size_t const offset = p - buf;
+            ++p;
+            if (*(p - 1) == ':')
+              {
+                this->colon_ = offset;
+                this->has_colon_ = true;
+                continue;
+              }
+
+            if (offset >= this->max_length_)
+              return this->status_ = PARSE_ERROR;
+
+            this->status_ = this->parse_line (offset);
+            if (this->status_ != PARSE_INCOMPLETE)
+              {
+                this->scanned_ = offset + 1;
+                return this->status_;
+              }
+
+            this->line_ = offset + 1;
+            this->has_colon_ = false;
+          }
+
+        this->scanned_ = length;
+        if (length > this->max_length_)
+          this->status_ = PARSE_ERROR;
+        return this->status_;
+      }
+
+    HeaderParser::Status HeaderParser::parse_line (size_t end)
+      {
+        size_t const lf = end;
+        if (end > this->line_ && this->buf_[end - 1] == '\r')
+          --end;
+
+        if (!this->has_start_)
+          {
+            // skip empty lines before the start line
+            if (end != this->line_)
+              {
+                this->has_start_ = true;
+                this->start_offset_ = this->line_;
+                this->start_length_ = end - this->line_;
+              }
+            return PARSE_INCOMPLETE;
+          }
+
+        if (end == this->line_)
+          {
+            this->header_length_ = lf + 1;
+            return PARSE_COMPLETE;
+          }
+
+        char const first = this->buf_[this->line_];
+        if (first == ' ' || first == '\t')
+          {
+            // followup lines starting with ws are continuations of the
+            // value; the value is extended over them
+            if (this->count_ == 0)
+              return PARSE_INCOMPLETE;
+
+            Field& f = this->fields_[this->count_ - 1];
+            f.value_length = end - f.value_offset;
+            f.continued = true;
+            if (f.value_length > MAX_VALUE_LENGTH)
+              return PARSE_ERROR;
+            return PARSE_INCOMPLETE;
+          }
+
+        if (!this->has_colon_)
+          return PARSE_INCOMPLETE; // ignore invalid headers
+
+        Field f;
+        f.name_offset = this->line_;
+        f.name_length = this->colon_ - this->line_;
+        if (f.name_length > MAX_NAME_LENGTH)
+          return PARSE_ERROR;
+
+        // skip leading whitespace of the value
+        size_t v = this->colon_ + 1;
+        while (v < end && (this->buf_[v] == ' ' || this->buf_[v] == '\t'))
+          ++v;
+        f.value_offset = v;
+        f.value_length = end - v;
+        f.continued = false;
+        if (f.value_length > MAX_VALUE_LENGTH)
+          return PARSE_ERROR;
+
+        if (this->count_ == this->max_headers_)
+          return PARSE_ERROR;
+        if (this->count_ == this->fields_.size ()
+            && this->fields_.size (2 * this->count_) != 0)
+          return PARSE_ERROR;
+
+        this->fields_[this->count_++] = f;
+        return PARSE_INCOMPLETE;
+      }
+
+    const char* HeaderParser::scan (const char* begin,
+                                    const char* end,
+                                    bool colon)
+      {
+#if defined (ACE_INET_HEADER_SSE2)
+        __m128i const lf = _mm_set1_epi8 ('\n');
+        __m128i const other = _mm_set1_epi8 (colon ? ':' : '\n');
+        while (end - begin >= 16)
+          {
+            __m128i const v =
+              _mm_loadu_si128 (reinterpret_cast<const __m128i*> (begin));
+            int const mask =
+              _mm_movemask_epi8 (_mm_or_si128 (_mm_cmpeq_epi8 (v, lf),
+                                               _mm_cmpeq_epi8 (v, other)));
+            if (mask != 0)
+              return begin + __builtin_ctz (mask);
+            begin += 16;
+          }
+#endif /* ACE_INET_HEADER_SSE2 */
+
+        for (; begin != end; ++begin)
+          {
+            if (*begin == '\n' || (colon && *begin == ':'))
+              return begin;
+          }
+        return end;
+      }
+
+    bool HeaderParser::split_start_line (View& first,
+                                         View& second,
+                                         View& rest) const
+      {
+        const char* p = this->buf_ + this->start_offset_;
+        const char* const end = p + this->start_length_;
+
+        first.data = p;
+        while (p != end && *p != ' ')
+          ++p;
+        first.length = p - first.data;
+        while (p != end && *p == ' ')
+          ++p;
+
+        second.data = p;
+        while (p != end && *p != ' ')
+          ++p;
+        second.length = p - second.data;
+        while (p != end && *p == ' ')
+          ++p;
+
+        rest.data = p;
+        rest.length = end - p;
+        while (rest.length != 0
+               && (rest.data[rest.length - 1] == ' '
+                   || rest.data[rest.length - 1] == '\t'))
+          --rest.length;
+
+        return first.length != 0 && second.length != 0;
+      }
+
+    void HeaderParser::get_value (size_t index, ACE_CString& value) const
+      {
+        const Field& f = this->fields_[index];
+        const char* p = this->buf_ + f.value_offset;
+
+        if (!f.continued)
+          {
+            value.set (p, f.value_length, true);
+            return;
+          }
+
+        // drop the line ends of a continued value
+        value.fast_clear ();
+        const char* const end = p + f.value_length;
+        while (p != end)
+          {
+            const char* q = p;
+            while (q != end && *q != '\r' && *q != '\n')
+              ++q;
+            value.append (p, q - p);
+            while (q != end && (*q == '\r' || *q == '\n'))
+              ++q;
+            p = q;
+          }
+      }
+
+    int HeaderParser::find (const char* name) const
+      {
+        size_t const length = ACE_OS::strlen (name);
+        for (size_t i = 0; i < this->count_; ++i)
+          {
+            const Field& f = this->fields_[i];
+            if (f.name_length == length
+                && ACE_OS::strncasecmp (this->buf_ + f.name_offset,
+                                        name,
+                                        length) == 0)
+              return static_cast<int> (i);
+          }
+        return -1;
+      }
+
+  }
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
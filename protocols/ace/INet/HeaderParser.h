@@ -0,0 +1,180 @@
+// $Id$
+
+/**
+ * @file HeaderParser.h
+ */
+
+#ifndef ACE_INET_HEADER_PARSER_H
+#define ACE_INET_HEADER_PARSER_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/SString.h"
+#include "ace/Array_Base.h"
+#include "ace/INet/INet_Export.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class ACE_Message_Block;
+
+namespace ACE
+  {
+    namespace INet
+      {
+        /**
+        * @class ACE_INet_HeaderParser
+        *
+        * @brief Incremental parser for the head of a message: a start
+        * line followed by header lines and an empty line.
+        *
+        * The parser works on the buffer the head is received into; it
+        * is given the whole buffer received so far each time more data
+        * came in and continues where it stopped.  It copies nothing:
+        * the start line and the names and values of the headers are
+        * views of that buffer, kept in a flat index that is reused by
+        * the next message after reset ().  The views are valid as long
+        * as the buffer last given to parse () is.
+        *
+        * Line ends are found by scanning 16 bytes at a time for LF and
+        * ':' where SSE2 is available.
+        */
+        class ACE_INET_Export HeaderParser
+          {
+            public:
+              /// Part of the buffer parsed.
+              struct View
+                {
+                  const char* data;
+                  size_t length;
+                };
+
+              enum Status
+                {
+                  /// The end of the head was not received yet.
+                  PARSE_INCOMPLETE,
+                  /// The head is complete, header_length () bytes long.
+                  PARSE_COMPLETE,
+                  /// The head is malformed or exceeds the limits.
+                  PARSE_ERROR
+                };
+
+              /// Limits for parsing a head
+              enum Limits
+                {
+                  MAX_NAME_LENGTH     = 256,
+                  MAX_VALUE_LENGTH    = 4096,
+                  DEFAULT_MAX_LENGTH  = 65536,
+                  DEFAULT_MAX_HEADERS = 128
+                };
+
+              /// Constructor; a head longer than @a max_length bytes
+              /// or with more than @a max_headers headers is an error.
+              HeaderParser (size_t max_length = DEFAULT_MAX_LENGTH,
+                            size_t max_headers = DEFAULT_MAX_HEADERS);
+
+              /// Destructor
+              ~HeaderParser ();
+
+              /// Prepare to parse the next message.
+              void reset ();
+
+              /// Parse the head in the @a length bytes at @a buf, which
+              /// start with the bytes given before since reset ().
+              Status parse (const char* buf, size_t length);
+
+              /// Parse the head in the data of @a mb, from its read
+              /// pointer.
+              Status parse (const ACE_Message_Block& mb);
+
+              /// Returns the status of the last parse ().
+              Status status () const;
+
+              /// Returns the length of the head, including the empty line
+              /// ending it, once it is complete; the body starts there.
+              size_t header_length () const;
+
+              /// Returns the start line, without its line end.
+              View start_line () const;
+
+              /// Split the start line into the part up to the first
+              /// space, the part up to the next one and the rest, as in
+              /// "GET / HTTP/1.1" or "HTTP/1.1 200 OK".
+              bool split_start_line (View& first,
+                                     View& second,
+                                     View& rest) const;
+
+              /// Returns the number of headers.
+              size_t count () const;
+
+              /// Returns the name of header <index>.
+              View name (size_t index) const;
+
+              /// Returns the value of header <index>, without the leading
+              /// whitespace.  The value of a header continued on following
+              /// lines includes their line ends.
+              View value (size_t index) const;
+
+              /// Copies the value of header <index> into <value>, joining
+              /// the lines of a continued header.
+              void get_value (size_t index, ACE_CString& value) const;
+
+              /// Returns the index of the first header <name>, compared
+              /// without regard to case, or -1 if there is none.
+              int find (const char* name) const;
+
+            private:
+              struct Field
+                {
+                  size_t name_offset;
+                  size_t name_length;
+                  size_t value_offset;
+                  size_t value_length;
+                  bool continued;
+                };
+
+              Status parse_line (size_t end);
+
+              static const char* scan (const char* begin,
+                                       const char* end,
+                                       bool colon);
+
+              size_t max_length_;
+              size_t max_headers_;
+
+              Status status_;
+
+              const char* buf_;
+
+              /// Offsets of the line being parsed and of its colon,
+              /// and the bytes of the buffer scanned.
+              size_t line_;
+              size_t colon_;
+              bool has_colon_;
+              size_t scanned_;
+
+              bool has_start_;
+              size_t start_offset_;
+              size_t start_length_;
+
+              size_t header_length_;
+
+              ACE_Array_Base<Field> fields_;
+              size_t count_;
+          };
+      }
+  }
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/INet/HeaderParser.inl"
+#endif
+
+#include /**/ "ace/post.h"
+#endif /* ACE_INET_HEADER_PARSER_H */
@@ -0,0 +1,64 @@
+// -*- C++ -*-
+//
+// $Id$
+
+#include "ace/Message_Block.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace ACE
+{
+  namespace INet
+  {
+
+    ACE_INLINE
+    HeaderParser::Status HeaderParser::parse (const ACE_Message_Block& mb)
+      {
+        return this->parse (mb.rd_ptr (), mb.length ());
+      }
+
+    ACE_INLINE
+    HeaderParser::Status HeaderParser::status () const
+      {
+        return this->status_;
+      }
+
+    ACE_INLINE
+    size_t HeaderParser::header_length () const
+      {
+        return this->header_length_;
+      }
+
+    ACE_INLINE
+    HeaderParser::View HeaderParser::start_line () const
+      {
+        View v = { this->buf_ + this->start_offset_, this->start_length_ };
+        return v;
+      }
+
+    ACE_INLINE
+    size_t HeaderParser::count () const
+      {
+        return this->count_;
+      }
+
+    ACE_INLINE
+    HeaderParser::View HeaderParser::name (size_t index) const
+      {
+        const Field& f = this->fields_[index];
+        View v = { this->buf_ + f.name_offset, f.name_length };
+        return v;
+      }
+
+    ACE_INLINE
+    HeaderParser::View HeaderParser::value (size_t index) const
+      {
+        const Field& f = this->fields_[index];
+        View v = { this->buf_ + f.value_offset, f.value_length };
+        return v;
+      }
+
+  }
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -31,7 +31,10 @@ namespace ACE_RMCast
   {
     Element::out_start (out);
 
-    tracker_mgr_.spawn (track_thunk, this);
+    // In the reactive mode the link calls tick () instead.
+    //
+    if (params_.reactor () == 0)
+      tracker_mgr_.spawn (track_thunk, this);
   }
 
   void Acknowledge::
@@ -49,7 +52,7 @@ namespace ACE_RMCast
   }
 
   void Acknowledge::
-  collapse (Queue& q)
+  collapse (Queue& q, Messages* batch)
   {
     // I would normally use iterators in the logic below but ACE_Map_Manager
     // iterates over entries in no particular order so it is pretty much
@@ -67,7 +70,7 @@ namespace ACE_RMCast
       Message_ptr m (e->int_id_.msg ());
       q.unbind (sn);
 
-      in_->recv (m);
+      deliver (m, batch);
     }
 
     q.sn (sn - 1);
@@ -78,62 +81,14 @@ namespace ACE_RMCast
   {
     while (true)
     {
-      Messages msgs;
-
       {
         Lock l (mutex_);
 
         if (stop_)
           break;
-
-        if (hold_.current_size () != 0)
-        {
-          for (Map::iterator i (hold_.begin ()), e (hold_.end ());
-               i != e;
-               ++i)
-          {
-            Queue& q = (*i).int_id_;
-
-            if (q.current_size () == 0) continue;
-
-            track_queue ((*i).ext_id_, q, msgs);
-          }
-        }
-
-        if (--nrtm_timer_ == 0)
-        {
-          nrtm_timer_ = params_.nrtm_timeout ();
-
-          // Send NRTM.
-          //
-          unsigned short max_payload_size (
-            params_.max_packet_size () - max_service_size);
-
-          u32 max_elem (NRTM::max_count (max_payload_size));
-
-          Profile_ptr nrtm (create_nrtm (max_elem));
-
-          if (!nrtm.null ())
-          {
-            Message_ptr m (new Message);
-            m->add (nrtm);
-            msgs.push_back (m);
-
-          }
-        }
       }
 
-      // Send stuff off.
-      //
-      for (Messages::Iterator i (msgs); !i.done (); i.advance ())
-      {
-        Message_ptr* ppm;
-        i.next (ppm);
-
-        //FUZZ: disable check_for_lack_ACE_OS
-        send (*ppm);
-        //FUZZ: enable check_for_lack_ACE_OS
-      }
+      track_once ();
 
       // Go to sleep but watch for "manual cancellation" request.
       //
@@ -163,6 +118,72 @@ namespace ACE_RMCast
     }
   }
 
+  void Acknowledge::
+  tick ()
+  {
+    track_once ();
+
+    Element::tick ();
+  }
+
+  void Acknowledge::
+  track_once ()
+  {
+    Messages msgs;
+
+    {
+      Optional_Lock l (mutex_, !params_.reactor ());
+
+      if (hold_.current_size () != 0)
+      {
+        for (Map::iterator i (hold_.begin ()), e (hold_.end ());
+             i != e;
+             ++i)
+        {
+          Queue& q = (*i).int_id_;
+
+          if (q.current_size () == 0) continue;
+
+          track_queue ((*i).ext_id_, q, msgs);
+        }
+      }
+
+      if (--nrtm_timer_ == 0)
+      {
+        nrtm_timer_ = params_.nrtm_timeout ();
+
+        // Send NRTM.
+        //
+        unsigned short max_payload_size (
+          params_.max_packet_size () - max_service_size);
+
+        u32 max_elem (NRTM::max_count (max_payload_size));
+
+        Profile_ptr nrtm (create_nrtm (max_elem));
+
+        if (nrtm.get () != 0)
+        {
+          Message_ptr m (new Message);
+          m->add (nrtm);
+          msgs.push_back (m);
+
+        }
+      }
+    }
+
+    // Send stuff off.
+    //
+    for (Messages::Iterator i (msgs); !i.done (); i.advance ())
+    {
+      Message_ptr* ppm;
+      i.next (ppm);
+
+      //FUZZ: disable check_for_lack_ACE_OS
+      send (*ppm);
+      //FUZZ: enable check_for_lack_ACE_OS
+    }
+  }
+
   void Acknowledge::
   track_queue (Address const& addr, Queue& q, Messages& msgs)
   {
@@ -241,8 +262,38 @@ namespace ACE_RMCast
     // is why I hold the lock at the beginning (which may be not very
     // efficient).
     //
-    Lock l (mutex_);
+    Optional_Lock l (mutex_, !params_.reactor ());
+
+    if (!order (m, 0))
+    {
+      l.release ();
+
+      // Just forward it up.
+      //
+      in_->recv (m);
+    }
+  }
+
+  void Acknowledge::
+  recv_batch (Messages& ms)
+  {
+    Messages batch;
+
+    Optional_Lock l (mutex_, !params_.reactor ());
+
+    for (size_t i (0); i < ms.size (); ++i)
+    {
+      if (!order (ms[i], &batch))
+        batch.push_back (ms[i]);
+    }
 
+    if (batch.size () != 0)
+      in_->recv_batch (batch);
+  }
+
+  bool Acknowledge::
+  order (Message_ptr m, Messages* batch)
+  {
     if (NRTM const* nrtm = static_cast<NRTM const*> (m->find (NRTM::id)))
     {
       for (Map::iterator i (hold_.begin ()), e (hold_.end ()); i != e; ++i)
@@ -279,7 +330,7 @@ namespace ACE_RMCast
         // First message from this source.
         //
         hold_.bind (from, Queue (sn));
-        in_->recv (m);
+        deliver (m, batch);
       }
       else
       {
@@ -298,7 +349,7 @@ namespace ACE_RMCast
           //
 
           q.rebind (sn, Descr (m));
-          collapse (q);
+          collapse (q, batch);
         }
         else
         {
@@ -307,15 +358,11 @@ namespace ACE_RMCast
           q.rebind (sn, Descr (m));
         }
       }
-    }
-    else
-    {
-      l.release ();
 
-      // Just forward it up.
-      //
-      in_->recv (m);
+      return true;
     }
+
+    return false;
   }
 
   void Acknowledge::send (Message_ptr m)
@@ -332,7 +379,7 @@ namespace ACE_RMCast
 
         if (max_elem > 0)
         {
-          Lock l (mutex_);
+          Optional_Lock l (mutex_, !params_.reactor ());
 
           Profile_ptr nrtm (create_nrtm (max_elem));
 
@@ -40,6 +40,12 @@ namespace ACE_RMCast
     virtual void
     recv (Message_ptr m);
 
+    virtual void
+    recv_batch (Messages& ms);
+
+    virtual void
+    tick ();
+
     virtual void
     send (Message_ptr m);
 
@@ -215,12 +221,21 @@ namespace ACE_RMCast
     Map;
 
   private:
+    // Put a data or no-data message in order, passing the ones that
+    // can go up to deliver (). Return false for other messages.
+    //
+    bool
+    order (Message_ptr m, Messages* batch);
+
     void
-    collapse (Queue& q);
+    collapse (Queue& q, Messages* batch);
 
     void
     track ();
 
+    void
+    track_once ();
+
     void
     track_queue (Address const& addr, Queue& q, Messages& msgs);
 
@@ -16,6 +16,42 @@ namespace ACE_RMCast
   typedef ACE_Guard<Mutex> Lock;
   typedef ACE_Condition<Mutex> Condition;
 // FUZZ: enable check_for_ACE_Guard
+
+  // Lock that only acquires the mutex if asked to. The elements of a
+  // stack running in a reactor (see Parameters::reactor ()) are only
+  // used from its thread and don't lock.
+  //
+  class Optional_Lock
+  {
+  public:
+    Optional_Lock (Mutex& m, bool locking)
+        : m_ (locking ? &m : 0)
+    {
+      if (m_) m_->acquire ();
+    }
+
+    ~Optional_Lock ()
+    {
+      release ();
+    }
+
+    void
+    release ()
+    {
+      if (m_)
+      {
+        m_->release ();
+        m_ = 0;
+      }
+    }
+
+  private:
+    Optional_Lock (Optional_Lock const&);
+    Optional_Lock& operator= (Optional_Lock const&);
+
+  private:
+    Mutex* m_;
+  };
 }
 
 
@@ -28,7 +28,7 @@ namespace ACE_RMCast
     {
       ACE_Time_Value now_time (ACE_OS::gettimeofday ());
 
-      Lock l (mutex_);
+      Optional_Lock l (mutex_, !params_.reactor ());
       sample_bytes_ += data->size ();
 
       if (sample_start_time_ == ACE_Time_Value (0, 0))
@@ -81,8 +81,10 @@ namespace ACE_RMCast
         time.tv_nsec = static_cast<unsigned long> (dev * 500000.0);
 
         // Don't bother to sleep if the time is less than 10 usec.
+        // Never sleep in the reactive mode, where it would hold up the
+        // reactor's thread and every other socket it runs.
         //
-        if (time.tv_nsec > 10000)
+        if (time.tv_nsec > 10000 && params_.reactor () == 0)
           ACE_OS::sleep (ACE_Time_Value (time));
       }
     }
@@ -91,6 +93,23 @@ namespace ACE_RMCast
   }
 
   void Flow::recv (Message_ptr m)
+  {
+    handle_nak (m);
+
+    in_->recv (m);
+  }
+
+  void Flow::
+  recv_batch (Messages& ms)
+  {
+    for (size_t i (0); i < ms.size (); ++i)
+      handle_nak (ms[i]);
+
+    in_->recv_batch (ms);
+  }
+
+  void Flow::
+  handle_nak (Message_ptr const& m)
   {
     if (NAK const* nak = static_cast<NAK const*> (m->find (NAK::id)))
     {
@@ -108,7 +127,7 @@ namespace ACE_RMCast
 
         ACE_Time_Value nak_time (ACE_OS::gettimeofday ());
 
-        Lock l (mutex_);
+        Optional_Lock l (mutex_, !params_.reactor ());
 
         nak_time_ = nak_time;
 
@@ -123,8 +142,6 @@ namespace ACE_RMCast
         }
       }
     }
-
-    in_->recv (m);
   }
 }
 
@@ -23,6 +23,13 @@ namespace ACE_RMCast
     virtual void
     recv (Message_ptr m);
 
+    virtual void
+    recv_batch (Messages& ms);
+
+  private:
+    void
+    handle_nak (Message_ptr const& m);
+
   private:
     Parameters const& params_;
 
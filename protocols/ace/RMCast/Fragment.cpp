@@ -29,7 +29,7 @@ namespace ACE_RMCast
       {
         u64 sn;
         {
-          Lock l (mutex_);
+          Optional_Lock l (mutex_, !params_.reactor ());
           sn = sn_++;
         }
 
@@ -39,7 +39,7 @@ namespace ACE_RMCast
         return;
       }
 
-      char const* p = data->buf ();
+      size_t offset (0);
       size_t size (data->size ());
 
       // Need fragmentation.
@@ -59,17 +59,19 @@ namespace ACE_RMCast
 
         u64 sn;
         {
-          Lock l (mutex_);
+          Optional_Lock l (mutex_, !params_.reactor ());
           sn = sn_++;
         }
 
         part->add (Profile_ptr (new SN (sn)));
         part->add (Profile_ptr (new Part (i, packets, size)));
-        part->add (Profile_ptr (new Data (p, s)));
+        // The parts refer to the data of the message.
+        //
+        part->add (Profile_ptr (new Data (*data, offset, s)));
 
         out_->send (part);
 
-        p += s;
+        offset += s;
       }
     }
   }
@@ -6,6 +6,8 @@
 #include "ace/OS_NS_stdlib.h"
 #include "ace/OS_NS_time.h"
 #include "ace/OS_NS_sys_socket.h"
+#include "ace/Message_Block.h"
+#include "ace/Reactor.h"
 
 #include "Link.h"
 
@@ -16,11 +18,18 @@ namespace ACE_RMCast
   {
     ssock_.close ();
     rsock_.close ();
+
+    for (size_t i (0); i < ACE_RMCAST_DEFAULT_BATCH_SIZE; ++i)
+    {
+      if (blocks_[i])
+        blocks_[i]->release ();
+    }
   }
 
   Link::
   Link (Address const& addr, Parameters const& params)
-      : params_ (params),
+      : ACE_Event_Handler (params.reactor ()),
+        params_ (params),
         addr_ (addr),
         ssock_ (Address (static_cast<unsigned short> (0),
                          static_cast<ACE_UINT32> (INADDR_ANY)),
@@ -70,6 +79,16 @@ namespace ACE_RMCast
     ssock_.get_local_addr (self_);
 
     //cerr << 5 << "self: " << self_ << endl;
+
+    // Buffers to receive batches of messages in.
+    //
+    for (size_t i (0); i < ACE_RMCAST_DEFAULT_BATCH_SIZE; ++i)
+    {
+      blocks_[i] = 0;
+
+      if (params_.reactor ())
+        renew (blocks_[i]);
+    }
   }
 
   void Link::
@@ -79,9 +98,26 @@ namespace ACE_RMCast
 
     rsock_.join (addr_);
 
-    // Start receiving thread.
-    //
-    recv_mgr_.spawn (recv_thunk, this);
+    if (ACE_Reactor* r = params_.reactor ())
+    {
+      // Receive and drive the timers of the stack in the reactor's
+      // event loop.
+      //
+      rsock_.enable (ACE_NONBLOCK);
+
+      if (r->register_handler (this, ACE_Event_Handler::READ_MASK) == -1 ||
+          r->schedule_timer (this, 0, params_.tick (), params_.tick ()) == -1)
+      {
+        ACE_OS::perror ("register_handler: ");
+        ACE_OS::abort ();
+      }
+    }
+    else
+    {
+      // Start receiving thread.
+      //
+      recv_mgr_.spawn (recv_thunk, this);
+    }
   }
 
   void Link::
@@ -93,13 +129,23 @@ namespace ACE_RMCast
   void Link::
   in_stop ()
   {
-    // Stop receiving thread.
-    //
+    if (ACE_Reactor* r = params_.reactor ())
     {
-      Lock l (mutex_);
-      stop_ = true;
+      r->cancel_timer (this);
+      r->remove_handler (this,
+                         ACE_Event_Handler::READ_MASK |
+                         ACE_Event_Handler::DONT_CALL);
+    }
+    else
+    {
+      // Stop receiving thread.
+      //
+      {
+        Lock l (mutex_);
+        stop_ = true;
+      }
+      recv_mgr_.wait ();
     }
-    recv_mgr_.wait ();
 
     Element::in_stop ();
   }
@@ -112,7 +158,7 @@ namespace ACE_RMCast
     {
       if ((ACE_OS::rand () % 17) != 0)
       {
-        Lock l (mutex_);
+        Optional_Lock l (mutex_, !params_.reactor ());
 
         if (hold_.get ())
         {
@@ -156,17 +202,20 @@ namespace ACE_RMCast
 
     os << *m;
 
-    if (os.length () > size_t (params_.max_packet_size ()))
+    if (os.total_length () > size_t (params_.max_packet_size ()))
     {
       ACE_ERROR ((LM_ERROR,
                   "packet length (%d) exceeds max_poacket_size (%d)\n",
-                  os.length (), params_.max_packet_size ()));
+                  os.total_length (), params_.max_packet_size ()));
 
-      for (Message::ProfileIterator i (m->begin ()); !i.done (); i.advance ())
+      for (u16 id (0); id < profile_slots; ++id)
       {
-        ACE_ERROR ((LM_ERROR,
-                    "profile id: %d; size: %d\n",
-                    (*i).ext_id_, (*i).int_id_->size ()));
+        if (Profile const* p = m->find (id))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      "profile id: %d; size: %d\n",
+                      id, p->size ()));
+        }
       }
 
       ACE_OS::abort ();
@@ -187,9 +236,7 @@ namespace ACE_RMCast
   {
     size_t max_packet_size (params_.max_packet_size ());
 
-    ACE_Auto_Array_Ptr<char> holder (new char[max_packet_size + ACE_CDR::MAX_ALIGNMENT]);
-
-    char* data = ACE_ptr_align_binary (holder.get (), ACE_CDR::MAX_ALIGNMENT);
+    ACE_Message_Block* mb (0);
 
     size_t size (0);
 
@@ -198,6 +245,12 @@ namespace ACE_RMCast
       //@@ Should I lock here?
       //
 
+      // The messages parsed from the packet refer to its data.
+      //
+      renew (mb);
+
+      char* data (mb->wr_ptr ());
+
       Address addr;
 
       // Block for up to one tick waiting for an incomming message.
@@ -213,7 +266,10 @@ namespace ACE_RMCast
         {
           Lock l (mutex_);
           if (stop_)
+          {
+            mb->release ();
             return;
+          }
         }
 
         if (r == -1)
@@ -263,59 +319,160 @@ namespace ACE_RMCast
 
       //cerr << 6 << "from: " << addr << endl;
 
-      Message_ptr m (new Message ());
+      mb->wr_ptr (size);
 
-      m->add (Profile_ptr (new From (addr)));
-      m->add (Profile_ptr (new To (self_)));
+      in_->recv (parse (mb, addr));
+    }
+  }
 
-      istream is (data, size, 1); // Always little-endian.
+  void Link::
+  renew (ACE_Message_Block*& mb)
+  {
+    if (mb == 0 || mb->data_block ()->reference_count () > 1)
+    {
+      if (mb != 0)
+        mb->release ();
+
+      mb = new ACE_Message_Block (
+        params_.max_packet_size () + ACE_CDR::MAX_ALIGNMENT,
+        ACE_Message_Block::MB_DATA,
+        0,
+        0,
+        0,
+        params_.reactor () ? 0 : Data::block_lock ());
+    }
 
-      is >> msg_size;
+    mb->reset ();
+    ACE_CDR::mb_align (mb);
+  }
 
-      while (true)
-      {
-        u16 id, size;
+  Message_ptr Link::
+  parse (ACE_Message_Block const* mb, Address const& addr)
+  {
+    Message_ptr m (new Message ());
 
-        if (!((is >> id) && (is >> size))) break;
+    m->add (Profile_ptr (new From (addr)));
+    m->add (Profile_ptr (new To (self_)));
 
-        //cerr << 6 << "reading profile with id " << id << " "
-        //     << size << " bytes long" << endl;
+    // The stream shares the data block with the profiles that refer
+    // to the packet.
+    //
+    istream is (mb->data_block ()->duplicate (),
+                0,
+                mb->rd_ptr () - mb->base (),
+                mb->wr_ptr () - mb->base (),
+                1); // Always little-endian.
 
-        Profile::Header hdr (id, size);
+    u32 msg_size;
+    is >> msg_size;
 
-        if (id == SN::id)
-          {
-            m->add (Profile_ptr (new SN (hdr, is)));
-          }
-        else if (id == Data::id)
-          {
-            m->add (Profile_ptr (new Data (hdr, is)));
-          }
-        else if (id == NAK::id)
-          {
-            m->add (Profile_ptr (new NAK (hdr, is)));
-          }
-        else if (id == NRTM::id)
-          {
-            m->add (Profile_ptr (new NRTM (hdr, is)));
-          }
-        else if (id == NoData::id)
-          {
-            m->add (Profile_ptr (new NoData (hdr, is)));
-          }
-        else if (id == Part::id)
-          {
-            m->add (Profile_ptr (new Part (hdr, is)));
-          }
-        else
-          {
-            //cerr << 0 << "unknown profile id " << hdr.id () << endl;
-            ACE_OS::abort ();
-          }
+    while (true)
+    {
+      u16 id, size;
+
+      if (!((is >> id) && (is >> size))) break;
+
+      //cerr << 6 << "reading profile with id " << id << " "
+      //     << size << " bytes long" << endl;
+
+      Profile::Header hdr (id, size);
+
+      if (id == SN::id)
+        {
+          m->add (Profile_ptr (new SN (hdr, is)));
+        }
+      else if (id == Data::id)
+        {
+          m->add (Profile_ptr (new Data (hdr, is)));
+        }
+      else if (id == NAK::id)
+        {
+          m->add (Profile_ptr (new NAK (hdr, is)));
+        }
+      else if (id == NRTM::id)
+        {
+          m->add (Profile_ptr (new NRTM (hdr, is)));
+        }
+      else if (id == NoData::id)
+        {
+          m->add (Profile_ptr (new NoData (hdr, is)));
+        }
+      else if (id == Part::id)
+        {
+          m->add (Profile_ptr (new Part (hdr, is)));
+        }
+      else
+        {
+          //cerr << 0 << "unknown profile id " << hdr.id () << endl;
+          ACE_OS::abort ();
+        }
+    }
+
+    return m;
+  }
+
+  ACE_HANDLE Link::
+  get_handle () const
+  {
+    return rsock_.get_handle ();
+  }
+
+  int Link::
+  handle_input (ACE_HANDLE)
+  {
+    for (size_t i (0); i < ACE_RMCAST_DEFAULT_BATCH_SIZE; ++i)
+      renew (blocks_[i]);
+
+    ssize_t n (rsock_.recv_batch (blocks_,
+                                  addrs_,
+                                  0,
+                                  ACE_RMCAST_DEFAULT_BATCH_SIZE));
+
+    if (n == -1)
+    {
+      if (errno != EWOULDBLOCK && errno != EINTR)
+        ACE_OS::abort ();
+
+      return 0;
+    }
+
+    Messages batch;
+
+    for (ssize_t i (0); i < n; ++i)
+    {
+      char const* data (blocks_[i]->rd_ptr ());
+      size_t size (blocks_[i]->length ());
+
+      // Discard bad messages, including the ones cut to the size of
+      // the buffer, and ones from ourselves since we are using
+      // reliable loopback.
+      //
+      if (size <= 4 || addrs_[i] == self_)
+        continue;
+
+      u32 msg_size;
+      {
+        istream is (data, size, 1); // Always little-endian.
+        is >> msg_size;
       }
 
-      in_->recv (m);
+      if (msg_size != size)
+        continue;
+
+      batch.push_back (parse (blocks_[i], addrs_[i]));
     }
+
+    if (batch.size () != 0)
+      in_->recv_batch (batch);
+
+    return 0;
+  }
+
+  int Link::
+  handle_timeout (ACE_Time_Value const&, void const*)
+  {
+    in_->tick ();
+    return 0;
   }
 
   ACE_THR_FUNC_RETURN Link::
@@ -329,4 +486,10 @@ namespace ACE_RMCast
   {
     ACE_OS::abort ();
   }
+
+  void Link::
+  recv_batch (Messages&)
+  {
+    ACE_OS::abort ();
+  }
 }
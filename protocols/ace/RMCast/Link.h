@@ -7,15 +7,30 @@
 #include "ace/SOCK_Dgram.h"
 #include "ace/SOCK_Dgram_Mcast.h"
 
+#include "ace/Event_Handler.h"
 #include "ace/Thread_Manager.h"
 
 #include "Stack.h"
 #include "Protocol.h"
 #include "Parameters.h"
 
+#if !defined (ACE_RMCAST_DEFAULT_BATCH_SIZE)
+#define ACE_RMCAST_DEFAULT_BATCH_SIZE 16
+#endif /* ACE_RMCAST_DEFAULT_BATCH_SIZE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ACE_Message_Block;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
 namespace ACE_RMCast
 {
-  class Link : public Element
+  // In the reactive mode (see Parameters::reactor ()) the link is an
+  // event handler of the reactor: it receives up to
+  // ACE_RMCAST_DEFAULT_BATCH_SIZE datagrams at a time and passes them
+  // up the stack in one batch, and calls tick () up the stack on a
+  // timer. Otherwise it receives in a thread of its own.
+  //
+  class Link : public Element, public ACE_Event_Handler
   {
   public:
     ~Link ();
@@ -35,10 +50,29 @@ namespace ACE_RMCast
     virtual void
     send (Message_ptr m);
 
+  public:
+    virtual ACE_HANDLE
+    get_handle () const;
+
+    virtual int
+    handle_input (ACE_HANDLE);
+
+    virtual int
+    handle_timeout (ACE_Time_Value const&, void const*);
+
   private:
     virtual void
     send_ (Message_ptr m);
 
+    // Makes mb ready to receive a packet into, replacing it while
+    // messages refer to its data.
+    //
+    void
+    renew (ACE_Message_Block*& mb);
+
+    Message_ptr
+    parse (ACE_Message_Block const* mb, Address const& addr);
+
   private:
     void
     recv ();
@@ -50,6 +84,9 @@ namespace ACE_RMCast
     virtual void
     recv (Message_ptr);
 
+    virtual void
+    recv_batch (Messages&);
+
   private:
     Parameters const& params_;
 
@@ -60,6 +97,11 @@ namespace ACE_RMCast
     bool stop_;
     ACE_Thread_Manager recv_mgr_;
 
+    // Reactive mode.
+    //
+    ACE_Message_Block* blocks_[ACE_RMCAST_DEFAULT_BATCH_SIZE];
+    Address addrs_[ACE_RMCAST_DEFAULT_BATCH_SIZE];
+
     // Simulator.
     //
     Message_ptr hold_;
@@ -6,6 +6,10 @@
 
 #include "ace/Time_Value.h"
 
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ACE_Reactor;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
 
 namespace ACE_RMCast
 {
@@ -38,7 +42,14 @@ namespace ACE_RMCast
       //
       unsigned long retention_timeout = 500,  // 1 sec
 
-      size_t addr_map_size = 50
+      size_t addr_map_size = 50,
+
+      // Reactor to run the protocol in. If not 0, the socket uses no
+      // threads of its own: datagrams are received and the timers run
+      // in the reactor's event loop, and the socket may only be used
+      // from there (see Socket).
+      //
+      ACE_Reactor* reactor = 0
     )
         : simulator_ (simulator),
           max_packet_size_ (max_packet_size),
@@ -46,7 +57,8 @@ namespace ACE_RMCast
           nak_timeout_ (nak_timeout),
           nrtm_timeout_ (nrtm_timeout),
           retention_timeout_ (retention_timeout),
-          addr_map_size_(addr_map_size)
+          addr_map_size_(addr_map_size),
+          reactor_ (reactor)
     {
     }
 
@@ -93,6 +105,12 @@ namespace ACE_RMCast
       return addr_map_size_;
     }
 
+    ACE_Reactor*
+    reactor () const
+    {
+      return reactor_;
+    }
+
   private:
     bool simulator_;
     unsigned short max_packet_size_;
@@ -101,6 +119,7 @@ namespace ACE_RMCast
     unsigned long nrtm_timeout_;
     unsigned long retention_timeout_;
     size_t addr_map_size_;
+    ACE_Reactor* reactor_;
   };
 }
 
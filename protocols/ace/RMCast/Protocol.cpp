@@ -1,6 +1,8 @@
 // author    : Boris Kolpackov <boris@kolpackov.net>
 // $Id$
 
+#include "ace/Lock_Adapter_T.h"
+
 #include "Protocol.h"
 
 namespace ACE_RMCast
@@ -13,4 +15,15 @@ namespace ACE_RMCast
   u16 const NRTM::  id = 0x0006;
   u16 const NoData::id = 0x0007;
   u16 const Part::  id = 0x0008;
+
+  namespace
+  {
+    ACE_Lock_Adapter<Mutex> block_lock_;
+  }
+
+  ACE_Lock* Data::
+  block_lock ()
+  {
+    return &block_lock_;
+  }
 }
@@ -5,10 +5,12 @@
 #define ACE_RMCAST_PROTOCOL_H
 
 #include "ace/Auto_Ptr.h"
-#include "ace/Bound_Ptr.h"
+#include "ace/Intrusive_Auto_Ptr.h"
+#include "ace/Atomic_Op.h"
 
 #include "ace/Vector_T.h"
 #include "ace/Hash_Map_Manager.h"
+#include "ace/Message_Block.h"
 
 #include "ace/CDR_Stream.h"
 #include "ace/CDR_Size.h"
@@ -35,6 +37,8 @@ namespace ACE_RMCast
   unsigned short const max_service_size = 60;  // service profiles (Part, SN,
                                                // etc), sizes plus message size.
 
+  unsigned short const profile_slots = 16; // Profile ids are below this.
+
   //
   //
   //
@@ -64,7 +68,7 @@ namespace ACE_RMCast
   struct Profile;
 
   typedef
-  ACE_Strong_Bound_Ptr<Profile, Mutex>
+  ACE_Intrusive_Auto_Ptr<Profile>
   Profile_ptr;
 
   struct Profile
@@ -123,14 +127,38 @@ namespace ACE_RMCast
       return p;
     }
 
+    // Profiles are counted in place, saving Profile_ptr the separate
+    // counter (and its lock) ACE_Strong_Bound_Ptr allocates.
+    //
+    static void
+    intrusive_add_ref (Profile* p)
+    {
+      if (p != 0)
+        ++p->ref_count_;
+    }
+
+    static void
+    intrusive_remove_ref (Profile* p)
+    {
+      if (p != 0 && --p->ref_count_ == 0)
+        delete p;
+    }
+
   protected:
     Profile (u16 id)
-        : header_ (id, 0)
+        : ref_count_ (0), header_ (id, 0)
     {
     }
 
     Profile (Header const& h)
-        : header_ (h)
+        : ref_count_ (0), header_ (h)
+    {
+    }
+
+    // A copy starts out unreferenced.
+    //
+    Profile (Profile const& p)
+        : ref_count_ (0), header_ (p.header_)
     {
     }
 
@@ -187,6 +215,7 @@ namespace ACE_RMCast
     operator<< (sstream& ss, Profile const& p);
 
   private:
+    ACE_Atomic_Op<Mutex, long> ref_count_;
     Header header_;
   };
 
@@ -237,18 +266,14 @@ namespace ACE_RMCast
   class Message;
 
   typedef
-  ACE_Strong_Bound_Ptr<Message, Mutex>
+  ACE_Intrusive_Auto_Ptr<Message>
   Message_ptr;
 
   class Message
   {
-    typedef
-    ACE_Hash_Map_Manager<u16, Profile_ptr, ACE_Null_Mutex>
-    Profiles;
-
   public:
     Message ()
-        : profiles_ (4)
+        : ref_count_ (0)
     {
     }
 
@@ -259,16 +284,30 @@ namespace ACE_RMCast
       return cloned;
     }
 
+    static void
+    intrusive_add_ref (Message* m)
+    {
+      if (m != 0)
+        ++m->ref_count_;
+    }
+
+    static void
+    intrusive_remove_ref (Message* m)
+    {
+      if (m != 0 && --m->ref_count_ == 0)
+        delete m;
+    }
+
   protected:
     Message (Message const& m)
-        : profiles_ (4)
+        : ref_count_ (0)
     {
-      for (Profiles::const_iterator i (m.profiles_); !i.done (); i.advance ())
+      // Shallow copy of profiles. This implies that profiles are not
+      // modified as they go up/down the stack.
+      //
+      for (u16 id (0); id < profile_slots; ++id)
       {
-        // Shallow copy of profiles. This implies that profiles are not
-        // modified as they go up/down the stack.
-        //
-        profiles_.bind ((*i).ext_id_, (*i).int_id_);
+        profiles_[id] = m.profiles_[id];
       }
     }
 
@@ -282,12 +321,15 @@ namespace ACE_RMCast
     {
       u16 id (p->id ());
 
-      if (profiles_.find (id) == 0)
+      if (id >= profile_slots)
+        ACE_OS::abort ();
+
+      if (profiles_[id].get () != 0)
       {
         return false;
       }
 
-      profiles_.bind (id, p);
+      profiles_[id] = p;
 
       return true;
     }
@@ -295,33 +337,27 @@ namespace ACE_RMCast
     void
     replace (Profile_ptr p)
     {
-      profiles_.rebind (p->id (), p);
+      u16 id (p->id ());
+
+      if (id >= profile_slots)
+        ACE_OS::abort ();
+
+      profiles_[id] = p;
     }
 
     void
     remove (u16 id)
     {
-      profiles_.unbind (id);
+      if (id < profile_slots)
+        profiles_[id] = Profile_ptr ();
     }
 
     Profile const*
     find (u16 id) const
     {
-      Profiles::ENTRY* e = 0;
+      if (id >= profile_slots) return 0;
 
-      if (profiles_.find (id, e) == -1) return 0;
-
-      return e->int_id_.get ();
-    }
-
-    typedef
-    Profiles::const_iterator
-    ProfileIterator;
-
-    ProfileIterator
-    begin () const
-    {
-      return ProfileIterator (profiles_);
+      return profiles_[id].get ();
     }
 
   public:
@@ -334,9 +370,10 @@ namespace ACE_RMCast
 
       ss << s;
 
-      for (Profiles::const_iterator i (profiles_); !i.done (); i.advance ())
+      for (u16 id (0); id < profile_slots; ++id)
       {
-        ss << *((*i).int_id_);
+        if (profiles_[id].get () != 0)
+          ss << *(profiles_[id]);
       }
 
       return ss.total_length ();
@@ -350,16 +387,23 @@ namespace ACE_RMCast
 
       os << s;
 
-      for (Profiles::const_iterator i (m.profiles_); !i.done (); i.advance ())
+      for (u16 id (0); id < profile_slots; ++id)
       {
-        os << *((*i).int_id_);
+        if (m.profiles_[id].get () != 0)
+          os << *(m.profiles_[id]);
       }
 
       return os;
     }
 
   private:
-    Profiles profiles_;
+    ACE_Atomic_Op<Mutex, long> ref_count_;
+
+    // Profiles indexed by id. The ids are small and a message carries
+    // a handful of them so a table beats a hash map that allocates
+    // for every entry.
+    //
+    Profile_ptr profiles_[profile_slots];
   };
 
   typedef ACE_Vector<Message_ptr, ACE_VECTOR_DEFAULT_SIZE> Messages;
@@ -370,7 +414,7 @@ namespace ACE_RMCast
   struct From;
 
   typedef
-  ACE_Strong_Bound_Ptr<From, Mutex>
+  ACE_Intrusive_Auto_Ptr<From>
   From_ptr;
 
   struct From : Profile
@@ -399,7 +443,7 @@ namespace ACE_RMCast
     From_ptr
     clone ()
     {
-      return From_ptr (clone_ ());
+      return From_ptr (static_cast<From*> (clone_ ().get ()));
     }
 
   protected:
@@ -455,7 +499,7 @@ namespace ACE_RMCast
   struct To;
 
   typedef
-  ACE_Strong_Bound_Ptr<To, Mutex>
+  ACE_Intrusive_Auto_Ptr<To>
   To_ptr;
 
   struct To : Profile
@@ -484,7 +528,7 @@ namespace ACE_RMCast
     To_ptr
     clone ()
     {
-      return To_ptr (clone_ ());
+      return To_ptr (static_cast<To*> (clone_ ().get ()));
     }
 
   protected:
@@ -540,7 +584,7 @@ namespace ACE_RMCast
   struct Data;
 
   typedef
-  ACE_Strong_Bound_Ptr<Data, Mutex>
+  ACE_Intrusive_Auto_Ptr<Data>
   Data_ptr;
 
   struct Data : Profile
@@ -551,33 +595,78 @@ namespace ACE_RMCast
     virtual
     ~Data ()
     {
-      if (buf_)
-        operator delete (buf_);
+      ACE_Message_Block::release (mb_);
     }
 
+    // Refers to the payload in the stream's data block instead of
+    // copying it, unless the block belongs to somebody else.
+    //
     Data (Header const& h, istream& is)
         : Profile (h),
-          buf_ (0),
-          size_ (h.size ()),
-          capacity_ (size_)
+          mb_ (0),
+          size_ (h.size ())
     {
       if (size_)
       {
-        buf_ = reinterpret_cast<char*> (operator new (capacity_));
-        is.read_char_array (buf_, size_);
+        ACE_Message_Block const* b (is.start ());
+
+        if (b->data_block () != 0 &&
+            !ACE_BIT_ENABLED (b->flags (), ACE_Message_Block::DONT_DELETE) &&
+            size_ <= is.length ())
+        {
+          mb_ = new ACE_Message_Block (b->data_block ()->duplicate ());
+          mb_->rd_ptr (is.rd_ptr ());
+          mb_->wr_ptr (mb_->rd_ptr () + size_);
+
+          is.skip_bytes (size_);
+        }
+        else
+        {
+          mb_ = new ACE_Message_Block (size_);
+          is.read_char_array (mb_->wr_ptr (), size_);
+          mb_->wr_ptr (size_);
+        }
       }
     }
 
-    Data (void const* buf, size_t s, size_t capacity = 0)
+    // Copies the buffer. Data blocks that are shared between threads
+    // need a lock for their reference count (see block_lock ()).
+    //
+    Data (void const* buf, size_t s, ACE_Lock* lock = 0)
         : Profile (id),
-          buf_ (0),
-          size_ (s),
-          capacity_ (capacity < size_ ? size_ : capacity)
+          mb_ (0),
+          size_ (s)
     {
       if (size_)
       {
-        buf_ = reinterpret_cast<char*> (operator new (capacity_));
-        ACE_OS::memcpy (buf_, buf, size_);
+        mb_ = new ACE_Message_Block (size_,
+                                     ACE_Message_Block::MB_DATA,
+                                     0,
+                                     0,
+                                     0,
+                                     lock);
+        mb_->copy (static_cast<char const*> (buf), size_);
+      }
+
+      Profile::size (calculate_size ());
+    }
+
+    // Refers to s bytes of d starting at offset. They have to be in
+    // the first block of d.
+    //
+    Data (Data const& d, size_t offset, size_t s)
+        : Profile (id),
+          mb_ (0),
+          size_ (s)
+    {
+      if (size_)
+      {
+        if (d.mb_ == 0 || offset + size_ > d.mb_->length ())
+          ACE_OS::abort ();
+
+        mb_ = new ACE_Message_Block (d.mb_->data_block ()->duplicate ());
+        mb_->rd_ptr (d.mb_->rd_ptr () + offset);
+        mb_->wr_ptr (mb_->rd_ptr () + size_);
       }
 
       Profile::size (calculate_size ());
@@ -586,9 +675,14 @@ namespace ACE_RMCast
     Data_ptr
     clone ()
     {
-      return Data_ptr (clone_ ());
+      return Data_ptr (static_cast<Data*> (clone_ ().get ()));
     }
 
+    // Lock for data blocks of sockets with threads of their own.
+    //
+    static ACE_Lock*
+    block_lock ();
+
   protected:
     virtual Profile_ptr
     clone_ ()
@@ -599,72 +693,91 @@ namespace ACE_RMCast
 
     Data (Data const& d)
         : Profile (d),
-          buf_ (0),
-          size_ (d.size_),
-          capacity_ (d.capacity_)
+          mb_ (d.mb_ == 0 ? 0 : d.mb_->duplicate ()),
+          size_ (d.size_)
     {
-      if (size_)
-      {
-        buf_ = reinterpret_cast<char*> (operator new (capacity_));
-        ACE_OS::memcpy (buf_, d.buf_, size_);
-      }
-
-      Profile::size (calculate_size ());
     }
 
   public:
-    char const*
-    buf () const
-    {
-      return buf_;
-    }
-
-    char*
-    buf ()
-    {
-      return buf_;
-    }
-
     size_t
     size () const
     {
       return size_;
     }
 
+    // Chains the blocks of d after ours.
+    //
     void
-    size (size_t s)
+    append (Data const& d)
     {
-      if (s > capacity_)
-        ACE_OS::abort ();
+      if (d.mb_ == 0)
+        return;
 
-      size_ = s;
+      ACE_Message_Block* mb (d.mb_->duplicate ());
+
+      if (mb_ == 0)
+      {
+        mb_ = mb;
+      }
+      else
+      {
+        ACE_Message_Block* last (mb_);
+
+        while (last->cont () != 0)
+          last = last->cont ();
+
+        last->cont (mb);
+      }
+
+      size_ += d.size_;
 
       Profile::size (calculate_size ());
     }
 
+    // Copies up to s bytes into buf, returns the number copied.
+    //
     size_t
-    capacity () const
+    copy (void* buf, size_t s) const
     {
-      return capacity_;
+      char* p (static_cast<char*> (buf));
+      size_t n (0);
+
+      for (ACE_Message_Block const* b (mb_); b != 0 && n < s; b = b->cont ())
+      {
+        size_t l (b->length ());
+
+        if (l > s - n)
+          l = s - n;
+
+        ACE_OS::memcpy (p + n, b->rd_ptr (), l);
+        n += l;
+      }
+
+      return n;
     }
 
   public:
     virtual void
     serialize_body (ostream& os) const
     {
-      os.write_char_array (buf_, size_);
+      for (ACE_Message_Block const* b (mb_); b != 0; b = b->cont ())
+      {
+        os.write_char_array (b->rd_ptr (), b->length ());
+      }
     }
 
     virtual void
     serialize_body (sstream& ss) const
     {
-      ss.write_char_array (buf_, size_);
+      for (ACE_Message_Block const* b (mb_); b != 0; b = b->cont ())
+      {
+        ss.write_char_array (b->rd_ptr (), b->length ());
+      }
     }
 
   private:
-    char* buf_;
+    ACE_Message_Block* mb_;
     size_t size_;
-    size_t capacity_;
   };
 
 
@@ -674,7 +787,7 @@ namespace ACE_RMCast
   struct SN;
 
   typedef
-  ACE_Strong_Bound_Ptr<SN, Mutex>
+  ACE_Intrusive_Auto_Ptr<SN>
   SN_ptr;
 
   struct SN : Profile
@@ -697,7 +810,7 @@ namespace ACE_RMCast
     SN_ptr
     clone ()
     {
-      return SN_ptr (clone_ ());
+      return SN_ptr (static_cast<SN*> (clone_ ().get ()));
     }
 
   protected:
@@ -745,7 +858,7 @@ namespace ACE_RMCast
   class NAK;
 
   typedef
-  ACE_Strong_Bound_Ptr<NAK, Mutex>
+  ACE_Intrusive_Auto_Ptr<NAK>
   NAK_ptr;
 
   class NAK : public Profile
@@ -801,7 +914,7 @@ namespace ACE_RMCast
     NAK_ptr
     clone ()
     {
-      return NAK_ptr (clone_ ());
+      return NAK_ptr (static_cast<NAK*> (clone_ ().get ()));
     }
 
   protected:
@@ -942,7 +1055,7 @@ namespace ACE_RMCast
   struct NRTM;
 
   typedef
-  ACE_Strong_Bound_Ptr<NRTM, Mutex>
+  ACE_Intrusive_Auto_Ptr<NRTM>
   NRTM_ptr;
 
   struct NRTM : Profile
@@ -987,7 +1100,7 @@ namespace ACE_RMCast
     NRTM_ptr
     clone ()
     {
-      return NRTM_ptr (clone_ ());
+      return NRTM_ptr (static_cast<NRTM*> (clone_ ().get ()));
     }
 
   protected:
@@ -1117,7 +1230,7 @@ namespace ACE_RMCast
   struct NoData;
 
   typedef
-  ACE_Strong_Bound_Ptr<NoData, Mutex>
+  ACE_Intrusive_Auto_Ptr<NoData>
   NoData_ptr;
 
   struct NoData : Profile
@@ -1139,7 +1252,7 @@ namespace ACE_RMCast
     NoData_ptr
     clone ()
     {
-      return NoData_ptr (clone_ ());
+      return NoData_ptr (static_cast<NoData*> (clone_ ().get ()));
     }
 
   protected:
@@ -1174,7 +1287,7 @@ namespace ACE_RMCast
   struct Part;
 
   typedef
-  ACE_Strong_Bound_Ptr<Part, Mutex>
+  ACE_Intrusive_Auto_Ptr<Part>
   Part_ptr;
 
   struct Part : Profile
@@ -1202,7 +1315,7 @@ namespace ACE_RMCast
     Part_ptr
     clone ()
     {
-      return Part_ptr (clone_ ());
+      return Part_ptr (static_cast<Part*> (clone_ ().get ()));
     }
 
   protected:
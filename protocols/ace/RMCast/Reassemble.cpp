@@ -13,6 +13,24 @@ namespace ACE_RMCast
   }
 
   void Reassemble::recv (Message_ptr m)
+  {
+    reassemble (m, 0);
+  }
+
+  void Reassemble::
+  recv_batch (Messages& ms)
+  {
+    Messages batch;
+
+    for (size_t i (0); i < ms.size (); ++i)
+      reassemble (ms[i], &batch);
+
+    if (batch.size () != 0)
+      in_->recv_batch (batch);
+  }
+
+  void Reassemble::
+  reassemble (Message_ptr m, Messages* batch)
   {
     Map::ENTRY* e = 0;
     Address from (
@@ -34,9 +52,9 @@ namespace ACE_RMCast
             return;
           }
 
-          Data_ptr new_data (new Data (data->buf (),
-                                       static_cast<size_t> (data->size ()),
-                                       static_cast<size_t> (part->total_size ())));
+          // The message refers to the data of its parts.
+          //
+          Data_ptr new_data (new Data (*data, 0, data->size ()));
 
           //std::cerr << "part->total_size (): " << part->total_size () << endl;
 
@@ -55,15 +73,7 @@ namespace ACE_RMCast
 
           Data_ptr& new_data = e->int_id_;
 
-          ACE_OS::memcpy (new_data->buf () + new_data->size (),
-                          data->buf (),
-                          data->size ());
-
-          //std::cerr << "data->size (): " << data->size () << endl
-          //          << "new_data->size (): " << new_data->size () << endl
-          //          << "new_data->capa (): " << new_data->capacity () << endl;
-
-          new_data->size (new_data->size () + data->size ());
+          new_data->append (*data);
 
 
           if (part->num () == part->of ())
@@ -80,25 +90,14 @@ namespace ACE_RMCast
 
             new_msg->add (Profile_ptr (new To (to)));
             new_msg->add (Profile_ptr (new From (from)));
-            /*
-             * Heads up... we need to add the new_data to new_msg then
-             * unbind the entry that maps to new_data, which will decrement
-             * its reference count. If the bound/refcounted pointer acted
-             * polymorphically like a regular pointer does, we'd be able to
-             * just pass new_data to add(Profile_Ptr) and it would work.
-             * However, Profile_Ptr and Data_Ptr are not compatible, but
-             * we can use the secret knowledge that both are instances of the
-             * same template and that the pointers they contain really are
-             * hierarchically compatible, and do this funky cast to get
-             * the result we want.
-             */
-            //new_msg->add (*(reinterpret_cast<Profile_ptr*> (&new_data)));
 
+            // Add new_data before unbinding the entry that holds it.
+            //
             new_msg->add (Profile_ptr (new_data));
 
             map_.unbind (from);
 
-            in_->recv (new_msg);
+            deliver (new_msg, batch);
           }
         }
       }
@@ -110,7 +109,7 @@ namespace ACE_RMCast
         if (map_.find (from, e) != -1)
           ACE_OS::abort ();
 
-        in_->recv (m);
+        deliver (m, batch);
       }
     }
     else if (m->find (NoData::id) != 0)
@@ -122,7 +121,7 @@ namespace ACE_RMCast
         map_.unbind (from);
       }
 
-      in_->recv (m);
+      deliver (m, batch);
     }
   }
 }
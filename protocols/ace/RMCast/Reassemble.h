@@ -22,6 +22,13 @@ namespace ACE_RMCast
     virtual void
     recv (Message_ptr m);
 
+    virtual void
+    recv_batch (Messages& ms);
+
+  private:
+    void
+    reassemble (Message_ptr m, Messages* batch);
+
   private:
     Parameters const& params_;
 
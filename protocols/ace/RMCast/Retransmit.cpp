@@ -22,7 +22,10 @@ namespace ACE_RMCast
   {
     Element::out_start (out);
 
-    tracker_mgr_.spawn (track_thunk, this);
+    // In the reactive mode the link calls tick () instead.
+    //
+    if (params_.reactor () == 0)
+      tracker_mgr_.spawn (track_thunk, this);
   }
 
   void Retransmit::
@@ -45,7 +48,7 @@ namespace ACE_RMCast
     {
       SN const* sn = static_cast<SN const*> (m->find (SN::id));
 
-      Lock l (mutex_);
+      Optional_Lock l (mutex_, !params_.reactor ());
       queue_.bind (sn->num (), Descr (m->clone ()));
     }
 
@@ -53,6 +56,31 @@ namespace ACE_RMCast
   }
 
   void Retransmit::recv (Message_ptr m)
+  {
+    handle_nak (m);
+
+    in_->recv (m);
+  }
+
+  void Retransmit::
+  recv_batch (Messages& ms)
+  {
+    for (size_t i (0); i < ms.size (); ++i)
+      handle_nak (ms[i]);
+
+    in_->recv_batch (ms);
+  }
+
+  void Retransmit::
+  tick ()
+  {
+    track_once ();
+
+    Element::tick ();
+  }
+
+  void Retransmit::
+  handle_nak (Message_ptr const& m)
   {
     if (NAK const* nak = static_cast<NAK const*> (m->find (NAK::id)))
     {
@@ -60,7 +88,7 @@ namespace ACE_RMCast
 
       if (nak->address () == to)
       {
-        Lock l (mutex_);
+        Optional_Lock l (mutex_, !params_.reactor ());
 
         for (NAK::iterator j (const_cast<NAK*> (nak)->begin ());
              !j.done ();
@@ -94,8 +122,6 @@ namespace ACE_RMCast
         }
       }
     }
-
-    in_->recv (m);
   }
 
   ACE_THR_FUNC_RETURN Retransmit::
@@ -105,26 +131,34 @@ namespace ACE_RMCast
     return 0;
   }
 
+  void Retransmit::
+  track_once ()
+  {
+    Optional_Lock l (mutex_, !params_.reactor ());
+
+    for (Queue::iterator i (queue_); !i.done ();)
+    {
+      if ((*i).int_id_.inc () >= params_.retention_timeout ())
+      {
+        u64 sn ((*i).ext_id_);
+        i.advance ();
+        queue_.unbind (sn);
+      }
+      else
+      {
+        i.advance ();
+      }
+    }
+  }
+
   void Retransmit::
   track ()
   {
     while (true)
     {
-      Lock l (mutex_);
+      track_once ();
 
-      for (Queue::iterator i (queue_); !i.done ();)
-      {
-        if ((*i).int_id_.inc () >= params_.retention_timeout ())
-        {
-          u64 sn ((*i).ext_id_);
-          i.advance ();
-          queue_.unbind (sn);
-        }
-        else
-        {
-          i.advance ();
-        }
-      }
+      Lock l (mutex_);
 
       //FUZZ: disable check_for_lack_ACE_OS
       // Go to sleep but watch for "manual cancellation" request.
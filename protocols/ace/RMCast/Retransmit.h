@@ -32,6 +32,12 @@ namespace ACE_RMCast
     virtual void
     recv (Message_ptr m);
 
+    virtual void
+    recv_batch (Messages& ms);
+
+    virtual void
+    tick ();
+
   private:
     struct Descr
     {
@@ -75,9 +81,15 @@ namespace ACE_RMCast
     Queue;
 
   private:
+    void
+    handle_nak (Message_ptr const& m);
+
     void
     track ();
 
+    void
+    track_once ();
+
     static ACE_THR_FUNC_RETURN
     track_thunk (void* obj);
 
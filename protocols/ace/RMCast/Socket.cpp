@@ -61,6 +61,14 @@ namespace ACE_RMCast
     virtual void recv (Message_ptr m);
     //FUZZ: enable check_for_lack_ACE_OS
 
+    virtual void recv_batch (Messages& ms);
+
+    bool
+    wanted (Message_ptr const& m) const;
+
+    void
+    signal_ ();
+
   private:
     bool loop_;
     Parameters const params_;
@@ -150,7 +158,14 @@ namespace ACE_RMCast
     {
       Message_ptr m (new Message);
 
-      m->add (Profile_ptr (new Data (buf, s)));
+      // With threads of their own, the retransmit tracker may release
+      // the data when the message has been sent.
+      //
+      m->add (Profile_ptr (new Data (buf,
+                                     s,
+                                     params_.reactor () == 0
+                                     ? Data::block_lock ()
+                                     : 0)));
 
       // Qualification is for VC6 and VxWorks.
       //
@@ -220,11 +235,7 @@ namespace ACE_RMCast
 
       Data const* d = static_cast<Data const*>(m->find (Data::id));
 
-      ssize_t r (static_cast<ssize_t> (d->size () < s ? d->size () : s));
-
-      ACE_OS::memcpy (buf, d->buf (), r);
-
-      return r;
+      return static_cast<ssize_t> (d->copy (buf, s));
     }
 
   ssize_t Socket_Impl::
@@ -289,19 +300,8 @@ namespace ACE_RMCast
 
   void Socket_Impl::recv (Message_ptr m)
     {
-      if (m->find (Data::id) != 0 || m->find (NoData::id) != 0)
+      if (wanted (m))
         {
-          if (!loop_)
-            {
-              Address to (static_cast<To const*> (m->find (To::id))->address ());
-
-              Address from (
-                            static_cast<From const*> (m->find (From::id))->address ());
-
-              if (to == from)
-                return;
-            }
-
           Lock l (mutex_);
 
           //if (queue_.size () != 0)
@@ -314,22 +314,64 @@ namespace ACE_RMCast
           queue_.enqueue_tail (m);
 
           if (signal)
-            {
-              // Also write to the pipe.
-              if (signal_pipe_.write_handle () != ACE_INVALID_HANDLE)
-                {
-                  char c;
+            signal_ ();
+        }
+    }
 
-                  if (signal_pipe_.send (&c, 1) != 1)
-                    {
-                      // perror ("write: ");
-                      ACE_OS::abort ();
-                    }
-                }
+  void Socket_Impl::recv_batch (Messages& ms)
+    {
+      Lock l (mutex_);
+
+      //FUZZ: disable check_for_lack_ACE_OS
+      bool signal (queue_.is_empty ());
+      //FUZZ: enable check_for_lack_ACE_OS
 
-              cond_.signal ();
+      for (size_t i (0); i < ms.size (); ++i)
+        {
+          if (wanted (ms[i]))
+            queue_.enqueue_tail (ms[i]);
+        }
+
+      if (signal && !queue_.is_empty ())
+        signal_ ();
+    }
+
+  bool Socket_Impl::
+    wanted (Message_ptr const& m) const
+    {
+      if (m->find (Data::id) == 0 && m->find (NoData::id) == 0)
+        return false;
+
+      if (!loop_)
+        {
+          Address to (static_cast<To const*> (m->find (To::id))->address ());
+
+          Address from (
+                        static_cast<From const*> (m->find (From::id))->address ());
+
+          if (to == from)
+            return false;
+        }
+
+      return true;
+    }
+
+  void Socket_Impl::
+    signal_ ()
+    {
+      // Also write to the pipe.
+      if (signal_pipe_.write_handle () != ACE_INVALID_HANDLE)
+        {
+          char c;
+
+          if (signal_pipe_.send (&c, 1) != 1)
+            {
+              // perror ("write: ");
+              ACE_OS::abort ();
             }
         }
+
+      cond_.signal ();
     }
 
 
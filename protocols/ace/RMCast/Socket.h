@@ -27,6 +27,11 @@ namespace ACE_RMCast
     // If 'simulator' is 'true' then internal message loss and
     // reordering simulator (on IPv4 level) is turned on.
     //
+    // If params.reactor () is not 0, the socket has no threads of its
+    // own and runs in the reactor's event loop. It must then only be
+    // used, and destroyed, from there: register get_handle () with the
+    // reactor and call recv() with a zero timeout once it is readable.
+    //
     Socket (ACE_INET_Addr const& a,
             bool loop = true,
             Parameters const& params = Parameters ());
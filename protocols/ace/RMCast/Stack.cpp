@@ -62,6 +62,27 @@ namespace ACE_RMCast
     if (in_) in_->recv (m);
   }
 
+  void In_Element::
+  recv_batch (Messages& ms)
+  {
+    if (in_) in_->recv_batch (ms);
+  }
+
+  void In_Element::
+  deliver (Message_ptr m, Messages* batch)
+  {
+    if (batch)
+      batch->push_back (m);
+    else
+      in_->recv (m);
+  }
+
+  void In_Element::
+  tick ()
+  {
+    if (in_) in_->tick ();
+  }
+
   void In_Element::
   in_stop ()
   {
@@ -45,6 +45,26 @@ namespace ACE_RMCast
     virtual void
     recv (Message_ptr m);
 
+    // Receive a batch of messages at once. Only used in the reactive
+    // mode (see Parameters::reactor ()); an element which handles
+    // messages in recv() handles them here as well, then passes the
+    // ones it forwards up in a single batch.
+    //
+    virtual void
+    recv_batch (Messages& ms);
+
+    // Called by the link every Parameters::tick () in the reactive
+    // mode, in place of the elements' own threads.
+    //
+    virtual void
+    tick ();
+
+  protected:
+    // Pass a message up, or add it to the batch if there is one.
+    //
+    void
+    deliver (Message_ptr m, Messages* batch);
+
   protected:
     In_Element* in_;
   };
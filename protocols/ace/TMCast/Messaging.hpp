@@ -5,21 +5,53 @@
 #define TMCAST_MESSAGING_HPP
 
 #include <ace/Synch.h>
-#include <ace/Bound_Ptr.h>
+#include <ace/Atomic_Op.h>
+#include <ace/Intrusive_Auto_Ptr.h>
 
 #include "MTQueue.hpp"
 
 namespace ACE_TMCast
 {
+  // Messages are counted in place so that passing one between the
+  // threads doesn't allocate a separate counter for it.
+  //
   class Message
   {
   public:
+    Message ()
+        : ref_count_ (0)
+    {
+    }
+
     virtual
     ~Message () {}
+
+    static void
+    intrusive_add_ref (Message* m)
+    {
+      if (m != 0)
+        ++m->ref_count_;
+    }
+
+    static void
+    intrusive_remove_ref (Message* m)
+    {
+      if (m != 0 && --m->ref_count_ == 0)
+        delete m;
+    }
+
+  private:
+    Message (Message const&);
+
+    Message&
+    operator= (Message const&);
+
+  private:
+    ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> ref_count_;
   };
 
   typedef
-  ACE_Strong_Bound_Ptr<Message, ACE_SYNCH_MUTEX>
+  ACE_Intrusive_Auto_Ptr<Message>
   MessagePtr;
 
   typedef
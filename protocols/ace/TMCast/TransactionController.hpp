@@ -4,7 +4,7 @@
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_stdlib.h"
 #include "ace/Synch.h"
-#include "ace/Bound_Ptr.h"
+#include "ace/Intrusive_Auto_Ptr.h"
 
 #include "Protocol.hpp"
 #include "Messaging.hpp"
@@ -44,7 +44,7 @@ namespace ACE_TMCast
   };
 
   typedef
-  ACE_Strong_Bound_Ptr<Send, ACE_SYNCH_MUTEX>
+  ACE_Intrusive_Auto_Ptr<Send>
   SendPtr;
 
 
@@ -75,7 +75,7 @@ namespace ACE_TMCast
   };
 
   typedef
-  ACE_Strong_Bound_Ptr<Recv, ACE_SYNCH_MUTEX>
+  ACE_Intrusive_Auto_Ptr<Recv>
   RecvPtr;
 
   class Aborted : public virtual Message {};
@@ -345,7 +345,7 @@ namespace ACE_TMCast
 
         if (typeid (*m) == typeid (Send))
         {
-          send_ = SendPtr (m);
+          send_ = SendPtr (dynamic_cast<Send*> (m.get ()));
         }
         else
         {
@@ -0,0 +1,527 @@
+// $Id$
+
+#include "ace/INet/HTTP_AsyncClient.h"
+#include "ace/INet/HTTP_URL.h"
+#include "ace/Reactor.h"
+#include "ace/Select_Reactor.h"
+#include "ace/SOCK_Acceptor.h"
+#include "ace/SOCK_Connector.h"
+#include "ace/SOCK_Stream.h"
+#include "ace/INET_Addr.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Message_Block.h"
+#include "ace/Signal.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+
+#if defined (ACE_HAS_THREADS)
+
+typedef ACE_Atomic_Op<ACE_Thread_Mutex, long> Counter;
+
+const int MAX_ID = 256;
+
+/// Requests the server got for each id, and the connections it took.
+Counter served[MAX_ID];
+Counter connections (0);
+
+/// Requests the server found queued behind another one.
+Counter pipelined (0);
+
+bool stop_server = false;
+
+#if defined (MSG_NOSIGNAL)
+int const send_flags = MSG_NOSIGNAL;
+#else
+int const send_flags = 0;
+#endif /* MSG_NOSIGNAL */
+
+int n_fails = 0;
+
+ACE_CString body_for (size_t length, int id)
+{
+  char* data = 0;
+  ACE_NEW_RETURN (data, char[length + 1], ACE_CString ());
+  for (size_t i = 0; i < length; ++i)
+    data[i] = static_cast<char> ('a' + (i + id) % 26);
+  ACE_CString const body (data, length);
+  delete [] data;
+  return body;
+}
+
+/**
+ * The server end of a connection.  A request for "/<kind>/<length>/<id>"
+ * is answered with <length> bytes of body made for <id>:
+ *
+ *   len    with a Content-Length
+ *   chunk  chunked, with chunk extensions and a trailer
+ *   eof    by HTTP/1.0, the body ending with the connection
+ *   close  with a Content-Length and "Connection: close"
+ *   drop   not at all, the connection is closed instead
+ *   once   like drop the first time, like len after that
+ *   huge   with a Content-Length too large for any size_t
+ */
+ACE_THR_FUNC_RETURN serve (void* arg)
+{
+  ACE_SOCK_Stream& peer = *static_cast<ACE_SOCK_Stream*> (arg);
+  ++connections;
+
+  ACE_CString in;
+  char buffer[4096];
+  bool done = false;
+  while (!done)
+    {
+      ACE_CString::size_type end;
+      while ((end = in.find ("\r\n\r\n")) == ACE_CString::npos)
+        {
+          ssize_t const n = peer.recv (buffer, sizeof buffer);
+          if (n <= 0)
+            {
+              done = true;
+              break;
+            }
+          in += ACE_CString (buffer, n);
+        }
+      if (done)
+        break;
+
+      ACE_CString const head = in.substr (0, end);
+      in = in.substr (end + 4);
+
+      ACE_CString::size_type const cl = head.find ("Content-Length: ");
+      if (cl != ACE_CString::npos)
+        {
+          size_t const length =
+            ACE_OS::strtoul (head.c_str () + cl + 16, 0, 10);
+          while (in.length () < length && !done)
+            {
+              ssize_t const n = peer.recv (buffer, sizeof buffer);
+              if (n <= 0)
+                done = true;
+              else
+                in += ACE_CString (buffer, n);
+            }
+          if (done)
+            break;
+          in = in.substr (length);
+        }
+      if (in.find ("\r\n\r\n") != ACE_CString::npos)
+        ++pipelined;
+
+      // <method> /<kind>/<length>/<id> HTTP/1.1
+      ACE_CString::size_type const sp = head.find (' ');
+      ACE_CString::size_type const slash = head.find ('/', sp + 2);
+      if (sp == ACE_CString::npos || slash == ACE_CString::npos)
+        break;
+      ACE_CString const method = head.substr (0, sp);
+      ACE_CString const kind = head.substr (sp + 2, slash - sp - 2);
+      char* rest = 0;
+      unsigned int const length = static_cast<unsigned int> (
+          ACE_OS::strtoul (head.c_str () + slash + 1, &rest, 10));
+      long const id = ACE_OS::strtol (rest + 1, 0, 10);
+      if (id < 0 || id >= MAX_ID)
+        break;
+      long const count = ++served[id];
+
+      ACE_CString const body = body_for (length, id);
+      ACE_CString out;
+      char line[256];
+
+      if (kind == "once" && count == 1)
+        break;
+
+      if (kind == "len" || kind == "once")
+        {
+          ACE_OS::snprintf (line, sizeof line,
+                            "HTTP/1.1 200 OK\r\nContent-Length: %u\r\n\r\n",
+                            length);
+          out = line;
+          if (method != "HEAD")
+            out += body;
+        }
+      else if (kind == "chunk")
+        {
+          out = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n";
+          for (size_t p = 0; p < body.length (); )
+            {
+              size_t n = 1 + ACE_OS::rand () % 300;
+              if (n > body.length () - p)
+                n = body.length () - p;
+              ACE_OS::snprintf (line, sizeof line, "%lx;ext=1\r\n",
+                                static_cast<unsigned long> (n));
+              out += line;
+              out += body.substr (p, n);
+              out += "\r\n";
+              p += n;
+            }
+          out += "0\r\nX-Trailer: yes\r\n\r\n";
+        }
+      else if (kind == "eof")
+        {
+          out = "HTTP/1.0 200 OK\r\n\r\n";
+          out += body;
+          done = true;
+        }
+      else if (kind == "close")
+        {
+          ACE_OS::snprintf (line, sizeof line,
+                            "HTTP/1.1 200 OK\r\nConnection: close\r\n"
+                            "Content-Length: %u\r\n\r\n",
+                            length);
+          out = line;
+          out += body;
+          done = true;
+        }
+      else if (kind == "huge")
+        {
+          out = "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 999999999999999999999999\r\n\r\nabc";
+        }
+      else
+        break;
+
+      // the response goes out in pieces to be parsed across reads
+      for (size_t p = 0; p < out.length (); )
+        {
+          size_t n = 1 + ACE_OS::rand () % 700;
+          if (n > out.length () - p)
+            n = out.length () - p;
+          if (peer.send_n (out.c_str () + p, n, send_flags) <= 0)
+            break;
+          p += n;
+        }
+    }
+
+  peer.close ();
+  delete &peer;
+  return 0;
+}
+
+ACE_THR_FUNC_RETURN accept_loop (void* arg)
+{
+  ACE_SOCK_Acceptor* acceptor = static_cast<ACE_SOCK_Acceptor*> (arg);
+  while (!stop_server)
+    {
+      ACE_SOCK_Stream* peer = 0;
+      ACE_NEW_RETURN (peer, ACE_SOCK_Stream, 0);
+      ACE_Time_Value timeout (0, 50000);
+      if (acceptor->accept (*peer, 0, &timeout) == -1
+          || ACE_Thread_Manager::instance ()->spawn (serve, peer) == -1)
+        {
+          peer->close ();
+          delete peer;
+        }
+    }
+  return 0;
+}
+
+/// What a request is expected to end with.
+struct Expect
+{
+  Expect ()
+    : length (0), id (0), error (0), status (0), body_ok (false)
+  {
+  }
+
+  size_t length;
+  int id;
+  int error;
+  int status;
+  bool body_ok;
+};
+
+class Handler : public ACE::HTTP::AsyncResponseHandler
+{
+public:
+  Handler () : responses (0), errors (0) {}
+
+  virtual void handle_response (const ACE::HTTP::Response& response,
+                                const ACE_Message_Block& body,
+                                const void* act)
+  {
+    Expect* expect = const_cast<Expect*> (static_cast<const Expect*> (act));
+    ++this->responses;
+    expect->status = response.get_status ().get_status ();
+    expect->body_ok =
+      body_for (expect->length, expect->id)
+        == ACE_CString (body.rd_ptr (), body.length ());
+  }
+
+  virtual void handle_error (int error, const void* act)
+  {
+    ++this->errors;
+    const_cast<Expect*> (static_cast<const Expect*> (act))->error = error;
+  }
+
+  int responses;
+  int errors;
+};
+
+void check (bool ok, const char* what)
+{
+  if (!ok)
+    {
+      ++n_fails;
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%P|%t) check failed: %C\n"), what));
+    }
+}
+
+#define CHECK(c) check ((c), #c)
+
+void run (ACE_Reactor& reactor, ACE::HTTP::AsyncClient& client)
+{
+  ACE_Time_Value const deadline =
+    ACE_OS::gettimeofday () + ACE_Time_Value (20);
+  while (client.pending () > 0 && ACE_OS::gettimeofday () < deadline)
+    {
+      ACE_Time_Value timeout (0, 100000);
+      reactor.handle_events (timeout);
+    }
+}
+
+int submit (ACE::HTTP::AsyncClient& client,
+            Handler& handler,
+            u_short port,
+            const char* method,
+            const char* kind,
+            Expect& expect,
+            size_t length,
+            int id)
+{
+  char uri[64];
+  ACE_OS::snprintf (uri, sizeof uri, "/%s/%lu/%d",
+                    kind, static_cast<unsigned long> (length), id);
+  expect.length = length;
+  expect.id = id;
+  ACE::HTTP::Request request (method, uri, ACE::HTTP::Header::HTTP_1_1);
+  return client.send_request ("127.0.0.1", port, request, &handler, &expect,
+                              ACE_OS::strcmp (method, "POST") == 0 ? "x" : 0,
+                              ACE_OS::strcmp (method, "POST") == 0 ? 1 : 0);
+}
+
+void test_pipelining (ACE_Reactor& reactor, u_short port)
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) pipelined keep-alive requests\n")));
+
+  connections = 0;
+  ACE::HTTP::AsyncClient client (&reactor, 1, 4);
+  Handler handler;
+  const int N = 40;
+  Expect expect[N];
+  for (int i = 0; i < N; ++i)
+    CHECK (submit (client, handler, port, "GET", i % 2 ? "chunk" : "len",
+                   expect[i], ACE_OS::rand () % 20000, i) == 0);
+  run (reactor, client);
+
+  CHECK (handler.responses == N && handler.errors == 0);
+  for (int i = 0; i < N; ++i)
+    CHECK (expect[i].status == 200 && expect[i].body_ok);
+  CHECK (connections.value () == 1);
+  CHECK (pipelined.value () > 0);
+}
+
+void test_connection_end (ACE_Reactor& reactor, u_short port)
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) bodies ending with the connection\n")));
+
+  ACE::HTTP::AsyncClient client (&reactor, 2, 1);
+  Handler handler;
+  const int N = 10;
+  Expect expect[N];
+  for (int i = 0; i < N; ++i)
+    CHECK (submit (client, handler, port, "GET", i % 2 ? "eof" : "close",
+                   expect[i], ACE_OS::rand () % 5000, 50 + i) == 0);
+  run (reactor, client);
+
+  CHECK (handler.responses == N && handler.errors == 0);
+  for (int i = 0; i < N; ++i)
+    CHECK (expect[i].status == 200 && expect[i].body_ok);
+}
+
+void test_retry (ACE_Reactor& reactor, u_short port)
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) requests of a connection closed\n")));
+
+  ACE::HTTP::AsyncClient client (&reactor, 1, 1);
+  Handler handler;
+  Expect once, drop, post;
+  CHECK (submit (client, handler, port, "GET", "once", once, 100, 100) == 0);
+  CHECK (submit (client, handler, port, "GET", "drop", drop, 0, 101) == 0);
+  CHECK (submit (client, handler, port, "POST", "drop", post, 0, 102) == 0);
+  run (reactor, client);
+
+  // an idempotent request is sent again once, others are not
+  CHECK (once.status == 200 && once.body_ok && served[100].value () == 2);
+  CHECK (drop.error == ECONNRESET && served[101].value () == 2);
+  CHECK (post.error == ECONNRESET && served[102].value () == 1);
+}
+
+void test_limits (ACE_Reactor& reactor, u_short port)
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) response body limits\n")));
+
+  ACE::HTTP::AsyncClient client (&reactor, 1, 1);
+  client.max_body_size (1000);
+  Handler handler;
+  Expect len, chunk, eof, fits, huge;
+  CHECK (submit (client, handler, port, "GET", "len", len, 5000, 110) == 0);
+  CHECK (submit (client, handler, port, "GET", "chunk", chunk, 5000, 111) == 0);
+  CHECK (submit (client, handler, port, "GET", "eof", eof, 5000, 112) == 0);
+  CHECK (submit (client, handler, port, "GET", "len", fits, 1000, 113) == 0);
+  CHECK (submit (client, handler, port, "GET", "huge", huge, 0, 114) == 0);
+  run (reactor, client);
+
+  // a response that can not be taken is not asked for again
+  CHECK (len.error == EFBIG && served[110].value () == 1);
+  CHECK (chunk.error == EFBIG && served[111].value () == 1);
+  CHECK (eof.error == EFBIG && served[112].value () == 1);
+  CHECK (fits.status == 200 && fits.body_ok);
+  CHECK (huge.error == EPROTO && served[114].value () == 1);
+}
+
+void test_connect_errors (ACE_Reactor& reactor)
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) connections failing\n")));
+
+  ACE_INET_Addr const any (static_cast<u_short> (0), "127.0.0.1");
+
+  // a port nobody listens on
+  {
+    ACE_SOCK_Acceptor acceptor (any);
+    ACE_INET_Addr address;
+    acceptor.get_local_addr (address);
+    acceptor.close ();
+
+    ACE::HTTP::AsyncClient client (&reactor);
+    Handler handler;
+    Expect expect[5];
+    for (int i = 0; i < 5; ++i)
+      submit (client, handler, address.get_port_number (), "GET", "len",
+              expect[i], 1, 120);
+    run (reactor, client);
+    CHECK (handler.errors == 5 && client.pending () == 0);
+    for (int i = 0; i < 5; ++i)
+      CHECK (expect[i].error == ECONNREFUSED);
+  }
+
+  // a listener whose backlog is full leaves connections unanswered
+  {
+    ACE_SOCK_Acceptor acceptor (any, 0, PF_INET, 0);
+    ACE_INET_Addr address;
+    acceptor.get_local_addr (address);
+
+    const int MAX_FILL = 8;
+    ACE_SOCK_Stream fill[MAX_FILL];
+    ACE_SOCK_Connector connector;
+    bool full = false;
+    for (int i = 0; i < MAX_FILL && !full; ++i)
+      {
+        ACE_Time_Value timeout (0, 100000);
+        full = connector.connect (fill[i], address, &timeout) == -1
+            && errno == ETIME;
+      }
+    if (!full)
+      {
+        ACE_DEBUG ((LM_INFO,
+                    ACE_TEXT ("(%P|%t) backlog does not fill up, ")
+                    ACE_TEXT ("connect timeout not tested\n")));
+      }
+    else
+      {
+        ACE::HTTP::AsyncClient client (&reactor);
+        client.connect_timeout (ACE_Time_Value (0, 200000));
+        Handler handler;
+        Expect expect;
+        submit (client, handler, address.get_port_number (), "GET", "len",
+                expect, 1, 121);
+        run (reactor, client);
+        CHECK (expect.error == ETIMEDOUT);
+      }
+    for (int i = 0; i < MAX_FILL; ++i)
+      fill[i].close ();
+  }
+}
+
+void test_close (ACE_Reactor& reactor, u_short port)
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) client closed with requests\n")));
+
+  ACE::HTTP::AsyncClient client (&reactor, 2, 2);
+  Handler handler;
+  const int N = 20;
+  Expect expect[N];
+  for (int i = 0; i < N; ++i)
+    submit (client, handler, port, "GET", "len", expect[i], 100000, 130 + i);
+  for (int i = 0; i < 3; ++i)
+    {
+      ACE_Time_Value timeout (0, 2000);
+      reactor.handle_events (timeout);
+    }
+  client.close ();
+  CHECK (handler.responses + handler.errors == N && client.pending () == 0);
+  CHECK (expect[N - 1].error == ECANCELED);
+
+  // the client takes requests again after that
+  Expect again;
+  CHECK (submit (client, handler, port, "GET", "len", again, 10, 160) == 0);
+  run (reactor, client);
+  CHECK (again.status == 200 && again.body_ok);
+}
+
+#endif /* ACE_HAS_THREADS */
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+#if defined (ACE_HAS_THREADS)
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) AsyncClient test started\n")));
+
+#if !defined (MSG_NOSIGNAL)
+  // the client does not keep servers gone from raising SIGPIPE here
+  ACE_Sig_Action sigpipe ((ACE_SignalHandler) SIG_IGN, SIGPIPE);
+  ACE_UNUSED_ARG (sigpipe);
+#endif /* MSG_NOSIGNAL */
+
+  ACE_SOCK_Acceptor acceptor;
+  ACE_INET_Addr address (static_cast<u_short> (0), "127.0.0.1");
+  if (acceptor.open (address, 1) == -1
+      || acceptor.get_local_addr (address) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), 1);
+  u_short const port = address.get_port_number ();
+
+  ACE_Thread_Manager::instance ()->spawn (accept_loop, &acceptor);
+
+  {
+    ACE_Reactor reactor (new ACE_Select_Reactor, true);
+
+    test_pipelining (reactor, port);
+    test_connection_end (reactor, port);
+    test_retry (reactor, port);
+    test_limits (reactor, port);
+    test_connect_errors (reactor);
+    test_close (reactor, port);
+
+    // let the connections closed last go
+    for (int i = 0; i < 5; ++i)
+      {
+        ACE_Time_Value timeout (0, 20000);
+        reactor.handle_events (timeout);
+      }
+  }
+
+  stop_server = true;
+  ACE_Thread_Manager::instance ()->wait ();
+  acceptor.close ();
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("(%P|%t) AsyncClient test finished, %d failures\n"),
+              n_fails));
+  return n_fails == 0 ? 0 : 1;
+#else
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("threads not supported on this platform\n")));
+  return 0;
+#endif /* ACE_HAS_THREADS */
+}
@@ -0,0 +1,381 @@
+// $Id$
+
+#include "ace/INet/ConnectionCache.h"
+#include "ace/Reactor.h"
+#include "ace/Select_Reactor.h"
+#include "ace/Task.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_Thread.h"
+
+using ACE::INet::ConnectionCache;
+using ACE::INet::ConnectionHolder;
+using ACE::INet::ConnectionKey;
+using ACE::INet::ConnectionFactory;
+
+typedef ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> Counter;
+
+/// Connections which exist, and were created.
+Counter live (0);
+Counter created (0);
+
+int n_fails = 0;
+
+void check (bool ok, const char* what, int line)
+{
+  if (!ok)
+    {
+      ++n_fails;
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%P|%t) line %d: check failed: %C\n"),
+                  line, what));
+    }
+}
+
+#define CHECK(c) check ((c), #c, __LINE__)
+
+class Key : public ConnectionKey
+{
+public:
+  Key (int id) : id_ (id) {}
+
+  virtual u_long hash () const { return static_cast<u_long> (this->id_); }
+
+  virtual ConnectionKey* duplicate () const
+  {
+    Key* key = 0;
+    ACE_NEW_RETURN (key, Key (this->id_), 0);
+    return key;
+  }
+
+  int id () const { return this->id_; }
+
+protected:
+  virtual bool equal (const ConnectionKey& key) const
+  {
+    const Key* other = dynamic_cast<const Key*> (&key);
+    return other != 0 && other->id_ == this->id_;
+  }
+
+private:
+  int id_;
+};
+
+class Connection : public ConnectionHolder
+{
+public:
+  Connection (int key) : key_ (key) { ++live; ++created; }
+  virtual ~Connection () { --live; }
+
+  int key () const { return this->key_; }
+
+private:
+  int key_;
+};
+
+class Factory : public ConnectionFactory
+{
+public:
+  Factory (bool fail = false) : fail_ (fail) {}
+
+  virtual ConnectionHolder* create_connection (const ConnectionKey& key) const
+  {
+    if (this->fail_)
+      return 0;
+    Connection* connection = 0;
+    ACE_NEW_RETURN (connection,
+                    Connection (dynamic_cast<const Key&> (key).id ()),
+                    0);
+    return connection;
+  }
+
+private:
+  bool fail_;
+};
+
+const ACE_Time_Value TIMEOUT (0, 100000);
+const ACE_Time_Value PAST_TIMEOUT (0, 150000);
+
+void test_claims ()
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) claims and releases\n")));
+
+  ConnectionCache cache (64, 2, 4);
+  Factory factory;
+  Key key (1);
+  ConnectionHolder* a = 0;
+  ConnectionHolder* b = 0;
+  ConnectionHolder* c = 0;
+
+  CHECK (!cache.has_connection (key));
+  CHECK (cache.claim_connection (key, a, factory, false));
+  CHECK (cache.claim_connection (key, b, factory, false));
+  CHECK (a != 0 && b != 0 && a != b);
+  CHECK (cache.has_connection (key));
+
+  // the limit of the key is reached
+  CHECK (!cache.claim_connection (key, c, factory, false));
+
+  CHECK (cache.release_connection (key, a));
+  CHECK (!cache.release_connection (key, a));
+  CHECK (!cache.release_connection (Key (2), b));
+  CHECK (cache.release_connection (key, b));
+
+  // the connection released last is claimed first
+  CHECK (cache.claim_connection (key, c, factory, false) && c == b);
+  CHECK (cache.close_connection (key, c));
+  CHECK (cache.claim_connection (key, c, factory, false) && c == a);
+  CHECK (cache.release_connection (key, c));
+
+  ConnectionCache::Statistics stats;
+  cache.get_statistics (stats);
+  CHECK (stats.hits == 2 && stats.misses == 2);
+  CHECK (stats.waits == 0 && stats.evictions == 0);
+  CHECK (cache.current_size () == 1);
+  CHECK (live.value () == 1);
+
+  // a connection that could not be created leaves its slot free
+  ConnectionCache single (64, 1, 1);
+  Factory failing (true);
+  CHECK (ConnectionCache ().max_connections () == 1);
+  CHECK (!single.claim_connection (key, c, failing, false));
+  CHECK (single.claim_connection (key, c, factory, false));
+  CHECK (single.release_connection (key, c));
+}
+
+void test_eviction ()
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) eviction\n")));
+
+  ConnectionCache cache (64, 2, 4);
+  Factory factory;
+  Key key (1);
+  ConnectionHolder* a = 0;
+  ConnectionHolder* b = 0;
+  ConnectionCache::Statistics stats;
+  long const before = live.value ();
+
+  // by idle time
+  cache.idle_timeout (TIMEOUT);
+  CHECK (cache.idle_timeout () == TIMEOUT);
+  CHECK (cache.claim_connection (key, a, factory, false));
+  CHECK (cache.release_connection (key, a));
+  CHECK (cache.evict () == 0);
+  ACE_OS::sleep (PAST_TIMEOUT);
+  CHECK (cache.evict () == 1);
+  CHECK (!cache.has_connection (key));
+  CHECK (live.value () == before);
+  cache.get_statistics (stats);
+  CHECK (stats.evictions == 1);
+  cache.idle_timeout (ACE_Time_Value::zero);
+
+  // by age, when evicting, released and claimed
+  cache.max_age (TIMEOUT);
+  CHECK (cache.claim_connection (key, a, factory, false));
+  CHECK (cache.release_connection (key, a));
+  ACE_OS::sleep (PAST_TIMEOUT);
+  CHECK (cache.evict () == 1);
+
+  CHECK (cache.claim_connection (key, a, factory, false));
+  ACE_OS::sleep (PAST_TIMEOUT);
+  CHECK (cache.release_connection (key, a));
+  CHECK (!cache.has_connection (key));
+
+  CHECK (cache.claim_connection (key, a, factory, false));
+  CHECK (cache.release_connection (key, a));
+  ACE_OS::sleep (PAST_TIMEOUT);
+  CHECK (cache.claim_connection (key, b, factory, false));
+  CHECK (cache.release_connection (key, b));
+  CHECK (live.value () == before + 1);
+
+  cache.get_statistics (stats);
+  CHECK (stats.evictions == 4);
+  CHECK (stats.misses == 5 && stats.hits == 0);
+}
+
+void test_close_all ()
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) closing all connections\n")));
+
+  ConnectionCache cache (64, 2, 4);
+  Factory factory;
+  Key key (1);
+  ConnectionHolder* idle = 0;
+  ConnectionHolder* busy = 0;
+  long const before = live.value ();
+
+  CHECK (cache.claim_connection (key, idle, factory, false));
+  CHECK (cache.claim_connection (key, busy, factory, false));
+  CHECK (cache.release_connection (key, idle));
+
+  // the connection claimed stays until it is released
+  cache.close_all_connections ();
+  CHECK (live.value () == before + 1);
+  CHECK (static_cast<Connection*> (busy)->key () == 1);
+  CHECK (cache.release_connection (key, busy));
+  CHECK (live.value () == before);
+  CHECK (!cache.has_connection (key));
+
+  // and the key takes connections again
+  CHECK (cache.claim_connection (key, busy, factory, false));
+  CHECK (cache.release_connection (key, busy));
+  CHECK (cache.has_connection (key));
+}
+
+#if defined (ACE_HAS_THREADS)
+/// Runs the event loop of a reactor.
+class Reactor_Task : public ACE_Task_Base
+{
+public:
+  Reactor_Task (ACE_Reactor& reactor) : reactor_ (reactor) {}
+
+  virtual int svc ()
+  {
+    this->reactor_.owner (ACE_Thread::self ());
+    this->reactor_.run_reactor_event_loop ();
+    return 0;
+  }
+
+private:
+  ACE_Reactor& reactor_;
+};
+
+void test_eviction_timer ()
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) eviction timer\n")));
+
+  ACE_Reactor reactor (new ACE_Select_Reactor, true);
+  Reactor_Task task (reactor);
+  if (task.activate () == -1)
+    {
+      CHECK (!"activate");
+      return;
+    }
+
+  Factory factory;
+  Key key (1);
+  ConnectionHolder* connection = 0;
+  long const before = live.value ();
+
+  {
+    ConnectionCache cache (64, 2, 4);
+    cache.idle_timeout (ACE_Time_Value (0, 20000));
+    CHECK (cache.claim_connection (key, connection, factory, false));
+    CHECK (cache.release_connection (key, connection));
+    CHECK (cache.schedule_eviction (ACE_Time_Value (0, 10000), &reactor) == 0);
+    for (int i = 0; i < 50 && cache.has_connection (key); ++i)
+      ACE_OS::sleep (ACE_Time_Value (0, 10000));
+    CHECK (!cache.has_connection (key));
+    CHECK (live.value () == before);
+  }
+
+  // caches going while their timer fires
+  for (int i = 0; i < 200; ++i)
+    {
+      ConnectionCache cache (64, 2, 4);
+      cache.idle_timeout (ACE_Time_Value (0, 1));
+      CHECK (cache.schedule_eviction (ACE_Time_Value (0, 100), &reactor) == 0);
+      CHECK (cache.claim_connection (key, connection, factory, false));
+      CHECK (cache.release_connection (key, connection));
+      ACE_OS::sleep (ACE_Time_Value (0, (i % 10) * 100));
+    }
+  CHECK (live.value () == before);
+
+  reactor.end_reactor_event_loop ();
+  task.wait ();
+}
+
+const int KEYS = 8;
+const int MAX_CONNECTIONS = 2;
+
+/// Claims the keys it picks from many threads, checking that no key
+/// has more connections claimed than it may have.
+class Stress_Task : public ACE_Task_Base
+{
+public:
+  Stress_Task (ConnectionCache& cache) : cache_ (cache) {}
+
+  virtual int svc ()
+  {
+    Factory factory;
+    for (int i = 0; i < 5000; ++i)
+      {
+        Key key (ACE_OS::rand () % KEYS);
+        ConnectionHolder* connection = 0;
+        if (!this->cache_.claim_connection (key, connection, factory, true))
+          {
+            CHECK (!"claim");
+            continue;
+          }
+        ++this->claims;
+
+        Connection* c = static_cast<Connection*> (connection);
+        CHECK (c->key () == key.id ());
+        long const claimed = ++this->in_use_[key.id ()];
+        CHECK (claimed <= MAX_CONNECTIONS);
+        if (i % 7 == 0)
+          ACE_OS::thr_yield ();
+        --this->in_use_[key.id ()];
+
+        if (i % 50 == 0)
+          CHECK (this->cache_.close_connection (key, connection));
+        else
+          CHECK (this->cache_.release_connection (key, connection));
+      }
+    return 0;
+  }
+
+  Counter claims;
+
+private:
+  ConnectionCache& cache_;
+  Counter in_use_[KEYS];
+};
+
+void test_threads ()
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) claims from 16 threads\n")));
+
+  long const before = live.value ();
+  {
+    ConnectionCache cache (64, MAX_CONNECTIONS, 4);
+    Stress_Task task (cache);
+    task.claims = 0;
+    if (task.activate (THR_NEW_LWP | THR_JOINABLE, 16) == -1)
+      {
+        CHECK (!"activate");
+        return;
+      }
+    task.wait ();
+
+    ConnectionCache::Statistics stats;
+    cache.get_statistics (stats);
+    CHECK (static_cast<long> (stats.hits + stats.misses)
+             == task.claims.value ());
+    CHECK (live.value () - before <= KEYS * MAX_CONNECTIONS);
+    CHECK (cache.current_size () == static_cast<size_t> (KEYS));
+    cache.close_all_connections ();
+    CHECK (live.value () == before);
+  }
+}
+#endif /* ACE_HAS_THREADS */
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) ConnectionCache test started\n")));
+
+  test_claims ();
+  test_eviction ();
+  test_close_all ();
+#if defined (ACE_HAS_THREADS)
+  test_eviction_timer ();
+  test_threads ();
+#endif /* ACE_HAS_THREADS */
+  CHECK (live.value () == 0);
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("(%P|%t) ConnectionCache test finished, %d failures\n"),
+              n_fails));
+  return n_fails == 0 ? 0 : 1;
+}
@@ -0,0 +1,420 @@
+// $Id$
+
+#include "ace/INet/HeaderParser.h"
+#include "ace/INet/HeaderBase.h"
+#include "ace/INet/HTTP_Request.h"
+#include "ace/INet/HTTP_Response.h"
+#include "ace/Message_Block.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+#include <sstream>
+
+using ACE::INet::HeaderParser;
+
+int n_fails = 0;
+
+void check (bool ok, const char* what, int line)
+{
+  if (!ok)
+    {
+      ++n_fails;
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%P|%t) line %d: check failed: %C\n"),
+                  line, what));
+    }
+}
+
+#define CHECK(c) check ((c), #c, __LINE__)
+
+bool equals (const HeaderParser::View& view, const char* s)
+{
+  return view.length == ACE_OS::strlen (s)
+    && ACE_OS::memcmp (view.data, s, view.length) == 0;
+}
+
+/// Gives @a parser the @a length bytes at @a buf, @a step bytes more
+/// each time, or all of them at once if @a step is 0.
+HeaderParser::Status feed (HeaderParser& parser,
+                           const char* buf,
+                           size_t length,
+                           size_t step)
+{
+  HeaderParser::Status status = HeaderParser::PARSE_INCOMPLETE;
+  size_t given = step == 0 ? length : 0;
+  do
+    {
+      given = given + step < length ? given + step : length;
+      status = parser.parse (buf, given);
+    }
+  while (status == HeaderParser::PARSE_INCOMPLETE && given < length);
+  return status;
+}
+
+const char* const REQUEST =
+  "\r\n"
+  "GET /a:b?x=1 HTTP/1.1\r\n"
+  "Host: example.com:80\r\n"
+  "X-Long-Header-Name-Spanning-Blocks:    value with : colon\r\n"
+  "Folded: one\r\n"
+  "  two\r\n"
+  "\tthree\r\n"
+  "Empty:\r\n"
+  "Cookie: a=1\r\n"
+  "Cookie: b=2\n"
+  "\r\n"
+  "BODY";
+
+void check_request (HeaderParser& parser, size_t length)
+{
+  CHECK (parser.status () == HeaderParser::PARSE_COMPLETE);
+  CHECK (parser.header_length () == length - 4);
+  CHECK (parser.count () == 6);
+  CHECK (equals (parser.start_line (), "GET /a:b?x=1 HTTP/1.1"));
+
+  HeaderParser::View method, uri, version;
+  CHECK (parser.split_start_line (method, uri, version));
+  CHECK (equals (method, "GET"));
+  CHECK (equals (uri, "/a:b?x=1"));
+  CHECK (equals (version, "HTTP/1.1"));
+
+  CHECK (parser.find ("host") == 0);
+  CHECK (equals (parser.name (0), "Host"));
+  CHECK (equals (parser.value (0), "example.com:80"));
+  CHECK (parser.find ("x-long-header-name-spanning-blocks") == 1);
+  CHECK (equals (parser.value (1), "value with : colon"));
+  CHECK (parser.find ("Cookie") == 4);
+  CHECK (equals (parser.value (5), "b=2"));
+  CHECK (parser.find ("Missing") == -1);
+
+  ACE_CString value;
+  parser.get_value (parser.find ("Folded"), value);
+  CHECK (value == "one  two\tthree");
+  parser.get_value (parser.find ("Empty"), value);
+  CHECK (value.length () == 0);
+}
+
+void test_feeds ()
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) whole, byte-wise and split feeds\n")));
+
+  size_t const length = ACE_OS::strlen (REQUEST);
+  HeaderParser parser;
+
+  size_t const steps[] = { 0, 1, 3, 16, 17 };
+  for (size_t i = 0; i < sizeof (steps) / sizeof (steps[0]); ++i)
+    {
+      parser.reset ();
+      CHECK (feed (parser, REQUEST, length, steps[i])
+               == HeaderParser::PARSE_COMPLETE);
+      check_request (parser, length);
+    }
+
+  // the buffer split in two at every point
+  for (size_t split = 0; split <= length; ++split)
+    {
+      parser.reset ();
+      HeaderParser::Status const first = parser.parse (REQUEST, split);
+      CHECK (first == HeaderParser::PARSE_INCOMPLETE
+             || split >= length - 4);
+      parser.parse (REQUEST, length);
+      check_request (parser, length);
+    }
+
+  // a complete head is not parsed again
+  CHECK (parser.parse (REQUEST, length) == HeaderParser::PARSE_COMPLETE);
+  CHECK (parser.count () == 6);
+
+  // from a message block
+  ACE_Message_Block mb (length + 8);
+  mb.copy ("XXXX", 4);
+  mb.copy (REQUEST, length);
+  mb.rd_ptr (4);
+  parser.reset ();
+  CHECK (parser.parse (mb) == HeaderParser::PARSE_COMPLETE);
+  check_request (parser, length);
+}
+
+void test_scan ()
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) line ends at every offset\n")));
+
+  // Names and values of every length up to past two blocks of 16
+  // bytes, at every alignment, find their line ends and colons in the
+  // 16 byte scan as well as in the scan of the rest a byte at a time.
+  char buf[256];
+  char name[64];
+  char value[64];
+  HeaderParser parser;
+  for (size_t align = 0; align < 16; ++align)
+    for (size_t n = 1; n < 40; ++n)
+      for (size_t v = 0; v < 40; v += 3)
+        {
+          ACE_OS::memset (name, 'n', n);
+          name[n] = '\0';
+          name[n - 1] = 'N';
+          ACE_OS::memset (value, 'v', v);
+          value[v] = '\0';
+          if (v != 0)
+            value[v - 1] = 'V';
+
+          size_t length = 0;
+          for (size_t i = 0; i < align; ++i)
+            buf[length++] = '\n';
+          length += ACE_OS::sprintf (buf + length,
+                                     "HTTP/1.1 200 OK\r\n%s:%s\r\nA:%s\n\n",
+                                     name, value, value);
+
+          for (size_t step = 0; step < 2; ++step)
+            {
+              parser.reset ();
+              CHECK (feed (parser, buf, length, step)
+                       == HeaderParser::PARSE_COMPLETE);
+              CHECK (parser.header_length () == length);
+              CHECK (parser.count () == 2);
+              CHECK (equals (parser.start_line (), "HTTP/1.1 200 OK"));
+              CHECK (parser.count () == 2
+                     && equals (parser.name (0), name)
+                     && equals (parser.value (0), value)
+                     && equals (parser.name (1), "A")
+                     && equals (parser.value (1), value));
+            }
+        }
+}
+
+void test_limits ()
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) limits\n")));
+
+  char buf[8192];
+
+  // length of the head
+  HeaderParser small (64, 2);
+  ACE_OS::strcpy (buf, "GET / HTTP/1.1\r\nA: 1\r\n\r\n");
+  CHECK (small.parse (buf, ACE_OS::strlen (buf))
+           == HeaderParser::PARSE_COMPLETE);
+  small.reset ();
+  ACE_OS::strcpy (buf, "GET / HTTP/1.1\r\nA: ");
+  ACE_OS::memset (buf + 19, 'a', 60);
+  ACE_OS::strcpy (buf + 79, "\r\n\r\n");
+  CHECK (small.parse (buf, ACE_OS::strlen (buf))
+           == HeaderParser::PARSE_ERROR);
+  CHECK (small.status () == HeaderParser::PARSE_ERROR);
+
+  // without a line end in sight
+  small.reset ();
+  CHECK (small.parse (buf, 60) == HeaderParser::PARSE_INCOMPLETE);
+  CHECK (small.parse (buf, 70) == HeaderParser::PARSE_ERROR);
+
+  // number of headers
+  small.reset ();
+  ACE_OS::strcpy (buf, "GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\nC: 3\r\n\r\n");
+  CHECK (small.parse (buf, ACE_OS::strlen (buf))
+           == HeaderParser::PARSE_ERROR);
+
+  HeaderParser parser;
+  size_t length = ACE_OS::sprintf (buf, "GET / HTTP/1.1\r\n");
+  for (int i = 0; i < HeaderParser::DEFAULT_MAX_HEADERS; ++i)
+    length += ACE_OS::sprintf (buf + length, "H%d: %d\r\n", i, i);
+  ACE_OS::strcpy (buf + length, "\r\n");
+  CHECK (parser.parse (buf, length + 2) == HeaderParser::PARSE_COMPLETE);
+  CHECK (parser.count () == HeaderParser::DEFAULT_MAX_HEADERS);
+  CHECK (parser.find ("h127") == 127);
+  CHECK (equals (parser.value (127), "127"));
+
+  parser.reset ();
+  length += ACE_OS::sprintf (buf + length, "Extra: 1\r\n\r\n");
+  CHECK (parser.parse (buf, length) == HeaderParser::PARSE_ERROR);
+
+  // name and value lengths
+  size_t const limits[] = { HeaderParser::MAX_NAME_LENGTH,
+                            HeaderParser::MAX_VALUE_LENGTH };
+  for (size_t i = 0; i < 2; ++i)
+    for (size_t over = 0; over < 2; ++over)
+      {
+        size_t const size = limits[i] + over;
+        length = ACE_OS::sprintf (buf, "GET / HTTP/1.1\r\n");
+        if (i == 0)
+          {
+            ACE_OS::memset (buf + length, 'n', size);
+            length += size;
+            length += ACE_OS::sprintf (buf + length, ": v\r\n\r\n");
+          }
+        else
+          {
+            length += ACE_OS::sprintf (buf + length, "N: ");
+            ACE_OS::memset (buf + length, 'v', size);
+            length += size;
+            length += ACE_OS::sprintf (buf + length, "\r\n\r\n");
+          }
+        parser.reset ();
+        CHECK (parser.parse (buf, length)
+                 == (over ? HeaderParser::PARSE_ERROR
+                          : HeaderParser::PARSE_COMPLETE));
+      }
+
+  // a value continued past its limit
+  length = ACE_OS::sprintf (buf, "GET / HTTP/1.1\r\nN: v\r\n");
+  for (int i = 0; i < 100; ++i)
+    {
+      buf[length++] = ' ';
+      ACE_OS::memset (buf + length, 'v', 60);
+      length += 60;
+      length += ACE_OS::sprintf (buf + length, "\r\n");
+    }
+  length += ACE_OS::sprintf (buf + length, "\r\n");
+  parser.reset ();
+  CHECK (parser.parse (buf, length) == HeaderParser::PARSE_ERROR);
+}
+
+void test_malformed ()
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) malformed lines\n")));
+
+  // Lines without a colon and continuations before the first header
+  // are skipped, as HeaderBase::read (std::istream&) does.
+  const char* head =
+    "\n\r\n"
+    "HTTP/1.0   204\r\n"
+    " continued nothing\r\n"
+    "no colon here\r\n"
+    ":\r\n"
+    "Name:value:more\n"
+    "\r\n";
+  HeaderParser parser;
+  CHECK (parser.parse (head, ACE_OS::strlen (head))
+           == HeaderParser::PARSE_COMPLETE);
+  CHECK (parser.count () == 2);
+  CHECK (equals (parser.name (0), "") && equals (parser.value (0), ""));
+  CHECK (equals (parser.name (1), "Name"));
+  CHECK (equals (parser.value (1), "value:more"));
+
+  HeaderParser::View version, status, reason;
+  CHECK (parser.split_start_line (version, status, reason));
+  CHECK (equals (version, "HTTP/1.0"));
+  CHECK (equals (status, "204"));
+  CHECK (equals (reason, ""));
+
+  // a start line of one word
+  parser.reset ();
+  head = "HTTP/1.1\r\n\r\n";
+  CHECK (parser.parse (head, ACE_OS::strlen (head))
+           == HeaderParser::PARSE_COMPLETE);
+  CHECK (!parser.split_start_line (version, status, reason));
+
+  // a head that does not end
+  parser.reset ();
+  head = "GET / HTTP/1.1\r\nHost: a\r\n\r";
+  CHECK (parser.parse (head, ACE_OS::strlen (head))
+           == HeaderParser::PARSE_INCOMPLETE);
+  CHECK (parser.count () == 1);
+}
+
+void test_read ()
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) reading messages from a parser\n")));
+
+  size_t const length = ACE_OS::strlen (REQUEST);
+  HeaderParser parser;
+
+  // incomplete heads are not read
+  ACE::INet::HeaderBase header;
+  CHECK (parser.parse (REQUEST, length / 2) == HeaderParser::PARSE_INCOMPLETE);
+  CHECK (!header.read (parser));
+
+  CHECK (parser.parse (REQUEST, length) == HeaderParser::PARSE_COMPLETE);
+  CHECK (header.read (parser));
+  ACE_CString value;
+  CHECK (header.get ("Folded", value) && value == "one  two\tthree");
+
+  // the same headers as read from a stream, which takes the line
+  // after an empty value for the value
+  const char* const headers =
+    "Host: example.com:80\r\n"
+    "Folded: one\r\n"
+    "  two\r\n"
+    "\tthree\r\n"
+    "Cookie: a=1\r\n"
+    "Cookie: b=2\n"
+    "\r\n";
+  char buf[256];
+  ACE_OS::sprintf (buf, "GET / HTTP/1.1\r\n%s", headers);
+  parser.reset ();
+  CHECK (parser.parse (buf, ACE_OS::strlen (buf))
+           == HeaderParser::PARSE_COMPLETE);
+  ACE::INet::HeaderBase parsed;
+  CHECK (parsed.read (parser));
+  std::istringstream in (headers);
+  ACE::INet::HeaderBase streamed;
+  CHECK (streamed.read (in));
+  std::ostringstream parsed_out, streamed_out;
+  parsed.write (parsed_out);
+  streamed.write (streamed_out);
+  CHECK (parsed_out.str () == streamed_out.str ());
+
+  parser.reset ();
+  CHECK (parser.parse (REQUEST, length) == HeaderParser::PARSE_COMPLETE);
+
+  ACE::HTTP::Request request;
+  CHECK (request.read (parser));
+  CHECK (request.get_method () == "GET");
+  CHECK (request.get_URI () == "/a:b?x=1");
+  CHECK (request.get_version () == "HTTP/1.1");
+  CHECK (request.get_host () == "example.com:80");
+  CHECK (request.has ("Empty"));
+
+  // limits of the request line
+  ACE_OS::sprintf (buf, "%s / HTTP/1.1\r\n\r\n",
+                   "A-METHOD-NAME-LONGER-THAN-32-BYTES");
+  parser.reset ();
+  CHECK (parser.parse (buf, ACE_OS::strlen (buf))
+           == HeaderParser::PARSE_COMPLETE);
+  CHECK (!ACE::HTTP::Request ().read (parser));
+  ACE_OS::strcpy (buf, "GET /\r\n\r\n");
+  parser.reset ();
+  CHECK (parser.parse (buf, ACE_OS::strlen (buf))
+           == HeaderParser::PARSE_COMPLETE);
+  CHECK (!ACE::HTTP::Request ().read (parser));
+
+  ACE::HTTP::Response response;
+  ACE_OS::strcpy (buf,
+                  "HTTP/1.1 404 Not Found\r\n"
+                  "Content-Length: 0\r\n"
+                  "\r\n");
+  parser.reset ();
+  CHECK (parser.parse (buf, ACE_OS::strlen (buf))
+           == HeaderParser::PARSE_COMPLETE);
+  CHECK (response.read (parser));
+  CHECK (response.get_version () == "HTTP/1.1");
+  CHECK (response.get_status ().get_status () == 404);
+  CHECK (response.get_status ().get_reason () == "Not Found");
+  CHECK (response.get_content_length () == 0);
+
+  // limits of the status line
+  ACE_OS::strcpy (buf, "HTTP/1.1 2000 OK\r\n\r\n");
+  parser.reset ();
+  CHECK (parser.parse (buf, ACE_OS::strlen (buf))
+           == HeaderParser::PARSE_COMPLETE);
+  CHECK (!ACE::HTTP::Response ().read (parser));
+  ACE_OS::strcpy (buf, "HTTP/1.1.1 200 OK\r\n\r\n");
+  parser.reset ();
+  CHECK (parser.parse (buf, ACE_OS::strlen (buf))
+           == HeaderParser::PARSE_COMPLETE);
+  CHECK (!ACE::HTTP::Response ().read (parser));
+}
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%P|%t) HeaderParser test started\n")));
+
+  test_feeds ();
+  test_scan ();
+  test_limits ();
+  test_malformed ();
+  test_read ();
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("(%P|%t) HeaderParser test finished, %d failures\n"),
+              n_fails));
+  return n_fails == 0 ? 0 : 1;
+}
@@ -0,0 +1,231 @@
+// file      : Reactive.cpp
+// cvs-id    : $Id$
+
+// Sends and receives over two sockets run by one reactor, without
+// threads of their own. The link drops and reorders messages, so
+// all of them arrive in order only if the lost ones are asked for
+// again and retransmitted.
+
+#include "ace/Log_Msg.h"
+#include "ace/Reactor.h"
+#include "ace/Select_Reactor.h"
+#include "ace/Event_Handler.h"
+#include "ace/OS_NS_string.h"
+
+#include "ace/RMCast/Socket.h"
+
+#include "Protocol.h"
+
+class args {};
+
+class Handler: public ACE_Event_Handler
+{
+public:
+  Handler (ACE_Reactor& reactor,
+           ACE_RMCast::Socket& sender,
+           ACE_RMCast::Socket& receiver)
+      : ACE_Event_Handler (&reactor),
+        sender_ (sender),
+        receiver_ (receiver),
+        sent_ (0),
+        received_ (0),
+        skipped_ (0),
+        next_ (0),
+        damaged_ (0),
+        lost_ (0)
+  {
+    for (unsigned short i = 0; i < payload_size; i++)
+    {
+      expected_.payload[i] = i;
+    }
+  }
+
+  // Receive all messages which came in.
+  //
+  virtual int
+  handle_input (ACE_HANDLE)
+  {
+    Message msg;
+
+    while (true)
+    {
+      ssize_t s = receiver_.recv (&msg, sizeof (msg), ACE_Time_Value::zero);
+
+      if (s == -1)
+      {
+        if (errno == ENOENT)
+        {
+          // The sender does not have it anymore.
+          //
+          ++lost_;
+          ++next_;
+          continue;
+        }
+
+        break; // ETIME, nothing more for now.
+      }
+
+      // It is ok to miss some number of messages at the beginning,
+      // before the receiver heard of the sender.
+      //
+      if (received_ == 0 && s == sizeof (msg) && msg.sn < message_count)
+      {
+        skipped_ = next_ = msg.sn;
+      }
+
+      if (s != sizeof (msg) ||
+          msg.sn != next_ ||
+          ACE_OS::memcmp (expected_.payload,
+                          msg.payload,
+                          payload_size * sizeof (short)) != 0)
+      {
+        ++damaged_;
+      }
+
+      ++received_;
+      ++next_;
+    }
+
+    if (next_ >= message_count)
+      reactor ()->end_reactor_event_loop ();
+
+    return 0;
+  }
+
+  // Send a few messages every time.
+  //
+  virtual int
+  handle_timeout (ACE_Time_Value const&, void const*)
+  {
+    Message msg;
+    ACE_OS::memcpy (msg.payload, expected_.payload, sizeof (msg.payload));
+
+    for (int i = 0; i < 4 && sent_ < message_count; ++i, ++sent_)
+    {
+      msg.sn = sent_;
+      sender_.send (&msg, sizeof (msg));
+    }
+
+    return 0;
+  }
+
+  unsigned long
+  sent () const
+  {
+    return sent_;
+  }
+
+  unsigned long
+  received () const
+  {
+    return received_;
+  }
+
+  unsigned long
+  skipped () const
+  {
+    return skipped_;
+  }
+
+  unsigned long
+  damaged () const
+  {
+    return damaged_;
+  }
+
+  unsigned long
+  lost () const
+  {
+    return lost_;
+  }
+
+private:
+  ACE_RMCast::Socket& sender_;
+  ACE_RMCast::Socket& receiver_;
+
+  Message expected_;
+
+  unsigned long sent_;
+  unsigned long received_;
+  unsigned long skipped_;
+  unsigned long next_;
+  unsigned long damaged_;
+  unsigned long lost_;
+};
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR* argv[])
+{
+  try
+  {
+    if (argc < 2) throw args ();
+
+    ACE_INET_Addr addr (argv[1]);
+
+    ACE_Select_Reactor select_reactor;
+    ACE_Reactor reactor (&select_reactor);
+
+    // Turn on message loss and reordering simulation, and run both
+    // sockets in the reactor.
+    //
+    ACE_RMCast::Parameters params (true,
+                                   1470,
+                                   ACE_Time_Value (0, 2000),
+                                   1,
+                                   10,
+                                   500,
+                                   50,
+                                   &reactor);
+
+    //FUZZ: disable check_for_lack_ACE_OS
+    ACE_RMCast::Socket sender (addr, false, params);
+    ACE_RMCast::Socket receiver (addr, false, params);
+    //FUZZ: enable check_for_lack_ACE_OS
+
+    Handler handler (reactor, sender, receiver);
+
+    reactor.register_handler (receiver.get_handle (),
+                              &handler,
+                              ACE_Event_Handler::READ_MASK);
+
+    reactor.schedule_timer (&handler,
+                            0,
+                            ACE_Time_Value (0, 1000),
+                            ACE_Time_Value (0, 1000));
+
+    ACE_Time_Value timeout (30, 0);
+    reactor.run_reactor_event_loop (timeout);
+
+    reactor.cancel_timer (&handler);
+    reactor.remove_handler (receiver.get_handle (),
+                            ACE_Event_Handler::READ_MASK |
+                            ACE_Event_Handler::DONT_CALL);
+
+    ACE_DEBUG ((LM_DEBUG,
+                "sent      : %d\n"
+                "received  : %d\n"
+                "skipped   : %d\n"
+                "lost      : %d\n"
+                "damaged   : %d\n",
+                static_cast<int> (handler.sent ()),
+                static_cast<int> (handler.received ()),
+                static_cast<int> (handler.skipped ()),
+                static_cast<int> (handler.lost ()),
+                static_cast<int> (handler.damaged ())));
+
+    if (handler.skipped () + handler.received () != message_count ||
+        handler.received () < message_count / 2 ||
+        handler.lost () != 0 ||
+        handler.damaged () != 0)
+      return 1;
+
+    return 0;
+  }
+  catch (args const&)
+  {
+    ACE_ERROR ((LM_ERROR,
+                "usage: %s <IPv4 multicast address>:<port>\n", argv[0]));
+  }
+
+  return 1;
+}
@@ -36,4 +36,17 @@ $sender->Kill ();
 $target1->GetStderrLog();
 $target2->GetStderrLog();
 
+# Send and receive in one reactor, with loss and retransmission.
+#
+my $reactive = $target1->CreateProcess("reactive", "224.1.2.3:12345");
+
+$reactive_status = $reactive->SpawnWaitKill ($target1->ProcessStopWaitInterval() + 30);
+
+if ($reactive_status != 0) {
+    print STDERR "ERROR: reactive returned $reactive_status\n";
+    $status = 1;
+}
+
+$target1->GetStderrLog();
+
 exit $status;
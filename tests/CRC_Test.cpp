@@ -0,0 +1,229 @@
+//=============================================================================
+/**
+ *  @file    CRC_Test.cpp
+ *
+ *  $Id$
+ *
+ *    This test checks <ACE::crc32>, <ACE::crc32c> and <ACE::hash64>
+ *    against published check values, compares the table and hardware
+ *    driven CRCs with a bit at a time reference on buffers of every
+ *    length and alignment, and times them against <ACE::hash_pjw>.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/ACE.h"
+#include "ace/Functor.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_stdlib.h"
+
+// Bit at a time CRC with the reversed polynomial <poly>.
+static ACE_UINT32
+reference_crc (ACE_UINT32 poly, const char *buf, size_t len)
+{
+  ACE_UINT32 crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < len; ++i)
+    {
+      crc ^= static_cast<unsigned char> (buf[i]);
+      for (int k = 0; k < 8; ++k)
+        crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+    }
+  return ~crc;
+}
+
+static int
+test_check_values (void)
+{
+  int status = 0;
+  const char check[] = "123456789";
+  const char spam[] = "Nobody inspects the spammish repetition";
+
+  struct
+  {
+    const char *name;
+    ACE_UINT64 got;
+    ACE_UINT64 expected;
+  } const values[] =
+    {
+      { "crc32", ACE::crc32 (check), 0xCBF43926 },
+      { "crc32c", ACE::crc32c (check), 0xE3069283 },
+      { "hash64 (\"\")", ACE::hash64 ("", 0),
+        ACE_UINT64_LITERAL (0xEF46DB3751D8E999) },
+      { "hash64 (check)", ACE::hash64 (check, 9),
+        ACE_UINT64_LITERAL (0x8CB841DB40E6AE83) },
+      { "hash64 (check, 1)", ACE::hash64 (check, 9, 1),
+        ACE_UINT64_LITERAL (0x1A4CC2C9E8079790) },
+      { "hash64 (spam)", ACE::hash64 (spam, sizeof spam - 1),
+        ACE_UINT64_LITERAL (0xFBCEA83C8A378BF1) }
+    };
+
+  for (size_t i = 0; i < sizeof values / sizeof values[0]; ++i)
+    if (values[i].got != values[i].expected)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("%C is %Q, expected %Q\n"),
+                    values[i].name,
+                    values[i].got,
+                    values[i].expected));
+        status = 1;
+      }
+
+  // Feeding the CRCs in pieces must give the same result.
+  iovec iov[3];
+  iov[0].iov_base = const_cast<char *> (check);
+  iov[0].iov_len = 2;
+  iov[1].iov_base = const_cast<char *> (check + 2);
+  iov[1].iov_len = 0;
+  iov[2].iov_base = const_cast<char *> (check + 2);
+  iov[2].iov_len = 7;
+
+  if (ACE::crc32 (iov, 3) != 0xCBF43926
+      || ACE::crc32 (check + 4, 5, ACE::crc32 (check, 4)) != 0xCBF43926)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("split crc32 mismatch\n")));
+      status = 1;
+    }
+
+  if (ACE::crc32c (iov, 3) != 0xE3069283
+      || ACE::crc32c (check + 4, 5, ACE::crc32c (check, 4)) != 0xE3069283)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("split crc32c mismatch\n")));
+      status = 1;
+    }
+
+#if !defined (ACE_USES_PJW_STRING_HASH)
+  ACE_Hash<const char *> hash;
+  if (hash (check) != static_cast<unsigned long> (ACE::hash64 (check, 9)))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("ACE_Hash<const char *> does not use hash64\n")));
+      status = 1;
+    }
+#endif /* !ACE_USES_PJW_STRING_HASH */
+
+  return status;
+}
+
+static int
+test_alignments (void)
+{
+  const size_t size = 300;
+  char buf[size + 16];
+  for (size_t i = 0; i < sizeof buf; ++i)
+    buf[i] = static_cast<char> (ACE_OS::rand ());
+
+  for (size_t offset = 0; offset < 16; ++offset)
+    for (size_t len = 0; len <= size; ++len)
+      {
+        const char *p = buf + offset;
+        if (ACE::crc32 (p, len) != reference_crc (0xEDB88320, p, len))
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("crc32 mismatch at offset %B ")
+                             ACE_TEXT ("length %B\n"),
+                             offset,
+                             len),
+                            1);
+        if (ACE::crc32c (p, len) != reference_crc (0x82F63B78, p, len))
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("crc32c mismatch at offset %B ")
+                             ACE_TEXT ("length %B\n"),
+                             offset,
+                             len),
+                            1);
+      }
+
+  // hash64 must not depend on the alignment of the key either.
+  char copy[size + 16];
+  for (size_t len = 0; len <= size; ++len)
+    {
+      ACE_UINT64 const h = ACE::hash64 (buf, len);
+      for (size_t offset = 1; offset < 16; ++offset)
+        {
+          ACE_OS::memcpy (copy + offset, buf, len);
+          if (ACE::hash64 (copy + offset, len) != h)
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               ACE_TEXT ("hash64 depends on alignment ")
+                               ACE_TEXT ("at offset %B length %B\n"),
+                               offset,
+                               len),
+                              1);
+        }
+    }
+
+  return 0;
+}
+
+static void
+report (const ACE_TCHAR *name,
+        ACE_High_Res_Timer &timer,
+        size_t bytes)
+{
+  ACE_hrtime_t ns = 0;
+  timer.elapsed_time (ns);
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-12s %Q MB/s\n"),
+              name,
+              ns == 0 ? ACE_UINT64 (0)
+                      : static_cast<ACE_UINT64> (bytes) * 1000 / ns));
+}
+
+static void
+time_functions (void)
+{
+  const size_t size = 64 * 1024;
+  const int rounds = 200;
+  char *buf = new char[size];
+  for (size_t i = 0; i < size; ++i)
+    buf[i] = static_cast<char> (i * 31);
+
+  // Accumulated so the calls can't be optimized away.
+  ACE_UINT64 sum = 0;
+
+  ACE_High_Res_Timer pjw_timer;
+  pjw_timer.start ();
+  for (int r = 0; r < rounds; ++r)
+    sum += ACE::hash_pjw (buf, size);
+  pjw_timer.stop ();
+
+  ACE_High_Res_Timer hash64_timer;
+  hash64_timer.start ();
+  for (int r = 0; r < rounds; ++r)
+    sum += ACE::hash64 (buf, size);
+  hash64_timer.stop ();
+
+  ACE_High_Res_Timer crc32_timer;
+  crc32_timer.start ();
+  for (int r = 0; r < rounds; ++r)
+    sum += ACE::crc32 (buf, size);
+  crc32_timer.stop ();
+
+  ACE_High_Res_Timer crc32c_timer;
+  crc32c_timer.start ();
+  for (int r = 0; r < rounds; ++r)
+    sum += ACE::crc32c (buf, size);
+  crc32c_timer.stop ();
+
+  size_t const bytes = size * rounds;
+  report (ACE_TEXT ("hash_pjw"), pjw_timer, bytes);
+  report (ACE_TEXT ("hash64"), hash64_timer, bytes);
+  report (ACE_TEXT ("crc32"), crc32_timer, bytes);
+  report (ACE_TEXT ("crc32c"), crc32c_timer, bytes);
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("(checksum %Q)\n"), sum));
+
+  delete [] buf;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("CRC_Test"));
+
+  int status = test_check_values ();
+  status += test_alignments ();
+  time_functions ();
+
+  ACE_END_TEST;
+  return status;
+}
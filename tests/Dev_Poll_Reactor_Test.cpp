@@ -36,10 +36,18 @@
 
 #include "ace/OS_NS_unistd.h"
 #include "ace/OS_NS_netdb.h"
+#include "ace/OS_NS_sys_socket.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/Flag_Manip.h"
 
 
 typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> SVC_HANDLER;
 
+// Largest number of bytes a Server reads per upcall.  In the batched
+// pass it only reads a few, and returns 1 to be called back for the
+// rest.
+static size_t server_read_size = BUFSIZ;
+
 // ----------------------------------------------------
 
 class Client : public SVC_HANDLER
@@ -212,7 +220,7 @@ Server::handle_input (ACE_HANDLE /* handle */)
   ssize_t bytes_read = 0;
 
   char * const begin = buffer;
-  char * const end   = buffer + BUFSIZ;
+  char * const end   = buffer + server_read_size;
 
   for (char * buf = begin; buf < end; buf += bytes_read)
     {
@@ -254,7 +262,8 @@ Server::handle_input (ACE_HANDLE /* handle */)
 
   ACE_DEBUG ((LM_INFO, ACE_TEXT ("(%t) Message received: %s\n"), buffer));
 
-  return 0;
+  // The buffer filled up, so there may be more to read.
+  return bytes_read != -1 && server_read_size < BUFSIZ ? 1 : 0;
 }
 
 int
@@ -478,12 +487,21 @@ disable_signal (int sigmin, int sigmax)
 
 // ----------------------------------------------------
 
+struct server_arg
+{
+  unsigned short port;
+
+  // Run the server reactor in batched, edge triggered mode.
+  bool batched;
+};
+
 ACE_THR_FUNC_RETURN
 server_worker (void *p)
 {
   disable_signal (SIGPIPE, SIGPIPE);
 
-  const unsigned short port = *(static_cast<unsigned short *> (p));
+  server_arg const &arg = *(static_cast<server_arg *> (p));
+  const unsigned short port = arg.port;
 
   ACE_INET_Addr addr;
 
@@ -500,6 +518,19 @@ server_worker (void *p)
   dp_reactor.restart (1);     // Restart on EINTR
   ACE_Reactor reactor (&dp_reactor);
 
+#if defined (ACE_HAS_EVENT_POLL)
+  // The server handlers read speculatively, so they can be driven by
+  // the batched, edge triggered mode; the client uses the default one.
+  if (arg.batched && dp_reactor.batch_events (64) != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%t) %p\n"),
+                  ACE_TEXT ("server_worker - batch_events")));
+
+      return (void *) -1;
+    }
+#endif /* ACE_HAS_EVENT_POLL */
+
   TestAcceptor server;
 
   int flags = 0;
@@ -534,22 +565,12 @@ server_worker (void *p)
 
 // ----------------------------------------------------
 
-// struct server_arg
-// {
-//   unsigned short port;
-
-//   ACE_Condition<ACE_SYNCH_MUTEX> * cv;
-// };
-
-// ----------------------------------------------------
-
-int
-run_main (int, ACE_TCHAR *[])
+static int
+run_pass (bool batched)
 {
-  ACE_START_TEST (ACE_TEXT ("Dev_Poll_Reactor_Test"));
-
-  // Make sure we ignore SIGPIPE
-  disable_signal (SIGPIPE, SIGPIPE);
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("(%t) Running the server in %C mode\n"),
+              batched ? "batched" : "default"));
 
   ACE_Dev_Poll_Reactor dp_reactor;
   dp_reactor.restart (1);          // Restart on EINTR
@@ -567,16 +588,11 @@ run_main (int, ACE_TCHAR *[])
                        ACE_TEXT ("Unable to open client service handler")),
                       -1);
 
-//   ACE_SYNCH_MUTEX mutex;
-//   ACE_Condition<ACE_SYNCH_MUTEX> cv (mutex);
-
-//   server_arg arg;
-//   arg.port = 54678;  // Port the server will listen on.
-//   arg.cv = &cv;
-
-  unsigned short port = 54678;
+  server_arg arg;
+  arg.port = 54678;  // Port the server will listen on.
+  arg.batched = batched;
 
-  if (ACE_Thread_Manager::instance ()->spawn (server_worker, &port) == -1)
+  if (ACE_Thread_Manager::instance ()->spawn (server_worker, &arg) == -1)
     ACE_ERROR_RETURN ((LM_ERROR,
                        ACE_TEXT ("(%t) %p\n"),
                        ACE_TEXT ("Unable to spawn server thread")),
@@ -585,7 +601,7 @@ run_main (int, ACE_TCHAR *[])
   ACE_OS::sleep (5);  // Wait for the listening endpoint to be set up.
 
   ACE_INET_Addr addr;
-  if (addr.set (port, INADDR_LOOPBACK) != 0)
+  if (addr.set (arg.port, INADDR_LOOPBACK) != 0)
     ACE_ERROR_RETURN ((LM_ERROR,
                        ACE_TEXT ("(%t) %p\n"),
                        ACE_TEXT ("ACE_INET_Addr::set")),
@@ -612,9 +628,145 @@ run_main (int, ACE_TCHAR *[])
                        ACE_TEXT ("Error waiting for threads to complete")),
                       -1);
 
+  return 0;
+}
+
+#if defined (ACE_HAS_EVENT_POLL)
+/**
+ * @class Chunk_Reader
+ *
+ * Reads a few bytes per upcall, returning 1 to be called back for the
+ * rest, until the end of the stream.
+ */
+class Chunk_Reader : public ACE_Event_Handler
+{
+public:
+  Chunk_Reader (ACE_HANDLE handle)
+    : handle_ (handle), received_ (0), closed_ (false)
+  {
+  }
+
+  virtual ACE_HANDLE get_handle (void) const
+  {
+    return this->handle_;
+  }
+
+  virtual int handle_input (ACE_HANDLE)
+  {
+    char buffer[256];
+    ssize_t const n = ACE_OS::recv (this->handle_, buffer, sizeof buffer);
+    if (n > 0)
+      {
+        this->received_ += n;
+        return 1;
+      }
+    return n == -1 && errno == EWOULDBLOCK ? 0 : -1;
+  }
+
+  virtual int handle_close (ACE_HANDLE, ACE_Reactor_Mask)
+  {
+    this->closed_ = true;
+    return 0;
+  }
+
+  ACE_HANDLE handle_;
+  size_t received_;
+  bool closed_;
+};
+
+// Data and the hangup of the peer reported together: the handler
+// reading the data in chunks must get all of it before it is removed.
+
+static int
+test_hangup_with_data (void)
+{
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("(%t) Reading the data sent before a hangup\n")));
+
+  ACE_HANDLE fds[2];
+  if (ACE_OS::socketpair (AF_UNIX, SOCK_STREAM, 0, fds) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) %p\n"),
+                       ACE_TEXT ("socketpair")),
+                      -1);
+
+  char data[4096] = { 0 };
+  if (ACE_OS::send (fds[1], data, sizeof data) != sizeof data)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) %p\n"),
+                       ACE_TEXT ("send")),
+                      -1);
+  ACE_OS::closesocket (fds[1]);
+  ACE::set_flags (fds[0], ACE_NONBLOCK);
+
+  ACE_Dev_Poll_Reactor dp_reactor;
+  ACE_Reactor reactor (&dp_reactor);
+  Chunk_Reader reader (fds[0]);
+
+  int status = 0;
+  if (dp_reactor.batch_events (64) != 0
+      || reactor.register_handler (&reader,
+                                   ACE_Event_Handler::READ_MASK) != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%t) %p\n"),
+                  ACE_TEXT ("register_handler")));
+      status = -1;
+    }
+
+  ACE_Time_Value const deadline =
+    ACE_OS::gettimeofday () + ACE_Time_Value (5);
+  while (status == 0
+         && !reader.closed_
+         && ACE_OS::gettimeofday () < deadline)
+    {
+      ACE_Time_Value timeout (0, 100000);
+      reactor.handle_events (timeout);
+    }
+
+  if (status == 0 && (!reader.closed_ || reader.received_ != sizeof data))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%t) %B of %B bytes read before the ")
+                  ACE_TEXT ("handler was %C\n"),
+                  reader.received_,
+                  sizeof data,
+                  reader.closed_ ? "removed" : "left"));
+      status = -1;
+    }
+
+  if (!reader.closed_)
+    reactor.remove_handler (&reader,
+                            ACE_Event_Handler::ALL_EVENTS_MASK
+                            | ACE_Event_Handler::DONT_CALL);
+  ACE_OS::closesocket (fds[0]);
+  return status;
+}
+#endif /* ACE_HAS_EVENT_POLL */
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Dev_Poll_Reactor_Test"));
+
+  // Make sure we ignore SIGPIPE
+  disable_signal (SIGPIPE, SIGPIPE);
+
+  int status = run_pass (false);
+
+#if defined (ACE_HAS_EVENT_POLL)
+  // Read in small pieces, so that the handlers ask to be called back
+  // and the edge triggered server relies on the reactor to do so.
+  server_read_size = 256;
+  if (status == 0)
+    status = run_pass (true);
+  if (status == 0)
+    status = test_hangup_with_data ();
+#endif /* ACE_HAS_EVENT_POLL */
+
   ACE_END_TEST;
 
-  return 0;
+  return status;
 }
 
 #else
@@ -0,0 +1,370 @@
+//=============================================================================
+/**
+ *  @file    Flat_Hash_Map_Test.cpp
+ *
+ *  $Id$
+ *
+ *    This test checks <ACE_Flat_Hash_Map>: binds, finds, rebinds and
+ *    unbinds with string and integer keys, growth of the table, reuse
+ *    of the slots of unbound entries, and iteration.  It then times
+ *    it against <ACE_Hash_Map_Manager_Ex> with the same keys.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/Flat_Hash_Map_T.h"
+#include "ace/Hash_Map_Manager.h"
+#include "ace/SString.h"
+#include "ace/Null_Mutex.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_string.h"
+
+typedef ACE_Flat_Hash_Map<ACE_CString,
+                          ACE_CString,
+                          ACE_Hash<ACE_CString>,
+                          ACE_Equal_To<ACE_CString>,
+                          ACE_Null_Mutex> STRING_MAP;
+
+typedef ACE_Flat_Hash_Map<int,
+                          int,
+                          ACE_Hash<int>,
+                          ACE_Equal_To<int>,
+                          ACE_Null_Mutex> INT_MAP;
+
+typedef ACE_Hash_Map_Manager_Ex<int,
+                                int,
+                                ACE_Hash<int>,
+                                ACE_Equal_To<int>,
+                                ACE_Null_Mutex> HASH_INT_MAP;
+
+struct String_Table
+{
+  const char *key_;
+  const char *value_;
+};
+
+static String_Table string_table[] =
+{
+  { "hello", "guten Tag" },
+  { "goodbye", "auf wiedersehen" },
+  { "funny", "lustig" },
+  { "ace", "adaptive communication environment" },
+  { "map", "Karte" },
+  { 0, 0 }
+};
+
+static int
+test_strings (void)
+{
+  STRING_MAP map (2);
+  size_t i;
+
+  for (i = 0; string_table[i].key_ != 0; ++i)
+    if (map.bind (string_table[i].key_, string_table[i].value_) != 0)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("bind of %C failed\n"),
+                         string_table[i].key_),
+                        -1);
+
+  if (map.current_size () != i)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%B entries instead of %B\n"),
+                       map.current_size (),
+                       i),
+                      -1);
+
+  for (i = 0; string_table[i].key_ != 0; ++i)
+    {
+      ACE_CString value;
+      if (map.find (string_table[i].key_, value) != 0
+          || value != string_table[i].value_)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("find of %C failed\n"),
+                           string_table[i].key_),
+                          -1);
+
+      // Binding again doesn't change the map.
+      if (map.bind (string_table[i].key_, "x") != 1)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("bind of existing %C didn't return 1\n"),
+                           string_table[i].key_),
+                          -1);
+
+      // trybind passes back the value in the map.
+      ACE_CString other ("x");
+      if (map.trybind (string_table[i].key_, other) != 1
+          || other != string_table[i].value_)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("trybind of existing %C failed\n"),
+                           string_table[i].key_),
+                          -1);
+    }
+
+  if (map.find ("absent") != -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("found absent key\n")), -1);
+
+  ACE_CString old_value;
+  if (map.rebind ("map", "carte", old_value) != 1 || old_value != "Karte")
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("rebind of map failed\n")), -1);
+
+  ACE_CString old_key;
+  if (map.rebind ("plan", "Plan", old_key, old_value) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("rebind of plan failed\n")), -1);
+
+  STRING_MAP::ENTRY *entry = 0;
+  if (map.find ("map", entry) != 0
+      || entry->key () != "map"
+      || entry->item () != "carte")
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("find of map entry failed\n")), -1);
+
+  if (map.unbind (entry) != 0 || map.find ("map") != -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("unbind of map entry failed\n")), -1);
+
+  if (map.unbind ("hello", old_value) != 0 || old_value != "guten Tag")
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("unbind of hello failed\n")), -1);
+
+  if (map.unbind ("hello") != -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("unbound hello twice\n")), -1);
+
+  if (map.current_size () != i - 1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%B entries left instead of %B\n"),
+                       map.current_size (),
+                       i - 1),
+                      -1);
+
+  // The destructor releases the strings still in the map.
+  return 0;
+}
+
+// Check that iterating over <map> in both directions visits each of
+// its entries once, and that they are the multiples of <step> below
+// <limit>.
+static int
+check_iteration (INT_MAP &map, int limit, int step)
+{
+  size_t const expected = static_cast<size_t> ((limit + step - 1) / step);
+  if (map.current_size () != expected)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%B entries instead of %B\n"),
+                       map.current_size (),
+                       expected),
+                      -1);
+
+  char *seen = new char[limit];
+  ACE_OS::memset (seen, 0, limit);
+  size_t count = 0;
+
+  for (INT_MAP::iterator i = map.begin (); i != map.end (); ++i, ++count)
+    {
+      int const key = (*i).key ();
+      if (key < 0 || key >= limit || key % step != 0
+          || (*i).item () != -key || seen[key]++ != 0)
+        {
+          delete [] seen;
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("unexpected entry %d\n"),
+                             key),
+                            -1);
+        }
+    }
+
+  for (INT_MAP::reverse_iterator i = map.rbegin (); i != map.rend (); ++i)
+    if (seen[(*i).key ()]-- != 1)
+      {
+        delete [] seen;
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("reverse iteration visited %d again\n"),
+                           (*i).key ()),
+                          -1);
+      }
+
+  delete [] seen;
+
+  if (count != expected)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("iteration visited %B entries instead of %B\n"),
+                       count,
+                       expected),
+                      -1);
+  return 0;
+}
+
+static int
+test_ints (void)
+{
+  static const int ENTRIES = 20000;
+
+  // Start small, so that the table grows a number of times.
+  INT_MAP map (4);
+  size_t const initial_size = map.total_size ();
+
+  for (int k = 0; k < ENTRIES; ++k)
+    if (map.bind (k, -k) != 0)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("bind of %d failed\n"),
+                         k),
+                        -1);
+
+  if (map.total_size () <= initial_size
+      || map.total_size () < map.current_size ())
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("table didn't grow: %B slots\n"),
+                       map.total_size ()),
+                      -1);
+
+  for (int k = 0; k < ENTRIES; ++k)
+    {
+      int value = 0;
+      if (map.find (k, value) != 0 || value != -k)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("%d not found\n"),
+                           k),
+                          -1);
+    }
+
+  if (check_iteration (map, ENTRIES, 1) != 0)
+    return -1;
+
+  // Unbind the odd keys while iterating, which doesn't move the
+  // other entries.
+  for (INT_MAP::iterator i = map.begin (); i != map.end (); ++i)
+    if ((*i).key () % 2 != 0)
+      map.unbind (&*i);
+
+  if (check_iteration (map, ENTRIES, 2) != 0)
+    return -1;
+
+  // Bind and unbind keys for a while: the slots of the unbound
+  // entries are reused, or cleaned up, instead of growing the table.
+  size_t const total_size = map.total_size ();
+  for (int round = 0; round < 20; ++round)
+    {
+      for (int k = ENTRIES; k < 2 * ENTRIES; k += 8)
+        map.bind (k + round, -(k + round));
+      for (int k = ENTRIES; k < 2 * ENTRIES; k += 8)
+        if (map.unbind (k + round) != 0)
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("unbind of %d failed\n"),
+                             k + round),
+                            -1);
+    }
+
+  if (map.total_size () != total_size)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("table grew from %B to %B slots\n"),
+                       total_size,
+                       map.total_size ()),
+                      -1);
+
+  if (check_iteration (map, ENTRIES, 2) != 0)
+    return -1;
+
+  if (map.unbind_all () != 0 || map.current_size () != 0)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("unbind_all failed\n")), -1);
+  if (map.begin () != map.end () || map.rbegin () != map.rend ())
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("empty map has entries\n")), -1);
+
+  for (int k = 0; k < ENTRIES; k += 3)
+    map.bind (k, -k);
+  if (check_iteration (map, ENTRIES, 3) != 0)
+    return -1;
+
+  // open() with a size makes room for that many entries.
+  if (map.open (1000) != 0 || map.current_size () != 0)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("reopen failed\n")), -1);
+  size_t const opened_size = map.total_size ();
+  for (int k = 0; k < 1000; ++k)
+    map.bind (k, -k);
+  if (map.total_size () != opened_size)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("table of %B slots grew to hold 1000 entries\n"),
+                       opened_size),
+                      -1);
+
+  return 0;
+}
+
+// Time <entries> binds, finds, failed finds and unbinds of integer
+// keys in a <MAP> opened with <size>.
+template <class MAP> void
+time_map (const ACE_TCHAR *name, int entries, size_t size)
+{
+  MAP map (size);
+
+  ACE_High_Res_Timer bind_timer;
+  bind_timer.start ();
+  for (int k = 0; k < entries; ++k)
+    map.bind (k * 7, k);
+  bind_timer.stop ();
+
+  ACE_High_Res_Timer find_timer;
+  int value = 0;
+  find_timer.start ();
+  for (int k = 0; k < entries; ++k)
+    map.find (k * 7, value);
+  find_timer.stop ();
+
+  ACE_High_Res_Timer miss_timer;
+  miss_timer.start ();
+  for (int k = 0; k < entries; ++k)
+    map.find (k * 7 + 1, value);
+  miss_timer.stop ();
+
+  ACE_High_Res_Timer unbind_timer;
+  unbind_timer.start ();
+  for (int k = 0; k < entries; ++k)
+    map.unbind (k * 7);
+  unbind_timer.stop ();
+
+  ACE_hrtime_t bind_ns = 0;
+  ACE_hrtime_t find_ns = 0;
+  ACE_hrtime_t miss_ns = 0;
+  ACE_hrtime_t unbind_ns = 0;
+  bind_timer.elapsed_time (bind_ns);
+  find_timer.elapsed_time (find_ns);
+  miss_timer.elapsed_time (miss_ns);
+  unbind_timer.elapsed_time (unbind_ns);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%s of %B, %d entries: %Q nsecs per bind, ")
+              ACE_TEXT ("%Q per find, %Q per failed find, %Q per unbind\n"),
+              name,
+              size,
+              entries,
+              bind_ns / entries,
+              find_ns / entries,
+              miss_ns / entries,
+              unbind_ns / entries));
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Flat_Hash_Map_Test"));
+
+  int status = 0;
+
+  if (test_strings () != 0)
+    status = 1;
+
+  if (test_ints () != 0)
+    status = 1;
+
+  // With the default size, and with a size for all of the entries.
+  size_t const sizes[] = { ACE_DEFAULT_MAP_SIZE, 100000 };
+  for (size_t i = 0; i < sizeof sizes / sizeof sizes[0]; ++i)
+    {
+      time_map<HASH_INT_MAP> (ACE_TEXT ("ACE_Hash_Map_Manager_Ex"),
+                              100000,
+                              sizes[i]);
+      time_map<INT_MAP> (ACE_TEXT ("ACE_Flat_Hash_Map"),
+                         100000,
+                         sizes[i]);
+    }
+
+  ACE_END_TEST;
+
+  return status;
+}
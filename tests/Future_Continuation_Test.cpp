@@ -0,0 +1,333 @@
+//=============================================================================
+/**
+ *  @file    Future_Continuation_Test.cpp
+ *
+ *  $Id$
+ *
+ *    This test checks the continuations and compositions of
+ *    <ACE_Future>: ACE::then() runs its continuation inline, on an
+ *    <ACE_Work_Stealing_Executor> or in a reactor event loop once the
+ *    future is set; ACE::when_all() and ACE::when_any() set their
+ *    result when all, or the first, of their futures are set.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/Future_Continuation.h"
+#include "ace/Work_Stealing_Executor.h"
+#include "ace/Method_Request.h"
+#include "ace/Reactor.h"
+#include "ace/Select_Reactor.h"
+#include "ace/Thread.h"
+
+#if defined (ACE_HAS_THREADS)
+
+static const int COUNT = 16;
+
+/// Returns its index, as the result of a request for a future.
+class Index_Request : public ACE_Method_Request
+{
+public:
+  Index_Request (int index) : index_ (index) {}
+
+  virtual int call (void)
+  {
+    return this->index_;
+  }
+
+private:
+  int index_;
+};
+
+/// Squares the value of the future, and records the thread it ran in.
+class Square : public ACE_Future_Continuation<int, int>
+{
+public:
+  Square (ACE_thread_t *thr_id = 0) : thr_id_ (thr_id) {}
+
+  virtual int call (const ACE_Future<int> &future)
+  {
+    if (this->thr_id_ != 0)
+      *this->thr_id_ = ACE_Thread::self ();
+
+    int value = 0;
+    future.get (value);
+    return value * value;
+  }
+
+private:
+  ACE_thread_t *thr_id_;
+};
+
+/// Adds up the values of futures all set, once when_all() says so.
+class Sum : public ACE_Future_Continuation<int, long>
+{
+public:
+  Sum (ACE_Future<int> *futures, int count)
+    : futures_ (futures),
+      count_ (count)
+  {
+  }
+
+  virtual long call (const ACE_Future<int> &)
+  {
+    long sum = 0;
+    for (int i = 0; i < this->count_; ++i)
+      {
+        if (!this->futures_[i].ready ())
+          return -1;
+
+        int value = 0;
+        this->futures_[i].get (value);
+        sum += value;
+      }
+    return sum;
+  }
+
+private:
+  ACE_Future<int> *futures_;
+  int count_;
+};
+
+static int
+test_then_inline (void)
+{
+  int status = 0;
+
+  // Already set: the continuation runs in the calling thread.
+  ACE_Future<int> set (7);
+  ACE_Future<int> squared;
+  ACE_thread_t thr_id = 0;
+  if (ACE::then (set, new Square (&thr_id), squared) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("then")), 1);
+
+  int value = 0;
+  if (!squared.ready ()
+      || squared.get (value) == -1
+      || value != 49
+      || !ACE_OS::thr_equal (thr_id, ACE_Thread::self ()))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("inline continuation of a set future got %d\n"),
+                  value));
+      status = 1;
+    }
+
+  // Set later: it runs in the thread setting it.
+  ACE_Future<int> later;
+  ACE_Future<int> later_squared;
+  ACE::then (later, new Square, later_squared);
+  if (later_squared.ready ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("continuation ran too early\n")));
+      status = 1;
+    }
+  later.set (5);
+  value = 0;
+  if (!later_squared.ready ()
+      || later_squared.get (value) == -1
+      || value != 25)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("inline continuation got %d\n"),
+                  value));
+      status = 1;
+    }
+
+  return status;
+}
+
+static int
+test_then_executor (void)
+{
+  int status = 0;
+  ACE_Work_Stealing_Executor executor;
+
+  if (executor.open (2) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), 1);
+
+  ACE_Future<int> results[COUNT];
+  ACE_Future<int> squares[COUNT];
+  for (int i = 0; i < COUNT; ++i)
+    {
+      if (ACE::then (results[i], new Square, squares[i], executor) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("then")),
+                          1);
+      executor.execute (new Index_Request (i), results[i]);
+    }
+
+  // Sum the squares once they are all there, without a thread
+  // waiting for them.
+  ACE_Future<int> all;
+  ACE_Future<long> sum;
+  if (ACE::when_all (squares, COUNT, all) == -1
+      || ACE::then (all, new Sum (squares, COUNT), sum, executor) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("when_all")),
+                      1);
+
+  long total = 0;
+  long expected = 0;
+  for (int i = 0; i < COUNT; ++i)
+    expected += i * i;
+
+  if (sum.get (total) == -1 || total != expected)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("sum of the squares is %d, expected %d\n"),
+                  static_cast<int> (total),
+                  static_cast<int> (expected)));
+      status = 1;
+    }
+
+  executor.close ();
+
+  // A closed executor refuses the continuation, which runs inline.
+  ACE_Future<int> after;
+  ACE_Future<int> after_squared;
+  ACE::then (after, new Square, after_squared, executor);
+  after.set (3);
+  int value = 0;
+  if (after_squared.get (value) == -1 || value != 9)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("continuation refused by the executor got %d\n"),
+                  value));
+      status = 1;
+    }
+
+  return status;
+}
+
+static int
+test_then_reactor (void)
+{
+  int status = 0;
+  ACE_Select_Reactor select_reactor;
+  ACE_Reactor reactor (&select_reactor);
+  reactor.owner (ACE_Thread::self ());
+
+  ACE_Work_Stealing_Executor executor;
+  if (executor.open (1) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), 1);
+
+  ACE_Future<int> result;
+  ACE_Future<int> squared;
+  ACE_thread_t thr_id = 0;
+  if (ACE::then (result, new Square (&thr_id), squared, reactor) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("then")), 1);
+
+  // Set by a worker; the continuation runs here, in the event loop.
+  executor.execute (new Index_Request (6), result);
+
+  for (int i = 0; i < 50 && !squared.ready (); ++i)
+    {
+      ACE_Time_Value tv (0, 100000);
+      reactor.handle_events (tv);
+    }
+
+  executor.close ();
+
+  int value = 0;
+  if (!squared.ready ()
+      || squared.get (value) == -1
+      || value != 36
+      || !ACE_OS::thr_equal (thr_id, ACE_Thread::self ()))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("reactor continuation got %d\n"),
+                  value));
+      status = 1;
+    }
+
+  return status;
+}
+
+static int
+test_when (void)
+{
+  int status = 0;
+
+  ACE_Future<int> futures[COUNT];
+  ACE_Future<int> any;
+  ACE_Future<int> all;
+  if (ACE::when_any (futures, COUNT, any) == -1
+      || ACE::when_all (futures, COUNT, all) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("when")), 1);
+
+  futures[5].set (0);
+  int index = -1;
+  if (!any.ready () || any.get (index) == -1 || index != 5 || all.ready ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("when_any() gave %d, expected 5\n"),
+                  index));
+      status = 1;
+    }
+
+  for (int i = COUNT - 1; i >= 0; --i)
+    {
+      if (all.ready ())
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("when_all() set with %d futures left\n"),
+                      i + 1));
+          status = 1;
+        }
+      futures[i].set (i);
+    }
+
+  index = -1;
+  if (!all.ready () || all.get (index) == -1 || index != 0
+      || any.get (index) == -1 || index != 5)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("when_all() not set\n")));
+      status = 1;
+    }
+
+  // No futures: all of them are set, none can be first.
+  ACE_Future<int> none;
+  if (ACE::when_all (futures, 0, none) == -1 || !none.ready ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("when_all() of no future not set\n")));
+      status = 1;
+    }
+  ACE_Future<int> no_any;
+  if (ACE::when_any (futures, 0, no_any) != -1 || errno != EINVAL)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("when_any() of no future accepted\n")));
+      status = 1;
+    }
+
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Future_Continuation_Test"));
+
+  int status = test_then_inline ();
+  status += test_then_executor ();
+  status += test_then_reactor ();
+  status += test_when ();
+
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Future_Continuation_Test"));
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("Future continuations require threads\n")));
+
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* ACE_HAS_THREADS */
@@ -21,6 +21,8 @@
 #include "ace/Hash_Map_Manager.h"
 #include "ace/Malloc_T.h"
 #include "ace/Null_Mutex.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_string.h"
 
 
 
@@ -180,6 +182,315 @@ int test_two_allocators ()
   return 0;
 }
 
+typedef ACE_Hash_Map_Manager_Ex<int,
+                                int,
+                                ACE_Hash<int>,
+                                ACE_Equal_To<int>,
+                                ACE_Null_Mutex> HASH_INT_MAP;
+
+typedef ACE_Hash_Map_Bucket_Iterator<int,
+                                     int,
+                                     ACE_Hash<int>,
+                                     ACE_Equal_To<int>,
+                                     ACE_Null_Mutex> HASH_INT_BUCKET_ITER;
+
+static const int GROW_ENTRIES = 5000;
+
+// Checks that every way of iterating over <map> visits the entries
+// bound, keys 0 to <count> - 1 with <step> between them, once.
+static int
+check_iteration (HASH_INT_MAP &map, int count, int step)
+{
+  static char seen[GROW_ENTRIES];
+  int const expected = (count + step - 1) / step;
+
+  for (int pass = 0; pass < 3; ++pass)
+    {
+      ACE_OS::memset (seen, 0, sizeof seen);
+      int visited = 0;
+
+      switch (pass)
+        {
+        case 0:
+          for (HASH_INT_MAP::iterator i = map.begin (); i != map.end (); ++i, ++visited)
+            ++seen[(*i).key ()];
+          break;
+        case 1:
+          for (HASH_INT_MAP::reverse_iterator i = map.rbegin (); i != map.rend (); ++i, ++visited)
+            ++seen[(*i).key ()];
+          break;
+        default:
+          {
+            HASH_INT_MAP const &cmap = map;
+            for (HASH_INT_MAP::const_iterator i = cmap.begin (); i != cmap.end (); ++i, ++visited)
+              ++seen[(*i).key ()];
+          }
+          break;
+        }
+
+      if (visited != expected)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("iteration %d visited %d entries ")
+                           ACE_TEXT ("instead of %d\n"),
+                           pass, visited, expected),
+                          -1);
+
+      for (int k = 0; k < count; k += step)
+        if (seen[k] != 1)
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("iteration %d visited %d %d times\n"),
+                             pass, k, seen[k]),
+                            -1);
+    }
+
+  return 0;
+}
+
+static int
+test_grow (void)
+{
+  HASH_INT_MAP map (4);
+
+  if (map.max_load (1) != 0 || map.max_load () != 1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("max_load failed\n")), -1);
+
+  // Bind the entries, checking the iterations while the table grows:
+  // the entries are then in two tables.
+  size_t total_size = map.total_size ();
+  int grown = 0;
+  for (int k = 0; k < GROW_ENTRIES; ++k)
+    {
+      if (map.bind (k, -k) != 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("bind %d failed\n"),
+                           k),
+                          -1);
+
+      if (map.total_size () != total_size)
+        {
+          total_size = map.total_size ();
+          ++grown;
+        }
+
+      if ((k < 300 || k % 97 == 0)
+          && check_iteration (map, k + 1, 1) != 0)
+        return -1;
+    }
+
+  if (map.current_size () != static_cast<size_t> (GROW_ENTRIES)
+      || map.total_size () < static_cast<size_t> (GROW_ENTRIES)
+      || (map.total_size () & (map.total_size () - 1)) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%B entries in %B buckets after binding %d\n"),
+                       map.current_size (),
+                       map.total_size (),
+                       GROW_ENTRIES),
+                      -1);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%d entries in %B buckets, after growing %d times\n"),
+              GROW_ENTRIES,
+              map.total_size (),
+              grown));
+
+  for (int k = 0; k < GROW_ENTRIES; ++k)
+    {
+      int value = 0;
+      if (map.find (k, value) != 0 || value != -k)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("%d not found\n"),
+                           k),
+                          -1);
+
+      HASH_INT_MAP::iterator pos = map.end ();
+      map.find (k, pos);
+      if (pos == map.end () || (*pos).key () != k)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("%d not found by iterator\n"),
+                           k),
+                          -1);
+
+      HASH_INT_BUCKET_ITER bucket (map, k);
+      HASH_INT_BUCKET_ITER bucket_end (map, k, 1);
+      while (bucket != bucket_end && (*bucket).key () != k)
+        ++bucket;
+      if (bucket == bucket_end)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("%d not in its bucket\n"),
+                           k),
+                          -1);
+    }
+
+  // Start growing the table once more, then unbind every other entry
+  // while iterating, which must not move the others.
+  total_size = map.total_size ();
+  int count = GROW_ENTRIES;
+  while (map.total_size () == total_size)
+    {
+      map.bind (count, -count);
+      ++count;
+    }
+
+  for (HASH_INT_MAP::iterator i = map.begin (); i != map.end (); )
+    {
+      HASH_INT_MAP::iterator current = i++;
+      if ((*current).key () % 2 != 0 || (*current).key () >= GROW_ENTRIES)
+        map.unbind (current);
+    }
+
+  if (check_iteration (map, GROW_ENTRIES, 2) != 0)
+    return -1;
+
+  // unbind_all() with the table still growing.
+  if (map.unbind_all () != 0 || map.current_size () != 0)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("unbind_all failed\n")), -1);
+  if (map.begin () != map.end ())
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("empty map has entries\n")), -1);
+  for (int k = 0; k < GROW_ENTRIES; k += 3)
+    map.bind (k, k);
+  if (check_iteration (map, GROW_ENTRIES, 3) != 0)
+    return -1;
+
+  // A table can't grow by doubling if its size isn't a power of 2.
+  HASH_INT_MAP odd (1000);
+  odd.bind (1, 1);
+  if (odd.max_load (2) != -1 || odd.max_load () != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("max_load accepted a table of 1000\n")),
+                      -1);
+  odd.unbind_all ();
+  if (odd.max_load (2) != 0 || odd.total_size () != 1024)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("empty table of 1000 reopened with %B buckets\n"),
+                       odd.total_size ()),
+                      -1);
+
+  return 0;
+}
+
+// Checks that iterating over a growing map visits all the entries it
+// had, while each step binds a new entry, until the table doubled
+// twice: the entries move while the iterator goes through them.
+static int
+test_grow_while_iterating (void)
+{
+  static const int OLD_ENTRIES = 1000;
+  static char seen[OLD_ENTRIES];
+
+  for (int pass = 0; pass < 3; ++pass)
+    {
+      HASH_INT_MAP map (4);
+      map.max_load (4);
+      for (int k = 0; k < OLD_ENTRIES; ++k)
+        map.bind (k, -k);
+
+      ACE_OS::memset (seen, 0, sizeof seen);
+      size_t const total_size = map.total_size ();
+      int count = OLD_ENTRIES;
+      int visited = 0;
+
+      switch (pass)
+        {
+        case 0:
+          for (HASH_INT_MAP::iterator i = map.begin (); i != map.end (); ++i, ++visited)
+            {
+              if ((*i).key () < OLD_ENTRIES)
+                ++seen[(*i).key ()];
+              if (count < 4 * OLD_ENTRIES)
+                map.bind (count++, 0);
+            }
+          break;
+        case 1:
+          for (HASH_INT_MAP::reverse_iterator i = map.rbegin (); i != map.rend (); ++i, ++visited)
+            {
+              if ((*i).key () < OLD_ENTRIES)
+                ++seen[(*i).key ()];
+              if (count < 4 * OLD_ENTRIES)
+                map.bind (count++, 0);
+            }
+          break;
+        default:
+          {
+            HASH_INT_MAP const &cmap = map;
+            for (HASH_INT_MAP::const_iterator i = cmap.begin (); i != cmap.end (); ++i, ++visited)
+              {
+                if ((*i).key () < OLD_ENTRIES)
+                  ++seen[(*i).key ()];
+                if (count < 4 * OLD_ENTRIES)
+                  map.bind (count++, 0);
+              }
+          }
+          break;
+        }
+
+      if (map.total_size () < 4 * total_size)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("iteration %d: table grew from %B ")
+                           ACE_TEXT ("to %B buckets only\n"),
+                           pass, total_size, map.total_size ()),
+                          -1);
+
+      int twice = 0;
+      for (int k = 0; k < OLD_ENTRIES; ++k)
+        if (seen[k] == 0)
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("iteration %d missed %d\n"),
+                             pass, k),
+                            -1);
+        else if (seen[k] > 1)
+          ++twice;
+
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("iteration %d: %d entries visited as the ")
+                  ACE_TEXT ("table grew from %B to %B buckets, ")
+                  ACE_TEXT ("%d of the first %d more than once\n"),
+                  pass, visited, total_size, map.total_size (),
+                  twice, OLD_ENTRIES));
+    }
+
+  return 0;
+}
+
+// Times binding and finding <entries> entries, with the default table
+// size, and with a table which grows from that size.
+static void
+time_grow (int entries)
+{
+  for (int grow = 0; grow < 2; ++grow)
+    {
+      HASH_INT_MAP map;
+      if (grow)
+        map.max_load (1);
+
+      ACE_High_Res_Timer bind_timer;
+      bind_timer.start ();
+      for (int k = 0; k < entries; ++k)
+        map.bind (k * 7, k);
+      bind_timer.stop ();
+
+      ACE_High_Res_Timer find_timer;
+      find_timer.start ();
+      int value = 0;
+      for (int k = 0; k < entries; ++k)
+        map.find (k * 7, value);
+      find_timer.stop ();
+
+      ACE_hrtime_t bind_ns = 0;
+      ACE_hrtime_t find_ns = 0;
+      bind_timer.elapsed_time (bind_ns);
+      find_timer.elapsed_time (find_ns);
+
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%s table, %d entries in %B buckets: ")
+                  ACE_TEXT ("%Q nsecs per bind, %Q nsecs per find\n"),
+                  grow ? ACE_TEXT ("growing") : ACE_TEXT ("fixed"),
+                  entries,
+                  map.total_size (),
+                  bind_ns / entries,
+                  find_ns / entries));
+    }
+}
+
 static int
 run_test (void)
 {
@@ -317,6 +628,14 @@ run_test (void)
 
   test_two_allocators();
 
+  if (test_grow () != 0)
+    return -1;
+
+  if (test_grow_while_iterating () != 0)
+    return -1;
+
+  time_grow (100000);
+
   // Run the STL algorithm test on the hash map.
   const HASH_STRING_MAP & chash = hash;
 
@@ -331,9 +650,9 @@ run_main (int, ACE_TCHAR *[])
 {
   ACE_START_TEST (ACE_TEXT ("Hash_Map_Manager_Test"));
 
-  run_test ();
+  int const status = run_test ();
 
   ACE_END_TEST;
 
-  return 0;
+  return status == 0 ? 0 : 1;
 }
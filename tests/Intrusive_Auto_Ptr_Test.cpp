@@ -96,6 +96,20 @@ int run_main (int, ACE_TCHAR *[])
 
   ACE_TEST_ASSERT (One::was_released());
 
+  // Assigning a null pointer releases the object held.
+  theone = new One (0);
+
+  {
+    ACE_Intrusive_Auto_Ptr<One> ip (theone);
+    ACE_Intrusive_Auto_Ptr<One> null_ip;
+
+    ACE_TEST_ASSERT (theone->has_refs (1));
+
+    ip = null_ip;
+    ACE_TEST_ASSERT (ip.get () == 0);
+    ACE_TEST_ASSERT (One::was_released ());
+  }
+
   ACE_END_TEST;
   return 0;
 }
@@ -0,0 +1,500 @@
+//=============================================================================
+/**
+ *  @file    Lockless_Message_Queue_Test.cpp
+ *
+ *  $Id$
+ *
+ *    This test checks <ACE_Lockless_Message_Queue>: FIFO order,
+ *    timeouts when the queue is empty or full, batch enqueues and
+ *    dequeues, deactivation of blocked threads and of threads about
+ *    to block, and the delivery of every message exactly once
+ *    through an <ACE_Task> worker pool using it as its queue.  The
+ *    worker pool is then timed with an <ACE_Message_Queue> and with
+ *    an <ACE_Lockless_Message_Queue>.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/Lockless_Message_Queue_T.h"
+#include "ace/Task.h"
+#include "ace/Thread_Manager.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+#if defined (ACE_HAS_THREADS) \
+    && defined (ACE_HAS_GCC_ATOMIC_BUILTINS) && (ACE_HAS_GCC_ATOMIC_BUILTINS == 1)
+
+typedef ACE_Lockless_Message_Queue<ACE_MT_SYNCH> LOCKLESS_QUEUE;
+typedef ACE_Message_Queue<ACE_MT_SYNCH> LOCKED_QUEUE;
+
+static const int PRODUCERS = 4;
+static const int CONSUMERS = 4;
+static const int MESSAGES = 200000;
+
+static int
+test_fifo (void)
+{
+  LOCKLESS_QUEUE queue (10);
+  int status = 0;
+
+  if (queue.size () != 16 || !queue.is_empty () || queue.is_full ())
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("new queue has size %B, empty %d, ")
+                       ACE_TEXT ("full %d\n"),
+                       queue.size (),
+                       queue.is_empty (),
+                       queue.is_full ()),
+                      1);
+
+  ACE_Message_Block blocks[16];
+  for (int i = 0; i < 16; ++i)
+    if (queue.enqueue_tail (&blocks[i]) != i + 1)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("enqueue_tail %d doesn't return %d\n"),
+                         i,
+                         i + 1),
+                        1);
+
+  if (!queue.is_full () || queue.message_count () != 16)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("queue of 16 messages: full %d, count %B\n"),
+                  queue.is_full (),
+                  queue.message_count ()));
+      status = 1;
+    }
+
+  ACE_Message_Block extra;
+  ACE_Time_Value now (ACE_OS::gettimeofday ());
+  if (queue.enqueue_tail (&extra, &now) != -1 || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%p\n"),
+                  ACE_TEXT ("enqueue to a full queue")));
+      status = 1;
+    }
+
+  if (queue.enqueue_head (&extra) != -1 || errno != ENOTSUP)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("enqueue_head is supported\n")));
+      status = 1;
+    }
+
+  for (int i = 0; i < 16; ++i)
+    {
+      ACE_Message_Block *mb = 0;
+      if (queue.dequeue_head (mb) != 15 - i || mb != &blocks[i])
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("dequeue_head %d out of order\n"),
+                           i),
+                          1);
+    }
+
+  ACE_Message_Block *mb = 0;
+  now = ACE_OS::gettimeofday ();
+  if (queue.dequeue_head (mb, &now) != -1 || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%p\n"),
+                  ACE_TEXT ("dequeue from an empty queue")));
+      status = 1;
+    }
+
+  // The ring wraps around.
+  for (int round = 0; round < 100; ++round)
+    {
+      if (queue.enqueue_tail (&blocks[round % 16]) == -1
+          || queue.dequeue_head (mb) == -1
+          || mb != &blocks[round % 16])
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("round %d failed\n"),
+                           round),
+                          1);
+    }
+
+  return status;
+}
+
+// A batch larger than the ring enqueues what fits before the timeout.
+
+static int
+test_batch (void)
+{
+  LOCKLESS_QUEUE queue (8);
+  ACE_Message_Block blocks[20];
+  ACE_Message_Block *in[20];
+  ACE_Message_Block *out[20];
+  for (int i = 0; i < 20; ++i)
+    in[i] = &blocks[i];
+
+  ACE_Time_Value now (ACE_OS::gettimeofday ());
+  int const enqueued = queue.enqueue_batch (in, 20, &now);
+  int const first = queue.dequeue_batch (out, 5);
+  int const second = queue.dequeue_batch (out + 5, 20);
+  if (enqueued != 8 || first != 5 || second != 3)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("batch of 20 in a ring of 8: enqueued %d, ")
+                       ACE_TEXT ("dequeued %d and %d\n"),
+                       enqueued,
+                       first,
+                       second),
+                      1);
+
+  for (int i = 0; i < 8; ++i)
+    if (out[i] != &blocks[i])
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("batch dequeue %d out of order\n"),
+                         i),
+                        1);
+
+  now = ACE_OS::gettimeofday ();
+  if (queue.dequeue_batch (out, 20, &now) != -1 || errno != EWOULDBLOCK)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("batch dequeue from an empty queue")),
+                      1);
+
+  return 0;
+}
+
+struct Blocked_Args
+{
+  LOCKLESS_QUEUE *queue_;
+
+  /// Set if the call returned with ESHUTDOWN.
+  bool shutdown_;
+};
+
+static ACE_THR_FUNC_RETURN
+blocked_dequeue (void *arg)
+{
+  Blocked_Args *args = static_cast<Blocked_Args *> (arg);
+  ACE_Message_Block *mb = 0;
+  int const result = args->queue_->dequeue_head (mb);
+  args->shutdown_ = result == -1 && errno == ESHUTDOWN;
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+blocked_enqueue (void *arg)
+{
+  Blocked_Args *args = static_cast<Blocked_Args *> (arg);
+  ACE_Message_Block mb;
+  int const result = args->queue_->enqueue_tail (&mb);
+  args->shutdown_ = result == -1 && errno == ESHUTDOWN;
+  return 0;
+}
+
+// Threads blocked on an empty or full queue return when it is
+// deactivated.
+
+static int
+test_deactivate (void)
+{
+  int status = 0;
+  LOCKLESS_QUEUE empty_queue (2);
+  LOCKLESS_QUEUE full_queue (2);
+
+  ACE_Message_Block blocks[2];
+  full_queue.enqueue_tail (&blocks[0]);
+  full_queue.enqueue_tail (&blocks[1]);
+
+  Blocked_Args consumer = { &empty_queue, false };
+  Blocked_Args producer = { &full_queue, false };
+  ACE_Thread_Manager threads;
+  if (threads.spawn (blocked_dequeue, &consumer) == -1
+      || threads.spawn (blocked_enqueue, &producer) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")), 1);
+
+  // Let both block.
+  ACE_OS::sleep (ACE_Time_Value (0, 200000));
+  empty_queue.deactivate ();
+  full_queue.deactivate ();
+  threads.wait ();
+
+  if (!consumer.shutdown_ || !producer.shutdown_)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("blocked threads didn't see the queue ")
+                  ACE_TEXT ("deactivated\n")));
+      status = 1;
+    }
+
+  // The blocks queued are on the stack; don't let close() release them.
+  ACE_Message_Block *mb = 0;
+  full_queue.activate ();
+  while (!full_queue.is_empty ())
+    full_queue.dequeue_head (mb);
+
+  return status;
+}
+
+static ACE_THR_FUNC_RETURN
+timed_dequeue (void *arg)
+{
+  Blocked_Args *args = static_cast<Blocked_Args *> (arg);
+  ACE_Message_Block *mb = 0;
+  ACE_Time_Value timeout (ACE_OS::gettimeofday () + ACE_Time_Value (2));
+  int const result = args->queue_->dequeue_head (mb, &timeout);
+  args->shutdown_ = result == -1 && errno == ESHUTDOWN;
+  return 0;
+}
+
+static ACE_THR_FUNC_RETURN
+timed_enqueue (void *arg)
+{
+  Blocked_Args *args = static_cast<Blocked_Args *> (arg);
+  ACE_Message_Block mb;
+  ACE_Time_Value timeout (ACE_OS::gettimeofday () + ACE_Time_Value (2));
+  int const result = args->queue_->enqueue_tail (&mb, &timeout);
+  args->shutdown_ = result == -1 && errno == ESHUTDOWN;
+  return 0;
+}
+
+/**
+ * @class Racing_Queue
+ *
+ * Lets the test deactivate the queue while holding its lock, as a
+ * deactivate() does between the check of the state a call makes
+ * without the lock and its wait.
+ */
+class Racing_Queue : public LOCKLESS_QUEUE
+{
+public:
+  Racing_Queue (size_t size) : LOCKLESS_QUEUE (size) {}
+
+  ACE_SYNCH_MUTEX &lock (void) { return this->lock_; }
+
+  /// Deactivate, with the lock held.
+  void deactivate_locked (void) { this->deactivate_i (); }
+};
+
+// Threads about to block when the queue is deactivated return too,
+// rather than wait for a broadcast that came before they waited.  A
+// thread which missed it times out instead of seeing ESHUTDOWN.
+
+static int
+test_deactivate_race (void)
+{
+  int status = 0;
+  Racing_Queue empty_queue (2);
+  Racing_Queue full_queue (2);
+
+  ACE_Message_Block blocks[2];
+  full_queue.enqueue_tail (&blocks[0]);
+  full_queue.enqueue_tail (&blocks[1]);
+
+  Blocked_Args consumer = { &empty_queue, false };
+  Blocked_Args producer = { &full_queue, false };
+  ACE_Thread_Manager threads;
+
+  {
+    // Both threads find the queue active, then block on the lock
+    // before they can wait.
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, empty_guard, empty_queue.lock (), 1);
+    ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, full_guard, full_queue.lock (), 1);
+
+    if (threads.spawn (timed_dequeue, &consumer) == -1
+        || threads.spawn (timed_enqueue, &producer) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")), 1);
+
+    ACE_OS::sleep (ACE_Time_Value (0, 200000));
+    empty_queue.deactivate_locked ();
+    full_queue.deactivate_locked ();
+  }
+  threads.wait ();
+
+  if (!consumer.shutdown_ || !producer.shutdown_)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("threads about to block didn't see the ")
+                  ACE_TEXT ("queue deactivated\n")));
+      status = 1;
+    }
+
+  // The blocks queued are on the stack; don't let close() release them.
+  ACE_Message_Block *mb = 0;
+  full_queue.activate ();
+  while (!full_queue.is_empty ())
+    full_queue.dequeue_head (mb);
+
+  return status;
+}
+
+/**
+ * @class Worker_Pool
+ *
+ * Counts the messages its threads get from its queue, until they get
+ * a hangup message each.
+ */
+class Worker_Pool : public ACE_Task<ACE_MT_SYNCH>
+{
+public:
+  Worker_Pool (ACE_Message_Block *blocks, char *seen)
+    : blocks_ (blocks),
+      seen_ (seen)
+  {
+  }
+
+  virtual int svc (void)
+  {
+    for (ACE_Message_Block *mb = 0; this->getq (mb) != -1; )
+      {
+        if (mb->msg_type () == ACE_Message_Block::MB_HANGUP)
+          {
+            mb->release ();
+            break;
+          }
+
+        // Each message is only got by one thread.
+        ++this->seen_[mb - this->blocks_];
+      }
+
+    return 0;
+  }
+
+private:
+  ACE_Message_Block *blocks_;
+  char *seen_;
+};
+
+struct Producer_Args
+{
+  Worker_Pool *pool_;
+  ACE_Message_Block *blocks_;
+  int count_;
+};
+
+static ACE_THR_FUNC_RETURN
+producer (void *arg)
+{
+  Producer_Args *args = static_cast<Producer_Args *> (arg);
+
+  for (int i = 0; i < args->count_; ++i)
+    if (args->pool_->putq (&args->blocks_[i]) == -1)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("putq")));
+        break;
+      }
+
+  return 0;
+}
+
+// Sends MESSAGES messages through a worker pool using <queue>.
+
+static int
+run_pool (const ACE_TCHAR *name, ACE_Message_Queue<ACE_MT_SYNCH> *queue)
+{
+  ACE_Message_Block *blocks = 0;
+  ACE_NEW_RETURN (blocks, ACE_Message_Block[MESSAGES], 1);
+  char *seen = 0;
+  ACE_NEW_RETURN (seen, char[MESSAGES], 1);
+  ACE_OS::memset (seen, 0, MESSAGES);
+
+  Worker_Pool pool (blocks, seen);
+  pool.msg_queue (queue);
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  if (pool.activate (THR_NEW_LWP | THR_JOINABLE, CONSUMERS) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("activate")),
+                      1);
+
+  Producer_Args args[PRODUCERS];
+  int const per_producer = MESSAGES / PRODUCERS;
+  ACE_Thread_Manager producers;
+  for (int p = 0; p < PRODUCERS; ++p)
+    {
+      args[p].pool_ = &pool;
+      args[p].blocks_ = blocks + p * per_producer;
+      args[p].count_ = per_producer;
+      producers.spawn (producer, &args[p]);
+    }
+  producers.wait ();
+
+  for (int c = 0; c < CONSUMERS; ++c)
+    {
+      ACE_Message_Block *hangup = 0;
+      ACE_NEW_RETURN (hangup,
+                      ACE_Message_Block (0, ACE_Message_Block::MB_HANGUP),
+                      1);
+      pool.putq (hangup);
+    }
+  pool.wait ();
+
+  timer.stop ();
+
+  int status = 0;
+  for (int i = 0; i < MESSAGES; ++i)
+    if (seen[i] != 1)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("%s: message %d was got %d times\n"),
+                    name,
+                    i,
+                    seen[i]));
+        status = 1;
+        break;
+      }
+
+  ACE_hrtime_t ns = 0;
+  timer.elapsed_time (ns);
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-28s %d producers, %d consumers: %Q ns/message\n"),
+              name,
+              PRODUCERS,
+              CONSUMERS,
+              ns / MESSAGES));
+
+  pool.msg_queue (0);
+  delete [] seen;
+  delete [] blocks;
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Lockless_Message_Queue_Test"));
+
+  int status = test_fifo ();
+  status += test_batch ();
+  status += test_deactivate ();
+  status += test_deactivate_race ();
+
+  LOCKED_QUEUE locked_queue;
+  status += run_pool (ACE_TEXT ("ACE_Message_Queue"), &locked_queue);
+
+  LOCKLESS_QUEUE lockless_queue;
+  status += run_pool (ACE_TEXT ("ACE_Lockless_Message_Queue"),
+                      &lockless_queue);
+
+  // A small ring makes the producers block.
+  LOCKLESS_QUEUE small_queue (8);
+  status += run_pool (ACE_TEXT ("ACE_Lockless_Message_Queue(8)"),
+                      &small_queue);
+
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Lockless_Message_Queue_Test"));
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("ACE_Lockless_Message_Queue requires threads ")
+              ACE_TEXT ("and atomic builtins\n")));
+
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* ACE_HAS_THREADS && ACE_HAS_GCC_ATOMIC_BUILTINS */
@@ -0,0 +1,490 @@
+//=============================================================================
+/**
+ *  @file    Log_Msg_Async_Test.cpp
+ *
+ *  $Id$
+ *
+ *  This test checks ACE_Log_Msg_Async: records logged by several
+ *  threads at once through a small ring with the BLOCK policy must
+ *  all be written to the file, in order for each thread; with the
+ *  DROP policy and a slow backend, records must be dropped, counted
+ *  and reported, never lost otherwise; and records logged through
+ *  ACE_Log_Msg with the CUSTOM flag must reach the file, including
+ *  when several threads fill the ring with the BLOCK policy.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Log_Msg_Async.h"
+#include "ace/Log_Msg.h"
+#include "ace/Log_Record.h"
+#include "ace/FILE_Connector.h"
+#include "ace/FILE_IO.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_Memory.h"
+
+#if defined (ACE_HAS_THREADS)
+
+static const int THREADS = 4;
+static const int RECORDS = 5000;
+
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> next_id;
+
+static ACE_THR_FUNC_RETURN
+producer (void *arg)
+{
+  ACE_Log_Msg_Async *backend = static_cast<ACE_Log_Msg_Async *> (arg);
+  long const id = next_id++;
+
+  for (int i = 0; i < RECORDS; ++i)
+    {
+      ACE_TCHAR msg[64];
+      ACE_OS::sprintf (msg,
+                       ACE_TEXT ("producer %ld record %d\n"),
+                       id,
+                       i);
+
+      ACE_Log_Record record (LM_DEBUG,
+                             ACE_OS::gettimeofday (),
+                             ACE_OS::getpid ());
+      record.msg_data (msg);
+      backend->log (record);
+    }
+
+  return 0;
+}
+
+// Read back the file at <path>, and check that the records of each
+// producer are there, in order.
+static int
+check_file (const ACE_TCHAR *path)
+{
+  FILE *fp = ACE_OS::fopen (path, ACE_TEXT ("r"));
+  if (fp == 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       path),
+                      -1);
+
+  int next[THREADS];
+  for (int t = 0; t < THREADS; ++t)
+    next[t] = 0;
+
+  int status = 0;
+  char line[ACE_Log_Record::MAXVERBOSELOGMSGLEN];
+
+  while (status == 0 && ACE_OS::fgets (line, sizeof line, fp) != 0)
+    {
+      const char *msg = ACE_OS::strstr (line, "producer ");
+      long id = -1;
+      int i = -1;
+      if (msg == 0
+          || ::sscanf (msg, "producer %ld record %d", &id, &i) != 2
+          || id < 0
+          || id >= THREADS)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("unexpected line: %C"),
+                      line));
+          status = -1;
+        }
+      else if (i != next[id])
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("record %d of producer %d, expected %d\n"),
+                      i,
+                      static_cast<int> (id),
+                      next[id]));
+          status = -1;
+        }
+      else
+        ++next[id];
+    }
+
+  ACE_OS::fclose (fp);
+
+  for (int t = 0; status == 0 && t < THREADS; ++t)
+    if (next[t] != RECORDS)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("%d records of producer %d, expected %d\n"),
+                    next[t],
+                    t,
+                    RECORDS));
+        status = -1;
+      }
+
+  return status;
+}
+
+static int
+test_block (void)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("BLOCK policy test\n")));
+
+  const ACE_TCHAR *path = ACE_TEXT ("Log_Msg_Async_Test.out");
+  ACE_FILE_IO file;
+  ACE_FILE_Connector connector;
+  if (connector.connect (file,
+                         ACE_FILE_Addr (path),
+                         0,
+                         ACE_Addr::sap_any,
+                         0,
+                         O_RDWR | O_CREAT | O_TRUNC,
+                         ACE_DEFAULT_FILE_PERMS) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       path),
+                      -1);
+
+  int status = 0;
+
+  {
+    ACE_Log_Msg_Async backend (file.get_handle (),
+                               64,
+                               ACE_Log_Msg_Async::BLOCK);
+    if (backend.open (0) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("%p\n"),
+                         ACE_TEXT ("open")),
+                        -1);
+
+    next_id = 0;
+    ACE_Thread_Manager::instance ()->spawn_n (THREADS, producer, &backend);
+    ACE_Thread_Manager::instance ()->wait ();
+
+    ACE_Time_Value timeout (10);
+    if (backend.flush (&timeout) == -1)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("%p\n"),
+                    ACE_TEXT ("flush")));
+        status = -1;
+      }
+
+    ACE_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("%Q records written, %Q dropped, ")
+                ACE_TEXT ("%Q waits for room\n"),
+                static_cast<ACE_UINT64> (backend.written ()),
+                static_cast<ACE_UINT64> (backend.dropped ()),
+                static_cast<ACE_UINT64> (backend.blocked ())));
+
+    if (backend.dropped () != 0
+        || backend.written () != THREADS * RECORDS)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("expected %d records written, none dropped\n"),
+                    THREADS * RECORDS));
+        status = -1;
+      }
+  }
+
+  file.close ();
+
+  if (status == 0)
+    status = check_file (path);
+
+  ACE_OS::unlink (path);
+  return status;
+}
+
+// A backend which takes its time.
+class Slow_Backend : public ACE_Log_Msg_Backend
+{
+public:
+  Slow_Backend (void) : records_ (0), notices_ (0) {}
+
+  virtual int open (const ACE_TCHAR *) { return 0; }
+  virtual int reset (void) { return 0; }
+  virtual int close (void) { return 0; }
+
+  virtual ssize_t log (ACE_Log_Record &log_record)
+  {
+    // The notices read "ACE_Log_Msg_Async: <n> log records dropped".
+    const ACE_TCHAR *msg = log_record.msg_data ();
+    const ACE_TCHAR *count = ACE_OS::strchr (msg, ACE_TEXT (' '));
+    if (log_record.type () == LM_WARNING && count != 0)
+      this->notices_ += ACE_OS::strtoul (count, 0, 10);
+    else
+      ++this->records_;
+
+    ACE_OS::sleep (ACE_Time_Value (0, 100));
+    return 0;
+  }
+
+  /// Records received.
+  unsigned long records_;
+
+  /// Sum of the records the notices report dropped.
+  unsigned long notices_;
+};
+
+static int
+test_drop (void)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("DROP policy test\n")));
+
+  Slow_Backend slow;
+  int status = 0;
+  unsigned long dropped = 0;
+
+  {
+    ACE_Log_Msg_Async backend (&slow, 16, ACE_Log_Msg_Async::DROP);
+    if (backend.open (0) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("%p\n"),
+                         ACE_TEXT ("open")),
+                        -1);
+
+    next_id = 0;
+    producer (&backend);
+
+    dropped = backend.dropped ();
+
+    // Let the notice of the last records dropped through.
+    ACE_Log_Record record (LM_DEBUG,
+                           ACE_OS::gettimeofday (),
+                           ACE_OS::getpid ());
+    record.msg_data (ACE_TEXT ("last record\n"));
+    backend.flush ();
+    backend.log (record);
+
+    // Closing writes the records left.
+    backend.close ();
+
+    ACE_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("%Q records passed on, %Q dropped, ")
+                ACE_TEXT ("%Q reported dropped\n"),
+                static_cast<ACE_UINT64> (slow.records_),
+                static_cast<ACE_UINT64> (dropped),
+                static_cast<ACE_UINT64> (slow.notices_)));
+  }
+
+  if (dropped == 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("no record was dropped\n")));
+      status = -1;
+    }
+
+  if (slow.records_ + dropped != RECORDS + 1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%Q records passed on and %Q dropped, ")
+                  ACE_TEXT ("expected %d in all\n"),
+                  static_cast<ACE_UINT64> (slow.records_),
+                  static_cast<ACE_UINT64> (dropped),
+                  RECORDS + 1));
+      status = -1;
+    }
+
+  if (slow.notices_ != dropped)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%Q records reported dropped, expected %Q\n"),
+                  static_cast<ACE_UINT64> (slow.notices_),
+                  static_cast<ACE_UINT64> (dropped)));
+      status = -1;
+    }
+
+  return status;
+}
+
+static int
+test_log_msg (void)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("ACE_Log_Msg CUSTOM test\n")));
+
+  const ACE_TCHAR *path = ACE_TEXT ("Log_Msg_Async_Test.out");
+  ACE_FILE_IO file;
+  ACE_FILE_Connector connector;
+  if (connector.connect (file,
+                         ACE_FILE_Addr (path),
+                         0,
+                         ACE_Addr::sap_any,
+                         0,
+                         O_RDWR | O_CREAT | O_TRUNC,
+                         ACE_DEFAULT_FILE_PERMS) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       path),
+                      -1);
+
+  int status = 0;
+
+  {
+    ACE_Log_Msg_Async backend (file.get_handle ());
+    backend.open (0);
+
+    ACE_Log_Msg_Backend *old = ACE_Log_Msg::msg_backend (&backend);
+    ACE_LOG_MSG->set_flags (ACE_Log_Msg::CUSTOM);
+
+    // These go to the test's log too.
+    for (int i = 0; i < 3; ++i)
+      ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("through ACE_Log_Msg %d\n"), i));
+
+    ACE_LOG_MSG->clr_flags (ACE_Log_Msg::CUSTOM);
+    ACE_Log_Msg::msg_backend (old);
+    backend.close ();
+  }
+
+  file.close ();
+
+  FILE *fp = ACE_OS::fopen (path, ACE_TEXT ("r"));
+  if (fp == 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       path),
+                      -1);
+
+  int found = 0;
+  char line[ACE_Log_Record::MAXVERBOSELOGMSGLEN];
+  while (ACE_OS::fgets (line, sizeof line, fp) != 0)
+    if (ACE_OS::strstr (line, "through ACE_Log_Msg") != 0)
+      ++found;
+  ACE_OS::fclose (fp);
+  ACE_OS::unlink (path);
+
+  if (found != 3)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d records from ACE_Log_Msg, expected 3\n"),
+                  found));
+      status = -1;
+    }
+
+  return status;
+}
+
+static const int FLOOD_RECORDS = 20000;
+
+static ACE_THR_FUNC_RETURN
+flooder (void *)
+{
+  long const id = next_id++;
+
+  for (int i = 0; i < FLOOD_RECORDS; ++i)
+    ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("flooder %d record %d\n"), id, i));
+
+  return 0;
+}
+
+// ACE_Log_Msg calls the backend with its lock held, so threads
+// waiting for room in the ring hold it while they wait.
+static int
+test_log_msg_block (void)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("ACE_Log_Msg CUSTOM BLOCK test\n")));
+
+  const ACE_TCHAR *path = ACE_TEXT ("Log_Msg_Async_Test.out");
+  ACE_FILE_IO file;
+  ACE_FILE_Connector connector;
+  if (connector.connect (file,
+                         ACE_FILE_Addr (path),
+                         0,
+                         ACE_Addr::sap_any,
+                         0,
+                         O_RDWR | O_CREAT | O_TRUNC,
+                         ACE_DEFAULT_FILE_PERMS) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       path),
+                      -1);
+
+  int status = 0;
+  unsigned long blocked = 0;
+
+  {
+    ACE_Log_Msg_Async backend (file.get_handle (),
+                               16,
+                               ACE_Log_Msg_Async::BLOCK);
+    backend.open (0);
+
+    // Only the backend gets the records, with the flags it must
+    // format them with.
+    ACE_Log_Msg *log_msg = ACE_LOG_MSG;
+    u_long const flags = log_msg->flags ();
+    ACE_Log_Msg_Backend *old = ACE_Log_Msg::msg_backend (&backend);
+    log_msg->clr_flags (flags);
+    log_msg->set_flags (ACE_Log_Msg::CUSTOM | ACE_Log_Msg::VERBOSE_LITE);
+
+    next_id = 0;
+    ACE_Thread_Manager::instance ()->spawn_n (THREADS, flooder);
+    ACE_Thread_Manager::instance ()->wait ();
+
+    log_msg->clr_flags (ACE_Log_Msg::CUSTOM | ACE_Log_Msg::VERBOSE_LITE);
+    log_msg->set_flags (flags);
+    ACE_Log_Msg::msg_backend (old);
+    backend.close ();
+    blocked = backend.blocked ();
+  }
+
+  file.close ();
+
+  FILE *fp = ACE_OS::fopen (path, ACE_TEXT ("r"));
+  if (fp == 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       path),
+                      -1);
+
+  int found = 0;
+  char line[ACE_Log_Record::MAXVERBOSELOGMSGLEN];
+  while (ACE_OS::fgets (line, sizeof line, fp) != 0)
+    if (ACE_OS::strstr (line, "@LM_DEBUG@flooder ") != 0)
+      ++found;
+  ACE_OS::fclose (fp);
+  ACE_OS::unlink (path);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%d records written, %Q waits for room\n"),
+              found,
+              static_cast<ACE_UINT64> (blocked)));
+
+  if (found != THREADS * FLOOD_RECORDS)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d verbose records from ACE_Log_Msg, ")
+                  ACE_TEXT ("expected %d\n"),
+                  found,
+                  THREADS * FLOOD_RECORDS));
+      status = -1;
+    }
+
+  return status;
+}
+
+#endif /* ACE_HAS_THREADS */
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Log_Msg_Async_Test"));
+
+  int status = 0;
+
+#if defined (ACE_HAS_THREADS)
+  if (test_block () == -1)
+    status = 1;
+
+  if (test_drop () == -1)
+    status = 1;
+
+  if (test_log_msg () == -1)
+    status = 1;
+
+  if (test_log_msg_block () == -1)
+    status = 1;
+#else
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("threads not supported on this platform\n")));
+#endif /* ACE_HAS_THREADS */
+
+  ACE_END_TEST;
+  return status;
+}
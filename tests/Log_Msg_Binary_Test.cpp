@@ -0,0 +1,437 @@
+//=============================================================================
+/**
+ *  @file    Log_Msg_Binary_Test.cpp
+ *
+ *  $Id$
+ *
+ *  This test checks the ACE_Log_Msg::BINARY flag: messages logged
+ *  with it must be kept encoded in their records, and render to the
+ *  text they have without it, also after going through a CDR stream,
+ *  or from an encoding of the other byte order.  Formats which can't
+ *  be deferred, and messages too long, must still be logged.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Log_Msg.h"
+#include "ace/Log_Msg_Callback.h"
+#include "ace/Log_Record.h"
+#include "ace/Log_Binary.h"
+#include "ace/CDR_Stream.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+// Keeps the last record logged.
+class Recorder : public ACE_Log_Msg_Callback
+{
+public:
+  Recorder (void) : binary_ (false), render_ (true)
+  {
+    this->text_[0] = '\0';
+  }
+
+  virtual void log (ACE_Log_Record &log_record)
+  {
+    this->binary_ = log_record.msg_binary () != 0;
+    if (this->render_)
+      ACE_OS::strcpy (this->text_, log_record.msg_data ());
+  }
+
+  /// Whether the message of the last record was encoded.
+  bool binary_;
+
+  /// Whether to render the messages.
+  bool render_;
+
+  ACE_TCHAR text_[ACE_Log_Record::MAXLOGMSGLEN];
+};
+
+static Recorder recorder;
+static u_long saved_flags = 0;
+
+// Log to the recorder only, with @a flags, until release().
+static void
+capture (u_long flags)
+{
+  saved_flags = ACE_LOG_MSG->flags ();
+  ACE_LOG_MSG->clr_flags (saved_flags);
+  ACE_LOG_MSG->set_flags (ACE_Log_Msg::MSG_CALLBACK | flags);
+}
+
+static void
+release (void)
+{
+  ACE_LOG_MSG->clr_flags (ACE_LOG_MSG->flags ());
+  ACE_LOG_MSG->set_flags (saved_flags);
+}
+
+static void
+nothing (void)
+{
+}
+
+static int
+test_formats (void)
+{
+  int status = 0;
+  ACE_Time_Value const tv (1234567890, 123456);
+  void *const ptr = &recorder;
+
+  for (int verbose = 0; verbose < 2; ++verbose)
+    {
+      for (int i = 0; i < 4; ++i)
+        {
+          ACE_TCHAR text[2][ACE_Log_Record::MAXLOGMSGLEN];
+
+          for (int binary = 0; binary < 2; ++binary)
+            {
+              capture ((verbose ? ACE_Log_Msg::VERBOSE : 0)
+                       | (binary ? ACE_Log_Msg::BINARY : 0));
+
+              ACE_LOG_MSG->errnum (ENOENT);
+              ACE_LOG_MSG->linenum (__LINE__);
+              ACE_LOG_MSG->file (__FILE__);
+
+              switch (i)
+                {
+                case 0:
+                  ACE_LOG_MSG->log (LM_INFO,
+                                    ACE_TEXT ("%d|%5.2f|%s|%C|%Q|%q|%B|%b|%x|")
+                                    ACE_TEXT ("%c|%@|%:|%% %*d|%-8s|%08.3e\n"),
+                                    -42,
+                                    3.14159,
+                                    ACE_TEXT ("string"),
+                                    "narrow",
+                                    ACE_UINT64_LITERAL (18446744073709551615),
+                                    ACE_INT64_LITERAL (-9223372036854775807),
+                                    static_cast<size_t> (4096),
+                                    static_cast<ssize_t> (-1),
+                                    0xbeef,
+                                    'z',
+                                    ptr,
+                                    static_cast<time_t> (1234567890),
+                                    6,
+                                    7,
+                                    ACE_TEXT ("left"),
+                                    6.02e23);
+                  break;
+                case 1:
+                  ACE_LOG_MSG->log (LM_NOTICE,
+                                    ACE_TEXT ("%M|%.1M|%l|%N|%n|%P|%t|")
+                                    ACE_TEXT ("%p|%m|%S\n"),
+                                    ACE_TEXT ("open"),
+                                    SIGINT);
+                  break;
+                case 2:
+                  ACE_LOG_MSG->log (LM_DEBUG,
+                                    ACE_TEXT ("%#D|%#T|%{%I%}%I|%s|%R\n"),
+                                    &tv,
+                                    &tv,
+                                    static_cast<ACE_TCHAR *> (0),
+                                    -1);
+                  break;
+                case 3:
+                  ACE_LOG_MSG->log (LM_WARNING,
+                                    ACE_TEXT ("100%% of %d\n"),
+                                    12);
+                  break;
+                }
+
+              release ();
+
+              if (recorder.binary_ != (binary != 0))
+                {
+                  ACE_ERROR ((LM_ERROR,
+                              ACE_TEXT ("format %d: record %s encoded\n"),
+                              i,
+                              binary ? ACE_TEXT ("not") : ACE_TEXT ("")));
+                  status = -1;
+                }
+
+              ACE_OS::strcpy (text[binary], recorder.text_);
+            }
+
+          if (ACE_OS::strcmp (text[0], text[1]) != 0)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("format %d rendered as <%s>, ")
+                          ACE_TEXT ("formatted as <%s>\n"),
+                          i,
+                          text[1],
+                          text[0]));
+              status = -1;
+            }
+          else
+            ACE_DEBUG ((LM_DEBUG,
+                        ACE_TEXT ("format %d: %s"),
+                        i,
+                        text[0]));
+        }
+    }
+
+  return status;
+}
+
+static int
+test_fallback (void)
+{
+  int status = 0;
+
+  // %r runs code: this is formatted right away.
+  capture (ACE_Log_Msg::BINARY);
+  ACE_LOG_MSG->log (LM_DEBUG, ACE_TEXT ("run %r done %d\n"), nothing, 7);
+  release ();
+
+  if (recorder.binary_
+      || ACE_OS::strcmp (recorder.text_, ACE_TEXT ("run  done 7\n")) != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%%r: <%s>, %s encoded\n"),
+                  recorder.text_,
+                  recorder.binary_ ? ACE_TEXT ("") : ACE_TEXT ("not")));
+      status = -1;
+    }
+
+  // A string longer than a message is truncated, and what follows
+  // it left out.
+  ACE_TCHAR *big = 0;
+  ACE_NEW_RETURN (big, ACE_TCHAR[2 * ACE_Log_Record::MAXLOGMSGLEN], -1);
+  for (int i = 0; i < 2 * ACE_Log_Record::MAXLOGMSGLEN - 1; ++i)
+    big[i] = ACE_TEXT ('x');
+  big[2 * ACE_Log_Record::MAXLOGMSGLEN - 1] = '\0';
+
+  capture (ACE_Log_Msg::BINARY);
+  ACE_LOG_MSG->log (LM_DEBUG, ACE_TEXT ("%s%d\n"), big, 7);
+  release ();
+  delete [] big;
+
+  size_t const len = ACE_OS::strlen (recorder.text_);
+  if (!recorder.binary_
+      || len >= ACE_Log_Record::MAXLOGMSGLEN
+      || len < ACE_Log_Record::MAXLOGMSGLEN / 2
+      || ACE_OS::strchr (recorder.text_, ACE_TEXT ('7')) != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("long message rendered with %B characters\n"),
+                  len));
+      status = -1;
+    }
+
+  return status;
+}
+
+// Store @a value at @a p, in the other byte order.
+template <typename T> static void
+put_swapped (char *p, T value)
+{
+  char const *src = reinterpret_cast<char const *> (&value);
+  for (size_t i = 0; i < sizeof value; ++i)
+    p[i] = src[sizeof value - 1 - i];
+}
+
+// Encode @a format, followed by @a count ints of @a value, at @a data
+// in the byte order of the host.  Returns the length of the encoding.
+static size_t
+encode_ints (char *data,
+             const ACE_TCHAR *format,
+             int count,
+             ACE_INT32 value)
+{
+  size_t pos = 0;
+  data[pos++] = static_cast<char> (ACE_CDR_BYTE_ORDER);
+  data[pos++] = 1;
+  data[pos++] = static_cast<char> (sizeof (ACE_TCHAR));
+  data[pos++] = 0;
+
+  ACE_UINT32 const len = static_cast<ACE_UINT32> (ACE_OS::strlen (format));
+  ACE_OS::memcpy (data + pos, &len, sizeof len);
+  pos += sizeof len;
+  ACE_OS::memcpy (data + pos, format, len * sizeof (ACE_TCHAR));
+  pos += len * sizeof (ACE_TCHAR);
+
+  for (int i = 0; i < count; ++i)
+    {
+      data[pos++] = 'i';
+      ACE_OS::memcpy (data + pos, &value, sizeof value);
+      pos += sizeof value;
+    }
+  return pos;
+}
+
+static int
+test_cdr (void)
+{
+  int status = 0;
+
+  char data[ACE_Log_Record::MAXLOGMSGLEN];
+  ACE_Log_Record record (LM_NOTICE, ACE_OS::gettimeofday (), ACE_OS::getpid ());
+
+  // Encode a message by hand, in the other byte order.
+  ACE_TCHAR const format[] = ACE_TEXT ("swapped %d %s\n");
+  ACE_TCHAR const arg[] = ACE_TEXT ("ok");
+  size_t pos = 0;
+  data[pos++] = static_cast<char> (!ACE_CDR_BYTE_ORDER);
+  data[pos++] = 1;
+  data[pos++] = static_cast<char> (sizeof (ACE_TCHAR));
+  data[pos++] = 0;
+
+  ACE_UINT32 len = static_cast<ACE_UINT32> (ACE_OS::strlen (format));
+  put_swapped (data + pos, len);
+  pos += 4;
+  for (size_t i = 0; i < len; ++i, pos += sizeof (ACE_TCHAR))
+    if (sizeof (ACE_TCHAR) == 1)
+      data[pos] = static_cast<char> (format[i]);
+    else
+      put_swapped (data + pos, format[i]);
+
+  ACE_INT32 const value = 42;
+  data[pos++] = 'i';
+  put_swapped (data + pos, value);
+  pos += 4;
+
+  len = static_cast<ACE_UINT32> (ACE_OS::strlen (arg));
+  data[pos++] = 's';
+  put_swapped (data + pos, len);
+  pos += 4;
+  for (size_t i = 0; i < len; ++i, pos += sizeof (ACE_TCHAR))
+    if (sizeof (ACE_TCHAR) == 1)
+      data[pos] = static_cast<char> (arg[i]);
+    else
+      put_swapped (data + pos, arg[i]);
+
+  record.msg_binary (data, pos);
+
+  // Send it through CDR, still encoded.
+  ACE_OutputCDR out;
+  if (!(out << record))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("can't insert the record\n")),
+                      -1);
+
+  ACE_InputCDR in (out);
+  ACE_Log_Record copy;
+  if (!(in >> copy))
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("can't extract the record\n")),
+                      -1);
+
+  if (copy.msg_binary () == 0
+      || copy.msg_binary_len () != pos
+      || copy.type () != LM_NOTICE
+      || copy.time_stamp () != record.time_stamp ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("record not extracted as inserted\n")));
+      status = -1;
+    }
+
+  if (ACE_OS::strcmp (copy.msg_data (), ACE_TEXT ("swapped 42 ok\n")) != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("swapped encoding rendered as <%s>\n"),
+                  copy.msg_data ()));
+      status = -1;
+    }
+
+  // Garbage doesn't render.
+  ACE_TCHAR text[ACE_Log_Record::MAXLOGMSGLEN];
+  if (ACE_Log_Binary::render ("\x01\x7f", 2, text, ACE_Log_Record::MAXLOGMSGLEN) != -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("invalid encoding rendered\n")));
+      status = -1;
+    }
+
+  // Nor do directives with more widths than ACE_Log_Msg takes, as a
+  // record off the wire may have, whether their values are all there
+  // or run out where the widths stop fitting.
+  ACE_TCHAR stars[128];
+  stars[0] = '%';
+  for (int i = 1; i <= 120; ++i)
+    stars[i] = '*';
+  stars[121] = 'd';
+  stars[122] = '\0';
+
+  pos = encode_ints (data, stars, 121, 1);
+  if (ACE_Log_Binary::render (data, pos, text, ACE_Log_Record::MAXLOGMSGLEN) != -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("directive of 120 widths rendered\n")));
+      status = -1;
+    }
+
+  pos = encode_ints (data, stars, 9, ACE_INT32_MIN);
+  if (ACE_Log_Binary::render (data, pos, text, ACE_Log_Record::MAXLOGMSGLEN) != -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("directive of too long widths rendered\n")));
+      status = -1;
+    }
+
+  return status;
+}
+
+// Time the logging of a message, with and without the BINARY flag,
+// to a callback which doesn't look at it.
+static void
+time_logging (void)
+{
+  const int iterations = 100000;
+  recorder.render_ = false;
+
+  for (int binary = 0; binary < 2; ++binary)
+    {
+      capture (binary ? ACE_Log_Msg::BINARY : 0);
+
+      ACE_High_Res_Timer timer;
+      timer.start ();
+      for (int i = 0; i < iterations; ++i)
+        ACE_LOG_MSG->log (LM_INFO,
+                          ACE_TEXT ("(%P|%t) request %d from %C took %f ms: %s\n"),
+                          i,
+                          "client.example.com",
+                          1.25,
+                          ACE_TEXT ("ok"));
+      timer.stop ();
+
+      release ();
+
+      ACE_Time_Value tv;
+      timer.elapsed_time (tv);
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%s: %f usecs per message\n"),
+                  binary ? ACE_TEXT ("binary") : ACE_TEXT ("text"),
+                  (tv.sec () * 1.0e6 + tv.usec ()) / iterations));
+    }
+
+  recorder.render_ = true;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Log_Msg_Binary_Test"));
+
+  int status = 0;
+
+  ACE_LOG_MSG->msg_callback (&recorder);
+
+  if (test_formats () == -1)
+    status = 1;
+
+  if (test_fallback () == -1)
+    status = 1;
+
+  time_logging ();
+
+  ACE_LOG_MSG->msg_callback (0);
+
+  if (test_cdr () == -1)
+    status = 1;
+
+  ACE_END_TEST;
+  return status;
+}
@@ -0,0 +1,617 @@
+//=============================================================================
+/**
+ *  @file    Log_Msg_Mapped_File_Test.cpp
+ *
+ *  $Id$
+ *
+ *  This test checks ACE_Log_Msg_Mapped_File: records logged by several
+ *  threads at once over small segments must all be found in the
+ *  finished segments, in order for each thread; find() must seek close
+ *  to the records of a given time through the index of a segment; a
+ *  segment must be switched once older than the maximum age; only the
+ *  last finished segments must be kept, the older ones left by an
+ *  earlier run removed too, whatever their numbers; and
+ *  ACE_Logging_Strategy must log to segments with its -M option,
+ *  keeping the number of them given with -N.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Log_Msg_Mapped_File.h"
+#include "ace/Logging_Strategy.h"
+#include "ace/Log_Msg.h"
+#include "ace/Log_Record.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_Memory.h"
+
+#if defined (ACE_HAS_THREADS) && !defined (ACE_LACKS_MMAP)
+
+static const int THREADS = 4;
+static const int RECORDS = 2000;
+static const size_t SEGMENT_SIZE = 64 * 1024;
+static const int MAX_SEGMENTS = 256;
+
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> next_id;
+
+static void
+segment_path (ACE_TCHAR *path, const ACE_TCHAR *base, int sequence)
+{
+  ACE_OS::sprintf (path, ACE_TEXT ("%s.%06d"), base, sequence);
+}
+
+static void
+remove_segments (const ACE_TCHAR *base)
+{
+  ACE_TCHAR path[MAXPATHLEN + 1];
+  for (int i = 1; i <= MAX_SEGMENTS; ++i)
+    {
+      segment_path (path, base, i);
+      ACE_OS::unlink (path);
+    }
+}
+
+// Read the records of the finished segment at <path> into a string
+// allocated with new [], which is returned, or 0.
+static char *
+read_records (const ACE_TCHAR *path)
+{
+  ACE_HANDLE handle = ACE_OS::open (path, O_RDONLY);
+  if (handle == ACE_INVALID_HANDLE)
+    return 0;
+
+  ACE_OFF_T const size = ACE_OS::filesize (handle);
+  ACE_Log_Msg_Mapped_File::Header header;
+  ACE_Log_Msg_Mapped_File::Trailer trailer;
+  char *records = 0;
+
+  if (size >= static_cast<ACE_OFF_T> (sizeof header + sizeof trailer)
+      && ACE_OS::pread (handle, &header, sizeof header, 0)
+           == static_cast<ssize_t> (sizeof header)
+      && ACE_OS::pread (handle,
+                        &trailer,
+                        sizeof trailer,
+                        size - sizeof trailer)
+           == static_cast<ssize_t> (sizeof trailer))
+    {
+      size_t const used = static_cast<size_t> (trailer.used_);
+      ACE_NEW_NORETURN (records, char[used + 1]);
+      if (records != 0
+          && ACE_OS::pread (handle, records, used, header.header_size_)
+               == static_cast<ssize_t> (used))
+        records[used] = '\0';
+      else
+        {
+          delete [] records;
+          records = 0;
+        }
+    }
+
+  ACE_OS::close (handle);
+  return records;
+}
+
+static ACE_THR_FUNC_RETURN
+producer (void *arg)
+{
+  ACE_Log_Msg_Mapped_File *backend =
+    static_cast<ACE_Log_Msg_Mapped_File *> (arg);
+  long const id = next_id++;
+
+  for (int i = 0; i < RECORDS; ++i)
+    {
+      ACE_TCHAR msg[64];
+      ACE_OS::sprintf (msg,
+                       ACE_TEXT ("producer %ld record %d\n"),
+                       id,
+                       i);
+
+      ACE_Log_Record record (LM_DEBUG,
+                             ACE_OS::gettimeofday (),
+                             ACE_OS::getpid ());
+      record.msg_data (msg);
+      backend->log (record);
+    }
+
+  return 0;
+}
+
+static int
+test_producers (void)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Producers test\n")));
+
+  const ACE_TCHAR *base = ACE_TEXT ("Log_Msg_Mapped_File_Test.seg");
+  remove_segments (base);
+
+  ACE_Log_Msg_Mapped_File backend (base, SEGMENT_SIZE);
+  if (backend.open (0) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), -1);
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (THREADS,
+                                                producer,
+                                                &backend) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")),
+                      -1);
+  ACE_Thread_Manager::instance ()->wait ();
+
+  ACE_UINT64 const last = backend.segment ();
+  backend.close ();
+
+  int status = 0;
+  if (backend.dropped () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%Q records dropped\n"),
+                  static_cast<ACE_UINT64> (backend.dropped ())));
+      status = -1;
+    }
+
+  int next[THREADS];
+  for (int t = 0; t < THREADS; ++t)
+    next[t] = 0;
+
+  int segments = 0;
+  for (int s = 1; status == 0 && s <= static_cast<int> (last); ++s)
+    {
+      ACE_TCHAR path[MAXPATHLEN + 1];
+      segment_path (path, base, s);
+
+      ACE_OFF_T offset = 0;
+      char *records = read_records (path);
+      if (records == 0
+          || ACE_Log_Msg_Mapped_File::find (path,
+                                            ACE_Time_Value::zero,
+                                            offset) == -1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("%p is not a finished segment\n"),
+                      path));
+          delete [] records;
+          status = -1;
+          break;
+        }
+      ++segments;
+
+      for (char *line = records; status == 0 && *line != '\0'; )
+        {
+          char *end = ACE_OS::strchr (line, '\n');
+          if (end != 0)
+            *end = '\0';
+
+          const char *msg = ACE_OS::strstr (line, "producer ");
+          long id = -1;
+          int i = -1;
+          if (msg == 0
+              || ::sscanf (msg, "producer %ld record %d", &id, &i) != 2
+              || id < 0
+              || id >= THREADS)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("unexpected line in %s: %C\n"),
+                          path,
+                          line));
+              status = -1;
+            }
+          else if (i != next[id])
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("record %d of producer %d, expected %d\n"),
+                          i,
+                          static_cast<int> (id),
+                          next[id]));
+              status = -1;
+            }
+          else
+            ++next[id];
+
+          if (end == 0)
+            break;
+          line = end + 1;
+        }
+
+      delete [] records;
+    }
+
+  for (int t = 0; status == 0 && t < THREADS; ++t)
+    if (next[t] != RECORDS)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("%d records of producer %d, expected %d\n"),
+                    next[t],
+                    t,
+                    RECORDS));
+        status = -1;
+      }
+
+  if (status == 0 && segments < 2)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d segments written, expected several\n"),
+                  segments));
+      status = -1;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%d segments of %B bytes written\n"),
+              segments,
+              SEGMENT_SIZE));
+
+  remove_segments (base);
+  return status;
+}
+
+// Return the stamp of the record starting at <line>, or -1.
+static int
+stamp_of (const char *line)
+{
+  const char *msg = ACE_OS::strstr (line, "stamp ");
+  int stamp = -1;
+  if (msg == 0 || ::sscanf (msg, "stamp %d", &stamp) != 1)
+    return -1;
+  return stamp;
+}
+
+static int
+test_find (void)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("find() test\n")));
+
+  const ACE_TCHAR *base = ACE_TEXT ("Log_Msg_Mapped_File_Test.idx");
+  remove_segments (base);
+
+  static const int STAMPS = 2000;
+  static const int FIRST = 1000;
+
+  {
+    ACE_Log_Msg_Mapped_File backend (base, 1024 * 1024);
+    if (backend.open (0) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), -1);
+
+    for (int i = 0; i < STAMPS; ++i)
+      {
+        ACE_TCHAR msg[64];
+        ACE_OS::sprintf (msg, ACE_TEXT ("stamp %d\n"), FIRST + i);
+
+        ACE_Log_Record record (LM_DEBUG,
+                               ACE_Time_Value (FIRST + i),
+                               ACE_OS::getpid ());
+        record.msg_data (msg);
+        backend.log (record);
+      }
+  }
+
+  ACE_TCHAR path[MAXPATHLEN + 1];
+  segment_path (path, base, 1);
+  char *records = read_records (path);
+  if (records == 0)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), path), -1);
+
+  int status = 0;
+  const int times[] = { 0, FIRST, FIRST + 1, FIRST + 777, FIRST + 1500,
+                        FIRST + STAMPS - 1, FIRST + 2 * STAMPS };
+
+  for (size_t t = 0; t < sizeof times / sizeof times[0]; ++t)
+    {
+      int const time = times[t];
+      ACE_OFF_T offset = 0;
+      if (ACE_Log_Msg_Mapped_File::find (path,
+                                         ACE_Time_Value (time),
+                                         offset) == -1)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("find")));
+          status = -1;
+          continue;
+        }
+
+      size_t const start =
+        static_cast<size_t> (offset)
+        - sizeof (ACE_Log_Msg_Mapped_File::Header);
+      const char *line = records + start;
+      int const stamp = stamp_of (line);
+
+      // The offset must start a record logged before <time>, if any,
+      // less than an index interval before the first one at <time>.
+      if (stamp == -1
+          || (start != 0 && line[-1] != '\n')
+          || (stamp >= time && start != 0))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("find (%d) gave record %d at %B\n"),
+                      time,
+                      stamp,
+                      start));
+          status = -1;
+          continue;
+        }
+
+      const char *target = line;
+      while (*target != '\0' && stamp_of (target) < time)
+        {
+          target = ACE_OS::strchr (target, '\n');
+          if (target == 0)
+            break;
+          ++target;
+        }
+
+      if (target != 0
+          && *target != '\0'
+          && static_cast<size_t> (target - line)
+               > 2 * ACE_DEFAULT_LOG_SEGMENT_INDEX_INTERVAL)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("find (%d) gave %B, %B bytes before\n"),
+                      time,
+                      start,
+                      static_cast<size_t> (target - line)));
+          status = -1;
+        }
+    }
+
+  delete [] records;
+
+  // Not a finished segment.
+  const ACE_TCHAR *text = ACE_TEXT ("Log_Msg_Mapped_File_Test.txt");
+  ACE_HANDLE handle = ACE_OS::open (text,
+                                    O_RDWR | O_CREAT | O_TRUNC,
+                                    ACE_DEFAULT_FILE_PERMS);
+  if (handle != ACE_INVALID_HANDLE)
+    {
+      char junk[256];
+      ACE_OS::memset (junk, 'x', sizeof junk);
+      ACE_OS::write (handle, junk, sizeof junk);
+      ACE_OS::close (handle);
+
+      ACE_OFF_T offset = 0;
+      if (ACE_Log_Msg_Mapped_File::find (text,
+                                         ACE_Time_Value::zero,
+                                         offset) != -1
+          || errno != EINVAL)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("find() accepted a file of text\n")));
+          status = -1;
+        }
+      ACE_OS::unlink (text);
+    }
+
+  remove_segments (base);
+  return status;
+}
+
+static int
+test_max_age (void)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Maximum age test\n")));
+
+  const ACE_TCHAR *base = ACE_TEXT ("Log_Msg_Mapped_File_Test.age");
+  remove_segments (base);
+
+  ACE_Log_Msg_Mapped_File backend (base,
+                                   SEGMENT_SIZE,
+                                   ACE_Time_Value (1));
+  if (backend.open (0) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), -1);
+
+  ACE_Log_Record record (LM_DEBUG,
+                         ACE_OS::gettimeofday (),
+                         ACE_OS::getpid ());
+  record.msg_data (ACE_TEXT ("aging\n"));
+  backend.log (record);
+
+  ACE_UINT64 const first = backend.segment ();
+  ACE_OS::sleep (ACE_Time_Value (2, 500000));
+  ACE_UINT64 const second = backend.segment ();
+  backend.close ();
+
+  int status = 0;
+  ACE_TCHAR path[MAXPATHLEN + 1];
+  segment_path (path, base, static_cast<int> (first));
+  ACE_OFF_T offset = 0;
+
+  if (second <= first
+      || ACE_Log_Msg_Mapped_File::find (path,
+                                        ACE_Time_Value::zero,
+                                        offset) == -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("segment %Q not switched after its age, ")
+                  ACE_TEXT ("current is %Q\n"),
+                  first,
+                  second));
+      status = -1;
+    }
+
+  remove_segments (base);
+  return status;
+}
+
+static int
+test_max_segments (void)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Maximum number of segments test\n")));
+
+  const ACE_TCHAR *base = ACE_TEXT ("Log_Msg_Mapped_File_Test.max");
+  remove_segments (base);
+
+  // Segments of an earlier run, with a gap between them.
+  ACE_TCHAR path[MAXPATHLEN + 1];
+  static const int stale[] = { 3, 7 };
+  for (size_t i = 0; i < sizeof stale / sizeof stale[0]; ++i)
+    {
+      segment_path (path, base, stale[i]);
+      ACE_HANDLE handle = ACE_OS::open (path,
+                                        O_RDWR | O_CREAT | O_TRUNC,
+                                        ACE_DEFAULT_FILE_PERMS);
+      if (handle == ACE_INVALID_HANDLE)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), path), -1);
+      ACE_OS::close (handle);
+    }
+
+  ACE_Log_Msg_Mapped_File backend (base,
+                                   SEGMENT_SIZE,
+                                   ACE_Time_Value::zero,
+                                   2);
+  if (backend.open (0) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), -1);
+
+  int status = 0;
+  if (backend.segment () != 8)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("first segment is %Q, expected 8\n"),
+                  backend.segment ()));
+      status = -1;
+    }
+
+  // Finish the segments 8 to 12.
+  ACE_Log_Record record (LM_DEBUG,
+                         ACE_OS::gettimeofday (),
+                         ACE_OS::getpid ());
+  record.msg_data (ACE_TEXT ("kept or not\n"));
+  for (int i = 0; i < 5; ++i)
+    {
+      backend.log (record);
+      if (i < 4)
+        backend.rotate ();
+    }
+  backend.close ();
+
+  for (int s = 1; s <= 16; ++s)
+    {
+      segment_path (path, base, s);
+      bool const kept = ACE_OS::access (path, F_OK) == 0;
+      if (kept != (s == 11 || s == 12))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("segment %d %C\n"),
+                      s,
+                      kept ? "kept" : "removed"));
+          status = -1;
+        }
+    }
+
+  remove_segments (base);
+  return status;
+}
+
+static int
+test_logging_strategy (void)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("ACE_Logging_Strategy -M test\n")));
+
+  const ACE_TCHAR *base = ACE_TEXT ("Log_Msg_Mapped_File_Test.log");
+  remove_segments (base);
+
+  static const int LINES = 5000;
+
+  // The strategy replaces the output flags of the test's log.
+  u_long const flags = ACE_LOG_MSG->flags ();
+
+  {
+    ACE_Logging_Strategy strategy;
+    ACE_TCHAR arg0[] = ACE_TEXT ("Logging_Strategy");
+    ACE_TCHAR arg1[] = ACE_TEXT ("-s");
+    ACE_TCHAR arg2[] = ACE_TEXT ("Log_Msg_Mapped_File_Test.log");
+    ACE_TCHAR arg3[] = ACE_TEXT ("-M");
+    ACE_TCHAR arg4[] = ACE_TEXT ("-m");
+    ACE_TCHAR arg5[] = ACE_TEXT ("64");
+    ACE_TCHAR arg6[] = ACE_TEXT ("-N");
+    ACE_TCHAR arg7[] = ACE_TEXT ("2");
+    ACE_TCHAR *argv[] = { arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, 0 };
+
+    if (strategy.init (8, argv) == -1)
+      {
+        ACE_LOG_MSG->set_flags (flags);
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("init")),
+                          -1);
+      }
+
+    for (int i = 0; i < LINES; ++i)
+      ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("strategy line %d\n"), i));
+
+    strategy.fini ();
+  }
+
+  ACE_LOG_MSG->clr_flags (ACE_Log_Msg::CUSTOM);
+  ACE_LOG_MSG->set_flags (flags);
+
+  // Only the last two segments are kept.
+  int status = 0;
+  int kept = 0;
+  int last = -1;
+  for (int s = 1; s <= MAX_SEGMENTS; ++s)
+    {
+      ACE_TCHAR path[MAXPATHLEN + 1];
+      segment_path (path, base, s);
+      char *records = read_records (path);
+      if (records == 0)
+        continue;
+
+      ++kept;
+      for (const char *line = ACE_OS::strstr (records, "strategy line ");
+           line != 0;
+           line = ACE_OS::strstr (line + 1, "strategy line "))
+        {
+          int i = -1;
+          if (::sscanf (line, "strategy line %d", &i) == 1 && i > last)
+            last = i;
+        }
+      delete [] records;
+    }
+
+  if (kept != 2 || last != LINES - 1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d segments kept, expected 2, last line %d\n"),
+                  kept,
+                  last));
+      status = -1;
+    }
+
+  remove_segments (base);
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Log_Msg_Mapped_File_Test"));
+
+  int status = 0;
+
+  if (test_producers () != 0)
+    status = 1;
+  if (test_find () != 0)
+    status = 1;
+  if (test_max_age () != 0)
+    status = 1;
+  if (test_max_segments () != 0)
+    status = 1;
+  if (test_logging_strategy () != 0)
+    status = 1;
+
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Log_Msg_Mapped_File_Test"));
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("ACE_Log_Msg_Mapped_File requires threads and mmap\n")));
+
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* ACE_HAS_THREADS && !ACE_LACKS_MMAP */
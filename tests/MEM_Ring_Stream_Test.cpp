@@ -0,0 +1,519 @@
+//=============================================================================
+/**
+ *  @file    MEM_Ring_Stream_Test.cpp
+ *
+ *  $Id$
+ *
+ *    This test checks <ACE_MEM_Ring_Stream>: round trips through an
+ *    echo thread using the zero-copy methods, with messages wrapping
+ *    around the rings, a one-way transfer to a handler of a reactor,
+ *    the timeouts, the end of the stream, and a peer process going
+ *    away without closing its stream.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/MEM_Ring_Acceptor.h"
+#include "ace/MEM_Ring_Connector.h"
+#include "ace/Event_Handler.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Lib_Find.h"
+#include "ace/Reactor.h"
+#include "ace/Select_Reactor.h"
+#include "ace/Thread_Manager.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_wait.h"
+#include "ace/OS_NS_unistd.h"
+
+#if defined (ACE_HAS_MEM_RING_STREAM) && defined (ACE_HAS_THREADS)
+
+static const int ROUND_TRIPS = 10000;
+static const size_t MESSAGE_SIZE = 64;
+static const size_t TRANSFER_SIZE = 1024 * 1024;
+
+static ACE_UNIX_Addr rendezvous;
+
+static char
+pattern (size_t i)
+{
+  return static_cast<char> (i % 251);
+}
+
+/// Echoes what it receives, through the zero-copy methods, until the
+/// end of the stream.
+static ACE_THR_FUNC_RETURN
+echo (void *arg)
+{
+  ACE_MEM_Ring_Acceptor *acceptor = static_cast<ACE_MEM_Ring_Acceptor *> (arg);
+  ACE_MEM_Ring_Stream stream;
+
+  if (acceptor->accept (stream) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("(%t) %p\n"), ACE_TEXT ("accept")),
+                      0);
+
+  for (;;)
+    {
+      const void *in = 0;
+      ssize_t const n = stream.peek (in);
+      if (n <= 0)
+        {
+          if (n == -1)
+            ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%t) %p\n"), ACE_TEXT ("peek")));
+          break;
+        }
+
+      void *out = 0;
+      ssize_t const room = stream.reserve (out, 1);
+      if (room == -1)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%t) %p\n"), ACE_TEXT ("reserve")));
+          break;
+        }
+
+      size_t const len = n < room ? n : room;
+      ACE_OS::memcpy (out, in, len);
+      stream.commit (len);
+      stream.consume (len);
+    }
+
+  stream.close ();
+  return 0;
+}
+
+/// Connects the stream passed.
+static ACE_THR_FUNC_RETURN
+connect (void *arg)
+{
+  ACE_MEM_Ring_Stream *stream = static_cast<ACE_MEM_Ring_Stream *> (arg);
+  ACE_MEM_Ring_Connector connector;
+
+  if (connector.connect (*stream, rendezvous) == -1)
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("(%t) %p\n"), ACE_TEXT ("connect")));
+  return 0;
+}
+
+/// Sends TRANSFER_SIZE bytes, then closes.
+static ACE_THR_FUNC_RETURN
+transfer (void *)
+{
+  ACE_MEM_Ring_Stream stream;
+  ACE_MEM_Ring_Connector connector;
+
+  if (connector.connect (stream, rendezvous) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("(%t) %p\n"), ACE_TEXT ("connect")),
+                      0);
+
+  char buf[1000];
+  for (size_t sent = 0; sent < TRANSFER_SIZE; )
+    {
+      size_t len = TRANSFER_SIZE - sent;
+      if (len > sizeof buf)
+        len = sizeof buf;
+      for (size_t i = 0; i < len; ++i)
+        buf[i] = pattern (sent + i);
+
+      if (stream.send_n (buf, len) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("(%t) %p\n"),
+                           ACE_TEXT ("send_n")),
+                          0);
+      sent += len;
+    }
+
+  stream.close ();
+  return 0;
+}
+
+static int
+test_echo (ACE_MEM_Ring_Acceptor &acceptor)
+{
+  int status = 0;
+
+  if (ACE_Thread_Manager::instance ()->spawn (echo, &acceptor) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")), 1);
+
+  ACE_MEM_Ring_Stream stream;
+  ACE_MEM_Ring_Connector connector;
+  if (connector.connect (stream, rendezvous) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("connect")), 1);
+
+  size_t const page = ACE_OS::allocation_granularity ();
+  if (stream.capacity () != page)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("capacity %B, expected %B\n"),
+                  stream.capacity (),
+                  page));
+      status = 1;
+    }
+
+  char out[MESSAGE_SIZE];
+  char in[MESSAGE_SIZE];
+  ACE_OS::memset (out, 'x', sizeof out);
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+  for (int i = 0; i < ROUND_TRIPS; ++i)
+    if (stream.send_n (out, sizeof out) != ssize_t (sizeof out)
+        || stream.recv_n (in, sizeof in) != ssize_t (sizeof in))
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                         ACE_TEXT ("round trip")),
+                        1);
+  timer.stop ();
+
+  ACE_hrtime_t usecs;
+  timer.elapsed_microseconds (usecs);
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("%d round trips of %B bytes: %.2f usec each\n"),
+              ROUND_TRIPS,
+              MESSAGE_SIZE,
+              static_cast<double> (usecs) / ROUND_TRIPS));
+
+  // Messages of sizes which do not divide the ring, so that they wrap
+  // around it.
+  char big_out[3000];
+  char big_in[3000];
+  size_t offset = 0;
+  for (size_t len = 1; len <= sizeof big_out; len += 37)
+    {
+      for (size_t i = 0; i < len; ++i)
+        big_out[i] = pattern (offset + i);
+      offset += len;
+
+      if (stream.send_n (big_out, len) != ssize_t (len)
+          || stream.recv_n (big_in, len) != ssize_t (len))
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("echo")),
+                          1);
+
+      if (ACE_OS::memcmp (big_out, big_in, len) != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("echo of %B bytes differs\n"),
+                      len));
+          status = 1;
+          break;
+        }
+    }
+
+  stream.close ();
+  ACE_Thread_Manager::instance ()->wait ();
+  return status;
+}
+
+/// Checks the bytes read in the reactor, until the end of the stream.
+class Receiver : public ACE_Event_Handler
+{
+public:
+  Receiver (ACE_MEM_Ring_Stream &stream)
+    : stream_ (stream),
+      received_ (0),
+      errors_ (0),
+      done_ (false)
+  {
+  }
+
+  virtual ACE_HANDLE get_handle (void) const
+  {
+    return this->stream_.get_handle ();
+  }
+
+  virtual int handle_input (ACE_HANDLE)
+  {
+    char buf[1500];
+    for (;;)
+      {
+        ssize_t const n = this->stream_.recv (buf,
+                                              sizeof buf,
+                                              &ACE_Time_Value::zero);
+        if (n == -1 && errno == EWOULDBLOCK)
+          return 0;
+
+        if (n <= 0)
+          {
+            if (n == -1)
+              {
+                ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("recv")));
+                ++this->errors_;
+              }
+            this->done_ = true;
+            return -1;
+          }
+
+        for (ssize_t i = 0; i < n; ++i)
+          if (buf[i] != pattern (this->received_ + i))
+            {
+              ++this->errors_;
+              break;
+            }
+        this->received_ += n;
+      }
+  }
+
+  virtual int handle_close (ACE_HANDLE, ACE_Reactor_Mask)
+  {
+    return 0;
+  }
+
+  size_t received (void) const { return this->received_; }
+  int errors (void) const { return this->errors_; }
+  bool done (void) const { return this->done_; }
+
+private:
+  ACE_MEM_Ring_Stream &stream_;
+  size_t received_;
+  int errors_;
+  bool done_;
+};
+
+static int
+test_reactor (ACE_MEM_Ring_Acceptor &acceptor)
+{
+  int status = 0;
+
+  if (ACE_Thread_Manager::instance ()->spawn (transfer) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")), 1);
+
+  ACE_MEM_Ring_Stream stream;
+  if (acceptor.accept (stream) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("accept")), 1);
+
+  ACE_Select_Reactor select_reactor;
+  ACE_Reactor reactor (&select_reactor);
+  Receiver receiver (stream);
+
+  if (reactor.register_handler (&receiver,
+                                ACE_Event_Handler::READ_MASK) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("register_handler")),
+                      1);
+
+  ACE_Time_Value limit (60);
+  while (!receiver.done () && limit > ACE_Time_Value::zero)
+    if (reactor.handle_events (limit) == -1)
+      break;
+
+  if (!receiver.done ()
+      || receiver.received () != TRANSFER_SIZE
+      || receiver.errors () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("reactor received %B of %B bytes, %d errors\n"),
+                  receiver.received (),
+                  TRANSFER_SIZE,
+                  receiver.errors ()));
+      status = 1;
+    }
+
+  if (!receiver.done ())
+    reactor.remove_handler (&receiver,
+                            ACE_Event_Handler::READ_MASK
+                            | ACE_Event_Handler::DONT_CALL);
+  ACE_Thread_Manager::instance ()->wait ();
+  return status;
+}
+
+static int
+test_close (ACE_MEM_Ring_Acceptor &acceptor)
+{
+  int status = 0;
+
+  ACE_MEM_Ring_Stream client;
+  if (ACE_Thread_Manager::instance ()->spawn (connect, &client) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")), 1);
+
+  ACE_MEM_Ring_Stream server;
+  if (acceptor.accept (server) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("accept")), 1);
+  ACE_Thread_Manager::instance ()->wait ();
+
+  char c = 0;
+  ACE_Time_Value tv (0, 100000);
+  if (server.recv (&c, 1, &ACE_Time_Value::zero) != -1 || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("recv of nothing did not block\n")));
+      status = 1;
+    }
+  if (server.recv (&c, 1, &tv) != -1 || errno != ETIME)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("recv of nothing did not time out\n")));
+      status = 1;
+    }
+
+  void *buf = 0;
+  if (client.reserve (buf, client.capacity () + 1) != -1 || errno != EINVAL)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("reserve beyond the capacity\n")));
+      status = 1;
+    }
+
+  // Fill the ring.
+  size_t sent = 0;
+  for (;;)
+    {
+      char block[1000];
+      ACE_OS::memset (block, 'y', sizeof block);
+      ssize_t const n = client.send (block, sizeof block, &ACE_Time_Value::zero);
+      if (n == -1)
+        break;
+      sent += n;
+    }
+  if (errno != EWOULDBLOCK || sent != client.capacity ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("filled %B bytes of %B\n"),
+                  sent,
+                  client.capacity ()));
+      status = 1;
+    }
+
+  // The data sent stays readable after the writer closes.
+  client.close_writer ();
+  if (client.send (&c, 1) != -1 || errno != EPIPE)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("send after close_writer()\n")));
+      status = 1;
+    }
+
+  size_t received = 0;
+  for (;;)
+    {
+      const void *data = 0;
+      ssize_t const n = server.peek (data, 1, &tv);
+      if (n <= 0)
+        {
+          if (n == -1)
+            {
+              ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("peek")));
+              status = 1;
+            }
+          break;
+        }
+      received += n;
+      server.consume (n);
+    }
+  if (received != sent)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("received %B bytes of %B\n"),
+                  received,
+                  sent));
+      status = 1;
+    }
+
+  server.close ();
+  if (client.recv (&c, 1, &tv) != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("no end of stream after close()\n")));
+      status = 1;
+    }
+  if (server.recv (&c, 1) != -1 || errno != ENOTCONN)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("recv on a closed stream\n")));
+      status = 1;
+    }
+
+  return status;
+}
+
+static int
+test_peer_gone (ACE_MEM_Ring_Acceptor &acceptor)
+{
+#if defined (ACE_LACKS_FORK)
+  ACE_UNUSED_ARG (acceptor);
+  return 0;
+#else
+  pid_t const pid = ACE_OS::fork (ACE_TEXT ("MEM_Ring_Stream_Test"));
+  if (pid == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("fork")), 1);
+
+  if (pid == 0)
+    {
+      // Send a message, then go away without closing the stream.
+      ACE_MEM_Ring_Stream stream;
+      ACE_MEM_Ring_Connector connector;
+      if (connector.connect (stream, rendezvous) == 0)
+        stream.send_n ("hello", 5);
+      ACE_OS::_exit (0);
+    }
+
+  int status = 0;
+  ACE_MEM_Ring_Stream stream;
+  ACE_Time_Value tv (10);
+  if (acceptor.accept (stream, 0, &tv) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("accept")), 1);
+
+  char buf[8];
+  ssize_t const n = stream.recv_n (buf, 5, &tv);
+  if (n != 5 || ACE_OS::memcmp (buf, "hello", 5) != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("got %b bytes from the child\n"), n));
+      status = 1;
+    }
+
+  // The child is gone by the time the socket says so.
+  if (stream.recv (buf, 1, &tv) != 0)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"),
+                  ACE_TEXT ("no end of stream from the child")));
+      status = 1;
+    }
+  if (stream.send ("x", 1, &tv) != -1 || errno != EPIPE)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("send to the child gone\n")));
+      status = 1;
+    }
+
+  ACE_OS::waitpid (pid, 0, 0);
+  return status;
+#endif /* ACE_LACKS_FORK */
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("MEM_Ring_Stream_Test"));
+
+  ACE_TCHAR path[MAXPATHLEN];
+  if (ACE::get_temp_dir (path, MAXPATHLEN - 32) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("get_temp_dir")), 1);
+  ACE_TCHAR name[32];
+  ACE_OS::sprintf (name, ACE_TEXT ("MEM_Ring_Stream_Test_%d"),
+                   static_cast<int> (ACE_OS::getpid ()));
+  ACE_OS::strcat (path, name);
+  rendezvous.set (path);
+
+  ACE_MEM_Ring_Acceptor acceptor;
+  if (acceptor.open (rendezvous) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), 1);
+
+  // The smallest rings, so that the transfers wrap around them.
+  acceptor.ring_size (1);
+
+  int status = test_echo (acceptor);
+  status += test_reactor (acceptor);
+  status += test_close (acceptor);
+  status += test_peer_gone (acceptor);
+
+  acceptor.remove ();
+
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("MEM_Ring_Stream_Test"));
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("ACE_MEM_Ring_Stream is not supported ")
+              ACE_TEXT ("on this platform\n")));
+
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* ACE_HAS_MEM_RING_STREAM && ACE_HAS_THREADS */
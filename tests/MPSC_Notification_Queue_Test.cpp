@@ -0,0 +1,241 @@
+//=============================================================================
+/**
+ *  @file    MPSC_Notification_Queue_Test.cpp
+ *
+ *  $Id$
+ *
+ *  This test checks ACE_MPSC_Notification_Queue: notifications pushed
+ *  concurrently by several threads are all popped, in order for each
+ *  thread, the wakeup handle is readable whenever notifications are
+ *  left and writes to it are coalesced, and purged notifications are
+ *  not returned.
+ */
+//=============================================================================
+
+#include "test_config.h"
+
+#if defined (ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE)
+
+#include "ace/MPSC_Notification_Queue.h"
+#include "ace/ACE.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Atomic_Op.h"
+
+static const int PRODUCERS = 4;
+static const int NOTIFICATIONS = 50000;
+
+class Handler : public ACE_Event_Handler
+{
+};
+
+// One handler per producer; the mask carries the sequence number.
+static Handler handlers[PRODUCERS];
+
+static ACE_THR_FUNC_RETURN
+producer (void *arg)
+{
+  ACE_MPSC_Notification_Queue *queue =
+    static_cast<ACE_MPSC_Notification_Queue *> (arg);
+
+  static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> next_id (0);
+  long const id = next_id++;
+
+  for (int i = 0; i < NOTIFICATIONS; ++i)
+    {
+      ACE_Notification_Buffer const b (&handlers[id],
+                                       static_cast<ACE_Reactor_Mask> (i));
+      if (queue->push (b) == -1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) %p\n"),
+                      ACE_TEXT ("push")));
+          break;
+        }
+    }
+
+  return 0;
+}
+
+static int
+test_producers (void)
+{
+  ACE_MPSC_Notification_Queue queue;
+
+  if (queue.open () == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) %p\n"),
+                       ACE_TEXT ("open")),
+                      -1);
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (PRODUCERS,
+                                                producer,
+                                                &queue) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) %p\n"),
+                       ACE_TEXT ("spawn_n")),
+                      -1);
+
+  int status = 0;
+  int expected[PRODUCERS] = { 0 };
+  long received = 0;
+  long wakeups = 0;
+
+  while (received < long (PRODUCERS) * NOTIFICATIONS)
+    {
+      ACE_Notification_Buffer b;
+      int const result = queue.pop (b);
+
+      if (result == 1)
+        {
+          ptrdiff_t const id = static_cast<Handler *> (b.eh_) - handlers;
+          if (id < 0 || id >= PRODUCERS
+              || b.mask_ != static_cast<ACE_Reactor_Mask> (expected[id]))
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("(%t) unexpected notification %d ")
+                          ACE_TEXT ("from producer %d\n"),
+                          static_cast<int> (b.mask_),
+                          static_cast<int> (id)));
+              status = -1;
+              break;
+            }
+          ++expected[id];
+          ++received;
+          continue;
+        }
+
+      if (result == -1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) %p\n"),
+                      ACE_TEXT ("pop")));
+          status = -1;
+          break;
+        }
+
+      // The queue is empty for now; a push must make the handle
+      // readable.
+      ACE_Time_Value timeout (5);
+      if (ACE::handle_read_ready (queue.handle (), &timeout) != 1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) no wakeup with %d of %d ")
+                      ACE_TEXT ("notifications received\n"),
+                      static_cast<int> (received),
+                      PRODUCERS * NOTIFICATIONS));
+          status = -1;
+          break;
+        }
+      ++wakeups;
+    }
+
+  ACE_Thread_Manager::instance ()->wait ();
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%d notifications, %d wakeups\n"),
+              static_cast<int> (received),
+              static_cast<int> (wakeups)));
+
+  if (status == 0 && wakeups > received)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%t) wakeups were not coalesced\n")));
+      status = -1;
+    }
+
+  // Everything was popped, so the handle must not be readable.
+  ACE_Notification_Buffer b;
+  ACE_Time_Value no_wait (ACE_Time_Value::zero);
+  if (status == 0
+      && (queue.pop (b) != 0
+          || ACE::handle_read_ready (queue.handle (), &no_wait) == 1))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%t) wakeup left on an empty queue\n")));
+      status = -1;
+    }
+
+  return status;
+}
+
+static int
+test_purge (void)
+{
+  ACE_MPSC_Notification_Queue queue;
+
+  if (queue.open () == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) %p\n"),
+                       ACE_TEXT ("open")),
+                      -1);
+
+  ACE_Reactor_Mask const read_mask = ACE_Event_Handler::READ_MASK;
+
+  for (int i = 0; i < 3; ++i)
+    {
+      queue.push (ACE_Notification_Buffer (&handlers[0], read_mask));
+      queue.push (ACE_Notification_Buffer (&handlers[1], read_mask));
+    }
+
+  int const purged =
+    queue.purge_pending_notifications (&handlers[0],
+                                       ACE_Event_Handler::ALL_EVENTS_MASK);
+  if (purged != 3)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) purged %d notifications; ")
+                       ACE_TEXT ("expected 3\n"),
+                       purged),
+                      -1);
+
+  int popped = 0;
+  ACE_Notification_Buffer b;
+  while (queue.pop (b) == 1)
+    {
+      if (b.eh_ != &handlers[1])
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("(%t) purged notification popped\n")),
+                          -1);
+      ++popped;
+    }
+
+  if (popped != 3)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) popped %d notifications; ")
+                       ACE_TEXT ("expected 3\n"),
+                       popped),
+                      -1);
+
+  return 0;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("MPSC_Notification_Queue_Test"));
+
+  int status = 0;
+
+  if (test_purge () == -1)
+    status = 1;
+
+  if (test_producers () == -1)
+    status = 1;
+
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("MPSC_Notification_Queue_Test"));
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE ")
+              ACE_TEXT ("is not defined\n")));
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* ACE_HAS_REACTOR_MPSC_NOTIFICATION_QUEUE */
@@ -0,0 +1,378 @@
+//=============================================================================
+/**
+ *  @file    Magazine_Allocator_Test.cpp
+ *
+ *  $Id$
+ *
+ *  This test checks ACE_Dynamic_Magazine_Allocator and
+ *  ACE_Magazine_Allocator: every chunk of the pool can be allocated
+ *  and goes back to the depot once freed, chunks can be freed by
+ *  another thread than the one which allocated them, and the
+ *  magazines of threads which exit are returned, also when a chunk
+ *  could not be put in a magazine.  It also compares
+ *  the speed of concurrent malloc()/free() with
+ *  ACE_Dynamic_Cached_Allocator.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/Magazine_Allocator_T.h"
+#include "ace/Malloc_T.h"
+#include "ace/OS_NS_string.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Barrier.h"
+#include "ace/Atomic_Op.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Null_Mutex.h"
+
+static const size_t CHUNK_SIZE = 40;
+static const size_t MAGAZINE_SIZE = 8;
+
+typedef char MEMBLOCK[CHUNK_SIZE];
+
+static int
+test_pool (void)
+{
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT (" (%t) ACE_Magazine_Allocator pool test...\n")));
+
+  // Not a multiple of the magazine size on purpose.
+  const size_t n_chunks = 101;
+
+  ACE_Magazine_Allocator<MEMBLOCK, ACE_SYNCH_NULL_MUTEX>
+    allocator (n_chunks, MAGAZINE_SIZE);
+
+  if (allocator.pool_depth () != n_chunks)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT (" (%t) pool depth is %B, expected %B\n"),
+                       allocator.pool_depth (),
+                       n_chunks),
+                      -1);
+
+  char *chunks[n_chunks];
+  size_t i;
+
+  for (i = 0; i < n_chunks; ++i)
+    {
+      chunks[i] = static_cast<char *> (allocator.malloc (CHUNK_SIZE));
+      if (chunks[i] == 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT (" (%t) malloc failed at chunk %B\n"),
+                           i),
+                          -1);
+      ACE_OS::memset (chunks[i], static_cast<int> (i), CHUNK_SIZE);
+    }
+
+  if (allocator.malloc () != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT (" (%t) malloc succeeded on an empty pool\n")),
+                      -1);
+
+  if (allocator.malloc (CHUNK_SIZE + 1) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT (" (%t) malloc succeeded for a big chunk\n")),
+                      -1);
+
+  // Chunks overlapping would have overwritten each other.
+  for (i = 0; i < n_chunks; ++i)
+    for (size_t j = 0; j < CHUNK_SIZE; ++j)
+      if (chunks[i][j] != static_cast<char> (i))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT (" (%t) chunk %B was overwritten\n"),
+                           i),
+                          -1);
+
+  for (i = 0; i < n_chunks; ++i)
+    allocator.free (chunks[i]);
+
+  allocator.flush ();
+
+  if (allocator.pool_depth () != n_chunks)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT (" (%t) pool depth is %B after flush, ")
+                       ACE_TEXT ("expected %B\n"),
+                       allocator.pool_depth (),
+                       n_chunks),
+                      -1);
+
+  return 0;
+}
+
+// A lock that fails to be acquired <refusals> times.
+class Refusing_Mutex : public ACE_Null_Mutex
+{
+public:
+  int acquire (void)
+  {
+    if (refusals > 0)
+      {
+        --refusals;
+        return -1;
+      }
+    return 0;
+  }
+
+  static int refusals;
+};
+
+int Refusing_Mutex::refusals = 0;
+
+static int
+test_no_magazine (void)
+{
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT (" (%t) ACE_Magazine_Allocator free without ")
+              ACE_TEXT ("a magazine test...\n")));
+
+  // Two magazines and one chunk.
+  const size_t n_chunks = 2 * MAGAZINE_SIZE + 1;
+
+  ACE_Magazine_Allocator<MEMBLOCK, Refusing_Mutex>
+    allocator (n_chunks, MAGAZINE_SIZE);
+
+  void *chunks[n_chunks];
+  size_t i;
+
+  for (i = 0; i < n_chunks; ++i)
+    chunks[i] = allocator.malloc ();
+
+  // Fill both magazines of the thread, then fail to trade one for an
+  // empty magazine: the last chunk must go to the depot on its own.
+  for (i = 0; i < n_chunks - 1; ++i)
+    allocator.free (chunks[i]);
+  Refusing_Mutex::refusals = 1;
+  allocator.free (chunks[n_chunks - 1]);
+  Refusing_Mutex::refusals = 0;
+
+  allocator.flush ();
+
+  if (allocator.pool_depth () != n_chunks)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT (" (%t) pool depth is %B, expected %B\n"),
+                       allocator.pool_depth (),
+                       n_chunks),
+                      -1);
+
+  for (i = 0; i < n_chunks; ++i)
+    if ((chunks[i] = allocator.malloc ()) == 0)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT (" (%t) malloc failed at chunk %B\n"),
+                         i),
+                        -1);
+
+  if (allocator.malloc () != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT (" (%t) malloc succeeded on an empty pool\n")),
+                      -1);
+
+  for (i = 0; i < n_chunks; ++i)
+    allocator.free (chunks[i]);
+
+  return 0;
+}
+
+#if defined (ACE_HAS_THREADS)
+
+static const size_t THREADS = 4;
+static const size_t PER_THREAD = 100;
+static const size_t ROUNDS = 200;
+
+typedef ACE_Dynamic_Magazine_Allocator<ACE_SYNCH_MUTEX> MAGAZINE_ALLOCATOR;
+
+struct Cross_Free_Args
+{
+  MAGAZINE_ALLOCATOR *allocator_;
+  ACE_Barrier *barrier_;
+  char *chunks_[THREADS][PER_THREAD];
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> next_id_;
+  ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> errors_;
+};
+
+// Each round, every thread fills chunks of its own, then checks and
+// frees those of its neighbour.
+static ACE_THR_FUNC_RETURN
+cross_free (void *arg)
+{
+  Cross_Free_Args *args = static_cast<Cross_Free_Args *> (arg);
+  size_t const id = static_cast<size_t> (args->next_id_++);
+  size_t const neighbour = (id + 1) % THREADS;
+
+  for (size_t round = 0; round < ROUNDS; ++round)
+    {
+      char const mark = static_cast<char> (id + round);
+
+      for (size_t i = 0; i < PER_THREAD; ++i)
+        {
+          char *chunk =
+            static_cast<char *> (args->allocator_->malloc (CHUNK_SIZE));
+          if (chunk == 0)
+            {
+              ++args->errors_;
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT (" (%t) malloc failed\n")));
+            }
+          else
+            ACE_OS::memset (chunk, mark, CHUNK_SIZE);
+          args->chunks_[id][i] = chunk;
+        }
+
+      args->barrier_->wait ();
+
+      char const expected = static_cast<char> (neighbour + round);
+
+      for (size_t i = 0; i < PER_THREAD; ++i)
+        {
+          char *chunk = args->chunks_[neighbour][i];
+          if (chunk == 0)
+            continue;
+
+          for (size_t j = 0; j < CHUNK_SIZE; ++j)
+            if (chunk[j] != expected)
+              {
+                ++args->errors_;
+                ACE_ERROR ((LM_ERROR,
+                            ACE_TEXT (" (%t) chunk of thread %B ")
+                            ACE_TEXT ("was overwritten\n"),
+                            neighbour));
+                break;
+              }
+
+          args->allocator_->free (chunk);
+        }
+
+      args->barrier_->wait ();
+    }
+
+  return 0;
+}
+
+static int
+test_cross_free (void)
+{
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT (" (%t) ACE_Dynamic_Magazine_Allocator ")
+              ACE_TEXT ("cross-thread free test...\n")));
+
+  // Room for the chunks in use plus the magazines cached by the
+  // threads.
+  const size_t n_chunks = THREADS * (PER_THREAD + 2 * MAGAZINE_SIZE);
+
+  MAGAZINE_ALLOCATOR allocator (n_chunks, CHUNK_SIZE, MAGAZINE_SIZE);
+  ACE_Barrier barrier (THREADS);
+
+  Cross_Free_Args args;
+  args.allocator_ = &allocator;
+  args.barrier_ = &barrier;
+  args.next_id_ = 0;
+  args.errors_ = 0;
+
+  if (ACE_Thread_Manager::instance ()->spawn_n (THREADS,
+                                                cross_free,
+                                                &args) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT (" (%t) %p\n"),
+                       ACE_TEXT ("spawn_n")),
+                      -1);
+
+  ACE_Thread_Manager::instance ()->wait ();
+
+  if (args.errors_.value () != 0)
+    return -1;
+
+  // The exiting threads returned their magazines.
+  if (allocator.pool_depth () != n_chunks)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT (" (%t) pool depth is %B after the ")
+                       ACE_TEXT ("threads exited, expected %B\n"),
+                       allocator.pool_depth (),
+                       n_chunks),
+                      -1);
+
+  return 0;
+}
+
+static const ACE_UINT32 LOOPS = 1000000;
+
+template <class ALLOCATOR>
+static ACE_THR_FUNC_RETURN
+speed_worker (void *arg)
+{
+  ALLOCATOR *allocator = static_cast<ALLOCATOR *> (arg);
+  void *ptrs[4];
+
+  for (ACE_UINT32 i = 0; i < LOOPS; ++i)
+    {
+      for (size_t j = 0; j < 4; ++j)
+        ptrs[j] = allocator->malloc (CHUNK_SIZE);
+      for (size_t j = 0; j < 4; ++j)
+        allocator->free (ptrs[j]);
+    }
+
+  return 0;
+}
+
+template <class ALLOCATOR>
+static void
+speed_test (ALLOCATOR &allocator, const ACE_TCHAR *name)
+{
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  ACE_Thread_Manager::instance ()->spawn_n (THREADS,
+                                            speed_worker<ALLOCATOR>,
+                                            &allocator);
+  ACE_Thread_Manager::instance ()->wait ();
+
+  timer.stop ();
+
+  ACE_Time_Value tc;
+  timer.elapsed_time (tc);
+  double const tt = tc.sec () + tc.usec () * 1.0e-6;
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT (" (%t) %s: %d threads, %.6g [us] ")
+              ACE_TEXT ("per malloc/free\n"),
+              name,
+              static_cast<int> (THREADS),
+              tt * 1.0e6 / (LOOPS * 4.0)));
+}
+
+static void
+speed_tests (void)
+{
+  const size_t n_chunks = THREADS * (4 + 2 * MAGAZINE_SIZE);
+
+  ACE_Dynamic_Cached_Allocator<ACE_SYNCH_MUTEX> cached (n_chunks,
+                                                        CHUNK_SIZE);
+  speed_test (cached, ACE_TEXT ("ACE_Dynamic_Cached_Allocator"));
+
+  MAGAZINE_ALLOCATOR magazine (n_chunks, CHUNK_SIZE, MAGAZINE_SIZE);
+  speed_test (magazine, ACE_TEXT ("ACE_Dynamic_Magazine_Allocator"));
+}
+
+#endif /* ACE_HAS_THREADS */
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Magazine_Allocator_Test"));
+
+  int status = 0;
+
+  if (test_pool () == -1)
+    status = 1;
+
+  if (test_no_magazine () == -1)
+    status = 1;
+
+#if defined (ACE_HAS_THREADS)
+  if (test_cross_free () == -1)
+    status = 1;
+
+  speed_tests ();
+#endif /* ACE_HAS_THREADS */
+
+  ACE_END_TEST;
+  return status;
+}
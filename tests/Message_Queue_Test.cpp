@@ -15,6 +15,9 @@
  *       ACE_Message_Queue_Vx, which wraps VxWorks message queues
  *    3) a test/usage example of ACE_Message_Queue_Vx
  *    4) a test of the message counting in a message queue under load.
+ *    5) a test of the batch enqueue and dequeue methods of
+ *       ACE_Message_Queue, ACE_Message_Queue_Ex, ACE_Task and
+ *       ACE_Stream.
  *
  *  @author Irfan Pyarali <irfan@cs.wustl.edu>
  *  @author David L. Levine <levine@cs.wustl.edu>
@@ -34,6 +37,7 @@
 #include "ace/Null_Condition.h"
 #include "ace/High_Res_Timer.h"
 #include "ace/Task.h"
+#include "ace/Stream.h"
 #include "ace/OS_NS_stdio.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_sys_time.h"
@@ -502,6 +506,170 @@ chained_block_test (void)
   return status;
 }
 
+// Move blocks in batches through the queues, a task and a stream,
+// checking counts and order.
+
+static int
+batch_test (void)
+{
+  int status = 0;
+  const int num_blks = 10;
+  ACE_Message_Block b[num_blks];
+  ACE_Message_Block *in[num_blks];
+  ACE_Message_Block *out[num_blks];
+  int i;
+
+  for (i = 0; i < num_blks; ++i)
+    {
+      b[i].init (10);
+      b[i].wr_ptr (10);
+      in[i] = &b[i];
+    }
+
+  SYNCH_QUEUE q;
+  int num = q.enqueue_batch (in, 6);
+  if (num != 6 || q.message_count () != 6 || q.message_bytes () != 60)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("enqueue_batch of 6 returned %d; queue has ")
+                  ACE_TEXT ("%B msgs, %B bytes\n"),
+                  num,
+                  q.message_count (),
+                  q.message_bytes ()));
+      status = -1;
+    }
+  q.enqueue_batch (in + 6, num_blks - 6);
+
+  // Asking for more than the queue holds returns what's there.
+  num = q.dequeue_batch (out, 4);
+  int const rest = q.dequeue_batch (out + 4, num_blks);
+  if (num != 4 || rest != num_blks - 4 || !q.is_empty ())
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("dequeue_batch returned %d and %d\n"),
+                  num,
+                  rest));
+      status = -1;
+    }
+  for (i = 0; i < num_blks && status == 0; ++i)
+    if (out[i] != &b[i] || out[i]->next () != 0 || out[i]->prev () != 0)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("Batch dequeue, block %d out of order\n"),
+                    i));
+        status = -1;
+      }
+
+  ACE_Time_Value nowait (ACE_OS::gettimeofday ());
+  if (q.dequeue_batch (out, num_blks, &nowait) != -1 || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%p\n"),
+                  ACE_TEXT ("Batch dequeue timeout should be EWOULDBLOCK, got")));
+      status = -1;
+    }
+
+  // The typed queue.
+  ACE_Message_Queue_Ex<int, ACE_MT_SYNCH> exq;
+  int values[num_blks];
+  int *value_in[num_blks];
+  int *value_out[num_blks];
+  for (i = 0; i < num_blks; ++i)
+    {
+      values[i] = i;
+      value_in[i] = &values[i];
+    }
+  num = exq.enqueue_batch (value_in, num_blks);
+  if (num != num_blks
+      || exq.dequeue_batch (value_out, num_blks) != num_blks
+      || !exq.is_empty ())
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("ACE_Message_Queue_Ex batch failed\n")));
+      status = -1;
+    }
+  for (i = 0; i < num_blks && status == 0; ++i)
+    if (value_out[i] != &values[i])
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("Batch dequeue, item %d out of order\n"),
+                    i));
+        status = -1;
+      }
+
+  // A batch stops at the high water mark; the blocks that fit are
+  // enqueued and counted when the queue stays full until the timeout.
+  SYNCH_QUEUE small (30, 30);
+  nowait = ACE_OS::gettimeofday ();
+  num = small.enqueue_batch (in, num_blks, &nowait);
+  if (num != 3 || small.message_count () != 3 || small.message_bytes () != 30)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("enqueue_batch into a full queue returned %d; ")
+                  ACE_TEXT ("queue has %B msgs, %B bytes\n"),
+                  num,
+                  small.message_count (),
+                  small.message_bytes ()));
+      status = -1;
+    }
+  nowait = ACE_OS::gettimeofday ();
+  if (small.enqueue_batch (in + 3, num_blks - 3, &nowait) != -1
+      || errno != EWOULDBLOCK)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%p\n"),
+                  ACE_TEXT ("Batch enqueue into a full queue should be EWOULDBLOCK, got")));
+      status = -1;
+    }
+  small.dequeue_batch (out, num_blks);
+
+  ACE_Message_Queue_Ex<int, ACE_MT_SYNCH> small_exq (3 * sizeof (int),
+                                                     3 * sizeof (int));
+  nowait = ACE_OS::gettimeofday ();
+  num = small_exq.enqueue_batch (value_in, num_blks, &nowait);
+  if (num != 3 || small_exq.message_count () != 3
+      || small_exq.dequeue_batch (value_out, num_blks) != 3
+      || value_out[2] != &values[2])
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("ACE_Message_Queue_Ex batch into a full queue ")
+                  ACE_TEXT ("returned %d\n"),
+                  num));
+      status = -1;
+    }
+
+  // A stream head reader queues a batch with a single putq_n(), and
+  // ACE_Stream::get_n() hands it back.
+  ACE_Stream<ACE_MT_SYNCH> stream;
+  num = stream.head ()->reader ()->put_n (in, num_blks);
+  int const got = stream.get_n (out, num_blks, &nowait);
+  if (num != num_blks || got != num_blks || out[0] != &b[0]
+      || out[num_blks - 1] != &b[num_blks - 1])
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Stream batch put %d, got %d\n"),
+                  num,
+                  got));
+      status = -1;
+    }
+
+  // Sent down the stream, the tail releases them.
+  ACE_Message_Block *down[3];
+  for (i = 0; i < 3; ++i)
+    ACE_NEW_RETURN (down[i], ACE_Message_Block (10), -1);
+  num = stream.put_n (down, 3);
+  if (num != 3)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("Stream put_n returned %d\n"),
+                  num));
+      status = -1;
+    }
+
+  if (status == 0)
+    ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("Batch test OK\n")));
+  return status;
+}
+
 static int
 single_thread_performance_test (int queue_type = 0)
 {
@@ -933,6 +1101,9 @@ run_main (int argc, ACE_TCHAR *argv[])
   if (status == 0)
     status = chained_block_test ();
 
+  if (status == 0)
+    status = batch_test ();
+
   if (status == 0)
     status = single_thread_performance_test ();
 
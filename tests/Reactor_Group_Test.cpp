@@ -0,0 +1,247 @@
+//=============================================================================
+/**
+ *  @file    Reactor_Group_Test.cpp
+ *
+ *  $Id$
+ *
+ *  This test checks ACE_Reactor_Group and ACE_Sharded_Acceptor:
+ *  connections are accepted by the shards of the group, each one is
+ *  dispatched by the thread of the shard which accepted it, and a
+ *  handler handed off to another shard is dispatched by the thread of
+ *  that shard afterwards.
+ */
+//=============================================================================
+
+#include "test_config.h"
+
+#if defined (ACE_HAS_DEV_POLL) || defined (ACE_HAS_EVENT_POLL)
+
+#include "ace/Reactor_Group.h"
+#include "ace/Sharded_Acceptor.h"
+#include "ace/Svc_Handler.h"
+#include "ace/SOCK_Acceptor.h"
+#include "ace/SOCK_Connector.h"
+#include "ace/SOCK_Stream.h"
+#include "ace/Atomic_Op.h"
+#include "ace/OS_NS_unistd.h"
+
+static const size_t SHARDS = 4;
+static const size_t CONNECTIONS = 16;
+
+static ACE_Reactor_Group *group = 0;
+
+// Number of messages dispatched by the wrong thread.
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> wrong_thread (0);
+
+// Number of handlers dispatched by another shard after a handoff.
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> moved (0);
+
+// Number of handlers closed.
+static ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> closed (0);
+
+class Echo_Handler : public ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH>
+{
+public:
+  Echo_Handler (void);
+
+  virtual int handle_input (ACE_HANDLE);
+  virtual int handle_close (ACE_HANDLE, ACE_Reactor_Mask);
+
+private:
+  /// Shard which accepted the connection, -1 until the first message.
+  ssize_t first_shard_;
+
+  /// Number of messages received.
+  int messages_;
+};
+
+Echo_Handler::Echo_Handler (void)
+  : first_shard_ (-1),
+    messages_ (0)
+{
+}
+
+int
+Echo_Handler::handle_input (ACE_HANDLE)
+{
+  char buf[64];
+  ssize_t const n = this->peer ().recv (buf, sizeof buf);
+  if (n <= 0)
+    return n == -1 && errno == EWOULDBLOCK ? 0 : -1;
+
+  ssize_t const shard = group->current_shard ();
+  if (shard == -1 || shard != group->shard (this->reactor ()))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%t) handle %d dispatched by shard %d, ")
+                  ACE_TEXT ("registered with shard %d\n"),
+                  this->get_handle (),
+                  static_cast<int> (shard),
+                  static_cast<int> (group->shard (this->reactor ()))));
+      ++wrong_thread;
+    }
+
+  if (++this->messages_ == 1)
+    {
+      // Move to the next shard; the move takes place once this upcall
+      // returns.
+      this->first_shard_ = shard;
+      if (group->handoff (this, (shard + 1) % group->size ()) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("(%t) %p\n"),
+                           ACE_TEXT ("handoff")),
+                          -1);
+    }
+  else if (this->messages_ == 2)
+    {
+      if (shard == (this->first_shard_ + 1)
+                   % static_cast<ssize_t> (group->size ()))
+        ++moved;
+      else
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("(%t) handle %d still on shard %d after ")
+                    ACE_TEXT ("handoff from shard %d\n"),
+                    this->get_handle (),
+                    static_cast<int> (shard),
+                    static_cast<int> (this->first_shard_)));
+    }
+
+  return this->peer ().send_n (buf, n) == n ? 0 : -1;
+}
+
+int
+Echo_Handler::handle_close (ACE_HANDLE handle, ACE_Reactor_Mask mask)
+{
+  ++closed;
+  return ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH>::handle_close (handle,
+                                                                       mask);
+}
+
+typedef ACE_Sharded_Acceptor<Echo_Handler, ACE_SOCK_ACCEPTOR> ACCEPTOR;
+
+static int
+run_client (const ACE_INET_Addr &server_addr)
+{
+  ACE_SOCK_Stream streams[CONNECTIONS];
+  ACE_SOCK_Connector connector;
+
+  for (size_t i = 0; i < CONNECTIONS; ++i)
+    if (connector.connect (streams[i], server_addr) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("(%t) %p\n"),
+                         ACE_TEXT ("connect")),
+                        -1);
+
+  // Two messages per connection; the first one triggers the handoff.
+  for (int round = 0; round < 2; ++round)
+    for (size_t i = 0; i < CONNECTIONS; ++i)
+      {
+        char const msg[] = "ping";
+        char reply[sizeof msg];
+        ACE_Time_Value timeout (5);
+        if (streams[i].send_n (msg, sizeof msg) != sizeof msg
+            || streams[i].recv_n (reply,
+                                  sizeof reply,
+                                  &timeout) != sizeof reply)
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("(%t) %p\n"),
+                             ACE_TEXT ("echo")),
+                            -1);
+      }
+
+  for (size_t i = 0; i < CONNECTIONS; ++i)
+    streams[i].close ();
+
+  return 0;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Reactor_Group_Test"));
+
+  int status = 0;
+
+  ACE_Reactor_Group reactor_group;
+  group = &reactor_group;
+
+  if (reactor_group.open (SHARDS) == -1 || reactor_group.start () == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) %p\n"),
+                       ACE_TEXT ("Reactor_Group")),
+                      1);
+
+  ACCEPTOR acceptor;
+  ACE_INET_Addr listen_addr (static_cast<u_short> (0), ACE_LOCALHOST);
+  ACE_INET_Addr server_addr;
+
+  if (acceptor.open (listen_addr, reactor_group, ACE_NONBLOCK) == -1)
+    {
+      int const error = errno;
+      if (error == ENOTSUP)
+        ACE_DEBUG ((LM_INFO,
+                    ACE_TEXT ("SO_REUSEPORT is not supported\n")));
+      else
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("(%t) %p\n"),
+                    ACE_TEXT ("Sharded_Acceptor::open")));
+      reactor_group.close ();
+      ACE_END_TEST;
+      return error == ENOTSUP ? 0 : 1;
+    }
+
+  if (acceptor.size () != SHARDS
+      || acceptor.get_local_addr (server_addr) == -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%t) unexpected acceptor state\n")));
+      status = 1;
+    }
+  else if (run_client (server_addr) == -1)
+    status = 1;
+
+  // Wait for the handlers to see the connections closed.
+  for (int i = 0; i < 50 && closed.value () < long (CONNECTIONS); ++i)
+    ACE_OS::sleep (ACE_Time_Value (0, 100000));
+
+  reactor_group.stop ();
+  acceptor.close ();
+  reactor_group.close ();
+
+  if (wrong_thread.value () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d messages dispatched by the wrong thread\n"),
+                  static_cast<int> (wrong_thread.value ())));
+      status = 1;
+    }
+
+  if (moved.value () != long (CONNECTIONS)
+      || closed.value () != long (CONNECTIONS))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d handlers moved, %d closed; expected %d\n"),
+                  static_cast<int> (moved.value ()),
+                  static_cast<int> (closed.value ()),
+                  static_cast<int> (CONNECTIONS)));
+      status = 1;
+    }
+
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Reactor_Group_Test"));
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("ACE_Reactor_Group is not supported ")
+              ACE_TEXT ("on this platform\n")));
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* ACE_HAS_DEV_POLL || ACE_HAS_EVENT_POLL */
@@ -0,0 +1,375 @@
+//=============================================================================
+/**
+ *  @file    SOCK_Dgram_Batch_Test.cpp
+ *
+ *  $Id$
+ *
+ *  This test checks ACE_SOCK_Dgram::send_batch() and recv_batch()
+ *  over the loopback interface: datagrams of several sizes sent in a
+ *  batch must arrive whole and in order, with their source address; a
+ *  datagram larger than its block must be reported as truncated where
+ *  recvmmsg() is used; a timed out receive must fail with ETIME; and,
+ *  where the kernel supports UDP segmentation offload, a block sent
+ *  with set_gso() must arrive as datagrams of the segment size.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/SOCK_Dgram.h"
+#include "ace/INET_Addr.h"
+#include "ace/Message_Block.h"
+#include "ace/Time_Value.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_errno.h"
+
+static const size_t COUNT = 40;
+static const size_t BLOCK_SIZE = 2048;
+
+// Open <sender> and <receiver> on the loopback interface, and set
+// <to> to the address of <receiver>.
+static int
+open_pair (ACE_SOCK_Dgram &sender,
+           ACE_SOCK_Dgram &receiver,
+           ACE_INET_Addr &to)
+{
+  ACE_INET_Addr local (static_cast<u_short> (0), ACE_LOCALHOST);
+  if (receiver.open (local) == -1 || sender.open (local) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), -1);
+
+  if (receiver.get_local_addr (to) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%p\n"),
+                       ACE_TEXT ("get_local_addr")),
+                      -1);
+  to.set (to.get_port_number (), ACE_LOCALHOST);
+  return 0;
+}
+
+// Receive <count> datagrams into <blocks>, with as many calls as
+// needed.  Returns the number received.
+static size_t
+recv_all (ACE_SOCK_Dgram &receiver,
+          ACE_Message_Block *blocks[],
+          ACE_INET_Addr addrs[],
+          ACE_SOCK_Dgram::Batch_Info info[],
+          size_t count)
+{
+  size_t received = 0;
+  int calls = 0;
+  while (received < count)
+    {
+      ACE_Time_Value timeout (2);
+      ssize_t const n = receiver.recv_batch (blocks + received,
+                                             addrs + received,
+                                             info + received,
+                                             count - received,
+                                             0,
+                                             &timeout);
+      if (n <= 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("%p after %B datagrams\n"),
+                      ACE_TEXT ("recv_batch"),
+                      received));
+          break;
+        }
+      received += static_cast<size_t> (n);
+      ++calls;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%B datagrams received with %d calls\n"),
+              received,
+              calls));
+  return received;
+}
+
+static int
+test_batch (void)
+{
+  ACE_SOCK_Dgram sender;
+  ACE_SOCK_Dgram receiver;
+  ACE_INET_Addr to;
+  if (open_pair (sender, receiver, to) == -1)
+    return -1;
+
+  ACE_INET_Addr from;
+  sender.get_local_addr (from);
+
+  int status = 0;
+  ACE_Message_Block *out[COUNT];
+  ACE_Message_Block *in[COUNT];
+  ACE_INET_Addr tos[COUNT];
+  ACE_INET_Addr addrs[COUNT];
+  ACE_SOCK_Dgram::Batch_Info info[COUNT];
+
+  for (size_t i = 0; i < COUNT; ++i)
+    {
+      // Datagram i holds i + 1 bytes of value i.
+      ACE_NEW_RETURN (out[i], ACE_Message_Block (BLOCK_SIZE), -1);
+      ACE_NEW_RETURN (in[i], ACE_Message_Block (BLOCK_SIZE), -1);
+      ACE_OS::memset (out[i]->wr_ptr (), static_cast<int> (i), i + 1);
+      out[i]->wr_ptr (i + 1);
+      tos[i] = to;
+    }
+
+  ssize_t const sent = sender.send_batch (out, tos, COUNT);
+  if (sent != static_cast<ssize_t> (COUNT))
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("send_batch sent %b datagrams, expected %B: %p\n"),
+                  sent,
+                  COUNT,
+                  ACE_TEXT ("send_batch")));
+      status = -1;
+    }
+
+  size_t const received = recv_all (receiver, in, addrs, info, COUNT);
+  if (received != COUNT)
+    status = -1;
+
+  for (size_t i = 0; status == 0 && i < received; ++i)
+    {
+      char expected[COUNT];
+      ACE_OS::memset (expected, static_cast<int> (i), i + 1);
+
+      if (in[i]->length () != i + 1
+          || ACE_OS::memcmp (in[i]->rd_ptr (), expected, i + 1) != 0
+          || addrs[i].get_port_number () != from.get_port_number ()
+          || info[i].flags_ != 0
+          || info[i].segment_size_ != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("datagram %B: %B bytes from port %d, ")
+                      ACE_TEXT ("flags %d\n"),
+                      i,
+                      in[i]->length (),
+                      addrs[i].get_port_number (),
+                      info[i].flags_));
+          status = -1;
+        }
+
+      // The blocks sent are left alone.
+      if (out[i]->length () != i + 1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("block %B sent was changed\n"),
+                      i));
+          status = -1;
+        }
+    }
+
+  // All to the same address, without an array of them.
+  for (size_t i = 0; i < COUNT; ++i)
+    in[i]->reset ();
+  if (sender.send_batch (out, COUNT, to) != static_cast<ssize_t> (COUNT)
+      || recv_all (receiver, in, 0, 0, COUNT) != COUNT)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("batch to a single address failed\n")));
+      status = -1;
+    }
+
+  // Nothing left: a timed receive fails.
+  ACE_Time_Value timeout (0, 100000);
+  in[0]->reset ();
+  if (receiver.recv_batch (in, addrs, info, COUNT, 0, &timeout) != -1
+      || errno != ETIME)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("recv_batch with nothing to receive didn't ")
+                  ACE_TEXT ("time out\n")));
+      status = -1;
+    }
+
+  for (size_t i = 0; i < COUNT; ++i)
+    {
+      out[i]->release ();
+      in[i]->release ();
+    }
+
+  sender.close ();
+  receiver.close ();
+  return status;
+}
+
+static int
+test_truncation (void)
+{
+  ACE_SOCK_Dgram sender;
+  ACE_SOCK_Dgram receiver;
+  ACE_INET_Addr to;
+  if (open_pair (sender, receiver, to) == -1)
+    return -1;
+
+  int status = 0;
+  ACE_Message_Block big (200);
+  ACE_OS::memset (big.wr_ptr (), 'x', big.space ());
+  big.wr_ptr (big.space ());
+
+  ACE_Message_Block small (50);
+  ACE_Message_Block *out[] = { &big };
+  ACE_Message_Block *in[] = { &small };
+  ACE_INET_Addr addr;
+  ACE_SOCK_Dgram::Batch_Info info;
+
+  if (sender.send_batch (out, 1, to) != 1
+      || recv_all (receiver, in, &addr, &info, 1) != 1
+      || small.length () != 50)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("truncated datagram of %B bytes\n"),
+                  small.length ()));
+      status = -1;
+    }
+#if defined (ACE_HAS_RECVMMSG) && defined (MSG_TRUNC)
+  else if ((info.flags_ & MSG_TRUNC) == 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("truncated datagram not reported, flags %d\n"),
+                  info.flags_));
+      status = -1;
+    }
+#endif /* ACE_HAS_RECVMMSG && MSG_TRUNC */
+
+  sender.close ();
+  receiver.close ();
+  return status;
+}
+
+static int
+test_offload (void)
+{
+  static const u_short SEGMENT = 100;
+  static const size_t SEGMENTS = 10;
+
+  ACE_SOCK_Dgram sender;
+  ACE_SOCK_Dgram receiver;
+  ACE_INET_Addr to;
+  if (open_pair (sender, receiver, to) == -1)
+    return -1;
+
+  if (sender.set_gso (SEGMENT) == -1)
+    {
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%p, skipping the offload test\n"),
+                  ACE_TEXT ("set_gso")));
+      return 0;
+    }
+
+  // With GRO the segments may come back coalesced, or not.
+  bool const gro = receiver.set_gro (true) == 0;
+
+  int status = 0;
+  ACE_Message_Block block (SEGMENT * SEGMENTS);
+  for (size_t i = 0; i < SEGMENTS; ++i)
+    {
+      ACE_OS::memset (block.wr_ptr (), static_cast<int> (i), SEGMENT);
+      block.wr_ptr (SEGMENT);
+    }
+
+  ACE_Message_Block *out[] = { &block };
+  ssize_t const sent = sender.send_batch (out, 1, to);
+  if (sent != 1)
+    {
+      // Some kernels refuse segmentation on loopback.
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%p, skipping the offload test\n"),
+                  ACE_TEXT ("send_batch with GSO")));
+      return 0;
+    }
+
+  ACE_Message_Block *in[SEGMENTS];
+  ACE_INET_Addr addrs[SEGMENTS];
+  ACE_SOCK_Dgram::Batch_Info info[SEGMENTS];
+  for (size_t i = 0; i < SEGMENTS; ++i)
+    ACE_NEW_RETURN (in[i], ACE_Message_Block (BLOCK_SIZE), -1);
+
+  // Gather the bytes of all the datagrams received, each of which is
+  // either a segment or several coalesced ones.
+  size_t bytes = 0;
+  size_t datagrams = 0;
+  while (bytes < SEGMENT * SEGMENTS && datagrams < SEGMENTS)
+    {
+      ACE_Time_Value timeout (2);
+      ssize_t const n = receiver.recv_batch (in + datagrams,
+                                             addrs + datagrams,
+                                             info + datagrams,
+                                             SEGMENTS - datagrams,
+                                             0,
+                                             &timeout);
+      if (n <= 0)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("recv_batch")));
+          status = -1;
+          break;
+        }
+
+      for (ssize_t i = 0; i < n; ++i, ++datagrams)
+        {
+          size_t const length = in[datagrams]->length ();
+          size_t const segment = info[datagrams].segment_size_;
+          if ((segment == 0 && length != SEGMENT)
+              || (segment != 0 && (segment != SEGMENT || !gro)))
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("datagram of %B bytes, segment %B\n"),
+                          length,
+                          segment));
+              status = -1;
+            }
+
+          // Segment k is filled with k.
+          for (size_t k = 0; k < length; ++k)
+            if (in[datagrams]->rd_ptr ()[k]
+                != static_cast<char> ((bytes + k) / SEGMENT))
+              {
+                ACE_ERROR ((LM_ERROR,
+                            ACE_TEXT ("byte %B of the block is wrong\n"),
+                            bytes + k));
+                status = -1;
+                break;
+              }
+          bytes += length;
+        }
+    }
+
+  if (bytes != SEGMENT * SEGMENTS)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%B bytes received, expected %B\n"),
+                  bytes,
+                  SEGMENT * SEGMENTS));
+      status = -1;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%B bytes sent with GSO came in %B datagrams%s\n"),
+              bytes,
+              datagrams,
+              gro ? ACE_TEXT (" with GRO") : ACE_TEXT ("")));
+
+  for (size_t i = 0; i < SEGMENTS; ++i)
+    in[i]->release ();
+
+  sender.close ();
+  receiver.close ();
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("SOCK_Dgram_Batch_Test"));
+
+  int status = 0;
+  if (test_batch () != 0)
+    status = 1;
+  if (test_truncation () != 0)
+    status = 1;
+  if (test_offload () != 0)
+    status = 1;
+
+  ACE_END_TEST;
+  return status;
+}
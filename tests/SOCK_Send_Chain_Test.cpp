@@ -0,0 +1,482 @@
+//=============================================================================
+/**
+ *  @file    SOCK_Send_Chain_Test.cpp
+ *
+ *  $Id$
+ *
+ *  This test checks ACE::send_chain() over a TCP connection: a chain
+ *  of message blocks is sent without blocking to a peer which doesn't
+ *  read, so that the writes are partial, and resumed until everything
+ *  is through; the data sent must be consumed from the blocks.  It
+ *  then checks that an ACE_Buffered_Svc_Handler registered with a
+ *  reactor sends what a flush couldn't from handle_output(), and,
+ *  where supported, that MSG_ZEROCOPY writes get their completions.
+ */
+//=============================================================================
+
+#include "test_config.h"
+#include "ace/ACE.h"
+#include "ace/SOCK_Acceptor.h"
+#include "ace/SOCK_Connector.h"
+#include "ace/INET_Addr.h"
+#include "ace/Message_Block.h"
+#include "ace/Svc_Handler.h"
+#include "ace/Select_Reactor.h"
+#include "ace/Reactor.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Null_Condition.h"
+#include "ace/Null_Mutex.h"
+#include "ace/OS_NS_sys_socket.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_unistd.h"
+
+// Number of messages sent, each a chain of three blocks.
+static const size_t MESSAGES = 64;
+
+// The blocks of message <i> have <i> * BLOCK_UNIT + <j> bytes.
+static const size_t BLOCK_UNIT = 1024;
+
+// Small buffers, so that writes are partial.
+static const int BUFFER_SIZE = 16 * 1024;
+
+// Connect <sender> to <receiver> over the loopback interface, with
+// small buffers unless <small_buffers> is false, and make <sender>
+// non-blocking.
+static int
+connect_pair (ACE_SOCK_Stream &sender,
+              ACE_SOCK_Stream &receiver,
+              bool small_buffers = true)
+{
+  ACE_SOCK_Acceptor acceptor;
+  ACE_INET_Addr addr (static_cast<u_short> (0),
+                      ACE_LOCALHOST);
+
+  if (acceptor.open (addr, 1) == -1
+      || acceptor.get_local_addr (addr) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) %p\n"),
+                       ACE_TEXT ("acceptor open")),
+                      -1);
+
+  ACE_SOCK_Connector connector;
+  if (connector.connect (sender, addr) == -1
+      || acceptor.accept (receiver) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) %p\n"),
+                       ACE_TEXT ("connect")),
+                      -1);
+
+  if (small_buffers)
+    {
+      int size = BUFFER_SIZE;
+      sender.set_option (SOL_SOCKET, SO_SNDBUF, &size, sizeof size);
+      receiver.set_option (SOL_SOCKET, SO_RCVBUF, &size, sizeof size);
+    }
+
+  return sender.enable (ACE_NONBLOCK);
+}
+
+// Build the messages, linked through <next>, each byte giving its
+// position in the stream.
+static ACE_Message_Block *
+make_messages (size_t &total)
+{
+  ACE_Message_Block *head = 0;
+  ACE_Message_Block *tail = 0;
+  total = 0;
+
+  for (size_t i = 0; i < MESSAGES; ++i)
+    {
+      ACE_Message_Block *message = 0;
+      for (size_t j = 3; j-- > 0; )
+        {
+          // An empty block in the middle of every other chain.
+          size_t const length = (i % 2 == 0 && j == 1)
+            ? 0
+            : (i + 1) * BLOCK_UNIT + j;
+          ACE_Message_Block *mb = 0;
+          ACE_NEW_RETURN (mb, ACE_Message_Block (length), 0);
+          mb->cont (message);
+          message = mb;
+        }
+
+      for (ACE_Message_Block *mb = message; mb != 0; mb = mb->cont ())
+        for (char *p = mb->wr_ptr (); p != mb->end (); ++p)
+          {
+            *p = static_cast<char> (total++ % 251);
+            mb->wr_ptr (1);
+          }
+
+      if (tail == 0)
+        head = message;
+      else
+        tail->next (message);
+      tail = message;
+    }
+
+  return head;
+}
+
+static void
+release_messages (ACE_Message_Block *messages)
+{
+  while (messages != 0)
+    {
+      ACE_Message_Block *next = messages->next ();
+      messages->release ();
+      messages = next;
+    }
+}
+
+// Read what's available from <receiver>, checking the data.
+static int
+drain (ACE_SOCK_Stream &receiver, size_t &received)
+{
+  char buf[BUFFER_SIZE];
+  ACE_Time_Value const nowait (ACE_Time_Value::zero);
+
+  for (;;)
+    {
+      ssize_t const n = receiver.recv (buf, sizeof buf, &nowait);
+      if (n <= 0)
+        return 0;
+
+      for (ssize_t i = 0; i < n; ++i)
+        if (buf[i] != static_cast<char> (received++ % 251))
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("(%t) byte %B is wrong\n"),
+                             received - 1),
+                            -1);
+    }
+}
+
+static int
+test_partial_writes (void)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("(%t) Partial writes test\n")));
+
+  ACE_SOCK_Stream sender;
+  ACE_SOCK_Stream receiver;
+  if (connect_pair (sender, receiver) == -1)
+    return -1;
+
+  size_t total = 0;
+  ACE_Message_Block *messages = make_messages (total);
+  if (messages == 0)
+    return -1;
+
+  int status = 0;
+  size_t sent = 0;
+  size_t received = 0;
+  size_t partial = 0;
+
+  while (status == 0 && sent < total)
+    {
+      size_t bytes_transferred = 0;
+      ssize_t const result = sender.send_chain (messages,
+                                                &ACE_Time_Value::zero,
+                                                &bytes_transferred);
+      sent += bytes_transferred;
+
+      if (result == -1)
+        {
+          if (errno != ETIME)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("(%t) %p\n"),
+                          ACE_TEXT ("send_chain")));
+              status = -1;
+            }
+          ++partial;
+        }
+      else if (static_cast<size_t> (result) != bytes_transferred)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) send_chain returned %b, sent %B\n"),
+                      result,
+                      bytes_transferred));
+          status = -1;
+        }
+
+      // What's left in the blocks is what wasn't sent.
+      size_t left = 0;
+      for (ACE_Message_Block *m = messages; m != 0; m = m->next ())
+        left += m->total_length ();
+      if (left != total - sent)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) %B bytes left in the blocks, ")
+                      ACE_TEXT ("expected %B\n"),
+                      left,
+                      total - sent));
+          status = -1;
+        }
+
+      if (drain (receiver, received) == -1)
+        status = -1;
+    }
+
+  while (status == 0 && received < sent)
+    {
+      ACE_OS::sleep (ACE_Time_Value (0, 1000));
+      if (drain (receiver, received) == -1)
+        status = -1;
+    }
+
+  if (status == 0 && partial == 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%t) no write was partial\n")));
+      status = -1;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("(%t) sent %B bytes with %B partial writes\n"),
+              sent,
+              partial));
+
+  release_messages (messages);
+  sender.close ();
+  receiver.close ();
+  return status;
+}
+
+typedef ACE_Buffered_Svc_Handler<ACE_SOCK_Stream, ACE_NULL_SYNCH> SVC_HANDLER;
+
+static int
+test_buffered_handler (bool zerocopy)
+{
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("(%t) Buffered handler test%s\n"),
+              zerocopy ? ACE_TEXT (" with MSG_ZEROCOPY") : ACE_TEXT ("")));
+
+  ACE_Select_Reactor select_reactor;
+  ACE_Reactor reactor (&select_reactor);
+
+  // Flush every few messages.
+  SVC_HANDLER handler (0, 0, &reactor, 4 * MESSAGES * BLOCK_UNIT);
+  handler.msg_queue ()->high_water_mark (16 * MESSAGES * BLOCK_UNIT);
+
+  // Pages given to MSG_ZEROCOPY writes are charged in full to the
+  // receive buffer of a local peer: small ones would drop them.
+  ACE_SOCK_Stream receiver;
+  if (connect_pair (handler.peer (), receiver, !zerocopy) == -1)
+    return -1;
+
+  if (zerocopy && handler.zerocopy_threshold (BLOCK_UNIT) == -1)
+    {
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("(%t) MSG_ZEROCOPY isn't supported\n")));
+      return 0;
+    }
+
+  if (reactor.register_handler (&handler,
+                                ACE_Event_Handler::NULL_MASK) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("(%t) %p\n"),
+                       ACE_TEXT ("register_handler")),
+                      -1);
+
+  size_t total = 0;
+  ACE_Message_Block *messages = make_messages (total);
+  if (messages == 0)
+    return -1;
+
+  int status = 0;
+  size_t received = 0;
+
+  while (messages != 0)
+    {
+      ACE_Message_Block *message = messages;
+      messages = message->next ();
+      message->next (0);
+
+      if (handler.put (message) == -1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) %p\n"),
+                      ACE_TEXT ("put")));
+          status = -1;
+          break;
+        }
+    }
+
+  if (status == 0 && handler.flush () == -1)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%t) %p\n"),
+                  ACE_TEXT ("flush")));
+      status = -1;
+    }
+
+  // The reactor sends the rest as the receiver reads.
+  for (int idle = 0; status == 0 && received < total && idle < 1000; )
+    {
+      size_t const before = received;
+      if (drain (receiver, received) == -1)
+        status = -1;
+      ACE_Time_Value tv (0, 1000);
+      reactor.handle_events (tv);
+      idle = received == before ? idle + 1 : 0;
+    }
+
+  if (status == 0 && received != total)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%t) received %B bytes, expected %B\n"),
+                  received,
+                  total));
+      status = -1;
+    }
+
+  if (status == 0 && handler.msg_queue ()->message_count () != 0)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%t) %B messages left in the queue\n"),
+                  handler.msg_queue ()->message_count ()));
+      status = -1;
+    }
+
+  release_messages (messages);
+  reactor.remove_handler (&handler,
+                          ACE_Event_Handler::ALL_EVENTS_MASK
+                          | ACE_Event_Handler::DONT_CALL);
+  receiver.close ();
+  return status;
+}
+
+static int
+test_zerocopy_completions (void)
+{
+  ACE_DEBUG ((LM_DEBUG, ACE_TEXT ("(%t) MSG_ZEROCOPY completions test\n")));
+
+#if defined (MSG_ZEROCOPY)
+  ACE_SOCK_Stream sender;
+  ACE_SOCK_Stream receiver;
+  if (connect_pair (sender, receiver, false) == -1)
+    return -1;
+
+  if (ACE::enable_zerocopy (sender.get_handle ()) == -1)
+    {
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("(%t) MSG_ZEROCOPY isn't supported\n")));
+      return 0;
+    }
+
+  size_t total = 0;
+  ACE_Message_Block *messages = make_messages (total);
+  if (messages == 0)
+    return -1;
+
+  int status = 0;
+  size_t sent = 0;
+  size_t received = 0;
+  size_t writes = 0;
+
+  while (status == 0 && sent < total)
+    {
+      size_t bytes_transferred = 0;
+      size_t n = 0;
+      if (sender.send_chain (messages,
+                             &ACE_Time_Value::zero,
+                             &bytes_transferred,
+                             MSG_ZEROCOPY,
+                             &n) == -1
+          && errno != ETIME)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) %p\n"),
+                      ACE_TEXT ("send_chain")));
+          status = -1;
+        }
+
+      sent += bytes_transferred;
+      writes += n;
+
+      if (drain (receiver, received) == -1)
+        status = -1;
+    }
+
+  // The kernel is done with the data once the receiver has it all.
+  ACE_UINT32 completed = 0;
+  for (int tries = 0;
+       status == 0 && completed < writes && tries < 1000;
+       ++tries)
+    {
+      if (drain (receiver, received) == -1)
+        status = -1;
+
+      ACE_UINT32 first = 0;
+      ACE_UINT32 last = 0;
+      int const result =
+        ACE::zerocopy_completion (sender.get_handle (), first, last);
+
+      if (result == -1)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) %p\n"),
+                      ACE_TEXT ("zerocopy_completion")));
+          status = -1;
+        }
+      else if (result == 0)
+        ACE_OS::sleep (ACE_Time_Value (0, 1000));
+      else if (first != completed || last < first)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("(%t) completion of writes %u to %u, ")
+                      ACE_TEXT ("expected %u\n"),
+                      first,
+                      last,
+                      completed));
+          status = -1;
+        }
+      else
+        completed = last + 1;
+    }
+
+  if (status == 0 && completed != writes)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("(%t) %u of %B writes completed\n"),
+                  completed,
+                  writes));
+      status = -1;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("(%t) %B zero-copy writes completed\n"),
+              writes));
+
+  release_messages (messages);
+  sender.close ();
+  receiver.close ();
+  return status;
+#else
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("(%t) MSG_ZEROCOPY isn't supported\n")));
+  return 0;
+#endif /* MSG_ZEROCOPY */
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("SOCK_Send_Chain_Test"));
+
+  int status = 0;
+
+  if (test_partial_writes () == -1)
+    status = 1;
+
+  if (test_buffered_handler (false) == -1)
+    status = 1;
+
+  if (test_zerocopy_completions () == -1)
+    status = 1;
+
+  if (test_buffered_handler (true) == -1)
+    status = 1;
+
+  ACE_END_TEST;
+  return status;
+}
@@ -21,6 +21,7 @@
 #include "ace/Timer_List.h"
 #include "ace/Timer_Hash.h"
 #include "ace/Timer_Wheel.h"
+#include "ace/Timer_Hierarchical_Wheel.h"
 #include "ace/Reactor.h"
 #include "ace/Recursive_Thread_Mutex.h"
 #include "ace/Null_Mutex.h"
@@ -482,6 +483,7 @@ static int list = 1;
 static int hash = 1;
 static int wheel = 1;
 static int hashheap = 1;
+static int hwheel = 1;
 static int test_cancellation = 1;
 static int test_expire = 1;
 static int test_one_upcall = 1;
@@ -490,7 +492,7 @@ static int test_simple = 1;
 static int
 parse_args (int argc, ACE_TCHAR *argv[])
 {
-  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("a:b:c:d:e:l:m:n:o:z:"));
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("a:b:c:d:e:f:l:m:n:o:z:"));
 
   int cc;
   while ((cc = get_opt ()) != -1)
@@ -512,6 +514,9 @@ parse_args (int argc, ACE_TCHAR *argv[])
         case 'e':
           hashheap = ACE_OS::atoi (get_opt.opt_arg ());
           break;
+        case 'f':
+          hwheel = ACE_OS::atoi (get_opt.opt_arg ());
+          break;
         case 'l':
           test_cancellation = ACE_OS::atoi (get_opt.opt_arg ());
           break;
@@ -535,6 +540,7 @@ parse_args (int argc, ACE_TCHAR *argv[])
                       ACE_TEXT ("\t[-c hash]  (defaults to %d)\n")
                       ACE_TEXT ("\t[-d wheel] (defaults to %d)\n")
                       ACE_TEXT ("\t[-e hashheap] (defaults to %d)\n")
+                      ACE_TEXT ("\t[-f hwheel] (defaults to %d)\n")
                       ACE_TEXT ("\t[-l test_cancellation] (defaults to %d)\n")
                       ACE_TEXT ("\t[-m test_expire] (defaults to %d)\n")
                       ACE_TEXT ("\t[-n test_one_upcall] (defaults to %d)\n")
@@ -547,6 +553,7 @@ parse_args (int argc, ACE_TCHAR *argv[])
                       hash,
                       wheel,
                       hashheap,
+                      hwheel,
                       test_cancellation,
                       test_expire,
                       test_one_upcall,
@@ -580,6 +587,7 @@ run_main (int argc, ACE_TCHAR *argv[])
       if (hash)  { cancellation_test<ACE_Timer_Hash>  test ("ACE_Timer_Hash");  ACE_UNUSED_ARG (test); }
       if (wheel) { cancellation_test<ACE_Timer_Wheel> test ("ACE_Timer_Wheel"); ACE_UNUSED_ARG (test); }
       if (hashheap) { cancellation_test<ACE_Timer_Hash_Heap> test ("ACE_Timer_Hash_Heap"); ACE_UNUSED_ARG (test); }
+      if (hwheel) { cancellation_test<ACE_Timer_Hierarchical_Wheel> test ("ACE_Timer_Hierarchical_Wheel"); ACE_UNUSED_ARG (test); }
     }
 
   if (test_expire)
@@ -592,6 +600,7 @@ run_main (int argc, ACE_TCHAR *argv[])
       if (hash)  { expire_test<ACE_Timer_Hash>  test ("ACE_Timer_Hash");  ACE_UNUSED_ARG (test); }
       if (wheel) { expire_test<ACE_Timer_Wheel> test ("ACE_Timer_Wheel"); ACE_UNUSED_ARG (test); }
       if (hashheap) { expire_test<ACE_Timer_Hash_Heap> test ("ACE_Timer_Hash_Heap"); ACE_UNUSED_ARG (test); }
+      if (hwheel) { expire_test<ACE_Timer_Hierarchical_Wheel> test ("ACE_Timer_Hierarchical_Wheel"); ACE_UNUSED_ARG (test); }
     }
 
   if (test_one_upcall)
@@ -604,6 +613,7 @@ run_main (int argc, ACE_TCHAR *argv[])
       if (hash)  { upcall_test<ACE_Timer_Hash>  test ("ACE_Timer_Hash");  ACE_UNUSED_ARG (test); }
       if (wheel) { upcall_test<ACE_Timer_Wheel> test ("ACE_Timer_Wheel"); ACE_UNUSED_ARG (test); }
       if (hashheap) { upcall_test<ACE_Timer_Hash_Heap> test ("ACE_Timer_Hash_Heap"); ACE_UNUSED_ARG (test); }
+      if (hwheel) { upcall_test<ACE_Timer_Hierarchical_Wheel> test ("ACE_Timer_Hierarchical_Wheel"); ACE_UNUSED_ARG (test); }
     }
 
   if (test_simple)
@@ -616,6 +626,7 @@ run_main (int argc, ACE_TCHAR *argv[])
       if (hash)  { simple_test<ACE_Timer_Hash>  test ("ACE_Timer_Hash");  ACE_UNUSED_ARG (test); }
       if (wheel) { simple_test<ACE_Timer_Wheel> test ("ACE_Timer_Wheel"); ACE_UNUSED_ARG (test); }
       if (hashheap) { simple_test<ACE_Timer_Hash_Heap> test ("ACE_Timer_Hash_Heap"); ACE_UNUSED_ARG (test); }
+      if (hwheel) { simple_test<ACE_Timer_Hierarchical_Wheel> test ("ACE_Timer_Hierarchical_Wheel"); ACE_UNUSED_ARG (test); }
     }
 
   ACE_END_TEST;
@@ -5,12 +5,13 @@
  *
  *  $Id$
  *
- *    This is a simple test of <ACE_Timer_Queue> and four of its
+ *    This is a simple test of <ACE_Timer_Queue> and five of its
  *    subclasses (<ACE_Timer_List>, <ACE_Timer_Heap>,
- *    <ACE_Timer_Wheel>, and <ACE_Timer_Hash>).  The test sets up a
- *    bunch of timers and then adds them to a timer queue. The
- *    functionality of the timer queue is then tested. No command
- *    line arguments are needed to run the test.
+ *    <ACE_Timer_Wheel>, <ACE_Timer_Hierarchical_Wheel> and
+ *    <ACE_Timer_Hash>).  The test sets up a bunch of timers and then
+ *    adds them to a timer queue. The functionality of the timer queue
+ *    is then tested, followed by the performance of each queue. No
+ *    command line arguments are needed to run the test.
  *
  *
  *  @author Douglas C. Schmidt <schmidt@cs.wustl.edu>
@@ -26,6 +27,7 @@
 #include "ace/Timer_List.h"
 #include "ace/Timer_Heap.h"
 #include "ace/Timer_Wheel.h"
+#include "ace/Timer_Hierarchical_Wheel.h"
 #include "ace/Timer_Hash.h"
 #include "ace/Timer_Queue.h"
 #include "ace/Time_Policy.h"
@@ -517,6 +519,59 @@ test_performance (ACE_Timer_Queue *tq,
               ACE_TEXT ("time per call = %f usecs\n"),
               (et.user_time / ACE_timer_t (max_iterations)) * 1000000));
 
+  // Test the amount of time required to keep pushing back idle
+  // timeouts, as servers do for each connection with activity: the
+  // timers are cancelled and rescheduled long before they expire.
+
+  const ACE_Time_Value idle_timeout (30);
+  const int rounds = 10;
+
+  for (i = 0; i < max_iterations; ++i)
+    {
+      ACE_NEW (timer_act, int (42));
+      timer_ids[i] = tq->schedule (&eh,
+                                   timer_act,
+                                   times[i] + idle_timeout);
+      ACE_TEST_ASSERT (timer_ids[i] != -1);
+    }
+
+  timer.start ();
+
+  for (int round = 1; round <= rounds; ++round)
+    for (i = 0; i < max_iterations; ++i)
+      {
+        tq->cancel (timer_ids[i], &timer_act);
+        timer_ids[i] = tq->schedule (&eh,
+                                     timer_act,
+                                     times[i] + idle_timeout
+                                     + ACE_Time_Value (round));
+        ACE_TEST_ASSERT (timer_ids[i] != -1);
+      }
+
+  timer.stop ();
+
+  ACE_TEST_ASSERT (tq->is_empty () == 0);
+
+  timer.elapsed_time (et);
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("time to reschedule %d idle timeouts %d times for %s\n"),
+              max_iterations, rounds, test_name));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("real time = %f secs, user time = %f secs, system time = %f secs\n"),
+              et.real_time, et.user_time, et.system_time));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("time per call = %f usecs\n"),
+              (et.user_time / ACE_timer_t (max_iterations * rounds)) * 1000000));
+
+  for (i = 0; i < max_iterations; ++i)
+    {
+      tq->cancel (timer_ids[i], &timer_act);
+      delete (int *) timer_act;
+    }
+
+  ACE_TEST_ASSERT (tq->is_empty () != 0);
+
   delete [] times;
 }
 
@@ -660,6 +715,21 @@ run_main (int argc, ACE_TCHAR *argv[])
                                      ACE_TEXT ("ACE_Timer_Wheel (preallocated)"),
                                      tq_stack),
                   -1);
+  // Timer_Hierarchical_Wheel without preallocated memory
+  ACE_NEW_RETURN (tq_stack,
+                  Timer_Queue_Stack (new ACE_Timer_Hierarchical_Wheel,
+                                     ACE_TEXT ("ACE_Timer_Hierarchical_Wheel (non-preallocated)"),
+                                     tq_stack),
+                  -1);
+
+  // Timer_Hierarchical_Wheel with preallocated memory.
+  ACE_NEW_RETURN (tq_stack,
+                  Timer_Queue_Stack (new ACE_Timer_Hierarchical_Wheel (ACE_DEFAULT_TIMER_HIERARCHICAL_WHEEL_RESOLUTION,
+                                                                       max_iterations),
+                                     ACE_TEXT ("ACE_Timer_Hierarchical_Wheel (preallocated)"),
+                                     tq_stack),
+                  -1);
+
   // Timer_Heap without preallocated memory.
   ACE_NEW_RETURN (tq_stack,
                   Timer_Queue_Stack (new ACE_Timer_Heap,
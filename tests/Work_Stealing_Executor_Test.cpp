@@ -0,0 +1,453 @@
+//=============================================================================
+/**
+ *  @file    Work_Stealing_Executor_Test.cpp
+ *
+ *  $Id$
+ *
+ *    This test checks <ACE_Work_Stealing_Executor>: requests which
+ *    split into more requests all run, exactly once, before close()
+ *    returns; futures get the results of the requests; thread
+ *    functions and task svc() hooks run on the workers; a closed
+ *    executor refuses requests, and those accepted while it closes
+ *    all run.  The split workload is timed on the
+ *    executor and on an <ACE_Task> pool sharing an
+ *    <ACE_Activation_Queue>.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/Work_Stealing_Executor.h"
+#include "ace/Method_Request.h"
+#include "ace/Activation_Queue.h"
+#include "ace/Task.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_unistd.h"
+
+#if defined (ACE_HAS_THREADS)
+
+static const int WORKERS = 4;
+
+// The split requests make 2^DEPTH leaves.
+static const int DEPTH = 16;
+
+/**
+ * @class Split_Request
+ *
+ * Schedules two requests of depth - 1 on the executor, or counts a
+ * leaf at depth 0.
+ */
+class Split_Request : public ACE_Method_Request
+{
+public:
+  Split_Request (ACE_Work_Stealing_Executor &executor,
+                 ACE_Atomic_Op<ACE_Thread_Mutex, long> &leaves,
+                 int depth)
+    : executor_ (executor),
+      leaves_ (leaves),
+      depth_ (depth)
+  {
+  }
+
+  virtual int call (void)
+  {
+    if (this->depth_ == 0)
+      {
+        ++this->leaves_;
+        return 0;
+      }
+
+    for (int i = 0; i < 2; ++i)
+      {
+        Split_Request *child = 0;
+        ACE_NEW_RETURN (child,
+                        Split_Request (this->executor_,
+                                       this->leaves_,
+                                       this->depth_ - 1),
+                        -1);
+        if (this->executor_.execute (child) == -1)
+          {
+            delete child;
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               ACE_TEXT ("(%t) %p\n"),
+                               ACE_TEXT ("execute")),
+                              -1);
+          }
+      }
+    return 0;
+  }
+
+private:
+  ACE_Work_Stealing_Executor &executor_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> &leaves_;
+  int depth_;
+};
+
+static int
+test_split (void)
+{
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> leaves (0);
+  ACE_Work_Stealing_Executor executor;
+
+  if (executor.open (WORKERS, true) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), 1);
+
+  if (executor.size () != static_cast<size_t> (WORKERS)
+      || executor.current_worker () != -1)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("executor has %B workers, current %d\n"),
+                       executor.size (),
+                       static_cast<int> (executor.current_worker ())),
+                      1);
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  // Each root request is given to a worker in turn; the others get
+  // their share of its children by stealing them.
+  for (int i = 0; i < WORKERS; ++i)
+    executor.execute (new Split_Request (executor, leaves, DEPTH - 2));
+
+  if (executor.close () == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("close")), 1);
+
+  timer.stop ();
+
+  long const expected = 1L << DEPTH;
+  if (leaves.value () != expected)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("%d leaves run, expected %d\n"),
+                       static_cast<int> (leaves.value ()),
+                       static_cast<int> (expected)),
+                      1);
+
+  ACE_hrtime_t ns = 0;
+  timer.elapsed_time (ns);
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("ACE_Work_Stealing_Executor: %Q ns/request, ")
+              ACE_TEXT ("%Q stolen\n"),
+              ns / (2 * expected),
+              static_cast<ACE_UINT64> (executor.steals ())));
+  return 0;
+}
+
+/**
+ * @class Pool
+ *
+ * ACE_Task worker pool running the requests of an
+ * ACE_Activation_Queue, until it gets a request returning -1.
+ */
+class Pool : public ACE_Task_Base
+{
+public:
+  Pool (void)
+  {
+    // The workers enqueue too, so they mustn't block on a full queue.
+    this->queue_.queue ()->high_water_mark (1 << 30);
+  }
+
+  virtual int svc (void)
+  {
+    for (;;)
+      {
+        ACE_Method_Request *request = this->queue_.dequeue ();
+        if (request == 0)
+          return -1;
+
+        int const result = request->call ();
+        delete request;
+        if (result == -1)
+          return 0;
+      }
+  }
+
+  ACE_Activation_Queue queue_;
+};
+
+class Pool_Split_Request : public ACE_Method_Request
+{
+public:
+  Pool_Split_Request (Pool &pool,
+                      ACE_Atomic_Op<ACE_Thread_Mutex, long> &leaves,
+                      int depth)
+    : pool_ (pool),
+      leaves_ (leaves),
+      depth_ (depth)
+  {
+  }
+
+  virtual int call (void)
+  {
+    if (this->depth_ == 0)
+      {
+        ++this->leaves_;
+        return 0;
+      }
+
+    for (int i = 0; i < 2; ++i)
+      this->pool_.queue_.enqueue (new Pool_Split_Request (this->pool_,
+                                                          this->leaves_,
+                                                          this->depth_ - 1));
+    return 0;
+  }
+
+private:
+  Pool &pool_;
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> &leaves_;
+  int depth_;
+};
+
+class Stop_Request : public ACE_Method_Request
+{
+public:
+  virtual int call (void)
+  {
+    return -1;
+  }
+};
+
+static int
+time_activation_queue (void)
+{
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> leaves (0);
+  Pool pool;
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  if (pool.activate (THR_NEW_LWP | THR_JOINABLE, WORKERS) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("activate")),
+                      1);
+
+  for (int i = 0; i < WORKERS; ++i)
+    pool.queue_.enqueue (new Pool_Split_Request (pool, leaves, DEPTH - 2));
+
+  long const expected = 1L << DEPTH;
+  while (leaves.value () != expected)
+    ACE_OS::thr_yield ();
+
+  for (int i = 0; i < WORKERS; ++i)
+    pool.queue_.enqueue (new Stop_Request);
+  pool.wait ();
+
+  timer.stop ();
+
+  ACE_hrtime_t ns = 0;
+  timer.elapsed_time (ns);
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("ACE_Activation_Queue pool:  %Q ns/request\n"),
+              ns / (2 * expected)));
+  return 0;
+}
+
+class Answer_Request : public ACE_Method_Request
+{
+public:
+  virtual int call (void)
+  {
+    return 42;
+  }
+};
+
+static ACE_THR_FUNC_RETURN
+count_call (void *arg)
+{
+  ++*static_cast<ACE_Atomic_Op<ACE_Thread_Mutex, long> *> (arg);
+  return 0;
+}
+
+class Counting_Task : public ACE_Task_Base
+{
+public:
+  Counting_Task (void) : calls_ (0) {}
+
+  virtual int svc (void)
+  {
+    ++this->calls_;
+    return 0;
+  }
+
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> calls_;
+};
+
+static int
+test_futures (void)
+{
+  int status = 0;
+  ACE_Work_Stealing_Executor executor;
+
+  if (executor.open (2) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), 1);
+
+  const int count = 10;
+  ACE_Future<int> results[count];
+  for (int i = 0; i < count; ++i)
+    if (executor.execute (new Answer_Request, results[i]) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("execute")),
+                        1);
+
+  for (int i = 0; i < count; ++i)
+    {
+      int value = 0;
+      if (results[i].get (value) == -1 || value != 42)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("future %d got %d\n"),
+                      i,
+                      value));
+          status = 1;
+        }
+    }
+
+  ACE_Atomic_Op<ACE_Thread_Mutex, long> calls (0);
+  Counting_Task task;
+  for (int i = 0; i < count; ++i)
+    {
+      executor.execute (count_call, &calls);
+      executor.execute (&task);
+    }
+
+  executor.close ();
+
+  if (calls.value () != count || task.calls_.value () != count)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("%d function calls and %d svc calls, ")
+                  ACE_TEXT ("expected %d\n"),
+                  static_cast<int> (calls.value ()),
+                  static_cast<int> (task.calls_.value ()),
+                  count));
+      status = 1;
+    }
+
+  Answer_Request late;
+  if (executor.execute (&late) != -1 || errno != ESHUTDOWN)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("closed executor accepted a request\n")));
+      status = 1;
+    }
+
+  return status;
+}
+
+static const int RACE_REQUESTS = 200000;
+
+/**
+ * @struct Racer
+ *
+ * A thread scheduling requests with futures from outside the
+ * executor until it is refused.
+ */
+struct Racer
+{
+  ACE_Work_Stealing_Executor *executor_;
+  ACE_Future<int> *results_;
+  int accepted_;
+};
+
+static ACE_THR_FUNC_RETURN
+race_execute (void *arg)
+{
+  Racer *racer = static_cast<Racer *> (arg);
+
+  for (racer->accepted_ = 0;
+       racer->accepted_ < RACE_REQUESTS;
+       ++racer->accepted_)
+    {
+      Answer_Request *request = new Answer_Request;
+      if (racer->executor_->execute (request,
+                                     racer->results_[racer->accepted_]) == -1)
+        {
+          delete request;
+          break;
+        }
+    }
+
+  return 0;
+}
+
+// Closes the executor while other threads schedule requests: those
+// accepted must all have run by the time close() returns.
+static int
+test_close_race (void)
+{
+  int status = 0;
+  ACE_Work_Stealing_Executor executor;
+
+  if (executor.open (2) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), 1);
+
+  const int racers = 4;
+  Racer racer[racers];
+  ACE_Thread_Manager thr_mgr;
+  for (int i = 0; i < racers; ++i)
+    {
+      racer[i].executor_ = &executor;
+      racer[i].results_ = new ACE_Future<int>[RACE_REQUESTS];
+      racer[i].accepted_ = 0;
+      thr_mgr.spawn (race_execute, &racer[i]);
+    }
+
+  ACE_OS::sleep (ACE_Time_Value (0, 20000));
+  executor.close ();
+  thr_mgr.wait ();
+
+  int accepted = 0;
+  for (int i = 0; i < racers; ++i)
+    {
+      for (int j = 0; j < racer[i].accepted_; ++j)
+        {
+          int value = 0;
+          if (!racer[i].results_[j].ready ()
+              || racer[i].results_[j].get (value) == -1
+              || value != 42)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("request %d of racer %d accepted ")
+                          ACE_TEXT ("but not run\n"),
+                          j, i));
+              status = 1;
+              break;
+            }
+        }
+      accepted += racer[i].accepted_;
+      delete [] racer[i].results_;
+    }
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%d requests accepted while closing\n"),
+              accepted));
+  return status;
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Work_Stealing_Executor_Test"));
+
+  int status = test_split ();
+  status += test_futures ();
+  status += test_close_race ();
+  status += time_activation_queue ();
+
+  ACE_END_TEST;
+  return status;
+}
+
+#else
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Work_Stealing_Executor_Test"));
+
+  ACE_DEBUG ((LM_INFO,
+              ACE_TEXT ("ACE_Work_Stealing_Executor requires threads\n")));
+
+  ACE_END_TEST;
+  return 0;
+}
+
+#endif /* ACE_HAS_THREADS */